@@ -17,6 +17,7 @@
 
 #include <log/vqe_cfg_syslog_def.h>
 #include <log/vqe_cfg_debug.h>
+#include <pthread.h>
 
 typedef enum {
     ORIGINAL_STREAM = 0,
@@ -58,9 +59,38 @@ typedef enum {
 
 #define LOSS_RLE_HEADER 12
 
+/*
+ * All syslog messages of the channel module go through cfg_chan_log().
+ * While a lineup worker thread validates a channel (see
+ * cfg_channel_extract_quiet()) nothing is logged: the thread's quiet flag
+ * is set instead, and the session is validated again on the merging thread
+ * so that its messages come out in lineup order.
+ */
+static pthread_key_t cfg_chan_quiet_key;
+static pthread_once_t cfg_chan_quiet_once = PTHREAD_ONCE_INIT;
+
+static boolean *cfg_chan_quiet_flag(void);
+
+#define cfg_chan_log(msg_name, args...)                                 \
+    do {                                                                \
+        boolean *__logged_p = cfg_chan_quiet_flag();                    \
+        if (__logged_p) {                                               \
+            *__logged_p = TRUE;                                         \
+        } else {                                                        \
+            syslog_print(msg_name, ##args);                             \
+        }                                                               \
+    } while (0)
+
 /* sa_ignore DISABLE_RETURNS strlcpy */
 
 static channel_cfg_t* is_exist(void *sdp_p, channel_mgr_t *channel_mgr_p);
+static void make_session_key(void *sdp_p, char *session_key);
+static cfg_channel_ret_e channel_add(void *sdp_p,
+                                     channel_cfg_t *extracted_p,
+                                     boolean valid,
+                                     channel_mgr_t *channel_mgr_p,
+                                     idmgr_id_t *handle_p,
+                                     uint32_t checksum);
 static boolean linear_validation_and_extraction(void *sdp_p,
                                                 channel_cfg_t *channel_p);
 static session_type_e figure_out_session_type(void *sdp_p,
@@ -69,7 +99,6 @@ static session_type_e figure_out_session_type(void *sdp_p,
 static int get_bit_rate(void *sdp_p, uint16_t index);
 static boolean check_rtcp_port(in_port_t *rtp, in_port_t *rtcp, 
                                char *stream_name, channel_cfg_t *channel_p);
-static void cp_fec(fec_stream_cfg_t *dest, fec_stream_cfg_t *src);
 static boolean possible_lose_xr_data(channel_cfg_t *channel_p);
 
 /* Function:    cfg_channel_add
@@ -89,59 +118,125 @@ cfg_channel_ret_e cfg_channel_add (void *sdp_p,
 
     /* Check whether the channel is exist. If not, add it */
     channel_p = is_exist(sdp_p, channel_mgr_p);
-    if (channel_p == NULL) {
-        /* Check whether we have exceed the maximum allowed */
-        if (channel_mgr_p->total_num_channels >= MAX_CHANNELS) {
-            syslog_print(CFG_REACH_MAX_WARN, MAX_CHANNELS);
+    if (channel_p) {
+        cfg_chan_log(CFG_ADD_ERR, channel_p->session_key);
+        return CFG_CHANNEL_EXIST;
+    }
 
-            return CFG_CHANNEL_EXCEED_MAX;
-        }
+    return channel_add(sdp_p, NULL, FALSE, channel_mgr_p, handle_p, checksum);
+}
 
-        /* Create a channel structure */
-        channel_p = (channel_cfg_t *) malloc(sizeof(channel_cfg_t));
-        if (channel_p == NULL) {
-            syslog_print(CFG_MALLOC_ERR);
-            return CFG_CHANNEL_MALLOC_ERR;
-        }
 
-        /* Clean up the memory */
-        memset(channel_p, 0, sizeof(channel_cfg_t));
+/* Function:    cfg_channel_add_extracted
+ * Description: Add a channel that has already been validated and extracted
+ *              by cfg_channel_extract_quiet to the channel manager.  The
+ *              channel manager ends up exactly as cfg_channel_add would
+ *              leave it for the same SDP description.
+ * Parameters:  session_key     session key of the channel
+ *              extracted_p     channel extracted by cfg_channel_extract_quiet
+ *              valid           whether the channel passed validation
+ *              channel_mgr_p   pointer to the channel manager
+ *              handle_p        channel handle for the new channel
+ *              checksum        MD5 checksum of the SDP description
+ * Returns:     Same as cfg_channel_add
+ */
+cfg_channel_ret_e cfg_channel_add_extracted (const char *session_key,
+                                             channel_cfg_t *extracted_p,
+                                             boolean valid,
+                                             channel_mgr_t *channel_mgr_p,
+                                             idmgr_id_t *handle_p,
+                                             uint32_t checksum)
+{
+    channel_cfg_t *channel_p;
 
-        /* Get a handle from the ID manager */
-        *handle_p = id_get((void *)channel_p, channel_mgr_p->handle_mgr);
-        channel_p->handle = *handle_p;
+    /* Check whether the channel is exist. If not, add it */
+    channel_p = cfg_channel_find(channel_mgr_p, session_key);
+    if (channel_p) {
+        cfg_chan_log(CFG_ADD_ERR, channel_p->session_key);
+        return CFG_CHANNEL_EXIST;
+    }
 
-        channel_p->chksum = checksum;
+    return channel_add(NULL, extracted_p, valid, channel_mgr_p, handle_p,
+                       checksum);
+}
 
-        /* Semantic validation and content extraction */
-        if (linear_validation_and_extraction(sdp_p, channel_p) == FALSE) {
-            /* Remove the handle from the ID manager */
-            id_delete(channel_p->handle, channel_mgr_p->handle_mgr);
-            free(channel_p);
-            return CFG_CHANNEL_FAILED_GET_INFO;
-        }
 
-        /* Also, add the channel to the channel map */
-        if (cfg_channel_add_map(channel_mgr_p, channel_p)
-            != CFG_CHANNEL_SUCCESS) {
-            syslog_print(CFG_ADD_TO_MAP_WARN, channel_p->session_key);
+/* Function:    channel_add
+ * Description: Create a channel structure for a new channel and add it to
+ *              the channel manager.  The configuration is either validated
+ *              and extracted from the SDP description, or copied from a
+ *              channel extracted earlier.
+ * Parameters:  sdp_p           pointer to the SDP description, or NULL
+ *              extracted_p     channel extracted earlier if sdp_p is NULL
+ *              valid           whether extracted_p passed validation
+ *              channel_mgr_p   pointer to the channel manager
+ *              handle_p        channel handle for the new channel
+ *              checksum        MD5 checksum of the SDP description
+ * Returns:     Same as cfg_channel_add
+ */
+static cfg_channel_ret_e channel_add (void *sdp_p,
+                                      channel_cfg_t *extracted_p,
+                                      boolean valid,
+                                      channel_mgr_t *channel_mgr_p,
+                                      idmgr_id_t *handle_p,
+                                      uint32_t checksum)
+{
+    channel_cfg_t *channel_p;
 
-            /* Remove the handle from the ID manager */
-            id_delete(channel_p->handle, channel_mgr_p->handle_mgr);
-            free(channel_p);
-            return CFG_CHANNEL_FAILED_ADD_MAP;
-        }
+    /* Check whether we have exceed the maximum allowed */
+    if (channel_mgr_p->total_num_channels >= MAX_CHANNELS) {
+        cfg_chan_log(CFG_REACH_MAX_WARN, MAX_CHANNELS);
 
-        channel_mgr_p->handles[channel_mgr_p->total_num_channels] = *handle_p;
+        return CFG_CHANNEL_EXCEED_MAX;
+    }
 
-        /* Increment the total channel count */
-        channel_mgr_p->total_num_channels++;
+    /* Create a channel structure */
+    channel_p = (channel_cfg_t *) malloc(sizeof(channel_cfg_t));
+    if (channel_p == NULL) {
+        cfg_chan_log(CFG_MALLOC_ERR);
+        return CFG_CHANNEL_MALLOC_ERR;
     }
-    else {
-        syslog_print(CFG_ADD_ERR, channel_p->session_key);
-        return CFG_CHANNEL_EXIST;
+
+    /* Clean up the memory */
+    if (extracted_p) {
+        memcpy(channel_p, extracted_p, sizeof(channel_cfg_t));
+    } else {
+        memset(channel_p, 0, sizeof(channel_cfg_t));
+    }
+
+    /* Get a handle from the ID manager */
+    *handle_p = id_get((void *)channel_p, channel_mgr_p->handle_mgr);
+    channel_p->handle = *handle_p;
+
+    channel_p->chksum = checksum;
+
+    /* Semantic validation and content extraction */
+    if (sdp_p) {
+        valid = linear_validation_and_extraction(sdp_p, channel_p);
+    }
+    if (valid == FALSE) {
+        /* Remove the handle from the ID manager */
+        id_delete(channel_p->handle, channel_mgr_p->handle_mgr);
+        free(channel_p);
+        return CFG_CHANNEL_FAILED_GET_INFO;
     }
 
+    /* Also, add the channel to the channel map */
+    if (cfg_channel_add_map(channel_mgr_p, channel_p)
+        != CFG_CHANNEL_SUCCESS) {
+        cfg_chan_log(CFG_ADD_TO_MAP_WARN, channel_p->session_key);
+
+        /* Remove the handle from the ID manager */
+        id_delete(channel_p->handle, channel_mgr_p->handle_mgr);
+        free(channel_p);
+        return CFG_CHANNEL_FAILED_ADD_MAP;
+    }
+
+    channel_mgr_p->handles[channel_mgr_p->total_num_channels] = *handle_p;
+
+    /* Increment the total channel count */
+    channel_mgr_p->total_num_channels++;
+
     return CFG_CHANNEL_SUCCESS;
 }
 
@@ -189,7 +284,7 @@ cfg_channel_ret_e cfg_channel_delete (channel_mgr_t *channel_mgr_p,
     if (remove_from_map) {
         if (cfg_channel_del_map(channel_mgr_p, channel_p)
             != CFG_CHANNEL_SUCCESS) {
-            syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+            cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
         }
     }
 
@@ -289,7 +384,7 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                           inet_ntop(AF_INET, &(channel_p->original_source_addr),
                                     tmp, INET_ADDRSTRLEN),
                           ntohs(channel_p->original_source_port)); 
-            syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN, channel_p->session_key);
+            cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN, channel_p->session_key);
 
             return CFG_CHANNEL_FAILED_ADD_MAP;
         }
@@ -306,13 +401,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                               inet_ntop(AF_INET, &(channel_p->original_source_addr),
                                         tmp, INET_ADDRSTRLEN),
                               ntohs(channel_p->original_source_rtcp_port)); 
-                syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN,
+                cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN,
                              channel_p->session_key);
 
                 /* Remove everything from the channel map */
                 if (cfg_channel_del_map(channel_mgr_p, channel_p)
                     != CFG_CHANNEL_SUCCESS) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
 
@@ -333,13 +428,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                               inet_ntop(AF_INET, &(channel_p->fbt_address),
                                         tmp, INET_ADDRSTRLEN),
                               ntohs(rtcp_port)); 
-                syslog_print(CFG_DUPLICATED_FBT_ADDR_WARN,
+                cfg_chan_log(CFG_DUPLICATED_FBT_ADDR_WARN,
                              channel_p->session_key);
 
                 /* Remove everything from the channel map */
                 if (cfg_channel_del_map(channel_mgr_p, channel_p)
                     != CFG_CHANNEL_SUCCESS) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
 
@@ -358,13 +453,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                               inet_ntop(AF_INET, &(channel_p->fbt_address),
                                         tmp, INET_ADDRSTRLEN),
                               ntohs(channel_p->rtx_rtp_port)); 
-                syslog_print(CFG_DUPLICATED_RTX_ADDR_WARN,
+                cfg_chan_log(CFG_DUPLICATED_RTX_ADDR_WARN,
                              channel_p->session_key);
 
                 /* Remove everything from the channel map */
                 if (cfg_channel_del_map(channel_mgr_p, channel_p)
                     != CFG_CHANNEL_SUCCESS) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
                 
@@ -382,14 +477,14 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                               inet_ntop(AF_INET, &(channel_p->fbt_address),
                                         tmp, INET_ADDRSTRLEN),
                               ntohs(channel_p->rtx_rtcp_port)); 
-                syslog_print(CFG_DUPLICATED_RTX_ADDR_WARN,
+                cfg_chan_log(CFG_DUPLICATED_RTX_ADDR_WARN,
                              channel_p->session_key);
 
 
                 /* Remove everything from the channel map */
                 if (cfg_channel_del_map(channel_mgr_p, channel_p)
                     != CFG_CHANNEL_SUCCESS) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
                 
@@ -410,13 +505,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                                         &(channel_p->fec_stream1.multicast_addr),
                                         tmp, INET_ADDRSTRLEN),
                               ntohs(channel_p->fec_stream1.rtp_port)); 
-                syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN,
+                cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN,
                              channel_p->session_key);
 
                 /* Remove everything from the channel map */
                 if (cfg_channel_del_map(channel_mgr_p, channel_p)
                     != CFG_CHANNEL_SUCCESS) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
                 
@@ -436,13 +531,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                                             &(channel_p->fec_stream1.multicast_addr),
                                             tmp, INET_ADDRSTRLEN),
                                   ntohs(channel_p->fec_stream1.rtcp_port)); 
-                    syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN,
+                    cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN,
                                  channel_p->session_key);
 
                     /* Remove everything from the channel map */
                     if (cfg_channel_del_map(channel_mgr_p, channel_p)
                         != CFG_CHANNEL_SUCCESS) {
-                        syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                        cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                      channel_p->session_key);
                     }
                 
@@ -463,13 +558,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                                             &(channel_p->fec_stream2.multicast_addr),
                                             tmp, INET_ADDRSTRLEN),
                                   ntohs(channel_p->fec_stream2.rtp_port)); 
-                    syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN,
+                    cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN,
                                  channel_p->session_key);
 
                     /* Remove everything from the channel map */
                     if (cfg_channel_del_map(channel_mgr_p, channel_p)
                         != CFG_CHANNEL_SUCCESS) {
-                        syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                        cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                      channel_p->session_key);
                     }
                 
@@ -489,13 +584,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                                                 &(channel_p->fec_stream2.multicast_addr),
                                                 tmp, INET_ADDRSTRLEN),
                                       ntohs(channel_p->fec_stream2.rtcp_port)); 
-                        syslog_print(CFG_DUPLICATED_SRC_ADDR_WARN,
+                        cfg_chan_log(CFG_DUPLICATED_SRC_ADDR_WARN,
                                      channel_p->session_key);
                         
                         /* Remove everything from the channel map */
                         if (cfg_channel_del_map(channel_mgr_p, channel_p)
                             != CFG_CHANNEL_SUCCESS) {
-                            syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                            cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                          channel_p->session_key);
                         }
                 
@@ -511,13 +606,13 @@ cfg_channel_ret_e cfg_channel_add_map (channel_mgr_t *channel_mgr_p,
                       strlen(channel_p->session_key));
     elem = vqe_hash_elem_create(&hkey, channel_p);
     if (elem == NULL) {
-        syslog_print(CFG_CREATE_KEY_ERR, channel_p->session_key);
+        cfg_chan_log(CFG_CREATE_KEY_ERR, channel_p->session_key);
         return CFG_CHANNEL_FAILED_ADD_MAP;
     }
 
     if (!MCALL(channel_mgr_p->session_keys, vqe_hash_add_elem, elem)) {
         vqe_hash_elem_destroy(elem);
-        syslog_print(CFG_CREATE_KEY_ERR, channel_p->session_key);
+        cfg_chan_log(CFG_CREATE_KEY_ERR, channel_p->session_key);
         return CFG_CHANNEL_FAILED_ADD_MAP;
     }
 
@@ -555,7 +650,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                channel_p->original_source_addr,
                                channel_p->original_source_port,
                                channel_p->handle) == FALSE) {
-            syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+            cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
         }
 
 
@@ -564,7 +659,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                    channel_p->original_source_addr,
                                    channel_p->original_source_rtcp_port,
                                    channel_p->handle) == FALSE) {
-                syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+                cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
             }
         }
 
@@ -574,21 +669,21 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                    channel_p->fbt_address,
                                    rtcp_port,
                                    channel_p->handle) == FALSE) {
-                syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+                cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
             }
 
             if (channel_remove_map(&channel_mgr_p->fbt_map,
                                    channel_p->fbt_address,
                                    channel_p->rtx_rtp_port,
                                    channel_p->handle) == FALSE) {
-                syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+                cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
             }
 
             if (channel_remove_map(&channel_mgr_p->fbt_map,
                                    channel_p->fbt_address,
                                    channel_p->rtx_rtcp_port,
                                    channel_p->handle) == FALSE) {
-                syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+                cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
             }
         }
 
@@ -597,7 +692,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                    channel_p->fec_stream1.multicast_addr,
                                    channel_p->fec_stream1.rtp_port,
                                    channel_p->handle) == FALSE) {
-                syslog_print(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
+                cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, channel_p->session_key);
             }
 
             if (channel_p->fec_stream1.rtcp_port != 0) {
@@ -605,7 +700,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                        channel_p->fec_stream1.multicast_addr,
                                        channel_p->fec_stream1.rtcp_port,
                                        channel_p->handle) == FALSE) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN, 
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, 
                                  channel_p->session_key);
                 }
             }
@@ -615,7 +710,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                        channel_p->fec_stream2.multicast_addr,
                                        channel_p->fec_stream2.rtp_port,
                                        channel_p->handle) == FALSE) {
-                    syslog_print(CFG_REMOVE_FROM_MAP_WARN,
+                    cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN,
                                  channel_p->session_key);
                 }
 
@@ -624,7 +719,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
                                            channel_p->fec_stream2.multicast_addr,
                                            channel_p->fec_stream2.rtcp_port,
                                            channel_p->handle) == FALSE) {
-                        syslog_print(CFG_REMOVE_FROM_MAP_WARN, 
+                        cfg_chan_log(CFG_REMOVE_FROM_MAP_WARN, 
                                      channel_p->session_key);
                     }
                 }
@@ -638,7 +733,7 @@ cfg_channel_ret_e cfg_channel_del_map (channel_mgr_t *channel_mgr_p,
     elem = MCALL(channel_mgr_p->session_keys, vqe_hash_get_elem, &hkey);
     if (elem) {
         if (!MCALL(channel_mgr_p->session_keys, vqe_hash_del_elem, elem)) {
-            syslog_print(CFG_DELETE_KEY_ERR, channel_p->session_key);
+            cfg_chan_log(CFG_DELETE_KEY_ERR, channel_p->session_key);
             return CFG_CHANNEL_FAILURE;
         }
         vqe_hash_elem_destroy(elem);
@@ -665,7 +760,7 @@ channel_cfg_t *cfg_channel_insert (channel_mgr_t *channel_mgr_p,
         /* Create a channel structure */
         channel_p = (channel_cfg_t *) malloc(sizeof(channel_cfg_t));
         if (channel_p == NULL) {
-            syslog_print(CFG_MALLOC_ERR);
+            cfg_chan_log(CFG_MALLOC_ERR);
             return NULL;
         }
         memset(channel_p, 0, sizeof(channel_cfg_t));
@@ -684,7 +779,7 @@ channel_cfg_t *cfg_channel_insert (channel_mgr_t *channel_mgr_p,
         /*Also, add the channel to the channel map */
         if (cfg_channel_add_map(channel_mgr_p, channel_p)
             != CFG_CHANNEL_SUCCESS) {
-            syslog_print(CFG_ADD_TO_MAP_WARN, channel_p->session_key);
+            cfg_chan_log(CFG_ADD_TO_MAP_WARN, channel_p->session_key);
 
             /* Remove the handle from the ID manager */
             id_delete(channel_p->handle, channel_mgr_p->handle_mgr);
@@ -702,10 +797,10 @@ channel_cfg_t *cfg_channel_insert (channel_mgr_t *channel_mgr_p,
         }
 
         if (channel_mgr_p->total_num_channels >= MAX_CHANNELS) {
-            syslog_print(CFG_REACH_MAX_WARN, MAX_CHANNELS);
+            cfg_chan_log(CFG_REACH_MAX_WARN, MAX_CHANNELS);
             if (cfg_channel_delete(channel_mgr_p, channel_p->handle, TRUE)
                 != CFG_CHANNEL_SUCCESS) {
-                syslog_print(CFG_DELETE_WARN);
+                cfg_chan_log(CFG_DELETE_WARN);
             }
 
             return NULL;
@@ -1085,6 +1180,8 @@ boolean cfg_channel_compare (channel_cfg_t *channel1_p,
 cfg_channel_ret_e cfg_channel_copy (channel_cfg_t *dest_channel_p,
                                     channel_cfg_t *src_channel_p)
 {
+    idmgr_id_t handle;
+
     if (src_channel_p == NULL || dest_channel_p == NULL) {
         VQE_CFG_DEBUG(CFG_DEBUG_CHANNEL, NULL,
                       "cfg_channel_copy:: Invalid channel pointers %p and %p.",
@@ -1093,85 +1190,13 @@ cfg_channel_ret_e cfg_channel_copy (channel_cfg_t *dest_channel_p,
         return CFG_CHANNEL_INVALID_CHANNEL;
     }
     else {
-        /* Copy the content from source channel to destination channel */
-        strncpy(dest_channel_p->name, src_channel_p->name, SDP_MAX_STRING_LEN);
-        strncpy(dest_channel_p->session_key, src_channel_p->session_key,
-                MAX_KEY_LENGTH);
-        dest_channel_p->version = src_channel_p->version;
-        dest_channel_p->complete = src_channel_p->complete;
-        dest_channel_p->mode = src_channel_p->mode;
-        dest_channel_p->role = src_channel_p->role;
-        dest_channel_p->active = src_channel_p->active;
-
-        dest_channel_p->source_proto = src_channel_p->source_proto;
-        dest_channel_p->original_source_addr.s_addr
-            = src_channel_p->original_source_addr.s_addr;
-        dest_channel_p->src_addr_for_original_source.s_addr
-            = src_channel_p->src_addr_for_original_source.s_addr;
-        dest_channel_p->original_source_port
-            = src_channel_p->original_source_port;
-        dest_channel_p->original_source_rtcp_port
-            = src_channel_p->original_source_rtcp_port;
-        dest_channel_p->original_source_payload_type
-            = src_channel_p->original_source_payload_type;
-        dest_channel_p->bit_rate = src_channel_p->bit_rate;
-        dest_channel_p->original_rtcp_sndr_bw
-            = src_channel_p->original_rtcp_sndr_bw;
-        dest_channel_p->original_rtcp_rcvr_bw
-            = src_channel_p->original_rtcp_rcvr_bw;
-        dest_channel_p->original_rtcp_per_rcvr_bw
-            = src_channel_p->original_rtcp_per_rcvr_bw;
-        dest_channel_p->original_rtcp_xr_loss_rle
-            = src_channel_p->original_rtcp_xr_loss_rle;
-        dest_channel_p->original_rtcp_xr_per_loss_rle
-            = src_channel_p->original_rtcp_xr_per_loss_rle;
-        dest_channel_p->original_rtcp_xr_stat_flags
-            = src_channel_p->original_rtcp_xr_stat_flags;
-        dest_channel_p->original_rtcp_xr_multicast_acq
-            = src_channel_p->original_rtcp_xr_multicast_acq;
-        dest_channel_p->original_rtcp_xr_diagnostic_counters
-            = src_channel_p->original_rtcp_xr_diagnostic_counters;
-
-        dest_channel_p->original_rtcp_rsize
-            = src_channel_p->original_rtcp_rsize;
-        dest_channel_p->re_sourced_addr.s_addr
-            = src_channel_p->re_sourced_addr.s_addr;
-        dest_channel_p->re_sourced_rtp_port
-            = src_channel_p->re_sourced_rtp_port;
-        dest_channel_p->re_sourced_rtcp_port
-            = src_channel_p->re_sourced_rtcp_port;
-        dest_channel_p->re_sourced_payload_type
-            = src_channel_p->re_sourced_payload_type;
-
-        dest_channel_p->fbt_address.s_addr = src_channel_p->fbt_address.s_addr;
-        dest_channel_p->rtx_addr.s_addr = src_channel_p->rtx_addr.s_addr;
-        dest_channel_p->rtx_rtp_port = src_channel_p->rtx_rtp_port;
-        dest_channel_p->rtx_rtcp_port = src_channel_p->rtx_rtcp_port;
-        dest_channel_p->rtx_payload_type = src_channel_p->rtx_payload_type;
-        dest_channel_p->rtx_apt = src_channel_p->rtx_apt;
-        dest_channel_p->rtx_time = src_channel_p->rtx_time;
-        dest_channel_p->repair_rtcp_sndr_bw
-            = src_channel_p->repair_rtcp_sndr_bw;
-        dest_channel_p->repair_rtcp_rcvr_bw
-            = src_channel_p->repair_rtcp_rcvr_bw;
-        dest_channel_p->repair_rtcp_xr_loss_rle
-            = src_channel_p->repair_rtcp_xr_loss_rle;
-        dest_channel_p->repair_rtcp_xr_stat_flags
-            = src_channel_p->repair_rtcp_xr_stat_flags;
-
-        dest_channel_p->er_enable = src_channel_p->er_enable;
-        dest_channel_p->fcc_enable = src_channel_p->fcc_enable;
-        dest_channel_p->rtcp_fb_mode = src_channel_p->rtcp_fb_mode;
-        
-        dest_channel_p->fec_enable = src_channel_p->fec_enable;
-        dest_channel_p->fec_mode = src_channel_p->fec_mode;
-        cp_fec(&dest_channel_p->fec_stream1, &src_channel_p->fec_stream1);
-        cp_fec(&dest_channel_p->fec_stream2, &src_channel_p->fec_stream2);
-        /* copy fec info */
-        memcpy(&dest_channel_p->fec_info, &src_channel_p->fec_info,
-               sizeof(fec_info_t));
-
-        dest_channel_p->chksum = src_channel_p->chksum;
+        /*
+         * Copy the whole record, so that no field is ever left out; the
+         * destination channel keeps its own handle.
+         */
+        handle = dest_channel_p->handle;
+        memcpy(dest_channel_p, src_channel_p, sizeof(channel_cfg_t));
+        dest_channel_p->handle = handle;
 
         return CFG_CHANNEL_SUCCESS;
     }
@@ -1214,11 +1239,6 @@ static channel_cfg_t* is_exist (void *sdp_p,
                                 channel_mgr_t *channel_mgr_p)
 {
     char session_key[MAX_KEY_LENGTH];
-    const char *username;
-    const char *sessionid;
-    const char *creator_addr;
-    vqe_hash_key_t hkey;
-    vqe_hash_elem_t *elem;
 
     if (sdp_p == NULL) {
         VQE_CFG_DEBUG(CFG_DEBUG_CHANNEL, NULL,
@@ -1226,6 +1246,24 @@ static channel_cfg_t* is_exist (void *sdp_p,
         return NULL;
     }
 
+    make_session_key(sdp_p, session_key);
+
+    return cfg_channel_find(channel_mgr_p, session_key);
+}
+
+
+/* Function:    make_session_key
+ * Description: Create the session key of an SDP description
+ * Parameters:  sdp_p           The SDP handle
+ *              session_key     Buffer of MAX_KEY_LENGTH for the key
+ * Returns:     N/A
+ */
+static void make_session_key (void *sdp_p, char *session_key)
+{
+    const char *username;
+    const char *sessionid;
+    const char *creator_addr;
+
     /* Create the info from "o=" line to create a globally unique identifier */
     username = sdp_get_owner_username(sdp_p);
     sessionid = sdp_get_owner_sessionid(sdp_p);
@@ -1233,6 +1271,24 @@ static channel_cfg_t* is_exist (void *sdp_p,
 
     snprintf(session_key, MAX_KEY_LENGTH, "INIP4#%s#%s#%s",
              username, sessionid, creator_addr);
+}
+
+
+/* Function:    cfg_channel_find
+ * Description: Look up a channel by its session key
+ * Parameters:  channel_mgr_p   Channel manager
+ *              session_key     Session key of the channel
+ * Returns:     Channel or NULL
+ */
+channel_cfg_t *cfg_channel_find (channel_mgr_t *channel_mgr_p,
+                                 const char *session_key)
+{
+    vqe_hash_key_t hkey;
+    vqe_hash_elem_t *elem;
+
+    if (channel_mgr_p->session_keys == NULL) {
+        return NULL;
+    }
 
     VQE_HASH_MAKE_KEY(&hkey, session_key, strlen(session_key));
     elem = MCALL(channel_mgr_p->session_keys, vqe_hash_get_elem, &hkey);
@@ -1330,7 +1386,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "reaching the maximum version number (%llu) allowed "
                  "in o= line. " CHECK_DOCUMENT, MAX_VERSION_ALLOWED);
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      message_buffer);
         return FALSE;
     }
@@ -1339,7 +1395,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
     /* For now we only support IN and IP4 */
     if (sdp_get_owner_network_type(sdp_p) != SDP_NT_INTERNET ||
         sdp_get_owner_address_type(sdp_p) != SDP_AT_IP4) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "an unsupported network type or address type. "
                      "Currently only IN and IP4 are allowed.");
         return FALSE;
@@ -1367,13 +1423,13 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             time_value = atoll(stop_time);
             if (time_value
                 < abs_time_to_sec(ntp_to_abs_time(get_ntp_time()))) {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a past-time value specified in stop time "
                              "of t= line. " CHECK_DOCUMENT 
                              " The channel will be deleted immediately.");
             }
             else {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a future time value specified in stop time "
                              "of t= line. " CHECK_DOCUMENT 
                              " However, the channel will be deleted "
@@ -1382,7 +1438,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         }
     }
     else {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "an unsupported non-zero starting time in t= line. "
                      CHECK_DOCUMENT);
         return FALSE;
@@ -1395,7 +1451,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                  "%d missing media session(s) [minimum %d sessions are "
                  "required.] " CHECK_DOCUMENT, 
                  MIN_LINEAR_SESSIONS-num_sessions, MIN_LINEAR_SESSIONS);
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      message_buffer);
         return FALSE;
     }
@@ -1454,7 +1510,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "failing to get the total number of attributes "
                      "in media session %d.",
                      media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -1469,7 +1525,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "failing to get attribute type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -1502,7 +1558,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "an illegal connection address %s in c= line of "
                          "original media session. " CHECK_DOCUMENT,
                          conn_address);
-                syslog_print(CFG_VALIDATION_ERR,
+                cfg_chan_log(CFG_VALIDATION_ERR,
                              channel_p->session_key,
                              message_buffer);
                 return FALSE;
@@ -1514,7 +1570,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "an illegal RTP port number %d in m= line of "
                          "original media session. " CHECK_DOCUMENT,
                          rtp_port);
-                syslog_print(CFG_VALIDATION_ERR,
+                cfg_chan_log(CFG_VALIDATION_ERR,
                              channel_p->session_key,
                              message_buffer);
                 return FALSE;
@@ -1527,7 +1583,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "AS bandwidth being missing in original stream. "
                          CHECK_DOCUMENT);
-                syslog_print(CFG_VALIDATION_ERR,
+                cfg_chan_log(CFG_VALIDATION_ERR,
                              channel_p->session_key,
                              message_buffer);
                 return FALSE;
@@ -1538,7 +1594,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "less than the min value %d required. "
                          CHECK_DOCUMENT, media_session_idx,
                          MIN_BIT_RATE_ALLOWED);
-                syslog_print(CFG_VALIDATION_ERR,
+                cfg_chan_log(CFG_VALIDATION_ERR,
                              channel_p->session_key,
                              message_buffer);
                 return FALSE;
@@ -1550,7 +1606,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "exceeding the max value %d. "
                          CHECK_DOCUMENT, media_session_idx, 
                          MAX_BIT_RATE_ALLOWED);
-                syslog_print(CFG_VALIDATION_ERR,
+                cfg_chan_log(CFG_VALIDATION_ERR,
                              channel_p->session_key,
                              message_buffer);
                 return FALSE;
@@ -1597,7 +1653,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "m= line of media session %d having invalid "
                          "payload type %d. " CHECK_DOCUMENT,
                          media_session_idx, payload_type);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -1609,7 +1665,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "specified. Currently, only one stream per session "
                      "is allowed.",
                      media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -1624,7 +1680,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "original source stream having no bandwidth "
                              "line specified. b=AS:<> line must be present.");
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  message_buffer);
                     return FALSE;
                 }
@@ -1642,7 +1698,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "an unsupported stream type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              message_buffer);
 
                 break;
@@ -1657,7 +1713,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "bandwidth for media session %d "
                          "exceeding the max value %d. " CHECK_DOCUMENT,
                          media_session_idx, MAX_BW_ALLOWED);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -1670,7 +1726,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "AS bandwidth in original media session "
                                      "less than the min value %d required. "
                                      CHECK_DOCUMENT, MIN_BIT_RATE_ALLOWED);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -1681,7 +1737,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "AS bandwidth in original media session "
                                      "exceeding the max value %d. "
                                      CHECK_DOCUMENT, MAX_BIT_RATE_ALLOWED);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -1695,7 +1751,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "in media session %d other than original "
                                  "media session.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -1730,7 +1786,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "RS bandwidth specified in "
                                      "unknown media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN, message_buffer);
+                            cfg_chan_log(CFG_VALIDATION_WARN, message_buffer);
                     }
                      
                     break;
@@ -1762,7 +1818,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "RR bandwidth specified in "
                                      "unknown media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN, message_buffer);
+                            cfg_chan_log(CFG_VALIDATION_WARN, message_buffer);
                     }
 
                     break;
@@ -1772,7 +1828,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                              "an unsupported bandwidth modifier "
                              "in media session %d. "
                              CHECK_DOCUMENT, media_session_idx);
-                    syslog_print(CFG_VALIDATION_WARN,
+                    cfg_chan_log(CFG_VALIDATION_WARN,
                                  channel_p->session_key,
                                  message_buffer);
             }
@@ -1788,7 +1844,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "unicast address in media session %d. "
                              CHECK_DOCUMENT, media_session_idx);
-                    syslog_print(CFG_VALIDATION_ERR,
+                    cfg_chan_log(CFG_VALIDATION_ERR,
                                  channel_p->session_key,
                                  message_buffer);
                     return FALSE;
@@ -1805,7 +1861,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "an illegal connection address %s in c= line of "
                      "media session %d. " CHECK_DOCUMENT,
                      conn_address, media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          message_buffer);
             return FALSE;
@@ -1817,7 +1873,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "an illegal RTP port number %d in m= line of "
                      "media session %d. " CHECK_DOCUMENT,
                      rtp_port, media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          message_buffer);
             return FALSE;
@@ -1845,7 +1901,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                              "an illegal connection address %s in "
                              "c= line of unicast retransmission stream. "
                              CHECK_DOCUMENT, conn_address);
-                    syslog_print(CFG_VALIDATION_ERR,
+                    cfg_chan_log(CFG_VALIDATION_ERR,
                                  channel_p->session_key,
                                  message_buffer);
                     return FALSE;
@@ -1873,7 +1929,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "an unsupported stream type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              message_buffer);
         }
 
@@ -1889,7 +1945,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "failing to get attribute type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -1927,7 +1983,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "failing to get filter destination "
                                      "address in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -1940,7 +1996,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "in a=source-filter line of media "
                                      "session %d. " CHECK_DOCUMENT,
                                      dest_address, media_session_idx);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -1965,7 +2021,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                          "failing to get filter source "
                                          "address in media session %d.",
                                          media_session_idx);
-                                syslog_print(CFG_VALIDATION_ERR,
+                                cfg_chan_log(CFG_VALIDATION_ERR,
                                              channel_p->session_key,
                                              message_buffer);
                                 return FALSE;
@@ -1979,7 +2035,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                          "a=source-filter line of media "
                                          "session %d. " CHECK_DOCUMENT,
                                          src_address, media_session_idx);
-                                syslog_print(CFG_VALIDATION_ERR, 
+                                cfg_chan_log(CFG_VALIDATION_ERR, 
                                              channel_p->session_key,
                                              message_buffer);
                                 return FALSE;
@@ -2013,7 +2069,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "line not matching the connection "
                                      "address in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -2025,7 +2081,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "an unsupported source filter mode "
                                  "in media session %d.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR, 
+                        cfg_chan_log(CFG_VALIDATION_ERR, 
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2047,7 +2103,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "type %d in a=rtpmap:<> line. "
                                  CHECK_DOCUMENT,
                                  media_session_idx, payload_type);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2080,7 +2136,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -2092,7 +2148,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "in media session %d. "
                                  "Check m= line and a=rtpmap line.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2113,7 +2169,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "a=rtcp line of media session %d. "
                                  CHECK_DOCUMENT,
                                  rtcp_port, media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2131,7 +2187,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "failing to get connection "
                                  "address for RTCP in media session %d.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2146,7 +2202,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "in a=rtcp line of media "
                                  "session %d. " CHECK_DOCUMENT,
                                  dest_address, media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2182,7 +2238,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                          "session %d from c= line. " 
                                          CHECK_DOCUMENT,
                                          dest_address, media_session_idx);
-                                syslog_print(CFG_VALIDATION_WARN,
+                                cfg_chan_log(CFG_VALIDATION_WARN,
                                              channel_p->session_key,
                                              message_buffer);
                             }
@@ -2201,7 +2257,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -2225,7 +2281,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "failing to get RTCP feedback parameters "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_ERR, 
+                            cfg_chan_log(CFG_VALIDATION_ERR, 
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -2240,7 +2296,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                              "mismatched payload type "
                                              "in original media session. "
                                              "Check m= line and a=rtcp-fb line.");
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  message_buffer);
                                     return FALSE;
@@ -2254,7 +2310,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                              "mismatched payload type "
                                              "in re-sourced media session. "
                                              "Check m= line and a=rtcp-fb line.");
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  message_buffer);
                                     return FALSE;
@@ -2271,7 +2327,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                          "an unsupported stream type "
                                          "in media session %d.",
                                          media_session_idx);
-                                syslog_print(CFG_VALIDATION_WARN,
+                                cfg_chan_log(CFG_VALIDATION_WARN,
                                              channel_p->session_key,
                                              message_buffer);
                                 break;
@@ -2290,7 +2346,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                  "an illegal RTCP feedback specified in "
                                  "media session %d.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -2332,7 +2388,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                              "in unicast retransmission "
                                              "session. "
                                              "Check m= line and a=fmtp line.");
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  message_buffer);
                                     return FALSE;
@@ -2364,7 +2420,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                          "an illegal FMTP specified in "
                                          "media session %d.",
                                          media_session_idx);
-                                syslog_print(CFG_VALIDATION_ERR,
+                                cfg_chan_log(CFG_VALIDATION_ERR,
                                              channel_p->session_key,
                                              message_buffer);
                                 return FALSE;
@@ -2384,7 +2440,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "mismatched payload type "
                                      "in original stream session. "
                                      "Check m= line and a=fmtp line.");
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -2401,7 +2457,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      " media session "
                                      "exceeding the max value %d. "
                                      CHECK_DOCUMENT, MAX_BW_ALLOWED);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -2413,7 +2469,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                         snprintf(message_buffer, MAX_MSG_LENGTH,
                                  "FMTP not allowed in media "
                                  "session %d.", media_session_idx);
-                        syslog_print(CFG_VALIDATION_WARN,
+                        cfg_chan_log(CFG_VALIDATION_WARN,
                                      channel_p->session_key,
                                      message_buffer);
                     }
@@ -2467,7 +2523,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                             /* Check whether it can report on full range 
                                of data */
                             if (possible_lose_xr_data(channel_p)) {
-                                syslog_print(CFG_VALIDATION_WARN,
+                                cfg_chan_log(CFG_VALIDATION_WARN,
                                              channel_p->session_key,
                                              "been configured for XR reports, "
                                              "but may not be able to report "
@@ -2499,7 +2555,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -2511,7 +2567,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "an unsupported attribute in media session %d.",
                              media_session_idx);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
             }
         }
@@ -2549,7 +2605,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         channel_p->mode = SOURCE_MODE;
         if (group_id[RE_SOURCED_STREAM][0] == '\0' ||
             group_id[UNICAST_RTX_STREAM][0] == '\0') {
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          "missing mid in either re-sourced or retransmission "
                          " session. " CHECK_DOCUMENT);
             return FALSE;
@@ -2562,7 +2618,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         channel_p->mode = LOOKASIDE_MODE;
         if (group_id[ORIGINAL_STREAM][0] == '\0' ||
             group_id[UNICAST_RTX_STREAM][0] == '\0') {
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          "missing mid in either original or retransmission "
                          " session. " CHECK_DOCUMENT);
             return FALSE;
@@ -2575,7 +2631,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         channel_p->mode = SOURCE_MODE;
         if (group_id[RE_SOURCED_STREAM][0] == '\0' ||
             group_id[UNICAST_RTX_STREAM][0] == '\0') {
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          "missing mid in either re-sourced or retransmission "
                          " session. " CHECK_DOCUMENT);
             return FALSE;
@@ -2588,7 +2644,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         channel_p->mode = LOOKASIDE_MODE;
         if (group_id[ORIGINAL_STREAM][0] == '\0' ||
             group_id[UNICAST_RTX_STREAM][0] == '\0') {
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          "missing mid in either original or retransmission "
                          " session. " CHECK_DOCUMENT);
             return FALSE;
@@ -2601,7 +2657,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         channel_p->mode = RECV_ONLY_MODE;
     }
     else {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "either the role or the mode not being specified. "
                      CHECK_DOCUMENT);
         return FALSE;
@@ -2611,7 +2667,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         (channel_p->er_enable || channel_p->fcc_enable)) {
         channel_p->er_enable = FALSE;
         channel_p->fcc_enable = FALSE;
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "Error repair and RCC disabled due to missing "
                      "retransmission section.", CHECK_DOCUMENT);
     }
@@ -2624,7 +2680,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             channel_p->mode == RECV_ONLY_MODE) {
             if (group_id[ORIGINAL_STREAM][0] == '\0' ||
                 group_id[FEC_FIRST_STREAM][0] == '\0') {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "missing mid in either original or first FEC "
                              " session. " CHECK_DOCUMENT);
                 return FALSE;
@@ -2633,7 +2689,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         else if (channel_p->mode == SOURCE_MODE) {
             if (group_id[RE_SOURCED_STREAM][0] == '\0' ||
                 group_id[FEC_FIRST_STREAM][0] == '\0') {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "missing mid in either re-sourced or first FEC "
                              " session. " CHECK_DOCUMENT);
                 return FALSE;
@@ -2649,7 +2705,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             if (group_id[ORIGINAL_STREAM][0] == '\0' ||
                 group_id[FEC_FIRST_STREAM][0] == '\0' ||
                 group_id[FEC_SECOND_STREAM][0] == '\0') {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "missing mid in either original or one of FEC "
                              " sessions. " CHECK_DOCUMENT);
                 return FALSE;
@@ -2659,7 +2715,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             if (group_id[RE_SOURCED_STREAM][0] == '\0' ||
                 group_id[FEC_FIRST_STREAM][0] == '\0' ||
                 group_id[FEC_SECOND_STREAM][0] == '\0') {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "missing mid in either re-sourced or one of FEC "
                              " sessions. " CHECK_DOCUMENT);
                 return FALSE;
@@ -2681,7 +2737,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                                         0, j);
                     /* We only support group of two streams for now */
                     if (num_group_id != 2) {
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      "only two group ids allowed in FID "
                                      "attribute. " CHECK_DOCUMENT);
@@ -2707,7 +2763,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                 strstr(group_label,
                                        group_id[UNICAST_RTX_STREAM])
                                 == NULL) {
-                                syslog_print(CFG_VALIDATION_ERR,
+                                cfg_chan_log(CFG_VALIDATION_ERR,
                                              channel_p->session_key,
                                              "FID attribute not matching "
                                              "session stream definition. "
@@ -2722,7 +2778,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                 strstr(group_label,
                                        group_id[UNICAST_RTX_STREAM])
                                 == NULL) {
-                                syslog_print(CFG_VALIDATION_ERR,
+                                cfg_chan_log(CFG_VALIDATION_ERR,
                                              channel_p->session_key,
                                              "FID attribute not matching "
                                              "session stream definition. "
@@ -2744,7 +2800,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                                         0, j);
                     if (channel_p->fec_mode == FEC_1D_MODE) {
                         if (num_group_id != 2) {
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          "only two group ids required "
                                          "in FEC attribute for 1-D FEC. "
@@ -2771,7 +2827,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                     strstr(group_label, 
                                            group_id[FEC_FIRST_STREAM])
                                     == NULL) {
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  "FEC attribute not matching "
                                                  "session stream definition. "
@@ -2787,7 +2843,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                     strstr(group_label, 
                                            group_id[FEC_FIRST_STREAM])
                                     == NULL) {
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  "FEC attribute not matching "
                                                  "session stream definition. "
@@ -2799,7 +2855,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     }
                     else if (channel_p->fec_mode == FEC_2D_MODE) {
                         if (num_group_id != 3) {
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          "only three group ids required "
                                          "in FEC attribute for 2-D FEC. "
@@ -2829,7 +2885,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                     strstr(group_label, 
                                            group_id[FEC_SECOND_STREAM]) 
                                     == NULL) {
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  "FEC attribute not matching "
                                                  "session stream definition. "
@@ -2848,7 +2904,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                                     strstr(group_label, 
                                            group_id[FEC_SECOND_STREAM])
                                     == NULL) {
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  "FEC attribute not matching "
                                                  "session stream definition. "
@@ -2869,7 +2925,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
     if (channel_p->mode == SOURCE_MODE || channel_p->mode == LOOKASIDE_MODE) {
         if (found_fid == FALSE) {
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          "missing FID attribute." CHECK_DOCUMENT);
             return FALSE;
@@ -2878,7 +2934,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
     if (channel_p->fec_enable) {
         if (found_fec == FALSE) {
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          "missing FEC attribute." CHECK_DOCUMENT);
             return FALSE;
@@ -2889,7 +2945,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
     /* Check a=rtcp-unicast: */
     switch (sdp_get_rtcp_unicast_mode(sdp_p, SDP_SESSION_LEVEL, 0, 1)) {
       case SDP_RTCP_UNICAST_MODE_REFLECTION:
-          syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+          cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                        "reflection mode not being supported. "
                        CHECK_DOCUMENT
                        " rsi mode will be used for RTCP unicast feedback.");
@@ -2903,7 +2959,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
           
       case SDP_RTCP_UNICAST_MODE_NOT_PRESENT:
           if (channel_p->mode != DISTRIBUTION_MODE) {
-              syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+              cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                            "a=rtcp-unicast line not being present. "
                            CHECK_DOCUMENT
                            " RTCP unicast feedback with rsi mode will be used.");
@@ -2913,7 +2969,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
           break;
           
       default:
-          syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+          cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                        "an unsupported mode (rtcp-unicast).");
           return FALSE;
     }
@@ -2930,7 +2986,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 channel_p->original_rtcp_per_rcvr_bw == RTCP_BW_UNSPECIFIED) {
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "no bandwidth being specified.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -2943,7 +2999,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "RTP port being the same as RTCP port for "
                          "original stream. "
                          "Check m= line and a=rtcp line.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -2959,7 +3015,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
             /* The source filter should be present for orignal stream. */
             if (found_src_filter_in_orig_source == FALSE) {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a=source-filter line not being specified in "
                              "original stream. " USE_IN_ADDR_ANY);
             }
@@ -2981,7 +3037,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "RTP port being the same as RTCP port for "
                          "re-sourced stream. "
                          "Check m= line and a=rtcp line.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -2999,7 +3055,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "the original multicast address being the same as "
                          "the re-sourced multicast address.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3015,14 +3071,14 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "the rtx address not being the same as the FBT "
                              "address in source mode. " CHECK_DOCUMENT);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
                 }
             }
             
             /* The source filter must be present for re-sourced stream. */
             if (found_src_filter_in_re_sourced == FALSE) {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a=source-filter line not being specified in "
                              "re-sourced stream. " USE_IN_ADDR_ANY);
             }
@@ -3033,7 +3089,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "the source IP address not being the same as the FBT "
                          "address in source mode.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3042,7 +3098,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             /* the correct association */
             if (channel_p->re_sourced_payload_type !=
                 channel_p->rtx_apt) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "a=fmtp:<payload> apt= line being incorrectly "
                              "specified in unicast retransmission stream. "
                              CHECK_DOCUMENT);
@@ -3056,7 +3112,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "bandwidth being turned off. No unicast error "
                              "repair is enabled. " CHECK_DOCUMENT);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
                     channel_p->er_enable = FALSE;
                     channel_p->fcc_enable = FALSE;
@@ -3070,7 +3126,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             /* the correct association */
             if (channel_p->original_source_payload_type !=
                 channel_p->rtx_apt) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "a=fmtp:<payload> apt= line being incorrectly "
                              "specified in unicast retransmission stream. "
                              CHECK_DOCUMENT);
@@ -3088,7 +3144,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "the rtx address not being the same as the FBT "
                              "address in lookaside mode. " CHECK_DOCUMENT);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
                 }
             }
@@ -3103,7 +3159,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "bandwidth being turned off. No unicast error "
                              "repair is enabled. " CHECK_DOCUMENT);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
                     channel_p->er_enable = FALSE;
                     channel_p->fcc_enable = FALSE;
@@ -3120,7 +3176,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "the FBT address not being specified "
                          "in receiver only mode. " CHECK_DOCUMENT);
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3133,7 +3189,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "RTP port being the same as RTCP port for "
                          "original stream. "
                          "Check m= line and a=rtcp line.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3149,7 +3205,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
             /* The source filter must be present for orignal stream. */
             if (found_src_filter_in_orig_source == FALSE) {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a=source-filter line not being specified in "
                              "original source stream. " USE_IN_ADDR_ANY);
             }
@@ -3168,7 +3224,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "RTP port being the same as RTCP port for "
                      "unicast retransmission stream. "
                      "Check m= line and a=rtcp line.");
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -3185,14 +3241,14 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             snprintf(message_buffer, MAX_MSG_LENGTH,
                      "RTCP port of original stream being the same as "
                      "RTCP port for unicast retransmission stream.");
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
 
         /* Make sure that the FBT address is assigned */
         if (channel_p->fbt_address.s_addr == 0) {
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          "the FBT address not being specified. "
                          CHECK_DOCUMENT);
             return FALSE;
@@ -3202,7 +3258,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
     if (channel_p->fec_enable) {
         /* The source filter must be present for FEC stream1. */
         if (found_src_filter_in_fec_column == FALSE) {
-            syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                          "a=source-filter line not being specified in first "
                          "FEC stream. " USE_IN_ADDR_ANY);
         }
@@ -3213,7 +3269,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                      "RTP port being the same as RTCP port for "
                      "first FEC stream. "
                      "Check m= line and a=rtcp line.");
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -3227,7 +3283,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
             channel_p->fec_stream1.multicast_addr.s_addr) {
             if (channel_p->original_source_port == 
                 channel_p->fec_stream1.rtp_port) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "the RTP port being the same in first FEC "
                              "stream as original source stream.");
                 return FALSE;
@@ -3235,7 +3291,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
             if (channel_p->original_source_port == 
                 channel_p->fec_stream1.rtcp_port) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "the RTCP port being the same in first FEC "
                              "stream as RTP port in original source stream.");
                 return FALSE;
@@ -3243,7 +3299,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
             if (channel_p->original_source_rtcp_port == 
                 channel_p->fec_stream1.rtcp_port) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "the RTCP port being the same in first FEC "
                              "stream as original source stream.");
                 return FALSE;
@@ -3251,7 +3307,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
             if (channel_p->original_source_rtcp_port == 
                 channel_p->fec_stream1.rtp_port) {
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              "the RTP port being the same in first FEC "
                              "stream as RTCP port in original source stream.");
                 return FALSE;
@@ -3261,7 +3317,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         if (channel_p->fec_mode == FEC_2D_MODE) {
             /* The source filter must be present for FEC stream2. */
             if (found_src_filter_in_fec_row == FALSE) {
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              "a=source-filter line not being specified in "
                              "second FEC stream. " USE_IN_ADDR_ANY);
             }
@@ -3272,7 +3328,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                          "RTP port being the same as RTCP port for "
                          "second FEC stream. "
                          "Check m= line and a=rtcp line.");
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3286,7 +3342,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 channel_p->fec_stream2.multicast_addr.s_addr) {
                 if (channel_p->original_source_port == 
                     channel_p->fec_stream2.rtp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTP port being the same in second FEC "
                                  "stream as original source stream.");
                     return FALSE;
@@ -3294,7 +3350,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
                 if (channel_p->original_source_port == 
                     channel_p->fec_stream2.rtcp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTCP port being the same in second FEC "
                                  "stream as RTP port in original source "
                                  "stream.");
@@ -3303,7 +3359,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
                 if (channel_p->original_source_rtcp_port == 
                     channel_p->fec_stream2.rtcp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTCP port being the same in second FEC "
                                  "stream as original source stream.");
                     return FALSE;
@@ -3311,7 +3367,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
                 if (channel_p->original_source_rtcp_port == 
                     channel_p->fec_stream2.rtp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTP port being the same in second FEC "
                                  "stream as RTCP port in original source "
                                  "stream.");
@@ -3323,7 +3379,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 channel_p->fec_stream2.multicast_addr.s_addr) {
                 if (channel_p->fec_stream1.rtp_port == 
                     channel_p->fec_stream2.rtp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTP port being the same in second FEC "
                                  "stream as first FEC stream.");
                     return FALSE;
@@ -3331,7 +3387,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
                 if (channel_p->fec_stream1.rtp_port == 
                     channel_p->fec_stream2.rtcp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTCP port being the same in second FEC "
                                  "stream as RTP port in first FEC stream.");
                     return FALSE;
@@ -3339,7 +3395,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
                 if (channel_p->fec_stream1.rtcp_port == 
                     channel_p->fec_stream2.rtp_port) {
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTP port being the same in second FEC "
                                  "stream as RTCP port in first FEC stream.");
                     return FALSE;
@@ -3348,7 +3404,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
                 if ((channel_p->fec_stream1.rtcp_port == 
                      channel_p->fec_stream2.rtcp_port) &&
                     (channel_p->fec_stream1.rtcp_port != 0)){
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  "the RTCP port being the same in second FEC "
                                  "stream as first FEC stream.");
                     return FALSE;
@@ -3360,7 +3416,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
     /* Check whether the XR options are supported in current release or not */
     if ((channel_p->original_rtcp_xr_stat_flags & RTCP_XR_UNSUPPORTED_OPT_MASK)
         != 0) {
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "some unsupported values specified in stat-summary "
                      "of rtcp-xr attribute for original stream. "
                      "Currently, only loss, dup, and jitt are supported.");
@@ -3369,7 +3425,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
 
     if ((channel_p->repair_rtcp_xr_stat_flags & RTCP_XR_UNSUPPORTED_OPT_MASK)
         != 0) {
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "some unsupported values specified in stat-summary "
                      "of rtcp-xr attribute for retransmission stream. "
                      "Currently, only loss, dup, and jitt are supported.");
@@ -3380,7 +3436,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
        without any repair mechanism enabled */
     if (channel_p->mode == RECV_ONLY_MODE && channel_p->fec_enable != TRUE) {
         if (channel_p->original_rtcp_xr_per_loss_rle != RTCP_RLE_UNSPECIFIED) {
-            syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                          "post repair Loss RLE being enabled in receive-only "
                          "mode.");
         }
@@ -3390,7 +3446,7 @@ static boolean linear_validation_and_extraction (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "AS bandwidth being missing in original stream. "
                  CHECK_DOCUMENT);
-        syslog_print(CFG_VALIDATION_ERR,
+        cfg_chan_log(CFG_VALIDATION_ERR,
                      channel_p->session_key,
                      message_buffer);
         return FALSE;
@@ -3481,7 +3537,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "reaching the maximum version number (%llu) allowed "
                  "in o= line. " CHECK_DOCUMENT, MAX_VERSION_ALLOWED);
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      message_buffer);
         return FALSE;
     }
@@ -3490,7 +3546,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
     /* For now we only support IN and IP4 */
     if (sdp_get_owner_network_type(sdp_p) != SDP_NT_INTERNET ||
         sdp_get_owner_address_type(sdp_p) != SDP_AT_IP4) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "an unsupported network type or address type. "
                      "Currently only IN and IP4 are allowed.");
         return FALSE;
@@ -3507,7 +3563,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                  "%d missing media session(s) [minimum %d sessions are "
                  "required.] " CHECK_DOCUMENT, MIN_VOD_SESSIONS-num_sessions,
                  MIN_VOD_SESSIONS);
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      message_buffer);
         return FALSE;
     }
@@ -3543,7 +3599,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                      "failed to get the total number of attributes "
                      "in media session %d.",
                      media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -3579,7 +3635,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                          "m= line of media session %d has invalid "
                          "payload type %d. " CHECK_DOCUMENT,
                          media_session_idx, payload_type);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3591,7 +3647,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                      "specified. Currently, only one stream per session "
                      "is allowed.",
                      media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -3606,7 +3662,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "primary source stream has no bandwidth "
                              "line specified. b=AS:<> line must be present.");
-                    syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                                  message_buffer);
                     return FALSE;
                 }
@@ -3621,7 +3677,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "an unsupported stream type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              message_buffer);
 
                 break;
@@ -3636,7 +3692,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                          "bandwidth for media session %d "
                          "exceeds the max value %d. " CHECK_DOCUMENT,
                          media_session_idx, MAX_BW_ALLOWED);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3649,7 +3705,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "AS bandwidth in primary media session "
                                      "less than the min value %d required. "
                                      CHECK_DOCUMENT, MIN_BIT_RATE_ALLOWED);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -3660,7 +3716,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "AS bandwidth in primary media session "
                                      "exceeds the max value %d. "
                                      CHECK_DOCUMENT, MAX_BIT_RATE_ALLOWED);
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -3674,7 +3730,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "in media session %d other than primary "
                                  "media session.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3697,7 +3753,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "RS bandwidth specified in "
                                      "unknown media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN, message_buffer);
+                            cfg_chan_log(CFG_VALIDATION_WARN, message_buffer);
                     }
                      
                     break;
@@ -3717,7 +3773,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "RR bandwidth specified in "
                                      "unknown media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN, message_buffer);
+                            cfg_chan_log(CFG_VALIDATION_WARN, message_buffer);
                     }
 
                     break;
@@ -3727,7 +3783,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                              "an unsupported bandwidth modifier "
                              "in media session %d. "
                              CHECK_DOCUMENT, media_session_idx);
-                    syslog_print(CFG_VALIDATION_WARN,
+                    cfg_chan_log(CFG_VALIDATION_WARN,
                                  channel_p->session_key,
                                  message_buffer);
             }
@@ -3743,7 +3799,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                      "an illegal connection address %s in c= line of "
                      "media session %d. " CHECK_DOCUMENT,
                      conn_address, media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          message_buffer);
             return FALSE;
@@ -3755,7 +3811,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                      "an illegal RTP port number %d in m= line of "
                      "media session %d. " CHECK_DOCUMENT,
                      rtp_port, media_session_idx);
-            syslog_print(CFG_VALIDATION_ERR,
+            cfg_chan_log(CFG_VALIDATION_ERR,
                          channel_p->session_key,
                          message_buffer);
             return FALSE;
@@ -3778,7 +3834,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                              "an illegal connection address %s in "
                              "c= line of unicast retransmission stream. "
                              CHECK_DOCUMENT, conn_address);
-                    syslog_print(CFG_VALIDATION_ERR,
+                    cfg_chan_log(CFG_VALIDATION_ERR,
                                  channel_p->session_key,
                                  message_buffer);
                     return FALSE;
@@ -3792,7 +3848,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "an unsupported stream type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                              message_buffer);
         }
 
@@ -3808,7 +3864,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                 snprintf(message_buffer, MAX_MSG_LENGTH,
                          "failing to get attribute type in media session %d.",
                          media_session_idx);
-                syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+                cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                              message_buffer);
                 return FALSE;
             }
@@ -3828,7 +3884,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "type %d in a=rtpmap:<> line. "
                                  CHECK_DOCUMENT,
                                  media_session_idx, payload_type);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3849,7 +3905,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -3861,7 +3917,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "in media session %d. "
                                  "Check m= line and a=rtpmap line.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3881,7 +3937,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "a=rtcp line of media session %d. "
                                  CHECK_DOCUMENT,
                                  rtcp_port, media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3899,7 +3955,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "failing to get connection "
                                  "address for RTCP in media session %d.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3915,7 +3971,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "in a=rtcp line of media "
                                  "session %d. " CHECK_DOCUMENT,
                                  dest_address, media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -3943,7 +3999,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                          "session %d from c= line. " 
                                          CHECK_DOCUMENT,
                                          dest_address, media_session_idx);
-                                syslog_print(CFG_VALIDATION_WARN,
+                                cfg_chan_log(CFG_VALIDATION_WARN,
                                              channel_p->session_key,
                                              message_buffer);
                             }
@@ -3954,7 +4010,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -3976,7 +4032,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "failed to get RTCP feedback parameters "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_ERR, 
+                            cfg_chan_log(CFG_VALIDATION_ERR, 
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -3988,7 +4044,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                             snprintf(message_buffer, MAX_MSG_LENGTH,
                                      "a=rtcp-fb line present for non-"
                                      "RTP/AVPF media session. ");
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -4001,7 +4057,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "mismatched payload type "
                                      "in primary media session. "
                                      "Check m= line and a=rtcp-fb line.");
-                            syslog_print(CFG_VALIDATION_ERR,
+                            cfg_chan_log(CFG_VALIDATION_ERR,
                                          channel_p->session_key,
                                          message_buffer);
                             return FALSE;
@@ -4015,7 +4071,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                             snprintf(message_buffer, MAX_MSG_LENGTH,
                                      "unsupported RTCP feedback parameter. "
                                      "'nack pli' not supported for VoD.");
-                            syslog_print(CFG_VALIDATION_WARN, 
+                            cfg_chan_log(CFG_VALIDATION_WARN, 
                                          channel_p->session_key,
                                          message_buffer);
                         }
@@ -4025,7 +4081,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                  "an illegal RTCP feedback specified in "
                                  "media session %d.",
                                  media_session_idx);
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      message_buffer);
                         return FALSE;
@@ -4067,7 +4123,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                              "in unicast retransmission "
                                              "session. "
                                              "Check m= line and a=fmtp line.");
-                                    syslog_print(CFG_VALIDATION_ERR,
+                                    cfg_chan_log(CFG_VALIDATION_ERR,
                                                  channel_p->session_key,
                                                  message_buffer);
                                     return FALSE;
@@ -4099,7 +4155,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                          "an illegal FMTP specified in "
                                          "media session %d.",
                                          media_session_idx);
-                                syslog_print(CFG_VALIDATION_ERR,
+                                cfg_chan_log(CFG_VALIDATION_ERR,
                                              channel_p->session_key,
                                              message_buffer);
                                 return FALSE;
@@ -4110,7 +4166,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                         snprintf(message_buffer, MAX_MSG_LENGTH,
                                  "FMTP not allowed in media "
                                  "session %d.", media_session_idx);
-                        syslog_print(CFG_VALIDATION_WARN,
+                        cfg_chan_log(CFG_VALIDATION_WARN,
                                      channel_p->session_key,
                                      message_buffer);
                     }
@@ -4176,7 +4232,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                      "an unsupported stream type "
                                      "in media session %d.",
                                      media_session_idx);
-                            syslog_print(CFG_VALIDATION_WARN,
+                            cfg_chan_log(CFG_VALIDATION_WARN,
                                          channel_p->session_key,
                                          message_buffer);
                             break;
@@ -4188,7 +4244,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                     snprintf(message_buffer, MAX_MSG_LENGTH,
                              "an unsupported attribute in media session %d.",
                              media_session_idx);
-                    syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+                    cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                                  message_buffer);
             }
         }
@@ -4196,7 +4252,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
 
     /* Check that primary media present */
     if (!prim_found) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "Primary media section missing from SDP. "
                      CHECK_DOCUMENT);
         return FALSE;
@@ -4213,7 +4269,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                                                     0, j);
                 /* We only support group of two streams for now */
                 if (num_group_id != 2) {
-                    syslog_print(CFG_VALIDATION_ERR,
+                    cfg_chan_log(CFG_VALIDATION_ERR,
                                  channel_p->session_key,
                                  "only two group ids allowed in FID "
                                  "attribute. " CHECK_DOCUMENT);
@@ -4233,7 +4289,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                     /* Check that media identifiers are valid */
                     if (group_id[ORIGINAL_STREAM][0] == '\0' ||
                         group_id[UNICAST_RTX_STREAM][0] == '\0') {
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      "primary or retransmission "
                                      "missing mid attribute.");
@@ -4248,7 +4304,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
                         strstr(group_label,
                                group_id[UNICAST_RTX_STREAM])
                         == NULL) {
-                        syslog_print(CFG_VALIDATION_ERR,
+                        cfg_chan_log(CFG_VALIDATION_ERR,
                                      channel_p->session_key,
                                      "FID attribute not matching "
                                      "session stream definition. "
@@ -4266,7 +4322,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
 
     /* Check for group FID line */
     if (rtx_found && !found_fid) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "missing FID attribute (a=group:FID)",
                      CHECK_DOCUMENT);
         return FALSE;
@@ -4276,7 +4332,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
     /* the correct association */
     if (rtx_found && (channel_p->original_source_payload_type !=
         channel_p->rtx_apt)) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "a=fmtp:<payload> apt= line being incorrectly "
                      "specified in unicast retransmission stream. "
                      CHECK_DOCUMENT);
@@ -4289,7 +4345,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "the rtx address differs from the FBT "
                  "address in the primary media section. " CHECK_DOCUMENT);
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      message_buffer);
     }
 
@@ -4303,7 +4359,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
             snprintf(message_buffer, MAX_MSG_LENGTH,
                      "bandwidth being turned off. No unicast error "
                      "repair is enabled. " CHECK_DOCUMENT);
-            syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                          message_buffer);
             channel_p->er_enable = FALSE;
             channel_p->fcc_enable = FALSE;
@@ -4313,7 +4369,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
     /* Check whether the XR options are supported in current release or not */
     if ((channel_p->original_rtcp_xr_stat_flags & RTCP_XR_UNSUPPORTED_OPT_MASK)
         != 0) {
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "some unsupported values specified in stat-summary "
                      "of rtcp-xr attribute for original stream. "
                      "Currently, only loss, dup, and jitt are supported.");
@@ -4321,7 +4377,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
     }
     if ((channel_p->repair_rtcp_xr_stat_flags & RTCP_XR_UNSUPPORTED_OPT_MASK)
         != 0) {
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "some unsupported values specified in stat-summary "
                      "of rtcp-xr attribute for retransmission stream. "
                      "Currently, only loss, dup, and jitt are supported.");
@@ -4333,7 +4389,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "AS bandwidth being missing in original stream. "
                  CHECK_DOCUMENT);
-        syslog_print(CFG_VALIDATION_ERR,
+        cfg_chan_log(CFG_VALIDATION_ERR,
                      channel_p->session_key,
                      message_buffer);
         return FALSE;
@@ -4341,7 +4397,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
 
     /* Check that retransmission media present */
     if (!rtx_found && (found_fid || channel_p->er_enable)) {
-        syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                      "Retransmission section missing from SDP. "
                      CHECK_DOCUMENT);
         return FALSE;
@@ -4354,7 +4410,7 @@ static boolean vod_validation_and_extraction (void *sdp_p,
         channel_p->rtx_addr.s_addr ||
         channel_p->rtx_rtp_port ||
         channel_p->rtx_rtcp_port) {
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      "Transport parameters present in SDP for VoD. "
                      CHECK_DOCUMENT);
     }
@@ -4584,7 +4640,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
         snprintf(message_buffer, MAX_MSG_LENGTH,
                  "m= line of media session %d not being a video type. "
                  "Currently, only vedeo type is supported.", index);
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      message_buffer);
         return MAX_SESSIONS;
     }
@@ -4600,7 +4656,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                  "failing to get the total number of attributes "
                  "in media session %d.",
                  index);
-        syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+        cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                      message_buffer);
         return MAX_SESSIONS;
     }
@@ -4611,7 +4667,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
             snprintf(message_buffer, MAX_MSG_LENGTH,
                      "failing to get attribute type in media session %d.",
                      index);
-            syslog_print(CFG_VALIDATION_WARN, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_WARN, channel_p->session_key,
                          message_buffer);
             return MAX_SESSIONS;
         }
@@ -4628,7 +4684,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                              "an unsupported clock rate "
                              "in a=rtpmap line of media session %d. "
                              CHECK_DOCUMENT, index);
-                    syslog_print(CFG_VALIDATION_WARN,
+                    cfg_chan_log(CFG_VALIDATION_WARN,
                                  channel_p->session_key,
                                  message_buffer);
                     return MAX_SESSIONS;
@@ -4650,7 +4706,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                                  "an illegal media protocol or address "
                                  "in m= line of media session %d"
                                  CHECK_DOCUMENT, index);
-                        syslog_print(CFG_VALIDATION_WARN,
+                        cfg_chan_log(CFG_VALIDATION_WARN,
                                      channel_p->session_key,
                                      message_buffer);
                         return MAX_SESSIONS;
@@ -4685,7 +4741,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                                  "an illegal media protocol or address "
                                  "in m= line of media session %d"
                                  CHECK_DOCUMENT, index);
-                        syslog_print(CFG_VALIDATION_WARN,
+                        cfg_chan_log(CFG_VALIDATION_WARN,
                                      channel_p->session_key,
                                      message_buffer);
                         return MAX_SESSIONS;
@@ -4710,7 +4766,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                                  "an illegal media protocol or address "
                                  "in m= line of media session %d"
                                  CHECK_DOCUMENT, index);
-                        syslog_print(CFG_VALIDATION_WARN,
+                        cfg_chan_log(CFG_VALIDATION_WARN,
                                      channel_p->session_key,
                                      message_buffer);
                         return MAX_SESSIONS;
@@ -4721,7 +4777,7 @@ static session_type_e figure_out_session_type (void *sdp_p,
                              "an unsupported encoded name "
                              "defined in a=rtpmap line of media session %d. "
                              CHECK_DOCUMENT, index);
-                    syslog_print(CFG_VALIDATION_WARN,
+                    cfg_chan_log(CFG_VALIDATION_WARN,
                                  channel_p->session_key,
                                  message_buffer);
                     return MAX_SESSIONS;
@@ -4788,7 +4844,7 @@ boolean check_rtcp_port(in_port_t *rtp, in_port_t *rtcp,
                      "RTP port being 65535 for %s stream "
                      "and no RTCP port being specified. "
                      CHECK_DOCUMENT, stream_name);
-            syslog_print(CFG_VALIDATION_ERR, channel_p->session_key,
+            cfg_chan_log(CFG_VALIDATION_ERR, channel_p->session_key,
                          message_buffer);
             return FALSE;
         }
@@ -4799,26 +4855,6 @@ boolean check_rtcp_port(in_port_t *rtp, in_port_t *rtcp,
 }
 
 
-/* Function:    cp_fec
- * Description: Copy all the info for FEC stream
- * Parameters:  dest    FEC stream configuration data
- *              src     FEC stream configuration data
- * Returns:     N/A
- */
-static void cp_fec (fec_stream_cfg_t *dest, fec_stream_cfg_t *src)
-{
-    if (src != NULL && dest != NULL) {
-        dest->multicast_addr.s_addr = src->multicast_addr.s_addr;
-        dest->src_addr.s_addr = src->src_addr.s_addr;
-        dest->rtp_port = src->rtp_port;
-        dest->rtcp_port = src->rtcp_port;
-        dest->payload_type = src->payload_type;
-        dest->rtcp_sndr_bw = src->rtcp_sndr_bw;
-        dest->rtcp_rcvr_bw = src->rtcp_rcvr_bw;
-    }
-}
-
-
 /* Function:    cfg_channel_parse_session_key
  * Description: Parse internal session_key
  * Parameters:  p_channel  pointer to the channel configuration
@@ -4918,6 +4954,67 @@ boolean cfg_channel_extract(void *sdp_p,
 }
 
 
+/* Function:    cfg_chan_quiet_key_init
+ * Description: Create the key of the per-thread quiet flag
+ * Parameters:  N/A
+ * Returns:     N/A
+ */
+static void cfg_chan_quiet_key_init (void)
+{
+    (void)pthread_key_create(&cfg_chan_quiet_key, NULL);
+}
+
+
+/* Function:    cfg_chan_quiet_flag
+ * Description: Get the quiet flag of the calling thread
+ * Parameters:  N/A
+ * Returns:     The flag to set instead of logging, or NULL to log
+ */
+static boolean *cfg_chan_quiet_flag (void)
+{
+    (void)pthread_once(&cfg_chan_quiet_once, cfg_chan_quiet_key_init);
+    return (boolean *)pthread_getspecific(cfg_chan_quiet_key);
+}
+
+
+/* Function:    cfg_channel_extract_quiet
+ * Description: Validate and extract a linear channel on a lineup worker
+ *              thread.  Nothing is logged; logged_p is set instead if the
+ *              validation had anything to log, in which case the session
+ *              should be validated again with cfg_channel_add so that the
+ *              messages are logged in lineup order.
+ * Parameters:  sdp_p        Pointer to SDP description
+ *              channel_p    Pointer to the channel configuration
+ *              session_key  Buffer of MAX_KEY_LENGTH for the session key
+ *              logged_p     Set TRUE if the validation had anything to log
+ * Returns:     TRUE if the channel is valid, FALSE otherwise
+ */
+boolean cfg_channel_extract_quiet (void *sdp_p,
+                                   channel_cfg_t *channel_p,
+                                   char *session_key,
+                                   boolean *logged_p)
+{
+    boolean valid_sdp;
+
+    *logged_p = FALSE;
+    if (sdp_p == NULL || channel_p == NULL) {
+        return FALSE;
+    }
+
+    make_session_key(sdp_p, session_key);
+
+    /* Clean up the memory */
+    memset(channel_p, 0, sizeof(channel_cfg_t));
+
+    (void)pthread_once(&cfg_chan_quiet_once, cfg_chan_quiet_key_init);
+    (void)pthread_setspecific(cfg_chan_quiet_key, logged_p);
+    valid_sdp = linear_validation_and_extraction(sdp_p, channel_p);
+    (void)pthread_setspecific(cfg_chan_quiet_key, NULL);
+
+    return valid_sdp;
+}
+
+
 #define MAX_RTP_PKT_SIZE 1370
 #define AVE_RTCP_PKT_SIZE 100
 #define BITS_PER_BYTE 8
@@ -4960,13 +5057,13 @@ static boolean possible_lose_xr_data (channel_cfg_t *channel_p)
                 return FALSE;
             }
         } else {
-            syslog_print(CFG_VALIDATION_WARN,
+            cfg_chan_log(CFG_VALIDATION_WARN,
                          channel_p->session_key,
                          "no RTCP per-receiver bandwidth specified.");
             return FALSE;
         }
     } else {
-        syslog_print(CFG_VALIDATION_ERR,
+        cfg_chan_log(CFG_VALIDATION_ERR,
                      channel_p->session_key,
                      "empty channel config data pointer.");
         return FALSE;
@@ -132,6 +132,17 @@ extern cfg_channel_ret_e cfg_channel_add(void *sdp_p,
                                          idmgr_id_t *channel_handle,
                                          uint32_t checksum);
 
+/**
+ * Add a channel extracted by cfg_channel_extract_quiet to the channel
+ * manager
+ */
+extern cfg_channel_ret_e cfg_channel_add_extracted(const char *session_key,
+                                                   channel_cfg_t *extracted_p,
+                                                   boolean valid,
+                                                   channel_mgr_t *channel_mgr_p,
+                                                   idmgr_id_t *channel_handle,
+                                                   uint32_t checksum);
+
 /**
  * Delete a channel from the channel manager
  */
@@ -164,6 +175,12 @@ extern cfg_channel_ret_e cfg_channel_del_map(channel_mgr_t *channel_mgr_p,
 extern channel_cfg_t *cfg_channel_get(channel_mgr_t *channel_mgr_p,
                                       idmgr_id_t channel_handle);
 
+/**
+ * Get a channel from the channel manager based on its session key
+ */
+extern channel_cfg_t *cfg_channel_find(channel_mgr_t *channel_mgr_p,
+                                       const char *session_key);
+
 /**
  * Print out a channel configuration info
  */
@@ -206,4 +223,13 @@ extern boolean cfg_channel_extract(void *sdp_p,
                                    channel_cfg_t *channel_p,
                                    cfg_chan_type_e chan_type);
 
+/**
+ * Extract and validate a linear channel without logging, on a lineup
+ * worker thread
+ */
+extern boolean cfg_channel_extract_quiet(void *sdp_p,
+                                         channel_cfg_t *channel_p,
+                                         char *session_key,
+                                         boolean *logged_p);
+
 #endif /* _CFG_CHANNEL_H_ */
@@ -10,6 +10,7 @@
  */
 
 #include <unistd.h>
+#include <pthread.h>
 
 #include "cfgapi.h"
 #include "cfg_channel.h"
@@ -47,6 +48,10 @@ static channel_mgr_t new_channel_mgr;
 
 static uint32_t g_lastUsedChannel = 0;
 
+/* Number of threads a lineup is parsed with; 0 or 1 parses it serially */
+#define CFG_MAX_PARSE_THREADS 16
+static uint32_t g_parse_threads = 0;
+
 static boolean file_exists(const char* filename);
 
 static boolean parse_sdp_o_line(const char* o_line,
@@ -73,6 +78,7 @@ static uint32_t cfg_session_key_hash_func(uint8_t *key,
 cfg_ret_e cfg_init (const char* cfg_db_name)
 {
     char message[MAX_LINE_LENGTH];
+    boolean write_snapshot = FALSE;
 
     VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
                   "cfg_init:: Opening the database %s\n", cfg_db_name);
@@ -139,11 +145,17 @@ cfg_ret_e cfg_init (const char* cfg_db_name)
             return CFG_OPEN_FAILED;
         }
 
-        /* Read the channel info from database */
-        if (cfg_db_read_channels(&system_cfg.config_db,
+        /* Load the channel info from the snapshot of the database if
+           it is current, otherwise parse the database */
+        if (cfg_db_read_snapshot(&system_cfg.config_db,
                                  &system_cfg.channel_mgr) != CFG_DB_SUCCESS) {
-            syslog_print(CFG_FILE_READ_CRIT, cfg_db_name);
-            return CFG_FAILURE;
+            if (cfg_db_read_channels(&system_cfg.config_db,
+                                     &system_cfg.channel_mgr) 
+                != CFG_DB_SUCCESS) {
+                syslog_print(CFG_FILE_READ_CRIT, cfg_db_name);
+                return CFG_FAILURE;
+            }
+            write_snapshot = TRUE;
         }
         
         /* Clean up the channel strucuture if not all the channels pass
@@ -186,6 +198,16 @@ cfg_ret_e cfg_init (const char* cfg_db_name)
         else {
             /* Remeber the time the configuration data is read */
             system_cfg.channel_mgr.timestamp = get_sys_time();
+
+            /* Save the parsed channels for the next start */
+            if (write_snapshot &&
+                cfg_db_write_snapshot(&system_cfg.config_db,
+                                      &system_cfg.channel_mgr)
+                != CFG_DB_SUCCESS) {
+                VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                              "cfg_init:: Could not save a snapshot of "
+                              "%s\n", cfg_db_name);
+            }
         }
     }
     else if (cfg_db_name) {
@@ -1228,6 +1250,476 @@ int read_line (char *line_buffer,
 }
 
 
+/* Function:    cfg_find_unchanged_channel
+ * Description: Find the channel of the current lineup that a session of
+ *              an update leaves unchanged, i.e. with the same o= line
+ *              identity and the same content checksum
+ * Parameters:  o_line          o= line of the session
+ *              chksum          Checksum of the session
+ * Returns:     Pointer to a channel configuration data structure or NULL
+ */
+static channel_cfg_t *cfg_find_unchanged_channel (const char *o_line,
+                                                  uint32_t chksum)
+{
+    char username[SDP_MAX_STRING_LEN];
+    char session_id[SDP_MAX_STRING_LEN];
+    char nettype[SDP_MAX_TYPE_LEN];
+    char addrtype[SDP_MAX_TYPE_LEN];
+    char creator_addr[SDP_MAX_STRING_LEN];
+    char session_key[MAX_KEY_LENGTH];
+    channel_cfg_t *channel_p;
+
+    if (o_line[0] == '\0' ||
+        !parse_sdp_o_line(o_line, username, session_id, 
+                          nettype, addrtype, creator_addr)) {
+        return NULL;
+    }
+
+    snprintf(session_key, MAX_KEY_LENGTH, "INIP4#%s#%s#%s",
+             username, session_id, creator_addr);
+    channel_p = cfg_channel_find(&system_cfg.channel_mgr, session_key);
+
+    /* A session repeated in the update is parsed to be reported */
+    if (channel_p && channel_p->active && channel_p->chksum == chksum &&
+        cfg_channel_find(&new_channel_mgr, session_key) == NULL) {
+        return channel_p;
+    }
+
+    return NULL;
+}
+
+
+/* Function:    cfg_init_lineup_sdp_config
+ * Description: Set up the SDP configuration the sessions of a lineup
+ *              are parsed with
+ * Parameters:  N/A
+ * Returns:     The SDP configuration or NULL
+ */
+static void *cfg_init_lineup_sdp_config (void)
+{
+    void        *sdp_cfg_p;
+
+    sdp_cfg_p = sdp_init_config();
+    if (sdp_cfg_p == NULL) {
+        return NULL;
+    }
+
+    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_TRACE, FALSE);
+    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_WARNINGS, FALSE);
+    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_ERRORS, FALSE);
+
+    sdp_require_version(sdp_cfg_p, TRUE);
+    sdp_require_owner(sdp_cfg_p, TRUE);
+    sdp_require_session_name(sdp_cfg_p, TRUE);
+    sdp_require_timespec(sdp_cfg_p, TRUE);
+
+    sdp_media_supported(sdp_cfg_p, SDP_MEDIA_VIDEO, TRUE);
+
+    sdp_nettype_supported(sdp_cfg_p, SDP_NT_INTERNET, TRUE);    
+    sdp_addrtype_supported(sdp_cfg_p, SDP_AT_IP4, TRUE);
+   
+    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_UDP, TRUE);
+    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_RTPAVP, TRUE);
+    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_RTPAVPF, TRUE);
+    
+    sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_CONN_ADDR, TRUE);
+    sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_PORTNUM, TRUE);
+
+    return sdp_cfg_p;
+}
+
+
+/*
+ * A session of a lineup parsed with worker threads.  The workers parse
+ * and validate the sessions ahead of the merge into the new channel
+ * manager; a session a worker could not finish without logging is left
+ * for the merge to parse again, so that the messages come out in lineup
+ * order just as when the lineup is parsed serially.
+ */
+typedef struct cfg_lineup_session_ {
+    char                *o_line;        /* o= line of the session */
+    char                *session;       /* The session in SDP syntax */
+    uint32_t            chksum;         /* Checksum, if extracted */
+    boolean             extracted;      /* Validated by a worker */
+    boolean             valid;          /* Passed the validation */
+    char                session_key[MAX_KEY_LENGTH];
+    channel_cfg_t       channel;        /* Channel extracted by a worker */
+} cfg_lineup_session_t;
+
+typedef struct cfg_lineup_ {
+    cfg_lineup_session_t *sessions;
+    uint32_t            num_sessions;
+    uint32_t            max_sessions;
+} cfg_lineup_t;
+
+typedef struct cfg_lineup_worker_ {
+    pthread_t           thread;
+    boolean             started;
+    void                *sdp_cfg_p;
+    void                *sdp_arena_p;
+    cfg_lineup_session_t *sessions;
+    uint32_t            num_sessions;
+} cfg_lineup_worker_t;
+
+
+/* Function:    cfg_parse_update_session
+ * Description: Parse and validate a session of an update into the new
+ *              channel manager.  A session which is unchanged from the
+ *              current lineup is not parsed again: the configuration of
+ *              the channel is copied instead.
+ * Parameters:  sdp_cfg_p       SDP configuration for parsing
+ *              sdp_arena_p     SDP arena the session is parsed into; it is
+ *                              reset once the session has been stored
+ *              o_line          o= line of the session
+ *              session_buffer  The session in SDP syntax
+ *              lineup_session_p  The session as handled by a lineup
+ *                              worker, or NULL
+ * Returns:     Success or failure codes
+ */
+static cfg_ret_e cfg_parse_update_session (void *sdp_cfg_p,
+                                           void *sdp_arena_p,
+                                           const char *o_line,
+                                           char *session_buffer,
+                                           cfg_lineup_session_t
+                                           *lineup_session_p)
+{
+    cfg_channel_ret_e status;
+    void        *sdp_p = NULL;
+    idmgr_id_t  handle;
+    uint32_t    chksum;
+    boolean     parsed;
+    boolean     syntax_error = FALSE;
+    channel_cfg_t *channel_p;
+
+    new_channel_mgr.num_input_channels++;
+
+    /* Compute MD5 checksum */
+    if (lineup_session_p && lineup_session_p->extracted) {
+        chksum = lineup_session_p->chksum;
+    } else {
+        chksum = cfg_db_checksum(session_buffer, strlen(session_buffer));
+    }
+
+    channel_p = cfg_find_unchanged_channel(o_line, chksum);
+    if (channel_p) {
+        channel_p = cfg_channel_insert(&new_channel_mgr, channel_p);
+        if (channel_p) {
+            new_channel_mgr.num_parsed++;
+            new_channel_mgr.num_validated++;
+
+            VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                          "cfg_parse_update_session:: Channel %s "
+                          "is unchanged\n",
+                          channel_p->session_key);
+            return CFG_SUCCESS;
+        }
+        /* Otherwise parse it to report the failure */
+    }
+
+    if (lineup_session_p && lineup_session_p->extracted) {
+        /* Already parsed and validated by a lineup worker */
+        parsed = TRUE;
+    } else {
+        /* Create a SDP structure for this session */
+        sdp_p  = sdp_init_description_arena(sdp_cfg_p, sdp_arena_p);
+        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                      "cfg_parse_update_session:: Creating SDP session "
+                      "%p\n", sdp_p);
+
+        if (sdp_p == NULL) {
+            syslog_print(CFG_MALLOC_ERR);
+            return CFG_MALLOC_ERR;
+        }
+
+        /* Parse and validate SDP description in the session */
+        parsed = cfg_db_parse_SDP(sdp_p, session_buffer, &syntax_error);
+    }
+
+    if (parsed) {
+        /* Increase number of channels passing the parser */
+        new_channel_mgr.num_parsed++;
+
+        /* Store it in the channel manager */
+        if (sdp_p) {
+            status = cfg_channel_add(sdp_p, &new_channel_mgr, &handle,
+                                     chksum);
+        } else {
+            status = cfg_channel_add_extracted(
+                lineup_session_p->session_key,
+                &lineup_session_p->channel,
+                lineup_session_p->valid,
+                &new_channel_mgr, &handle, chksum);
+        }
+        if (status != CFG_CHANNEL_SUCCESS) {
+            if (status != CFG_CHANNEL_EXIST) {
+                VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                              "cfg_parse_update_session:: Failed to "
+                              "add the channel.\n");
+                VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL,
+                              "SDP Session = \n%s\n",
+                              session_buffer);
+            }
+        }
+        else {
+            /* Increase number of channels passing */
+            /* the validation */
+            new_channel_mgr.num_validated++;
+
+            VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                          "cfg_parse_update_session:: New channel "
+                          "0x%lx is being added\n",
+                          handle);
+        }
+    }
+    else {
+        if (syntax_error) {
+            new_channel_mgr.num_syntax_errors++;
+        }
+        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                      "cfg_parse_update_session:: Failed to create "
+                      "SDP session for the channel.\n");
+        VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL,
+                      "Raw data = \n%s\n", 
+                      session_buffer);
+    }
+
+    /* Delete the SDP data */
+    if (sdp_p) {
+        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                      "cfg_parse_update_session:: Deleting SDP "
+                      "session %p\n",
+                      sdp_p);
+        sdp_free_description(sdp_p);
+        sdp_reset_arena(sdp_arena_p);
+    }
+
+    return CFG_SUCCESS;
+}
+
+
+/* Function:    cfg_lineup_add_session
+ * Description: Append a session to a lineup to be parsed with worker
+ *              threads
+ * Parameters:  lineup_p        The lineup
+ *              o_line          o= line of the session
+ *              session_buffer  The session in SDP syntax
+ * Returns:     TRUE or FALSE if the memory could not be allocated
+ */
+static boolean cfg_lineup_add_session (cfg_lineup_t *lineup_p,
+                                       const char *o_line,
+                                       const char *session_buffer)
+{
+    cfg_lineup_session_t *sessions;
+    cfg_lineup_session_t *session_p;
+    uint32_t    max_sessions;
+
+    if (lineup_p->num_sessions == lineup_p->max_sessions) {
+        max_sessions = lineup_p->max_sessions ?
+            2 * lineup_p->max_sessions : 64;
+        sessions = realloc(lineup_p->sessions,
+                           max_sessions * sizeof(cfg_lineup_session_t));
+        if (sessions == NULL) {
+            return FALSE;
+        }
+        lineup_p->sessions = sessions;
+        lineup_p->max_sessions = max_sessions;
+    }
+
+    session_p = &lineup_p->sessions[lineup_p->num_sessions];
+    memset(session_p, 0, sizeof(cfg_lineup_session_t));
+    session_p->o_line = strdup(o_line);
+    session_p->session = strdup(session_buffer);
+    if (session_p->o_line == NULL || session_p->session == NULL) {
+        free(session_p->o_line);
+        free(session_p->session);
+        return FALSE;
+    }
+
+    lineup_p->num_sessions++;
+    return TRUE;
+}
+
+
+/* Function:    cfg_lineup_free
+ * Description: Free the sessions of a lineup
+ * Parameters:  lineup_p        The lineup or NULL
+ * Returns:     N/A
+ */
+static void cfg_lineup_free (cfg_lineup_t *lineup_p)
+{
+    uint32_t    i;
+
+    if (lineup_p == NULL) {
+        return;
+    }
+
+    for (i = 0; i < lineup_p->num_sessions; i++) {
+        free(lineup_p->sessions[i].o_line);
+        free(lineup_p->sessions[i].session);
+    }
+    free(lineup_p->sessions);
+    memset(lineup_p, 0, sizeof(cfg_lineup_t));
+}
+
+
+/* Function:    cfg_lineup_worker
+ * Description: Parse and validate a run of sessions of a lineup, on a
+ *              worker thread.  Nothing is written outside the sessions:
+ *              a session which is unchanged, fails to parse or logs
+ *              during validation is left for the merge.
+ * Parameters:  arg             The worker
+ * Returns:     NULL
+ */
+static void *cfg_lineup_worker (void *arg)
+{
+    cfg_lineup_worker_t *worker_p = (cfg_lineup_worker_t *)arg;
+    cfg_lineup_session_t *session_p;
+    void        *sdp_p;
+    char        *data_p;
+    boolean     logged;
+    uint32_t    i;
+
+    for (i = 0; i < worker_p->num_sessions; i++) {
+        session_p = &worker_p->sessions[i];
+        session_p->chksum = cfg_db_checksum(session_p->session,
+                                            strlen(session_p->session));
+
+        /* The merge copies the channel from the current lineup */
+        if (cfg_find_unchanged_channel(session_p->o_line,
+                                       session_p->chksum)) {
+            continue;
+        }
+
+        sdp_p = sdp_init_description_arena(worker_p->sdp_cfg_p,
+                                           worker_p->sdp_arena_p);
+        if (sdp_p == NULL) {
+            continue;
+        }
+
+        data_p = session_p->session;
+        if (sdp_parse(sdp_p, &data_p, strlen(data_p)) == SDP_SUCCESS) {
+            session_p->valid = cfg_channel_extract_quiet(
+                sdp_p, &session_p->channel, session_p->session_key, &logged);
+            session_p->extracted = !logged;
+        }
+
+        sdp_free_description(sdp_p);
+        sdp_reset_arena(worker_p->sdp_arena_p);
+    }
+
+    return NULL;
+}
+
+
+/* Function:    cfg_parse_lineup
+ * Description: Parse and validate the sessions of a lineup with worker
+ *              threads, then merge them into the new channel manager in
+ *              lineup order.  The channel manager, the statistics and the
+ *              messages logged are the same as when the sessions are
+ *              parsed one by one on the calling thread.
+ * Parameters:  lineup_p        The lineup
+ *              sdp_cfg_p       SDP configuration for the merge
+ *              sdp_arena_p     SDP arena for the merge
+ *              num_threads     Number of worker threads
+ * Returns:     Success or failure codes
+ */
+static cfg_ret_e cfg_parse_lineup (cfg_lineup_t *lineup_p,
+                                   void *sdp_cfg_p,
+                                   void *sdp_arena_p,
+                                   uint32_t num_threads)
+{
+    cfg_lineup_worker_t workers[CFG_MAX_PARSE_THREADS];
+    cfg_lineup_session_t *session_p;
+    uint32_t    num_workers, first, i;
+
+    num_workers = num_threads;
+    if (num_workers > CFG_MAX_PARSE_THREADS) {
+        num_workers = CFG_MAX_PARSE_THREADS;
+    }
+    if (num_workers > lineup_p->num_sessions) {
+        num_workers = lineup_p->num_sessions;
+    }
+
+    /* Give each worker a contiguous run of sessions; the sessions of a
+       worker which cannot be started are all parsed by the merge */
+    memset(workers, 0, sizeof(workers));
+    first = 0;
+    for (i = 0; i < num_workers; i++) {
+        workers[i].sessions = &lineup_p->sessions[first];
+        workers[i].num_sessions =
+            (lineup_p->num_sessions - first) / (num_workers - i);
+        first += workers[i].num_sessions;
+
+        workers[i].sdp_cfg_p = cfg_init_lineup_sdp_config();
+        workers[i].sdp_arena_p = sdp_init_arena(0);
+        if (workers[i].sdp_cfg_p && workers[i].sdp_arena_p &&
+            pthread_create(&workers[i].thread, NULL,
+                           cfg_lineup_worker, &workers[i]) == 0) {
+            workers[i].started = TRUE;
+        }
+    }
+
+    for (i = 0; i < num_workers; i++) {
+        if (workers[i].started) {
+            pthread_join(workers[i].thread, NULL);
+        }
+        if (workers[i].sdp_arena_p) {
+            sdp_free_arena(workers[i].sdp_arena_p);
+        }
+        if (workers[i].sdp_cfg_p) {
+            my_free(workers[i].sdp_cfg_p);
+        }
+    }
+
+    for (i = 0; i < lineup_p->num_sessions; i++) {
+        session_p = &lineup_p->sessions[i];
+        if (cfg_parse_update_session(sdp_cfg_p, sdp_arena_p,
+                                     session_p->o_line, session_p->session,
+                                     session_p) != CFG_SUCCESS) {
+            return CFG_MALLOC_ERR;
+        }
+    }
+
+    return CFG_SUCCESS;
+}
+
+
+/* Function:    cfg_set_parse_threads
+ * Description: Set the number of threads a lineup is parsed with
+ * Parameters:  num_threads     Number of threads; 0 or 1 parses the
+ *                              lineup on the calling thread
+ * Returns:     N/A
+ */
+void cfg_set_parse_threads (uint32_t num_threads)
+{
+    g_parse_threads = num_threads;
+}
+
+
+/* Function:    cfg_parse_threads_enabled
+ * Description: Check whether a lineup is to be parsed with worker threads.
+ *              The debugging messages of the manager are only printed in
+ *              lineup order when the lineup is parsed serially.
+ * Parameters:  N/A
+ * Returns:     TRUE or FALSE
+ */
+static boolean cfg_parse_threads_enabled (void)
+{
+    if (g_parse_threads <= 1) {
+        return FALSE;
+    }
+
+    if (debug_check_element(vqe_cfg_debug_arr, CFG_DEBUG_MGR, NULL) ||
+        debug_check_element(vqe_cfg_debug_arr, CFG_DEBUG_DB, NULL) ||
+        debug_check_element(vqe_cfg_debug_arr, CFG_DEBUG_CHANNEL, NULL) ||
+        debug_check_element(vqe_cfg_debug_arr, CFG_DEBUG_SDP, NULL)) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
 /* Function:    cfg_parse_all_channel_data
  * Description: Parse all the channel data in a buffer
  * Parameters:  buffer  The buffer contains channel data in SDP syntax
@@ -1235,20 +1727,19 @@ int read_line (char *line_buffer,
  */
 cfg_ret_e cfg_parse_all_channel_data (char *buffer)
 {
-    cfg_channel_ret_e status;
     int         start_idx = 0;
     char        line_buffer[MAX_LINE_LENGTH];
     char        session_buffer[MAX_SESSION_SIZE];
     void        *sdp_cfg_p;
-    void        *sdp_p;
-    idmgr_id_t  handle;
+    void        *sdp_arena_p;
     boolean     in_session = FALSE;
     char        id_buffer[MAX_LINE_LENGTH];
     uint32_t    total_session_length = 0;
     boolean     skip = FALSE;
-    uint32_t    chksum;
     int         total_buffer_length;
-    boolean     syntax_error = FALSE;
+    cfg_lineup_t lineup;
+    cfg_lineup_t *lineup_p = NULL;
+    cfg_ret_e   err;
 
     /* Check whether the configuration manager has been initialized or not */
     if (system_cfg.initialized == FALSE) {
@@ -1303,28 +1794,23 @@ cfg_ret_e cfg_parse_all_channel_data (char *buffer)
     }
 
     /* Set up a default SDP configuration for all the sessions */
-    sdp_cfg_p = sdp_init_config();
-
-    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_TRACE, FALSE);
-    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_WARNINGS, FALSE);
-    sdp_appl_debug(sdp_cfg_p, SDP_DEBUG_ERRORS, FALSE);
-
-    sdp_require_version(sdp_cfg_p, TRUE);
-    sdp_require_owner(sdp_cfg_p, TRUE);
-    sdp_require_session_name(sdp_cfg_p, TRUE);
-    sdp_require_timespec(sdp_cfg_p, TRUE);
+    sdp_cfg_p = cfg_init_lineup_sdp_config();
 
-    sdp_media_supported(sdp_cfg_p, SDP_MEDIA_VIDEO, TRUE);
+    /* All the sessions are parsed into one arena, which is rewound
+       after each session and released in one go at the end */
+    sdp_arena_p = sdp_init_arena(0);
+    if (sdp_arena_p == NULL) {
+        syslog_print(CFG_MALLOC_ERR);
+        my_free(sdp_cfg_p);
+        return CFG_MALLOC_ERR;
+    }
 
-    sdp_nettype_supported(sdp_cfg_p, SDP_NT_INTERNET, TRUE);    
-    sdp_addrtype_supported(sdp_cfg_p, SDP_AT_IP4, TRUE);
-   
-    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_UDP, TRUE);
-    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_RTPAVP, TRUE);
-    sdp_transport_supported(sdp_cfg_p, SDP_TRANSPORT_RTPAVPF, TRUE);
-    
-    sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_CONN_ADDR, TRUE);
-    sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_PORTNUM, TRUE);
+    /* With worker threads the sessions are collected first, then parsed
+       together once the whole buffer has been split */
+    if (cfg_parse_threads_enabled()) {
+        memset(&lineup, 0, sizeof(cfg_lineup_t));
+        lineup_p = &lineup;
+    }
 
     /* Parse all the data contents */
     memset(session_buffer, 0, MAX_SESSION_SIZE);
@@ -1349,71 +1835,22 @@ cfg_ret_e cfg_parse_all_channel_data (char *buffer)
                 continue;
             }
 
-            new_channel_mgr.num_input_channels++;
-
-            /* Create a SDP structure for this session */
-            sdp_p  = sdp_init_description(sdp_cfg_p);
-            VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                          "cfg_parse_all_channel_data:: Creating SDP session "
-                          "%p\n", sdp_p);
-
-            if (sdp_p == NULL) {
-                syslog_print(CFG_MALLOC_ERR);
-                return CFG_MALLOC_ERR;
-            }
-
-            /* Parse and validate SDP description in the session */
-            if(cfg_db_parse_SDP(sdp_p, session_buffer, &syntax_error)) {
-                /* Increase number of channels passing the parser */
-                new_channel_mgr.num_parsed++;
-
-                /* Compute MD5 checksum */
-                chksum = cfg_db_checksum(session_buffer,
-                                         strlen(session_buffer));
-                        
-                /* Store it in the channel manager */
-                status = cfg_channel_add(sdp_p, &new_channel_mgr,
-                                         &handle, chksum);
-                if (status != CFG_CHANNEL_SUCCESS) {
-                    if (status != CFG_CHANNEL_EXIST) {
-                        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                                      "cfg_parse_all_channel_data:: Failed to "
-                                      "add the channel.\n");
-                        VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL,
-                                      "SDP Session = \n%s\n",
-                                      session_buffer);
-                    }
-                }
-                else {
-                    /* Increase number of channels passing */
-                    /* the validation */
-                    new_channel_mgr.num_validated++;
-
-                    VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                                  "cfg_parse_all_channel_data:: New channel "
-                                  "0x%lx is being added\n",
-                                  handle);
-                }
-            }
-            else {
-                if (syntax_error) {
-                    new_channel_mgr.num_syntax_errors++;
+            if (lineup_p) {
+                if (!cfg_lineup_add_session(lineup_p, id_buffer,
+                                            session_buffer)) {
+                    syslog_print(CFG_MALLOC_ERR);
+                    cfg_lineup_free(lineup_p);
+                    sdp_free_arena(sdp_arena_p);
+                    my_free(sdp_cfg_p);
+                    return CFG_MALLOC_ERR;
                 }
-                VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                              "cfg_parse_all_channel_data:: Failed to create "
-                              "SDP session for the channel.\n");
-                VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL,
-                              "Raw data = \n%s\n", 
-                              session_buffer);
             }
-
-            /* Delete the SDP data */
-            if (sdp_p) {
-                VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                              "cfg_parse_all_channel_data:: Deleting SDP "
-                              "session %p\n",
-                              sdp_p);
-                sdp_free_description(sdp_p);
+            else if (cfg_parse_update_session(sdp_cfg_p, sdp_arena_p,
+                                              id_buffer, session_buffer,
+                                              NULL) != CFG_SUCCESS) {
+                sdp_free_arena(sdp_arena_p);
+                my_free(sdp_cfg_p);
+                return CFG_MALLOC_ERR;
             }
 
             /* Reset the seesion buffer for new session */
@@ -1465,77 +1902,43 @@ cfg_ret_e cfg_parse_all_channel_data (char *buffer)
     if (session_buffer[0] != '\n' &&
         session_buffer[0] != '\r' &&
         session_buffer[0] != '\0') {
-        new_channel_mgr.num_input_channels++;
         VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
                       "cfg_parse_all_channel_data:: Session = \n%s\n",
                       session_buffer);
 
-        /* Create a SDP structure for this session */
-        sdp_p  = sdp_init_description(sdp_cfg_p);
-        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                      "cfg_parse_all_channel_data:: Creating SDP session "
-                      "%p\n", sdp_p);
-        
-        if (sdp_p == NULL) {
-            syslog_print(CFG_MALLOC_ERR);
-            return CFG_MALLOC_ERR;
-        }
-
-        /* Parse and validate SDP description in the session */
-        if (cfg_db_parse_SDP(sdp_p, session_buffer, &syntax_error)) {
-            /* Increase number of channels passing the parser */
-            new_channel_mgr.num_parsed++;
-
-            /* Compute MD5 checksum */
-            chksum = cfg_db_checksum(session_buffer,
-                                     strlen(session_buffer));
-                        
-           /* Store it in the channel manager */
-            status = cfg_channel_add(sdp_p, &new_channel_mgr, &handle, chksum);
-            if (status != CFG_CHANNEL_SUCCESS) {
-                if (status != CFG_CHANNEL_EXIST) {
-                    VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                                  "cfg_parse_all_channel_data:: Failed to "
-                                  "add the channel.\n");
-                    VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL, 
-                                  "SDP Session = \n%s\n", 
-                                  session_buffer);
-                }
-            }
-            else {
-                /* Increase number of channels passing */
-                /* the validation */
-                new_channel_mgr.num_validated++;
-
-                VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                              "cfg_parse_all_channel_data:: New channel "
-                              "0x%lx is being added\n",
-                              handle);
+        if (lineup_p) {
+            if (!cfg_lineup_add_session(lineup_p, id_buffer,
+                                        session_buffer)) {
+                syslog_print(CFG_MALLOC_ERR);
+                cfg_lineup_free(lineup_p);
+                sdp_free_arena(sdp_arena_p);
+                my_free(sdp_cfg_p);
+                return CFG_MALLOC_ERR;
             }
         }
-        else {
-            if (syntax_error) {
-                new_channel_mgr.num_syntax_errors++;
-            }
-            VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                          "cfg_parse_all_channel_data:: Failed to create SDP "
-                          "session for the channel.\n");
-            VQE_CFG_DEBUG(CFG_DEBUG_SDP, NULL, 
-                          "Raw data = \n%s\n", 
-                          session_buffer);
+        else if (cfg_parse_update_session(sdp_cfg_p, sdp_arena_p,
+                                          id_buffer, session_buffer,
+                                          NULL) != CFG_SUCCESS) {
+            sdp_free_arena(sdp_arena_p);
+            my_free(sdp_cfg_p);
+            return CFG_MALLOC_ERR;
         }
+    }
 
-        /* Delete the SDP data */
-        if (sdp_p) {
-            VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                          "cfg_parse_all_channel_data:: Deleting SDP "
-                          "session %p\n",
-                          sdp_p);
-            sdp_free_description(sdp_p);
+    /* Parse the sessions collected for the worker threads */
+    if (lineup_p) {
+        err = cfg_parse_lineup(lineup_p, sdp_cfg_p, sdp_arena_p,
+                               g_parse_threads);
+        cfg_lineup_free(lineup_p);
+        if (err != CFG_SUCCESS) {
+            sdp_free_arena(sdp_arena_p);
+            my_free(sdp_cfg_p);
+            return err;
         }
     }
 
     /* Free up stuff */
+    sdp_free_arena(sdp_arena_p);
     my_free(sdp_cfg_p);
 
     /* Remeber the time the configuration data is read */
@@ -1673,15 +2076,19 @@ cfg_ret_e cfg_parse_single_channel_data (char *buffer,
 
 
 /* Function:    cfg_commit_update()
- * Description: Replace current channel manager with new channel manager
+ * Description: Replace current channel manager with new channel manager.
+ *              Channels which the update leaves unchanged keep their
+ *              configuration and handle; only the channels which are
+ *              removed, added or modified by the update are replaced.
  * Parameters:  N/A
  * Returns:     Success or failure codes
  */
 cfg_ret_e cfg_commit_update (void)
 {
     channel_mgr_t *channel_mgr_p;
-    int i;
-    channel_cfg_t *channel_p;
+    int i, j;
+    channel_cfg_t *channel_p, *new_p;
+    uint32_t num_kept = 0;
 
     VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
                   "cfg_commit_update:: Replacing current contents with new "
@@ -1689,35 +2096,68 @@ cfg_ret_e cfg_commit_update (void)
 
     channel_mgr_p = cfg_get_channel_mgr();
     if (channel_mgr_p) {
-        /* Clean up the current channel manager in system_config */
-        if (cfg_channel_destroy_all(channel_mgr_p) != CFG_CHANNEL_SUCCESS) {
-            syslog_print(CFG_DESTROY_ALL_ERR);
+        /* Remove the current channels which are not in the update as is */
+        for (i = 0; i < channel_mgr_p->total_num_channels; i++) {
+            if (channel_mgr_p->handles[i] == ILLEGAL_ID) {
+                continue;
+            }
+            channel_p = cfg_channel_get(channel_mgr_p, 
+                                        channel_mgr_p->handles[i]);
+            if (channel_p) {
+                new_p = cfg_channel_find(&new_channel_mgr, 
+                                         channel_p->session_key);
+                if (new_p && new_p->active && 
+                    new_p->version == channel_p->version &&
+                    new_p->chksum == channel_p->chksum &&
+                    cfg_channel_compare(new_p, channel_p)) {
+                    num_kept++;
+                    continue;
+                }
+            }
+            if (cfg_channel_delete(channel_mgr_p, channel_mgr_p->handles[i],
+                                   TRUE) != CFG_CHANNEL_SUCCESS) {
+                syslog_print(CFG_DELETE_WARN);
+            }
         }
-        else {
-            for (i = 0; i < new_channel_mgr.total_num_channels; i++) {
-                channel_p = cfg_channel_get(&new_channel_mgr,
-                                            new_channel_mgr.handles[i]);
-                if (channel_p && channel_p->active) {
-                    if (cfg_insert_channel(channel_p) == NULL) {
-                        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
-                                      "cfg_commit_update:: Failed to insert "
-                                      "channel 0x%lx to channel manager.\n",
-                                      new_channel_mgr.handles[i]);
 
-                        return CFG_FAILURE;
-                    }
-                }
+        /* Close the gaps left by the removed channels */
+        for (i = 0, j = 0; i < channel_mgr_p->total_num_channels; i++) {
+            if (channel_mgr_p->handles[i] != ILLEGAL_ID) {
+                channel_mgr_p->handles[j++] = channel_mgr_p->handles[i];
             }
+        }
+        channel_mgr_p->total_num_channels = j;
+
+        /* Add the new and modified channels */
+        for (i = 0; i < new_channel_mgr.total_num_channels; i++) {
+            channel_p = cfg_channel_get(&new_channel_mgr,
+                                        new_channel_mgr.handles[i]);
+            if (channel_p && channel_p->active &&
+                !cfg_channel_find(channel_mgr_p, channel_p->session_key)) {
+                if (cfg_insert_channel(channel_p) == NULL) {
+                    VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                                  "cfg_commit_update:: Failed to insert "
+                                  "channel 0x%lx to channel manager.\n",
+                                  new_channel_mgr.handles[i]);
 
-            channel_mgr_p->num_parsed = new_channel_mgr.num_parsed;
-            channel_mgr_p->num_syntax_errors = 
-                new_channel_mgr.num_syntax_errors;
-            channel_mgr_p->num_validated = new_channel_mgr.num_validated;
-            channel_mgr_p->num_input_channels = 
-                new_channel_mgr.num_input_channels;
-            channel_mgr_p->timestamp = new_channel_mgr.timestamp;
+                    return CFG_FAILURE;
+                }
+            }
         }
 
+        VQE_CFG_DEBUG(CFG_DEBUG_MGR, NULL,
+                      "cfg_commit_update:: %u channels unchanged, %u "
+                      "channels in total\n",
+                      num_kept, channel_mgr_p->total_num_channels);
+
+        channel_mgr_p->num_parsed = new_channel_mgr.num_parsed;
+        channel_mgr_p->num_syntax_errors = 
+            new_channel_mgr.num_syntax_errors;
+        channel_mgr_p->num_validated = new_channel_mgr.num_validated;
+        channel_mgr_p->num_input_channels = 
+            new_channel_mgr.num_input_channels;
+        channel_mgr_p->timestamp = new_channel_mgr.timestamp;
+
         return CFG_SUCCESS;
     }
     else {
@@ -10,6 +10,9 @@
  */
 
 #include <stdio.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <utils/vam_debug.h>
 #include <utils/vam_time.h>
 #include <utils/vmd5.h>
@@ -147,6 +150,7 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
     char        line_buffer[MAX_LINE_LENGTH];
     char        session_buffer[MAX_SESSION_SIZE];
     void        *sdp_cfg_p;
+    void        *sdp_arena_p;
     void        *sdp_p;
     idmgr_id_t  handle;
     boolean     in_session = FALSE;
@@ -191,6 +195,15 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
     sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_CONN_ADDR, TRUE);
     sdp_allow_choose(sdp_cfg_p, SDP_CHOOSE_PORTNUM, TRUE);
 
+    /* All the sessions are parsed into one arena, which is rewound
+       after each session and released in one go at the end */
+    sdp_arena_p = sdp_init_arena(0);
+    if (sdp_arena_p == NULL) {
+        syslog_print(CFG_MALLOC_ERR);
+        my_free(sdp_cfg_p);
+        return CFG_DB_MALLOC_ERR;
+    }
+
     /* Parse all the data contents */
     switch (cfg_db_p->type) {
         case DB_FILE:
@@ -214,13 +227,16 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
                     channel_mgr_p->num_input_channels++;
 
                     /* Create a SDP structure for this session */
-                    sdp_p  = sdp_init_description(sdp_cfg_p);
+                    sdp_p  = sdp_init_description_arena(sdp_cfg_p,
+                                                        sdp_arena_p);
                     VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
                                   "cfg_db_read_channels:: Creating SDP session"
                                   " %p\n", sdp_p);
 
                     if (sdp_p == NULL) {
                         syslog_print(CFG_MALLOC_ERR);
+                        sdp_free_arena(sdp_arena_p);
+                        my_free(sdp_cfg_p);
                         return CFG_DB_MALLOC_ERR;
                     }
                        
@@ -279,6 +295,7 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
                                       "session %p\n",
                                       sdp_p);
                         sdp_free_description(sdp_p);
+                        sdp_reset_arena(sdp_arena_p);
                     }
 
                     /* Reset the seesion buffer for new session */
@@ -340,13 +357,15 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
                 }
 
                 /* Create a SDP structure for this session */
-                sdp_p  = sdp_init_description(sdp_cfg_p);
+                sdp_p  = sdp_init_description_arena(sdp_cfg_p, sdp_arena_p);
                 VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
                               "cfg_db_read_channels:: Creating SDP session "
                               "%p\n", sdp_p);
 
                 if (sdp_p == NULL) {
                     syslog_print(CFG_MALLOC_ERR);
+                    sdp_free_arena(sdp_arena_p);
+                    my_free(sdp_cfg_p);
                     return CFG_DB_MALLOC_ERR;
                 }
                        
@@ -401,6 +420,7 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
                                   "session %p\n",
                                   sdp_p);
                     sdp_free_description(sdp_p);
+                    sdp_reset_arena(sdp_arena_p);
                 }
             }
 
@@ -411,11 +431,14 @@ cfg_db_ret_e cfg_db_read_channels (cfg_database_t *cfg_db_p,
                           "cfg_db_read_channels:: Unspecified database "
                           "type %d.\n",
                           cfg_db_p->type);
+            sdp_free_arena(sdp_arena_p);
+            my_free(sdp_cfg_p);
             return CFG_DB_NOT_SUPPORTED;
 
     }
 
     /* Free up stuff */
+    sdp_free_arena(sdp_arena_p);
     my_free(sdp_cfg_p);
 
     return CFG_DB_SUCCESS;
@@ -993,3 +1016,289 @@ uint32_t cfg_db_checksum (char *sdp_buffer, int length)
 
     return r;
 }
+
+
+/*
+ * A snapshot file is a header followed by num_channels channel_cfg_t
+ * records, in the order of the channel manager's handles.  The records
+ * are stored in host format so that the file can be mapped and copied
+ * from directly; the format version and record size guard against a
+ * snapshot written by another build.  The header size is a multiple of
+ * 8 bytes to keep the mapped records aligned.
+ */
+#define CFG_DB_SNAPSHOT_MAGIC   0x56514353      /* "VQCS" */
+#define CFG_DB_SNAPSHOT_VERSION 1
+
+typedef struct cfg_db_snapshot_hdr_ {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t num_channels;
+    unsigned char db_digest[DIGEST_BYTES];  /* MD5 of the database */
+    uint32_t records_chksum;                /* checksum of the records */
+
+    /* Statistics of the parse the snapshot was taken from */
+    uint32_t num_input_channels;
+    uint32_t num_parsed;
+    uint32_t num_syntax_errors;
+    uint32_t num_validated;
+    uint32_t num_old_version;
+    uint32_t num_invalid_ver;
+    uint32_t reserved;
+} cfg_db_snapshot_hdr_t;
+
+
+/* Function:    cfg_db_snapshot_name
+ * Description: Build the name of the snapshot file of a database
+ * Parameters:  cfg_db          Configuration database structure
+ *              name            Buffer for the name
+ *              length          Length of the buffer
+ * Returns:     TRUE if the name fits in the buffer
+ */
+static boolean cfg_db_snapshot_name (cfg_database_t *cfg_db_p,
+                                     char *name,
+                                     int length)
+{
+    return (snprintf(name, length, "%s%s", 
+                     cfg_db_p->db_name, CFG_DB_SNAPSHOT_SUFFIX) < length);
+}
+
+
+/* Function:    cfg_db_digest
+ * Description: Compute the MD5 digest of the whole database; the
+ *              database is left positioned at its beginning
+ * Parameters:  cfg_db          Configuration database structure
+ *              digest          Buffer of DIGEST_BYTES for the digest
+ * Returns:     TRUE on success
+ */
+static boolean cfg_db_digest (cfg_database_t *cfg_db_p,
+                              unsigned char *digest)
+{
+    MD_CTX context;
+    unsigned char buffer[MAX_SESSION_SIZE];
+    size_t length;
+    FILE *fp = (FILE *) cfg_db_p->db_file_p;
+
+    if (cfg_db_p->type != DB_FILE || fp == NULL) {
+        return FALSE;
+    }
+
+    rewind(fp);
+    MDInit(&context);
+    while ((length = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        MDUpdate(&context, buffer, length);
+    }
+    MDFinal(digest, &context);
+
+    if (ferror(fp)) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_digest:: Failed to read database %s.\n",
+                      cfg_db_p->db_name);
+        return FALSE;
+    }
+    rewind(fp);
+
+    return TRUE;
+}
+
+
+/* Function:    cfg_db_read_snapshot
+ * Description: Load the validated channels of a database from its
+ *              snapshot, instead of parsing the SDP descriptions
+ * Parameters:  cfg_db          Configuration database structure
+ *              channel_mgr     Channel manager, which must be empty
+ * Returns:     CFG_DB_SUCCESS, CFG_DB_OPEN_FAILED if there is no snapshot,
+ *              CFG_DB_CORRUPTED if it does not match the database
+ */
+cfg_db_ret_e cfg_db_read_snapshot (cfg_database_t *cfg_db_p,
+                                   channel_mgr_t *channel_mgr_p)
+{
+    char name[MAX_DB_NAME_LENGTH];
+    unsigned char digest[DIGEST_BYTES];
+    const cfg_db_snapshot_hdr_t *hdr_p;
+    channel_cfg_t *records_p;
+    struct stat st;
+    void *map_p = MAP_FAILED;
+    int fd;
+    uint32_t i;
+    cfg_db_ret_e result = CFG_DB_CORRUPTED;
+
+    if (cfg_db_p->db_file_p == NULL) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_read_snapshot:: Database %s is not opened.\n",
+                      cfg_db_p->db_name);
+        return CFG_DB_NOT_OPEN;
+    }
+
+    if (channel_mgr_p->total_num_channels ||
+        !cfg_db_snapshot_name(cfg_db_p, name, MAX_DB_NAME_LENGTH) ||
+        !cfg_db_digest(cfg_db_p, digest)) {
+        return CFG_DB_FAILURE;
+    }
+
+    fd = open(name, O_RDONLY);
+    if (fd < 0) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_read_snapshot:: No snapshot %s.\n", name);
+        return CFG_DB_OPEN_FAILED;
+    }
+
+    if (fstat(fd, &st) || st.st_size < sizeof(cfg_db_snapshot_hdr_t)) {
+        goto done;
+    }
+    map_p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map_p == MAP_FAILED) {
+        result = CFG_DB_FAILURE;
+        goto done;
+    }
+    hdr_p = (const cfg_db_snapshot_hdr_t *) map_p;
+    records_p = (channel_cfg_t *) (hdr_p + 1);
+
+    /* Only a snapshot of this very database is usable */
+    if (hdr_p->magic != CFG_DB_SNAPSHOT_MAGIC ||
+        hdr_p->version != CFG_DB_SNAPSHOT_VERSION ||
+        hdr_p->record_size != sizeof(channel_cfg_t) ||
+        hdr_p->num_channels > MAX_CHANNELS ||
+        st.st_size != sizeof(cfg_db_snapshot_hdr_t) + 
+        hdr_p->num_channels * sizeof(channel_cfg_t) ||
+        memcmp(hdr_p->db_digest, digest, DIGEST_BYTES) ||
+        cfg_db_checksum((char *) records_p, 
+                        hdr_p->num_channels * sizeof(channel_cfg_t))
+        != hdr_p->records_chksum) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_read_snapshot:: Snapshot %s does not match "
+                      "the database.\n", name);
+        goto done;
+    }
+
+    for (i = 0; i < hdr_p->num_channels; i++) {
+        if (cfg_channel_insert(channel_mgr_p, &records_p[i]) == NULL) {
+            VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                          "cfg_db_read_snapshot:: Failed to add the "
+                          "channel %s.\n", records_p[i].name);
+            (void) cfg_channel_destroy_all(channel_mgr_p);
+            result = CFG_DB_FAILURE;
+            goto done;
+        }
+    }
+
+    channel_mgr_p->num_input_channels = hdr_p->num_input_channels;
+    channel_mgr_p->num_parsed = hdr_p->num_parsed;
+    channel_mgr_p->num_syntax_errors = hdr_p->num_syntax_errors;
+    channel_mgr_p->num_validated = hdr_p->num_validated;
+    channel_mgr_p->num_old_version = hdr_p->num_old_version;
+    channel_mgr_p->num_invalid_ver = hdr_p->num_invalid_ver;
+
+    VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                  "cfg_db_read_snapshot:: Loaded %d channels from %s\n",
+                  channel_mgr_p->total_num_channels, name);
+    result = CFG_DB_SUCCESS;
+
+done:
+    if (map_p != MAP_FAILED) {
+        munmap(map_p, st.st_size);
+    }
+    close(fd);
+
+    return result;
+}
+
+
+/* Function:    cfg_db_write_snapshot
+ * Description: Write a snapshot of the channels read from a database
+ * Parameters:  cfg_db          Configuration database structure
+ *              channel_mgr     Channel manager
+ * Returns:     Success or failure
+ */
+cfg_db_ret_e cfg_db_write_snapshot (cfg_database_t *cfg_db_p,
+                                    channel_mgr_t *channel_mgr_p)
+{
+    char name[MAX_DB_NAME_LENGTH];
+    char tmp_name[MAX_DB_NAME_LENGTH + 4];
+    cfg_db_snapshot_hdr_t hdr;
+    channel_cfg_t *records_p = NULL;
+    channel_cfg_t *channel_p;
+    size_t records_size;
+    FILE *fp;
+    uint16_t i;
+    cfg_db_ret_e result = CFG_DB_FAILURE;
+
+    if (cfg_db_p->db_file_p == NULL) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_write_snapshot:: Database %s is not "
+                      "opened.\n",
+                      cfg_db_p->db_name);
+        return CFG_DB_NOT_OPEN;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    if (!cfg_db_snapshot_name(cfg_db_p, name, MAX_DB_NAME_LENGTH) ||
+        !cfg_db_digest(cfg_db_p, hdr.db_digest)) {
+        return CFG_DB_FAILURE;
+    }
+    snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", name);
+
+    if (channel_mgr_p->total_num_channels) {
+        records_p = (channel_cfg_t *) 
+            my_malloc(channel_mgr_p->total_num_channels * 
+                      sizeof(channel_cfg_t));
+        if (records_p == NULL) {
+            syslog_print(CFG_MALLOC_ERR);
+            return CFG_DB_MALLOC_ERR;
+        }
+    }
+    for (i = 0; i < channel_mgr_p->total_num_channels; i++) {
+        if (channel_mgr_p->handles[i] == ILLEGAL_ID) {
+            continue;
+        }
+        channel_p = cfg_channel_get(channel_mgr_p, channel_mgr_p->handles[i]);
+        if (channel_p) {
+            records_p[hdr.num_channels++] = *channel_p;
+        }
+    }
+    records_size = hdr.num_channels * sizeof(channel_cfg_t);
+
+    hdr.magic = CFG_DB_SNAPSHOT_MAGIC;
+    hdr.version = CFG_DB_SNAPSHOT_VERSION;
+    hdr.record_size = sizeof(channel_cfg_t);
+    hdr.records_chksum = cfg_db_checksum((char *) records_p, records_size);
+    hdr.num_input_channels = channel_mgr_p->num_input_channels;
+    hdr.num_parsed = channel_mgr_p->num_parsed;
+    hdr.num_syntax_errors = channel_mgr_p->num_syntax_errors;
+    hdr.num_validated = channel_mgr_p->num_validated;
+    hdr.num_old_version = channel_mgr_p->num_old_version;
+    hdr.num_invalid_ver = channel_mgr_p->num_invalid_ver;
+
+    /* Write to a temporary file so a reader never sees a partial one */
+    fp = fopen(tmp_name, "w");
+    if (fp == NULL) {
+        VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                      "cfg_db_write_snapshot:: Could not open %s.\n",
+                      tmp_name);
+        goto done;
+    }
+    if (fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        (records_size && fwrite(records_p, records_size, 1, fp) != 1)) {
+        fclose(fp);
+        goto cleanup;
+    }
+    if (fclose(fp) || rename(tmp_name, name)) {
+        goto cleanup;
+    }
+
+    VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                  "cfg_db_write_snapshot:: Saved %d channels to %s\n",
+                  hdr.num_channels, name);
+    result = CFG_DB_SUCCESS;
+    goto done;
+
+cleanup:
+    VQE_CFG_DEBUG(CFG_DEBUG_DB, NULL,
+                  "cfg_db_write_snapshot:: Could not write %s.\n", name);
+    /* sa_ignore IGNORE_RETURN */
+    remove(tmp_name);
+done:
+    my_free(records_p);
+
+    return result;
+}
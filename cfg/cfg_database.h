@@ -30,6 +30,12 @@
 
 #define BACKUP_DB_NAME "vam-config-backup.cfg"
 
+/* 
+ * Binary snapshot of the validated channels of a database; it is stored
+ * next to the database under the database name with this suffix.
+ */
+#define CFG_DB_SNAPSHOT_SUFFIX ".snapshot"
+
 #define SDP_TEMPLATE "v=0\n\
 o=%s\n\
 s=%s\n\
@@ -166,6 +172,23 @@ extern cfg_db_ret_e cfg_db_read_channels(cfg_database_t *db,
 extern cfg_db_ret_e cfg_db_write_channels(cfg_database_t *db,
                                           channel_mgr_t *channel_mgr_p);
 
+/**
+ * Load the validated channels of a database from its binary snapshot
+ * into an empty channel_mgr_t.  The snapshot is used only if it was taken
+ * from a database with the same MD5 digest and by the same software
+ * version; otherwise CFG_DB_CORRUPTED is returned and the database must
+ * be parsed.
+ */
+extern cfg_db_ret_e cfg_db_read_snapshot(cfg_database_t *db,
+                                         channel_mgr_t *channel_mgr_p);
+
+/**
+ * Write a binary snapshot of the channels in channel_mgr_t, which must
+ * have been read from the database
+ */
+extern cfg_db_ret_e cfg_db_write_snapshot(cfg_database_t *db,
+                                          channel_mgr_t *channel_mgr_p);
+
 /**
  * Create a SDP description based on the channel configuration data
  */
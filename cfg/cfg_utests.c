@@ -5524,6 +5524,61 @@ a=mid:2\n"
     CU_ASSERT(55 == chan_cfg.repair_rtcp_rcvr_bw);
 }
 
+
+void test_channel_extract_quiet (void)
+{
+    char data_buffer[DATA_SIZE];
+    char session_key[MAX_KEY_LENGTH];
+    channel_cfg_t quiet_cfg;
+    channel_cfg_t chan_cfg;
+    char *data_p;
+    void *sdp_in_p;
+    boolean logged;
+
+    /* A valid channel has nothing to log */
+    strncpy(data_buffer, LINEAR_SDP, DATA_SIZE);
+    data_p = data_buffer;
+    sdp_in_p = sdp_init_description(sdp_cfg_p);
+    CU_ASSERT_EQUAL(sdp_parse(sdp_in_p, &data_p, strlen(data_buffer)),
+                    SDP_SUCCESS);
+
+    logged = TRUE;
+    CU_ASSERT(cfg_channel_extract_quiet(sdp_in_p, &quiet_cfg, session_key,
+                                        &logged));
+    CU_ASSERT_FALSE(logged);
+    CU_ASSERT_PTR_NOT_NULL(strstr(session_key, "4262738225"));
+
+    /* It extracts what the logging validation does */
+    CU_ASSERT(cfg_channel_extract(sdp_in_p, &chan_cfg, CFG_LINEAR));
+    CU_ASSERT(cfg_is_identical(&quiet_cfg, &chan_cfg));
+    sdp_free_description(sdp_in_p);
+
+    /* An invalid channel would log: the flag is set instead */
+    strncpy(data_buffer, BAD_RTP_PORT, DATA_SIZE);
+    data_p = data_buffer;
+    sdp_in_p = sdp_init_description(sdp_cfg_p);
+    CU_ASSERT_EQUAL(sdp_parse(sdp_in_p, &data_p, strlen(data_buffer)),
+                    SDP_SUCCESS);
+
+    logged = FALSE;
+    CU_ASSERT_FALSE(cfg_channel_extract_quiet(sdp_in_p, &quiet_cfg,
+                                              session_key, &logged));
+    CU_ASSERT(logged);
+    CU_ASSERT_PTR_NOT_NULL(strstr(session_key, "111199375"));
+
+    /* The flag is not left set on the thread */
+    logged = FALSE;
+    CU_ASSERT_FALSE(cfg_channel_extract(sdp_in_p, &chan_cfg, CFG_LINEAR));
+    CU_ASSERT_FALSE(logged);
+    sdp_free_description(sdp_in_p);
+
+    /* Nothing to extract from */
+    logged = TRUE;
+    CU_ASSERT_FALSE(cfg_channel_extract_quiet(NULL, &quiet_cfg, session_key,
+                                              &logged));
+    CU_ASSERT_FALSE(logged);
+}
+
 /***********************************************************************
  *
  *     DATABASE SUITE TESTS START HERE
@@ -5653,6 +5708,80 @@ void test_db_write (void)
 }
 
 
+void test_db_snapshot (void)
+{
+    cfg_db_ret_e status;
+    cfg_database_t db;
+    channel_mgr_t snap_manager;
+    channel_cfg_t *channel_p, *orig_p, expected;
+    FILE *fp;
+    int i;
+
+    memset(&snap_manager, 0, sizeof(snap_manager));
+    snap_manager.handle_mgr = id_create_new_table(100, 100);
+    snap_manager.session_keys = vqe_hash_create(256,
+                                                cfg_session_key_hash_func,
+                                                NULL);
+
+    /* sa_ignore IGNORE_RETURN */
+    remove(TEST_DB CFG_DB_SNAPSHOT_SUFFIX);
+    status = cfg_db_open(&db, TEST_DB, DB_FILE);
+    CU_ASSERT_EQUAL(status, CFG_DB_SUCCESS);
+
+    /* No snapshot yet */
+    status = cfg_db_read_snapshot(&db, &snap_manager);
+    CU_ASSERT_EQUAL(status, CFG_DB_OPEN_FAILED);
+
+    /* Save the channels read from the database and load them back */
+    status = cfg_db_write_snapshot(&db, &channel_manager);
+    CU_ASSERT_EQUAL(status, CFG_DB_SUCCESS);
+    status = cfg_db_read_snapshot(&db, &snap_manager);
+    CU_ASSERT_EQUAL(status, CFG_DB_SUCCESS);
+    CU_ASSERT_EQUAL(snap_manager.total_num_channels, TOTAL_CHANNELS);
+    CU_ASSERT_EQUAL(snap_manager.num_validated, 
+                    channel_manager.num_validated);
+    for (i = 0; i < TOTAL_CHANNELS; i++) {
+        channel_p = cfg_channel_get(&snap_manager, snap_manager.handles[i]);
+        CU_ASSERT_PTR_NOT_NULL(channel_p);
+        orig_p = cfg_channel_get(&channel_manager, channel_manager.handles[i]);
+        CU_ASSERT_PTR_NOT_NULL(orig_p);
+        if (channel_p && orig_p) {
+            /* the whole record is restored, only the handle differs */
+            memcpy(&expected, orig_p, sizeof(expected));
+            expected.handle = channel_p->handle;
+            CU_ASSERT_EQUAL(memcmp(channel_p, &expected, sizeof(expected)), 
+                            0);
+        }
+    }
+
+    /* A snapshot is only loaded into an empty channel manager */
+    status = cfg_db_read_snapshot(&db, &snap_manager);
+    CU_ASSERT_EQUAL(status, CFG_DB_FAILURE);
+    CU_ASSERT_EQUAL(cfg_channel_destroy_all(&snap_manager), 
+                    CFG_CHANNEL_SUCCESS);
+
+    /* A damaged snapshot is rejected */
+    fp = fopen(TEST_DB CFG_DB_SNAPSHOT_SUFFIX, "r+");
+    CU_ASSERT_PTR_NOT_NULL(fp);
+    if (fp) {
+        CU_ASSERT_EQUAL(fseek(fp, -1, SEEK_END), 0);
+        fputc(0x5a, fp);
+        fclose(fp);
+    }
+    status = cfg_db_read_snapshot(&db, &snap_manager);
+    CU_ASSERT_EQUAL(status, CFG_DB_CORRUPTED);
+    CU_ASSERT_EQUAL(snap_manager.total_num_channels, 0);
+
+    status = cfg_db_close(&db);
+    CU_ASSERT_EQUAL(status, CFG_DB_SUCCESS);
+
+    /* sa_ignore IGNORE_RETURN */
+    remove(TEST_DB CFG_DB_SNAPSHOT_SUFFIX);
+    vqe_hash_destroy(snap_manager.session_keys);
+    id_destroy_table(snap_manager.handle_mgr);
+}
+
+
 /***********************************************************************
  *
  *     CONFIGURATION MANAGER SUITE TESTS START HERE
@@ -5811,6 +5940,260 @@ void test_cfgmgr_update (void)
 }
 
 
+void test_cfgmgr_update_diff (void)
+{
+    cfg_ret_e status;
+    channel_cfg_t *channels[TOTAL_CHANNELS];
+    channel_cfg_t *channel_p;
+    char first_key[MAX_KEY_LENGTH];
+    FILE *fp;
+    long file_size;
+    char *sdp_buffer;
+    char *second_p;
+    int i;
+
+    status = cfg_init(TEST_DB);
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+    CU_ASSERT_EQUAL(cfg_get_total_num_channels(), TOTAL_CHANNELS);
+    for (i = 0; i < TOTAL_CHANNELS; i++) {
+        channels[i] = cfg_get_channel_cfg_from_idx(i);
+        CU_ASSERT_PTR_NOT_NULL(channels[i]);
+    }
+    strncpy(first_key, channels[0]->session_key, MAX_KEY_LENGTH);
+
+    fp = fopen(TEST_DB, "r");
+    CU_ASSERT_PTR_NOT_NULL(fp);
+    if (fp == NULL) {
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    file_size = ftell(fp);
+    rewind(fp);
+    sdp_buffer = malloc(file_size + 1);
+    CU_ASSERT_EQUAL(fread(sdp_buffer, 1, file_size, fp), file_size);
+    sdp_buffer[file_size] = '\0';
+    fclose(fp);
+
+    /* The same lineup keeps every channel in place */
+    status = cfg_parse_all_channel_data(sdp_buffer);
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+    CU_ASSERT(cfg_validate_all());
+    status = cfg_commit_update();
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+    CU_ASSERT_EQUAL(cfg_get_total_num_channels(), TOTAL_CHANNELS);
+    CU_ASSERT_EQUAL(cfg_get_total_num_input_channels(), TOTAL_CHANNELS);
+    for (i = 0; i < TOTAL_CHANNELS; i++) {
+        CU_ASSERT_PTR_EQUAL(cfg_get_channel_cfg_from_idx(i), channels[i]);
+    }
+    cfg_cleanup_update();
+
+    /* Dropping the first session only removes its channel */
+    second_p = strstr(sdp_buffer, "\nv=0");
+    if (second_p) {
+        second_p = strstr(second_p + 1, "\nv=0");
+    }
+    CU_ASSERT_PTR_NOT_NULL(second_p);
+    if (second_p) {
+        status = cfg_parse_all_channel_data(second_p + 1);
+        CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+        status = cfg_commit_update();
+        CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+        CU_ASSERT_EQUAL(cfg_get_total_num_channels(), TOTAL_CHANNELS - 1);
+        for (i = 1; i < TOTAL_CHANNELS; i++) {
+            CU_ASSERT_PTR_EQUAL(cfg_get_channel_cfg_from_idx(i - 1), 
+                                channels[i]);
+        }
+        cfg_cleanup_update();
+    }
+
+    /* Restoring it adds the channel back */
+    status = cfg_parse_all_channel_data(sdp_buffer);
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+    status = cfg_commit_update();
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+    CU_ASSERT_EQUAL(cfg_get_total_num_channels(), TOTAL_CHANNELS);
+    channel_p = cfg_get_channel_cfg_from_idx(TOTAL_CHANNELS - 1);
+    CU_ASSERT_PTR_NOT_NULL(channel_p);
+    if (channel_p) {
+        CU_ASSERT_STRING_EQUAL(channel_p->session_key, first_key);
+    }
+    cfg_cleanup_update();
+
+    free(sdp_buffer);
+    status = cfg_shutdown();
+    CU_ASSERT_EQUAL(status, CFG_SUCCESS);
+}
+
+
+/*
+ * The outcome of parsing a lineup: the channels in order with their
+ * handles, the statistics of the update and the messages logged to
+ * stderr while parsing.
+ */
+#define LINEUP_MAX_CHANNELS (2 * TOTAL_CHANNELS + 2)
+#define LINEUP_LOG_SIZE 16384
+
+typedef struct cfgmgr_lineup_result_ {
+    uint16_t total;
+    char session_keys[LINEUP_MAX_CHANNELS][MAX_KEY_LENGTH];
+    idmgr_id_t handles[LINEUP_MAX_CHANNELS];
+    boolean active[LINEUP_MAX_CHANNELS];
+    uint32_t chksums[LINEUP_MAX_CHANNELS];
+    uint32_t parsed;
+    uint32_t validated;
+    uint32_t input;
+    uint32_t syntax_errors;
+    char update_stats[DATA_SIZE];
+    char log[LINEUP_LOG_SIZE];
+} cfgmgr_lineup_result_t;
+
+static cfgmgr_lineup_result_t serial_result;
+static cfgmgr_lineup_result_t threaded_result;
+
+static void cfgmgr_parse_lineup (char *buffer,
+                                 uint32_t num_threads,
+                                 cfgmgr_lineup_result_t *result_p)
+{
+    channel_mgr_t *mgr_p;
+    channel_cfg_t *channel_p;
+    cfg_stats_t stats;
+    FILE *log_fp;
+    int stderr_fd;
+    int i;
+
+    memset(result_p, 0, sizeof(cfgmgr_lineup_result_t));
+
+    /* Start from an empty lineup, with handles given out in order */
+    CU_ASSERT_EQUAL(cfg_init(NULL), CFG_SUCCESS);
+    mgr_p = cfg_get_channel_mgr();
+    CU_ASSERT_PTR_NOT_NULL(mgr_p);
+    if (mgr_p == NULL) {
+        return;
+    }
+    CU_ASSERT(id_table_set_no_randomize(mgr_p->handle_mgr));
+
+    cfg_set_parse_threads(num_threads);
+    log_fp = tmpfile();
+    CU_ASSERT_PTR_NOT_NULL(log_fp);
+    fflush(stderr);
+    stderr_fd = dup(STDERR_FILENO);
+    if (log_fp) {
+        dup2(fileno(log_fp), STDERR_FILENO);
+    }
+    CU_ASSERT_EQUAL(cfg_parse_all_channel_data(buffer), CFG_SUCCESS);
+    fflush(stderr);
+    dup2(stderr_fd, STDERR_FILENO);
+    close(stderr_fd);
+    if (log_fp) {
+        rewind(log_fp);
+        CU_ASSERT(fread(result_p->log, 1, LINEUP_LOG_SIZE - 1, log_fp) <
+                  LINEUP_LOG_SIZE - 1);
+        fclose(log_fp);
+    }
+    cfg_get_update_stats(result_p->update_stats, DATA_SIZE);
+    cfg_get_update_stats_values(&stats);
+    result_p->syntax_errors = stats.num_syntax_errors;
+    CU_ASSERT_EQUAL(cfg_commit_update(), CFG_SUCCESS);
+    cfg_set_parse_threads(0);
+
+    result_p->total = cfg_get_total_num_channels();
+    CU_ASSERT(result_p->total <= LINEUP_MAX_CHANNELS);
+    for (i = 0; i < result_p->total && i < LINEUP_MAX_CHANNELS; i++) {
+        channel_p = cfg_get_channel_cfg_from_idx(i);
+        CU_ASSERT_PTR_NOT_NULL(channel_p);
+        if (channel_p) {
+            strncpy(result_p->session_keys[i], channel_p->session_key,
+                    MAX_KEY_LENGTH);
+            result_p->handles[i] = channel_p->handle;
+            result_p->active[i] = channel_p->active;
+            result_p->chksums[i] = channel_p->chksum;
+            CU_ASSERT_EQUAL(channel_p->handle, mgr_p->handles[i]);
+        }
+    }
+    CU_ASSERT_EQUAL(cfg_get_cfg_stats(&result_p->parsed,
+                                      &result_p->validated,
+                                      &result_p->input), CFG_SUCCESS);
+
+    cfg_cleanup_update();
+    CU_ASSERT_EQUAL(cfg_shutdown(), CFG_SUCCESS);
+}
+
+
+void test_cfgmgr_parse_threads (void)
+{
+    /* Worker counts to compare with the serial parse: uneven splits,
+       more workers than the maximum and than there are sessions */
+    uint32_t num_threads[] = { 2, 3, 5, 16, 64 };
+    FILE *fp;
+    long file_size;
+    size_t len;
+    char *sdp_buffer;
+    char *lineup;
+    int i, j;
+
+    fp = fopen(TEST_DB, "r");
+    CU_ASSERT_PTR_NOT_NULL(fp);
+    if (fp == NULL) {
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    file_size = ftell(fp);
+    rewind(fp);
+    sdp_buffer = malloc(file_size + 1);
+    CU_ASSERT_EQUAL(fread(sdp_buffer, 1, file_size, fp), file_size);
+    sdp_buffer[file_size] = '\0';
+    fclose(fp);
+
+    /* An invalid channel, a session that fails to parse, then the
+       lineup twice so that every channel is repeated */
+    len = strlen(BAD_RTP_PORT) + strlen(BAD_VERSION) + 2 * file_size + 32;
+    lineup = malloc(len);
+    snprintf(lineup, len, "%s--\n%s--\n%s\n--\n%s",
+             BAD_RTP_PORT, BAD_VERSION, sdp_buffer, sdp_buffer);
+    free(sdp_buffer);
+
+    cfgmgr_parse_lineup(lineup, 0, &serial_result);
+    CU_ASSERT_EQUAL(serial_result.input, 2 * TOTAL_CHANNELS + 2);
+    CU_ASSERT_EQUAL(serial_result.validated, TOTAL_CHANNELS);
+    CU_ASSERT_EQUAL(serial_result.syntax_errors, 1);
+    CU_ASSERT(serial_result.total >= TOTAL_CHANNELS);
+
+    /* A single thread parses serially as well */
+    cfgmgr_parse_lineup(lineup, 1, &threaded_result);
+    CU_ASSERT_EQUAL(memcmp(&serial_result, &threaded_result,
+                           sizeof(cfgmgr_lineup_result_t)), 0);
+
+    for (i = 0; i < sizeof(num_threads) / sizeof(num_threads[0]); i++) {
+        cfgmgr_parse_lineup(lineup, num_threads[i], &threaded_result);
+
+        CU_ASSERT_EQUAL(threaded_result.total, serial_result.total);
+        for (j = 0; j < serial_result.total &&
+                 j < LINEUP_MAX_CHANNELS; j++) {
+            CU_ASSERT_STRING_EQUAL(threaded_result.session_keys[j],
+                                   serial_result.session_keys[j]);
+            CU_ASSERT_EQUAL(threaded_result.handles[j],
+                            serial_result.handles[j]);
+            CU_ASSERT_EQUAL(threaded_result.active[j],
+                            serial_result.active[j]);
+            CU_ASSERT_EQUAL(threaded_result.chksums[j],
+                            serial_result.chksums[j]);
+        }
+        CU_ASSERT_EQUAL(threaded_result.parsed, serial_result.parsed);
+        CU_ASSERT_EQUAL(threaded_result.validated, serial_result.validated);
+        CU_ASSERT_EQUAL(threaded_result.input, serial_result.input);
+        CU_ASSERT_EQUAL(threaded_result.syntax_errors,
+                        serial_result.syntax_errors);
+        CU_ASSERT_STRING_EQUAL(threaded_result.update_stats,
+                               serial_result.update_stats);
+
+        /* The workers log nothing, and the messages come in order */
+        CU_ASSERT_STRING_EQUAL(threaded_result.log, serial_result.log);
+    }
+
+    free(lineup);
+}
+
+
 void test_cfgmgr_access (void)
 {
     cfg_ret_e status;
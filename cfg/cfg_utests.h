@@ -19,6 +19,7 @@ void test_channel_compare(void);
 void test_channel_get(void);
 void test_parse_channels(void);
 void test_parse_single_channel(void);
+void test_channel_extract_quiet(void);
 void test_channel_valid1(void);
 void test_channel_valid2(void);
 void test_channel_valid3(void);
@@ -59,6 +60,7 @@ void test_db_open(void);
 void test_db_close(void);
 void test_db_read(void);
 void test_db_write(void);
+void test_db_snapshot(void);
 
 /*****************************************************************
  *             Channel configuration manager testsuite
@@ -68,6 +70,8 @@ int cfgmgr_testsuite_cleanup(void);
 void test_cfgmgr_init(void);
 void test_cfgmgr_shutdown(void);
 void test_cfgmgr_update(void);
+void test_cfgmgr_update_diff(void);
+void test_cfgmgr_parse_threads(void);
 void test_cfgmgr_save(void);
 void test_cfgmgr_access(void);
 void test_cfgmgr_removeFBTs(void);
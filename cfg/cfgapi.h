@@ -245,6 +245,11 @@ extern void cfg_set_db_name(const char *cfg_db_name);
 /*! \fn cfg_ret_e cfg_init(const char *cfg_db_name)
     \brief Initialize the configuration module.
 
+    The channels are loaded from the binary snapshot of the database,
+    cfg_db_name with a ".snapshot" suffix, when it was taken from the same
+    database contents; otherwise the database is parsed and the snapshot
+    is rewritten.
+
     \param cfg_db_name The name of configuration database.
 */
 extern cfg_ret_e cfg_init(const char *cfg_db_name);
@@ -307,6 +312,15 @@ extern cfg_ret_e cfg_get_all_channel_data(char *data_buffer,
 */
 extern cfg_ret_e cfg_parse_all_channel_data(char *data_buffer);
 
+/*! \fn void cfg_set_parse_threads(uint32_t num_threads)
+    \brief Set the number of threads cfg_parse_all_channel_data() parses
+    and validates the sessions of a lineup with.
+
+    \param num_threads Number of threads; 0 or 1 parses the lineup on the
+    calling thread only, which is the default.
+*/
+extern void cfg_set_parse_threads(uint32_t num_threads);
+
 /*! \fn cfg_ret_e cfg_parse_single_channel_data(char *data_buffer,
                                                 channel_cfg_t *chan_cfg,
                                                 cfg_chan_type_e chan_type)
@@ -27,6 +27,7 @@ CU_TestInfo test_cfg_channel[] = {
     { "channel configuration get", test_channel_get },
     { "channel configuration parse", test_parse_channels },
     { "channel configuration single channel", test_parse_single_channel },
+    { "channel configuration quiet extraction", test_channel_extract_quiet },
     { "channel configuration validate version", test_channel_valid1 },
     { "channel configuration validate IP version", test_channel_valid2 },
     { "channel configuration validate non-zero time values",
@@ -64,6 +65,7 @@ CU_TestInfo test_cfg_database[] = {
     { "configuration database close", test_db_close },
     { "configuration database read", test_db_read },
     { "configuration database write", test_db_write },
+    { "configuration database snapshot", test_db_snapshot },
     CU_TEST_INFO_NULL,
 };
 
@@ -71,6 +73,8 @@ CU_TestInfo test_configmgr[] = {
     { "configuration manager initialization", test_cfgmgr_init },
     { "configuration manager shutdown", test_cfgmgr_shutdown },
     { "configuration manager update", test_cfgmgr_update },
+    { "configuration manager incremental update", test_cfgmgr_update_diff },
+    { "configuration manager threaded parse", test_cfgmgr_parse_threads },
     { "configuration manager access functions", test_cfgmgr_access },
     { "configuration manager save", test_cfgmgr_save },
     { "configuration manager remove FBTs", test_cfgmgr_removeFBTs },
@@ -12,6 +12,7 @@
 #include <sys/time.h>
 #include "rtp_repair_recv.h"
 #include "rtp_era_recv.h"
+#include "vqec_rtcp_mux.h"
 #include "rtcp_stats_api.h"
 #include "vqec_debug.h"
 #include "vqec_event.h"
@@ -220,7 +221,27 @@ rtp_era_recv_t *rtp_create_session_era_recv (vqec_dp_streamid_t dp_id,
     memset(p_era_recv, 0, sizeof(rtp_era_recv_t));    
     p_era_recv->rtcp_mem = &rtp_era_recv_memory;
 
-    if (recv_rtcp_port) {
+    if (recv_rtcp_port && !IN_MULTICAST(ntohl(era_dest_addr)) &&
+        vqec_rtcp_mux_enabled()) {
+        /*
+         * Unicast RTCP receive sockets are shared: attach to the
+         * shared socket, which is read by the shared socket module.
+         */
+        p_era_recv->era_rtcp_sock = 
+            vqec_rtcp_mux_attach(&p_era_recv->rtcp_mux,
+                                 (rtp_session_t *)p_era_recv,
+                                 TRUE,
+                                 src_addr,
+                                 &recv_rtcp_port,
+                                 fbt_ip_addr,
+                                 send_rtcp_port,
+                                 sock_buf_depth,
+                                 rtcp_dscp_value);
+        if (!p_era_recv->era_rtcp_sock) {
+            syslog_print(VQEC_ERROR, "unable to open recv rtcp socket\n");
+            goto fail;
+        }
+    } else if (recv_rtcp_port) {
         /* 
          * Only create the RTCP receive socket if the 
          * recv_rtcp_port is non-zero.
@@ -442,6 +463,13 @@ rtp_update_session_era_recv (rtp_era_recv_t *p_era_recv,
         success = FALSE;
         goto done;
     }
+    if (p_era_recv->rtcp_mux &&
+        !vqec_rtcp_mux_update(p_era_recv->rtcp_mux,
+                              fbt_ip_addr, send_rtcp_port)) {
+        syslog_print(VQEC_ERROR, "failed to update shared rtcp socket\n");
+        success = FALSE;
+        goto done;
+    }
     p_era_recv->send_addrs.dst_addr = fbt_ip_addr;
     p_era_recv->send_addrs.dst_port = send_rtcp_port;
 done:
@@ -524,6 +552,11 @@ void rtp_delete_session_era_recv (rtp_era_recv_t **pp_era_recv,
         }
         (*pp_era_recv)->era_rtcp_xmit_sock = -1;
     }
+    if ((*pp_era_recv)->rtcp_mux) {
+        /* detach from a shared socket, which is closed by its owner */
+        (*pp_era_recv)->era_rtcp_sock = NULL;
+        vqec_rtcp_mux_detach(&(*pp_era_recv)->rtcp_mux);
+    }
     if ((*pp_era_recv)->era_rtcp_sock) {
         /* remove the event from the handler */
         vqec_event_destroy(&((*pp_era_recv)->era_rtcp_sock)->vqec_ev);
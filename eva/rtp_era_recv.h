@@ -27,6 +27,7 @@ extern "C" {
 
 struct vqec_chan_;
 struct rtp_era_recv_t_;
+struct vqec_rtcp_mux_sess_;
 
 /*
  * The ERA-RECV member class is derived from the SSM_RSI RTP member class
@@ -91,6 +92,11 @@ typedef struct era_recv_member_ {
      * RTCP transmit socket.                                    \
      */                                                         \
     int32_t era_rtcp_xmit_sock;                                 \
+    /**                                                         \
+     * Attachment to a shared RTCP receive socket, if the       \
+     * receive socket is shared.                                \
+     */                                                         \
+    struct vqec_rtcp_mux_sess_ *rtcp_mux;                       \
     /**                                                         \
      * Dataplane input stream identifier.                       \
      */                                                         \
@@ -21,6 +21,7 @@
 #include "vqec_rtp.h"
 #include "vqec_assert_macros.h"
 #include "vqec_event.h"
+#include "vqec_rtcp_mux.h"
 #include "vqec_channel_private.h"
 
 #ifdef _VQEC_UTEST_INTERPOSERS
@@ -297,16 +298,33 @@ rtp_create_session_repair_recv (vqec_dp_streamid_t dp_id,
     /* 
      * Create the repair rtcp session receive socket. If the rx rtcp
      * port is specified as 0, a port will be dynamically selected.
+     * If receive sockets are shared, attach to the shared socket
+     * instead: it is read by the shared socket module, and an
+     * ephemeral port is that of the socket shared by all ephemeral
+     * requests.
      */
-    p_repair_recv_sess->repair_rtcp_sock = 
+    if (vqec_rtcp_mux_enabled()) {
+        rtcp_sock =
+            vqec_rtcp_mux_attach(&p_repair_recv_sess->rtcp_mux,
+                                 (rtp_session_t *)p_repair_recv_sess,
+                                 FALSE,
+                                 src_addr,
+                                 recv_rtcp_port,
+                                 fbt_ip_addr,
+                                 send_rtcp_port,
+                                 sock_buf_depth,
+                                 rtcp_dscp_value);
+    } else {
         rtcp_sock =  
-        vqec_recv_sock_create("repair rtcp sock",
-                              src_addr,      
-                              *recv_rtcp_port,
-                              src_addr,
-                              FALSE,
-                              sock_buf_depth,
-                              rtcp_dscp_value);
+            vqec_recv_sock_create("repair rtcp sock",
+                                  src_addr,      
+                                  *recv_rtcp_port,
+                                  src_addr,
+                                  FALSE,
+                                  sock_buf_depth,
+                                  rtcp_dscp_value);
+    }
+    p_repair_recv_sess->repair_rtcp_sock = rtcp_sock;
     if (!rtcp_sock) {
         syslog_print(VQEC_ERROR, "unable to create unicast rtcp socket\n");
         goto fail;
@@ -320,13 +338,14 @@ rtp_create_session_repair_recv (vqec_dp_streamid_t dp_id,
     }
 
     /* the event invoked when packets are received on the repair session. */ 
-    if (!vqec_event_create(&rtcp_sock->vqec_ev,
-                           VQEC_EVTYPE_FD, 
-                           VQEC_EV_READ | VQEC_EV_RECURRING,
-                           repair_rtcp_event_handler, 
-                           rtcp_sock->fd,
-                           p_repair_recv_sess) ||
-        !vqec_event_start(rtcp_sock->vqec_ev, NULL)) {
+    if (!p_repair_recv_sess->rtcp_mux &&
+        (!vqec_event_create(&rtcp_sock->vqec_ev,
+                            VQEC_EVTYPE_FD, 
+                            VQEC_EV_READ | VQEC_EV_RECURRING,
+                            repair_rtcp_event_handler, 
+                            rtcp_sock->fd,
+                            p_repair_recv_sess) ||
+         !vqec_event_start(rtcp_sock->vqec_ev, NULL))) {
 
         vqec_event_destroy(&rtcp_sock->vqec_ev);
         syslog_print(VQEC_ERROR, "failed to add event");
@@ -474,6 +493,13 @@ rtp_update_session_repair_recv (rtp_repair_recv_t *p_repair_recv,
         success = FALSE;
         goto done;
     }
+    if (p_repair_recv->rtcp_mux &&
+        !vqec_rtcp_mux_update(p_repair_recv->rtcp_mux,
+                              fbt_ip_addr, send_rtcp_port)) {
+        syslog_print(VQEC_ERROR, "failed to update shared rtcp socket\n");
+        success = FALSE;
+        goto done;
+    }
     p_repair_recv->send_addrs.dst_addr = fbt_ip_addr;
     p_repair_recv->send_addrs.dst_port = send_rtcp_port;
 done:
@@ -553,6 +579,15 @@ rtp_delete_session_repair_recv (rtp_repair_recv_t **pp_repair_recv_sess,
        vqec_event_destroy(&(*pp_repair_recv_sess)->member_timeout_event);
    }
 
+   /* 
+    * detach from a shared rtcp socket, which is closed by its owner.
+    */
+   if ((*pp_repair_recv_sess)->rtcp_mux) {
+       (*pp_repair_recv_sess)->repair_rtcp_xmit_sock = -1;
+       (*pp_repair_recv_sess)->repair_rtcp_sock = NULL;
+       vqec_rtcp_mux_detach(&(*pp_repair_recv_sess)->rtcp_mux);
+   }
+
    /* delete the event associated with the repair rtcp socket. */
    if ((*pp_repair_recv_sess)->repair_rtcp_sock) {
        if ((*pp_repair_recv_sess)->repair_rtcp_sock->vqec_ev) {
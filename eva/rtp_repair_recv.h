@@ -24,6 +24,7 @@ extern "C" {
 
 struct vqec_chan_;
 struct rtp_repair_recv_t_;
+struct vqec_rtcp_mux_sess_;
 
 /*
  * The repair-recv session is derived from the rtp_ptp session.
@@ -101,6 +102,11 @@ struct rtp_repair_recv_t_;
      * Repair rtcp socket.                                              \
      */                                                                 \
     vqec_recv_sock_t *repair_rtcp_sock;                                 \
+    /**                                                                 \
+     * Attachment to a shared RTCP receive socket, if the receive       \
+     * socket is shared.                                                \
+     */                                                                 \
+    struct vqec_rtcp_mux_sess_ *rtcp_mux;                               \
     /**                                                                 \
      * Parent channel object.                                           \
      */                                                                 \
@@ -42,6 +42,8 @@ boolean vqec_pcm_gap_get_gaps_internal(vqec_pcm_t *pcm,
                                        uint32_t buf_len,
                                        vqec_seq_num_t *highest_seq,
                                        boolean *more);
+void vqec_pcm_gap_ev_arm(vqec_pcm_t *pcm, vqec_seq_num_t gap_start);
+void vqec_pcm_gap_ev_check_aged(vqec_pcm_t *pcm, abs_time_t cur_time);
 
 /*
  *  Unit tests for vqe_bitmap
@@ -553,6 +555,80 @@ void test_vqec_bitmap_optimizations (void)
 
 }
 
+/*
+ * Aged-gap events of the PCM: every gap raises an event once it ages,
+ * including gaps that open while an earlier one is still aging.
+ */
+void test_vqec_pcm_gap_ev (void)
+{
+    vqec_pcm_t *pcm;
+    abs_time_t now = TIME_MK_A(msec, 1000);
+    rel_time_t coalesce = VQEC_PCM_GAP_EV_COALESCE_TIME;
+    int i;
+
+    pcm = malloc(sizeof(vqec_pcm_t));
+    CU_ASSERT(pcm != NULL);
+    if (!pcm) {
+        return;
+    }
+    memset(pcm, 0, sizeof(vqec_pcm_t));
+    pcm->er_enable = TRUE;
+
+    /* two overlapping gaps: the second opens while the first ages */
+    pcm->highest_er_seq_num = 90;
+    vqec_pcm_gap_ev_arm(pcm, 100);
+    vqec_pcm_gap_ev_arm(pcm, 150);
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    CU_ASSERT(!vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+
+    /* the first gap ages */
+    pcm->highest_er_seq_num = 120;
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    CU_ASSERT(pcm->gap_ev_num == 1);
+    CU_ASSERT(!vqec_pcm_gap_ev_due(pcm, now));
+    CU_ASSERT(vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+    CU_ASSERT(!vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+
+    /* the second gap raises its own event when it ages */
+    now = TIME_ADD_A_R(now, MSECS(20));
+    pcm->highest_er_seq_num = 140;
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    CU_ASSERT(!vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+    pcm->highest_er_seq_num = 150;
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    CU_ASSERT(pcm->gap_ev_num == 0);
+    CU_ASSERT(vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+
+    /* gaps aging within the coalescing window share one event */
+    vqec_pcm_gap_ev_arm(pcm, 200);
+    vqec_pcm_gap_ev_arm(pcm, 210);
+    pcm->highest_er_seq_num = 200;
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    pcm->highest_er_seq_num = 210;
+    vqec_pcm_gap_ev_check_aged(pcm, TIME_ADD_A_R(now, MSECS(2)));
+    CU_ASSERT(vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+    CU_ASSERT(!vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, MSECS(10))));
+
+    /* beyond the queue, the newest gap stands in for the others */
+    for (i = 0; i < VQEC_PCM_GAP_EV_MAX + 2; i++) {
+        vqec_pcm_gap_ev_arm(pcm, 300 + i * 10);
+    }
+    CU_ASSERT(pcm->gap_ev_num == VQEC_PCM_GAP_EV_MAX);
+    CU_ASSERT(pcm->gap_ev_seq_num[VQEC_PCM_GAP_EV_MAX - 1] == 
+              300 + (VQEC_PCM_GAP_EV_MAX + 1) * 10);
+    pcm->highest_er_seq_num = 300 + (VQEC_PCM_GAP_EV_MAX + 1) * 10;
+    vqec_pcm_gap_ev_check_aged(pcm, now);
+    CU_ASSERT(pcm->gap_ev_num == 0);
+    CU_ASSERT(vqec_pcm_gap_ev_due(pcm, TIME_ADD_A_R(now, coalesce)));
+
+    /* no events without error repair */
+    pcm->er_enable = FALSE;
+    vqec_pcm_gap_ev_arm(pcm, 400);
+    CU_ASSERT(pcm->gap_ev_num == 0);
+
+    free(pcm);
+}
+
 int test_vqec_bitmap_clean (void)
 {
     return 0;
@@ -573,5 +649,6 @@ CU_TestInfo test_array_bitmap[] = {
     {"test vqec_bitmap_flush",test_vqec_bitmap_flush},
     {"test vqec_bitmap_optimizations",test_vqec_bitmap_optimizations},
     {"test vqec_bitmap_destroy",test_vqec_bitmap_destroy},
+    {"test vqec_pcm_gap_ev",test_vqec_pcm_gap_ev},
     CU_TEST_INFO_NULL,
 };
@@ -162,6 +162,34 @@ static void test_vqec_channel_tests (void) {
     CU_ASSERT(status == VQEC_CHAN_ERR_OK)
     CU_ASSERT(chanid3 != VQEC_CHANID_INVALID);
 
+    /* Look the channels up by destination, and by URL */
+    status = vqec_chan_find_chanid(&chanid_temp, 
+                                   cfg2.primary_dest_addr.s_addr,
+                                   cfg2.primary_dest_port);
+    CU_ASSERT(status == VQEC_CHAN_ERR_OK);
+    CU_ASSERT(chanid_temp == chanid2);
+    status = vqec_chan_find_chanid(&chanid_temp, 
+                                   cfg2.primary_dest_addr.s_addr,
+                                   cfg2.primary_dest_port + 1);
+    CU_ASSERT(status == VQEC_CHAN_ERR_NOTFOUND);
+    status = vqec_chan_find_chanid_by_url(&chanid_temp, 
+                                          "udp://224.1.1.2:50000");
+    CU_ASSERT(status == VQEC_CHAN_ERR_NOTFOUND);
+    vqec_chan_index_url(chanid2, "udp://224.1.1.2:50000");
+    status = vqec_chan_find_chanid_by_url(&chanid_temp, 
+                                          "udp://224.1.1.2:50000");
+    CU_ASSERT(status == VQEC_CHAN_ERR_OK);
+    CU_ASSERT(chanid_temp == chanid2);
+    vqec_chan_index_url(chanid3, "udp://224.1.1.2:50000");
+    status = vqec_chan_find_chanid_by_url(&chanid_temp, 
+                                          "udp://224.1.1.2:50000");
+    CU_ASSERT(status == VQEC_CHAN_ERR_OK);
+    CU_ASSERT(chanid_temp == chanid3);
+    vqec_chan_flush_url_index();
+    status = vqec_chan_find_chanid_by_url(&chanid_temp, 
+                                          "udp://224.1.1.2:50000");
+    CU_ASSERT(status == VQEC_CHAN_ERR_NOTFOUND);
+
     /* Create a tuner, and bind it to the first channel */
     CU_ASSERT(vqec_tuner_create(&tunerid1, "tuner1") == VQEC_OK);
     bp = vqec_ifclient_bind_params_create();
@@ -14,6 +14,7 @@
 
 #include <sys/event.h>
 #include "vqec_event.h"
+#include "vqec_event_profile.h"
 #include <pthread.h>
 
 #include "vqec_lock_defs.h"
@@ -43,6 +44,10 @@ struct vqec_event_
                                 //!<  Callback function
     struct      timeval tv;
                                 //!<  Associated timeout (timers)
+    abs_time_t  sched_time;
+                                //!<  Scheduled expiration time (timers)
+    vqec_event_profile_t *prof;
+                                //!<  Profile of events of the same name
     struct      event ev; 
                                 //!<  Libevent event object
 };
@@ -672,6 +677,157 @@ static void test_vqec_g_ev_handler (void)
     vqec_event_destroy(&test_event);
 }
 
+static void test_vqec_event_profile_table (void)
+{
+    static vqec_event_profile_t tbl[VQEC_EVENT_PROFILE_MAX];
+    vqec_event_profile_t copy[2], *prof, *first, *other;
+    char name[VQEC_EVENT_PROFILE_NAME_LEN];
+    char long_name[VQEC_EVENT_PROFILE_NAME_LEN + 8];
+    uint32_t num = 0, i;
+
+    /* names are added in the order first seen, and found again */
+    first = vqec_event_profile_lookup(tbl, &num, "handler_a");
+    CU_ASSERT(num == 1 && first == &tbl[0]);
+    CU_ASSERT(!strcmp(first->name, "handler_a"));
+    CU_ASSERT(first->runs == 0);
+    prof = vqec_event_profile_lookup(tbl, &num, "handler_b");
+    CU_ASSERT(num == 2 && prof == &tbl[1]);
+    CU_ASSERT(vqec_event_profile_lookup(tbl, &num, "handler_a") == first);
+    CU_ASSERT(num == 2);
+    prof = vqec_event_profile_lookup(tbl, &num, NULL);
+    CU_ASSERT(num == 3);
+    CU_ASSERT(!strcmp(prof->name, VQEC_EVENT_PROFILE_OTHER));
+
+    /* run counts and maximum execution times */
+    vqec_event_profile_record(first, TIME_MK_R(usec, 100), FALSE, REL_TIME_0);
+    vqec_event_profile_record(first, TIME_MK_R(usec, 300), FALSE, REL_TIME_0);
+    vqec_event_profile_record(first, TIME_MK_R(usec, 200), FALSE, REL_TIME_0);
+    CU_ASSERT(first->runs == 3);
+    CU_ASSERT(first->total_usecs == 600);
+    CU_ASSERT(first->max_usecs == 300);
+    CU_ASSERT(first->timer_runs == 0);
+    CU_ASSERT(first->total_late_usecs == 0);
+
+    /* lateness is only accounted for timers; negative times count as 0 */
+    vqec_event_profile_record(first, TIME_MK_R(usec, -5), TRUE, 
+                              TIME_MK_R(usec, 1000));
+    vqec_event_profile_record(first, TIME_MK_R(usec, 50), TRUE, 
+                              TIME_MK_R(usec, -1000));
+    vqec_event_profile_record(first, TIME_MK_R(usec, 50), TRUE, 
+                              TIME_MK_R(usec, 4000));
+    CU_ASSERT(first->runs == 6);
+    CU_ASSERT(first->total_usecs == 700);
+    CU_ASSERT(first->max_usecs == 300);
+    CU_ASSERT(first->timer_runs == 3);
+    CU_ASSERT(first->total_late_usecs == 5000);
+    CU_ASSERT(first->max_late_usecs == 4000);
+
+    /* maxima saturate rather than wrap */
+    vqec_event_profile_record(first, TIME_MK_R(sec, 5000), TRUE,
+                              TIME_MK_R(sec, 5000));
+    CU_ASSERT(first->max_usecs == VQEC_EVENT_PROFILE_USECS_MAX);
+    CU_ASSERT(first->max_late_usecs == VQEC_EVENT_PROFILE_USECS_MAX);
+    CU_ASSERT(first->total_usecs == 700 + 5000000000ULL);
+
+    /* once the table is full, new names share the "(other)" entry */
+    for (i = num; i < VQEC_EVENT_PROFILE_MAX - 1; i++) {
+        snprintf(name, sizeof(name), "handler_%u", i);
+        prof = vqec_event_profile_lookup(tbl, &num, name);
+        CU_ASSERT(prof == &tbl[i]);
+    }
+    CU_ASSERT(num == VQEC_EVENT_PROFILE_MAX - 1);
+    other = vqec_event_profile_lookup(tbl, &num, "handler_overflow_1");
+    CU_ASSERT(num == VQEC_EVENT_PROFILE_MAX);
+    CU_ASSERT(other == &tbl[VQEC_EVENT_PROFILE_MAX - 1]);
+    CU_ASSERT(!strcmp(other->name, VQEC_EVENT_PROFILE_OTHER));
+    CU_ASSERT(vqec_event_profile_lookup(tbl, &num, "handler_overflow_2")
+              == other);
+    CU_ASSERT(num == VQEC_EVENT_PROFILE_MAX);
+    vqec_event_profile_record(other, TIME_MK_R(usec, 10), FALSE, REL_TIME_0);
+    vqec_event_profile_record(
+        vqec_event_profile_lookup(tbl, &num, "handler_overflow_3"),
+        TIME_MK_R(usec, 20), FALSE, REL_TIME_0);
+    CU_ASSERT(other->runs == 2);
+    CU_ASSERT(other->max_usecs == 20);
+    CU_ASSERT(vqec_event_profile_lookup(tbl, &num, "handler_a") == first);
+
+    /* longer names are truncated, and share the entry of their prefix */
+    memset(long_name, 'x', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    num = 0;
+    prof = vqec_event_profile_lookup(tbl, &num, long_name);
+    CU_ASSERT(strlen(prof->name) == VQEC_EVENT_PROFILE_NAME_LEN - 1);
+    long_name[VQEC_EVENT_PROFILE_NAME_LEN - 1] = '\0';
+    CU_ASSERT(vqec_event_profile_lookup(tbl, &num, long_name) == prof);
+    CU_ASSERT(num == 1);
+
+    /* copies are bounded by the array */
+    num = VQEC_EVENT_PROFILE_MAX;
+    CU_ASSERT(vqec_event_profile_copy(tbl, num, NULL, 2) == 0);
+    CU_ASSERT(vqec_event_profile_copy(tbl, num, copy, 2) == 2);
+    CU_ASSERT(!memcmp(copy, tbl, sizeof(copy)));
+    CU_ASSERT(vqec_event_profile_copy(tbl, 1, copy, 2) == 1);
+}
+
+#define TEST_VQEC_EVENT_PROFILE_LATE_MSECS 20
+#define TEST_VQEC_EVENT_PROFILE_EXEC_MSECS 5
+
+static void 
+test_vqec_event_profile_handler (const vqec_event_t * const evptr, 
+                                 int32_t fd, int16_t ev, void *dptr)
+{
+    usleep(TEST_VQEC_EVENT_PROFILE_EXEC_MSECS * 1000);
+}
+
+static void test_vqec_event_profile (void)
+{
+    static vqec_event_profile_t prof[VQEC_EVENT_PROFILE_MAX];
+    vqec_event_profile_t *p = NULL;
+    uint32_t num, i;
+    boolean st;
+
+    /* events are profiled under the name of their handler */
+    test_event = NULL;
+    st = vqec_event_create(&test_event, 
+                           VQEC_EVTYPE_TIMER,
+                           VQEC_EV_ONESHOT,
+                           test_vqec_event_profile_handler, 
+                           VQEC_EVDESC_TIMER,
+                           NULL);
+    CU_ASSERT(st);
+    if (!st) {
+        return;
+    }
+    CU_ASSERT(test_event->prof != NULL);
+    CU_ASSERT(!strcmp(test_event->prof->name, 
+                      "test_vqec_event_profile_handler"));
+
+    /* a late timer run */
+    test_event->sched_time = 
+        TIME_SUB_A_R(get_sys_time(), 
+                     TIME_MK_R(msec, TEST_VQEC_EVENT_PROFILE_LATE_MSECS));
+    vqec_g_ev_handler(-1, EV_TIMEOUT, test_event);
+    vqec_event_destroy(&test_event);
+
+    num = vqec_event_get_profile(prof, VQEC_EVENT_PROFILE_MAX);
+    CU_ASSERT(num > 0 && num <= VQEC_EVENT_PROFILE_MAX);
+    for (i = 0; i < num; i++) {
+        if (!strcmp(prof[i].name, "test_vqec_event_profile_handler")) {
+            p = &prof[i];
+        }
+    }
+    CU_ASSERT(p != NULL);
+    if (!p) {
+        return;
+    }
+    CU_ASSERT(p->runs == 1);
+    CU_ASSERT(p->timer_runs == 1);
+    CU_ASSERT(p->max_usecs >= TEST_VQEC_EVENT_PROFILE_EXEC_MSECS * 1000);
+    CU_ASSERT(p->total_usecs == p->max_usecs);
+    CU_ASSERT(p->max_late_usecs >= TEST_VQEC_EVENT_PROFILE_LATE_MSECS * 1000);
+    CU_ASSERT(p->total_late_usecs == p->max_late_usecs);
+}
+
 CU_TestInfo test_array_event[] = {
     {"test vqec_event_libinit",test_vqec_event_libinit},
     {"test vqec_event_dispatch",test_vqec_event_dispatch},
@@ -681,6 +837,8 @@ CU_TestInfo test_array_event[] = {
     {"test vqec_event_stop",test_vqec_event_stop},
     {"test vqec_event_destroy",test_vqec_event_destroy},
     {"test vqec_g_ev_handler",test_vqec_g_ev_handler},
+    {"test vqec_event_profile_table",test_vqec_event_profile_table},
+    {"test vqec_event_profile",test_vqec_event_profile},
     CU_TEST_INFO_NULL,
 };
 
@@ -108,6 +108,35 @@ static void test_vqec_gap_reporter_construct_generic_nack_internal (
 
 }
 
+/*
+ * Builds the FCI payload for a gap list consisting of a single gap.
+ */
+static void test_vqec_gap_reporter_construct_generic_nack_run (
+    vqec_chan_t *chan,
+    rtcp_rtpfb_generic_nack_t *nd,
+    int *fci_count,
+    uint32_t *num_repairs,
+    uint32_t start_seq,
+    uint32_t extent)
+{
+    vqec_dp_gap_buffer_t gapbuf;
+
+    gapbuf.num_gaps = 1;
+    gapbuf.gap_list[0].start_seq = start_seq;
+    gapbuf.gap_list[0].extent = extent;
+    test_vqec_dp_chan_get_gap_report_use_interposer(
+        TRUE, VQEC_DP_ERR_OK, &gapbuf);
+    chan->er_policer_enabled = FALSE;
+
+    *fci_count =
+        vqec_gap_reporter_construct_generic_nack(chan, nd,
+                                                 VQEC_GAP_REPORTER_FCI_MAX,
+                                                 num_repairs);
+
+    test_vqec_dp_chan_get_gap_report_use_interposer(
+        FALSE, VQEC_CHANID_INVALID, NULL);
+}
+
 static void test_vqec_gap_reporter_construct_generic_nack (void)
 {
     rtcp_rtpfb_generic_nack_t nd[VQEC_GAP_REPORTER_FCI_MAX];
@@ -200,6 +229,44 @@ static void test_vqec_gap_reporter_construct_generic_nack (void)
     CU_ASSERT(chan1->stats.total_repairs_policed ==
               initial_repairs_policed_chan + 8);
 
+    /*
+     * A run of 40 packets takes two full fields and a PID with 5 bits...
+     */
+    test_vqec_gap_reporter_construct_generic_nack_run(
+        chan1, nd, &fci_count, &num_repairs, 100, 39);
+
+    CU_ASSERT(fci_count == 3);
+    CU_ASSERT(num_repairs == 40);
+    CU_ASSERT(nd[0].pid == 100);
+    CU_ASSERT(nd[0].bitmask == 0xffff);
+    CU_ASSERT(nd[1].pid == 117);
+    CU_ASSERT(nd[1].bitmask == 0xffff);
+    CU_ASSERT(nd[2].pid == 134);
+    CU_ASSERT(nd[2].bitmask == 0x001f);
+
+    /*
+     * ...a run which exactly fills the buffer is requested...
+     */
+    test_vqec_gap_reporter_construct_generic_nack_run(
+        chan1, nd, &fci_count, &num_repairs, 
+        0, (VQEC_GAP_REPORTER_FCI_MAX * 17) - 1);
+
+    CU_ASSERT(fci_count == VQEC_GAP_REPORTER_FCI_MAX);
+    CU_ASSERT(num_repairs == VQEC_GAP_REPORTER_FCI_MAX * 17);
+    CU_ASSERT(nd[VQEC_GAP_REPORTER_FCI_MAX - 1].pid == 
+              (VQEC_GAP_REPORTER_FCI_MAX - 1) * 17);
+    CU_ASSERT(nd[VQEC_GAP_REPORTER_FCI_MAX - 1].bitmask == 0xffff);
+
+    /*
+     * ...and one packet more is a suppressed jumbo gap.
+     */
+    test_vqec_gap_reporter_construct_generic_nack_run(
+        chan1, nd, &fci_count, &num_repairs, 
+        0, VQEC_GAP_REPORTER_FCI_MAX * 17);
+
+    CU_ASSERT(!fci_count);
+    CU_ASSERT(!num_repairs);
+
     vqec_ifclient_deinit();
 }
 
@@ -17,6 +17,10 @@
 #include "vqec_pthread.h"
 #include "vqec_syscfg.h"
 #include "vqec_updater.h"
+#include "vqec_metrics_export.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 #define VQEC_IFCLIENT_STARTED 2
 #define VQEC_IFCLIENT_STOPPED 3
@@ -817,6 +821,12 @@ void test_vqec_ifclient_histogram (void)
               == VQEC_OK);
     CU_ASSERT(vqec_ifclient_histogram_display(VQEC_HIST_JOIN_DELAY)
               == VQEC_OK);
+    CU_ASSERT(vqec_ifclient_histogram_clear(VQEC_HIST_LATENCY) == VQEC_OK);
+    CU_ASSERT(vqec_ifclient_histogram_display(VQEC_HIST_LATENCY) == VQEC_OK);
+
+    /* Latency of an unknown channel */
+    CU_ASSERT(vqec_ifclient_get_stats_channel_latency(NULL, NULL)
+              == VQEC_ERR_INVALIDARGS);
 }
 
 void test_vqec_ifclient_get_stats_channel (void)
@@ -878,6 +888,273 @@ void test_vqec_ifclient_get_stats_channel (void)
     CU_ASSERT(stats.tr135_severe_loss_min_distance == 0);
 }
 
+/*
+ * Check the summary of two tuners, each bound to its own channel, as
+ * returned by the non-cumulative or the cumulative variant. The channels
+ * are identified by the primary destination of their configuration.
+ */
+static void
+test_vqec_ifclient_check_stats_summary (
+    vqec_error_t (*get)(vqec_ifclient_stats_channel_summary_t *,
+                        uint32_t, uint32_t *,
+                        vqec_ifclient_stats_tuner_summary_t *,
+                        uint32_t, uint32_t *),
+    const vqec_tunerid_t *ids,
+    const in_addr_t *addrs,
+    const in_port_t *ports)
+{
+    vqec_ifclient_stats_channel_summary_t chans[4], few_chans[1];
+    vqec_ifclient_stats_tuner_summary_t tuners[4], few_tuners[1];
+    uint32_t num_chans, num_tuners, i, j;
+    int32_t idx;
+
+    CU_ASSERT(get(NULL, 1, &num_chans, NULL, 0, &num_tuners)
+              == VQEC_ERR_INVALIDARGS);
+    CU_ASSERT(get(chans, 4, NULL, tuners, 4, &num_tuners)
+              == VQEC_ERR_INVALIDARGS);
+
+    /* Both channels and tuners appear, each tuner with its channel */
+    CU_ASSERT(get(chans, 4, &num_chans, tuners, 4, &num_tuners) == VQEC_OK);
+    CU_ASSERT_EQUAL(num_chans, 2);
+    CU_ASSERT_EQUAL(num_tuners, 2);
+    if (num_chans != 2 || num_tuners != 2) {
+        return;
+    }
+    for (i = 0; i < num_chans; i++) {
+        CU_ASSERT(chans[i].num_tuners == 1);
+        CU_ASSERT(chans[i].primary_rtp_expected == 0);
+        CU_ASSERT(chans[i].primary_rtp_lost == 0);
+    }
+    for (i = 0; i < num_tuners; i++) {
+        for (j = 0; j < 2 && tuners[i].id != ids[j]; j++) {
+            ;
+        }
+        CU_ASSERT(j < 2);
+        idx = tuners[i].chan_index;
+        CU_ASSERT(idx >= 0 && idx < 2);
+        if (j < 2 && idx >= 0 && idx < 2) {
+            CU_ASSERT(chans[idx].primary_dest_addr.s_addr == addrs[j]);
+            CU_ASSERT(chans[idx].primary_dest_port == ports[j]);
+        }
+    }
+    CU_ASSERT(tuners[0].chan_index != tuners[1].chan_index);
+
+    /* No room for any entry */
+    CU_ASSERT(get(NULL, 0, &num_chans, NULL, 0, &num_tuners) == VQEC_OK);
+    CU_ASSERT_EQUAL(num_chans, 0);
+    CU_ASSERT_EQUAL(num_tuners, 0);
+
+    /* Room for fewer entries than are active */
+    CU_ASSERT(get(few_chans, 1, &num_chans, few_tuners, 1, &num_tuners)
+              == VQEC_OK);
+    CU_ASSERT_EQUAL(num_chans, 1);
+    CU_ASSERT_EQUAL(num_tuners, 1);
+    CU_ASSERT(few_chans[0].primary_dest_addr.s_addr ==
+              chans[0].primary_dest_addr.s_addr);
+    CU_ASSERT(few_tuners[0].id == tuners[0].id);
+
+    /*
+     * A tuner bound to a channel that did not fit is reported unbound,
+     * rather than with the index of a channel the caller does not have.
+     */
+    CU_ASSERT(get(few_chans, 1, &num_chans, tuners, 4, &num_tuners)
+              == VQEC_OK);
+    CU_ASSERT_EQUAL(num_chans, 1);
+    CU_ASSERT_EQUAL(num_tuners, 2);
+    for (i = 0; i < num_tuners; i++) {
+        CU_ASSERT(tuners[i].chan_index == 0 || tuners[i].chan_index == -1);
+        if (tuners[i].chan_index == 0) {
+            for (j = 0; j < 2 && tuners[i].id != ids[j]; j++) {
+                ;
+            }
+            CU_ASSERT(j < 2 && 
+                      few_chans[0].primary_dest_addr.s_addr == addrs[j] &&
+                      few_chans[0].primary_dest_port == ports[j]);
+        }
+    }
+    CU_ASSERT(tuners[0].chan_index != tuners[1].chan_index);
+}
+
+void test_vqec_ifclient_get_stats_summary (void)
+{
+    vqec_error_t err;
+    vqec_ifclient_stats_channel_summary_t chans[4];
+    vqec_ifclient_stats_tuner_summary_t tuners[4];
+    uint32_t num_chans, num_tuners, i;
+    vqec_sdp_handle_t sdp_handle;
+    vqec_tunerid_t ids[2];
+    in_addr_t addrs[2];
+    in_port_t ports[2];
+    static char *urls[2] = { "udp://224.1.1.1:50000",
+                             "udp://224.1.1.2:50000" };
+    static const char *names[2] = { "0", "1" };
+
+    vqec_ifclient_deinit();
+    err = vqec_ifclient_init("data/cfg_test_all_params_valid.cfg");
+    CU_ASSERT(err == VQEC_OK);
+
+    /* Nothing is active yet */
+    CU_ASSERT(vqec_ifclient_get_stats_summary(chans, 4, &num_chans,
+                                              tuners, 4, &num_tuners)
+              == VQEC_OK);
+    CU_ASSERT_EQUAL(num_chans, 0);
+    CU_ASSERT_EQUAL(num_tuners, 0);
+
+    /* Bind a tuner to each of two channels of the lineup */
+    addrs[0] = inet_addr("230.15.1.1");
+    ports[0] = htons(55300);
+    addrs[1] = inet_addr("230.15.1.2");
+    ports[1] = htons(55304);
+    for (i = 0; i < 2; i++) {
+        err = vqec_ifclient_tuner_create(&ids[i], names[i]);
+        CU_ASSERT(err == VQEC_OK);
+        sdp_handle = vqec_ifclient_alloc_sdp_handle_from_url(urls[i]);
+        err = vqec_ifclient_tuner_bind_chan(ids[i], sdp_handle, NULL);
+        CU_ASSERT(err == VQEC_OK);
+        vqec_ifclient_free_sdp_handle(sdp_handle);
+    }
+
+    test_vqec_ifclient_check_stats_summary(vqec_ifclient_get_stats_summary,
+                                           ids, addrs, ports);
+    test_vqec_ifclient_check_stats_summary(
+        vqec_ifclient_get_stats_summary_cumulative, ids, addrs, ports);
+
+    vqec_ifclient_deinit();
+}
+
+/*
+ * Check that the buckets of a rendered histogram are cumulative, and
+ * that the last one, labelled +Inf, matches the count.
+ */
+static void
+test_vqec_ifclient_metrics_check_hist (const char *text, const char *name)
+{
+    char prefix[64], line[128];
+    const char *p, *q, *last = NULL;
+    unsigned long long count, prev = 0;
+    int buckets = 0;
+
+    snprintf(line, sizeof(line), "# TYPE %s histogram\n", name);
+    CU_ASSERT(strstr(text, line) != NULL);
+
+    snprintf(prefix, sizeof(prefix), "%s_bucket{le=\"", name);
+    for (p = strstr(text, prefix); p; p = strstr(p + 1, prefix)) {
+        q = strstr(p, "} ");
+        CU_ASSERT(q != NULL);
+        if (!q) {
+            return;
+        }
+        CU_ASSERT(sscanf(q + 2, "%llu", &count) == 1);
+        CU_ASSERT(count >= prev);
+        prev = count;
+        last = p + strlen(prefix);
+        buckets++;
+    }
+    CU_ASSERT(buckets > 0);
+    CU_ASSERT(last && !strncmp(last, "+Inf\"}", 6));
+
+    snprintf(line, sizeof(line), "%s_count %llu\n", name, prev);
+    CU_ASSERT(strstr(text, line) != NULL);
+}
+
+/*
+ * Send a request to the metrics exporter, and read the response.
+ */
+static int
+test_vqec_ifclient_metrics_request (uint16_t port, 
+                                    const char *req,
+                                    char *buf,
+                                    int len)
+{
+    struct sockaddr_in addr;
+    int fd, n, used = 0;
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return (-1);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+        (send(fd, req, strlen(req), 0) != strlen(req))) {
+        close(fd);
+        return (-1);
+    }
+    while ((used < len - 1) && 
+           ((n = recv(fd, buf + used, len - 1 - used, 0)) > 0)) {
+        used += n;
+    }
+    buf[used] = '\0';
+    close(fd);
+    return (used);
+}
+
+#define TEST_METRICS_EXPORT_PORT 18099
+#define TEST_METRICS_EXPORT_BUFLEN (128 * 1024)
+
+void test_vqec_ifclient_metrics_export (void)
+{
+    static char buf[TEST_METRICS_EXPORT_BUFLEN];
+    char small[64];
+    int32_t len;
+
+    /* the channel bound by test_vqec_ifclient_get_stats_channel */
+    CU_ASSERT(vqec_metrics_export_render(NULL, sizeof(buf)) == -1);
+    CU_ASSERT(vqec_metrics_export_render(buf, 0) == -1);
+    len = vqec_metrics_export_render(buf, sizeof(buf));
+    CU_ASSERT(len > 0 && len < sizeof(buf));
+    CU_ASSERT(strlen(buf) == len);
+
+    /* dataplane global counters */
+    CU_ASSERT(strstr(buf, "# TYPE vqec_dp_graph_create counter\n") != NULL);
+    CU_ASSERT(strstr(buf, "\nvqec_dp_graph_create ") != NULL);
+
+    /* channel and tuner series */
+    CU_ASSERT(strstr(buf, "# TYPE vqec_channel_tuners gauge\n") != NULL);
+    CU_ASSERT(strstr(buf, "vqec_channel_tuners"
+                     "{channel=\"224.1.1.1:50000\"} 1\n") != NULL);
+    CU_ASSERT(strstr(buf, "# TYPE vqec_channel_primary_rtp_inputs "
+                     "counter\n") != NULL);
+    CU_ASSERT(strstr(buf, "vqec_channel_primary_rtp_inputs"
+                     "{channel=\"224.1.1.1:50000\"} 0\n") != NULL);
+    CU_ASSERT(strstr(buf, "# TYPE vqec_channel_primary_rtp_lost "
+                     "gauge\n") != NULL);
+    CU_ASSERT(strstr(buf, "# TYPE vqec_tuner_queue_depth gauge\n") != NULL);
+
+    /* histograms */
+    test_vqec_ifclient_metrics_check_hist(buf, "vqec_join_delay_msec");
+    test_vqec_ifclient_metrics_check_hist(buf, "vqec_output_sched_msec");
+    test_vqec_ifclient_metrics_check_hist(buf, "vqec_reader_jitter_msec");
+
+    /* event loop handler profiles */
+    CU_ASSERT(strstr(buf, "# TYPE vqec_event_runs counter\n") != NULL);
+
+    /* truncation still returns the length of the full rendering */
+    CU_ASSERT(vqec_metrics_export_render(small, sizeof(small)) == len);
+    CU_ASSERT(strlen(small) == sizeof(small) - 1);
+    CU_ASSERT(!strncmp(small, buf, sizeof(small) - 1));
+
+    /* served over HTTP: GET only */
+    CU_ASSERT(vqec_metrics_export_start(TEST_METRICS_EXPORT_PORT));
+    CU_ASSERT(test_vqec_ifclient_metrics_request(
+                  TEST_METRICS_EXPORT_PORT, "GET /metrics HTTP/1.0\r\n\r\n",
+                  buf, sizeof(buf)) > 0);
+    CU_ASSERT(!strncmp(buf, "HTTP/1.0 200 OK\r\n", 17));
+    CU_ASSERT(strstr(buf, "\r\n\r\n# HELP ") != NULL);
+    CU_ASSERT(test_vqec_ifclient_metrics_request(
+                  TEST_METRICS_EXPORT_PORT, "POST /metrics HTTP/1.0\r\n\r\n",
+                  buf, sizeof(buf)) > 0);
+    CU_ASSERT(!strncmp(buf, "HTTP/1.0 405 ", 13));
+    CU_ASSERT(strstr(buf, "# HELP ") == NULL);
+    CU_ASSERT(test_vqec_ifclient_metrics_request(
+                  TEST_METRICS_EXPORT_PORT, "HEAD /metrics HTTP/1.0\r\n\r\n",
+                  buf, sizeof(buf)) > 0);
+    CU_ASSERT(!strncmp(buf, "HTTP/1.0 405 ", 13));
+    vqec_metrics_export_stop();
+}
+
 /* Function for checking up the cname */
 int compare_cname(char *new_cname, int len)
 {
@@ -1131,6 +1408,10 @@ CU_TestInfo test_array_ifclient[] = {
      test_vqec_ifclient_histogram},
     {"test_vqec_ifclient_get_stats_channel",
      test_vqec_ifclient_get_stats_channel},
+    {"test_vqec_ifclient_metrics_export",
+     test_vqec_ifclient_metrics_export},
+    {"test_vqec_ifclient_get_stats_summary",
+     test_vqec_ifclient_get_stats_summary},
     {"test_vqec_ifclient_register_cname",
      test_vqec_ifclient_register_cname},
     {"test_vqec_ifclient_bind_params_fast_fill",
@@ -48,6 +48,8 @@ CU_SuiteInfo suites_vqec[] = {
      test_vqec_gap_reporter_clean, test_array_gap_reporter},
     {"VQEC_RECV_SOCKET", test_vqec_recv_socket_init, test_vqec_recv_socket_clean,
      test_array_recv_sock},
+    {"VQEC_RTCP_MUX", test_vqec_rtcp_mux_init, test_vqec_rtcp_mux_clean,
+     test_array_rtcp_mux},
     {"VQEC_NAT", test_vqec_nat_init, test_vqec_nat_clean, test_array_nat},
     {"VQEC_PAK", test_vqec_pak_init, test_vqec_pak_clean,
      test_array_pak},
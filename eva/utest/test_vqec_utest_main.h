@@ -30,6 +30,11 @@ int test_vqec_recv_socket_init(void);
 int test_vqec_recv_socket_clean(void);
 extern CU_TestInfo test_array_recv_sock[];
 
+/* unit tests for the shared RTCP receive sockets */
+int test_vqec_rtcp_mux_init(void);
+int test_vqec_rtcp_mux_clean(void);
+extern CU_TestInfo test_array_rtcp_mux[];
+
 /* unit tests for url */
 int test_vqec_url_init(void);
 int test_vqec_url_clean(void);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ */
+
+#include "test_vqec_utest_main.h"
+#include "../add-ons/include/CUnit/CUnit.h"
+#include "../add-ons/include/CUnit/Basic.h"
+#include "vqec_rtcp_mux.h"
+#include "vqec_event.h"
+#include <utils/queue_plus.h>
+#include <arpa/inet.h>
+
+#ifdef _VQEC_UTEST_INTERPOSERS
+#include "test_vqec_utest_interposers.h"
+#endif
+
+/*
+ *  Unit tests for the shared RTCP receive sockets
+ */
+
+//----------------------------------------------------------------------------
+// Structure repeated, to get at the socket and the sessions of a remote end.
+//----------------------------------------------------------------------------
+struct vqec_rtcp_mux_sess_ {
+    VQE_LIST_ENTRY(vqec_rtcp_mux_sess_) list_obj;
+    rtp_session_t *session;
+    boolean is_primary;
+    struct vqec_rtcp_mux_sock_ *msock;
+    struct vqec_rtcp_mux_dest_ *dest;
+};
+
+extern struct vqec_rtcp_mux_dest_ *
+vqec_rtcp_mux_dest_lookup(struct vqec_rtcp_mux_sock_ *msock,
+                          struct in_addr src_addr,
+                          uint16_t src_port);
+
+#define TEST_RTCP_MUX_FBT1 "10.1.1.1"
+#define TEST_RTCP_MUX_FBT2 "10.1.1.2"
+#define TEST_RTCP_MUX_FBT3 "10.1.1.3"
+#define TEST_RTCP_MUX_BUFF_BYTES 65536
+
+static rtp_session_t s_sess[4];
+static struct in_addr s_fbt1, s_fbt2, s_fbt3;
+static boolean s_was_enabled;
+
+int test_vqec_rtcp_mux_init (void) 
+{
+    inet_pton(AF_INET, TEST_RTCP_MUX_FBT1, &s_fbt1);
+    inet_pton(AF_INET, TEST_RTCP_MUX_FBT2, &s_fbt2);
+    inet_pton(AF_INET, TEST_RTCP_MUX_FBT3, &s_fbt3);
+    if (!vqec_event_init()) {
+        return (-1);
+    }
+    s_was_enabled = vqec_rtcp_mux_enabled();
+    return (vqec_rtcp_mux_init() ? 0 : -1);
+}
+
+int test_vqec_rtcp_mux_clean (void) 
+{
+    if (!s_was_enabled) {
+        vqec_rtcp_mux_deinit();
+    }
+    return (0);
+}
+
+static vqec_recv_sock_t *
+test_vqec_rtcp_mux_attach (struct vqec_rtcp_mux_sess_ **pp_msess,
+                           rtp_session_t *session,
+                           uint16_t *local_port,
+                           struct in_addr remote_addr,
+                           uint16_t remote_port)
+{
+    return (vqec_rtcp_mux_attach(pp_msess, session, FALSE, 
+                                 htonl(INADDR_LOOPBACK), local_port,
+                                 remote_addr.s_addr, htons(remote_port),
+                                 TEST_RTCP_MUX_BUFF_BYTES, 0));
+}
+
+static struct vqec_rtcp_mux_dest_ *
+test_vqec_rtcp_mux_lookup (struct vqec_rtcp_mux_sess_ *msess,
+                           struct in_addr src_addr,
+                           uint16_t src_port)
+{
+    return (vqec_rtcp_mux_dest_lookup(msess->msock, src_addr, 
+                                      htons(src_port)));
+}
+
+static void test_vqec_rtcp_mux_demux (void)
+{
+    struct vqec_rtcp_mux_sess_ *a = NULL, *b = NULL, *c = NULL, *d = NULL;
+    vqec_recv_sock_t *sock;
+    uint16_t port = 0, port2 = 0;
+
+    CU_ASSERT(vqec_rtcp_mux_enabled());
+
+    /* sessions asking for an ephemeral port share one socket */
+    sock = test_vqec_rtcp_mux_attach(&a, &s_sess[0], &port, s_fbt1, 5001);
+    CU_ASSERT(sock != NULL && port != 0);
+    CU_ASSERT(test_vqec_rtcp_mux_attach(&b, &s_sess[1], &port2, 
+                                        s_fbt2, 0) == sock);
+    CU_ASSERT(port2 == port);
+    port2 = 0;
+    CU_ASSERT(test_vqec_rtcp_mux_attach(&c, &s_sess[2], &port2, 
+                                        s_fbt1, 5002) == sock);
+    if (!a || !b || !c) {
+        goto done;
+    }
+    CU_ASSERT(a->session == &s_sess[0] && b->session == &s_sess[1]);
+    CU_ASSERT(a->dest != b->dest && a->dest != c->dest);
+
+    /* a source is matched by its address and port */
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5001) == a->dest);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5002) == c->dest);
+
+    /* else by its address, for sessions accepting any remote port */
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt2, 5001) == b->dest);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt2, 7000) == b->dest);
+
+    /* RTCP from any other source is not for a session, and is dropped */
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 6000) == NULL);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt3, 5001) == NULL);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt3, 0) == NULL);
+
+    /* an exact match is preferred to a session accepting any port */
+    port2 = 0;
+    CU_ASSERT(test_vqec_rtcp_mux_attach(&d, &s_sess[3], &port2, 
+                                        s_fbt1, 0) == sock);
+    if (!d) {
+        goto done;
+    }
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5001) == a->dest);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 6000) == d->dest);
+
+    /* a session moves with its feedback target */
+    CU_ASSERT(vqec_rtcp_mux_update(a, s_fbt3.s_addr, htons(5001)));
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt3, 5001) == a->dest);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5001) == d->dest);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5002) == c->dest);
+
+    /* and is no longer found once detached */
+    vqec_rtcp_mux_detach(&d);
+    CU_ASSERT(d == NULL);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5001) == NULL);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 6000) == NULL);
+    vqec_rtcp_mux_detach(&c);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt1, 5002) == NULL);
+    CU_ASSERT(test_vqec_rtcp_mux_lookup(a, s_fbt3, 5001) == a->dest);
+
+done:
+    vqec_rtcp_mux_detach(&a);
+    vqec_rtcp_mux_detach(&b);
+    vqec_rtcp_mux_detach(&c);
+    vqec_rtcp_mux_detach(&d);
+    CU_ASSERT(a == NULL && b == NULL);
+}
+
+CU_TestInfo test_array_rtcp_mux[] = {
+    {"test vqec_rtcp_mux_demux",test_vqec_rtcp_mux_demux},
+    CU_TEST_INFO_NULL,
+};
@@ -23,6 +23,11 @@
 #include "vqec_updater.h"
 #include "vqec_updater_private.h"
 #include "vqec_debug.h"
+#include "vqec_pthread.h"
+#include "rtspclient/rtsp_client.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 /*
  * Unit tests for VQE-C updater
@@ -48,11 +53,177 @@ void test_vqec_updater_reset_files (void)
     system(cmd); 
 }
 
+/*
+ * A VCDS on the loopback interface, serving the updater's RTSP requests
+ * one connection at a time.  Each DESCRIBE request for the index is
+ * answered with index_code and index_body, and any other request with
+ * resource_code and resource_body.  A NULL body is sent as an empty one.
+ */
+#define TEST_VCDS_REQ_LEN 2048
+#define TEST_VCDS_RSP_LEN 4096
+
+static struct {
+    int listen_fd;
+    in_port_t port;                 /* host byte order */
+    pthread_t tid;
+
+    int index_code;
+    const char *index_body;
+    int resource_code;
+    const char *resource_body;
+    boolean drop_after_response;    /* close the connection, unannounced */
+
+    int accepts;                    /* connections accepted */
+    int requests;                   /* requests answered */
+    char if_none_match[RTSP_ETAG_LENGTH];  /* sent with the last request */
+} test_vcds;
+
+/*
+ * Answer one request, held NUL terminated in req.
+ */
+static boolean
+test_vcds_respond (int fd, char *req)
+{
+    char rsp[TEST_VCDS_RSP_LEN];
+    const char *body;
+    unsigned int cseq = 0;
+    char *p, *q;
+    int code, len;
+
+    p = strstr(req, "\nCSeq:");
+    if (p) {
+        sscanf(p + 6, "%u", &cseq);
+    }
+    test_vcds.if_none_match[0] = '\0';
+    p = strstr(req, "\nIf-None-Match: \"");
+    if (p) {
+        p += 17;
+        q = strchr(p, '"');
+        if (q && (q - p) < RTSP_ETAG_LENGTH) {
+            memcpy(test_vcds.if_none_match, p, q - p);
+            test_vcds.if_none_match[q - p] = '\0';
+        }
+    }
+
+    if (strstr(req, "/" VQEC_UPDATER_RESOURCE_NAME_INDEX "/")) {
+        code = test_vcds.index_code;
+        body = test_vcds.index_body;
+    } else {
+        code = test_vcds.resource_code;
+        body = test_vcds.resource_body;
+    }
+    if (!body || (code != MSG_200_OK)) {
+        body = "";
+    }
+
+    len = snprintf(rsp, sizeof(rsp),
+                   "RTSP/1.0 %d Test\r\n"
+                   "CSeq: %u\r\n"
+                   "Server: vcds test\r\n"
+                   "Content-Type: %s\r\n"
+                   "Content-Length: %zu\r\n"
+                   "\r\n"
+                   "%s",
+                   code, cseq, MEDIA_TYPE_APP_PLAIN_TEXT, strlen(body), body);
+    if (len >= sizeof(rsp)) {
+        return (FALSE);
+    }
+    test_vcds.requests++;
+    return (send(fd, rsp, len, MSG_NOSIGNAL) == len);
+}
+
+/*
+ * Serve the requests of a connection until it is closed.
+ */
+static void
+test_vcds_serve (int fd)
+{
+    char req[TEST_VCDS_REQ_LEN];
+    int used = 0, n;
+    char *end;
+
+    for (;;) {
+        n = recv(fd, req + used, sizeof(req) - 1 - used, 0);
+        if (n <= 0) {
+            return;
+        }
+        used += n;
+        req[used] = '\0';
+        while ((end = strstr(req, "\r\n\r\n")) != NULL) {
+            *end = '\0';
+            if (!test_vcds_respond(fd, req) ||
+                test_vcds.drop_after_response) {
+                return;
+            }
+            end += 4;
+            used -= end - req;
+            memmove(req, end, used + 1);
+        }
+        if (used == sizeof(req) - 1) {
+            return;
+        }
+    }
+}
+
+static void *
+test_vcds_thread (void *arg)
+{
+    int fd;
+
+    while ((fd = accept(test_vcds.listen_fd, NULL, NULL)) >= 0) {
+        test_vcds.accepts++;
+        test_vcds_serve(fd);
+        close(fd);
+    }
+    return (NULL);
+}
+
+static boolean
+test_vcds_start (void)
+{
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+
+    test_vcds.listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (test_vcds.listen_fd < 0) {
+        return (FALSE);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(test_vcds.listen_fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(test_vcds.listen_fd, 4) ||
+        getsockname(test_vcds.listen_fd, 
+                    (struct sockaddr *)&addr, &addrlen) ||
+        vqec_pthread_create(&test_vcds.tid, test_vcds_thread, NULL)) {
+        close(test_vcds.listen_fd);
+        test_vcds.listen_fd = -1;
+        return (FALSE);
+    }
+    test_vcds.port = ntohs(addr.sin_port);
+    return (TRUE);
+}
+
+static void
+test_vcds_stop (void)
+{
+    if (test_vcds.listen_fd < 0) {
+        return;
+    }
+    /* wakes the thread from accept() */
+    shutdown(test_vcds.listen_fd, SHUT_RDWR);
+    pthread_join(test_vcds.tid, NULL);
+    close(test_vcds.listen_fd);
+    test_vcds.listen_fd = -1;
+}
+
 /*
  * Sets the VQE-C updater to have existent but empty
  * attribute and channel config files.
  *
- * Also, resets the RTSP client interposers.
+ * Also, resets the test VCDS to answer every request with an empty
+ * 200 OK response, and points the updater at it.
  */
 void test_vqec_updater_reset_all (void)
 {
@@ -71,14 +242,18 @@ void test_vqec_updater_reset_all (void)
                                 vqec_updater.attrcfg.vcds_version);
     (void)vqe_MD5ComputeChecksumStr(vqec_updater.chancfg.datafile, TRUE,
                                 vqec_updater.chancfg.vcds_version);
+    vqec_updater.last_index_request.index_version[0] = '\0';
+    vqec_updater.vcds_port = test_vcds.port;
 
-    /* Initialize RTSP client interposers to intercept */
-    test_rtsp_client_set_intercept(TRUE);
-    test_rtsp_client_init_make_fail(RTSP_SUCCESS);
-    test_rtsp_send_request_make_fail(RTSP_SUCCESS);
-    test_rtsp_get_response_code_make_fail(MSG_200_OK);
-    test_rtsp_get_response_body_make_fail("");
-    test_rtsp_client_close_make_fail(RTSP_SUCCESS);
+    /* Initialize the test VCDS */
+    test_vcds.index_code = MSG_200_OK;
+    test_vcds.index_body = "";
+    test_vcds.resource_code = MSG_200_OK;
+    test_vcds.resource_body = "";
+    test_vcds.drop_after_response = FALSE;
+    test_vcds.accepts = 0;
+    test_vcds.requests = 0;
+    test_vcds.if_none_match[0] = '\0';
 }
 
 int test_vqec_updater_init (void)
@@ -86,6 +261,11 @@ int test_vqec_updater_init (void)
     int loglevel;
 
     sleep(2);
+    test_vcds.listen_fd = -1;
+    if (!test_vcds_start()) {
+        return -1;
+    }
+
     /* Load the system configuration from supplied file */
     (void)vqec_syscfg_init(
         "data/cfg_test_all_params_valid_with_local_vcds.cfg");
@@ -103,6 +283,7 @@ int test_vqec_updater_init (void)
 
 int test_vqec_updater_clean (void)
 {
+    test_vcds_stop();
     snprintf(cmd, MAX_STRLEN, "rm -f %s", s_cfg.network_cfg_pathname);
     system(cmd);
     snprintf(cmd, MAX_STRLEN, "rm -f %s", s_cfg.channel_lineup);
@@ -152,7 +333,7 @@ static void test_vqec_updater_tests (void)
      *          Make sure both files are deleted
      */
     test_vqec_updater_reset_all();
-    test_rtsp_get_response_body_make_fail(NULL);
+    test_vcds.index_body = NULL;
     vqec_updater_request_update(
         TRUE, FALSE, FALSE,
         TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
@@ -168,9 +349,9 @@ static void test_vqec_updater_tests (void)
      *          Make sure new updated versions are recorded for VCDS
      */
     test_vqec_updater_reset_all();
-    test_rtsp_get_response_body_make_fail(
+    test_vcds.index_body =
         "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n"
-        "unknown-resource    <unknown version>");
+        "unknown-resource    <unknown version>";
     vqec_updater_request_update(
         TRUE, FALSE, FALSE,
         TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
@@ -186,10 +367,10 @@ static void test_vqec_updater_tests (void)
      *          Make sure new updated versions are recorded for VCDS
      */
     test_vqec_updater_reset_all();
-    test_rtsp_get_response_body_make_fail(
+    test_vcds.index_body =
         "vqe-channels e89ab785efbe3a674655b21e998ab5bd\r\n"
         "unknown-resource    <unknown version>\r\n"
-        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n");
+        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n";
     vqec_updater_request_update(
         TRUE, FALSE, FALSE,
         TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
@@ -205,11 +386,11 @@ static void test_vqec_updater_tests (void)
      *          Make sure new updated versions are recorded for VCDS
      */
     test_vqec_updater_reset_all();
-    test_rtsp_get_response_body_make_fail(
+    test_vcds.index_body =
         "vcds 3.2.0(61)-development\r\n"
         "vqe-channels e89ab785efbe3a674655b21e998ab5bd\r\n"
         "unknown-resource    <unknown version>\r\n"
-        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n");
+        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n";
     vqec_updater_request_update(
         TRUE, FALSE, FALSE,
         TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
@@ -221,8 +402,171 @@ static void test_vqec_updater_tests (void)
                       "e89ab785efbe3a674655b21e998ab5bd"));
 }
 
+/* A network configuration served by the test VCDS */
+#define TEST_VCDS_NETCFG "# network configuration from the test VCDS\n"
+
+static void test_vqec_updater_rtsp_client (void)
+{
+    static rtsp_conn_t conn;
+    static rtsp_request_t req;
+    abs_time_t abort_time;
+
+    test_vqec_updater_reset_all();
+    test_vcds.resource_body = TEST_VCDS_NETCFG;
+    rtsp_conn_init(&conn);
+    rtsp_request_init(&req);
+    abort_time = TIME_ADD_A_R(get_sys_time(), TIME_MK_R(sec, 5));
+
+    CU_ASSERT(!rtsp_conn_is_open(&conn, "127.0.0.1", test_vcds.port));
+    CU_ASSERT(rtsp_conn_open(&conn, "127.0.0.1", test_vcds.port)
+              == RTSP_SUCCESS);
+    CU_ASSERT(rtsp_conn_is_open(&conn, "127.0.0.1", test_vcds.port));
+    CU_ASSERT(!rtsp_conn_is_open(&conn, "127.0.0.1", test_vcds.port + 1));
+
+    /* A plain request:  the whole body is returned */
+    CU_ASSERT(rtsp_request_start(&req, &conn,
+                                 VQEC_UPDATER_RESOURCE_NAME_NETCFG,
+                                 MEDIA_TYPE_APP_PLAIN_TEXT, NULL)
+              == RTSP_SUCCESS);
+    CU_ASSERT(rtsp_request_wait(&req, abort_time) == RTSP_SUCCESS);
+    CU_ASSERT(rtsp_request_get_response_code(&req) == MSG_200_OK);
+    CU_ASSERT(rtsp_request_get_response_body(&req) &&
+              !strcmp(rtsp_request_get_response_body(&req),
+                      TEST_VCDS_NETCFG));
+    CU_ASSERT(rtsp_request_get_response_server(&req) &&
+              !strcmp(rtsp_request_get_response_server(&req), "vcds test"));
+    CU_ASSERT(test_vcds.if_none_match[0] == '\0');
+
+    /* A conditional request, on the same connection */
+    test_vcds.resource_code = MSG_304_NOT_MODIFIED;
+    CU_ASSERT(rtsp_request_start(&req, &conn,
+                                 VQEC_UPDATER_RESOURCE_NAME_NETCFG,
+                                 MEDIA_TYPE_APP_PLAIN_TEXT,
+                                 VQEC_VERSION_EMPTY_FILE)
+              == RTSP_SUCCESS);
+    CU_ASSERT(rtsp_request_wait(&req, abort_time) == RTSP_SUCCESS);
+    CU_ASSERT(rtsp_request_get_response_code(&req) == MSG_304_NOT_MODIFIED);
+    CU_ASSERT(rtsp_request_get_response_body(&req) == NULL);
+    CU_ASSERT(!strcmp(test_vcds.if_none_match, VQEC_VERSION_EMPTY_FILE));
+    CU_ASSERT(rtsp_conn_is_open(&conn, "127.0.0.1", test_vcds.port));
+    CU_ASSERT(test_vcds.accepts == 1);
+    CU_ASSERT(test_vcds.requests == 2);
+
+    rtsp_request_free(&req);
+    rtsp_conn_close(&conn);
+    CU_ASSERT(!rtsp_conn_is_open(&conn, "127.0.0.1", test_vcds.port));
+}
+
+static void test_vqec_updater_conn_reuse (void)
+{
+    /*
+     * The index and the network configuration of an update are fetched
+     * over one connection, which is closed at the end of the update.
+     */
+    test_vqec_updater_reset_all();
+    test_vcds.index_body =
+        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n";
+    test_vcds.resource_body = TEST_VCDS_NETCFG;
+    vqec_updater_request_update(
+        TRUE, TRUE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(vqec_updater.attrcfg.last_update_result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(test_vcds.requests == 2);
+    CU_ASSERT(test_vcds.accepts == 1);
+
+    /* The next update opens a new connection */
+    vqec_updater_request_update(
+        TRUE, FALSE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(test_vcds.requests == 3);
+    CU_ASSERT(test_vcds.accepts == 2);
+}
+
+static void test_vqec_updater_reconnect (void)
+{
+    /*
+     * The VCDS closes the connection after the index is served:  the
+     * network configuration is fetched on a second connection.
+     */
+    test_vqec_updater_reset_all();
+    test_vcds.index_body =
+        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n";
+    test_vcds.resource_body = TEST_VCDS_NETCFG;
+    test_vcds.drop_after_response = TRUE;
+    vqec_updater_request_update(
+        TRUE, TRUE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(vqec_updater.attrcfg.last_update_result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(test_vcds.requests == 2);
+    CU_ASSERT(test_vcds.accepts == 2);
+}
+
+static void test_vqec_updater_not_modified (void)
+{
+    char index_version[MD5_CHECKSUM_STRLEN];
+
+    /* The first index request is unconditional */
+    test_vqec_updater_reset_all();
+    test_vcds.index_body =
+        "vqec-network-cfg    f02d77ad5d121f00b124d4aa5651e2f8\r\n";
+    vqec_updater_request_update(
+        TRUE, FALSE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(test_vcds.if_none_match[0] == '\0');
+    CU_ASSERT(strlen(vqec_updater.last_index_request.index_version)
+              == MD5_CHECKSUM_STRLEN - 1);
+    strncpy(index_version, vqec_updater.last_index_request.index_version,
+            MD5_CHECKSUM_STRLEN);
+
+    /*
+     * The next one names the index received:  a 304 response leaves
+     * the recorded versions as they are.
+     */
+    test_vcds.index_code = MSG_304_NOT_MODIFIED;
+    vqec_updater_request_update(
+        TRUE, FALSE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(!strcmp(test_vcds.if_none_match, index_version));
+    CU_ASSERT(!strcmp(vqec_updater.last_index_request.index_version,
+                      index_version));
+    CU_ASSERT(!strcmp(vqec_updater.attrcfg.vcds_version,
+                      "f02d77ad5d121f00b124d4aa5651e2f8"));
+
+    /*
+     * A resource request names the version VQE-C has:  a 304 response
+     * leaves the file as it is.
+     */
+    test_vcds.resource_code = MSG_304_NOT_MODIFIED;
+    vqec_updater_request_update(
+        TRUE, TRUE, FALSE,
+        TIME_ADD_A_R(get_sys_time(), VQEC_UPDATER_TIMEOUT_BACKGROUND));
+    CU_ASSERT(vqec_updater.last_index_request.result
+              == VQEC_UPDATER_RESULT_ERR_OK);
+    CU_ASSERT(vqec_updater.attrcfg.last_update_result
+              == VQEC_UPDATER_RESULT_ERR_UNNECESSARY);
+    CU_ASSERT(!strcmp(test_vcds.if_none_match, VQEC_VERSION_EMPTY_FILE));
+    CU_ASSERT(!strcmp(vqec_updater.attrcfg.vqec_version,
+                      VQEC_VERSION_EMPTY_FILE));
+}
+
 CU_TestInfo test_array_updater[] = {
     {"test_vqec_updater_tests",test_vqec_updater_tests},
+    {"test_vqec_updater_rtsp_client",test_vqec_updater_rtsp_client},
+    {"test_vqec_updater_conn_reuse",test_vqec_updater_conn_reuse},
+    {"test_vqec_updater_reconnect",test_vqec_updater_reconnect},
+    {"test_vqec_updater_not_modified",test_vqec_updater_not_modified},
     CU_TEST_INFO_NULL,
 };
 
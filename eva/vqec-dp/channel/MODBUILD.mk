@@ -15,9 +15,12 @@ COMMON_SOURCES 		=					\
 				vqec_log.c			\
 				vqec_dp_rtp_receiver.c		\
 				vqec_dp_rtp_input_stream.c 	\
+				vqec_dp_rtp_hdr_vec.c		\
 				vqec_oscheduler.c		\
 				vqec_pcm.c			\
 				vqec_fec.c			\
+				vqec_fec_xor.c			\
+				vqec_fec_rs.c			\
 				vqec_dpchan.c			\
 				vqec_dp_sm.c			\
 
@@ -36,8 +39,11 @@ KMODOBJECTS		=	$(COMMON_OBJECTS) $(KERNELPORT_OBJECTS)
 COMMON_HEADERS 	= 		vqec_dpchan_api.h		\
 				vqec_dp_rtp_input_stream.h	\
 				vqec_dp_rtp_receiver.h		\
+				vqec_dp_rtp_hdr_vec.h		\
 				vqec_dp_sm.h			\
 				vqec_fec.h			\
+				vqec_fec_xor.h			\
+				vqec_fec_rs.h			\
 				vqec_log.h			\
 				vqec_nll.h			\
 				vqec_oscheduler.h		\
@@ -0,0 +1,808 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * test_vqec_dp_bench.c - in-process benchmark of the channel dataplane
+ * receive path: PCM insertion, FEC, gap collection and output scheduling.
+ *
+ * A synthetic stream of 1316-byte RTP source packets, protected by an
+ * L x D XOR FEC (column FEC only with -1, otherwise column and row FEC,
+ * with the column FEC of a block spread over the next block as in
+ * Annex B), is passed through a loss model in sending order and fed to a
+ * PCM, FEC and output scheduler set up as vqec_dpchan_create() sets them
+ * up, but without the input / output shims or the channel state machine.
+ * Gap collection and the output scheduler run every BENCH_TICK_PAKS
+ * source packets, as the 20 ms dataplane timer would.
+ *
+ * Time is simulated, advancing by one packet time per source packet, so
+ * that the run goes as fast as the code allows. Each stage is timed on
+ * its own, with the cost of reading the clock taken out, and the packet
+ * pool allocations made inside each stage are counted by wrapping
+ * zone_acquire() at link time. The output is checked for gaps and for
+ * packets with the wrong payload.
+ *
+ * Loss models, applied to source and FEC packets alike:
+ *     none
+ *     bernoulli:p             each packet lost with probability p
+ *     ge:p,r[,h]              Gilbert-Elliott: good -> bad with probability
+ *                             p, bad -> good with probability r, packets
+ *                             lost in the bad state with probability h
+ *                             (default 1)
+ *     burst:len,period        len packets lost out of every period
+ *     trace:file              recorded trace, one '0' (received) or '1'
+ *                             (lost) per packet, other characters ignored;
+ *                             the trace is replayed in a loop
+ *
+ * Usage: test_vqec_dp_bench [-n packets] [-L columns] [-D rows] [-1]
+ *                           [-m loss-model] [-s seed]
+ */
+
+#include <time.h>
+#include <unistd.h>
+#include "vqec_dpchan.h"
+#include "vqec_fec_xor.h"
+#include "vqec_pak.h"
+#include "rtp.h"
+#include <eva/vqec_channel_private.h>
+#include <eva/vqec_rtp.h>
+
+#define BENCH_DEFAULT_PAKS      200000
+#define BENCH_DEFAULT_L         10
+#define BENCH_DEFAULT_D         10
+#define BENCH_PAYLOAD           1316    /* 7 MPEG-TS packets */
+#define BENCH_PAK_SIZE          1500
+#define BENCH_POOL_PAKS         4096
+#define BENCH_PAK_TIME_USEC     1000    /* ~10.5 Mbps */
+#define BENCH_TICK_PAKS         20      /* 20 ms dataplane timer */
+#define BENCH_JITTER_BUFF_MSEC  200
+#define BENCH_REORDER_MSEC      20
+#define BENCH_REPAIR_TRIG_MSEC  20
+#define BENCH_RTP_TS_PER_PAK    90      /* 90 kHz clock */
+#define BENCH_SRC_PT            RTP_MP2T
+#define BENCH_FEC_PT            96
+#define BENCH_START_SEQ         65000   /* exercise sequence wrap */
+#define BENCH_CALIBRATE_ITER    100000
+
+/*
+ * Loss models.
+ */
+typedef enum bench_loss_type_ {
+    BENCH_LOSS_NONE,
+    BENCH_LOSS_BERNOULLI,
+    BENCH_LOSS_GE,
+    BENCH_LOSS_BURST,
+    BENCH_LOSS_TRACE,
+} bench_loss_type_t;
+
+typedef struct bench_loss_ {
+    bench_loss_type_t type;
+    double p;                   /* bernoulli loss, or ge good -> bad */
+    double r;                   /* ge bad -> good */
+    double h;                   /* ge loss in the bad state */
+    uint32_t len;               /* burst length */
+    uint32_t period;            /* burst period */
+    char *trace;                /* '0' / '1' per packet */
+    uint32_t trace_len;
+    uint32_t pos;               /* packets seen */
+    boolean bad;                /* ge state */
+} bench_loss_t;
+
+/*
+ * Stages of the receive path.
+ */
+typedef enum bench_stage_ {
+    BENCH_STAGE_INSERT,
+    BENCH_STAGE_FEC,
+    BENCH_STAGE_GAPS,
+    BENCH_STAGE_OUTPUT,
+    BENCH_STAGE_NUM,
+} bench_stage_t;
+
+typedef struct bench_stage_stats_ {
+    const char *name;
+    uint64_t ns;
+    uint64_t calls;
+    uint64_t allocs;
+} bench_stage_stats_t;
+
+/*
+ * XOR parity of a row or column, as it is accumulated.
+ */
+typedef struct bench_parity_ {
+    uint16_t snbase;
+    uint8_t pt;
+    uint32_t ts;
+    uint16_t len;
+    char payload[BENCH_PAYLOAD];
+} bench_parity_t;
+
+static bench_stage_stats_t s_bench_stages[BENCH_STAGE_NUM] = {
+    { "pcm insert" }, { "fec receive" }, { "gap collect" }, { "osched run" },
+};
+static uint64_t s_bench_clock_ns;       /* cost of reading the clock */
+static uint64_t s_bench_allocs;         /* zone_acquire() calls */
+
+static vqec_dpchan_t s_bench_chan;
+static abs_time_t s_bench_now;
+static uint16_t s_bench_fec_seq;
+
+static uint32_t s_bench_out_paks;
+static uint32_t s_bench_out_gaps;
+static uint32_t s_bench_out_corrupt;
+static uint32_t s_bench_out_gap_paks;
+static boolean s_bench_out_seq_valid;
+static vqec_seq_num_t s_bench_out_seq;
+
+/**
+ * Count the allocations made from every zone, packets included.
+ */
+void *__real_zone_acquire(struct vqe_zone *z);
+
+void *
+__wrap_zone_acquire (struct vqe_zone *z)
+{
+    s_bench_allocs++;
+    return (__real_zone_acquire(z));
+}
+
+/*
+ * The primary input stream calls into the control-plane for RTCP packets
+ * multiplexed on the RTP port; there is no control-plane here.
+ */
+vqec_chan_t *
+vqec_chanid_to_chan (const vqec_chanid_t chanid)
+{
+    return (NULL);
+}
+
+void
+rtcp_event_handler_internal_process_pak (rtp_session_t *rtp_session,
+                                         struct in_addr pak_src_addr,
+                                         uint16_t pak_src_port,
+                                         char *pak_buff,
+                                         int32_t pak_buff_len,
+                                         struct timeval *recv_time)
+{
+}
+
+static inline uint64_t
+bench_now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+static void
+bench_calibrate (void)
+{
+    uint64_t start;
+    uint32_t i;
+
+    start = bench_now_ns();
+    for (i = 0; i < BENCH_CALIBRATE_ITER; i++) {
+        (void)bench_now_ns();
+    }
+    s_bench_clock_ns = (bench_now_ns() - start) / BENCH_CALIBRATE_ITER;
+}
+
+static inline void
+bench_stage_begin (uint64_t *start, uint64_t *allocs)
+{
+    *allocs = s_bench_allocs;
+    *start = bench_now_ns();
+}
+
+static inline void
+bench_stage_end (bench_stage_t stage, uint64_t start, uint64_t allocs)
+{
+    uint64_t elapsed = bench_now_ns() - start;
+
+    s_bench_stages[stage].ns +=
+        (elapsed > s_bench_clock_ns) ? elapsed - s_bench_clock_ns : 0;
+    s_bench_stages[stage].calls++;
+    s_bench_stages[stage].allocs += s_bench_allocs - allocs;
+}
+
+/*----------------------------------------------------------------------------
+ * Loss models.
+ *---------------------------------------------------------------------------*/
+
+static boolean
+bench_loss_load_trace (bench_loss_t *loss, const char *path)
+{
+    FILE *fp;
+    int c;
+    uint32_t size = 4096;
+
+    fp = fopen(path, "r");
+    if (!fp) {
+        return (FALSE);
+    }
+    loss->trace = malloc(size);
+    loss->trace_len = 0;
+    while (loss->trace && (c = fgetc(fp)) != EOF) {
+        if (c != '0' && c != '1') {
+            continue;
+        }
+        if (loss->trace_len == size) {
+            size *= 2;
+            loss->trace = realloc(loss->trace, size);
+            if (!loss->trace) {
+                break;
+            }
+        }
+        loss->trace[loss->trace_len++] = (char)c;
+    }
+    fclose(fp);
+
+    return (loss->trace && loss->trace_len);
+}
+
+static boolean
+bench_loss_parse (bench_loss_t *loss, const char *arg)
+{
+    memset(loss, 0, sizeof(*loss));
+    loss->h = 1.0;
+
+    if (!strcmp(arg, "none")) {
+        loss->type = BENCH_LOSS_NONE;
+        return (TRUE);
+    } else if (sscanf(arg, "bernoulli:%lf", &loss->p) == 1) {
+        loss->type = BENCH_LOSS_BERNOULLI;
+        return (loss->p >= 0.0 && loss->p <= 1.0);
+    } else if (sscanf(arg, "ge:%lf,%lf,%lf", &loss->p, &loss->r, &loss->h)
+               >= 2) {
+        loss->type = BENCH_LOSS_GE;
+        return (loss->p >= 0.0 && loss->p <= 1.0 &&
+                loss->r >= 0.0 && loss->r <= 1.0 &&
+                loss->h >= 0.0 && loss->h <= 1.0);
+    } else if (sscanf(arg, "burst:%u,%u", &loss->len, &loss->period) == 2) {
+        loss->type = BENCH_LOSS_BURST;
+        return (loss->period != 0 && loss->len <= loss->period);
+    } else if (!strncmp(arg, "trace:", strlen("trace:"))) {
+        loss->type = BENCH_LOSS_TRACE;
+        return (bench_loss_load_trace(loss, arg + strlen("trace:")));
+    }
+
+    return (FALSE);
+}
+
+static inline double
+bench_uniform (void)
+{
+    return ((double)rand() / ((double)RAND_MAX + 1.0));
+}
+
+/**
+ * Advance the loss model by one packet.
+ *
+ * @return TRUE if the packet is lost
+ */
+static boolean
+bench_loss_drop (bench_loss_t *loss)
+{
+    boolean drop = FALSE;
+
+    switch (loss->type) {
+    case BENCH_LOSS_NONE:
+        break;
+
+    case BENCH_LOSS_BERNOULLI:
+        drop = (bench_uniform() < loss->p);
+        break;
+
+    case BENCH_LOSS_GE:
+        if (loss->bad) {
+            drop = (bench_uniform() < loss->h);
+            loss->bad = (bench_uniform() >= loss->r);
+        } else {
+            loss->bad = (bench_uniform() < loss->p);
+        }
+        break;
+
+    case BENCH_LOSS_BURST:
+        drop = ((loss->pos % loss->period) < loss->len);
+        break;
+
+    case BENCH_LOSS_TRACE:
+        drop = (loss->trace[loss->pos % loss->trace_len] == '1');
+        break;
+    }
+    loss->pos++;
+
+    return (drop);
+}
+
+static const char *
+bench_loss_to_str (bench_loss_t *loss, char *buf, uint32_t len)
+{
+    switch (loss->type) {
+    case BENCH_LOSS_BERNOULLI:
+        snprintf(buf, len, "bernoulli p=%g", loss->p);
+        break;
+    case BENCH_LOSS_GE:
+        snprintf(buf, len, "gilbert-elliott p=%g r=%g h=%g",
+                 loss->p, loss->r, loss->h);
+        break;
+    case BENCH_LOSS_BURST:
+        snprintf(buf, len, "burst %u of %u", loss->len, loss->period);
+        break;
+    case BENCH_LOSS_TRACE:
+        snprintf(buf, len, "trace of %u packets", loss->trace_len);
+        break;
+    default:
+        snprintf(buf, len, "none");
+        break;
+    }
+    return (buf);
+}
+
+/*----------------------------------------------------------------------------
+ * Output stream.
+ *---------------------------------------------------------------------------*/
+
+/**
+ * Receive a packet from the output scheduler; the scheduler keeps its
+ * reference. The first bytes of the payload hold the RTP sequence number
+ * the generator gave the packet, which must survive FEC recovery.
+ */
+static vqec_dp_stream_err_t
+bench_out_receive (vqec_dp_isid_t is, vqec_pak_t *pak)
+{
+    uint16_t marker;
+
+    s_bench_out_paks++;
+    if (s_bench_out_seq_valid &&
+        pak->seq_num != vqec_next_seq_num(s_bench_out_seq)) {
+        s_bench_out_gaps++;
+        s_bench_out_gap_paks +=
+            vqec_seq_num_sub(pak->seq_num, s_bench_out_seq) - 1;
+    }
+    s_bench_out_seq = pak->seq_num;
+    s_bench_out_seq_valid = TRUE;
+
+    memcpy(&marker, vqec_pak_get_head_ptr(pak) + pak->mpeg_payload_offset,
+           sizeof(marker));
+    if (vqec_pak_get_content_len(pak) !=
+        pak->mpeg_payload_offset + BENCH_PAYLOAD ||
+        marker != pak->rtp->sequence) {
+        s_bench_out_corrupt++;
+    }
+
+    return (VQEC_DP_STREAM_ERR_OK);
+}
+
+static const vqec_dp_isops_t s_bench_out_isops = {
+    .receive = bench_out_receive,
+};
+
+/*----------------------------------------------------------------------------
+ * Packet generation and delivery.
+ *---------------------------------------------------------------------------*/
+
+static void
+bench_parity_reset (bench_parity_t *par, uint16_t snbase)
+{
+    memset(par, 0, sizeof(*par));
+    par->snbase = snbase;
+}
+
+static void
+bench_parity_add (bench_parity_t *par, const char *payload, uint32_t ts)
+{
+    char *srcs[2];
+
+    par->pt ^= BENCH_SRC_PT;
+    par->ts ^= ts;
+    par->len ^= BENCH_PAYLOAD;
+    srcs[0] = par->payload;
+    srcs[1] = (char *)payload;
+    vqec_fec_xor_blocks(par->payload, srcs, 2, BENCH_PAYLOAD);
+}
+
+static vqec_pak_t *
+bench_src_pak (uint16_t seq, uint32_t ts)
+{
+    vqec_pak_t *pak;
+    char *payload;
+
+    pak = vqec_pak_alloc_with_particle();
+    if (!pak) {
+        return (NULL);
+    }
+    pak->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+    memset(pak->rtp, 0, sizeof(rtpfasttype_t));
+    SET_RTP_VERSION(pak->rtp, RTPVERSION);
+    SET_RTP_PAYLOAD(pak->rtp, BENCH_SRC_PT);
+    pak->rtp->sequence = htons(seq);
+    pak->rtp->timestamp = htonl(ts);
+    pak->rtp->ssrc = htonl(0x12345678);
+
+    payload = (char *)(pak->rtp + 1);
+    memset(payload, seq & 0xff, BENCH_PAYLOAD);
+    memcpy(payload, &pak->rtp->sequence, sizeof(pak->rtp->sequence));
+    (void)vqec_pak_set_content_len(pak, sizeof(rtpfasttype_t) +
+                                   BENCH_PAYLOAD);
+
+    pak->type = VQEC_PAK_TYPE_PRIMARY;
+    pak->mpeg_payload_offset = sizeof(rtpfasttype_t);
+    pak->rtp_ts = ts;
+    return (pak);
+}
+
+static vqec_pak_t *
+bench_fec_pak (bench_parity_t *par, uint8_t offset, uint8_t na)
+{
+    vqec_pak_t *pak;
+    rtpfasttype_t *rtp;
+    fecfasttype_t *fec_hdr;
+
+    pak = vqec_pak_alloc_with_particle();
+    if (!pak) {
+        return (NULL);
+    }
+    rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+    memset(rtp, 0, sizeof(rtpfasttype_t) + sizeof(fecfasttype_t));
+    SET_RTP_VERSION(rtp, RTPVERSION);
+    SET_RTP_PAYLOAD(rtp, BENCH_FEC_PT);
+    rtp->sequence = htons(s_bench_fec_seq++);
+    rtp->ssrc = htonl(0x12345679);
+
+    fec_hdr = (fecfasttype_t *)(rtp + 1);
+    fec_hdr->snbase_low_bits = htons(par->snbase);
+    fec_hdr->length_recovery = htons(par->len);
+    SET_FEC_E_BIT(fec_hdr, 1);
+    SET_FEC_PT_RECOVERY(fec_hdr, par->pt);
+    fec_hdr->ts_recovery = htonl(par->ts);
+    SET_FEC_D_BIT(fec_hdr, offset == 1);
+    SET_FEC_TYPE(fec_hdr, VQEC_FEC_TYPE_XOR);
+    SET_FEC_OFFSET(fec_hdr, offset);
+    SET_FEC_NA(fec_hdr, na);
+
+    memcpy(fec_hdr + 1, par->payload, BENCH_PAYLOAD);
+    (void)vqec_pak_set_content_len(pak, sizeof(rtpfasttype_t) +
+                                   sizeof(fecfasttype_t) + BENCH_PAYLOAD);
+    return (pak);
+}
+
+/**
+ * Deliver a source packet to the PCM, as the primary input stream does.
+ */
+static void
+bench_deliver_src (vqec_pak_t *pak)
+{
+    vqec_pcm_t *pcm = &s_bench_chan.pcm;
+    uint64_t start, allocs;
+
+    bench_stage_begin(&start, &allocs);
+    pak->rcv_ts = s_bench_now;
+    pak->seq_num =
+        vqec_seq_num_nearest_to_rtp_seq_num(vqec_pcm_get_last_rx_seq_num(pcm),
+                                            ntohs(pak->rtp->sequence));
+    vqec_pcm_set_last_rx_seq_num(pcm, pak->seq_num);
+    (void)vqec_pcm_insert_packets(pcm, &pak, 1, TRUE, NULL);
+    bench_stage_end(BENCH_STAGE_INSERT, start, allocs);
+}
+
+/**
+ * Deliver a FEC packet to the FEC module, as the FEC input streams do.
+ */
+static void
+bench_deliver_fec (vqec_pak_t *pak, uint32_t stream_hdl)
+{
+    uint64_t start, allocs;
+
+    bench_stage_begin(&start, &allocs);
+    pak->rcv_ts = s_bench_now;
+    (void)vqec_fec_receive_packet(s_bench_chan.fec, pak, stream_hdl);
+    bench_stage_end(BENCH_STAGE_FEC, start, allocs);
+}
+
+/**
+ * One tick of the dataplane timer: collect the gaps for error repair,
+ * then run the output scheduler.
+ */
+static void
+bench_tick (boolean timed)
+{
+    vqec_pcm_t *pcm = &s_bench_chan.pcm;
+    vqec_dp_gap_buffer_t gapbuf;
+    boolean more, done_with_fastfill;
+    uint64_t start, allocs;
+
+    if (timed) {
+        bench_stage_begin(&start, &allocs);
+    }
+    do {
+        if (!vqec_pcm_gap_get_gaps(pcm, &gapbuf, &more)) {
+            break;
+        }
+    } while (more);
+    if (timed) {
+        bench_stage_end(BENCH_STAGE_GAPS, start, allocs);
+        bench_stage_begin(&start, &allocs);
+    }
+    (void)vqec_dp_oscheduler_run(&pcm->osched, s_bench_now,
+                                 &done_with_fastfill);
+    if (timed) {
+        bench_stage_end(BENCH_STAGE_OUTPUT, start, allocs);
+    }
+}
+
+static void
+bench_usage (const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-n packets] [-L columns] [-D rows] [-1] "
+            "[-m loss-model] [-s seed]\n"
+            "  loss-model: none | bernoulli:p | ge:p,r[,h] | "
+            "burst:len,period | trace:file\n",
+            prog);
+}
+
+int
+main (int argc, char **argv)
+{
+    uint32_t num_paks = BENCH_DEFAULT_PAKS, seed = 1;
+    uint32_t fec_l = BENCH_DEFAULT_L, fec_d = BENCH_DEFAULT_D;
+    boolean is_2d = TRUE;
+    bench_loss_t loss;
+    vqec_pcm_params_t pcm_params;
+    vqec_fec_params_t fec_params;
+    vqec_dp_oscheduler_streams_t streams;
+    vqec_dp_fec_status_t fec_status;
+    vqec_pak_pool_status_t pool_status;
+    bench_parity_t *cols, *prev_cols, *tmp, row;
+    vqec_pak_t *pak;
+    uint32_t i, pos, block, ts, sent_src = 0, sent_fec = 0;
+    uint32_t lost_src = 0, lost_fec = 0, drain;
+    uint16_t seq;
+    uint64_t total_ns = 0, total_allocs = 0;
+    char lossbuf[80];
+    int c;
+
+    (void)bench_loss_parse(&loss, "none");
+    while ((c = getopt(argc, argv, "n:L:D:1m:s:")) != -1) {
+        switch (c) {
+        case 'n':
+            num_paks = strtoul(optarg, NULL, 10);
+            break;
+        case 'L':
+            fec_l = strtoul(optarg, NULL, 10);
+            break;
+        case 'D':
+            fec_d = strtoul(optarg, NULL, 10);
+            break;
+        case '1':
+            is_2d = FALSE;
+            break;
+        case 'm':
+            if (!bench_loss_parse(&loss, optarg)) {
+                fprintf(stderr, "bad loss model: %s\n", optarg);
+                bench_usage(argv[0]);
+                return (1);
+            }
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            bench_usage(argv[0]);
+            return (1);
+        }
+    }
+    if (!num_paks || fec_l < (is_2d ? MIN_L_IN_2D : MIN_L) ||
+        fec_l > MAX_L || fec_d < MIN_D || fec_d > MAX_D ||
+        fec_l * fec_d > MAX_LD) {
+        bench_usage(argv[0]);
+        return (1);
+    }
+
+    cols = malloc(2 * fec_l * sizeof(bench_parity_t));
+    if (!cols) {
+        return (1);
+    }
+    prev_cols = cols + fec_l;
+    srand(seed);
+    bench_calibrate();
+
+    /* set up the pcm, fec and output scheduler as the channel does */
+    vqec_pak_pool_create("bench pak pool", BENCH_PAK_SIZE, BENCH_POOL_PAKS);
+    if (vqec_pcm_module_init(1) != VQEC_DP_ERR_OK ||
+        vqec_fec_module_init(1) != VQEC_DP_ERR_OK) {
+        fprintf(stderr, "module init failed\n");
+        return (1);
+    }
+
+    memset(&pcm_params, 0, sizeof(pcm_params));
+    pcm_params.dpchan = &s_bench_chan;
+    pcm_params.er_enable = TRUE;
+    pcm_params.fec_enable = TRUE;
+    pcm_params.avg_pkt_time = TIME_MK_R(usec, BENCH_PAK_TIME_USEC);
+    pcm_params.default_delay = TIME_MK_R(msec, BENCH_JITTER_BUFF_MSEC);
+    pcm_params.reorder_delay = TIME_MK_R(msec, BENCH_REORDER_MSEC);
+    pcm_params.repair_trigger_time = TIME_MK_R(msec, BENCH_REPAIR_TRIG_MSEC);
+    pcm_params.fec_info.fec_l_value = fec_l;
+    pcm_params.fec_info.fec_d_value = fec_d;
+    pcm_params.fec_info.fec_order = VQEC_DP_FEC_SENDING_ORDER_ANNEXB;
+    pcm_params.fec_default_block_size = fec_l * fec_d;
+    if (!vqec_pcm_init(&s_bench_chan.pcm, &pcm_params)) {
+        fprintf(stderr, "pcm init failed\n");
+        return (1);
+    }
+
+    memset(&fec_params, 0, sizeof(fec_params));
+    fec_params.is_fec_enabled = TRUE;
+    fec_params.avail_streams =
+        is_2d ? VQEC_FEC_STREAM_AVAIL_2D : VQEC_FEC_STREAM_AVAIL_1D;
+    fec_params.fec_type_stream1 = VQEC_FEC_TYPE_XOR;
+    fec_params.fec_type_stream2 = VQEC_FEC_TYPE_XOR;
+    s_bench_chan.fec_enabled = TRUE;
+    s_bench_chan.fec = vqec_fec_create(&fec_params, &s_bench_chan.pcm,
+                                       VQEC_DP_CHANID_INVALID);
+    if (!s_bench_chan.fec) {
+        fprintf(stderr, "fec create failed\n");
+        return (1);
+    }
+
+    memset(&streams, 0, sizeof(streams));
+    streams.osencap[0] = VQEC_DP_ENCAP_RTP;
+    streams.isids[0] = 1;
+    streams.isops[0] = &s_bench_out_isops;
+    if (vqec_dp_oscheduler_init(&s_bench_chan.pcm.osched,
+                                &s_bench_chan.pcm, 0) != VQEC_DP_ERR_OK ||
+        vqec_dp_oscheduler_add_streams(&s_bench_chan.pcm.osched, streams)
+        != VQEC_DP_ERR_OK ||
+        vqec_dp_oscheduler_start(&s_bench_chan.pcm.osched)
+        != VQEC_DP_ERR_OK) {
+        fprintf(stderr, "output scheduler init failed\n");
+        return (1);
+    }
+
+    printf("Dataplane benchmark: %u source packets, %s FEC %ux%u, "
+           "loss %s, XOR kernel %s\n",
+           num_paks, is_2d ? "2-D" : "1-D", fec_l, fec_d,
+           bench_loss_to_str(&loss, lossbuf, sizeof(lossbuf)),
+           vqec_fec_xor_impl_to_str(vqec_fec_xor_get_impl()));
+
+    s_bench_now = get_sys_time();
+    for (i = 0; i < num_paks; i++) {
+        seq = (uint16_t)(BENCH_START_SEQ + i);
+        ts = i * BENCH_RTP_TS_PER_PAK;
+        block = i / (fec_l * fec_d);
+        pos = i % (fec_l * fec_d);
+
+        if (!pos) {
+            tmp = prev_cols;
+            prev_cols = cols;
+            cols = tmp;
+            for (c = 0; c < fec_l; c++) {
+                bench_parity_reset(&cols[c], seq + c);
+            }
+        }
+        if (!(pos % fec_l)) {
+            bench_parity_reset(&row, seq);
+        }
+
+        pak = bench_src_pak(seq, ts);
+        if (!pak) {
+            fprintf(stderr, "packet pool exhausted\n");
+            return (1);
+        }
+        bench_parity_add(&cols[pos % fec_l], (char *)(pak->rtp + 1), ts);
+        bench_parity_add(&row, (char *)(pak->rtp + 1), ts);
+        sent_src++;
+        if (bench_loss_drop(&loss)) {
+            lost_src++;
+        } else {
+            bench_deliver_src(pak);
+        }
+        vqec_pak_free(pak);
+
+        /* row FEC as soon as the row is complete */
+        if (is_2d && (pos % fec_l) == fec_l - 1) {
+            pak = bench_fec_pak(&row, 1, fec_l);
+            sent_fec++;
+            if (pak) {
+                if (bench_loss_drop(&loss)) {
+                    lost_fec++;
+                } else {
+                    bench_deliver_fec(pak, VQEC_DP_FEC1_IS_HANDLE);
+                }
+                vqec_pak_free(pak);
+            }
+        }
+
+        /* column FEC of the previous block, one every D source packets */
+        if (block && !((pos + 1) % fec_d)) {
+            pak = bench_fec_pak(&prev_cols[(pos + 1) / fec_d - 1],
+                                fec_l, fec_d);
+            sent_fec++;
+            if (pak) {
+                if (bench_loss_drop(&loss)) {
+                    lost_fec++;
+                } else {
+                    bench_deliver_fec(pak, VQEC_DP_FEC0_IS_HANDLE);
+                }
+                vqec_pak_free(pak);
+            }
+        }
+
+        s_bench_now = TIME_ADD_A_R(s_bench_now,
+                                   TIME_MK_R(usec, BENCH_PAK_TIME_USEC));
+        if (!((i + 1) % BENCH_TICK_PAKS)) {
+            bench_tick(TRUE);
+        }
+    }
+
+    /* drain the jitter buffer, untimed */
+    drain = (BENCH_JITTER_BUFF_MSEC * 1000 / BENCH_PAK_TIME_USEC +
+             4 * fec_l * fec_d) / BENCH_TICK_PAKS + 1;
+    while (drain--) {
+        s_bench_now = TIME_ADD_A_R(s_bench_now,
+                                   TIME_MK_R(usec, BENCH_PAK_TIME_USEC *
+                                             BENCH_TICK_PAKS));
+        bench_tick(FALSE);
+    }
+
+    printf("sent %u source + %u FEC packets, lost %u source + %u FEC\n",
+           sent_src, sent_fec, lost_src, lost_fec);
+    printf("%-12s %10s %12s %12s %10s %10s\n",
+           "stage", "calls", "ns/call", "ns/src-pak", "allocs", "allocs/call");
+    for (c = 0; c < BENCH_STAGE_NUM; c++) {
+        printf("%-12s %10llu %12.1f %12.1f %10llu %10.2f\n",
+               s_bench_stages[c].name,
+               (unsigned long long)s_bench_stages[c].calls,
+               s_bench_stages[c].calls ?
+               (double)s_bench_stages[c].ns / s_bench_stages[c].calls : 0.0,
+               (double)s_bench_stages[c].ns / num_paks,
+               (unsigned long long)s_bench_stages[c].allocs,
+               s_bench_stages[c].calls ?
+               (double)s_bench_stages[c].allocs / s_bench_stages[c].calls :
+               0.0);
+        total_ns += s_bench_stages[c].ns;
+        total_allocs += s_bench_stages[c].allocs;
+    }
+    printf("%-12s %10s %12s %12.1f %10llu\n", "total", "", "",
+           (double)total_ns / num_paks, (unsigned long long)total_allocs);
+    printf("throughput: %.0f packets/sec (source + FEC received), "
+           "%.0f source packets/sec\n",
+           (double)(sent_src + sent_fec - lost_src - lost_fec) * 1e9 /
+           total_ns,
+           (double)sent_src * 1e9 / total_ns);
+
+    vqec_fec_get_status(s_bench_chan.fec, &fec_status, TRUE);
+    printf("fec: recovered %llu, late %llu, unrecoverable %llu, "
+           "not needed %llu\n",
+           (unsigned long long)fec_status.fec_recovered_paks,
+           (unsigned long long)fec_status.fec_late_paks,
+           (unsigned long long)fec_status.fec_unrecoverable_paks,
+           (unsigned long long)fec_status.fec_dec_not_needed);
+    printf("output: %u packets, %u gaps (%u packets), %u corrupt\n",
+           s_bench_out_paks, s_bench_out_gaps, s_bench_out_gap_paks,
+           s_bench_out_corrupt);
+    if (vqec_pak_pool_get_status(&pool_status) == VQEC_PAK_POOL_ERR_OK) {
+        printf("pak pool: %d max, %d in use, %d high water, "
+               "%d alloc failures\n",
+               pool_status.max, pool_status.used, pool_status.hiwat,
+               pool_status.alloc_fail);
+    }
+
+    (void)vqec_dp_oscheduler_deinit(&s_bench_chan.pcm.osched);
+    vqec_fec_destroy(s_bench_chan.fec);
+    vqec_pcm_deinit(&s_bench_chan.pcm);
+    (void)vqec_fec_module_deinit();
+    (void)vqec_pcm_module_deinit();
+    vqec_pak_pool_destroy();
+    free(cols < prev_cols ? cols : prev_cols);
+    free(loss.trace);
+
+    return (s_bench_out_corrupt ? 1 : 0);
+}
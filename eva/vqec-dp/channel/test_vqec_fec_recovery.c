@@ -0,0 +1,584 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * test_vqec_fec_recovery.c - unit-tests of FEC recovery into the PCM.
+ *
+ * A PCM and FEC module are set up as vqec_dpchan_create() sets them up,
+ * without the input / output shims or the channel state machine. Source
+ * and FEC packets are built here, delivered as the input streams deliver
+ * them, and the packets recovered into the PCM are checked against the
+ * originals.
+ */
+
+#include "vqec_dpchan.h"
+#include "vqec_fec_xor.h"
+#include "vqec_fec_rs.h"
+#include "vqec_pak.h"
+#include "rtp.h"
+#include <eva/vqec_channel_private.h>
+#include <eva/vqec_rtp.h>
+#include "../add-ons/include/CUnit/CUnit.h"
+#include "../add-ons/include/CUnit/Basic.h"
+
+#define UT_PAYLOAD          1316    /* 7 MPEG-TS packets */
+#define UT_PAK_SIZE         1500
+#define UT_POOL_PAKS        512
+#define UT_PAK_TIME_USEC    1000
+#define UT_JITTER_BUFF_MSEC 50
+#define UT_REORDER_MSEC     10
+#define UT_RTP_TS_PER_PAK   90
+#define UT_SRC_PT           RTP_MP2T
+#define UT_FEC_PT           96
+#define UT_START_SEQ        1000
+#define UT_L                5
+#define UT_D                5
+#define UT_LD               (UT_L * UT_D)
+#define UT_RS_VEC_LEN       (VQEC_FEC_RS_HDR_BYTES + UT_PAYLOAD)
+
+static vqec_dpchan_t s_ut_chan;
+static abs_time_t s_ut_now;
+static uint16_t s_ut_fec_seq;
+static uint32_t s_ut_out_paks;
+
+/*
+ * XOR parity of a row or column.
+ */
+typedef struct ut_parity_ {
+    uint16_t snbase;
+    uint8_t pt;
+    uint32_t ts;
+    uint16_t len;
+    char payload[UT_PAYLOAD];
+} ut_parity_t;
+
+/*
+ * The primary input stream calls into the control-plane for RTCP packets
+ * multiplexed on the RTP port; there is no control-plane here.
+ */
+vqec_chan_t *
+vqec_chanid_to_chan (const vqec_chanid_t chanid)
+{
+    return (NULL);
+}
+
+void
+rtcp_event_handler_internal_process_pak (rtp_session_t *rtp_session,
+                                         struct in_addr pak_src_addr,
+                                         uint16_t pak_src_port,
+                                         char *pak_buff,
+                                         int32_t pak_buff_len,
+                                         struct timeval *recv_time)
+{
+}
+
+static vqec_dp_stream_err_t
+ut_out_receive (vqec_dp_isid_t is, vqec_pak_t *pak)
+{
+    s_ut_out_paks++;
+    return (VQEC_DP_STREAM_ERR_OK);
+}
+
+static const vqec_dp_isops_t s_ut_out_isops = {
+    .receive = ut_out_receive,
+};
+
+/*----------------------------------------------------------------------------
+ * Packets.
+ *---------------------------------------------------------------------------*/
+
+static inline uint32_t
+ut_src_ts (uint16_t seq)
+{
+    return ((uint16_t)(seq - UT_START_SEQ) * UT_RTP_TS_PER_PAK);
+}
+
+/**
+ * Fill in the payload of a source packet: the sequence number, then a
+ * byte pattern that differs from packet to packet.
+ */
+static void
+ut_src_payload (uint16_t seq, char *payload)
+{
+    uint32_t i;
+
+    for (i = 0; i < UT_PAYLOAD; i++) {
+        payload[i] = (char)(seq * 7 + i * 13);
+    }
+    memcpy(payload, &seq, sizeof(seq));
+}
+
+static vqec_pak_t *
+ut_src_pak (uint16_t seq)
+{
+    vqec_pak_t *pak;
+
+    pak = vqec_pak_alloc_with_particle();
+    if (!pak) {
+        return (NULL);
+    }
+    pak->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+    memset(pak->rtp, 0, sizeof(rtpfasttype_t));
+    SET_RTP_VERSION(pak->rtp, RTPVERSION);
+    SET_RTP_PAYLOAD(pak->rtp, UT_SRC_PT);
+    pak->rtp->sequence = htons(seq);
+    pak->rtp->timestamp = htonl(ut_src_ts(seq));
+    pak->rtp->ssrc = htonl(0x12345678);
+    ut_src_payload(seq, (char *)(pak->rtp + 1));
+    (void)vqec_pak_set_content_len(pak, sizeof(rtpfasttype_t) + UT_PAYLOAD);
+
+    pak->type = VQEC_PAK_TYPE_PRIMARY;
+    pak->mpeg_payload_offset = sizeof(rtpfasttype_t);
+    pak->rtp_ts = ut_src_ts(seq);
+    return (pak);
+}
+
+/**
+ * XOR parity of num members of a row or column, starting at snbase.
+ */
+static void
+ut_parity (ut_parity_t *par, uint16_t snbase, uint32_t offset, uint32_t num)
+{
+    char payload[UT_PAYLOAD];
+    char *srcs[2];
+    uint16_t seq;
+    uint32_t i;
+
+    memset(par, 0, sizeof(*par));
+    par->snbase = snbase;
+    for (i = 0; i < num; i++) {
+        seq = snbase + i * offset;
+        ut_src_payload(seq, payload);
+        par->pt ^= UT_SRC_PT;
+        par->ts ^= ut_src_ts(seq);
+        par->len ^= UT_PAYLOAD;
+        srcs[0] = par->payload;
+        srcs[1] = payload;
+        vqec_fec_xor_blocks(par->payload, srcs, 2, UT_PAYLOAD);
+    }
+}
+
+static vqec_pak_t *
+ut_fec_pak (ut_parity_t *par, uint8_t offset, uint8_t na)
+{
+    vqec_pak_t *pak;
+    rtpfasttype_t *rtp;
+    fecfasttype_t *fec_hdr;
+
+    pak = vqec_pak_alloc_with_particle();
+    if (!pak) {
+        return (NULL);
+    }
+    rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+    memset(rtp, 0, sizeof(rtpfasttype_t) + sizeof(fecfasttype_t));
+    SET_RTP_VERSION(rtp, RTPVERSION);
+    SET_RTP_PAYLOAD(rtp, UT_FEC_PT);
+    rtp->sequence = htons(s_ut_fec_seq++);
+    rtp->ssrc = htonl(0x12345679);
+
+    fec_hdr = (fecfasttype_t *)(rtp + 1);
+    fec_hdr->snbase_low_bits = htons(par->snbase);
+    fec_hdr->length_recovery = htons(par->len);
+    SET_FEC_E_BIT(fec_hdr, 1);
+    SET_FEC_PT_RECOVERY(fec_hdr, par->pt);
+    fec_hdr->ts_recovery = htonl(par->ts);
+    SET_FEC_D_BIT(fec_hdr, offset == 1);
+    SET_FEC_TYPE(fec_hdr, VQEC_FEC_TYPE_XOR);
+    SET_FEC_OFFSET(fec_hdr, offset);
+    SET_FEC_NA(fec_hdr, na);
+
+    memcpy(fec_hdr + 1, par->payload, UT_PAYLOAD);
+    (void)vqec_pak_set_content_len(pak, sizeof(rtpfasttype_t) +
+                                   sizeof(fecfasttype_t) + UT_PAYLOAD);
+    return (pak);
+}
+
+/**
+ * Deliver a source packet to the PCM, as the primary input stream does.
+ */
+static void
+ut_deliver_src (uint16_t seq)
+{
+    vqec_pcm_t *pcm = &s_ut_chan.pcm;
+    vqec_pak_t *pak;
+
+    pak = ut_src_pak(seq);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pak);
+    pak->rcv_ts = s_ut_now;
+    pak->seq_num =
+        vqec_seq_num_nearest_to_rtp_seq_num(vqec_pcm_get_last_rx_seq_num(pcm),
+                                            ntohs(pak->rtp->sequence));
+    vqec_pcm_set_last_rx_seq_num(pcm, pak->seq_num);
+    (void)vqec_pcm_insert_packets(pcm, &pak, 1, TRUE, NULL);
+    vqec_pak_free(pak);
+    s_ut_now = TIME_ADD_A_R(s_ut_now, TIME_MK_R(usec, UT_PAK_TIME_USEC));
+}
+
+/**
+ * Build Reed-Solomon column FEC packet index of a column, laid out as
+ * described in vqec_fec_rs.h.
+ */
+static vqec_pak_t *
+ut_rs_fec_pak (uint16_t snbase, uint8_t index)
+{
+    static char vecs[UT_D][UT_RS_VEC_LEN];
+    static char par[UT_RS_VEC_LEN];
+    char *members[UT_D];
+    rtpfasttype_t src_rtp;
+    vqec_pak_t *pak;
+    rtpfasttype_t *rtp;
+    fecfasttype_t *fec_hdr;
+    uint16_t seq;
+    uint32_t i;
+
+    for (i = 0; i < UT_D; i++) {
+        seq = snbase + i * UT_L;
+        memset(&src_rtp, 0, sizeof(src_rtp));
+        SET_RTP_VERSION(&src_rtp, RTPVERSION);
+        SET_RTP_PAYLOAD(&src_rtp, UT_SRC_PT);
+        src_rtp.sequence = htons(seq);
+        src_rtp.timestamp = htonl(ut_src_ts(seq));
+        vqec_fec_rs_hdr_vector((uint8_t *)vecs[i], (const uint8_t *)&src_rtp,
+                               UT_PAYLOAD);
+        ut_src_payload(seq, vecs[i] + VQEC_FEC_RS_HDR_BYTES);
+        members[i] = vecs[i];
+    }
+    vqec_fec_rs_encode(par, members, UT_D, index, UT_RS_VEC_LEN);
+
+    pak = vqec_pak_alloc_with_particle();
+    if (!pak) {
+        return (NULL);
+    }
+    rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+    memset(rtp, 0, sizeof(rtpfasttype_t) + sizeof(fecfasttype_t));
+    SET_RTP_VERSION(rtp, RTPVERSION);
+    SET_RTP_PAYLOAD(rtp, UT_FEC_PT);
+    SET_RTP_MARKER(rtp, par[1] & 0x80);
+    rtp->sequence = htons(s_ut_fec_seq++);
+    rtp->ssrc = htonl(0x12345679);
+
+    /* bytes 4 - 7 and 8 - 9 of the vector are already in network order */
+    fec_hdr = (fecfasttype_t *)(rtp + 1);
+    fec_hdr->snbase_low_bits = htons(snbase);
+    memcpy(&fec_hdr->length_recovery, par + 8, 
+           sizeof(fec_hdr->length_recovery));
+    SET_FEC_E_BIT(fec_hdr, 1);
+    SET_FEC_PT_RECOVERY(fec_hdr, par[1] & 0x7f);
+    memcpy(&fec_hdr->ts_recovery, par + 4, sizeof(fec_hdr->ts_recovery));
+    SET_FEC_TYPE(fec_hdr, VQEC_FEC_TYPE_RS);
+    PUTSHORT(&fec_hdr->combined2, 
+             GETSHORT(&fec_hdr->combined2) | ((index & 0x07) << 8));
+    SET_FEC_OFFSET(fec_hdr, UT_L);
+    SET_FEC_NA(fec_hdr, UT_D);
+
+    memcpy(fec_hdr + 1, par + VQEC_FEC_RS_HDR_BYTES, UT_PAYLOAD);
+    (void)vqec_pak_set_content_len(pak, sizeof(rtpfasttype_t) +
+                                   sizeof(fecfasttype_t) + UT_PAYLOAD);
+    return (pak);
+}
+
+/**
+ * Deliver a column FEC packet, as the FEC input stream does.
+ */
+static void
+ut_deliver_fec (vqec_pak_t *pak)
+{
+    CU_ASSERT_PTR_NOT_NULL_FATAL(pak);
+    pak->rcv_ts = s_ut_now;
+    (void)vqec_fec_receive_packet(s_ut_chan.fec, pak, VQEC_DP_FEC0_IS_HANDLE);
+    vqec_pak_free(pak);
+}
+
+/**
+ * Deliver the XOR column FEC packet of a column.
+ */
+static void
+ut_deliver_col_fec (uint16_t snbase)
+{
+    ut_parity_t par;
+
+    ut_parity(&par, snbase, UT_L, UT_D);
+    ut_deliver_fec(ut_fec_pak(&par, UT_L, UT_D));
+}
+
+/**
+ * Run the output scheduler after advancing time by msecs.
+ */
+static void
+ut_tick (uint32_t msecs)
+{
+    boolean done_with_fastfill;
+
+    s_ut_now = TIME_ADD_A_R(s_ut_now, TIME_MK_R(msec, msecs));
+    (void)vqec_dp_oscheduler_run(&s_ut_chan.pcm.osched, s_ut_now,
+                                 &done_with_fastfill);
+}
+
+/**
+ * Check that the PCM holds a packet identical to the source packet.
+ */
+static void
+ut_check_pak (vqec_seq_num_t seq_num, uint16_t seq)
+{
+    vqec_pak_t *pak, *orig;
+
+    pak = vqec_pak_seq_find(s_ut_chan.pcm.pak_seq, seq_num);
+    CU_ASSERT_PTR_NOT_NULL(pak);
+    orig = ut_src_pak(seq);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(orig);
+    if (pak) {
+        CU_ASSERT_EQUAL(vqec_pak_get_content_len(pak),
+                        vqec_pak_get_content_len(orig));
+        CU_ASSERT_EQUAL(memcmp(vqec_pak_get_head_ptr(pak),
+                               vqec_pak_get_head_ptr(orig),
+                               vqec_pak_get_content_len(orig)), 0);
+    }
+    vqec_pak_free(orig);
+}
+
+/*----------------------------------------------------------------------------
+ * Setup.
+ *---------------------------------------------------------------------------*/
+
+static int
+ut_fec_setup (void)
+{
+    vqec_pcm_params_t pcm_params;
+    vqec_fec_params_t fec_params;
+    vqec_dp_oscheduler_streams_t streams;
+
+    memset(&s_ut_chan, 0, sizeof(s_ut_chan));
+    s_ut_out_paks = 0;
+    s_ut_fec_seq = 0;
+
+    memset(&pcm_params, 0, sizeof(pcm_params));
+    pcm_params.dpchan = &s_ut_chan;
+    pcm_params.er_enable = FALSE;
+    pcm_params.fec_enable = TRUE;
+    pcm_params.avg_pkt_time = TIME_MK_R(usec, UT_PAK_TIME_USEC);
+    pcm_params.default_delay = TIME_MK_R(msec, UT_JITTER_BUFF_MSEC);
+    pcm_params.reorder_delay = TIME_MK_R(msec, UT_REORDER_MSEC);
+    pcm_params.fec_info.fec_l_value = UT_L;
+    pcm_params.fec_info.fec_d_value = UT_D;
+    pcm_params.fec_info.fec_order = VQEC_DP_FEC_SENDING_ORDER_ANNEXB;
+    pcm_params.fec_default_block_size = UT_LD;
+    if (!vqec_pcm_init(&s_ut_chan.pcm, &pcm_params)) {
+        return (-1);
+    }
+
+    memset(&fec_params, 0, sizeof(fec_params));
+    fec_params.is_fec_enabled = TRUE;
+    fec_params.avail_streams = VQEC_FEC_STREAM_AVAIL_1D;
+    fec_params.fec_type_stream1 = VQEC_FEC_TYPE_XOR;
+    s_ut_chan.fec_enabled = TRUE;
+    s_ut_chan.fec = vqec_fec_create(&fec_params, &s_ut_chan.pcm,
+                                    VQEC_DP_CHANID_INVALID);
+    if (!s_ut_chan.fec) {
+        return (-1);
+    }
+
+    memset(&streams, 0, sizeof(streams));
+    streams.osencap[0] = VQEC_DP_ENCAP_RTP;
+    streams.isids[0] = 1;
+    streams.isops[0] = &s_ut_out_isops;
+    if (vqec_dp_oscheduler_init(&s_ut_chan.pcm.osched,
+                                &s_ut_chan.pcm, 0) != VQEC_DP_ERR_OK ||
+        vqec_dp_oscheduler_add_streams(&s_ut_chan.pcm.osched, streams)
+        != VQEC_DP_ERR_OK ||
+        vqec_dp_oscheduler_start(&s_ut_chan.pcm.osched)
+        != VQEC_DP_ERR_OK) {
+        return (-1);
+    }
+
+    s_ut_now = get_sys_time();
+    return (0);
+}
+
+static void
+ut_fec_teardown (void)
+{
+    (void)vqec_dp_oscheduler_deinit(&s_ut_chan.pcm.osched);
+    vqec_fec_destroy(s_ut_chan.fec);
+    vqec_pcm_deinit(&s_ut_chan.pcm);
+}
+
+/**
+ * Deliver two whole blocks with all of their column FEC: the FEC
+ * columns of the first block let the sending order, L and D be
+ * learned, the first column of the second block pins the block
+ * alignment. Parity accumulation starts with the next block.
+ *
+ * @return the base of the next block
+ */
+static uint16_t
+ut_pin_alignment (uint16_t base)
+{
+    uint32_t i, j;
+
+    for (i = 0; i < 2; i++, base += UT_LD) {
+        for (j = 0; j < UT_LD; j++) {
+            ut_deliver_src(base + j);
+        }
+        for (j = 0; j < UT_L; j++) {
+            ut_deliver_col_fec(base + j);
+        }
+    }
+    CU_ASSERT_FATAL(s_ut_chan.fec->acc->pinned);
+    return (base);
+}
+
+/*----------------------------------------------------------------------------
+ * Tests.
+ *---------------------------------------------------------------------------*/
+
+/*
+ * A packet recovered into a PCM which the output scheduler has drained
+ * is inserted after an underrun, which resets the parity accumulators;
+ * among them the one the packet was recovered from.
+ */
+static void
+test_vqec_fec_recover_underrun (void)
+{
+    vqec_dp_fec_status_t fec_status;
+    vqec_pak_pool_status_t pool_status;
+    vqec_pcm_t *pcm;
+    uint16_t base;
+    uint32_t i;
+
+    CU_ASSERT_EQUAL_FATAL(ut_fec_setup(), 0);
+    pcm = &s_ut_chan.pcm;
+
+    base = ut_pin_alignment(UT_START_SEQ);
+
+    /* the first packet of the next block is lost */
+    for (i = 1; i < UT_LD; i++) {
+        ut_deliver_src(base + i);
+    }
+
+    /* drain the PCM */
+    for (i = 0; i < 10; i++) {
+        ut_tick(UT_JITTER_BUFF_MSEC);
+    }
+    CU_ASSERT_EQUAL_FATAL(vqec_pak_seq_get_num_paks(pcm->pak_seq), 0);
+    CU_ASSERT_EQUAL(pcm->stats.under_run_counter, 0);
+
+    ut_deliver_col_fec(base);
+    CU_ASSERT_EQUAL(pcm->stats.under_run_counter, 1);
+    CU_ASSERT_FALSE(s_ut_chan.fec->acc->pinned);
+    vqec_fec_get_status(s_ut_chan.fec, &fec_status, FALSE);
+    CU_ASSERT_EQUAL(fec_status.fec_recovered_paks, 1);
+    CU_ASSERT_EQUAL(vqec_pak_seq_get_num_paks(pcm->pak_seq), 1);
+    ut_check_pak(vqec_seq_num_nearest_to_rtp_seq_num(
+                     vqec_pcm_get_last_rx_seq_num(pcm), base), base);
+
+    /* the FEC packet held by the accumulator is freed once */
+    ut_fec_teardown();
+    CU_ASSERT_EQUAL(vqec_pak_pool_get_status(&pool_status),
+                    VQEC_PAK_POOL_ERR_OK);
+    CU_ASSERT_EQUAL(pool_status.used, 0);
+}
+
+/*
+ * Several packets of a Reed-Solomon column are lost: they are recovered
+ * once as many FEC packets of the column have been received, and
+ * inserted into the PCM as they were sent.
+ */
+static void
+test_vqec_fec_recover_rs (void)
+{
+    vqec_dp_fec_status_t fec_status;
+    vqec_pak_pool_status_t pool_status;
+    vqec_pcm_t *pcm;
+    vqec_seq_num_t seq_num;
+    const uint16_t base = UT_START_SEQ + UT_LD, num_loss = 3;
+    uint16_t seq;
+    uint32_t i;
+
+    CU_ASSERT_EQUAL_FATAL(ut_fec_setup(), 0);
+    pcm = &s_ut_chan.pcm;
+
+    /*
+     * A whole block, so that the PCM holds packets before the next one,
+     * then the next block without the first num_loss packets of column 0.
+     */
+    for (i = 0; i < UT_LD; i++) {
+        ut_deliver_src(UT_START_SEQ + i);
+    }
+    for (i = 0; i < UT_LD; i++) {
+        if (i % UT_L || i / UT_L >= num_loss) {
+            ut_deliver_src(base + i);
+        }
+    }
+    CU_ASSERT_EQUAL(vqec_pak_seq_get_num_paks(pcm->pak_seq), 
+                    2 * UT_LD - num_loss);
+
+    /* nothing can be recovered before the last FEC packet */
+    for (i = 0; i < num_loss; i++) {
+        vqec_fec_get_status(s_ut_chan.fec, &fec_status, FALSE);
+        CU_ASSERT_EQUAL(fec_status.fec_recovered_paks, 0);
+        ut_deliver_fec(ut_rs_fec_pak(base, i));
+    }
+    vqec_fec_get_status(s_ut_chan.fec, &fec_status, FALSE);
+    CU_ASSERT_EQUAL(fec_status.fec_recovered_paks, num_loss);
+    CU_ASSERT_EQUAL(vqec_pak_seq_get_num_paks(pcm->pak_seq), 2 * UT_LD);
+
+    for (i = 0; i < num_loss; i++) {
+        seq = base + i * UT_L;
+        seq_num = 
+            vqec_seq_num_nearest_to_rtp_seq_num(
+                vqec_pcm_get_last_rx_seq_num(pcm), seq);
+        ut_check_pak(seq_num, seq);
+    }
+
+    ut_fec_teardown();
+    CU_ASSERT_EQUAL(vqec_pak_pool_get_status(&pool_status),
+                    VQEC_PAK_POOL_ERR_OK);
+    CU_ASSERT_EQUAL(pool_status.used, 0);
+}
+
+static CU_TestInfo s_ut_fec_recovery_tests[] = {
+    { "recovery into a drained pcm", test_vqec_fec_recover_underrun },
+    { "reed-solomon recovery of a column", test_vqec_fec_recover_rs },
+    CU_TEST_INFO_NULL,
+};
+
+static CU_SuiteInfo s_ut_suites[] = {
+    { "FEC recovery", NULL, NULL, s_ut_fec_recovery_tests },
+    CU_SUITE_INFO_NULL,
+};
+
+int
+main (int argc, char **argv)
+{
+    int failures;
+
+    vqec_pak_pool_create("utest pak pool", UT_PAK_SIZE, UT_POOL_PAKS);
+    if (vqec_pcm_module_init(1) != VQEC_DP_ERR_OK ||
+        vqec_fec_module_init(1) != VQEC_DP_ERR_OK) {
+        fprintf(stderr, "module init failed\n");
+        return (1);
+    }
+
+    if (CU_initialize_registry() != CUE_SUCCESS) {
+        return (CU_get_error());
+    }
+    if (CU_register_suites(s_ut_suites) != CUE_SUCCESS) {
+        CU_cleanup_registry();
+        return (CU_get_error());
+    }
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    failures = CU_get_number_of_failures();
+    CU_cleanup_registry();
+
+    (void)vqec_fec_module_deinit();
+    (void)vqec_pcm_module_deinit();
+    vqec_pak_pool_destroy();
+
+    return (failures ? 1 : 0);
+}
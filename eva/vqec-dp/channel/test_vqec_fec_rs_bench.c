@@ -0,0 +1,166 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * test_vqec_fec_rs_bench.c - standalone benchmark for the Reed-Solomon
+ * FEC decoder.
+ *
+ * For rows / columns of several sizes and for 1 up to
+ * VQEC_FEC_RS_MAX_PARITY losses, this program encodes the parity
+ * packets, then repeatedly recovers the lost members from them (syndrome
+ * computation and solve, as the decoder does) and checks the recovered
+ * members against the originals. Throughput is reported in source
+ * payload bytes per second, with the lost members spread evenly.
+ *
+ * Usage: test_vqec_fec_rs_bench [iterations] [payload-bytes]
+ */
+
+#include <time.h>
+#include "vqec_fec.h"
+#include "vqec_fec_xor.h"
+#include "vqec_fec_rs.h"
+
+#define BENCH_DEFAULT_ITERATIONS  2000
+#define BENCH_DEFAULT_PAYLOAD     1316  /* 7 MPEG-TS packets */
+#define BENCH_MAX_PAYLOAD         1500
+
+/* number of members in a row or column: MIN_D, typical, MAX_D */
+static const uint8_t s_bench_num_members[] = { MIN_D + 1, 10, MAX_D };
+static const uint8_t s_bench_num_lost[] = { 1, 2, 3, 4, VQEC_FEC_RS_MAX_PARITY };
+
+static uint64_t
+bench_now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+int
+main (int argc, char **argv)
+{
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS, it, i, n, l;
+    uint32_t payload = BENCH_DEFAULT_PAYLOAD;
+    char *members[MAX_D], *parity[VQEC_FEC_RS_MAX_PARITY];
+    char *syn[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t parity_index[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t lost[VQEC_FEC_RS_MAX_PARITY], which[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t num_members, num_lost, m, r, j;
+    boolean is_lost[MAX_D], ok = TRUE;
+    uint64_t start, enc_ns, dec_ns;
+    char *pool;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        payload = strtoul(argv[2], NULL, 10);
+    }
+    if (!iterations || !payload || payload > BENCH_MAX_PAYLOAD) {
+        fprintf(stderr, "usage: %s [iterations] [payload-bytes <= %d]\n",
+                argv[0], BENCH_MAX_PAYLOAD);
+        return (1);
+    }
+
+    pool = malloc((MAX_D + 2 * VQEC_FEC_RS_MAX_PARITY) * BENCH_MAX_PAYLOAD);
+    if (!pool) {
+        return (1);
+    }
+    for (i = 0; i < MAX_D; i++) {
+        members[i] = pool + i * BENCH_MAX_PAYLOAD;
+    }
+    for (i = 0; i < VQEC_FEC_RS_MAX_PARITY; i++) {
+        parity[i] = pool + (MAX_D + i) * BENCH_MAX_PAYLOAD;
+        syn[i] = pool + (MAX_D + VQEC_FEC_RS_MAX_PARITY + i) *
+            BENCH_MAX_PAYLOAD;
+        parity_index[i] = i;
+    }
+    srand(1);
+    for (i = 0; i < MAX_D * BENCH_MAX_PAYLOAD; i++) {
+        pool[i] = (char)rand();
+    }
+
+    vqec_fec_xor_init();
+    vqec_fec_rs_init();
+    printf("FEC Reed-Solomon benchmark: payload %u bytes, %u iterations, "
+           "XOR kernel %s\n",
+           payload, iterations,
+           vqec_fec_xor_impl_to_str(vqec_fec_xor_get_impl()));
+    printf("%8s %6s %14s %14s %12s\n", "members", "lost", "ns/encode",
+           "ns/recovery", "MB/s");
+
+    for (n = 0; n < sizeof(s_bench_num_members); n++) {
+        num_members = s_bench_num_members[n];
+        for (l = 0; l < sizeof(s_bench_num_lost); l++) {
+            num_lost = s_bench_num_lost[l];
+            if (num_lost >= num_members) {
+                continue;
+            }
+
+            /* spread the losses over the row / column */
+            memset(is_lost, 0, sizeof(is_lost));
+            for (m = 0; m < num_lost; m++) {
+                lost[m] = (m * num_members) / num_lost;
+                is_lost[lost[m]] = TRUE;
+            }
+
+            start = bench_now_ns();
+            for (it = 0; it < iterations; it++) {
+                for (r = 0; r < num_lost; r++) {
+                    vqec_fec_rs_encode(parity[r], members, num_members,
+                                       parity_index[r], payload);
+                }
+            }
+            enc_ns = bench_now_ns() - start;
+
+            start = bench_now_ns();
+            for (it = 0; it < iterations; it++) {
+                for (r = 0; r < num_lost; r++) {
+                    memcpy(syn[r], parity[r], payload);
+                }
+                for (j = 0; j < num_members; j++) {
+                    if (is_lost[j]) {
+                        continue;
+                    }
+                    for (r = 0; r < num_lost; r++) {
+                        vqec_fec_rs_mul_add(syn[r], members[j],
+                                        vqec_fec_rs_coef(parity_index[r], j),
+                                        payload);
+                    }
+                }
+                if (!vqec_fec_rs_solve(syn, parity_index, lost, num_lost,
+                                       payload, which)) {
+                    break;
+                }
+            }
+            dec_ns = bench_now_ns() - start;
+
+            for (m = 0; m < num_lost && it == iterations; m++) {
+                if (memcmp(syn[which[m]], members[lost[m]], payload)) {
+                    break;
+                }
+            }
+            if (it != iterations || m != num_lost) {
+                printf("%8u %6u MISMATCH\n", num_members, num_lost);
+                ok = FALSE;
+                continue;
+            }
+
+            printf("%8u %6u %14.1f %14.1f %12.1f\n",
+                   num_members, num_lost,
+                   (double)enc_ns / iterations,
+                   (double)dec_ns / iterations,
+                   ((double)payload * num_members * iterations) /
+                   ((double)dec_ns / 1000.0));
+        }
+    }
+
+    free(pool);
+    return (ok ? 0 : 1);
+}
@@ -0,0 +1,129 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * test_vqec_fec_xor_bench.c - standalone benchmark for the FEC XOR kernels.
+ *
+ * For each XOR kernel supported by the CPU, and for a range of block
+ * sizes (number of packets XOR'ed together, from a 1-packet row up to
+ * MAX_LD), this program times the recovery of a 1316-byte payload and
+ * checks the result against the scalar kernel.
+ *
+ * Usage: test_vqec_fec_xor_bench [iterations] [payload-bytes]
+ */
+
+#include <time.h>
+#include "vqec_fec.h"
+#include "vqec_fec_xor.h"
+
+#define BENCH_DEFAULT_ITERATIONS  20000
+#define BENCH_DEFAULT_PAYLOAD     1316  /* 7 MPEG-TS packets */
+#define BENCH_MAX_PAYLOAD         1500
+
+/*
+ * Number of source packets XOR'ed per recovery: 1-D / 2-D rows and
+ * columns are (L or D) - 1 received packets plus the FEC packet.
+ */
+static const uint16_t s_bench_num_srcs[] = {
+    2, MIN_D, MIN_L_IN_2D + 1, 10, MAX_L, MAX_D + 1, 64, 128, MAX_LD,
+};
+
+static uint64_t
+bench_now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+int
+main (int argc, char **argv)
+{
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS, it, i, n, impl;
+    uint32_t payload = BENCH_DEFAULT_PAYLOAD;
+    char *srcs[MAX_LD], *pool;
+    char ref[BENCH_MAX_PAYLOAD], out[BENCH_MAX_PAYLOAD + 1];
+    uint64_t start, elapsed;
+    double ns_per, mbps;
+    boolean ok = TRUE;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        payload = strtoul(argv[2], NULL, 10);
+    }
+    if (!iterations || !payload || payload > BENCH_MAX_PAYLOAD) {
+        fprintf(stderr, "usage: %s [iterations] [payload-bytes <= %d]\n",
+                argv[0], BENCH_MAX_PAYLOAD);
+        return (1);
+    }
+
+    /*
+     * One extra byte per packet so that the sources are deliberately
+     * misaligned, as RTP payloads are in real packet buffers.
+     */
+    pool = malloc(MAX_LD * (BENCH_MAX_PAYLOAD + 1));
+    if (!pool) {
+        return (1);
+    }
+    srand(1);
+    for (i = 0; i < MAX_LD * (BENCH_MAX_PAYLOAD + 1); i++) {
+        pool[i] = (char)rand();
+    }
+    for (i = 0; i < MAX_LD; i++) {
+        srcs[i] = pool + i * (BENCH_MAX_PAYLOAD + 1) + (i & 1);
+    }
+
+    vqec_fec_xor_init();
+    printf("FEC XOR benchmark: payload %u bytes, %u iterations, "
+           "default kernel %s\n",
+           payload, iterations,
+           vqec_fec_xor_impl_to_str(vqec_fec_xor_get_impl()));
+    printf("%-8s %8s %14s %12s\n", "kernel", "packets", "ns/recovery",
+           "MB/s in");
+
+    for (n = 0; n < sizeof(s_bench_num_srcs) / sizeof(s_bench_num_srcs[0]);
+         n++) {
+        (void)vqec_fec_xor_set_impl(VQEC_FEC_XOR_IMPL_SCALAR);
+        vqec_fec_xor_blocks(ref, srcs, s_bench_num_srcs[n], payload);
+
+        for (impl = 0; impl < VQEC_FEC_XOR_IMPL_NUM; impl++) {
+            if (!vqec_fec_xor_set_impl(impl)) {
+                continue;
+            }
+
+            /* correctness against the scalar kernel */
+            vqec_fec_xor_blocks(out + 1, srcs, s_bench_num_srcs[n], payload);
+            if (memcmp(out + 1, ref, payload)) {
+                printf("%-8s %8u MISMATCH\n",
+                       vqec_fec_xor_impl_to_str(impl), s_bench_num_srcs[n]);
+                ok = FALSE;
+                continue;
+            }
+
+            start = bench_now_ns();
+            for (it = 0; it < iterations; it++) {
+                vqec_fec_xor_blocks(out + 1, srcs, s_bench_num_srcs[n],
+                                    payload);
+            }
+            elapsed = bench_now_ns() - start;
+
+            ns_per = (double)elapsed / iterations;
+            mbps = ((double)payload * s_bench_num_srcs[n] * iterations) /
+                ((double)elapsed / 1000.0);
+            printf("%-8s %8u %14.1f %12.1f\n",
+                   vqec_fec_xor_impl_to_str(impl), s_bench_num_srcs[n],
+                   ns_per, mbps);
+        }
+    }
+
+    free(pool);
+    return (ok ? 0 : 1);
+}
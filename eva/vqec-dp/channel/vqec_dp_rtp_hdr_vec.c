@@ -0,0 +1,185 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_dp_rtp_hdr_vec.c - RTP header validation for packet vectors.
+ */
+
+#include "vqec_dp_rtp_hdr_vec.h"
+#include "vqec_dp_common.h"
+
+/*
+ * The SSE2 classifier is built with a per-function target attribute and
+ * selected at runtime, as are the FEC XOR kernels.
+ */
+#if !defined(__KERNEL__) && !defined(VQEC_DP_RTP_HDR_NO_SIMD)
+#if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define VQEC_DP_RTP_HDR_HAVE_X86 1
+#include <immintrin.h>
+#endif
+#endif /* !__KERNEL__ && !VQEC_DP_RTP_HDR_NO_SIMD */
+
+/*
+ * First byte of a plain header: version 2, any padding bit, no
+ * extension, no CSRCs.
+ */
+#define VQEC_DP_RTP_HDR_PLAIN_MASK 0xdf
+#define VQEC_DP_RTP_HDR_PLAIN_BITS 0x80
+
+typedef uint64_t (*vqec_dp_rtp_hdr_classify_fn_t)(const uint8_t *b0,
+                                                  const uint16_t *len,
+                                                  uint32_t n);
+
+/**
+ * Portable classifier.
+ *
+ * @param[in] b0 First byte of each packet.
+ * @param[in] len Length of each packet.
+ * @param[in] n Number of packets, at most VQEC_DP_RTP_HDR_VEC_MAX.
+ * @param[out] uint64_t Mask of the packets with a plain header.
+ */
+static uint64_t
+vqec_dp_rtp_hdr_classify_scalar (const uint8_t *b0,
+                                 const uint16_t *len,
+                                 uint32_t n)
+{
+    uint64_t plain = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (((b0[i] & VQEC_DP_RTP_HDR_PLAIN_MASK) ==
+             VQEC_DP_RTP_HDR_PLAIN_BITS) &&
+            (len[i] >= MINRTPHEADERBYTES)) {
+            plain |= 1ULL << i;
+        }
+    }
+
+    return (plain);
+}
+
+#ifdef VQEC_DP_RTP_HDR_HAVE_X86
+/**
+ * SSE2 classifier: 16 packets per iteration, then scalar.
+ */
+__attribute__((target("sse2"))) static uint64_t
+vqec_dp_rtp_hdr_classify_sse2 (const uint8_t *b0,
+                               const uint16_t *len,
+                               uint32_t n)
+{
+    const __m128i vmask = _mm_set1_epi8((char)VQEC_DP_RTP_HDR_PLAIN_MASK);
+    const __m128i vbits = _mm_set1_epi8((char)VQEC_DP_RTP_HDR_PLAIN_BITS);
+    const __m128i vmin = _mm_set1_epi16(MINRTPHEADERBYTES);
+    const __m128i vzero = _mm_setzero_si128();
+    __m128i ok_b0, ok_lo, ok_hi;
+    uint64_t plain = 0;
+    uint32_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        ok_b0 = _mm_cmpeq_epi8(
+            _mm_and_si128(_mm_loadu_si128((const __m128i *)(b0 + i)), vmask),
+            vbits);
+        /* len >= MINRTPHEADERBYTES iff (MINRTPHEADERBYTES - len) saturates */
+        ok_lo = _mm_cmpeq_epi16(
+            _mm_subs_epu16(vmin,
+                           _mm_loadu_si128((const __m128i *)(len + i))),
+            vzero);
+        ok_hi = _mm_cmpeq_epi16(
+            _mm_subs_epu16(vmin,
+                           _mm_loadu_si128((const __m128i *)(len + i + 8))),
+            vzero);
+        plain |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+            _mm_and_si128(ok_b0, _mm_packs_epi16(ok_lo, ok_hi))) << i;
+    }
+
+    if (i < n) {
+        plain |= vqec_dp_rtp_hdr_classify_scalar(b0 + i, len + i, n - i) << i;
+    }
+
+    return (plain);
+}
+#endif /* VQEC_DP_RTP_HDR_HAVE_X86 */
+
+static vqec_dp_rtp_hdr_classify_fn_t s_vqec_dp_rtp_hdr_classify_fn =
+    vqec_dp_rtp_hdr_classify_scalar;
+
+/**
+ * Select the packet classifier supported by the running CPU.
+ */
+void
+vqec_dp_rtp_hdr_vec_init (void)
+{
+    s_vqec_dp_rtp_hdr_classify_fn = vqec_dp_rtp_hdr_classify_scalar;
+
+#ifdef VQEC_DP_RTP_HDR_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        s_vqec_dp_rtp_hdr_classify_fn = vqec_dp_rtp_hdr_classify_sse2;
+    }
+#endif /* VQEC_DP_RTP_HDR_HAVE_X86 */
+}
+
+/**
+ * Validate the RTP headers of a packet vector.
+ */
+uint64_t
+vqec_dp_rtp_hdr_validate_vec (rtp_hdr_session_t *session,
+                              vqec_pak_t *pak_array[],
+                              uint32_t array_len,
+                              vqec_dp_rtp_hdr_fields_t *fields)
+{
+    uint8_t b0[VQEC_DP_RTP_HDR_VEC_MAX];
+    uint16_t len[VQEC_DP_RTP_HDR_VEC_MAX];
+    uint64_t plain, bad = 0;
+    rtpfasttype_t *rtp;
+    vqec_pak_t *pak;
+    uint32_t i, hdr_len;
+
+    VQEC_DP_ASSERT_FATAL(session && pak_array, __FUNCTION__);
+    VQEC_DP_ASSERT_FATAL(array_len <= VQEC_DP_RTP_HDR_VEC_MAX,
+                         __FUNCTION__);
+    if (!array_len) {
+        return (0);
+    }
+
+    /*
+     * Gather the first byte and the length of every packet; the first
+     * byte is always within the packet buffer, even for an empty packet.
+     * Lengths are truncated to 16 bits as for rtp_validate_hdr().
+     */
+    for (i = 0; i < array_len; i++) {
+        pak = pak_array[i];
+        pak->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+        b0[i] = *(uint8_t *)pak->rtp;
+        len[i] = (uint16_t)vqec_pak_get_content_len(pak);
+    }
+
+    plain = (*s_vqec_dp_rtp_hdr_classify_fn)(b0, len, array_len);
+
+    for (i = 0; i < array_len; i++) {
+        pak = pak_array[i];
+        rtp = pak->rtp;
+        if (plain & (1ULL << i)) {
+            hdr_len = MINRTPHEADERBYTES;
+        } else if (rtp_hdr_ok(rtp_validate_hdr(session,
+                                               (char *)rtp, len[i]))) {
+            hdr_len = RTPHEADERBYTES(rtp);
+        } else {
+            bad |= 1ULL << i;
+            continue;
+        }
+
+        pak->mpeg_payload_offset = hdr_len;
+        pak->rtp_ts = ntohl(rtp->timestamp);
+        if (fields) {
+            fields[i].ssrc = ntohl(rtp->ssrc);
+        }
+    }
+
+    return (bad);
+}
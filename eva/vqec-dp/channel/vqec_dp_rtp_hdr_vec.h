@@ -0,0 +1,72 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_dp_rtp_hdr_vec.h - RTP header validation for packet vectors.
+ *
+ * The checks are those of rtp_validate_hdr(): minimum length, version,
+ * and the consistency of the packet length with the CSRC count and the
+ * extension header. A packet vector is validated in two passes: first
+ * every packet is classified as a plain 12-byte header (version 2, no
+ * CSRCs, no extension, long enough), which is the common case and is
+ * done several packets at a time where SIMD is available; then the
+ * header fields are extracted, and the remaining packets take the full
+ * scalar checks. Session error counters are updated as
+ * rtp_validate_hdr() updates them.
+ *
+ * The vector kernels are only built for user-space dataplane builds.
+ */
+
+#ifndef __VQEC_DP_RTP_HDR_VEC_H__
+#define __VQEC_DP_RTP_HDR_VEC_H__
+
+#include "vqec_dp_api_types.h"
+#include "vqec_pak.h"
+
+/**
+ * Largest vector that can be validated in one call; one bit of the
+ * returned mask per packet.
+ */
+#define VQEC_DP_RTP_HDR_VEC_MAX 64
+
+/**
+ * Header fields which are not stored in the packet.
+ */
+typedef struct vqec_dp_rtp_hdr_fields_
+{
+    uint32_t ssrc;              /* host order */
+} vqec_dp_rtp_hdr_fields_t;
+
+/**
+ * Select the packet classifier supported by the running CPU. It is safe
+ * to call this function more than once.
+ */
+void vqec_dp_rtp_hdr_vec_init(void);
+
+/**
+ * Validate the RTP headers of a packet vector. For every packet, the
+ * rtp pointer is set to the head of the packet; for every packet with a
+ * valid header, rtp_ts and mpeg_payload_offset are filled in, as are
+ * the SSRC in fields if it is supplied.
+ *
+ * @param[in] session Session statistics, updated for invalid headers.
+ * @param[in] pak_array Packet vector.
+ * @param[in] array_len Length of the vector, at most
+ * VQEC_DP_RTP_HDR_VEC_MAX.
+ * @param[out] fields (optional) array_len entries, filled in for
+ * packets with a valid header.
+ * @param[out] uint64_t Mask of the packets whose header is not a valid
+ * RTP header (bit i for pak_array[i]); such packets may be STUN.
+ */
+uint64_t
+vqec_dp_rtp_hdr_validate_vec(rtp_hdr_session_t *session,
+                             vqec_pak_t *pak_array[],
+                             uint32_t array_len,
+                             vqec_dp_rtp_hdr_fields_t *fields);
+
+#endif /* __VQEC_DP_RTP_HDR_VEC_H__ */
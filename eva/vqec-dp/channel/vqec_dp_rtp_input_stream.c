@@ -16,6 +16,7 @@
  *****************************************************************************/
 
 #include "vqec_dp_rtp_input_stream.h"
+#include "vqec_dp_rtp_hdr_vec.h"
 #include "vqec_pak.h"
 #include "vqec_dpchan.h"
 #include "vqec_dp_tlm.h"
@@ -29,6 +30,10 @@
 #include <eva/vqec_channel_private.h>
 #include <eva/vqec_rtp.h>
 
+#if VQEC_DP_STREAM_PUSH_VECTOR_PAKS_MAX > VQEC_DP_RTP_HDR_VEC_MAX
+#error "Primary packet vectors must fit in a RTP header validation mask"
+#endif
+
 #define VQEC_DP_RTP_IS_IDTABLE_ID_BASE (0xA0000000)
 #define VQEC_DP_RTP_IS_IDTABLE_NUM_IDS (s_id_table.total_ids)
 #define VQEC_DP_RTP_IS_IDTABLE_IDS_PER_BLOCK \
@@ -766,11 +771,14 @@ vqec_dp_chan_rtp_primary_input_stream_rcv_vec (
     uint32_t array_len,
     abs_time_t current_time)
 {
-    uint32_t rtp_drops = 0, wr = 0, i;
+    uint32_t rtp_drops = 0, wr = 0, rx = 0, i;
     vqec_pak_t *pak;
     vqec_dp_chan_rtp_input_stream_t *rtp_is;
     vqec_pak_t *l_pak_array[VQEC_DP_STREAM_PUSH_VECTOR_PAKS_MAX];
-    vqec_dp_rtp_src_t *rtp_src_entry, *rtp_src_entry_pktflow_permitted = NULL;
+    vqec_dp_rtp_hdr_fields_t fields[VQEC_DP_STREAM_PUSH_VECTOR_PAKS_MAX];
+    vqec_dp_rtp_src_t *rtp_src_entry = NULL;
+    vqec_dp_rtp_src_t *rtp_src_entry_pktflow_permitted = NULL;
+    uint64_t bad_hdrs;
     boolean drop;
 
     if (!in || !pak_array) {
@@ -800,15 +808,44 @@ vqec_dp_chan_rtp_primary_input_stream_rcv_vec (
             rtp_drops++;
             continue;
         }
+        l_pak_array[rx++] = pak;
+    }
+
+    /*
+     * Validate the RTP headers of the remaining packets in one pass, 
+     * which also extracts the header fields used below.
+     */
+    bad_hdrs = 
+        vqec_dp_rtp_hdr_validate_vec(&rtp_is->rtp_recv.session.sess_stats,
+                                     l_pak_array, rx, fields);
+
+    /*
+     * The packets for PCM insertion are compacted at the front of 
+     * l_pak_array; wr never passes i.
+     */
+    for (i = 0; i < rx; i++) {
+
+        pak = l_pak_array[i];
+
+        if (bad_hdrs & (1ULL << i)) {
+            /* Invalid header, or a STUN packet for the control plane. */
+            if (vqec_dp_chan_rtp_process_primary_invalid_pak(rtp_is, pak)) {
+                rtp_drops++;
+            }
+            continue;
+        }
         
         /*
          * Invoke rtp processing on the packet, which determines whether
          * the packet is acceptable for insertion into the PCM.
          * If the packet should be dropped, the appropriate RTP drop counter
          * is updated internally, and the "dropped" parameter is set to TRUE.
+         * The source of the previous packet is passed in, so that a run of
+         * packets from one source is resolved without a table lookup.
          */
-        if (vqec_dp_chan_rtp_process_primary_pak(rtp_is, pak, &drop,
-                                                 &rtp_src_entry)) {
+        if (vqec_dp_chan_rtp_process_primary_pak(rtp_is, pak, fields[i].ssrc,
+                                                 rtp_src_entry,
+                                                 &drop, &rtp_src_entry)) {
             /*
              * Packets which passed RTP processing (and were not 
              * dropped/queued) must be from a single RTP source.
@@ -2575,6 +2612,7 @@ vqec_dp_chan_rtp_module_init (vqec_dp_module_init_params_t *params)
     if (err != VQEC_DP_ERR_OK) {
         goto bail;
     }
+    vqec_dp_rtp_hdr_vec_init();
 
     vqec_dp_chan_rtp_primary_input_stream_set_fcns(&the_prim_is_func_table);
     vqec_dp_chan_rtp_input_stream_set_fcns(&the_fec_is_func_table);
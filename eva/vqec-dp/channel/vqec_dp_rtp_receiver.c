@@ -36,6 +36,15 @@ static rtcp_xr_stats_pool_t *s_xr_stats_pool = NULL;
 typedef struct vqe_zone post_er_stats_pool_t;
 static post_er_stats_pool_t *s_post_er_stats_pool;
 
+/**
+ * XR loss map pool. Maps are a large allocation, so there are only
+ * enough of them for two sources per stream; other sources build their
+ * RLE chunks packet by packet, as do all sources if the pool could not
+ * be created.
+ */
+typedef struct vqe_zone rtcp_xr_map_pool_t;
+static rtcp_xr_map_pool_t *s_xr_map_pool;
+
 #ifdef _VQEC_DP_UTEST
 #define UT_STATIC
 #else
@@ -64,6 +73,79 @@ static post_er_stats_pool_t *s_post_er_stats_pool;
  */
 
 
+/**---------------------------------------------------------------------------
+ * Hash bucket of a source (private scope).
+ *
+ * @param[in] ssrc SSRC, host order.
+ * @param[in] src_addr Source IP address, network order.
+ * @param[in] src_port Source UDP port, network order.
+ * @param[out] uint32_t Bucket index.
+ *---------------------------------------------------------------------------*/
+static inline uint32_t
+vqec_dp_rtp_src_hash (uint32_t ssrc, struct in_addr src_addr, 
+                      uint16_t src_port)
+{
+    uint32_t h;
+
+    h = ssrc ^ src_addr.s_addr ^ ((uint32_t)src_port << 16) ^ src_port;
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return (h & (VQEC_DP_RTP_SRC_HASH_BUCKETS - 1));
+}
+
+/**---------------------------------------------------------------------------
+ * Does a source entry match the given {SSRC, source IP, source port}
+ * (private scope).
+ *---------------------------------------------------------------------------*/
+static inline boolean
+vqec_dp_rtp_src_entry_match (vqec_dp_rtp_src_t *rtp_src_entry,
+                             uint32_t ssrc, 
+                             struct in_addr src_addr,
+                             uint16_t src_port)
+{
+    return ((rtp_src_entry->key.ssrc == ssrc) &&
+            (rtp_src_entry->key.ipv4.src_addr.s_addr == src_addr.s_addr) &&
+            (rtp_src_entry->key.ipv4.src_port == src_port));
+}
+
+/**---------------------------------------------------------------------------
+ * Look up an existing source entry by its {SSRC, source IP, source port},
+ * trying the last matched source first (private scope).
+ *
+ * @param[in] src_list Pointer to a RTP source list object.
+ * @param[in] ssrc SSRC, host order.
+ * @param[in] src_addr Source IP address, network order.
+ * @param[in] src_port Source UDP port, network order.
+ * @param[out] vqec_dp_rtp_src_t* Pointer to the retrieved src entry.
+ *---------------------------------------------------------------------------*/
+static inline vqec_dp_rtp_src_t *
+vqec_dp_rtp_src_entry_lookup_internal (vqec_dp_rtp_src_list_t *src_list,
+                                       uint32_t ssrc,
+                                       struct in_addr src_addr,
+                                       uint16_t src_port)
+{
+    vqec_dp_rtp_src_t *rtp_src_entry;
+
+    rtp_src_entry = src_list->last_hit;
+    if (rtp_src_entry &&
+        vqec_dp_rtp_src_entry_match(rtp_src_entry, ssrc, src_addr, src_port)) {
+        return (rtp_src_entry);
+    }
+
+    for (rtp_src_entry = 
+             src_list->hash[vqec_dp_rtp_src_hash(ssrc, src_addr, src_port)];
+         rtp_src_entry; 
+         rtp_src_entry = rtp_src_entry->hash_next) {
+        if (vqec_dp_rtp_src_entry_match(rtp_src_entry, 
+                                        ssrc, src_addr, src_port)) {
+            src_list->last_hit = rtp_src_entry;
+            break;
+        }
+    }
+
+    return (rtp_src_entry);
+}
+
 /**---------------------------------------------------------------------------
  * Get an existing source entry (private scope). 
  *
@@ -75,18 +157,44 @@ static vqec_dp_rtp_src_t *
 vqec_dp_rtp_src_entry_get_internal (vqec_dp_rtp_src_list_t *src_list,
                                     vqec_dp_rtp_src_key_t *key)
 {
-    vqec_dp_rtp_src_t *rtp_src_entry = NULL;
-    
-    VQE_TAILQ_FOREACH(rtp_src_entry, 
-                   &src_list->lh_known_sources, le_known_sources) {
-        if (memcmp(&rtp_src_entry->key, key, sizeof(*key)) == 0) {
-            break;
-        }
-    }
+    return (vqec_dp_rtp_src_entry_lookup_internal(src_list,
+                                                  key->ssrc,
+                                                  key->ipv4.src_addr,
+                                                  key->ipv4.src_port));
+}
 
-    return (rtp_src_entry);
+/**---------------------------------------------------------------------------
+ * Attach a loss map to XR stats, if one is available (private scope).
+ *
+ * @param[in] xr_stats Pointer to the XR stats, before they are initialized.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_dp_rtcp_xr_map_attach (rtcp_xr_stats_t *xr_stats)
+{
+    rtcp_xr_map_t *map;
+
+    if (!s_xr_map_pool) {
+        return;
+    }
+    map = (rtcp_xr_map_t *)zone_acquire(s_xr_map_pool);
+    if (map) {
+        rtcp_xr_map_attach(xr_stats, map);
+    }
 }
 
+/**---------------------------------------------------------------------------
+ * Release the loss map of XR stats, if any (private scope).
+ *
+ * @param[in] xr_stats Pointer to the XR stats.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_dp_rtcp_xr_map_detach (rtcp_xr_stats_t *xr_stats)
+{
+    if (xr_stats->map) {
+        zone_release(s_xr_map_pool, xr_stats->map);
+        xr_stats->map = NULL;
+    }
+}
 
 /**---------------------------------------------------------------------------
  * Create a new source entry (private scope).
@@ -111,6 +219,7 @@ vqec_dp_rtp_src_entry_create_internal (
 {
     vqec_dp_rtp_src_t *rtp_src_entry;
     abs_time_t cur_time;
+    uint32_t bucket;
 
     if (src_list->present >= VQEC_DP_RTP_MAX_KNOWN_SOURCES) {
         /* Too many sources for the receiver. */
@@ -155,6 +264,7 @@ vqec_dp_rtp_src_entry_create_internal (
                 memset(rtp_src_entry->xr_stats, 0, 
                        sizeof(*rtp_src_entry->xr_stats));
                 rtcp_xr_set_size(rtp_src_entry->xr_stats, max_xr_rle_size);
+                vqec_dp_rtcp_xr_map_attach(rtp_src_entry->xr_stats);
             }
         }
         if (max_post_er_rle_size) {
@@ -167,12 +277,19 @@ vqec_dp_rtp_src_entry_create_internal (
                        sizeof(*rtp_src_entry->post_er_stats));
                 rtcp_xr_set_size(&rtp_src_entry->post_er_stats->xr_stats, 
                                  max_post_er_rle_size);
+                vqec_dp_rtcp_xr_map_attach(
+                    &rtp_src_entry->post_er_stats->xr_stats);
             }
         }
 
         /* Put in RTP source table, at the tail of the queue. */
         VQE_TAILQ_INSERT_TAIL(&src_list->lh_known_sources, 
                           rtp_src_entry, le_known_sources);
+        bucket = vqec_dp_rtp_src_hash(key->ssrc, 
+                                      key->ipv4.src_addr, 
+                                      key->ipv4.src_port);
+        rtp_src_entry->hash_next = src_list->hash[bucket];
+        src_list->hash[bucket] = rtp_src_entry;
         src_list->present++;
         src_list->created++;
 
@@ -605,6 +722,7 @@ vqec_dp_rtp_src_entry_delete_internal (
     vqec_dp_rtp_src_t *rtp_src_entry)
 {
     vqec_dp_rtp_src_list_t *src_list;
+    vqec_dp_rtp_src_t **link;
     vqec_dp_error_t ret = VQEC_DP_ERR_OK;
 
     if (!rtp_recv || !rtp_src_entry) {
@@ -616,11 +734,27 @@ vqec_dp_rtp_src_entry_delete_internal (
     
     VQE_TAILQ_REMOVE(&src_list->lh_known_sources, 
                  rtp_src_entry, le_known_sources);
+    for (link = &src_list->hash[
+             vqec_dp_rtp_src_hash(rtp_src_entry->key.ssrc,
+                                  rtp_src_entry->key.ipv4.src_addr,
+                                  rtp_src_entry->key.ipv4.src_port)];
+         *link; 
+         link = &(*link)->hash_next) {
+        if (*link == rtp_src_entry) {
+            *link = rtp_src_entry->hash_next;
+            break;
+        }
+    }
+    if (src_list->last_hit == rtp_src_entry) {
+        src_list->last_hit = NULL;
+    }
     if (rtp_src_entry->xr_stats) {
+        vqec_dp_rtcp_xr_map_detach(rtp_src_entry->xr_stats);
         zone_release(s_xr_stats_pool, rtp_src_entry->xr_stats);
         rtp_src_entry->xr_stats = NULL;
     }
     if (rtp_src_entry->post_er_stats) {
+        vqec_dp_rtcp_xr_map_detach(&rtp_src_entry->post_er_stats->xr_stats);
         zone_release(s_post_er_stats_pool, rtp_src_entry->post_er_stats);
         rtp_src_entry->post_er_stats = NULL;
     }
@@ -924,6 +1058,35 @@ vqec_dp_rtp_src_get_table (vqec_dp_chan_rtp_input_stream_t *in,
 }
 
 
+/**---------------------------------------------------------------------------
+ * Get the RTP statistics of the source which has packet-flow enabled on
+ * an input stream.  Only primary sessions have such a source, and they
+ * have at most one.
+ *
+ * @param[in] in Pointer to an RTP input stream.
+ * @param[out] rtp_hdr_source_t* Statistics of the packet-flow source, or
+ * NULL if no source has packet-flow enabled.
+ *---------------------------------------------------------------------------*/
+const rtp_hdr_source_t *
+vqec_dp_rtp_src_get_pktflow_stats (vqec_dp_chan_rtp_input_stream_t *in)
+{
+    vqec_dp_rtp_src_t *rtp_src_entry;
+
+    if (!in) {
+        return (NULL);
+    }
+
+    VQE_TAILQ_FOREACH(rtp_src_entry, 
+                      &in->rtp_recv.src_list.lh_known_sources,
+                      le_known_sources) {
+        if (rtp_src_entry->info.pktflow_permitted) {
+            return (&rtp_src_entry->info.src_stats);
+        }
+    }
+    return (NULL);
+}
+
+
 /**---------------------------------------------------------------------------
  * Promote a particular source as a packet-flow source. The method is called
  * for primary sessions only. For primary sessions, only one source at any
@@ -1229,12 +1392,17 @@ vqec_dp_rtp_src_get_info (vqec_dp_chan_rtp_input_stream_t *in,
         }
 
         if (xr_stats && rtp_src_entry->xr_stats) {
+            /* Build the RLE chunks if the source has a loss map */
+            rtcp_xr_map_encode(rtp_src_entry->xr_stats);
             memcpy(xr_stats, rtp_src_entry->xr_stats, sizeof(*xr_stats));
+            xr_stats->map = NULL;
         }
 
         if (post_er_stats && rtp_src_entry->post_er_stats) {
+            rtcp_xr_map_encode(&rtp_src_entry->post_er_stats->xr_stats);
             memcpy(post_er_stats, rtp_src_entry->post_er_stats, 
                    sizeof(*post_er_stats));
+            post_er_stats->xr_stats.map = NULL;
         }
 
         if (update_prior) {
@@ -1839,10 +2007,16 @@ vqec_dp_chan_process_rtp_pak_csrc_update (
  * source that may be used upon failover, VQE will enqueue it internally
  * and returns false.
  * NOTE: It is assumed that both the primary stream and packet input
- * pointers are null-checked prior to invoking this function.
+ * pointers are null-checked prior to invoking this function, and that
+ * the packet's RTP header has been validated and its fields filled in
+ * by vqec_dp_rtp_hdr_validate_vec().
  *
  * @param[in] in Pointer to the rtp input stream.
  * @param[in] pak Pointer to a RTP packet.
+ * @param[in] ssrc SSRC of the packet, host order.
+ * @param[in] run_src (optional) Source of the previous packet of a
+ * vector; it is checked first, so that a run of packets from the same
+ * source resolves the source without a table lookup.
  * @param[in] drop (optional) Set to TRUE if a drop should be counted
  * on the input stream object, FALSE otherwise
  * @param[out] pak_rtp_src_entry (optional) If supplied and the function 
@@ -1854,18 +2028,17 @@ boolean
 vqec_dp_chan_rtp_process_primary_pak (
     vqec_dp_chan_rtp_input_stream_t *in, 
     vqec_pak_t *pak,
+    uint32_t ssrc,
+    vqec_dp_rtp_src_t *run_src,
     boolean *drop,
     vqec_dp_rtp_src_t **pak_rtp_src_entry)
 {
     vqec_dp_rtp_recv_t *rtp_recv;
     vqec_pak_t *oldest_pak;
-    rtptype *rtp_pak;
     vqec_dp_rtp_src_key_t key;
-    rtp_hdr_status_t rtp_status;
     vqec_dp_rtp_src_t *rtp_src_entry = NULL;
     vqec_dp_chan_rtp_primary_input_stream_t *primary_is;
     boolean pcm_insert = FALSE, dropped_pak = FALSE;
-    vqec_dp_error_t err = VQEC_DP_ERR_OK;
     
     
     VQEC_DP_ASSERT_FATAL(in != NULL, __FUNCTION__);
@@ -1874,43 +2047,28 @@ vqec_dp_chan_rtp_process_primary_pak (
     rtp_recv = &in->rtp_recv; 
     primary_is = (vqec_dp_chan_rtp_primary_input_stream_t *)in; 
 
-    rtp_status = rtp_validate_hdr(&rtp_recv->session.sess_stats,
-                                  vqec_pak_get_head_ptr(pak),
-                                  vqec_pak_get_content_len(pak));
-    if (!rtp_hdr_ok(rtp_status)) {
-        /* Check for stun packet: punt to control plane. */
-        if ((vqec_pak_get_head_ptr(pak)[0] & 0xC0) == 0) {
-            err = vqec_dpchan_eject_pak(in->chan, in->id, pak);
-            if (err == VQEC_DP_ERR_OK) {
-                VQEC_DP_TLM_CNT(input_stream_eject_paks, vqec_dp_tlm_get());
-            } else {
-                VQEC_DP_TLM_CNT(input_stream_eject_paks_failure, 
-                                vqec_dp_tlm_get());
-            }
-            pcm_insert = FALSE;
-            goto done;
-        }
-        in->rtp_in_stats.rtp_parse_drops++;
-        dropped_pak = TRUE;
-        goto done;
-    }
-
     in->rtp_in_stats.rtp_paks++;
-    pak->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
     
     /*
      * Search for an existing rtp source entry. 
      */
-    rtp_pak = (rtptype *) pak->rtp;    
-    memset(&key, 0, sizeof(vqec_dp_rtp_src_key_t));
-    key.ssrc = ntohl(rtp_pak->ssrc);
-    memcpy(&key.ipv4.src_addr, &pak->src_addr, sizeof(struct in_addr));
-    key.ipv4.src_port = pak->src_port;
-    rtp_src_entry = 
-        vqec_dp_rtp_src_entry_get_internal(&rtp_recv->src_list, &key);
+    if (run_src && 
+        vqec_dp_rtp_src_entry_match(run_src, ssrc, 
+                                    pak->src_addr, pak->src_port)) {
+        rtp_src_entry = run_src;
+    } else {
+        rtp_src_entry = 
+            vqec_dp_rtp_src_entry_lookup_internal(&rtp_recv->src_list, ssrc,
+                                                  pak->src_addr, 
+                                                  pak->src_port);
+    }
 
     if (!rtp_src_entry) {
         /* Build a new RTP source entry. */
+        memset(&key, 0, sizeof(vqec_dp_rtp_src_key_t));
+        key.ssrc = ssrc;
+        memcpy(&key.ipv4.src_addr, &pak->src_addr, sizeof(struct in_addr));
+        key.ipv4.src_port = pak->src_port;
         rtp_src_entry = 
             vqec_dp_rtp_src_entry_create_internal(
                 &rtp_recv->src_list, &key,
@@ -2023,6 +2181,41 @@ done:
     return (pcm_insert);
 }
 
+/**---------------------------------------------------------------------------
+ * Processing for a packet of the primary input stream whose RTP header
+ * failed validation: STUN packets are punted to the control plane, and
+ * other packets are counted as parse drops.
+ *
+ * @param[in] in Pointer to the rtp input stream.
+ * @param[in] pak Pointer to the packet.
+ * @param[out] boolean Returns TRUE if a drop should be counted on the
+ * input stream object.
+ *---------------------------------------------------------------------------*/
+boolean
+vqec_dp_chan_rtp_process_primary_invalid_pak (
+    vqec_dp_chan_rtp_input_stream_t *in, 
+    vqec_pak_t *pak)
+{
+    vqec_dp_error_t err;
+
+    VQEC_DP_ASSERT_FATAL(in != NULL, __FUNCTION__);
+    VQEC_DP_ASSERT_FATAL(pak != NULL, __FUNCTION__);
+
+    /* Check for stun packet: punt to control plane. */
+    if ((vqec_pak_get_head_ptr(pak)[0] & 0xC0) == 0) {
+        err = vqec_dpchan_eject_pak(in->chan, in->id, pak);
+        if (err == VQEC_DP_ERR_OK) {
+            VQEC_DP_TLM_CNT(input_stream_eject_paks, vqec_dp_tlm_get());
+        } else {
+            VQEC_DP_TLM_CNT(input_stream_eject_paks_failure, 
+                            vqec_dp_tlm_get());
+        }
+        return (FALSE);
+    }
+    in->rtp_in_stats.rtp_parse_drops++;
+    return (TRUE);
+}
+
 /*
  * Defines the largest batch of primary packets processed at once,
  * which is the larger of
@@ -2103,7 +2296,7 @@ vqec_dp_chan_rtp_process_primary_paks_and_insert_to_pcm (
         /* Update the jitter estimate. */
         rtp_update_jitter(&rtp_src_entry->info.src_stats,
                           rtcp_xr_stats,
-                          ntohl(rtp_pak->timestamp),
+                          pak->rtp_ts,
                           rtp_update_timestamps(&rtp_src_entry->info.src_stats,
                                                 pak->rcv_ts));
         event = rtp_hdr_event(rtp_status);
@@ -2114,8 +2307,10 @@ vqec_dp_chan_rtp_process_primary_paks_and_insert_to_pcm (
              */
         }
         
-        pak->mpeg_payload_offset = RTPHEADERBYTES(pak->rtp);
-        pak->rtp_ts = ntohl(rtp_pak->timestamp);        
+        /*
+         * rtp_ts and mpeg_payload_offset were filled in when the header 
+         * was validated.
+         */
         pak->type = VQEC_PAK_TYPE_PRIMARY; 
         VQEC_PAK_FLAGS_RESET(&pak->flags, VQEC_PAK_FLAGS_AFTER_EC);
 
@@ -2200,6 +2395,7 @@ vqec_dp_chan_rtp_process_repair_pak (
     vqec_dp_rtp_recv_t *rtp_recv;
     rtptype *rtp_pak;
     vqec_dp_rtp_src_key_t key;
+    uint32_t ssrc;
     rtp_hdr_status_t rtp_status;
     rtp_event_t event;
     vqec_dp_rtp_src_t *rtp_src_entry, *rtp_src_entry_primary = NULL;
@@ -2227,23 +2423,25 @@ vqec_dp_chan_rtp_process_repair_pak (
      * drop the packet. This is done prior to src entry lookup.
      */
     rtp_pak = (rtptype *) pak->rtp;    
-    memset(&key, 0, sizeof(vqec_dp_rtp_src_key_t));
-    key.ssrc = ntohl(rtp_pak->ssrc);
-    memcpy(&key.ipv4.src_addr, &pak->src_addr, sizeof(struct in_addr));
-    key.ipv4.src_port = pak->src_port;
+    ssrc = ntohl(rtp_pak->ssrc);
 
     if (rtp_recv->filter.enable && 
-        rtp_recv->filter.ssrc != key.ssrc) {  
+        rtp_recv->filter.ssrc != ssrc) {  
         rtp_recv->filter.drops++;
         VQEC_DP_TLM_CNT(ssrc_filter_drops, vqec_dp_tlm_get());
         return (FALSE);
     }
 
     rtp_src_entry = 
-        vqec_dp_rtp_src_entry_get_internal(&rtp_recv->src_list, &key);
+        vqec_dp_rtp_src_entry_lookup_internal(&rtp_recv->src_list, ssrc,
+                                              pak->src_addr, pak->src_port);
     if (!rtp_src_entry) {
 
         /* Build a new RTP source entry. */
+        memset(&key, 0, sizeof(vqec_dp_rtp_src_key_t));
+        key.ssrc = ssrc;
+        memcpy(&key.ipv4.src_addr, &pak->src_addr, sizeof(struct in_addr));
+        key.ipv4.src_port = pak->src_port;
         rtp_src_entry = 
             vqec_dp_rtp_src_entry_create_internal(
                 &rtp_recv->src_list, &key, 
@@ -2437,16 +2635,24 @@ vqec_dp_chan_rtp_process_post_repair_pak (
 {
     vqec_dp_rtp_src_t *rtp_src_entry = NULL;
     rtcp_xr_post_rpr_stats_t *post_er_stats = NULL;
+    uint32_t ssrc;
 
     VQEC_DP_ASSERT_FATAL(in != NULL, __FUNCTION__);
     VQEC_DP_ASSERT_FATAL(pak != NULL, __FUNCTION__);
 
-    /* Lookup the primary source to which this packet corresponds */
-    VQE_TAILQ_FOREACH(rtp_src_entry, 
-                      &in->rtp_recv.src_list.lh_known_sources, 
-                      le_known_sources) {
-        if (rtp_src_entry->key.ssrc == ntohl(pak->rtp->ssrc)) {
-            break;
+    /*
+     * Lookup the primary source to which this packet corresponds; it is
+     * almost always the packetflow source.
+     */
+    ssrc = ntohl(pak->rtp->ssrc);
+    rtp_src_entry = in->rtp_recv.src_list.pktflow_src;
+    if (!rtp_src_entry || rtp_src_entry->key.ssrc != ssrc) {
+        VQE_TAILQ_FOREACH(rtp_src_entry, 
+                          &in->rtp_recv.src_list.lh_known_sources, 
+                          le_known_sources) {
+            if (rtp_src_entry->key.ssrc == ssrc) {
+                break;
+            }
         }
     }
         
@@ -2529,6 +2735,37 @@ vqec_dp_rtcp_post_er_stats_pool_create (uint32_t pool_size)
         NULL, NULL);
 }
 
+/**---------------------------------------------------------------------------
+ * Create an XR loss map pool.
+ * 
+ * @param[in] pool_size maximum number of loss maps
+ * @param[out] rtcp_xr_map_pool_t* point to loss map pool.
+ *---------------------------------------------------------------------------*/
+static rtcp_xr_map_pool_t *
+vqec_dp_rtcp_xr_map_pool_create (uint32_t pool_size)
+{
+    int flags = O_CREAT;
+    return zone_instance_get_loc(
+        "rtcp_xr_map",
+        flags,
+        sizeof(rtcp_xr_map_t),
+        pool_size,
+        NULL, NULL);
+}
+
+/**---------------------------------------------------------------------------
+ * Destroy the XR loss map pool.
+ *
+ * @param[in] pool Pointer to the pool.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_dp_rtcp_xr_map_pool_destroy (rtcp_xr_map_pool_t *pool)
+{
+    if (pool) {
+        (void)zone_instance_put(pool);
+    }
+}
+
 /**---------------------------------------------------------------------------
  * Destroy the RTP source pool.
  *
@@ -2680,6 +2917,11 @@ vqec_dp_rtp_receiver_module_init (vqec_dp_module_init_params_t *params)
         goto done;
     }
 
+    /* Not fatal: without maps, XR stats are encoded packet by packet */
+    s_xr_map_pool = 
+        vqec_dp_rtcp_xr_map_pool_create(
+            2 * params->max_channels * params->max_streams_per_channel);
+
 done:
     if (err != VQEC_DP_ERR_OK &&
         err != VQEC_DP_ERR_ALREADY_INITIALIZED) {
@@ -2701,4 +2943,6 @@ vqec_dp_rtp_receiver_module_deinit (void)
     s_xr_stats_pool = NULL;
     vqec_dp_rtcp_post_er_stats_pool_destroy(s_post_er_stats_pool);
     s_post_er_stats_pool = NULL;
+    vqec_dp_rtcp_xr_map_pool_destroy(s_xr_map_pool);
+    s_xr_map_pool = NULL;
 }
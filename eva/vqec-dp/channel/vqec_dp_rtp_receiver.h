@@ -60,10 +60,20 @@ struct vqec_dp_rtp_src_
      * Thread the source into a per receiver source list.
      */
     VQE_TAILQ_ENTRY(vqec_dp_rtp_src_) le_known_sources;
+    /**
+     * Next source in the same bucket of the per receiver source hash.
+     */
+    struct vqec_dp_rtp_src_ *hash_next;
                                  
 } vqec_dp_rtp_src_t;
 
 
+/**
+ * Number of buckets in the per receiver source hash (a power of 2). There
+ * are at most VQEC_DP_RTP_MAX_KNOWN_SOURCES sources per receiver.
+ */
+#define VQEC_DP_RTP_SRC_HASH_BUCKETS 8
+
 /**
  * List of all sources known / accepted for a particular RTP receiver.
  */
@@ -93,6 +103,15 @@ struct vqec_dp_rtp_src_list_
      * optimization and not a necessity).
      */         
     vqec_dp_rtp_src_t *pktflow_src;
+    /**
+     * Sources hashed on {SSRC, source IP address, source port}, for the
+     * per-packet lookups.
+     */
+    vqec_dp_rtp_src_t *hash[VQEC_DP_RTP_SRC_HASH_BUCKETS];
+    /**
+     * Source matched by the last lookup, checked before the hash.
+     */
+    vqec_dp_rtp_src_t *last_hit;
 
 } vqec_dp_rtp_src_list_t;
 
@@ -197,12 +216,20 @@ vqec_dp_chan_rtp_process_failoverq(
  * source that may be used upon failover, VQE will enqueue it internally
  * and returns false.
  * NOTE: It is assumed that both the primary stream and packet input
- * pointers are null-checked prior to invoking this function.
+ * pointers are null-checked prior to invoking this function, and that
+ * the packet's RTP header has been validated and its fields filled in
+ * by vqec_dp_rtp_hdr_validate_vec().
  *
  * @param[in] in Pointer to the rtp input stream.
  * @param[in] pak Pointer to a RTP packet.
- * @param[out] pak_rtp_src_entry (optional) If supplied and the function 
- * returns TRUE, this points to the packet's RTP source entry
+ * @param[in] ssrc SSRC of the packet, host order.
+ * @param[in] run_src (optional) Source of the previous packet of the same
+ * vector; it is tried before the source table is searched, so that a run
+ * of packets from one source is resolved with a single lookup.
+ * @param[out] drop (optional) Set to TRUE if a drop should be counted
+ * on the input stream object, FALSE otherwise
+ * @param[out] pak_rtp_src_entry (optional) If supplied, this points to
+ * the packet's RTP source entry, or is NULL if the packet has no source.
  * @param[out] boolean Returns true if the packet should be delivered
  * to the next cache element.
  */
@@ -210,9 +237,26 @@ boolean
 vqec_dp_chan_rtp_process_primary_pak(
     struct vqec_dp_chan_rtp_input_stream_ *in, 
     struct vqec_pak_ *pak,
+    uint32_t ssrc,
+    vqec_dp_rtp_src_t *run_src,
     boolean *drop,
     vqec_dp_rtp_src_t **pak_rtp_src_entry);
 
+/**
+ * Processing for a packet of the primary input stream whose RTP header
+ * failed validation: STUN packets are punted to the control plane, and
+ * other packets are counted as parse drops.
+ *
+ * @param[in] in Pointer to the rtp input stream.
+ * @param[in] pak Pointer to the packet.
+ * @param[out] boolean Returns TRUE if a drop should be counted on the
+ * input stream object.
+ */
+boolean
+vqec_dp_chan_rtp_process_primary_invalid_pak(
+    struct vqec_dp_chan_rtp_input_stream_ *in, 
+    struct vqec_pak_ *pak);
+
 /**---------------------------------------------------------------------------
  * RTP-specific processing for packets of the primary input stream
  * from a single RTP source (SSRC, source IP, source port).
@@ -324,6 +368,17 @@ vqec_dp_rtp_src_entry_get_next(struct vqec_dp_chan_rtp_input_stream_ *in,
                                vqec_dp_rtp_src_key_t *cur, 
                                vqec_dp_rtp_src_key_t *next_key);
 
+/**
+ * Get the RTP statistics of the source which has packet-flow enabled on
+ * an input stream, if there is one.
+ *
+ * @param[in] in Pointer to an RTP input stream.
+ * @param[out] rtp_hdr_source_t* Statistics of the packet-flow source, or
+ * NULL if no source has packet-flow enabled.
+ */
+const rtp_hdr_source_t *
+vqec_dp_rtp_src_get_pktflow_stats(struct vqec_dp_chan_rtp_input_stream_ *in);
+
 
 /**
  * Method which will scan a single RTP input stream's RTP receivers, and 
@@ -472,6 +472,8 @@ vqec_dp_sm_activity_timer_handler (const vqec_event_t * const evptr,
  * @param[in] event Double indirection pointer to the timer event.
  * be destroyed.
  * @param[in] handler Handler which will be called when the timer expires.
+ * @param[in] handler_name Name of the handler, under which the timer
+ * is profiled.
  * @param[in] timeout Timeout period.
  * @param[in] fcn_name The function name that invoked this method
  * (for debug).
@@ -483,6 +485,7 @@ vqec_dp_sm_timer_start (vqec_dpchan_t *chan,
                         vqec_event_t **event, 
                         void (handler)(const vqec_event_t * const, int32_t, 
                                        int16_t, void *),
+                        const char *handler_name,
                         rel_time_t timeout,                         
                         const char *fcn_name) 
 {    
@@ -491,12 +494,13 @@ vqec_dp_sm_timer_start (vqec_dpchan_t *chan,
     tv = rel_time_to_timeval(timeout);
 
     VQEC_DP_ASSERT_FATAL(!(*event), "%s", __FUNCTION__);
-    if (!vqec_event_create(event, 
-                           VQEC_EVTYPE_TIMER,
-                           VQEC_EV_ONESHOT,
-                           handler, 
-                           VQEC_EVDESC_TIMER,
-                           chan) ||
+    if (!vqec_event_create_named(event, 
+                                 VQEC_EVTYPE_TIMER,
+                                 VQEC_EV_ONESHOT,
+                                 handler, 
+                                 VQEC_EVDESC_TIMER,
+                                 chan,
+                                 handler_name) ||
         !vqec_event_start(*event, &tv)) {
         vqec_event_destroy(event);
 
@@ -549,6 +553,7 @@ vqec_dp_sm_waitfirst_timer_start (vqec_dpchan_t *chan,
         vqec_dp_sm_timer_start(chan, 
                                &chan->wait_first_timer,
                                vqec_dp_sm_waitfirst_timeout_handler,
+                               "vqec_dp_sm_waitfirst_timeout_handler",
                                timeout,
                                __FUNCTION__);
 
@@ -586,6 +591,7 @@ vqec_dp_sm_join_timer_start (vqec_dpchan_t *chan,
         vqec_dp_sm_timer_start(chan, 
                                &chan->join_timer,
                                vqec_dp_sm_join_timeout_handler,
+                               "vqec_dp_sm_join_timeout_handler",
                                timeout,
                                __FUNCTION__);
 
@@ -625,6 +631,7 @@ vqec_dp_sm_er_timer_start (vqec_dpchan_t *chan,
         vqec_dp_sm_timer_start(chan, 
                                &chan->er_timer,
                                vqec_dp_sm_er_timeout_handler,  
+                               "vqec_dp_sm_er_timeout_handler",
                                timeout,
                                __FUNCTION__);
 
@@ -662,6 +669,7 @@ vqec_dp_sm_waitburst_timer_start (vqec_dpchan_t *chan,
         vqec_dp_sm_timer_start(chan, 
                                &chan->burst_end_timer,
                                vqec_dp_sm_waitburst_timeout_handler, 
+                               "vqec_dp_sm_waitburst_timeout_handler",
                                timeout,
                                __FUNCTION__);
 
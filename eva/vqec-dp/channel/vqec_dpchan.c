@@ -1751,6 +1751,105 @@ vqec_dp_chan_hist_outputsched_is_enabled (boolean *enabled)
     return (VQEC_DP_ERR_INVALIDARGS);
 }
 
+static int32_t
+s_latency_ranges[] = VQEC_DP_LATENCY_HIST_RANGES;
+static const uint32_t
+s_latency_num_ranges = sizeof(s_latency_ranges)/sizeof(s_latency_ranges[0]);
+static char *
+s_latency_titles[VQEC_DPCHAN_LATENCY_STAGES][VQEC_DP_LATENCY_CLASS_MAX] = {
+    {"Network to PCM, primary packets (in usec)",
+     "Network to PCM, repair packets (in usec)",
+     "Network to PCM, FEC-recovered packets (in usec)"},
+    {"PCM residence, primary packets (in usec)",
+     "PCM residence, repair packets (in usec)",
+     "PCM residence, FEC-recovered packets (in usec)"}
+};
+
+/**
+ * Initialize the packet latency histograms of a channel.
+ *
+ * @param[in] chan Pointer to the channel.
+ */
+static void
+vqec_dpchan_latency_hist_init (vqec_dpchan_t *chan)
+{
+    int stage, cls;
+
+    for (stage = 0; stage < VQEC_DPCHAN_LATENCY_STAGES; stage++) {
+        for (cls = 0; cls < VQEC_DP_LATENCY_CLASS_MAX; cls++) {
+            (void)vam_hist_create_ranges(
+                (vam_hist_type_t *)&chan->latency_hist[stage][cls],
+                s_latency_ranges,
+                s_latency_num_ranges,
+                s_latency_titles[stage][cls]);
+        }
+    }
+}
+
+/**
+ * Gets a snapshot of a channel's packet latency histogram.
+ *
+ * @param[in]  chanid             - channel identifier
+ * @param[in]  stage              - latency stage; sink residence is kept
+ *                                  by the output shim
+ * @param[in]  cls                - class of packets
+ * @param[out] hist_ptr           - buffer into which histogram is copied
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+vqec_dp_error_t
+vqec_dp_chan_latency_hist_get (vqec_dp_chanid_t chanid,
+                               vqec_dp_latency_stage_t stage,
+                               vqec_dp_latency_class_t cls,
+                               vqec_dp_histogram_data_t *hist_ptr)
+{
+    vqec_dpchan_t *this;
+
+    if ((stage < 0) || (stage >= VQEC_DPCHAN_LATENCY_STAGES) ||
+        (cls < 0) || (cls >= VQEC_DP_LATENCY_CLASS_MAX) || !hist_ptr) {
+        return (VQEC_DP_ERR_INVALIDARGS);
+    }
+
+    if (!s_dpchan_module.init_done) {
+        return (VQEC_DP_ERR_SHUTDOWN);
+    }
+
+    this = vqec_dp_chanid_to_ptr(chanid);
+    if (!this) {
+        return (VQEC_DP_ERR_NOT_FOUND);
+    }
+
+    vam_hist_copy((vam_hist_type_t *)hist_ptr,
+                  VQEC_DP_HIST_MAX_BUCKETS,
+                  (vam_hist_type_t *)&this->latency_hist[stage][cls]);
+    return (VQEC_DP_ERR_OK);
+}
+
+/**
+ * Clear the packet latency histograms of all channels.
+ *
+ * @param[out] vqec_dp_error_t  - VQEC_DP_ERR_OK or failure code
+ */
+vqec_dp_error_t
+vqec_dp_chan_latency_hist_clear (void)
+{
+    vqec_dpchan_t *chan;
+    int stage, cls;
+
+    if (!s_dpchan_module.init_done) {
+        return (VQEC_DP_ERR_OK);
+    }
+
+    VQE_TAILQ_FOREACH(chan, &s_dpchan_module.chan_list, le) {
+        for (stage = 0; stage < VQEC_DPCHAN_LATENCY_STAGES; stage++) {
+            for (cls = 0; cls < VQEC_DP_LATENCY_CLASS_MAX; cls++) {
+                vam_hist_clear(
+                    (vam_hist_type_t *)&chan->latency_hist[stage][cls]);
+            }
+        }
+    }
+    return (VQEC_DP_ERR_OK);
+}
+
 
 /****************************************************************************
  * General methods exported to the CP.
@@ -2010,6 +2109,102 @@ vqec_dp_chan_get_status (vqec_dp_chanid_t chanid,
 }
 
 
+/**---------------------------------------------------------------------------
+ * Get compact statistics for all channels.  The counters are derived from
+ * the same channel state as those returned by vqec_dp_chan_get_status(),
+ * without gathering the full status of each module.
+ *
+ * @param[out] chans Array of channel summaries to be filled.
+ * @param[in] max_chans Number of entries in the chans array.
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @param[out] uint32_t Number of channel summaries filled.
+ *---------------------------------------------------------------------------*/ 
+uint32_t
+vqec_dpchan_get_stats_summary (vqec_dp_chan_stats_summary_t *chans,
+                               uint32_t max_chans,
+                               boolean cumulative)
+{
+    vqec_dpchan_t *chan;
+    vqec_dp_chan_stats_summary_t *s;
+    vqec_dp_chan_stats_t chan_s;
+    vqec_dp_chan_rtp_input_stream_t *iptr;
+    const rtp_hdr_source_t *src_stats;
+    vqec_pcm_t *pcm;
+    vqec_fec_t *fec;
+    uint32_t num = 0;
+
+    if (!s_dpchan_module.init_done || !chans) {
+        return (0);
+    }
+
+    VQE_TAILQ_FOREACH(chan, &s_dpchan_module.chan_list, le) {
+        if (num == max_chans) {
+            break;
+        }
+        s = &chans[num++];
+        memset(s, 0, sizeof(*s));
+        s->cp_handle = chan->cp_handle;
+
+        if (chan->prim_is != VQEC_DP_INVALID_ISID) {
+            iptr = (vqec_dp_chan_rtp_input_stream_t *)
+                vqec_dp_chan_input_stream_id_to_ptr(chan->prim_is);
+            src_stats = vqec_dp_rtp_src_get_pktflow_stats(iptr);
+            if (src_stats) {
+                s->primary_rtp_expected = 
+                    (src_stats->cycles + src_stats->max_seq) 
+                    - src_stats->base_seq + 1;
+                s->primary_rtp_received = src_stats->received;
+            }
+        }
+
+        vqec_dpchan_get_input_stats(chan, &chan_s, cumulative);
+        s->primary_udp_inputs = chan_s.udp_rx_paks;
+        s->primary_rtp_inputs = chan_s.primary_rx_paks;
+        s->primary_rtp_drops =
+            (chan_s.primary_pcm_drops_total 
+             - chan_s.primary_pcm_drops_duplicate)
+            + chan_s.primary_sm_early_drops
+            + chan_s.primary_rtp_rx_drops
+            + chan_s.primary_sim_drops;
+        s->repair_rtp_inputs = chan_s.repair_rx_paks;
+        s->repair_rtp_drops =
+            (chan_s.repair_pcm_drops_total
+             - chan_s.repair_pcm_drops_duplicate)
+            + chan_s.repair_sm_early_drops
+            + chan_s.repair_rtp_rx_drops
+            + chan_s.repair_sim_drops;
+
+        fec = chan->fec;
+        if (fec) {
+            s->fec_inputs = fec->fec_stats.fec_total_paks;
+            s->fec_recovered_paks = fec->fec_stats.fec_recovered_paks;
+            if (!cumulative) {
+                s->fec_inputs -= fec->fec_stats_snapshot.fec_total_paks;
+                s->fec_recovered_paks -= 
+                    fec->fec_stats_snapshot.fec_recovered_paks;
+            }
+        }
+
+        pcm = &chan->pcm;
+        s->post_repair_losses_rcc = pcm->stats.output_loss_paks_first_prim;
+        s->pre_repair_losses = pcm->stats.input_loss_pak_counter;
+        s->post_repair_losses = pcm->stats.output_loss_pak_counter;
+        s->post_repair_outputs = pcm->stats.total_tx_paks;
+        s->underruns = pcm->stats.under_run_counter;
+        if (!cumulative) {
+            s->pre_repair_losses -= pcm->stats_snapshot.input_loss_pak_counter;
+            s->post_repair_losses -= 
+                pcm->stats_snapshot.output_loss_pak_counter;
+            s->post_repair_outputs -= pcm->stats_snapshot.total_tx_paks;
+            s->underruns -= pcm->stats_snapshot.under_run_counter;
+        }
+        s->post_repair_losses += s->post_repair_losses_rcc;
+    }
+
+    return (num);
+}
+
+
 #define INFINITY_U64 (-1)
 vqec_dp_error_t
 vqec_dp_chan_get_stats_tr135_sample (vqec_dp_chanid_t chanid,
@@ -2784,6 +2979,28 @@ vqec_dpchan_primary_inactive_notify (vqec_dpchan_t *chan)
 
 }
 
+/**---------------------------------------------------------------------------
+ * Aged-gap notification from the pcm: gaps are eligible for error repair.
+ * An upcall notification is sent to the control-plane, which then retrieves
+ * and reports the gaps.
+ * 
+ * @param[in] chan Pointer to the channel.
+ *---------------------------------------------------------------------------*/ 
+static void
+vqec_dpchan_gap_aged_notify (vqec_dpchan_t *chan)
+{
+    if (vqec_dpchan_tx_upcall_ev(chan, 
+                                 VQEC_DP_UPCALL_DEV_DPCHAN,
+                                 0, 
+                                 VQEC_DP_UPCALL_REASON_CHAN_GAP_AGED) !=
+        VQEC_DP_ERR_OK) {
+        VQEC_DP_SYSLOG_PRINT(CHAN_ERROR, 
+                             vqec_dpchan_print_name(chan),
+                             " ",
+                             "Upcall gap aged post failure");
+    }
+}
+
 /**---------------------------------------------------------------------------
  * Notification from the dpchan that the FEC L and D values have been updated.
  * An upcall notification is sent to the control-plane.
@@ -3733,6 +3950,7 @@ vqec_dpchan_create (vqec_dp_chan_desc_t *desc,
     dpchan->rcc_enabled = desc->en_rcc;
     dpchan->passthru = desc->passthru;
     dpchan->reorder_time = desc->reorder_time;
+    vqec_dpchan_latency_hist_init(dpchan);
 
 #ifdef HAVE_FCC
     dpchan->max_backfill = desc->max_backfill;
@@ -3977,6 +4195,9 @@ vqec_dpchan_poll_ev_handler (abs_time_t cur_time)
                     }
                 }
             }
+            if (vqec_pcm_gap_ev_due(&chan->pcm, cur_time)) {
+                vqec_dpchan_gap_aged_notify(chan);
+            }
             if (gen_sync) {
                 (void)vqec_dpchan_tx_upcall_ev(
                     chan, 
@@ -144,6 +144,12 @@ struct vqec_dp_irq_desc_
 
 #endif   /* HAVE_FCC */
 
+/*
+ * Latency stages which are kept per channel; sink residence is kept
+ * per tuner by the output shim.
+ */
+#define VQEC_DPCHAN_LATENCY_STAGES VQEC_DP_LATENCY_SINK_RESIDENCE
+
 #define MAX_DPCHAN_IPV4_PRINT_NAME_SIZE \
     (sizeof("XXX.XXX.XXX.XXX:65535")) 
 /* (just a sample string to measure the max length for IPv4 addresses) */
@@ -202,6 +208,9 @@ typedef struct vqec_dpchan_ {
                                  * last pak, or ABS_TIME_0 if no previous
                                  * pktflow source existed
                                  */
+    vqec_dp_histogram_data_t
+        latency_hist[VQEC_DPCHAN_LATENCY_STAGES][VQEC_DP_LATENCY_CLASS_MAX];
+                                /* Packet latency histograms */
 
 #if HAVE_FCC
     VQEC_DPCHAN_RCC_FIELDS
@@ -380,6 +389,28 @@ vqec_dpchan_pcm_ptr (vqec_dpchan_t *chan)
     return (&chan->pcm);
 }
 
+/**
+ * Log a packet's latency in one of the channel's latency histograms.
+ *
+ * @param[in] chan Pointer to the channel - may be NULL.
+ * @param[in] stage Latency stage, which is kept per channel.
+ * @param[in] pak Pointer to the packet.
+ * @param[in] delay Time spent by the packet in the stage.
+ */
+static inline void
+vqec_dpchan_latency_add (vqec_dpchan_t *chan,
+                         vqec_dp_latency_stage_t stage,
+                         const vqec_pak_t *pak,
+                         rel_time_t delay)
+{
+    vqec_dp_latency_class_t cls = vqec_dp_latency_pak_class(pak);
+
+    if (chan && (cls != VQEC_DP_LATENCY_CLASS_MAX)) {
+        (void)vam_hist_add((vam_hist_type_t *)&chan->latency_hist[stage][cls],
+                           TIME_GET_R(usec, delay));
+    }
+}
+
 /**
  * Access the fec instance: used by the FEC RTP IS to call "deliver" on
  * the FEC instance.
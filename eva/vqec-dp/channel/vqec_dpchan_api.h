@@ -59,4 +59,17 @@ vqec_dpchan_module_deinit(void);
 void 
 vqec_dpchan_poll_ev_handler(abs_time_t cur_time);
 
+/**
+ * Get compact statistics for all channels.
+ *
+ * @param[out] chans Array of channel summaries to be filled.
+ * @param[in] max_chans Number of entries in the chans array.
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @return Number of channel summaries filled.
+ */
+uint32_t
+vqec_dpchan_get_stats_summary(vqec_dp_chan_stats_summary_t *chans,
+                              uint32_t max_chans,
+                              boolean cumulative);
+
 #endif /* __VQEC_DPCHAN_API_H__ */
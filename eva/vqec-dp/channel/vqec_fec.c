@@ -19,6 +19,8 @@
  */
 
 #include "vqec_fec.h"
+#include "vqec_fec_xor.h"
+#include "vqec_fec_rs.h"
 #include <vam_time.h>
 #include <rtp.h>
 #include "vqe_port_macros.h"
@@ -74,7 +76,8 @@ typedef enum vqec_fec_hdr_error_ {
  * LATE_PAK:    one of the video paks protected by this FEC packet 
  *              is out of fec buffer
  * FUTURE_PAK:  one of the video paks protected by this FEC packet
- *              is not arrived yet.
+ *              is not arrived yet, or (Reed-Solomon) more FEC packets
+ *              of the row or column are needed.
  * UNRECOVERABLE: the number of video pak losses are more than 1 
  *              in our XOR fec.
  * FAILURE:     decode failure
@@ -96,6 +99,21 @@ typedef enum vqec_fec_dec_error_ {
     VQEC_FEC_DEC_PAK_TOO_EARLY,
 } vqec_fec_dec_error_t;
 
+/**
+ * FEC decoding engine, one per FEC type of the FEC header. The engine
+ * decodes the row or column protected by an FEC packet, recovering as
+ * many lost packets as its code allows, and inserts the recovered
+ * packets into the PCM. It returns VQEC_FEC_DEC_UNRECOVERABLE while it cannot
+ * recover the row or column yet, in which case the FEC packet is kept
+ * for a later attempt.
+ */
+typedef struct vqec_fec_engine_ {
+    vqec_fec_type_t type;               /* FEC_TYPE() of handled paks */
+    vqec_fec_dec_error_t (*decode)(vqec_fec_t *fec, vqec_pak_t *fec_pak);
+} vqec_fec_engine_t;
+
+static const vqec_fec_engine_t *vqec_fec_engine_get(uint8_t fec_type);
+
 /**
  * define the error message, used while
  * inserting an fec packet to fec_pak_seq
@@ -117,6 +135,8 @@ boolean g_fec_set = FALSE;
 
 typedef struct vqe_zone vqec_fec_pool_t;
 static vqec_fec_pool_t *s_vqec_fec_pool = NULL;
+static vqec_fec_pool_t *s_vqec_fec_acc_tbl_pool = NULL;
+static vqec_fec_pool_t *s_vqec_fec_acc_pool = NULL;
 static vqec_pak_seq_pool_t *s_vqec_pak_seq_pool = NULL;
 
 #define PAK_SEQ_PER_FEC 2
@@ -141,6 +161,9 @@ vqec_fec_module_init (uint32_t max_fecs)
         goto done;
     }
 
+    vqec_fec_xor_init();
+    vqec_fec_rs_init();
+
     s_vqec_fec_pool = zone_instance_get_loc (
                                 "vqec_fec_pool",
                                  O_CREAT,
@@ -154,6 +177,32 @@ vqec_fec_module_init (uint32_t max_fecs)
         goto done;
     }
 
+    s_vqec_fec_acc_tbl_pool = zone_instance_get_loc (
+                                "vqec_fec_acc_tbl_pool",
+                                 O_CREAT,
+                                 sizeof(vqec_fec_acc_tbl_t),
+                                 max_fecs,
+                                 NULL, NULL);
+    if (!s_vqec_fec_acc_tbl_pool) {
+        VQEC_DP_SYSLOG_PRINT(INIT_FAILURE,
+                             "FEC accumulator table pool creation failed");
+        err = VQEC_DP_ERR_NOMEM;
+        goto done;
+    }
+
+    s_vqec_fec_acc_pool = zone_instance_get_loc (
+                                "vqec_fec_acc_pool",
+                                 O_CREAT,
+                                 sizeof(vqec_fec_acc_t),
+                                 VQEC_FEC_ACC_PER_FEC * max_fecs,
+                                 NULL, NULL);
+    if (!s_vqec_fec_acc_pool) {
+        VQEC_DP_SYSLOG_PRINT(INIT_FAILURE,
+                             "FEC accumulator pool creation failed");
+        err = VQEC_DP_ERR_NOMEM;
+        goto done;
+    }
+
     s_vqec_pak_seq_pool = vqec_pak_seq_pool_create(
                                  "pak_seq_fec",
                                  PAK_SEQ_PER_FEC * max_fecs,
@@ -186,6 +235,14 @@ vqec_fec_module_deinit ()
         (void)zone_instance_put(s_vqec_fec_pool);
         s_vqec_fec_pool = NULL;
     }
+    if (s_vqec_fec_acc_tbl_pool) {
+        (void)zone_instance_put(s_vqec_fec_acc_tbl_pool);
+        s_vqec_fec_acc_tbl_pool = NULL;
+    }
+    if (s_vqec_fec_acc_pool) {
+        (void)zone_instance_put(s_vqec_fec_acc_pool);
+        s_vqec_fec_acc_pool = NULL;
+    }
     if (s_vqec_pak_seq_pool) {
         vqec_pak_seq_pool_destroy(s_vqec_pak_seq_pool);
         s_vqec_pak_seq_pool = NULL;
@@ -460,9 +517,9 @@ UT_STATIC vqec_fec_hdr_error_t vqec_fec_hdr_validation (vqec_fec_t *fec,
         return VQEC_FEC_HDR_WRONG_VERSION;
     }
     /**
-     * check if the type of FEC is supported, COP#3r2 only XOR
+     * check if the type of FEC is supported, i.e. has a decoding engine
      */
-    if (FEC_TYPE(fec_hdr) != VQEC_FEC_TYPE_XOR) {
+    if (!vqec_fec_engine_get(FEC_TYPE(fec_hdr))) {
         return VQEC_FEC_HDR_UNSUPPORTED_TYPE;
     }
 
@@ -536,8 +593,19 @@ UT_STATIC vqec_fec_hdr_error_t vqec_fec_hdr_validation (vqec_fec_t *fec,
                 pcm->last_rx_seq_num,
                 ntohs(fec_hdr->snbase_low_bits));
 
-            res = vqec_fec_detect_sending_order(fec, fec_seq32, sn_base32,
-                                                l_value,d_value);
+            /**
+             * Reed-Solomon streams send several FEC packets per column,
+             * which the detection does not handle; assume the worst
+             * case ordering.
+             */
+            if (FEC_TYPE(fec_hdr) != VQEC_FEC_TYPE_XOR) {
+                fec->sending_order_detected = TRUE;
+                res = VQEC_DP_FEC_SENDING_ORDER_OTHER;
+            } else {
+                res = vqec_fec_detect_sending_order(fec, fec_seq32, 
+                                                    sn_base32,
+                                                    l_value,d_value);
+            }
             switch (res) {
 
                 case VQEC_DP_FEC_SENDING_ORDER_ANNEXA:
@@ -620,6 +688,12 @@ vqec_fec_t *vqec_fec_create (vqec_fec_params_t *fec_param,
     fec->pcm = pcm;
     fec->chanid = chanid;
 
+    /* without accumulators, all FEC packets are decoded by gathering */
+    fec->acc = (vqec_fec_acc_tbl_t *)zone_acquire(s_vqec_fec_acc_tbl_pool);
+    if (fec->acc) {
+        memset(fec->acc, 0, sizeof(vqec_fec_acc_tbl_t));
+    }
+
     switch (fec_param->avail_streams) {
 
         case VQEC_FEC_STREAM_AVAIL_NONE:
@@ -694,6 +768,10 @@ void vqec_fec_destroy (vqec_fec_t *fec)
         vqec_pak_seq_destroy_in_pool(s_vqec_pak_seq_pool,
                                      fec->fec_pak_seq_row);
     }
+    if (fec->acc) {
+        vqec_fec_acc_reset(fec);
+        zone_release(s_vqec_fec_acc_tbl_pool, fec->acc);
+    }
     zone_release(s_vqec_fec_pool, fec);
 }
 
@@ -761,10 +839,11 @@ boolean vqec_fec_flush (vqec_fec_t *fec,
 
 /**
  * This function decodes received packets using XOR fec.
- * The decoding is word by word. 
  * All the related video packets as well as the FEC packet are 
  * input to **received_pkts, must allocate a buffer for recovered
- * packet and pass to the function. 
+ * packet and pass to the function. The packets are XOR'ed into the
+ * recovered packet in a single pass, using the fastest XOR kernel
+ * supported by the CPU (see vqec_fec_xor.h).
  *
  * @param[in] received_pkts pointer to received packets pointers
  * @param[in] num_pkts      total number of packets received
@@ -779,14 +858,8 @@ UT_STATIC boolean vqec_fec_decode_xor_word (char **received_pkts,
                                             uint16_t pkt_size,
                                             char *recovered_pkt)
 {
-  uint16_t i,j;
-  uint16_t num_words = 0;
-  const uint16_t WORD_LEN = 4;
-  uint16_t remain_bytes = 0;
-  char *ptr1 = NULL;
-  char *ptr2 = NULL;
+  uint16_t i;
 
-    
   if (!received_pkts || !recovered_pkt) {
       return FALSE;
   }
@@ -807,39 +880,7 @@ UT_STATIC boolean vqec_fec_decode_xor_word (char **received_pkts,
       }
   }
 
-  remain_bytes = pkt_size % WORD_LEN;
-  num_words = (pkt_size - remain_bytes)/WORD_LEN;
-
-  if (num_words == 0) {
-     /* byte based decode*/
-      memcpy(recovered_pkt, received_pkts[0], pkt_size);
-
-      for (i = 1; i < num_pkts; i++) {
-          for (j = 0; j < pkt_size; j++) {
-              *(recovered_pkt+j) = *(recovered_pkt+j) ^ *(received_pkts[i]+j);
-          }
-      }
-  } else {
-     /* word based decoding */
-      memcpy(recovered_pkt, received_pkts[0], pkt_size);
-
-      for (i = 1; i < num_pkts; i++) {
-          /* decode the received packets bitwise*/   
-          for (j = 0; j < num_words; j++) {
-              *((uint32_t *)recovered_pkt+j) = 
-                  *((uint32_t *)recovered_pkt+j) ^
-                  *((uint32_t *)received_pkts[i]+j);
-          }
-          /* decode the remaining bytes */
-          if (remain_bytes != 0) {
-              ptr1 = recovered_pkt + num_words * WORD_LEN;
-              ptr2 = received_pkts[i] + num_words *WORD_LEN;
-              for (j = 0; j < remain_bytes; j++) {
-                  *(ptr1+j) = *(ptr1+j) ^ *(ptr2+j);
-              }
-          }
-      }
-  }
+  vqec_fec_xor_blocks(recovered_pkt, received_pkts, num_pkts, pkt_size);
 
   return TRUE;
 }
@@ -1308,7 +1349,7 @@ UT_STATIC boolean vqec_fec_remove_packet (vqec_fec_t *fec,
 }
 
 /**
- * This function parses decode error after vqec_fec_decode_basic()
+ * This function parses decode error after vqec_fec_decode()
  * and properly processes the FEC packet just used.
  *
  * @param[in] dec_res       decode error results 
@@ -1719,6 +1760,1137 @@ UT_STATIC vqec_fec_dec_error_t vqec_fec_decode_basic (vqec_fec_t *fec,
 }
 
 
+/**
+ * Decode a row or column protected by Reed-Solomon FEC packets. Up to
+ * VQEC_FEC_RS_MAX_PARITY lost packets can be recovered, provided as
+ * many FEC packets of the row or column (with distinct indices) have
+ * been received. The packet layout is described in vqec_fec_rs.h.
+ *
+ * The syndromes are built directly in the buffers of the packets to be
+ * recovered, and solved in place.
+ *
+ * @param[in] fec       pointer to fec module
+ * @param[in] fec_pak   one of the FEC packets of the row or column
+ * 
+ * @return error code defined at vqec_fec_dec_error_t
+ */
+UT_STATIC vqec_fec_dec_error_t vqec_fec_decode_rs (vqec_fec_t *fec, 
+                                                   vqec_pak_t *fec_pak)
+{
+    uint16_t sn_base, offset, na_bits, num_loss, num_parity, i, m, r;
+    vqec_seq_num_t sn_base32, last_seq32, seq32, head, tail;
+    vqec_seq_num_t lost_seq_nums[MAX_D];
+    vqec_pak_t *members[MAX_D], *src = NULL;
+    vqec_pak_t *parity[VQEC_FEC_RS_MAX_PARITY];
+    vqec_pak_t *recovered[VQEC_FEC_RS_MAX_PARITY];
+    char *syn[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t parity_index[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t lost[VQEC_FEC_RS_MAX_PARITY], which[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t vec_hdr[VQEC_FEC_RS_HDR_BYTES], c;
+    uint32_t vec_len, content_len, payload_len, pkt_size;
+    const uint32_t fec_hdr_len = sizeof(rtpfasttype_t) + 
+        sizeof(vqec_fec_hdr_t);
+    fecfasttype_t *fec_hdr, *hdr;
+    rtpfasttype_t fec_rtp_header;
+    vqec_pak_seq_t *fec_pak_seq;
+    vqec_pak_t *pak;
+    vqec_pcm_t *pcm;
+    vqec_fec_dec_error_t ret = VQEC_FEC_DEC_OK;
+
+    if (!fec || !fec_pak || !fec->pcm) {
+        return VQEC_FEC_DEC_MEM_ALLOC_WRONG;
+    }
+    pcm = fec->pcm;
+
+    fec_hdr = (fecfasttype_t *)fec_pak->fec_hdr;
+    VQEC_DP_ASSERT_FATAL(fec_hdr, "fec");
+    sn_base = ntohs(fec_hdr->snbase_low_bits);
+    offset = FEC_OFFSET(fec_hdr);
+    na_bits = FEC_NA(fec_hdr);
+    if (!na_bits || na_bits > MAX_D) {
+        return VQEC_FEC_DEC_FAILURE;
+    }
+
+    sn_base32 = 
+        vqec_seq_num_nearest_to_rtp_seq_num(pcm->last_rx_seq_num,
+                                            sn_base);
+    fec_pak->fec_touched++;
+    if (vqec_seq_num_lt(sn_base32, pcm->head)) {
+        return VQEC_FEC_DEC_LATE_PAK;
+    }
+
+    last_seq32 = sn_base32 + (na_bits - 1) * offset;
+    if (vqec_seq_num_lt(pcm->tail, last_seq32)) {
+        if (vqec_seq_num_sub(last_seq32, pcm->tail) > 
+            2 * fec->fec_info.fec_l_value * fec->fec_info.fec_d_value) {
+            return VQEC_FEC_DEC_PAK_TOO_EARLY;
+        }
+        return VQEC_FEC_DEC_FUTURE_PAK;
+    }
+
+    num_loss = vqec_pcm_gap_search(pcm, sn_base32, offset, 
+                                   na_bits, lost_seq_nums);
+    if (num_loss == 0) {
+        return VQEC_FEC_DEC_NOT_NEEDED;
+    }
+    if (num_loss > VQEC_FEC_RS_MAX_PARITY || num_loss >= na_bits) {
+        return VQEC_FEC_DEC_UNRECOVERABLE;
+    }
+
+    /* collect one FEC packet per lost packet, with distinct indices */
+    if (FEC_D_BIT(fec_hdr)) {
+        fec_pak_seq = fec->fec_pak_seq_row;
+        head = fec->fec_row_head;
+        tail = fec->fec_row_tail;
+    } else {
+        fec_pak_seq = fec->fec_pak_seq_column;
+        head = fec->fec_column_head;
+        tail = fec->fec_column_tail;
+    }
+    num_parity = 0;
+    for (seq32 = head; 
+         vqec_seq_num_le(seq32, tail) && num_parity < num_loss;
+         seq32 = vqec_next_seq_num(seq32)) {
+        pak = vqec_pak_seq_find(fec_pak_seq, seq32);
+        if (!pak) {
+            continue;
+        }
+        hdr = (fecfasttype_t *)pak->fec_hdr;
+        if (FEC_TYPE(hdr) != VQEC_FEC_TYPE_RS ||
+            hdr->snbase_low_bits != fec_hdr->snbase_low_bits ||
+            FEC_OFFSET(hdr) != offset || FEC_NA(hdr) != na_bits ||
+            vqec_pak_get_content_len(pak) < fec_hdr_len) {
+            continue;
+        }
+        for (r = 0; r < num_parity && parity_index[r] != FEC_INDEX(hdr); 
+             r++) {
+            ;
+        }
+        if (r == num_parity) {
+            parity[num_parity] = pak;
+            parity_index[num_parity++] = FEC_INDEX(hdr);
+        }
+    }
+    /*
+     * Wait for more FEC paks: every FEC pak received runs the decoder
+     * again, so an unrecoverable pak would be dropped before the rest of
+     * its row or column arrives. It is held until it is late instead.
+     */
+    if (num_parity < num_loss) {
+        return VQEC_FEC_DEC_FUTURE_PAK;
+    }
+
+    /* find the received members, and the longest protected vector */
+    vec_len = VQEC_FEC_RS_HDR_BYTES;
+    for (r = 0; r < num_parity; r++) {
+        content_len = vqec_pak_get_content_len(parity[r]);
+        if (vec_len < VQEC_FEC_RS_HDR_BYTES + content_len - fec_hdr_len) {
+            vec_len = VQEC_FEC_RS_HDR_BYTES + content_len - fec_hdr_len;
+        }
+    }
+    m = 0;
+    for (i = 0; i < na_bits; i++) {
+        members[i] = vqec_pak_seq_find(pcm->pak_seq, sn_base32 + i * offset);
+        if (!members[i]) {
+            if (m == num_loss) {
+                return VQEC_FEC_DEC_FAILURE;
+            }
+            lost[m++] = i;
+            continue;
+        }
+        content_len = vqec_pak_get_content_len(members[i]);
+        if (content_len < sizeof(rtpfasttype_t) ||
+            members[i]->mpeg_payload_offset > content_len) {
+            return VQEC_FEC_DEC_FAILURE;
+        }
+        payload_len = content_len - members[i]->mpeg_payload_offset;
+        if (vec_len < VQEC_FEC_RS_HDR_BYTES + payload_len) {
+            vec_len = VQEC_FEC_RS_HDR_BYTES + payload_len;
+        }
+        src = members[i];
+    }
+    if (m != num_loss || !src) {
+        return VQEC_FEC_DEC_FAILURE;
+    }
+
+    /* start each syndrome from its FEC packet */
+    memset(recovered, 0, sizeof(recovered));
+    for (r = 0; r < num_loss; r++) {
+        recovered[r] = vqec_pak_alloc_with_particle();
+        if (!recovered[r]) {
+            ret = VQEC_FEC_DEC_MEM_ALLOC_WRONG;
+            goto done;
+        }
+        recovered[r]->head_offset = 0;
+        if (!vqec_pak_set_content_len(recovered[r], vec_len)) {
+            ret = VQEC_FEC_DEC_FAILURE;
+            goto done;
+        }
+        syn[r] = vqec_pak_get_head_ptr(recovered[r]);
+        memset(syn[r], 0, vec_len);
+
+        hdr = (fecfasttype_t *)parity[r]->fec_hdr;
+        memset(&fec_rtp_header, 0, sizeof(rtpfasttype_t));
+        fec_rtp_header.combined_bits = parity[r]->rtp->combined_bits;
+        SET_RTP_PAYLOAD(&fec_rtp_header, FEC_PT_RECOVERY(hdr));
+        fec_rtp_header.timestamp = hdr->ts_recovery;
+        vqec_fec_rs_hdr_vector((uint8_t *)syn[r], 
+                               (const uint8_t *)&fec_rtp_header,
+                               ntohs(hdr->length_recovery));
+        memcpy(syn[r] + VQEC_FEC_RS_HDR_BYTES,
+               vqec_pak_get_head_ptr(parity[r]) + fec_hdr_len,
+               vqec_pak_get_content_len(parity[r]) - fec_hdr_len);
+    }
+
+    /* add in the contribution of every received member */
+    for (i = 0; i < na_bits; i++) {
+        if (!members[i]) {
+            continue;
+        }
+        content_len = vqec_pak_get_content_len(members[i]);
+        payload_len = content_len - members[i]->mpeg_payload_offset;
+        vqec_fec_rs_hdr_vector(vec_hdr, (const uint8_t *)members[i]->rtp,
+                               content_len - sizeof(rtpfasttype_t));
+        for (r = 0; r < num_loss; r++) {
+            c = vqec_fec_rs_coef(parity_index[r], i);
+            vqec_fec_rs_mul_add(syn[r], (const char *)vec_hdr, c, 
+                                VQEC_FEC_RS_HDR_BYTES);
+            vqec_fec_rs_mul_add(syn[r] + VQEC_FEC_RS_HDR_BYTES,
+                                vqec_pak_get_head_ptr(members[i]) + 
+                                members[i]->mpeg_payload_offset,
+                                c, payload_len);
+        }
+    }
+
+    if (!vqec_fec_rs_solve(syn, parity_index, lost, num_loss, 
+                           vec_len, which)) {
+        ret = VQEC_FEC_DEC_UNRECOVERABLE;
+        goto done;
+    }
+
+    /* turn the solved vectors into packets, and insert them */
+    for (m = 0; m < num_loss; m++) {
+        pak = recovered[which[m]];
+        pak->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(pak);
+        pkt_size = ntohs(*(uint16_t *)&pak->rtp->ssrc);
+        if (pkt_size + VQEC_FEC_RS_HDR_BYTES > vec_len) {
+            ret = VQEC_FEC_DEC_RTP_VALIDATE_WRONG;
+            goto done;
+        }
+        SET_RTP_VERSION(pak->rtp, RTPVERSION);
+        seq32 = sn_base32 + lost[m] * offset;
+        pak->rtp->sequence = htons(vqec_seq_num_to_rtp_seq_num(seq32));
+        pak->rtp->ssrc = src->rtp->ssrc;
+        vqec_pak_set_content_len(pak, pkt_size + sizeof(rtpfasttype_t));
+        pak->rtp_ts = ntohl(pak->rtp->timestamp);
+        pak->seq_num = seq32;
+        pak->mpeg_payload_offset = RTPHEADERBYTES(pak->rtp);
+        pak->type = VQEC_PAK_TYPE_REPAIR;
+        VQEC_PAK_FLAGS_SET(&pak->flags, VQEC_PAK_FLAGS_AFTER_EC);
+        pak->src_addr = src->src_addr;
+        pak->src_port = src->src_port;
+
+        if (vqec_fec_rtp_hdr_validation(vqec_pak_get_head_ptr(pak), 
+                                        vqec_pak_get_content_len(pak)) 
+            != VQEC_DP_ERR_OK) {
+            ret = VQEC_FEC_DEC_RTP_VALIDATE_WRONG;
+            goto done;
+        }
+    }
+
+    for (m = 0; m < num_loss; m++) {
+        pak = recovered[which[m]];
+        pak->fec_touched = FEC_TOUCHED;
+        if (!vqec_pcm_insert_packets(pcm, &pak, 1, FALSE, NULL)) {
+            vqec_pcm_log_tr135_overrun(pcm, 1);
+            VQEC_DP_SYSLOG_PRINT(ERROR,
+                                 "Error upon inserting recovered FEC pkt"); 
+        }
+    }
+    /* the caller accounts for one recovered packet */
+    fec->fec_stats.fec_recovered_paks += num_loss - 1;
+
+done:
+    for (r = 0; r < num_loss; r++) {
+        if (recovered[r]) {
+            vqec_pak_free(recovered[r]);
+        }
+    }
+    return ret;
+}
+
+/*
+ * FEC decoding engines, indexed by the type field of the FEC header.
+ */
+static const vqec_fec_engine_t s_vqec_fec_engines[] = {
+    { VQEC_FEC_TYPE_XOR, vqec_fec_decode_basic },
+    { VQEC_FEC_TYPE_RS, vqec_fec_decode_rs },
+};
+
+/**
+ * Get the decoding engine of an FEC type.
+ *
+ * @param[in] fec_type  type field of an FEC header
+ *
+ * @return the engine, or NULL if the type is not supported
+ */
+static const vqec_fec_engine_t *
+vqec_fec_engine_get (uint8_t fec_type)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(s_vqec_fec_engines) / 
+             sizeof(s_vqec_fec_engines[0]); i++) {
+        if (s_vqec_fec_engines[i].type == fec_type) {
+            return &s_vqec_fec_engines[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Decode the row or column protected by an FEC packet, with the engine
+ * of its FEC type.
+ *
+ * @param[in] fec       pointer to fec module
+ * @param[in] fec_pak   pointer to received packet
+ * 
+ * @return error code defined at vqec_fec_dec_error_t
+ */
+UT_STATIC vqec_fec_dec_error_t vqec_fec_decode (vqec_fec_t *fec, 
+                                                vqec_pak_t *fec_pak)
+{
+    const vqec_fec_engine_t *engine;
+    fecfasttype_t *fec_hdr;
+
+    if (!fec || !fec_pak || !fec_pak->fec_hdr) {
+        return VQEC_FEC_DEC_MEM_ALLOC_WRONG;
+    }
+
+    fec_hdr = (fecfasttype_t *)fec_pak->fec_hdr;
+    engine = vqec_fec_engine_get(FEC_TYPE(fec_hdr));
+    if (!engine) {
+        return VQEC_FEC_DEC_FAILURE;
+    }
+    return (*engine->decode)(fec, fec_pak);
+}
+
+/*
+ * Incremental parity accumulation.
+ *
+ * Rather than gathering all the packets of a row or column from the PCM
+ * when its FEC packet arrives, a running XOR of every row and column of
+ * the most recent FEC blocks is kept. Source packets are folded in as
+ * they are inserted into the PCM, FEC packets as they are received, so
+ * that a single loss is recovered by copying out the accumulator.
+ *
+ * The accumulators of a block can only be used once the alignment of
+ * FEC blocks in the sequence space is known. A column FEC packet with
+ * SN base S places the block base within [S - L + 1, S]; a row FEC
+ * packet places it at SN base modulo L. Successive constraints are
+ * intersected until a single base remains.
+ *
+ * Each tracked block has a matrix descriptor recording which source
+ * packets are present per row and column. A row or column becomes ready
+ * when its FEC packet has been received and at most one of its source
+ * packets is missing; it is then put on a worklist. Decoding drains the
+ * worklist, so its cost depends on the number of rows and columns that
+ * changed, not on the number of rows and columns tracked.
+ */
+
+/*
+ * Non-negative remainder of a signed division.
+ */
+static inline int32_t
+vqec_fec_acc_mod (int32_t a, int32_t m)
+{
+    int32_t r = a % m;
+
+    return (r < 0 ? r + m : r);
+}
+
+static inline vqec_fec_acc_t *
+vqec_fec_acc_acquire (vqec_seq_num_t sn_base)
+{
+    vqec_fec_acc_t *acc;
+
+    acc = (vqec_fec_acc_t *)zone_acquire(s_vqec_fec_acc_pool);
+    if (acc) {
+        memset(acc, 0, offsetof(vqec_fec_acc_t, payload));
+        acc->sn_base = sn_base;
+    }
+    return (acc);
+}
+
+/**
+ * Return the accumulators of a block to the pool, releasing the FEC
+ * packets they hold.
+ *
+ * @param[in] fec   pointer to fec module
+ * @param[in] blk   block whose accumulators are released
+ */
+static void
+vqec_fec_acc_release_accs (vqec_fec_t *fec, vqec_fec_acc_block_t *blk)
+{
+    vqec_fec_acc_t **acc;
+    uint32_t i;
+
+    for (i = 0; i < MAX_L + MAX_D; i++) {
+        acc = (i < MAX_L) ? &blk->col[i] : &blk->row[i - MAX_L];
+        if (!*acc) {
+            continue;
+        }
+        if ((*acc)->fec_pak) {
+            if (!(*acc)->done &&
+                VQEC_DP_GET_DEBUG_FLAG(VQEC_DP_DEBUG_COLLECT_STATS)) {
+                fec->fec_stats.fec_unrecoverable_paks++;
+            }
+            vqec_pak_free((*acc)->fec_pak);
+            (*acc)->fec_pak = NULL;
+        }
+        zone_release(s_vqec_fec_acc_pool, *acc);
+        *acc = NULL;
+    }
+}
+
+/**
+ * Release the accumulators of a block, and mark the block unused.
+ *
+ * @param[in] fec   pointer to fec module
+ * @param[in] blk   block to release
+ */
+static void
+vqec_fec_acc_block_release (vqec_fec_t *fec, vqec_fec_acc_block_t *blk)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    uint32_t i, j, slot;
+
+    if (!blk->in_use) {
+        return;
+    }
+
+    /* purge the block's rows and columns from the worklist */
+    slot = blk - tbl->blocks;
+    for (i = 0, j = 0; i < tbl->num_work; i++) {
+        if (tbl->work[i].slot != slot) {
+            tbl->work[j++] = tbl->work[i];
+        }
+    }
+    tbl->num_work = j;
+
+    vqec_fec_acc_release_accs(fec, blk);
+    blk->in_use = FALSE;
+}
+
+/**
+ * Discard all parity accumulators and forget the learned block alignment.
+ */
+void
+vqec_fec_acc_reset (vqec_fec_t *fec)
+{
+    vqec_fec_acc_tbl_t *tbl;
+    uint32_t i;
+
+    if (!fec || !fec->acc) {
+        return;
+    }
+    tbl = fec->acc;
+
+    for (i = 0; i < VQEC_FEC_ACC_BLOCKS; i++) {
+        vqec_fec_acc_block_release(fec, &tbl->blocks[i]);
+    }
+    tbl->num_work = 0;
+    tbl->have_origin = FALSE;
+    tbl->have_row_ref = FALSE;
+    tbl->pinned = FALSE;
+}
+
+/**
+ * Start tracking blocks, now that their alignment is known. Blocks
+ * that may have had packets inserted into the PCM already are left to
+ * the gather-based decoder.
+ *
+ * @param[in] fec   pointer to fec module
+ */
+static void
+vqec_fec_acc_pin (vqec_fec_t *fec)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_pcm_t *pcm = fec->pcm;
+    vqec_seq_num_t highest;
+
+    highest = pcm->last_rx_seq_num;
+    if (vqec_pak_seq_get_num_paks(pcm->pak_seq) &&
+        vqec_seq_num_gt(pcm->tail, highest)) {
+        highest = pcm->tail;
+    }
+
+    tbl->pinned = TRUE;
+    tbl->slack = 0;
+    tbl->origin_blkno = 0;
+    tbl->start = vqec_next_seq_num(highest);
+
+    VQEC_DP_DEBUG(VQEC_DP_DEBUG_FEC,
+                  "FEC block alignment learned: base %u, L %d, D %d, "
+                  "tracking from %u\n",
+                  tbl->origin, tbl->L, tbl->D, tbl->start);
+}
+
+/**
+ * Learn the alignment of FEC blocks from the SN base of a received
+ * FEC packet, and verify it once it is known.
+ *
+ * @param[in] fec           pointer to fec module
+ * @param[in] sn_base32     SN base of the FEC packet
+ * @param[in] is_column_fec if column TRUE, if row FALSE
+ */
+static void
+vqec_fec_acc_learn (vqec_fec_t *fec,
+                    vqec_seq_num_t sn_base32,
+                    boolean is_column_fec)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    int32_t L, D, LD, d, lo, hi;
+
+    L = fec->fec_info.fec_l_value;
+    D = fec->fec_info.fec_d_value;
+    if (!L || !D) {
+        return;      /* geometry not learned yet */
+    }
+    if (tbl->L != L || tbl->D != D) {
+        vqec_fec_acc_reset(fec);
+        tbl->L = L;
+        tbl->D = D;
+    }
+    LD = L * D;
+
+    if (tbl->pinned) {
+        if (is_column_fec) {
+            d = vqec_fec_acc_mod(vqec_seq_num_sub(sn_base32, tbl->origin), LD);
+            if (d < L) {
+                return;
+            }
+        } else if (!vqec_fec_acc_mod(vqec_seq_num_sub(sn_base32, tbl->origin),
+                                     L)) {
+            return;
+        }
+        /* the stream's block alignment has changed: start over */
+        VQEC_DP_DEBUG(VQEC_DP_DEBUG_FEC,
+                      "FEC block alignment changed, sn_base %u\n",
+                      sn_base32);
+        vqec_fec_acc_reset(fec);
+    }
+
+    if (is_column_fec) {
+        if (!tbl->have_origin) {
+            tbl->origin = sn_base32;
+            tbl->slack = L - 1;
+            tbl->have_origin = TRUE;
+        } else {
+            d = vqec_fec_acc_mod(vqec_seq_num_sub(sn_base32, tbl->origin), LD);
+            if (d > LD / 2) {
+                d -= LD;
+            }
+            lo = (d - L + 1 > -(int32_t)tbl->slack) ? 
+                d - L + 1 : -(int32_t)tbl->slack;
+            hi = (d < 0) ? d : 0;
+            if (lo > hi) {
+                tbl->origin = sn_base32;
+                tbl->slack = L - 1;
+            } else {
+                tbl->origin += hi;
+                tbl->slack = hi - lo;
+            }
+        }
+    } else {
+        tbl->row_ref = sn_base32;
+        tbl->have_row_ref = TRUE;
+    }
+
+    if (tbl->have_origin && tbl->have_row_ref && tbl->slack) {
+        d = vqec_fec_acc_mod(vqec_seq_num_sub(tbl->origin, tbl->row_ref), L);
+        if (d <= tbl->slack) {
+            tbl->origin -= d;
+            tbl->slack = 0;
+        } else {
+            tbl->have_origin = FALSE;
+        }
+    }
+
+    if (tbl->have_origin && !tbl->slack) {
+        vqec_fec_acc_pin(fec);
+    }
+}
+
+/**
+ * Find the block containing a sequence number, optionally claiming a
+ * block slot for it. Claiming a slot evicts the oldest tracked block.
+ *
+ * @param[in] fec       pointer to fec module
+ * @param[in] seq_num   sequence number of a source packet
+ *
+ * @return the block, or NULL if the sequence number is not tracked
+ */
+static vqec_fec_acc_block_t *
+vqec_fec_acc_get_block (vqec_fec_t *fec, vqec_seq_num_t seq_num)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_fec_acc_block_t *blk;
+    vqec_seq_num_t base;
+    int32_t LD, diff, q, blkno;
+    uint32_t i;
+
+    LD = tbl->L * tbl->D;
+    diff = vqec_seq_num_sub(seq_num, tbl->origin);
+    q = diff / LD;
+    if (diff % LD < 0) {
+        q--;
+    }
+    base = tbl->origin + (vqec_seq_num_t)(q * LD);
+    if (vqec_seq_num_lt(base, tbl->start)) {
+        return NULL;
+    }
+
+    blkno = tbl->origin_blkno + q;
+    blk = &tbl->blocks[vqec_fec_acc_mod(blkno, VQEC_FEC_ACC_BLOCKS)];
+    if (blk->in_use) {
+        if (blk->blkno == blkno) {
+            return (blk->no_acc ? NULL : blk);
+        }
+        if (blk->blkno > blkno) {
+            return NULL;        /* older than the tracked window */
+        }
+        vqec_fec_acc_block_release(fec, blk);
+    }
+
+    blk->in_use = TRUE;
+    blk->no_acc = FALSE;
+    blk->blkno = blkno;
+    blk->base = base;
+    blk->num_present = 0;
+    memset(blk->col_present, 0, sizeof(blk->col_present));
+    memset(blk->row_present, 0, sizeof(blk->row_present));
+    memset(blk->col_num, 0, sizeof(blk->col_num));
+    memset(blk->row_num, 0, sizeof(blk->row_num));
+    for (i = 0; i < tbl->L && !blk->no_acc; i++) {
+        blk->col[i] = vqec_fec_acc_acquire(base + i);
+        blk->no_acc = !blk->col[i];
+    }
+    if (fec->fec_params.avail_streams == VQEC_FEC_STREAM_AVAIL_2D) {
+        for (i = 0; i < tbl->D && !blk->no_acc; i++) {
+            blk->row[i] = vqec_fec_acc_acquire(base + i * tbl->L);
+            blk->no_acc = !blk->row[i];
+        }
+    }
+
+    /* keep the origin near the stream, so that block math never wraps */
+    if (blkno > tbl->origin_blkno) {
+        tbl->origin = base;
+        tbl->origin_blkno = blkno;
+    }
+
+    /*
+     * If the pool is exhausted, the whole block is left to the gather
+     * decoder:  it keeps its slot, so that it is not claimed again with
+     * some of its packets missing from the accumulators.
+     */
+    if (blk->no_acc) {
+        vqec_fec_acc_release_accs(fec, blk);
+        return NULL;
+    }
+    return blk;
+}
+
+/**
+ * XOR the header bits, length and payload of one packet into an
+ * accumulator. Payloads shorter than the accumulator are zero-padded.
+ */
+static void
+vqec_fec_acc_fold (vqec_fec_acc_t *acc,
+                   const uint8_t *hdr,
+                   uint16_t len,
+                   char *payload,
+                   uint32_t payload_len)
+{
+    char *srcs[2];
+    uint32_t i;
+
+    if (payload_len > VQEC_FEC_ACC_MAX_PAYLOAD) {
+        acc->overflow = TRUE;
+        return;
+    }
+
+    for (i = 0; i < sizeof(acc->hdr_xor); i++) {
+        acc->hdr_xor[i] ^= hdr[i];
+    }
+    acc->len_xor ^= len;
+
+    if (payload_len > acc->payload_len) {
+        memset(acc->payload + acc->payload_len, 0,
+               payload_len - acc->payload_len);
+        acc->payload_len = payload_len;
+    }
+    srcs[0] = acc->payload;
+    srcs[1] = payload;
+    vqec_fec_xor_blocks(acc->payload, srcs, 2, payload_len);
+}
+
+/**
+ * Fold a source packet into an accumulator, recording where it came from.
+ */
+static inline void
+vqec_fec_acc_fold_src (vqec_fec_acc_t *acc,
+                       vqec_pak_t *pak,
+                       uint16_t len,
+                       char *payload,
+                       uint32_t payload_len)
+{
+    vqec_fec_acc_fold(acc, (const uint8_t *)pak->rtp, len,
+                      payload, payload_len);
+    if (!acc->have_src) {
+        acc->src_addr = pak->src_addr;
+        acc->src_port = pak->src_port;
+        acc->ssrc = pak->rtp->ssrc;
+        acc->have_src = TRUE;
+    }
+}
+
+/**
+ * Put a row or column on the decode worklist if it is ready: its FEC
+ * packet has been received, and either at most one source packet is
+ * missing or the accumulator cannot be used.
+ *
+ * @param[in] fec       pointer to fec module
+ * @param[in] blk       block of the row or column
+ * @param[in] is_row    TRUE for a row, FALSE for a column
+ * @param[in] idx       row or column number
+ */
+static void
+vqec_fec_acc_mark_ready (vqec_fec_t *fec,
+                         vqec_fec_acc_block_t *blk,
+                         boolean is_row,
+                         uint32_t idx)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_fec_acc_work_t *work;
+    vqec_fec_acc_t *acc;
+    uint32_t num, na;
+
+    if (is_row) {
+        acc = blk->row[idx];
+        num = blk->row_num[idx];
+        na = tbl->L;
+    } else {
+        acc = blk->col[idx];
+        num = blk->col_num[idx];
+        na = tbl->D;
+    }
+
+    if (!acc || !acc->fec_pak || acc->done || acc->queued ||
+        (num + 1 < na && !acc->overflow)) {
+        return;
+    }
+
+    VQEC_DP_ASSERT_FATAL(tbl->num_work < VQEC_FEC_ACC_MAX_WORK, "fec");
+    work = &tbl->work[tbl->num_work++];
+    work->slot = blk - tbl->blocks;
+    work->is_row = is_row;
+    work->idx = idx;
+    acc->queued = TRUE;
+}
+
+/**
+ * Fold a packet that has just been inserted into the PCM into the parity
+ * accumulators of its row and column.
+ */
+void
+vqec_fec_acc_pak_inserted (vqec_fec_t *fec, const vqec_pak_t *cpak)
+{
+    vqec_fec_acc_tbl_t *tbl;
+    vqec_fec_acc_block_t *blk;
+    vqec_pak_t *pak = (vqec_pak_t *)cpak;
+    uint32_t pos, col, row, content_len, payload_len;
+    char *payload;
+    uint16_t len;
+
+    if (!fec || !fec->acc || !fec->acc->pinned || !pak || !pak->rtp) {
+        return;
+    }
+    tbl = fec->acc;
+
+    blk = vqec_fec_acc_get_block(fec, pak->seq_num);
+    if (!blk) {
+        return;
+    }
+    pos = vqec_seq_num_sub(pak->seq_num, blk->base);
+    col = pos % tbl->L;
+    row = pos / tbl->L;
+
+    content_len = vqec_pak_get_content_len(pak);
+    if (content_len < sizeof(rtpfasttype_t) ||
+        pak->mpeg_payload_offset > content_len) {
+        blk->col[col]->overflow = TRUE;
+        if (blk->row[row]) {
+            blk->row[row]->overflow = TRUE;
+        }
+        vqec_fec_acc_mark_ready(fec, blk, FALSE, col);
+        vqec_fec_acc_mark_ready(fec, blk, TRUE, row);
+        return;
+    }
+    len = content_len - sizeof(rtpfasttype_t);
+    payload = vqec_pak_get_head_ptr(pak) + pak->mpeg_payload_offset;
+    payload_len = content_len - pak->mpeg_payload_offset;
+
+    if (blk->col_present[col] & (1 << row)) {
+        return;
+    }
+    blk->col_present[col] |= (1 << row);
+    blk->row_present[row] |= (1 << col);
+    blk->col_num[col]++;
+    blk->row_num[row]++;
+    blk->num_present++;
+
+    vqec_fec_acc_fold_src(blk->col[col], pak, len, payload, payload_len);
+    vqec_fec_acc_mark_ready(fec, blk, FALSE, col);
+    if (fec->fec_params.avail_streams == VQEC_FEC_STREAM_AVAIL_2D) {
+        vqec_fec_acc_fold_src(blk->row[row], pak, len,
+                              payload, payload_len);
+        vqec_fec_acc_mark_ready(fec, blk, TRUE, row);
+    }
+}
+
+/**
+ * Convert the sequence number of an FEC packet that bypasses the FEC
+ * pak_seq to 32 bits, and keep the receive tracking of its stream.
+ */
+static void
+vqec_fec_acc_update_rx_seq (vqec_fec_t *fec,
+                            vqec_pak_t *pak,
+                            boolean is_column_fec)
+{
+    vqec_seq_num_t *last_rx, *largest;
+    int32_t diff;
+
+    if (is_column_fec) {
+        last_rx = &fec->last_rx_seq_num_column;
+        largest = &fec->largest_seq_num_recved_column;
+    } else {
+        last_rx = &fec->last_rx_seq_num_row;
+        largest = &fec->largest_seq_num_recved_row;
+    }
+
+    pak->seq_num = vqec_seq_num_nearest_to_rtp_seq_num(*last_rx,
+                                                        pak->seq_num);
+    diff = vqec_seq_num_sub(pak->seq_num, *largest);
+    if (diff > 0) {
+        if (diff > 1 && diff <= VQEC_FEC_MAX_GAP_SIZE) {
+            fec->fec_stats.fec_gap_detected += diff - 1;
+        }
+        *largest = pak->seq_num;
+    } else {
+        VQEC_PAK_FLAGS_SET(&pak->flags, VQEC_PAK_FLAGS_RX_REORDERED);
+    }
+    *last_rx = pak->seq_num;
+}
+
+/**
+ * Fold a received FEC packet into the accumulator of its row or column.
+ * The header of the FEC packet must have been validated.
+ *
+ * @param[in] fec           pointer to fec module
+ * @param[in] pak           FEC packet
+ * @param[in] is_column_fec if column TRUE, if row FALSE
+ *
+ * @return TRUE if the packet was consumed by the accumulators, FALSE
+ * if it must be decoded by gathering source packets from the PCM.
+ */
+static boolean
+vqec_fec_acc_insert_fec_pak (vqec_fec_t *fec,
+                             vqec_pak_t *pak,
+                             boolean is_column_fec)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_fec_acc_block_t *blk;
+    vqec_fec_acc_t *acc;
+    fecfasttype_t *fec_hdr;
+    rtpfasttype_t fec_rtp_header;
+    vqec_seq_num_t sn_base32;
+    uint32_t pos, idx, content_len, hdr_len;
+
+    if (!tbl) {
+        return FALSE;
+    }
+
+    fec_hdr = (fecfasttype_t *)pak->fec_hdr;
+    if (FEC_TYPE(fec_hdr) != VQEC_FEC_TYPE_XOR) {
+        return FALSE;
+    }
+    sn_base32 = 
+        vqec_seq_num_nearest_to_rtp_seq_num(fec->pcm->last_rx_seq_num,
+                                            ntohs(fec_hdr->snbase_low_bits));
+    vqec_fec_acc_learn(fec, sn_base32, is_column_fec);
+    if (!tbl->pinned) {
+        return FALSE;
+    }
+
+    blk = vqec_fec_acc_get_block(fec, sn_base32);
+    if (!blk) {
+        return FALSE;
+    }
+    pos = vqec_seq_num_sub(sn_base32, blk->base);
+    if (is_column_fec) {
+        if (pos >= tbl->L || 
+            FEC_OFFSET(fec_hdr) != tbl->L || FEC_NA(fec_hdr) != tbl->D) {
+            return FALSE;
+        }
+        idx = pos;
+        acc = blk->col[idx];
+    } else {
+        if (pos % tbl->L ||
+            FEC_OFFSET(fec_hdr) != 1 || FEC_NA(fec_hdr) != tbl->L) {
+            return FALSE;
+        }
+        idx = pos / tbl->L;
+        acc = blk->row[idx];
+        if (!acc) {
+            return FALSE;
+        }
+    }
+
+    hdr_len = sizeof(rtpfasttype_t) + sizeof(fecfasttype_t);
+    content_len = vqec_pak_get_content_len(pak);
+    if (acc->overflow || content_len < hdr_len ||
+        content_len - hdr_len > VQEC_FEC_ACC_MAX_PAYLOAD) {
+        return FALSE;
+    }
+
+    vqec_fec_acc_update_rx_seq(fec, pak, is_column_fec);
+    if (acc->fec_pak || acc->done) {
+        fec->fec_stats.fec_duplicate_paks++;
+        return TRUE;
+    }
+
+    /* FEC RTP header for recovery, based on RFC 2733 */
+    memset(&fec_rtp_header, 0, sizeof(rtpfasttype_t));
+    fec_rtp_header.combined_bits = pak->rtp->combined_bits;
+    SET_RTP_PAYLOAD(&fec_rtp_header, FEC_PT_RECOVERY(fec_hdr));
+    fec_rtp_header.timestamp = fec_hdr->ts_recovery;
+
+    vqec_fec_acc_fold(acc, (const uint8_t *)&fec_rtp_header, 
+                      ntohs(fec_hdr->length_recovery),
+                      vqec_pak_get_head_ptr(pak) + hdr_len,
+                      content_len - hdr_len);
+
+    vqec_pak_ref(pak);
+    acc->fec_pak = pak;
+    pak->fec_touched = 0;
+    vqec_fec_acc_mark_ready(fec, blk, !is_column_fec, idx);
+    return TRUE;
+}
+
+/**
+ * Rebuild the single missing packet of a row or column from its
+ * accumulator and insert it into the PCM.
+ *
+ * @param[in] fec           pointer to fec module
+ * @param[in] acc           accumulator, with its FEC packet and all but
+ *                          one source packet folded in
+ * @param[in] lost_seq32    sequence number of the missing packet
+ *
+ * @return the decode result, as for vqec_fec_decode_basic()
+ */
+static vqec_fec_dec_error_t
+vqec_fec_acc_recover (vqec_fec_t *fec,
+                      vqec_fec_acc_t *acc,
+                      vqec_seq_num_t lost_seq32)
+{
+    vqec_pcm_t *pcm = fec->pcm;
+    vqec_pak_t *recovered;
+    uint32_t pkt_size, copy_len;
+
+    if (vqec_pak_seq_get_num_paks(pcm->pak_seq) &&
+        vqec_seq_num_lt(lost_seq32, pcm->head)) {
+        return VQEC_FEC_DEC_LATE_PAK;
+    }
+
+    pkt_size = acc->len_xor;
+    if (!acc->have_src || pkt_size > VQEC_FEC_ACC_MAX_PAYLOAD) {
+        return VQEC_FEC_DEC_FAILURE;
+    }
+
+    recovered = vqec_pak_alloc_with_particle();
+    if (recovered == NULL) {
+        return VQEC_FEC_DEC_MEM_ALLOC_WRONG;
+    }
+    recovered->head_offset = 0;
+    if (!vqec_pak_set_content_len(recovered, 
+                                  pkt_size + sizeof(rtpfasttype_t))) {
+        vqec_pak_free(recovered);
+        return VQEC_FEC_DEC_FAILURE;
+    }
+
+    recovered->rtp = (rtpfasttype_t *)vqec_pak_get_head_ptr(recovered);
+    memcpy(recovered->rtp, acc->hdr_xor, sizeof(acc->hdr_xor));
+    SET_RTP_VERSION(recovered->rtp, RTPVERSION);
+    recovered->rtp->sequence = 
+        htons(vqec_seq_num_to_rtp_seq_num(lost_seq32));
+    recovered->rtp->ssrc = acc->ssrc;
+
+    copy_len = (pkt_size < acc->payload_len) ? pkt_size : acc->payload_len;
+    memcpy(recovered->rtp + 1, acc->payload, copy_len);
+    if (copy_len < pkt_size) {
+        memset((char *)(recovered->rtp + 1) + copy_len, 0,
+               pkt_size - copy_len);
+    }
+
+    recovered->rtp_ts = ntohl(recovered->rtp->timestamp);
+    recovered->seq_num = lost_seq32;
+    recovered->mpeg_payload_offset = RTPHEADERBYTES(recovered->rtp);
+    recovered->type = VQEC_PAK_TYPE_REPAIR;
+    VQEC_PAK_FLAGS_SET(&recovered->flags, VQEC_PAK_FLAGS_AFTER_EC);
+    recovered->src_addr = acc->src_addr;
+    recovered->src_port = acc->src_port;
+
+    if (vqec_fec_rtp_hdr_validation(vqec_pak_get_head_ptr(recovered), 
+                                    vqec_pak_get_content_len(recovered)) 
+        != VQEC_DP_ERR_OK) {
+        vqec_pak_free(recovered);
+        return VQEC_FEC_DEC_RTP_VALIDATE_WRONG;
+    }
+
+    /*
+     * Mark the accumulator done before inserting: the insertion folds
+     * the recovered packet into this row / column and the crossing one.
+     */
+    acc->done = TRUE;
+    recovered->fec_touched = FEC_TOUCHED;
+    if (!vqec_pcm_insert_packets(pcm, &recovered, 1, FALSE, NULL)) {
+        vqec_pcm_log_tr135_overrun(pcm, 1);
+        VQEC_DP_SYSLOG_PRINT(ERROR,
+                             "Error upon inserting recovered FEC pkt"); 
+    }
+    vqec_pak_free(recovered);
+    return VQEC_FEC_DEC_OK;
+}
+
+/**
+ * Act on a row or column taken off the worklist: recover its missing
+ * packet, or release its FEC packet if nothing is missing or the
+ * accumulator cannot be used.
+ *
+ * @param[in] fec       pointer to fec module
+ * @param[in] blk       block of the row or column
+ * @param[in] is_row    TRUE for a row, FALSE for a column
+ * @param[in] idx       row or column number
+ */
+static void
+vqec_fec_acc_check (vqec_fec_t *fec,
+                    vqec_fec_acc_block_t *blk,
+                    boolean is_row,
+                    uint32_t idx)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_fec_stats_t *fec_stats = &fec->fec_stats;
+    vqec_fec_dec_error_t dec_res;
+    vqec_fec_acc_t *acc;
+    uint32_t present, num, na, i;
+    vqec_seq_num_t lost_seq32;
+    int32_t blkno;
+
+    if (is_row) {
+        acc = blk->row[idx];
+        present = blk->row_present[idx];
+        num = blk->row_num[idx];
+        na = tbl->L;
+    } else {
+        acc = blk->col[idx];
+        present = blk->col_present[idx];
+        num = blk->col_num[idx];
+        na = tbl->D;
+    }
+    acc->queued = FALSE;
+
+    if (!acc->fec_pak || acc->done) {
+        return;
+    }
+    blkno = blk->blkno;
+
+    if (num >= na) {
+        dec_res = VQEC_FEC_DEC_NOT_NEEDED;
+    } else if (acc->overflow) {
+        dec_res = VQEC_FEC_DEC_FAILURE;
+    } else if (num + 1 == na) {
+        for (i = 0; i < na && (present & (1 << i)); i++) {
+            ;
+        }
+        lost_seq32 = is_row ?
+            blk->base + idx * tbl->L + i : blk->base + i * tbl->L + idx;
+        dec_res = vqec_fec_acc_recover(fec, acc, lost_seq32);
+    } else {
+        return;
+    }
+
+    switch (dec_res) {
+        case VQEC_FEC_DEC_OK:
+            fec_stats->fec_recovered_paks++;
+            break;
+        case VQEC_FEC_DEC_NOT_NEEDED:
+            if (VQEC_DP_GET_DEBUG_FLAG(VQEC_DP_DEBUG_COLLECT_STATS)) {
+                fec_stats->fec_dec_not_needed++;
+            }
+            break;
+        case VQEC_FEC_DEC_LATE_PAK:
+            fec_stats->fec_late_paks++;
+            break;
+        default:
+            VQEC_DP_DEBUG(VQEC_DP_DEBUG_FEC, 
+                          "fec_drops_other, code: %d\n",
+                          dec_res);
+            fec_stats->fec_drops_other++;
+            break;
+    }
+
+    /*
+     * Inserting the recovered packet resets the accumulators if it
+     * flushed the PCM or bumped its sequence space after an underrun:
+     * the accumulator and its FEC packet have been released then.
+     */
+    if (!blk->in_use || blk->blkno != blkno ||
+        (is_row ? blk->row[idx] : blk->col[idx]) != acc) {
+        return;
+    }
+    acc->done = TRUE;
+    if (acc->fec_pak) {
+        vqec_pak_free(acc->fec_pak);
+        acc->fec_pak = NULL;
+    }
+}
+
+/**
+ * Decode every row and column on the worklist. In 2-D FEC, a recovered
+ * packet is inserted into the PCM, which folds it into its crossing row
+ * or column; if that one becomes ready it is queued in turn, so the
+ * iteration ends when the worklist is empty.
+ *
+ * @param[in] fec   pointer to fec module
+ */
+static void
+vqec_fec_acc_decode (vqec_fec_t *fec)
+{
+    vqec_fec_acc_tbl_t *tbl = fec->acc;
+    vqec_fec_acc_work_t work;
+
+    if (!tbl) {
+        return;
+    }
+
+    while (tbl->num_work) {
+        work = tbl->work[--tbl->num_work];
+        vqec_fec_acc_check(fec, &tbl->blocks[work.slot],
+                           work.is_row, work.idx);
+    }
+}
+
 /**
  * fec event process each fec packet,
  * This function validate RTP header and FEC header of a FEC packet
@@ -1784,6 +2956,12 @@ boolean fec_event_handler_internal_process_pak (boolean is_column_fec,
     pak->rtp_ts = ntohl(pak->rtp->timestamp);  /* save rtp timestamp in pak */
 
     pak->fec_touched = 0;
+
+    /* fold into the parity accumulators if its block is tracked */
+    if (vqec_fec_acc_insert_fec_pak(fec, pak, is_column_fec)) {
+        return TRUE;
+    }
+
     /* insert packet to fec module */
     if (vqec_fec_insert_packet(fec, pak, is_column_fec) 
        != VQEC_FEC_INSERT_OK) {
@@ -1820,7 +2998,7 @@ UT_STATIC void fec_trigger_decoding (boolean is_column_fec,
             for (i=start; vqec_seq_num_le(i,end); i=vqec_next_seq_num(i)) {
                 fec_pak = vqec_pak_seq_find(fec->fec_pak_seq_column, i);
                 if (fec_pak) {
-                    dec_res = vqec_fec_decode_basic(fec,fec_pak);
+                    dec_res = vqec_fec_decode(fec,fec_pak);
                     vqec_fec_parse_dec_error(dec_res, TRUE, fec,fec_pak);
                 }
             } /*for()*/
@@ -1847,7 +3025,7 @@ UT_STATIC void fec_trigger_decoding (boolean is_column_fec,
                 for (i=start; vqec_seq_num_le(i,end);i=vqec_next_seq_num(i)) {
                     fec_pak = vqec_pak_seq_find(fec->fec_pak_seq_row, i);
                     if (fec_pak) {
-                        dec_res = vqec_fec_decode_basic(fec,fec_pak);
+                        dec_res = vqec_fec_decode(fec,fec_pak);
                         vqec_fec_parse_dec_error(dec_res, FALSE, fec,fec_pak);
                     }
                 } /*for()*/
@@ -1880,7 +3058,7 @@ UT_STATIC void fec_trigger_decoding (boolean is_column_fec,
                          i=vqec_next_seq_num(i)) {
                         fec_pak = vqec_pak_seq_find(fec->fec_pak_seq_column, i);
                         if (fec_pak) {
-                            dec_res = vqec_fec_decode_basic(fec,fec_pak);
+                            dec_res = vqec_fec_decode(fec,fec_pak);
                             vqec_fec_parse_dec_error(dec_res,TRUE,fec,fec_pak);
                             /* if a packet is decoded, need to do iteration */
                             if (dec_res ==  VQEC_FEC_DEC_OK) {
@@ -1905,7 +3083,7 @@ UT_STATIC void fec_trigger_decoding (boolean is_column_fec,
                             fec_pak = vqec_pak_seq_find(
                                 fec->fec_pak_seq_row, i);
                             if (fec_pak) {
-                                dec_res = vqec_fec_decode_basic(fec,fec_pak);
+                                dec_res = vqec_fec_decode(fec,fec_pak);
                                 vqec_fec_parse_dec_error(dec_res, FALSE, 
                                                          fec,fec_pak);
                                 /* if a packet is decoded, do iteration */
@@ -2035,7 +3213,7 @@ boolean vqec_fec_receive_packet (vqec_fec_t *fec,
                 if (!FEC_E_BIT(fec_hdr)) {
                     return FALSE; /* not supported in COP#3r2*/
                 }
-                if (FEC_TYPE(fec_hdr)!= VQEC_FEC_TYPE_XOR) {
+                if (!vqec_fec_engine_get(FEC_TYPE(fec_hdr))) {
                     return FALSE; /* not supported in COP#3r2 */
                 }
 
@@ -2079,6 +3257,7 @@ boolean vqec_fec_receive_packet (vqec_fec_t *fec,
      * fec decoding is triggered
      */
     fec_trigger_decoding(is_column_fec, fec);
+    vqec_fec_acc_decode(fec);
 
     return TRUE;
 }
@@ -88,11 +88,12 @@ typedef enum vqec_fec_stream_avail_ {
 } vqec_fec_stream_avail_t;
 
 /**
- * define the fec types, CoP#3 only does XOR,
- * define this enum for future easy extension
+ * define the fec types, as carried in the type field of the FEC header;
+ * CoP#3 only does XOR, Reed-Solomon is described in vqec_fec_rs.h
  */ 
 typedef enum vqec_fec_type_ {
     VQEC_FEC_TYPE_XOR =  0,
+    VQEC_FEC_TYPE_RS = 2,
     VQEC_FEC_TYPE_UNKNOWN,
 } vqec_fec_type_t;
 
@@ -147,6 +148,115 @@ typedef struct vqec_fec_stats_ {        /*!< stats for FEC module */
     uint64_t fec_gap_detected;          /*!< fec gap detected */
 } vqec_fec_stats_t;
 
+/**
+ * Number of FEC blocks (L x D matrices) for which parity is accumulated
+ * concurrently. The FEC packets of a block arrive up to one block after
+ * its source packets; the extra block absorbs reordering.
+ */
+#define VQEC_FEC_ACC_BLOCKS 3
+
+/**
+ * Accumulators set aside per FEC object. The accumulators are shared by
+ * all FEC objects, and each tracked block takes one per column, plus one
+ * per row with 2-D FEC. This covers all tracked blocks of a 10 x 10 2-D
+ * or a 20 x D 1-D matrix; a block for which no accumulators are left is
+ * decoded by gathering.
+ */
+#define VQEC_FEC_ACC_PER_FEC (VQEC_FEC_ACC_BLOCKS * 20)
+
+/**
+ * Largest source / FEC payload that can be accumulated. A row or column
+ * carrying a larger payload is left to the gather-based decoder.
+ */
+#define VQEC_FEC_ACC_MAX_PAYLOAD 1500
+
+/**
+ * Running XOR parity of one row or column of an FEC block.
+ *
+ * Every source packet is folded in as it is inserted into the PCM, and
+ * the FEC packet is folded in when it is received. Once the FEC packet
+ * is present and exactly one source packet is missing, the accumulator
+ * holds the missing packet's header bits, length and payload. Which
+ * source packets have been folded in is recorded in the block's matrix.
+ */
+typedef struct vqec_fec_acc_ {
+    vqec_seq_num_t sn_base;      /* first source packet of row / column */
+    boolean overflow;            /* payload too large, accumulator unusable */
+    boolean done;                /* recovered, or recovery not needed */
+    boolean queued;              /* on the decode worklist */
+    boolean have_src;            /* src_addr, src_port, ssrc are valid */
+    vqec_pak_t *fec_pak;         /* FEC packet of this row / column */
+    uint8_t hdr_xor[8];          /* XOR of the first 8 RTP header bytes */
+    uint16_t len_xor;            /* XOR of the protected lengths */
+    uint16_t payload_len;        /* longest payload folded in so far */
+    struct in_addr src_addr;     /* source of a member, for recovery */
+    uint16_t src_port;
+    uint32_t ssrc;
+    char payload[VQEC_FEC_ACC_MAX_PAYLOAD];
+} vqec_fec_acc_t;
+
+/**
+ * Matrix descriptor and accumulators of one L x D FEC block. Source
+ * packet (r, c) is base + r * L + c; it belongs to column c and row r.
+ * The presence masks are kept for both dimensions, whichever FEC
+ * streams are available, so that a row or column can be checked for
+ * readiness without looking at the PCM. The accumulators are acquired
+ * from a shared pool when the block is claimed, for the L columns and,
+ * with 2-D FEC, the D rows of the block; the others are NULL.
+ */
+typedef struct vqec_fec_acc_block_ {
+    boolean in_use;
+    boolean no_acc;              /* no accumulators, decoded by gathering */
+    int32_t blkno;               /* block number, relative to the table */
+    vqec_seq_num_t base;         /* first source packet of the block */
+    uint32_t num_present;        /* source packets present in the block */
+    uint32_t col_present[MAX_L]; /* bit r: source (r, c) present */
+    uint32_t row_present[MAX_D]; /* bit c: source (r, c) present */
+    uint8_t col_num[MAX_L];      /* number of bits set in col_present */
+    uint8_t row_num[MAX_D];      /* number of bits set in row_present */
+    vqec_fec_acc_t *col[MAX_L];  /* column accumulators, D packets each */
+    vqec_fec_acc_t *row[MAX_D];  /* row accumulators, L packets each */
+} vqec_fec_acc_block_t;
+
+/**
+ * Entry of the decode worklist: a row or column whose FEC packet has
+ * been received and which is missing at most one source packet.
+ */
+typedef struct vqec_fec_acc_work_ {
+    uint8_t slot;                /* index into the table's blocks */
+    uint8_t is_row;              /* TRUE for a row, FALSE for a column */
+    uint8_t idx;                 /* row or column number */
+} vqec_fec_acc_work_t;
+
+#define VQEC_FEC_ACC_MAX_WORK (VQEC_FEC_ACC_BLOCKS * (MAX_L + MAX_D))
+
+/**
+ * Per-FEC accumulator table. The block geometry (L, D) comes from the
+ * FEC headers; the alignment of blocks in the sequence space is learned
+ * from the SN base of received FEC packets. Until the alignment is known
+ * ("pinned"), and for blocks that started before that, FEC packets are
+ * decoded by gathering source packets from the PCM.
+ */
+typedef struct vqec_fec_acc_tbl_ {
+    uint8_t L;
+    uint8_t D;
+    boolean have_origin;         /* origin / slack constrain the alignment */
+    boolean have_row_ref;        /* row_ref constrains alignment mod L */
+    boolean pinned;              /* block alignment is known */
+    uint16_t slack;              /* block base in [origin - slack, origin] */
+    vqec_seq_num_t origin;       /* a block base, once pinned */
+    int32_t origin_blkno;        /* block number of origin */
+    vqec_seq_num_t row_ref;      /* SN base of a row FEC packet */
+    vqec_seq_num_t start;        /* blocks based before this not tracked */
+    vqec_fec_acc_block_t blocks[VQEC_FEC_ACC_BLOCKS];
+    /*
+     * Rows and columns ready for decoding; each is queued at most once,
+     * and entries of a block are purged when the block is released.
+     */
+    uint16_t num_work;
+    vqec_fec_acc_work_t work[VQEC_FEC_ACC_MAX_WORK];
+} vqec_fec_acc_tbl_t;
+
 /**
  * fec module main structure defination
  */
@@ -203,6 +313,7 @@ typedef struct vqec_fec_ {
     uint8_t saved_L;
     uint8_t saved_D;
 
+    vqec_fec_acc_tbl_t *acc;             /* parity accumulators, or NULL */
 } vqec_fec_t;
 
 extern boolean g_fec_enabled;
@@ -299,6 +410,25 @@ boolean vqec_fec_receive_packet (vqec_fec_t *fec,
                                  vqec_pak_t *pak,
                                  uint32_t handle);
 
+/**
+ * Fold a packet that has just been inserted into the PCM into the parity
+ * accumulators of its row and column. Called by the PCM for primary,
+ * repair and FEC-recovered packets alike.
+ *
+ * @param[in] fec   pointer to fec module, may be NULL
+ * @param[in] pak   packet inserted into the PCM
+ */
+void vqec_fec_acc_pak_inserted(vqec_fec_t *fec, const vqec_pak_t *pak);
+
+/**
+ * Discard all parity accumulators and forget the learned block alignment.
+ * Called when the PCM sequence number space is discontinuous (flush,
+ * sequence number bump).
+ *
+ * @param[in] fec   pointer to fec module, may be NULL
+ */
+void vqec_fec_acc_reset(vqec_fec_t *fec);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,242 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_fec_rs.c - Reed-Solomon erasure code over GF(2^8) for FEC.
+ *
+ * Multiplication uses log / antilog tables; multiplying a buffer by a
+ * constant first expands the constant into a 256-entry product table,
+ * so each byte then costs one lookup and one XOR. Coefficients of 1,
+ * which make up all of parity 0 and member 0, use the XOR kernels.
+ */
+
+#include "vqec_fec_rs.h"
+#include "vqec_fec_xor.h"
+
+#define VQEC_FEC_RS_POLY 0x11d          /* x^8 + x^4 + x^3 + x^2 + 1 */
+
+static uint8_t s_vqec_fec_rs_exp[2 * 255];
+static uint8_t s_vqec_fec_rs_log[256];
+static boolean s_vqec_fec_rs_ready = FALSE;
+
+/**
+ * Build the GF(2^8) tables.
+ */
+void
+vqec_fec_rs_init (void)
+{
+    uint32_t i, x;
+
+    if (s_vqec_fec_rs_ready) {
+        return;
+    }
+
+    x = 1;
+    for (i = 0; i < 255; i++) {
+        s_vqec_fec_rs_exp[i] = (uint8_t)x;
+        s_vqec_fec_rs_exp[i + 255] = (uint8_t)x;
+        s_vqec_fec_rs_log[x] = (uint8_t)i;
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= VQEC_FEC_RS_POLY;
+        }
+    }
+    s_vqec_fec_rs_log[0] = 0;   /* undefined, never used */
+    s_vqec_fec_rs_ready = TRUE;
+}
+
+static inline uint8_t
+vqec_fec_rs_mul (uint8_t a, uint8_t b)
+{
+    if (!a || !b) {
+        return (0);
+    }
+    return (s_vqec_fec_rs_exp[s_vqec_fec_rs_log[a] + s_vqec_fec_rs_log[b]]);
+}
+
+static inline uint8_t
+vqec_fec_rs_inv (uint8_t a)
+{
+    return (s_vqec_fec_rs_exp[255 - s_vqec_fec_rs_log[a]]);
+}
+
+/**
+ * Expand c into a table of its products with every byte value.
+ */
+static void
+vqec_fec_rs_mul_table (uint8_t *tbl, uint8_t c)
+{
+    uint32_t x, log_c;
+
+    tbl[0] = 0;
+    log_c = s_vqec_fec_rs_log[c];
+    for (x = 1; x < 256; x++) {
+        tbl[x] = s_vqec_fec_rs_exp[log_c + s_vqec_fec_rs_log[x]];
+    }
+}
+
+/**
+ * Coefficient of a member in a parity packet.
+ */
+uint8_t
+vqec_fec_rs_coef (uint8_t index, uint8_t member)
+{
+    return (s_vqec_fec_rs_exp[(index * member) % 255]);
+}
+
+/**
+ * dst ^= c * src over GF(2^8).
+ */
+void
+vqec_fec_rs_mul_add (char *dst, const char *src, uint8_t c, uint32_t len)
+{
+    uint8_t tbl[256];
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    char *srcs[2];
+    uint32_t k;
+
+    if (!c || !len) {
+        return;
+    }
+    if (c == 1 && len <= 0xffff) {
+        srcs[0] = dst;
+        srcs[1] = (char *)src;
+        vqec_fec_xor_blocks(dst, srcs, 2, len);
+        return;
+    }
+
+    vqec_fec_rs_mul_table(tbl, c);
+    for (k = 0; k + 4 <= len; k += 4) {
+        d[k] ^= tbl[s[k]];
+        d[k + 1] ^= tbl[s[k + 1]];
+        d[k + 2] ^= tbl[s[k + 2]];
+        d[k + 3] ^= tbl[s[k + 3]];
+    }
+    for (; k < len; k++) {
+        d[k] ^= tbl[s[k]];
+    }
+}
+
+/**
+ * buf *= c over GF(2^8), c non-zero.
+ */
+static void
+vqec_fec_rs_scale (char *buf, uint8_t c, uint32_t len)
+{
+    uint8_t tbl[256];
+    uint8_t *b = (uint8_t *)buf;
+    uint32_t k;
+
+    if (c == 1) {
+        return;
+    }
+    vqec_fec_rs_mul_table(tbl, c);
+    for (k = 0; k < len; k++) {
+        b[k] = tbl[b[k]];
+    }
+}
+
+/**
+ * Build the fixed part of a protected vector.
+ */
+void
+vqec_fec_rs_hdr_vector (uint8_t *vec, const uint8_t *rtp_hdr, uint16_t len)
+{
+    memcpy(vec, rtp_hdr, 8);
+    vec[0] &= 0x3f;                 /* version bits are not protected */
+    vec[8] = (uint8_t)(len >> 8);
+    vec[9] = (uint8_t)len;
+    vec[10] = 0;
+    vec[11] = 0;
+}
+
+/**
+ * Compute a parity packet.
+ */
+void
+vqec_fec_rs_encode (char *parity,
+                    char **members,
+                    uint8_t num_members,
+                    uint8_t index,
+                    uint32_t len)
+{
+    uint8_t i;
+
+    memset(parity, 0, len);
+    for (i = 0; i < num_members; i++) {
+        vqec_fec_rs_mul_add(parity, members[i],
+                            vqec_fec_rs_coef(index, i), len);
+    }
+}
+
+/**
+ * Solve for the lost members of a row or column, by Gauss-Jordan
+ * elimination of the num_lost x num_lost system
+ *
+ *     syn[r] = sum over m of coef(parity_index[r], lost[m]) * X[m]
+ *
+ * applying every row operation to the syndrome buffers as well. Rows
+ * are never swapped; the pivot row of each column is recorded instead.
+ */
+boolean
+vqec_fec_rs_solve (char **syn,
+                   const uint8_t *parity_index,
+                   const uint8_t *lost,
+                   uint8_t num_lost,
+                   uint32_t len,
+                   uint8_t *which)
+{
+    uint8_t a[VQEC_FEC_RS_MAX_PARITY][VQEC_FEC_RS_MAX_PARITY];
+    boolean used[VQEC_FEC_RS_MAX_PARITY];
+    uint8_t r, r2, m, c, inv, f;
+
+    if (!syn || !parity_index || !lost || !which ||
+        !num_lost || num_lost > VQEC_FEC_RS_MAX_PARITY) {
+        return (FALSE);
+    }
+
+    for (r = 0; r < num_lost; r++) {
+        used[r] = FALSE;
+        for (m = 0; m < num_lost; m++) {
+            a[r][m] = vqec_fec_rs_coef(parity_index[r], lost[m]);
+        }
+    }
+
+    for (m = 0; m < num_lost; m++) {
+        for (r = 0; r < num_lost && (used[r] || !a[r][m]); r++) {
+            ;
+        }
+        if (r == num_lost) {
+            return (FALSE);     /* singular for these parity indices */
+        }
+        used[r] = TRUE;
+        which[m] = r;
+
+        /* normalize the pivot row */
+        inv = vqec_fec_rs_inv(a[r][m]);
+        for (c = 0; c < num_lost; c++) {
+            a[r][c] = vqec_fec_rs_mul(a[r][c], inv);
+        }
+        vqec_fec_rs_scale(syn[r], inv, len);
+
+        /* eliminate column m from every other row */
+        for (r2 = 0; r2 < num_lost; r2++) {
+            f = a[r2][m];
+            if (r2 == r || !f) {
+                continue;
+            }
+            for (c = 0; c < num_lost; c++) {
+                a[r2][c] ^= vqec_fec_rs_mul(f, a[r][c]);
+            }
+            vqec_fec_rs_mul_add(syn[r2], syn[r], f, len);
+        }
+    }
+
+    return (TRUE);
+}
@@ -0,0 +1,142 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_fec_rs.h - Reed-Solomon erasure code over GF(2^8) for FEC.
+ *
+ * The Reed-Solomon FEC streams use the same layout as the XOR streams:
+ * every row or column of an L x D block is protected, but by up to
+ * VQEC_FEC_RS_MAX_PARITY FEC packets instead of one. The FEC packets of
+ * a row or column share an SN base and are told apart by the index
+ * field of the FEC header. Byte k of parity packet j is
+ *
+ *     P_j[k] = sum over members i of g^(i * j) * M_i[k]
+ *
+ * in GF(2^8) (polynomial 0x11d, generator g = 2), where member i is the
+ * i-th source packet of the row or column. Parity 0 is the XOR parity.
+ * Any e members can be recovered from e parity packets.
+ *
+ * The protected fields are those of the XOR streams, with the RTP
+ * version bits cleared, so that every byte of a protected packet is
+ * independent of the others. A packet is protected as the vector:
+ *
+ *     bytes 0 - 7    first 8 bytes of the RTP header, version bits zero
+ *     bytes 8 - 9    length recovery (payload length, network order)
+ *     bytes 10 - 11  zero
+ *     bytes 12 -     payload, zero-padded to the longest in the block
+ *
+ * so that a recovered vector is laid out as an RTP packet, with the
+ * SSRC field holding the length.
+ *
+ * The arithmetic is table-based and safe in kernel-mode builds of the
+ * dataplane.
+ */
+
+#ifndef __VQEC_FEC_RS_H__
+#define __VQEC_FEC_RS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <utils/vam_types.h>
+
+/**
+ * Maximum number of FEC packets per row or column; the index field
+ * of the FEC header is 3 bits.
+ */
+#define VQEC_FEC_RS_MAX_PARITY 8
+
+/**
+ * Size of the fixed part of the protected vector.
+ */
+#define VQEC_FEC_RS_HDR_BYTES 12
+
+/**
+ * Build the GF(2^8) tables. It is safe to call this function more
+ * than once.
+ */
+void vqec_fec_rs_init(void);
+
+/**
+ * Coefficient of a member in a parity packet, g^(member * index).
+ *
+ * @param[in] index   parity index, 0 to VQEC_FEC_RS_MAX_PARITY - 1
+ * @param[in] member  position of the member in its row or column
+ */
+uint8_t vqec_fec_rs_coef(uint8_t index, uint8_t member);
+
+/**
+ * dst[k] ^= c * src[k] over GF(2^8), for k in [0, len).
+ *
+ * @param[in,out] dst  destination buffer
+ * @param[in]     src  source buffer, must not overlap dst
+ * @param[in]     c    coefficient
+ * @param[in]     len  number of bytes
+ */
+void vqec_fec_rs_mul_add(char *dst, const char *src, uint8_t c, uint32_t len);
+
+/**
+ * Build the 12-byte fixed part of the protected vector of a source
+ * packet, or of a FEC packet once its recovery fields have been laid
+ * out as an RTP header.
+ *
+ * @param[out] vec      VQEC_FEC_RS_HDR_BYTES bytes
+ * @param[in]  rtp_hdr  first 8 bytes of the RTP header
+ * @param[in]  len      payload length (or length recovery), host order
+ */
+void vqec_fec_rs_hdr_vector(uint8_t *vec, const uint8_t *rtp_hdr,
+                            uint16_t len);
+
+/**
+ * Compute parity packet index over num_members members of len bytes:
+ * parity = sum of vqec_fec_rs_coef(index, i) * members[i].
+ *
+ * @param[out] parity       len bytes
+ * @param[in]  members      num_members buffers of len bytes
+ * @param[in]  num_members  number of members
+ * @param[in]  index        parity index
+ * @param[in]  len          number of bytes
+ */
+void vqec_fec_rs_encode(char *parity,
+                        char **members,
+                        uint8_t num_members,
+                        uint8_t index,
+                        uint32_t len);
+
+/**
+ * Solve for the lost members of a row or column.
+ *
+ * On entry, syn[r] holds the syndrome of parity packet parity_index[r]:
+ * the parity packet with the contribution of every received member
+ * added in (vqec_fec_rs_mul_add() with vqec_fec_rs_coef()). On success,
+ * syn[which[m]] holds lost member lost[m]. The buffers are transformed
+ * in place; no other memory is used.
+ *
+ * @param[in,out] syn           num_lost syndrome buffers of len bytes
+ * @param[in]     parity_index  index of the parity of each syndrome
+ * @param[in]     lost          positions of the lost members
+ * @param[in]     num_lost      number of lost members (and syndromes)
+ * @param[in]     len           number of bytes
+ * @param[out]    which         buffer holding each lost member
+ *
+ * @return TRUE on success, FALSE if the parity indices do not allow
+ * these members to be recovered
+ */
+boolean vqec_fec_rs_solve(char **syn,
+                          const uint8_t *parity_index,
+                          const uint8_t *lost,
+                          uint8_t num_lost,
+                          uint32_t len,
+                          uint8_t *which);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __VQEC_FEC_RS_H__ */
@@ -0,0 +1,319 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_fec_xor.c - XOR parity kernels used by the FEC decoder.
+ *
+ * Every kernel walks the buffers lane by lane; for each lane, the lane
+ * of the first source is loaded into an accumulator, the same lane of
+ * every other source is XOR'ed in, and the accumulator is stored once
+ * to the destination. Wide kernels hand the remaining tail of the
+ * buffer to the next narrower kernel, down to single bytes.
+ */
+
+#include "vqec_fec_xor.h"
+
+/*
+ * Vector kernels are only built for user-space dataplane builds. They are
+ * built with per-function target attributes so that the rest of the
+ * library is not compiled for a newer instruction set than the baseline
+ * of the platform; the kernel is then chosen at runtime.
+ */
+#if !defined(__KERNEL__) && !defined(VQEC_FEC_XOR_NO_SIMD)
+
+#if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define VQEC_FEC_XOR_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VQEC_FEC_XOR_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#endif /* !__KERNEL__ && !VQEC_FEC_XOR_NO_SIMD */
+
+typedef void (*vqec_fec_xor_fn_t)(char *dst,
+                                  char **srcs,
+                                  uint16_t num_srcs,
+                                  uint32_t off,
+                                  uint32_t len);
+
+/**
+ * Portable kernel: native machine words, then bytes for the tail.
+ * memcpy() is used for the word accesses so that unaligned payloads are
+ * safe on strict-alignment targets (MIPS, SH4); compilers reduce it to
+ * a plain load / store where that is legal.
+ */
+static void
+vqec_fec_xor_scalar (char *dst,
+                     char **srcs,
+                     uint16_t num_srcs,
+                     uint32_t off,
+                     uint32_t len)
+{
+    unsigned long acc, word;
+    uint8_t bacc;
+    uint16_t i;
+
+    for (; off + sizeof(acc) <= len; off += sizeof(acc)) {
+        memcpy(&acc, srcs[0] + off, sizeof(acc));
+        for (i = 1; i < num_srcs; i++) {
+            memcpy(&word, srcs[i] + off, sizeof(word));
+            acc ^= word;
+        }
+        memcpy(dst + off, &acc, sizeof(acc));
+    }
+
+    for (; off < len; off++) {
+        bacc = (uint8_t)srcs[0][off];
+        for (i = 1; i < num_srcs; i++) {
+            bacc ^= (uint8_t)srcs[i][off];
+        }
+        dst[off] = (char)bacc;
+    }
+}
+
+#ifdef VQEC_FEC_XOR_HAVE_X86
+/**
+ * SSE2 kernel: two 16-byte lanes per iteration to keep two independent
+ * XOR chains in flight, then a single 16-byte lane, then scalar.
+ */
+__attribute__((target("sse2"))) static void
+vqec_fec_xor_sse2 (char *dst,
+                   char **srcs,
+                   uint16_t num_srcs,
+                   uint32_t off,
+                   uint32_t len)
+{
+    __m128i acc0, acc1;
+    uint16_t i;
+
+    for (; off + 2 * sizeof(__m128i) <= len; off += 2 * sizeof(__m128i)) {
+        acc0 = _mm_loadu_si128((const __m128i *)(srcs[0] + off));
+        acc1 = _mm_loadu_si128((const __m128i *)(srcs[0] + off +
+                                                 sizeof(__m128i)));
+        for (i = 1; i < num_srcs; i++) {
+            acc0 = _mm_xor_si128(acc0,
+                      _mm_loadu_si128((const __m128i *)(srcs[i] + off)));
+            acc1 = _mm_xor_si128(acc1,
+                      _mm_loadu_si128((const __m128i *)(srcs[i] + off +
+                                                        sizeof(__m128i))));
+        }
+        _mm_storeu_si128((__m128i *)(dst + off), acc0);
+        _mm_storeu_si128((__m128i *)(dst + off + sizeof(__m128i)), acc1);
+    }
+
+    if (off + sizeof(__m128i) <= len) {
+        acc0 = _mm_loadu_si128((const __m128i *)(srcs[0] + off));
+        for (i = 1; i < num_srcs; i++) {
+            acc0 = _mm_xor_si128(acc0,
+                      _mm_loadu_si128((const __m128i *)(srcs[i] + off)));
+        }
+        _mm_storeu_si128((__m128i *)(dst + off), acc0);
+        off += sizeof(__m128i);
+    }
+
+    vqec_fec_xor_scalar(dst, srcs, num_srcs, off, len);
+}
+
+/**
+ * AVX2 kernel: 32-byte lanes, two per iteration; the tail (< 64 bytes)
+ * is completed by the SSE2 kernel, which AVX2 hardware always supports.
+ */
+__attribute__((target("avx2"))) static void
+vqec_fec_xor_avx2 (char *dst,
+                   char **srcs,
+                   uint16_t num_srcs,
+                   uint32_t off,
+                   uint32_t len)
+{
+    __m256i acc0, acc1;
+    uint16_t i;
+
+    for (; off + 2 * sizeof(__m256i) <= len; off += 2 * sizeof(__m256i)) {
+        acc0 = _mm256_loadu_si256((const __m256i *)(srcs[0] + off));
+        acc1 = _mm256_loadu_si256((const __m256i *)(srcs[0] + off +
+                                                    sizeof(__m256i)));
+        for (i = 1; i < num_srcs; i++) {
+            acc0 = _mm256_xor_si256(acc0,
+                      _mm256_loadu_si256((const __m256i *)(srcs[i] + off)));
+            acc1 = _mm256_xor_si256(acc1,
+                      _mm256_loadu_si256((const __m256i *)(srcs[i] + off +
+                                                           sizeof(__m256i))));
+        }
+        _mm256_storeu_si256((__m256i *)(dst + off), acc0);
+        _mm256_storeu_si256((__m256i *)(dst + off + sizeof(__m256i)), acc1);
+    }
+
+    /* avoid the AVX-to-SSE transition penalty before the SSE2 tail */
+    _mm256_zeroupper();
+    vqec_fec_xor_sse2(dst, srcs, num_srcs, off, len);
+}
+#endif /* VQEC_FEC_XOR_HAVE_X86 */
+
+#ifdef VQEC_FEC_XOR_HAVE_NEON
+/**
+ * NEON kernel: two 16-byte lanes per iteration, then scalar.
+ */
+static void
+vqec_fec_xor_neon (char *dst,
+                   char **srcs,
+                   uint16_t num_srcs,
+                   uint32_t off,
+                   uint32_t len)
+{
+    uint8x16_t acc0, acc1;
+    uint16_t i;
+
+    for (; off + 2 * sizeof(uint8x16_t) <= len;
+         off += 2 * sizeof(uint8x16_t)) {
+        acc0 = vld1q_u8((const uint8_t *)(srcs[0] + off));
+        acc1 = vld1q_u8((const uint8_t *)(srcs[0] + off +
+                                          sizeof(uint8x16_t)));
+        for (i = 1; i < num_srcs; i++) {
+            acc0 = veorq_u8(acc0, vld1q_u8((const uint8_t *)(srcs[i] + off)));
+            acc1 = veorq_u8(acc1,
+                            vld1q_u8((const uint8_t *)(srcs[i] + off +
+                                                       sizeof(uint8x16_t))));
+        }
+        vst1q_u8((uint8_t *)(dst + off), acc0);
+        vst1q_u8((uint8_t *)(dst + off + sizeof(uint8x16_t)), acc1);
+    }
+
+    vqec_fec_xor_scalar(dst, srcs, num_srcs, off, len);
+}
+#endif /* VQEC_FEC_XOR_HAVE_NEON */
+
+static const char *const s_vqec_fec_xor_impl_names[VQEC_FEC_XOR_IMPL_NUM] = {
+    "scalar",
+    "sse2",
+    "avx2",
+    "neon",
+};
+
+static vqec_fec_xor_fn_t s_vqec_fec_xor_fns[VQEC_FEC_XOR_IMPL_NUM];
+static boolean s_vqec_fec_xor_probed = FALSE;
+static vqec_fec_xor_impl_t s_vqec_fec_xor_impl = VQEC_FEC_XOR_IMPL_SCALAR;
+static vqec_fec_xor_fn_t s_vqec_fec_xor_fn = vqec_fec_xor_scalar;
+
+/**
+ * Fill in the table of kernels supported by the running CPU.
+ */
+static void
+vqec_fec_xor_probe (void)
+{
+    memset(s_vqec_fec_xor_fns, 0, sizeof(s_vqec_fec_xor_fns));
+    s_vqec_fec_xor_fns[VQEC_FEC_XOR_IMPL_SCALAR] = vqec_fec_xor_scalar;
+
+#ifdef VQEC_FEC_XOR_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        s_vqec_fec_xor_fns[VQEC_FEC_XOR_IMPL_SSE2] = vqec_fec_xor_sse2;
+        if (__builtin_cpu_supports("avx2")) {
+            s_vqec_fec_xor_fns[VQEC_FEC_XOR_IMPL_AVX2] = vqec_fec_xor_avx2;
+        }
+    }
+#endif /* VQEC_FEC_XOR_HAVE_X86 */
+
+#ifdef VQEC_FEC_XOR_HAVE_NEON
+    /* NEON is part of the compile-time target, hence always present */
+    s_vqec_fec_xor_fns[VQEC_FEC_XOR_IMPL_NEON] = vqec_fec_xor_neon;
+#endif /* VQEC_FEC_XOR_HAVE_NEON */
+
+    s_vqec_fec_xor_probed = TRUE;
+}
+
+/**
+ * Probe the CPU and select the fastest XOR kernel it supports.
+ */
+void
+vqec_fec_xor_init (void)
+{
+    /* order of preference, fastest first */
+    static const vqec_fec_xor_impl_t pref[] = {
+        VQEC_FEC_XOR_IMPL_AVX2,
+        VQEC_FEC_XOR_IMPL_NEON,
+        VQEC_FEC_XOR_IMPL_SSE2,
+        VQEC_FEC_XOR_IMPL_SCALAR,
+    };
+    uint32_t i;
+
+    vqec_fec_xor_probe();
+    for (i = 0; i < sizeof(pref) / sizeof(pref[0]); i++) {
+        if (vqec_fec_xor_set_impl(pref[i])) {
+            break;
+        }
+    }
+}
+
+/**
+ * Check whether a kernel is compiled in and supported by the running CPU.
+ */
+boolean
+vqec_fec_xor_impl_supported (vqec_fec_xor_impl_t impl)
+{
+    if (impl >= VQEC_FEC_XOR_IMPL_NUM) {
+        return FALSE;
+    }
+    if (!s_vqec_fec_xor_probed) {
+        vqec_fec_xor_probe();
+    }
+    return (s_vqec_fec_xor_fns[impl] != NULL);
+}
+
+/**
+ * Force a particular XOR kernel.
+ */
+boolean
+vqec_fec_xor_set_impl (vqec_fec_xor_impl_t impl)
+{
+    if (!vqec_fec_xor_impl_supported(impl)) {
+        return FALSE;
+    }
+    s_vqec_fec_xor_impl = impl;
+    s_vqec_fec_xor_fn = s_vqec_fec_xor_fns[impl];
+    return TRUE;
+}
+
+/**
+ * Get the XOR kernel currently in use.
+ */
+vqec_fec_xor_impl_t
+vqec_fec_xor_get_impl (void)
+{
+    return s_vqec_fec_xor_impl;
+}
+
+/**
+ * Get a printable name for an XOR kernel.
+ */
+const char *
+vqec_fec_xor_impl_to_str (vqec_fec_xor_impl_t impl)
+{
+    if (impl >= VQEC_FEC_XOR_IMPL_NUM) {
+        return "unknown";
+    }
+    return s_vqec_fec_xor_impl_names[impl];
+}
+
+/**
+ * XOR num_srcs source buffers of len bytes each into dst.
+ */
+void
+vqec_fec_xor_blocks (char *dst,
+                     char **srcs,
+                     uint16_t num_srcs,
+                     uint16_t len)
+{
+    if (!dst || !srcs || !num_srcs || !len) {
+        return;
+    }
+    (*s_vqec_fec_xor_fn)(dst, srcs, num_srcs, 0, len);
+}
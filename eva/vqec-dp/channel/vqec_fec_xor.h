@@ -0,0 +1,103 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/**
+ * vqec_fec_xor.h - XOR parity kernels used by the FEC decoder.
+ *
+ * The FEC decoder recovers a lost packet by XOR'ing together every
+ * packet of a row or column, including the FEC packet itself. This
+ * module provides the kernel that performs that XOR. All sources are
+ * folded into the destination in a single pass over the buffer, one
+ * lane (machine word, or 16/32 byte vector register) at a time, so the
+ * destination is only written once per lane.
+ *
+ * Several kernels are compiled in, depending on the target:
+ *   - a portable scalar kernel (always available);
+ *   - SSE2 and AVX2 kernels on x86;
+ *   - a NEON kernel on ARM when the compiler targets NEON.
+ * The fastest kernel supported by the running CPU is selected at
+ * module initialization time. The vector kernels are never used in
+ * kernel-mode builds of the dataplane, where FPU / vector state may not
+ * be touched without explicit save / restore.
+ */
+
+#ifndef __VQEC_FEC_XOR_H__
+#define __VQEC_FEC_XOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <utils/vam_types.h>
+
+/**
+ * XOR kernel implementations.
+ */
+typedef enum vqec_fec_xor_impl_ {
+    VQEC_FEC_XOR_IMPL_SCALAR = 0,       /* portable word-based kernel */
+    VQEC_FEC_XOR_IMPL_SSE2,             /* x86 SSE2, 16-byte lanes */
+    VQEC_FEC_XOR_IMPL_AVX2,             /* x86 AVX2, 32-byte lanes */
+    VQEC_FEC_XOR_IMPL_NEON,             /* ARM NEON, 16-byte lanes */
+    VQEC_FEC_XOR_IMPL_NUM,              /* must be last */
+} vqec_fec_xor_impl_t;
+
+/**
+ * Probe the CPU and select the fastest XOR kernel it supports.
+ * It is safe to call this function more than once.
+ */
+void vqec_fec_xor_init(void);
+
+/**
+ * Check whether a kernel is compiled in and supported by the running CPU.
+ *
+ * @param[in] impl  kernel to check
+ *
+ * @return TRUE if the kernel can be used, otherwise FALSE
+ */
+boolean vqec_fec_xor_impl_supported(vqec_fec_xor_impl_t impl);
+
+/**
+ * Force a particular XOR kernel; used by benchmarks and unit tests.
+ *
+ * @param[in] impl  kernel to use
+ *
+ * @return TRUE if the kernel was selected, FALSE if it is not supported
+ */
+boolean vqec_fec_xor_set_impl(vqec_fec_xor_impl_t impl);
+
+/**
+ * Get the XOR kernel currently in use.
+ */
+vqec_fec_xor_impl_t vqec_fec_xor_get_impl(void);
+
+/**
+ * Get a printable name for an XOR kernel.
+ */
+const char *vqec_fec_xor_impl_to_str(vqec_fec_xor_impl_t impl);
+
+/**
+ * XOR num_srcs source buffers of len bytes each into dst, i.e.
+ * dst = srcs[0] ^ srcs[1] ^ ... ^ srcs[num_srcs - 1].
+ * No alignment is required for any of the buffers; dst may alias
+ * srcs[0] but must not partially overlap any source.
+ *
+ * @param[out] dst       destination buffer, at least len bytes
+ * @param[in]  srcs      array of num_srcs source buffer pointers
+ * @param[in]  num_srcs  number of source buffers, must be at least 1
+ * @param[in]  len       number of bytes to XOR
+ */
+void vqec_fec_xor_blocks(char *dst,
+                         char **srcs,
+                         uint16_t num_srcs,
+                         uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __VQEC_FEC_XOR_H__ */
@@ -451,6 +451,15 @@ vqec_dp_oscheduler_run (vqec_dp_oscheduler_t *osched,
                 }
 #endif /* HAVE_FCC */
 
+                if (!IS_ABS_TIME_ZERO(osched->pak_pend->pcm_ts)) {
+                    vqec_dpchan_latency_add(
+                        pcm->dpchan,
+                        VQEC_DP_LATENCY_PCM_RESIDENCE,
+                        osched->pak_pend,
+                        TIME_SUB_A_A(now, osched->pak_pend->pcm_ts));
+                }
+                osched->pak_pend->sink_ts = now;
+
                 /* process packet for each connected input stream */
                 for (stream_idx = 0;
                      stream_idx < VQEC_DP_OSCHED_STREAMS_MAX;
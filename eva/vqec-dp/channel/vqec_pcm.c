@@ -18,6 +18,7 @@
 #include "vam_time.h"
 #include "vqe_bitmap.h"
 #include <vqec_oscheduler.h>
+#include "vqec_dpchan.h"
 
 #ifdef _VQEC_DP_UTEST
 #define UT_STATIC 
@@ -33,6 +34,16 @@ UT_STATIC vqec_seq_num_t vqec_pcm_get_seq_num (const vqec_pak_t * pak)
     return pak->seq_num;
 }
 
+/*
+ * FEC module of the PCM's channel, whose parity accumulators follow the
+ * packets inserted into the PCM; NULL if the PCM has no channel.
+ */
+static inline vqec_fec_t *
+vqec_pcm_fec_ptr (vqec_pcm_t *pcm)
+{
+    return (pcm->dpchan ? vqec_dpchan_fec_ptr(pcm->dpchan) : NULL);
+}
+
 /*
  * HELPER FUNCTIONS FOR CANDIDATE ARRAY
  */
@@ -155,6 +166,71 @@ vqec_pcm_get_last_candidate (vqec_pcm_t * pcm)
     return last;
 }
 
+/**
+ * vqec_pcm_gap_ev_reset
+ * @brief
+ * Forget any gap waiting to age, and any aged-gap event not yet raised.
+ */
+static inline void
+vqec_pcm_gap_ev_reset (vqec_pcm_t *pcm)
+{
+    pcm->gap_ev_num = 0;
+    pcm->gap_ev_due_ts = ABS_TIME_0;
+}
+
+/**
+ * vqec_pcm_gap_ev_arm
+ * @brief
+ * Called when a gap opens at the tail of the PCM. Gaps open in sequence
+ * order, so they are queued oldest first; each one raises an aged-gap
+ * event when it ages, unless one is already pending. If the queue is full,
+ * the newest gap replaces the last one queued.
+ */
+UT_STATIC void
+vqec_pcm_gap_ev_arm (vqec_pcm_t *pcm, vqec_seq_num_t gap_start)
+{
+    if (!pcm->er_enable) {
+        return;
+    }
+    if (pcm->gap_ev_num == VQEC_PCM_GAP_EV_MAX) {
+        pcm->gap_ev_seq_num[VQEC_PCM_GAP_EV_MAX - 1] = gap_start;
+    } else {
+        pcm->gap_ev_seq_num[pcm->gap_ev_num++] = gap_start;
+    }
+}
+
+/**
+ * vqec_pcm_gap_ev_check_aged
+ * @brief
+ * Called after highest_er_seq_num is updated: dequeue the gaps that are
+ * now eligible for error repair and, if there were any, schedule the
+ * aged-gap event at the end of the coalescing window, unless one is
+ * already scheduled. The gaps still queued raise events as they age.
+ */
+UT_STATIC void
+vqec_pcm_gap_ev_check_aged (vqec_pcm_t *pcm, abs_time_t cur_time)
+{
+    uint32_t i;
+
+    for (i = 0; i < pcm->gap_ev_num; i++) {
+        if (vqec_seq_num_lt(pcm->highest_er_seq_num, 
+                            pcm->gap_ev_seq_num[i])) {
+            break;
+        }
+    }
+    if (!i) {
+        return;
+    }
+    pcm->gap_ev_num -= i;
+    memmove(pcm->gap_ev_seq_num, 
+            &pcm->gap_ev_seq_num[i],
+            pcm->gap_ev_num * sizeof(pcm->gap_ev_seq_num[0]));
+    if (IS_ABS_TIME_ZERO(pcm->gap_ev_due_ts)) {
+        pcm->gap_ev_due_ts = 
+            TIME_ADD_A_R(cur_time, VQEC_PCM_GAP_EV_COALESCE_TIME);
+    }
+}
+
 /**
  * vqec_pcm_timeout_old_candidates
  * @brief
@@ -197,6 +273,7 @@ vqec_pcm_timeout_old_candidates (vqec_pcm_t *pcm,
             break;
         }
     }
+    vqec_pcm_gap_ev_check_aged(pcm, cur_time);
 }
 
 /*
@@ -1357,6 +1434,7 @@ vqec_pcm_insert_packets (vqec_pcm_t *pcm, vqec_pak_t *paks[],
     vqec_pak_t *pak;
     boolean bump_seqs = FALSE;
     boolean check_all_ranges = FALSE;
+    abs_time_t now;
 
     VQEC_DP_ASSERT_FATAL(pcm, "pcm");
     VQEC_DP_ASSERT_FATAL(paks, "pcm");
@@ -1416,8 +1494,10 @@ vqec_pcm_insert_packets (vqec_pcm_t *pcm, vqec_pak_t *paks[],
 
         /*
          * Bump the current pak's seq_num up a few 16-bit generations.
+         * FEC blocks tracked against the old sequence space are dropped.
          */
         bump_seqs = TRUE;
+        vqec_fec_acc_reset(vqec_pcm_fec_ptr(pcm));
 
         /*
          * Reset the resultant delay from any app paks.
@@ -1425,6 +1505,8 @@ vqec_pcm_insert_packets (vqec_pcm_t *pcm, vqec_pak_t *paks[],
         pcm->delay_from_apps = REL_TIME_0;
     }
 
+    now = get_sys_time();
+
     if (contig) {
         /* check seq ranges for just first and last paks */
         ret = vqec_pcm_insert_packet_check_range(pcm,
@@ -1547,6 +1629,18 @@ vqec_pcm_insert_packets (vqec_pcm_t *pcm, vqec_pak_t *paks[],
         }
 
         if (vqec_pak_seq_insert(pcm->pak_seq, pak)) {
+            /* fold into the FEC parity of the packet's row and column */
+            vqec_fec_acc_pak_inserted(vqec_pcm_fec_ptr(pcm), pak);
+
+            /* FEC-recovered packets have no receive timestamp */
+            pak->pcm_ts = now;
+            if (!IS_ABS_TIME_ZERO(pak->rcv_ts)) {
+                vqec_dpchan_latency_add(pcm->dpchan,
+                                        VQEC_DP_LATENCY_NET_TO_PCM,
+                                        pak,
+                                        TIME_SUB_A_A(now, pak->rcv_ts));
+            }
+
             /* need to update the gapmap and head and tail */
             if (VQE_BITMAP_OK !=
                 vqe_bitmap_set_bit(pcm->gapmap, pak->seq_num)) {
@@ -1578,11 +1672,14 @@ vqec_pcm_insert_packets (vqec_pcm_t *pcm, vqec_pak_t *paks[],
                     VQEC_PAK_FLAGS_SET(&pak->flags, 
                                        VQEC_PAK_FLAGS_RX_REORDERED);
                 } else if (vqec_seq_num_gt(pak->seq_num, pcm->tail)) {
-                    if (pak->seq_num != vqec_next_seq_num(pcm->tail) &&
-                        gap_update) {
-                        vqec_pcm_gap_update_stats(pcm,
-                                               vqec_next_seq_num(pcm->tail),
-                                               vqec_pre_seq_num(pak->seq_num));
+                    if (pak->seq_num != vqec_next_seq_num(pcm->tail)) {
+                        vqec_pcm_gap_ev_arm(pcm, vqec_next_seq_num(pcm->tail));
+                        if (gap_update) {
+                            vqec_pcm_gap_update_stats(
+                                pcm,
+                                vqec_next_seq_num(pcm->tail),
+                                vqec_pre_seq_num(pak->seq_num));
+                        }
                     }
                     pcm->tail = pak->seq_num;
                     if (is_primary_session) {
@@ -1926,8 +2023,12 @@ boolean vqec_pcm_flush (vqec_pcm_t * pcm)
         return FALSE;
     }
 
-    /* flush the gap list */
+    /* flush the gap list, and forget gaps waiting to be signaled */
     vqec_pcm_gapmap_flush(pcm);
+    vqec_pcm_gap_ev_reset(pcm);
+
+    /* FEC parity accumulated for the flushed packets is of no further use */
+    vqec_fec_acc_reset(vqec_pcm_fec_ptr(pcm));
 
     /* deQ all paks from the inorder list (for safety) */
     vqec_pcm_inorder_pak_list_flush(pcm);
@@ -2190,6 +2291,7 @@ vqec_pcm_notify_rcc_en_er (vqec_pcm_t *pcm)
         if (pcm->er_enable) {
             pcm->last_requested_er_seq_num = pcm->head;
             pcm->highest_er_seq_num = pcm->tail;
+            vqec_pcm_gap_ev_reset(pcm);
             vqec_pcm_set_er_en_ts(pcm);
         }
     }
@@ -52,6 +52,17 @@ extern "C" {
  * Maximum number of packet candidates for next_seq_num */
 #define VQEC_PCM_MAX_CANDIDATES    10
 
+/**@brief
+ * Once a gap has aged past gap_hold_time, the aged-gap event is held for
+ * this long, so that gaps which age shortly afterwards are reported in
+ * the same generic NACK. */
+#define VQEC_PCM_GAP_EV_COALESCE_TIME MSECS(5)
+
+/**@brief
+ * Maximum number of gaps tracked while they age. If more gaps are open,
+ * the newest one stands in for those that do not fit. */
+#define VQEC_PCM_GAP_EV_MAX 8
+
 /**
  * vqec_pcm_candidate_t
  * @brief
@@ -257,6 +268,14 @@ typedef struct vqec_pcm_ {
     boolean candidates_recently_checked;
     boolean first_er_poll_done;
 
+    /* Following members signal gaps to the control plane once they have */
+    /* aged past gap_hold_time, see vqec_pcm_gap_ev_due()                */
+    vqec_seq_num_t gap_ev_seq_num[VQEC_PCM_GAP_EV_MAX];
+                                /*!< first seq_num of gaps waiting to */
+                                /*!< age, oldest first */
+    uint32_t gap_ev_num;        /*!< number of gaps waiting to age */
+    abs_time_t gap_ev_due_ts;   /*!< time the aged-gap event is due, or 0 */
+
     /* Params for PCM to create FEC buffer */
     vqec_fec_info_t fec_info;
     uint16_t fec_default_block_size; 
@@ -575,6 +594,28 @@ static inline void vqec_pcm_candidates_recently_checked_reset(vqec_pcm_t *pcm)
     pcm->candidates_recently_checked = FALSE;
 }
 
+/**
+ * vqec_pcm_gap_ev_due
+ * Check whether a gap has aged past gap_hold_time, and the coalescing
+ * window that follows has expired, i.e., whether the control plane should
+ * now be asked to report gaps. The event is consumed by this call.
+ * pcm must not be NULL
+ *
+ * @param[in]    pcm       Pointer to the PCM.
+ * @param[in]    cur_time  Current time.
+ * @return       TRUE if the aged-gap event is due.
+ */
+static inline boolean vqec_pcm_gap_ev_due (vqec_pcm_t *pcm,
+                                           abs_time_t cur_time)
+{
+    if (IS_ABS_TIME_ZERO(pcm->gap_ev_due_ts) ||
+        TIME_CMP_A(lt, cur_time, pcm->gap_ev_due_ts)) {
+        return (FALSE);
+    }
+    pcm->gap_ev_due_ts = ABS_TIME_0;
+    return (TRUE);
+}
+
 
 /*
  * get the average packet time
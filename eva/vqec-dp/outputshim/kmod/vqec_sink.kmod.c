@@ -168,6 +168,7 @@ vqec_sink_kernel_enq (vqec_sink_t *sink,
          vqec_pak_get_content_len(pak))) {
         readlen = vqec_sink_read_internal(sink, pak, 
                                           &waiter->iobuf[waiter->i_cur]);
+        vqec_sink_upd_residence(sink, pak, pak->sink_ts);
         waiter->len += readlen;
 
         /*
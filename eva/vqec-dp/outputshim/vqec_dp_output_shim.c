@@ -599,6 +599,85 @@ vqec_dp_output_shim_get_tuner_status (vqec_dp_tunerid_t tid,
     return VQEC_DP_ERR_OK;
 }
 
+/**
+ * Get compact output queue statistics for all tuners.
+ *
+ * @param[out] tuners Array of tuner summaries to be filled.
+ * @param[in] max_tuners Number of entries in the tuners array.
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @param[out] uint32_t Number of tuner summaries filled.
+ */
+uint32_t
+vqec_dp_output_shim_get_tuner_summary (vqec_dp_tuner_stats_summary_t *tuners,
+                                       uint32_t max_tuners,
+                                       boolean cumulative)
+{
+    vqec_dp_output_shim_tuner_t *t;
+    vqec_dp_sink_stats_t sink_stats;
+    uint32_t i, num = 0;
+
+    if (!g_output_shim.tuners || !tuners) {
+        return (0);
+    }
+
+    for (i = 0; (i < g_output_shim.max_tuners) && (num < max_tuners); i++) {
+        t = g_output_shim.tuners[i];
+        if (!t || !t->sink) {
+            continue;
+        }
+        memset(&sink_stats, 0, sizeof(vqec_dp_sink_stats_t));
+        MCALL(t->sink, vqec_sink_get_stats, &sink_stats, cumulative);
+
+        tuners[num].cp_tid = t->cp_tid;
+        tuners[num].qdepth = sink_stats.queue_depth;
+        tuners[num].qdrops = sink_stats.queue_drops;
+        num++;
+    }
+    return (num);
+}
+
+/**
+ * Get the reader exit-to-enter jitter histograms of all tuners merged into
+ * one.  The histogram is left empty if reader jitter is not measured.
+ *
+ * @param[out] hist Histogram into which those of all tuners are merged.
+ */
+void
+vqec_dp_output_shim_get_reader_jitter_hist (vqec_dp_histogram_data_t *hist)
+{
+#ifdef HAVE_SCHED_JITTER_HISTOGRAM
+    vqec_dp_output_shim_tuner_t *t;
+    boolean first = TRUE;
+    uint32_t i;
+#endif  /* HAVE_SCHED_JITTER_HISTOGRAM */
+
+    if (!hist) {
+        return;
+    }
+    memset(hist, 0, sizeof(*hist));
+
+#ifdef HAVE_SCHED_JITTER_HISTOGRAM
+    if (!g_output_shim.tuners) {
+        return;
+    }
+    for (i = 0; i < g_output_shim.max_tuners; i++) {
+        t = g_output_shim.tuners[i];
+        if (!t || !t->sink || !t->sink->reader_jitter_hist) {
+            continue;
+        }
+        if (first) {
+            vam_hist_copy((vam_hist_type_t *)hist,
+                          VQEC_DP_HIST_MAX_BUCKETS,
+                          t->sink->reader_jitter_hist);
+            first = FALSE;
+        } else {
+            (void)vam_hist_merge((vam_hist_type_t *)hist,
+                                 t->sink->reader_jitter_hist);
+        }
+    }
+#endif  /* HAVE_SCHED_JITTER_HISTOGRAM */
+}
+
 /**
  * Clear the counters for a dataplane tuner.
  */
@@ -1258,6 +1337,66 @@ vqec_dp_output_shim_hist_get (vqec_dp_tunerid_t dp_tid,
 }
 
 
+/**
+ * Gets a snapshot of the sink residence histogram of a class of packets
+ * for a particular dataplane tuner.
+ *
+ * @param[in] dp_tid - Dataplane tuner id.
+ * @param[in] cls - Class of packets.
+ * @param[out]  hist_ptr - Buffer into which histogram is copied.
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+vqec_dp_error_t
+vqec_dp_output_shim_latency_hist_get (vqec_dp_tunerid_t dp_tid,
+                                      vqec_dp_latency_class_t cls,
+                                      vqec_dp_histogram_data_t *hist_ptr)
+{
+    if (dp_tid > g_output_shim.max_tuners ||
+        dp_tid < 1 ||
+        cls < 0 ||
+        cls >= VQEC_DP_LATENCY_CLASS_MAX ||
+        !hist_ptr) {
+        return VQEC_DP_ERR_INVALIDARGS;
+    }  else if (!g_output_shim.tuners || !g_output_shim.tuners[dp_tid - 1]) {
+        return VQEC_DP_ERR_NOSUCHTUNER;
+    }  else if (!g_output_shim.tuners[dp_tid - 1]->sink) {
+        return VQEC_DP_ERR_NOT_FOUND;
+    }
+
+    vam_hist_copy((vam_hist_type_t *)hist_ptr,
+                  VQEC_DP_HIST_MAX_BUCKETS,
+                  (vam_hist_type_t *)
+                  &g_output_shim.tuners[dp_tid - 1]->sink->residence_hist[cls]);
+    return (VQEC_DP_ERR_OK);
+}
+
+
+/**
+ * Clear the sink residence histograms of all tuners.
+ *
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+vqec_dp_error_t
+vqec_dp_output_shim_latency_hist_clear (void)
+{
+    int32_t i, cls;
+
+    if (!g_output_shim.tuners) {
+        return (VQEC_DP_ERR_OK);
+    }
+    for (i = 0; i < g_output_shim.max_tuners; i++) {
+        if (g_output_shim.tuners[i] && g_output_shim.tuners[i]->sink) {
+            for (cls = 0; cls < VQEC_DP_LATENCY_CLASS_MAX; cls++) {
+                vam_hist_clear((vam_hist_type_t *)
+                               &g_output_shim.tuners[i]->sink->
+                               residence_hist[cls]);
+            }
+        }
+    }
+    return (VQEC_DP_ERR_OK);
+}
+
+
 /**
  * Publish output jitter for all active tuners.
  *
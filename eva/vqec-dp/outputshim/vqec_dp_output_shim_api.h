@@ -148,6 +148,28 @@ vqec_dp_error_t
 vqec_dp_output_shim_tuner_cache_channel(vqec_dp_tunerid_t tid,
                                         vqec_dp_chan_desc_t *chan);
 
+/**
+ * Get compact output queue statistics for all tuners.
+ *
+ * @param[out] tuners Array of tuner summaries to be filled.
+ * @param[in] max_tuners Number of entries in the tuners array.
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @param[out] uint32_t Number of tuner summaries filled.
+ */
+uint32_t
+vqec_dp_output_shim_get_tuner_summary(vqec_dp_tuner_stats_summary_t *tuners,
+                                      uint32_t max_tuners,
+                                      boolean cumulative);
+
+/**
+ * Get the reader exit-to-enter jitter histograms of all tuners merged into
+ * one.  The histogram is left empty if reader jitter is not measured.
+ *
+ * @param[out] hist Histogram into which those of all tuners are merged.
+ */
+void
+vqec_dp_output_shim_get_reader_jitter_hist(vqec_dp_histogram_data_t *hist);
+
 #ifdef HAVE_SCHED_JITTER_HISTOGRAM
 /**
  * Publish output jitter for all active tuners.
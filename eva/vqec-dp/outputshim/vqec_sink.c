@@ -85,6 +85,7 @@ int32_t vqec_sink_enqueue (struct vqec_sink_ *sink,
          vqec_pak_get_content_len(pak))) {
         readlen = vqec_sink_read_internal(sink, pak, 
                                           &waiter->iobuf[waiter->i_cur]);
+        vqec_sink_upd_residence(sink, pak, pak->sink_ts);
         waiter->len += readlen;
         /*
          * Terminate processing of packets in this iobuf if:
@@ -224,6 +224,10 @@ struct vqec_dp_sink_stats_
      * Maximum packet size.                                             \
      */                                                                 \
     uint32_t max_paksize;                                               \
+    /**                                                                 \
+     * Residence time of packets in the sink, per latency class.        \
+     */                                                                 \
+    vqec_dp_histogram_data_t residence_hist[VQEC_DP_LATENCY_CLASS_MAX]; \
     VQEC_SINK_MEMBERS_JITTER_HISTOGRAM                                  \
     /**                                                                 \
      * Packet queue chain.                                              \
@@ -240,6 +244,14 @@ void vqec_sink_destroy(struct vqec_sink_ *);
 vam_hist_type_t *vqec_sink_get_inp_delay_hist(struct vqec_sink_ *);
 #endif  /* HAVE_SCHED_JITTER_HISTOGRAM */
 
+/*
+ * Log the residence time of a packet read from the sink; packets copied
+ * straight to a waiting reader are logged with now set to their sink_ts.
+ */
+void vqec_sink_upd_residence(struct vqec_sink_ *sink,
+                             const vqec_pak_t *pak,
+                             abs_time_t now);
+
 struct vqec_sink_fcns_;
 void vqec_sink_set_fcns_common(struct vqec_sink_fcns_ *table);
 
@@ -15,6 +15,7 @@
  *
  *****************************************************************************/
 #include "vqec_sink.h"
+#include <vqec_dp_io_stream.h>
 
 /************************************************************************
  * Packet header pools support
@@ -220,6 +221,7 @@ int32_t vqec_sink_read (struct vqec_sink_ *sink,
     vqec_pak_t *pak;
     vqec_pak_hdr_t *pak_hdr;
     char *paktype;
+    abs_time_t now;
 
     if (!iobuf) {
         return (-1);
@@ -227,6 +229,8 @@ int32_t vqec_sink_read (struct vqec_sink_ *sink,
         return (0);
     }
 
+    now = get_sys_time();
+
     while (1) {
         pak_hdr = VQE_TAILQ_FIRST(&sink->pak_queue);
         if (!pak_hdr) {
@@ -242,6 +246,7 @@ int32_t vqec_sink_read (struct vqec_sink_ *sink,
             sink->pak_queue_depth--;
             pak = pak_hdr->pak; 
             (void)vqec_sink_read_internal(sink, pak, iobuf);
+            vqec_sink_upd_residence(sink, pak, now);
 
             if (VQEC_DP_GET_DEBUG_FLAG(VQEC_DP_DEBUG_OUTPUTSHIM_PAK)) {
                 switch (pak->type) {
@@ -297,6 +302,18 @@ int32_t vqec_sink_read (struct vqec_sink_ *sink,
     return (iobuf->buf_wrlen);
 }
 
+static int32_t
+s_residence_ranges[] = VQEC_DP_LATENCY_HIST_RANGES;
+static const uint32_t
+s_residence_num_ranges =
+    sizeof(s_residence_ranges)/sizeof(s_residence_ranges[0]);
+static char *
+s_residence_titles[VQEC_DP_LATENCY_CLASS_MAX] = {
+    "Sink residence, primary packets (in usec)",
+    "Sink residence, repair packets (in usec)",
+    "Sink residence, FEC-recovered packets (in usec)"
+};
+
 #ifdef HAVE_SCHED_JITTER_HISTOGRAM
 static int32_t
 s_reader_jitter_ranges[] = {0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100,
@@ -322,6 +339,7 @@ vqec_sink_t * vqec_sink_create (uint32_t max_q_depth, uint32_t max_paksize)
 {
 
     vqec_sink_t * sink;
+    int cls;
     
     sink = (vqec_sink_t *) zone_acquire(s_vqec_sink_pool);
     
@@ -332,6 +350,14 @@ vqec_sink_t * vqec_sink_create (uint32_t max_q_depth, uint32_t max_paksize)
     memset(sink, 0, sizeof(vqec_sink_t));
     sink->__func_table = &vqec_sink_fcn_table;
 
+    for (cls = 0; cls < VQEC_DP_LATENCY_CLASS_MAX; cls++) {
+        (void)vam_hist_create_ranges(
+            (vam_hist_type_t *)&sink->residence_hist[cls],
+            s_residence_ranges,
+            s_residence_num_ranges,
+            s_residence_titles[cls]);
+    }
+
 #ifdef HAVE_SCHED_JITTER_HISTOGRAM
     sink->reader_jitter_hist =
         zone_acquire(s_reader_hist_pool);
@@ -400,6 +426,31 @@ void vqec_sink_destroy (vqec_sink_t * sink)
     zone_release(s_vqec_sink_pool, sink);
 }
 
+/**---------------------------------------------------------------------------
+ * Log the residence time of a packet read from the sink, i.e. the time
+ * since the packet was output to the tuners.  Packets which were not
+ * output by a channel's output scheduler (e.g. in fallback mode) have no
+ * sink_ts and are not logged.
+ *
+ * @param[in] sink Pointer to the sink object.
+ * @param[in] pak Pointer to the packet.
+ * @param[in] now Time at which the packet is read.
+ *---------------------------------------------------------------------------*/
+void
+vqec_sink_upd_residence (vqec_sink_t *sink,
+                         const vqec_pak_t *pak,
+                         abs_time_t now)
+{
+    vqec_dp_latency_class_t cls = vqec_dp_latency_pak_class(pak);
+
+    if ((cls != VQEC_DP_LATENCY_CLASS_MAX) &&
+        !IS_ABS_TIME_ZERO(pak->sink_ts)) {
+        (void)vam_hist_add((vam_hist_type_t *)&sink->residence_hist[cls],
+                           TIME_GET_R(usec,
+                                      TIME_SUB_A_A(now, pak->sink_ts)));
+    }
+}
+
 #ifdef HAVE_SCHED_JITTER_HISTOGRAM
 /**---------------------------------------------------------------------------
  * Update a reader's thread exit-to-enter jitter when reading packet data
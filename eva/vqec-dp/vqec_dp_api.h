@@ -171,6 +171,14 @@ RPC vqec_dp_error_t
 vqec_dp_get_benchmark(INV uint32_t interval,
                       OUT uint32_t *cpu_usage);
 
+/**
+ * Gets the execution profiles of the dataplane event loop.
+ *
+ * @param[out] profile Profiles of the dataplane events, by name.
+ */
+RPC vqec_dp_error_t
+vqec_dp_get_event_profile(OUT vqec_dp_event_profile_t *profile);
+
 /**
  * Get operating mode of the dataplane.
  */
@@ -193,14 +201,48 @@ RPC vqec_dp_error_t
 vqec_dp_get_default_pakpool_status(OUT vqec_pak_pool_status_t *status);
 
 /**
- * Retrieve all of the global debug counters kept within the TLM.
+ * Retrieve all of the global debug counters kept within the TLM, as last
+ * published by the dataplane.  The dataplane lock is not taken.
  *
  * @param[out] counters Pointer to the data structure than holds
  * the debug counters. 
  */
-RPC vqec_dp_error_t
+RPC_NOLOCK vqec_dp_error_t
 vqec_dp_get_global_counters(OUT vqec_dp_global_debug_stats_t *stats);
 
+/**
+ * Publish the statistics of all channels and tuners, and the global
+ * counters and histograms, at once.  This is done when channels or
+ * tuners have just been added, removed or cleared, so that readers see
+ * the change without waiting for the next periodic publish.
+ */
+RPC vqec_dp_error_t
+vqec_dp_publish_stats(void);
+
+/**
+ * Retrieve compact statistics for all channels and tuners in one call.
+ * The statistics are those last published by the dataplane, at most
+ * VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS old while they are being read
+ * regularly.  The dataplane lock is not taken.
+ *
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @param[out] snapshot Pointer to the snapshot to be filled.
+ */
+RPC_NOLOCK vqec_dp_error_t
+vqec_dp_get_stats_snapshot(INV boolean cumulative,
+                           OUT vqec_dp_stats_snapshot_t *snapshot);
+
+/**
+ * Retrieve a histogram, as last published by the dataplane.  The
+ * dataplane lock is not taken.
+ *
+ * @param[in] hist Histogram to be retrieved.
+ * @param[out] hist_ptr Buffer into which the histogram is copied.
+ */
+RPC_NOLOCK vqec_dp_error_t
+vqec_dp_get_published_hist(INV vqec_dp_published_hist_t hist,
+                           OUT vqec_dp_histogram_data_t *hist_ptr);
+
 /**
  ***********************************************************
  * Input Shim APIs.
@@ -589,6 +631,30 @@ vqec_dp_chan_hist_get(INV vqec_dp_hist_t hist,
 RPC vqec_dp_error_t
 vqec_dp_chan_hist_clear(INV vqec_dp_hist_t hist);
 
+/**
+ * Gets a snapshot of a channel's packet latency histogram.
+ *
+ * @param[in]  chanid             - channel identifier
+ * @param[in]  stage              - latency stage; sink residence is kept
+ *                                  by the output shim
+ * @param[in]  cls                - class of packets
+ * @param[out] hist_ptr           - buffer into which histogram is copied
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+RPC vqec_dp_error_t
+vqec_dp_chan_latency_hist_get(INV vqec_dp_chanid_t chanid,
+                              INV vqec_dp_latency_stage_t stage,
+                              INV vqec_dp_latency_class_t cls,
+                              OUT vqec_dp_histogram_data_t *hist_ptr);
+
+/**
+ * Clear the packet latency histograms of all channels.
+ *
+ * @param[out] vqec_dp_error_t  - VQEC_DP_ERR_OK or failure code
+ */
+RPC vqec_dp_error_t
+vqec_dp_chan_latency_hist_clear(void);
+
 /**
  * Enable/Disable measurement logging for the output scheduling histogram
  *
@@ -1084,6 +1150,28 @@ vqec_dp_output_shim_hist_get(INV vqec_dp_tunerid_t dp_tid,
                              INV vqec_dp_outputshim_hist_t type,                             
                              OUT vqec_dp_histogram_data_t *hist_ptr);
 
+/**
+ * Gets a snapshot of the sink residence histogram of a class of packets
+ * for a particular dataplane tuner.
+ *
+ * @param[in] dp_tid - Dataplane tuner id.
+ * @param[in] cls - Class of packets.
+ * @param[out]  hist_ptr - Buffer into which histogram is copied.
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+RPC vqec_dp_error_t
+vqec_dp_output_shim_latency_hist_get(INV vqec_dp_tunerid_t dp_tid,
+                                     INV vqec_dp_latency_class_t cls,
+                                     OUT vqec_dp_histogram_data_t *hist_ptr);
+
+/**
+ * Clear the sink residence histograms of all tuners.
+ *
+ * @param[out] vqec_dp_error_t    - VQEC_DP_ERR_OK or failure code
+ */
+RPC vqec_dp_error_t
+vqec_dp_output_shim_latency_hist_clear(void);
+
 /**
  ***********************************************************
  * VQE-C DP Debug APIs.
@@ -20,6 +20,7 @@
 
 #include "vqec_dp_common.h"
 #include <vqec_seq_num.h>
+#include <vqec_event.h>
 #include <rtp_header.h>
 
 #include "mp_mpeg.h"  /* for length of PSI section */
@@ -32,6 +33,12 @@
  * An API exported via IPC mechanisms.  
  */
 #define RPC
+/**
+ * An API exported via IPC mechanisms, which the IPC server invokes 
+ * without taking the dataplane lock.  It must only read data that is
+ * safe to read concurrently with the dataplane.
+ */
+#define RPC_NOLOCK
 /**
  * Input parameter passed by reference.  
  */
@@ -1098,6 +1105,11 @@ enum vqec_dp_upcall_irq_reason_code_
      * Event used to periodically synchronize generation (sequence) numbers.
      */
     VQEC_DP_UPCALL_REASON_CHAN_GEN_NUM_SYNC,
+    /**
+     * A gap has aged past the reorder / FEC hold time, and should now be
+     * reported for error repair.
+     */
+    VQEC_DP_UPCALL_REASON_CHAN_GAP_AGED,
     /**
      * Must be last.
      */
@@ -1658,6 +1670,105 @@ struct vqec_dp_chan_stats_
 } vqec_dp_chan_stats_t;
 
 
+/**
+ * Maximum number of channels and tuners in a statistics snapshot:  there
+ * is at most one dataplane channel per tuner.
+ */
+#define VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS 32
+#define VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS 32
+
+/**
+ * Interval at which the dataplane publishes the statistics snapshot
+ * and global counters returned to readers.
+ */
+#define VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS 100
+
+/**
+ * Interval at which the statistics are published when they have not
+ * been read since they were last published.
+ */
+#define VQEC_DP_STATS_PUBLISH_IDLE_INTERVAL_MSECS 1000
+
+/**
+ * Compact statistics of a channel, as gathered for all channels at once
+ * in a statistics snapshot.  The counters are derived as they are for
+ * vqec_ifclient_stats_channel_t.
+ */
+typedef
+struct vqec_dp_chan_stats_summary_
+{
+    /**
+     * Opaque control-plane channel handle.
+     */
+    uint32_t cp_handle;
+    /**
+     * Sequence-derived packets expected and received from the primary
+     * source with packet-flow enabled, if any.
+     */
+    uint32_t primary_rtp_expected;
+    uint32_t primary_rtp_received;
+    /**
+     * Output losses during the RCC burst.
+     */
+    uint32_t post_repair_losses_rcc;
+    /**
+     * Input counters.
+     */
+    uint64_t primary_udp_inputs;
+    uint64_t primary_rtp_inputs;
+    uint64_t primary_rtp_drops;
+    uint64_t repair_rtp_inputs;
+    uint64_t repair_rtp_drops;
+    uint64_t fec_inputs;
+    uint64_t fec_recovered_paks;
+    /**
+     * PCM counters.
+     */
+    uint64_t pre_repair_losses;
+    uint64_t post_repair_losses;
+    uint64_t post_repair_outputs;
+    uint64_t underruns;
+
+} vqec_dp_chan_stats_summary_t;
+
+/**
+ * Compact statistics of a tuner's output queue.
+ */
+typedef
+struct vqec_dp_tuner_stats_summary_
+{
+    /**
+     * Control-plane tuner id.
+     */
+    int32_t cp_tid;
+    /**
+     * Packets currently queued.
+     */
+    uint32_t qdepth;
+    /**
+     * Packets dropped from the queue.
+     */
+    uint64_t qdrops;
+
+} vqec_dp_tuner_stats_summary_t;
+
+/**
+ * Statistics of all channels and tuners of the dataplane.  The whole
+ * snapshot is returned by a single IPC, so it must fit in one IPC buffer
+ * (VQEC_DEV_IPC_BUF_LEN); the generated RPC code fails to compile if it
+ * does not.
+ */
+typedef
+struct vqec_dp_stats_snapshot_
+{
+    uint32_t num_chans;
+    uint32_t num_tuners;
+    vqec_dp_chan_stats_summary_t chans[VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS];
+    vqec_dp_tuner_stats_summary_t tuners[VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS];
+
+} vqec_dp_stats_snapshot_t;
+
+
 /*
  * Primary session failover state information
  */
@@ -1804,6 +1915,23 @@ struct vqec_dp_global_debug_stats_
 
 } vqec_dp_global_debug_stats_t;
 
+/*
+ * Execution profiles of the dataplane event loop.  They are only
+ * maintained for the kernel dataplane, which runs its own event loop;
+ * in user-mode builds, the dataplane events are profiled with the rest
+ * of the events of the shared loop.  There is room for every entry of
+ * the kernel profile table, so none are lost in the copy.
+ */
+#define VQEC_DP_EVENT_PROFILE_MAX VQEC_EVENT_PROFILE_MAX
+
+typedef
+struct vqec_dp_event_profile_
+{
+    uint32_t num_events;
+    vqec_event_profile_t events[VQEC_DP_EVENT_PROFILE_MAX];
+
+} vqec_dp_event_profile_t;
+
 
 /****************************************************************************
  * Gap logs.
@@ -2189,6 +2317,61 @@ typedef enum vqec_dp_outputshim_hist_t_
     VQEC_DP_HIST_OUTPUTSHIM_MAX
 } vqec_dp_outputshim_hist_t;
 
+/*
+ * Histograms published by the dataplane along with its statistics.  The
+ * reader jitter histogram merges those of all tuners.
+ */
+typedef enum vqec_dp_published_hist_t_
+{
+    VQEC_DP_PUBLISHED_HIST_JOIN_DELAY = 0,
+    VQEC_DP_PUBLISHED_HIST_OUTPUTSCHED,
+    VQEC_DP_PUBLISHED_HIST_READER_JITTER,
+    VQEC_DP_PUBLISHED_HIST_MAX
+} vqec_dp_published_hist_t;
+
+/*
+ * Stages of a packet's path through VQE-C for which latency histograms
+ * are kept, separately for each vqec_dp_latency_class_t.
+ *
+ * VQEC_DP_LATENCY_NET_TO_PCM:
+ * From the receipt of the packet on its socket to its insertion in the
+ * channel's PCM; kept per channel.
+ *
+ * VQEC_DP_LATENCY_PCM_RESIDENCE:
+ * From the insertion of the packet in the PCM to its output to the
+ * tuners; kept per channel.
+ *
+ * VQEC_DP_LATENCY_SINK_RESIDENCE:
+ * From the output of the packet to a tuner to its read from the tuner;
+ * kept per tuner, since every tuner has its own output queue.
+ */
+typedef enum vqec_dp_latency_stage_t_ {
+    VQEC_DP_LATENCY_NET_TO_PCM = 0,
+    VQEC_DP_LATENCY_PCM_RESIDENCE,
+    VQEC_DP_LATENCY_SINK_RESIDENCE,
+    VQEC_DP_LATENCY_STAGE_MAX
+} vqec_dp_latency_stage_t;
+
+/*
+ * Classes of packets with separate latency histograms.  FEC-recovered
+ * packets have no receive time, hence no network-to-PCM latency.
+ */
+typedef enum vqec_dp_latency_class_t_ {
+    VQEC_DP_LATENCY_PRIMARY = 0,
+    VQEC_DP_LATENCY_REPAIR,             /* retransmitted */
+    VQEC_DP_LATENCY_FEC,                /* recovered by FEC */
+    VQEC_DP_LATENCY_CLASS_MAX
+} vqec_dp_latency_class_t;
+
+/*
+ * Bucket ranges (in usec) of all latency histograms, which may thus be
+ * merged.
+ */
+#define VQEC_DP_LATENCY_HIST_RANGES                                     \
+    {0, 100, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000,   \
+     150000, 200000, 300000, 500000, 750000, 1000000, 1500000, 2000000, \
+     3000000, 5000000}
+
 /* Maximum number of buckets supported by above histograms */
 #define VQEC_DP_HIST_MAX_BUCKETS 25
 
@@ -769,6 +769,29 @@ struct vqec_dp_osops_
 
 } vqec_dp_osops_t;
 
+/**
+ * Latency class of a packet carried by a stream.
+ *
+ * @param[in] pak Pointer to the packet.
+ * @param[out] vqec_dp_latency_class_t Class of the packet, or
+ * VQEC_DP_LATENCY_CLASS_MAX for packets whose latency is not measured
+ * (e.g. APP packets).
+ */
+static inline vqec_dp_latency_class_t
+vqec_dp_latency_pak_class (const vqec_pak_t *pak)
+{
+    switch (pak->type) {
+    case VQEC_PAK_TYPE_PRIMARY:
+        return (VQEC_DP_LATENCY_PRIMARY);
+    case VQEC_PAK_TYPE_REPAIR:
+        /* fec_touched is only set on repair packets recovered by FEC */
+        return (pak->fec_touched ?
+                VQEC_DP_LATENCY_FEC : VQEC_DP_LATENCY_REPAIR);
+    default:
+        return (VQEC_DP_LATENCY_CLASS_MAX);
+    }
+}
+
 /**
  * @}
  */
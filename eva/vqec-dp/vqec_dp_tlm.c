@@ -22,6 +22,7 @@
 #include <vqec_dp_output_shim_api.h>
 #include <vqec_dp_rtp_input_stream.h>
 #include <vqec_dpchan_api.h>
+#include <vqec_lock.h>
 #include "vqec_dp_common.h"
 
 #ifdef _VQEC_DP_UTEST
@@ -53,6 +54,32 @@ static uint16_t vqec_dp_fast_sched_interval =
 static uint16_t vqec_dp_slow_sched_interval =
     VQEC_DP_SLOW_SCHEDULE_INTERVAL_MSEC;
 
+/*
+ * Statistics published for readers, indexed by the double-buffer index.
+ * Readers copy the current buffer without the dataplane lock (their RPCs
+ * are RPC_NOLOCK), while the polling event refreshes the other one.
+ */
+typedef
+struct vqec_dp_tlm_stats_pub_
+{
+    /**
+     * Snapshots since the last clear [0] and cumulative [1].
+     */
+    vqec_dp_stats_snapshot_t snapshot[2];
+    /**
+     * Global debug counters.
+     */
+    vqec_dp_global_debug_stats_t global;
+    /**
+     * Join delay, output scheduling and reader jitter histograms.
+     */
+    vqec_dp_histogram_data_t hists[VQEC_DP_PUBLISHED_HIST_MAX];
+
+} vqec_dp_tlm_stats_pub_t;
+
+static vqec_dp_tlm_stats_pub_t s_vqec_dp_tlm_stats_pub[2];
+static vqec_dbuf_t s_vqec_dp_tlm_stats_dbuf;
+
 /**
  * Set the default DP polling interval.
  *
@@ -134,6 +161,64 @@ vqec_dp_tlm_get (void)
     return (s_vqec_dp_tlm_info);
 }
 
+/**
+ * Publishes a copy of the channel, tuner and global statistics.  The copy
+ * is built in the spare buffer, and then made current for readers.
+ */
+void
+vqec_dp_tlm_publish_stats (void)
+{
+    vqec_dp_tlm_stats_pub_t *pub;
+    uint32_t i;
+
+    if (!s_vqec_dp_tlm_info) {
+        return;
+    }
+
+    pub = &s_vqec_dp_tlm_stats_pub[
+        vqec_dbuf_write_idx(&s_vqec_dp_tlm_stats_dbuf)];
+    for (i = 0; i < 2; i++) {
+        pub->snapshot[i].num_chans = 
+            vqec_dpchan_get_stats_summary(pub->snapshot[i].chans,
+                                          VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS,
+                                          (i != 0));
+        pub->snapshot[i].num_tuners = 
+            vqec_dp_output_shim_get_tuner_summary(
+                pub->snapshot[i].tuners,
+                VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS,
+                (i != 0));
+    }
+
+    #define VQEC_DP_TLM_CNT_DECL(name,desc)                                 \
+        pub->global.name =                                                  \
+            vqec_dp_ev_cnt_get(&s_vqec_dp_tlm_info->counters.name, FALSE);
+    #include "vqec_dp_tlm_cnt_decl.h"
+    #undef VQEC_DP_TLM_CNT_DECL
+
+    if (vqec_dp_chan_hist_get(
+            VQEC_DP_HIST_JOIN_DELAY, 
+            &pub->hists[VQEC_DP_PUBLISHED_HIST_JOIN_DELAY]) != 
+        VQEC_DP_ERR_OK) {
+        memset(&pub->hists[VQEC_DP_PUBLISHED_HIST_JOIN_DELAY], 0,
+               sizeof(vqec_dp_histogram_data_t));
+    }
+    if (vqec_dp_chan_hist_get(
+            VQEC_DP_HIST_OUTPUTSCHED, 
+            &pub->hists[VQEC_DP_PUBLISHED_HIST_OUTPUTSCHED]) != 
+        VQEC_DP_ERR_OK) {
+        memset(&pub->hists[VQEC_DP_PUBLISHED_HIST_OUTPUTSCHED], 0,
+               sizeof(vqec_dp_histogram_data_t));
+    }
+    vqec_dp_output_shim_get_reader_jitter_hist(
+        &pub->hists[VQEC_DP_PUBLISHED_HIST_READER_JITTER]);
+
+    vqec_dbuf_publish(&s_vqec_dp_tlm_stats_dbuf);
+    s_vqec_dp_tlm_info->last_stats_publish = get_sys_time();
+    s_vqec_dp_tlm_info->next_stats_publish = 
+        TIME_ADD_A_R(s_vqec_dp_tlm_info->last_stats_publish, 
+                     TIME_MK_R(msec, VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS));
+}
+
 /**
  * Event handler callback for the TLM polling event.
  *
@@ -148,11 +233,31 @@ vqec_dp_tlm_event_handler (const vqec_event_t *const evptr,
                            int16_t event,
                            void *arg)
 {
-    abs_time_t cur_time;
+    abs_time_t cur_time, idle_publish;
 
     vqec_dp_input_shim_run_service(*(uint16_t *)arg);
     cur_time = get_sys_time();
     vqec_dpchan_poll_ev_handler(cur_time);
+
+    /*
+     * Statistics that have not been read since they were last published
+     * are only republished once per idle interval.
+     */
+    if (TIME_CMP_A(ge, cur_time, s_vqec_dp_tlm_info->next_stats_publish)) {
+        idle_publish = 
+            TIME_ADD_A_R(s_vqec_dp_tlm_info->last_stats_publish,
+                         TIME_MK_R(msec, 
+                                   VQEC_DP_STATS_PUBLISH_IDLE_INTERVAL_MSECS));
+        if (vqec_dbuf_is_read(&s_vqec_dp_tlm_stats_dbuf) ||
+            TIME_CMP_A(ge, cur_time, idle_publish)) {
+            vqec_dp_tlm_publish_stats();
+        } else {
+            s_vqec_dp_tlm_info->next_stats_publish = 
+                TIME_ADD_A_R(cur_time, 
+                             TIME_MK_R(msec, 
+                                       VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS));
+        }
+    }
 }
 
 /* wait 20 msec * 100 times = 2 seconds total */
@@ -321,6 +426,8 @@ vqec_dp_init_module (vqec_dp_module_init_params_t *params)
         goto done;
     }
 
+    vqec_dp_tlm_publish_stats();
+
 done:
     if (status != VQEC_DP_ERR_OK) {
         vqec_dp_tlm_deinit_module_internal();
@@ -383,7 +490,8 @@ vqec_dp_get_default_pakpool_status (vqec_pak_pool_status_t *status)
 
 
 /**---------------------------------------------------------------------------
- * Retrieve the global event debug counters.
+ * Retrieve the global event debug counters, as last published.  The
+ * counters are copied without holding the dataplane lock.
  *
  * @param[out] counters Output structure for the counters.
  * @param[out] vqec_dp_error_t Returns VQEC_DP_ERR_OK on success.
@@ -391,15 +499,87 @@ vqec_dp_get_default_pakpool_status (vqec_pak_pool_status_t *status)
 vqec_dp_error_t
 vqec_dp_get_global_counters (vqec_dp_global_debug_stats_t *stats)
 {
+    uint32_t version;
+
     if (!s_vqec_dp_tlm_info || !stats) {
         return (VQEC_DP_ERR_INVALIDARGS);
     }
 
-    #define VQEC_DP_TLM_CNT_DECL(name,desc)                                 \
-        stats->name = vqec_dp_ev_cnt_get(&s_vqec_dp_tlm_info->counters.name, \
-                                         FALSE);
-    #include "vqec_dp_tlm_cnt_decl.h"
-    #undef VQEC_DP_TLM_CNT_DECL
+    do {
+        version = vqec_dbuf_read_begin(&s_vqec_dp_tlm_stats_dbuf);
+        *stats = s_vqec_dp_tlm_stats_pub[version & 1].global;
+    } while (vqec_dbuf_read_retry(&s_vqec_dp_tlm_stats_dbuf, version));
+
+    return (VQEC_DP_ERR_OK);   
+}
+
+/**---------------------------------------------------------------------------
+ * Publish the statistics at once, rather than at the next polling event.
+ *
+ * @param[out] vqec_dp_error_t Returns VQEC_DP_ERR_OK on success.
+ *---------------------------------------------------------------------------*/ 
+vqec_dp_error_t
+vqec_dp_publish_stats (void)
+{
+    if (!s_vqec_dp_tlm_info) {
+        return (VQEC_DP_ERR_INVALIDARGS);
+    }
+
+    vqec_dp_tlm_publish_stats();
+    return (VQEC_DP_ERR_OK);
+}
+
+/**---------------------------------------------------------------------------
+ * Retrieve compact statistics for all channels and tuners.  This lets the
+ * control plane poll every channel with a single IPC.  The statistics are
+ * those last published, and are copied without holding the dataplane lock.
+ *
+ * @param[in] cumulative Boolean flag to retrieve cumulative stats.
+ * @param[out] snapshot Output structure for the statistics.
+ * @param[out] vqec_dp_error_t Returns VQEC_DP_ERR_OK on success.
+ *---------------------------------------------------------------------------*/ 
+vqec_dp_error_t
+vqec_dp_get_stats_snapshot (boolean cumulative,
+                            vqec_dp_stats_snapshot_t *snapshot)
+{
+    uint32_t version;
+
+    if (!s_vqec_dp_tlm_info || !snapshot) {
+        return (VQEC_DP_ERR_INVALIDARGS);
+    }
+
+    do {
+        version = vqec_dbuf_read_begin(&s_vqec_dp_tlm_stats_dbuf);
+        *snapshot = 
+            s_vqec_dp_tlm_stats_pub[version & 1].snapshot[cumulative ? 1 : 0];
+    } while (vqec_dbuf_read_retry(&s_vqec_dp_tlm_stats_dbuf, version));
+
+    return (VQEC_DP_ERR_OK);   
+}
+
+/**---------------------------------------------------------------------------
+ * Retrieve a histogram, as last published.  It is copied without holding 
+ * the dataplane lock.
+ *
+ * @param[in] hist Histogram to be retrieved.
+ * @param[out] hist_ptr Buffer into which the histogram is copied.
+ * @param[out] vqec_dp_error_t Returns VQEC_DP_ERR_OK on success.
+ *---------------------------------------------------------------------------*/ 
+vqec_dp_error_t
+vqec_dp_get_published_hist (vqec_dp_published_hist_t hist,
+                            vqec_dp_histogram_data_t *hist_ptr)
+{
+    uint32_t version;
+
+    if (!s_vqec_dp_tlm_info || !hist_ptr || 
+        (hist < 0) || (hist >= VQEC_DP_PUBLISHED_HIST_MAX)) {
+        return (VQEC_DP_ERR_INVALIDARGS);
+    }
+
+    do {
+        version = vqec_dbuf_read_begin(&s_vqec_dp_tlm_stats_dbuf);
+        *hist_ptr = s_vqec_dp_tlm_stats_pub[version & 1].hists[hist];
+    } while (vqec_dbuf_read_retry(&s_vqec_dp_tlm_stats_dbuf, version));
 
     return (VQEC_DP_ERR_OK);   
 }
@@ -575,6 +755,24 @@ vqec_dp_get_benchmark(uint32_t interval, uint32_t *cpu_usage) {
     return VQEC_DP_ERR_OK;
 }
 
+/**
+ * Gets the execution profiles of the dataplane event loop.
+ *
+ * @param[out] profile Profiles of the dataplane events, by name.
+ * @param[out] vqec_dp_error_t Returns VQEC_DP_ERR_OK on success
+ */
+vqec_dp_error_t
+vqec_dp_get_event_profile (vqec_dp_event_profile_t *profile)
+{
+    if (!profile) {
+        return (VQEC_DP_ERR_INVALIDARGS);
+    }
+    profile->num_events = 
+        vqec_dp_event_get_profile(profile->events, 
+                                  VQEC_DP_EVENT_PROFILE_MAX);
+    return (VQEC_DP_ERR_OK);
+}
+
 /**
  * Get operating mode of the dataplane.
  *
@@ -67,6 +67,14 @@ struct vqec_dp_tlm_
      * Various debug counters and statistics.
      */
     vqec_dp_tlm_debug_cnt_t counters;
+    /**
+     * Time at which statistics are next published for readers.
+     */
+    abs_time_t next_stats_publish;
+    /**
+     * Time at which statistics were last published.
+     */
+    abs_time_t last_stats_publish;
 
 } vqec_dp_tlm_t;
 
@@ -99,4 +107,12 @@ struct vqec_dp_tlm_
 vqec_dp_tlm_t *
 vqec_dp_tlm_get(void);
 
+/**
+ * Publishes a copy of the channel, tuner and global statistics, from which
+ * statistics readers are served.  This is done every publish interval from
+ * the polling event, and on demand.
+ */
+void
+vqec_dp_tlm_publish_stats(void);
+
 #endif /* __VQEC_DP_TLM_H__ */
@@ -658,3 +658,25 @@ static inline boolean is_vqec_cfg_log_level_valid (uint32_t val) {
  * stun optimization
  ******/
 #define VQEC_SYSCFG_DEFAULT_STUN_OPTIMIZATION            (TRUE)
+
+/*****
+ * shared RTCP receive sockets
+ ******/
+#define VQEC_SYSCFG_DEFAULT_RTCP_SHARED_SOCKETS          (FALSE)
+
+/*****
+ * metrics_export_port
+ ******/
+#define VQEC_SYSCFG_DEFAULT_METRICS_EXPORT_PORT          (0)
+#define VQEC_SYSCFG_MIN_R1_METRICS_EXPORT_PORT           (1024)
+#define VQEC_SYSCFG_MAX_R1_METRICS_EXPORT_PORT           ((1<<16)- 1)
+static inline boolean is_vqec_cfg_metrics_export_port_valid (uint32_t val) {
+    if (val == 0) {
+        return (TRUE);
+    }
+    if ((val >= VQEC_SYSCFG_MIN_R1_METRICS_EXPORT_PORT) && 
+        (val <= VQEC_SYSCFG_MAX_R1_METRICS_EXPORT_PORT)) {
+        return (TRUE);
+    }
+    return (FALSE);
+}
@@ -742,6 +742,27 @@ ARR_ELEM("stun_optimization",       VQEC_CFG_STUN_OPTIMIZATION,
          VQEC_UPDATE_INVALID,
          VQEC_V4_ATTRIBUTES_NAMESPACE_ID,
          VQEC_PARAM_STATUS_CURRENT)
+ARR_ELEM("rtcp_shared_sockets",     VQEC_CFG_RTCP_SHARED_SOCKETS,
+         VQEC_TYPE_BOOLEAN, "When TRUE, the unicast RTCP receive sockets "
+         "of all channels are shared per local port and demultiplexed "
+         "by source and SSRC; when FALSE, each session opens its own.",
+         FALSE,
+         FALSE, 
+         VQEC_BOOL_CONSTRUCTOR(FALSE),
+         VQEC_UPDATE_STARTUP,
+         VQEC_V4_ATTRIBUTES_NAMESPACE_ID,
+         VQEC_PARAM_STATUS_CURRENT)
+ARR_ELEM("metrics_export_port",     VQEC_CFG_METRICS_EXPORT_PORT,
+         VQEC_TYPE_UINT32_T, "Loopback TCP port on which the dataplane "
+         "counters, channel and tuner statistics and histograms are "
+         "served in a text exposition format, for collection by a "
+         "monitoring agent. A port of 0 disables the exporter.",
+         FALSE,
+         FALSE, 
+         VQEC_UINT32_RANGE_CONSTRUCTOR(0, 0:0, 1024:(1<<16) - 1),
+         VQEC_UPDATE_STARTUP,
+         VQEC_V4_ATTRIBUTES_NAMESPACE_ID,
+         VQEC_PARAM_STATUS_CURRENT)
 ARR_ELEM("must_be_last",         VQEC_CFG_MUST_BE_LAST,
          VQEC_TYPE_STRING,   "Don't add after this",
          FALSE,      /* Must be last */
@@ -36,6 +36,7 @@
 #include "vqec_ifclient.h"
 #include "vqec_ifclient_private.h"
 #include "vqec_url.h"
+#include "vqec_rtcp_mux.h"
 
 #ifdef _VQEC_UTEST_INTERPOSERS
 #include "test_vqec_utest_interposers.h"
@@ -160,6 +161,69 @@ vqec_chanid_to_chan (const vqec_chanid_t chanid)
     }
 }
 
+/*
+ * Active channels are indexed by their (primary_dest_addr,
+ * primary_dest_port) pair, and, for the stats APIs, by URL.  Both
+ * indices use elements embedded in the channel.
+ */
+#define VQEC_CHAN_HASH_BUCKETS 256      /* must be a power of 2 */
+
+static uint32_t
+vqec_chan_dest_hash_func (uint8_t *key, int32_t len, int32_t mask)
+{
+    vqec_chan_dest_key_t *dest = (vqec_chan_dest_key_t *)key;
+    uint32_t hash;
+
+    hash = (ntohl(dest->addr) * 2654435761U) ^ ntohs(dest->port);
+    return ((hash ^ (hash >> 16)) & (VQEC_CHAN_HASH_BUCKETS - 1));
+}
+
+static uint32_t
+vqec_chan_url_hash_func (uint8_t *key, int32_t len, int32_t mask)
+{
+    uint32_t hash = 2166136261U;
+
+    while (len--) {
+        hash = (hash ^ *key++) * 16777619U;
+    }
+    return ((hash ^ (hash >> 16)) & (VQEC_CHAN_HASH_BUCKETS - 1));
+}
+
+/*
+ * Adds a channel to the destination index.
+ *
+ * @param[in]  chan          channel to be added.
+ * @param[out] boolean       Returns TRUE on success.
+ */
+static boolean
+vqec_chan_dest_index (vqec_chan_t *chan)
+{
+    vqe_hash_key_t key;
+
+    memset(&chan->dest_key, 0, sizeof(chan->dest_key));
+    chan->dest_key.addr = chan->cfg.primary_dest_addr.s_addr;
+    chan->dest_key.port = chan->cfg.primary_dest_port;
+    VQE_HASH_MAKE_KEY(&key, &chan->dest_key, sizeof(chan->dest_key));
+    vqe_hash_elem_init(&chan->dest_elem, &key, chan);
+    return (MCALL(g_channel_module->dest_hash, vqe_hash_add_elem,
+                  &chan->dest_elem));
+}
+
+/*
+ * Removes a channel from the URL index, if it is in it.
+ *
+ * @param[in]  chan          channel to be removed.
+ */
+static void
+vqec_chan_url_unindex (vqec_chan_t *chan)
+{
+    if (chan->url_indexed) {
+        (void)MCALL(g_channel_module->url_hash, vqe_hash_del_elem,
+                    &chan->url_elem);
+        chan->url_indexed = FALSE;
+    }
+}
+
 /*
  * Searches the active channel database for the given channel, which
  * is identified by its (primary_dest_addr, primary_dest_port) pair.
@@ -172,19 +236,19 @@ vqec_chanid_to_chan (const vqec_chanid_t chanid)
 vqec_chan_t *
 vqec_chan_find (in_addr_t ip, in_port_t port)
 {
-    vqec_chan_t *curr_chan, *matching_chan = NULL;
+    vqec_chan_dest_key_t dest;
+    vqe_hash_key_t key;
+    vqe_hash_elem_t *elem;
 
     if (!g_channel_module) {
         return NULL;
     }
-    VQE_LIST_FOREACH(curr_chan, &g_channel_module->channel_list, list_obj) {
-        if ((curr_chan->cfg.primary_dest_addr.s_addr == ip) &&
-            (curr_chan->cfg.primary_dest_port == port)) {
-            matching_chan = curr_chan;
-            break;
-        }
-    }
-    return (matching_chan);
+    memset(&dest, 0, sizeof(dest));
+    dest.addr = ip;
+    dest.port = port;
+    VQE_HASH_MAKE_KEY(&key, &dest, sizeof(dest));
+    elem = MCALL(g_channel_module->dest_hash, vqe_hash_get_elem, &key);
+    return (elem ? (vqec_chan_t *)vqe_hash_get_elem_data(elem) : NULL);
 }
 
 /**
@@ -424,6 +488,9 @@ vqec_chan_deinit_final (vqec_chan_t *chan)
         vqec_event_destroy(&chan->bye_ev);
     }
 
+    vqec_chan_url_unindex(chan);
+    (void)MCALL(g_channel_module->dest_hash, vqe_hash_del_elem, 
+                &chan->dest_elem);
     VQE_LIST_REMOVE(chan, list_obj);
     free(chan);
 }
@@ -514,6 +581,7 @@ vqec_chan_destroy (vqec_chan_t *chan, boolean deinit_final)
     vqec_chan_deinit_multibye(chan, !deinit_final);
 
     /* Delete the channel ID: no external references possible */
+    vqec_chan_url_unindex(chan);
     id_delete(chan->chanid, g_channel_module->id_table_key);
 
     if (!deinit_final &&
@@ -546,8 +614,53 @@ destroy:
     vqec_chan_deinit_final(chan);
 }
 
+/*
+ * Poll interval for gaps while reports find none; gaps are then reported
+ * as the dataplane signals that they have aged.
+ */
+#define VQEC_CHANNEL_ER_IDLE_POLL_INTERVAL MSECS(500)
+
 /**---------------------------------------------------------------------------
- * Invoke the gap reporter if the channel's repair trigger time has arrived.
+ * Invoke the gap reporter, and schedule the next poll for gaps.
+ *
+ * Gaps are normally reported as soon as the dataplane signals that they have
+ * aged (see vqec_chan_upcall_gap_aged_event()), so polling is a fallback:
+ * while reports find gaps, e.g., when there were more gaps than fit in one
+ * generic NACK, the channel is polled every repair trigger time; otherwise,
+ * it is polled every VQEC_CHANNEL_ER_IDLE_POLL_INTERVAL.
+ * 
+ * @param[in] chan Pointer to the channel.
+ * @param[in] cur_time Current system time.
+ *---------------------------------------------------------------------------*/ 
+static void
+vqec_chan_gap_report (vqec_chan_t *chan, abs_time_t cur_time)
+{
+    uint64_t repairs;
+
+    repairs = chan->stats.total_repairs_requested + 
+        chan->stats.total_repairs_unrequested;
+    vqec_gap_reporter_report(NULL, 
+                             0, 
+                             0, 
+                             (void *)chan->chanid);
+
+    if (repairs != chan->stats.total_repairs_requested + 
+        chan->stats.total_repairs_unrequested) {
+        chan->next_er_sched_time = TIME_ADD_A_R(cur_time,
+                                                chan->repair_trigger_time);
+    } else if (TIME_CMP_R(gt, 
+                          chan->repair_trigger_time, 
+                          VQEC_CHANNEL_ER_IDLE_POLL_INTERVAL)) {
+        chan->next_er_sched_time = TIME_ADD_A_R(cur_time,
+                                                chan->repair_trigger_time);
+    } else {
+        chan->next_er_sched_time = 
+            TIME_ADD_A_R(cur_time, VQEC_CHANNEL_ER_IDLE_POLL_INTERVAL);
+    }
+}
+
+/**---------------------------------------------------------------------------
+ * Invoke the gap reporter if the channel's next poll time has arrived.
  * The method "rounds down" the poll time, i.e., if repair trigger time is
  * 30 msecs, and the poll internal is 20 msecs, the channel will be polled for
  * gaps every 20 msecs. The computation of next_er_sched_time reflects
@@ -562,12 +675,7 @@ static void
 vqec_chan_poll_gap_report (vqec_chan_t *chan, abs_time_t cur_time)
 {
     if (TIME_CMP_A(ge, cur_time, chan->next_er_sched_time)) {
-        chan->next_er_sched_time = TIME_ADD_A_R(cur_time,
-                                                chan->repair_trigger_time);
-        vqec_gap_reporter_report(NULL, 
-                                 0, 
-                                 0, 
-                                 (void *)chan->chanid);
+        vqec_chan_gap_report(chan, cur_time);
     }
 }
 
@@ -672,12 +780,32 @@ vqec_chan_module_init (void)
     /* Initialize a linked list for storing active channels */
     VQE_LIST_INIT(&g_channel_module->channel_list);
 
+    /* ...and the indices by destination and by URL */
+    init_vqe_hash_elem_module();
+    init_vqe_hash_module();
+    g_channel_module->dest_hash = vqe_hash_create(VQEC_CHAN_HASH_BUCKETS,
+                                                  vqec_chan_dest_hash_func,
+                                                  NULL);
+    g_channel_module->url_hash = vqe_hash_create(VQEC_CHAN_HASH_BUCKETS,
+                                                 vqec_chan_url_hash_func,
+                                                 NULL);
+    if (!g_channel_module->dest_hash || !g_channel_module->url_hash) {
+        status = VQEC_CHAN_ERR_NOMEM;
+        goto done;
+    }
+
     /* Initialize child RTP module(s). */
     if (!rtp_repair_recv_init_module(g_channel_module->max_channels) ||
         !rtp_era_recv_init_module(g_channel_module->max_channels)) {
         status = VQEC_CHAN_ERR_INTERNAL;
         goto done;
     }
+
+    /* Share RTCP receive sockets between the RTP sessions, if enabled. */
+    if (syscfg->rtcp_shared_sockets && !vqec_rtcp_mux_init()) {
+        status = VQEC_CHAN_ERR_NOMEM;
+        goto done;
+    }
     
     /*
      * All activities inclusive of error-repair polls and STB polls are
@@ -707,6 +835,13 @@ done:
             if (g_channel_module->poll_ev) {
                 vqec_event_destroy(&g_channel_module->poll_ev);
             }
+            if (g_channel_module->dest_hash) {
+                (void)vqe_hash_destroy_x(g_channel_module->dest_hash, FALSE);
+            }
+            if (g_channel_module->url_hash) {
+                (void)vqe_hash_destroy_x(g_channel_module->url_hash, FALSE);
+            }
+            vqec_rtcp_mux_deinit();
             free(g_channel_module);
             g_channel_module = NULL;
         }
@@ -748,6 +883,9 @@ vqec_chan_module_deinit (void)
         vqec_chan_destroy(chan, TRUE);
     }
 
+    /* Close any shared RTCP sockets, now that all sessions are gone */
+    vqec_rtcp_mux_deinit();
+
     /* Destroy the channel module's ID Manager table */
     if (g_channel_module->id_table_key != ID_MGR_TABLE_KEY_ILLEGAL) {
         id_destroy_table(g_channel_module->id_table_key);
@@ -761,6 +899,13 @@ vqec_chan_module_deinit (void)
     if (g_channel_module->poll_ev) {
         vqec_event_destroy(&g_channel_module->poll_ev);
     }
+    /* Free the channel indices; their elements are part of the channels */
+    if (g_channel_module->dest_hash) {
+        (void)vqe_hash_destroy_x(g_channel_module->dest_hash, FALSE);
+    }
+    if (g_channel_module->url_hash) {
+        (void)vqe_hash_destroy_x(g_channel_module->url_hash, FALSE);
+    }
     /* Free the global channel module state */
     free(g_channel_module);
     g_channel_module = NULL;
@@ -821,6 +966,109 @@ done:
     return (status);
 }
 
+/**
+ * Retrieves a channel manager ID for the active channel which was
+ * last associated with the supplied URL by vqec_chan_index_url().
+ *
+ * @param[out] chanid   Retrieved channel's ID upon success, or
+ *                      VQEC_CHANID_INVALID upon failure.
+ * @param[in] url       URL by which the channel is requested
+ * @param[out] vqec_chan_err_t 
+ *                      Returns VQEC_CHAN_ERR_OK upon success,
+ *                      VQEC_CHAN_ERR_NOTFOUND if no channel is
+ *                      associated with the URL.
+ */
+vqec_chan_err_t
+vqec_chan_find_chanid_by_url (vqec_chanid_t *chanid, const char *url)
+{
+    vqec_chan_err_t status = VQEC_CHAN_ERR_OK;
+    vqe_hash_key_t key;
+    vqe_hash_elem_t *elem;
+    size_t len;
+
+    if (!chanid || !url) {
+        status = VQEC_CHAN_ERR_INVALIDARGS;
+        goto done;
+    } 
+    *chanid = VQEC_CHANID_INVALID;
+    if (!g_channel_module) {
+        status = VQEC_CHAN_ERR_NOTINITIALIZED;
+        goto done;
+    }
+    len = strlen(url);
+    if (!len || len >= VQEC_MAX_URL_LEN) {
+        status = VQEC_CHAN_ERR_NOTFOUND;
+        goto done;
+    }
+    VQE_HASH_MAKE_KEY(&key, url, len);
+    elem = MCALL(g_channel_module->url_hash, vqe_hash_get_elem, &key);
+    if (!elem) {
+        status = VQEC_CHAN_ERR_NOTFOUND;
+        goto done;
+    }
+    *chanid = ((vqec_chan_t *)vqe_hash_get_elem_data(elem))->chanid;
+done:
+    return (status);
+}
+
+/**
+ * Associates a URL with an active channel, so that it may be found by
+ * vqec_chan_find_chanid_by_url().  Any other channel associated with
+ * the same URL is dissociated from it.
+ *
+ * @param[in] chanid    ID of an active channel
+ * @param[in] url       URL which resolves to the channel
+ */
+void
+vqec_chan_index_url (vqec_chanid_t chanid, const char *url)
+{
+    vqec_chan_t *chan;
+    vqe_hash_key_t key;
+    vqe_hash_elem_t *elem;
+    size_t len;
+
+    chan = vqec_chanid_to_chan(chanid);
+    if (!chan || chan->shutdown || !url) {
+        return;
+    }
+    len = strlen(url);
+    if (!len || len >= VQEC_MAX_URL_LEN) {
+        return;
+    }
+    if (chan->url_indexed && !strcmp(chan->url_key, url)) {
+        return;
+    }
+
+    vqec_chan_url_unindex(chan);
+    VQE_HASH_MAKE_KEY(&key, url, len);
+    elem = MCALL(g_channel_module->url_hash, vqe_hash_get_elem, &key);
+    if (elem) {
+        vqec_chan_url_unindex((vqec_chan_t *)vqe_hash_get_elem_data(elem));
+    }
+
+    (void)strlcpy(chan->url_key, url, sizeof(chan->url_key));
+    VQE_HASH_MAKE_KEY(&key, chan->url_key, len);
+    vqe_hash_elem_init(&chan->url_elem, &key, chan);
+    chan->url_indexed = MCALL(g_channel_module->url_hash, vqe_hash_add_elem,
+                              &chan->url_elem);
+}
+
+/**
+ * Removes all associations between URLs and channels.
+ */
+void
+vqec_chan_flush_url_index (void)
+{
+    vqec_chan_t *chan;
+
+    if (!g_channel_module) {
+        return;
+    }
+    VQE_LIST_FOREACH(chan, &g_channel_module->channel_list, list_obj) {
+        vqec_chan_url_unindex(chan);
+    }
+}
+
 /**
  * Converts a channel_cfg_t structure (based on SDP)
  * into a vqec_chan_cfg_t structure (internal VQE-C
@@ -1254,6 +1502,10 @@ vqec_chan_get_chanid (vqec_chanid_t *chanid, vqec_chan_cfg_t *cfg)
             goto done;
         }
     }
+    if (!vqec_chan_dest_index(chan)) {
+        status = VQEC_CHAN_ERR_INTERNAL;
+        goto done;
+    }
     VQE_LIST_INSERT_HEAD(&g_channel_module->channel_list, chan, list_obj);
     
 done:
@@ -3364,6 +3616,110 @@ done:
     return (status);    
 }
 
+/**
+ * Populate compact counters for all active channels.
+ *
+ * The dataplane counters of all channels are gathered beforehand in a
+ * single snapshot, so that they can be polled without an IPC per channel.
+ * The counters are derived as by vqec_chan_get_counters_channel(), except
+ * for tuner_queue_drops which is left to the caller.
+ *
+ * @param[in]  snapshot        Statistics of all dataplane channels.
+ * @param[out] chans           Array of channel summaries to be filled.
+ * @param[out] chanids         IDs of the summarized channels, by index.
+ * @param[in]  max_chans       Number of entries in chans and chanids.
+ * @param[out] num_chans       Number of channel summaries filled.
+ * @param[in]  cumulative      Flag indicating cumulative counters desired.
+ * @param[out] vqec_chan_err_t Indicates success or reason for failure.
+ */
+vqec_chan_err_t
+vqec_chan_get_counters_summary (const vqec_dp_stats_snapshot_t *snapshot,
+                                vqec_ifclient_stats_channel_summary_t *chans,
+                                vqec_chanid_t *chanids,
+                                uint32_t max_chans,
+                                uint32_t *num_chans,
+                                boolean cumulative)
+{
+    vqec_chan_t *chan;
+    vqec_chan_tuner_entry_t *curr_tuner;
+    const vqec_dp_chan_stats_summary_t *dp;
+    vqec_ifclient_stats_channel_summary_t *s;
+    vqec_chan_err_t status = VQEC_CHAN_ERR_OK;
+    uint32_t i;
+
+    /* Validate state and parameters */
+    if (!g_channel_module) {
+        status = VQEC_CHAN_ERR_NOTINITIALIZED;
+        goto done;
+    }
+    if (!snapshot || !num_chans || (max_chans && (!chans || !chanids))) {
+        status = VQEC_CHAN_ERR_INVALIDARGS;
+        goto done;
+    }
+    *num_chans = 0;
+
+    VQE_LIST_FOREACH(chan, &g_channel_module->channel_list, list_obj) {
+        if (*num_chans == max_chans) {
+            break;
+        }
+        if (chan->shutdown || (chan->dp_chanid == VQEC_DP_CHANID_INVALID)) {
+            continue;
+        }
+        dp = NULL;
+        for (i = 0; i < snapshot->num_chans; i++) {
+            if (snapshot->chans[i].cp_handle == chan->chanid) {
+                dp = &snapshot->chans[i];
+                break;
+            }
+        }
+        if (!dp) {
+            continue;
+        }
+
+        chanids[*num_chans] = chan->chanid;
+        s = &chans[(*num_chans)++];
+        memset(s, 0, sizeof(*s));
+        s->primary_dest_addr = chan->cfg.primary_dest_addr;
+        s->primary_dest_port = chan->cfg.primary_dest_port;
+        VQE_TAILQ_FOREACH(curr_tuner, &chan->tuner_list, list_obj) {
+            s->num_tuners++;
+        }
+
+        s->primary_rtp_expected = dp->primary_rtp_expected;
+        s->primary_rtp_lost = 
+            s->primary_rtp_expected - dp->primary_rtp_received;
+        if (!cumulative) {
+            s->primary_rtp_expected -= chan->primary_rtp_expected_snapshot;
+            s->primary_rtp_lost -= chan->primary_rtp_lost_snapshot;
+        }
+
+        s->primary_udp_inputs = dp->primary_udp_inputs;
+        s->primary_rtp_inputs = dp->primary_rtp_inputs;
+        s->primary_rtp_drops = dp->primary_rtp_drops;
+        s->repair_rtp_inputs = dp->repair_rtp_inputs;
+        s->repair_rtp_drops = dp->repair_rtp_drops;
+        s->fec_inputs = dp->fec_inputs;
+        s->fec_recovered_paks = dp->fec_recovered_paks;
+        s->pre_repair_losses = dp->pre_repair_losses;
+        s->post_repair_losses = dp->post_repair_losses;
+        s->post_repair_outputs = dp->post_repair_outputs;
+        s->underruns = dp->underruns;
+
+        if (chan->er_enabled) {
+            s->repairs_requested = chan->stats.total_repairs_requested;
+            s->repairs_policed = chan->stats.total_repairs_policed;
+            if (!cumulative) {
+                s->repairs_requested -= 
+                    chan->stats_snapshot.total_repairs_requested;
+                s->repairs_policed -= 
+                    chan->stats_snapshot.total_repairs_policed;
+            }
+        }
+    }
+done:
+    return (status);    
+}
+
 /**
  * API to set TR-135 parameters for a channel
  *
@@ -4120,6 +4476,70 @@ vqec_chan_err_t vqec_chan_get_tuner_q_drops (vqec_chanid_t chanid,
     return VQEC_CHAN_ERR_OK;
 }
 
+/**---------------------------------------------------------------------------
+ * Get a packet latency histogram of a channel.  Sink residence is kept by
+ * the dataplane per tuner, and is summed over the tuners bound to the
+ * channel.
+ *
+ * @param[in]  chanid              Channel identifier.
+ * @param[in]  stage               Latency stage.
+ * @param[in]  cls                 Class of packets.
+ * @param[out] hist                Histogram.
+ * @returns vqec_chan_err_t
+ *---------------------------------------------------------------------------*/
+vqec_chan_err_t vqec_chan_get_latency_hist (vqec_chanid_t chanid,
+                                            vqec_dp_latency_stage_t stage,
+                                            vqec_dp_latency_class_t cls,
+                                            vqec_dp_histogram_data_t *hist)
+{
+    static int32_t ranges[] = VQEC_DP_LATENCY_HIST_RANGES;
+    static const char *titles[VQEC_DP_LATENCY_CLASS_MAX] = {
+        "Sink residence, primary packets (in usec)",
+        "Sink residence, repair packets (in usec)",
+        "Sink residence, FEC-recovered packets (in usec)"
+    };
+    vqec_dp_histogram_data_t tuner_hist;
+    vqec_chan_tuner_entry_t *curr_tuner;
+    vqec_dp_error_t status_dp;
+    vqec_chan_t *chan;
+
+    if (!g_channel_module) {
+        return VQEC_CHAN_ERR_NOTINITIALIZED;
+    }
+    if ((stage < 0) || (stage >= VQEC_DP_LATENCY_STAGE_MAX) ||
+        (cls < 0) || (cls >= VQEC_DP_LATENCY_CLASS_MAX) || !hist) {
+        return VQEC_CHAN_ERR_INVALIDARGS;
+    }
+    chan = vqec_chanid_to_chan(chanid);
+    if (!chan || chan->shutdown ||
+        (chan->dp_chanid == VQEC_DP_CHANID_INVALID)) {
+        return VQEC_CHAN_ERR_NOSUCHCHAN;
+    }
+
+    if (stage != VQEC_DP_LATENCY_SINK_RESIDENCE) {
+        status_dp = vqec_dp_chan_latency_hist_get(chan->dp_chanid, 
+                                                  stage, cls, hist);
+        return ((status_dp == VQEC_DP_ERR_OK) ? 
+                VQEC_CHAN_ERR_OK : VQEC_CHAN_ERR_INTERNAL);
+    }
+
+    (void)vam_hist_create_ranges((vam_hist_type_t *)hist,
+                                 ranges,
+                                 sizeof(ranges) / sizeof(ranges[0]),
+                                 (char *)titles[cls]);
+    VQE_TAILQ_FOREACH(curr_tuner, &chan->tuner_list, list_obj) {
+        status_dp = vqec_dp_output_shim_latency_hist_get(curr_tuner->tid,
+                                                         cls,
+                                                         &tuner_hist);
+        if ((status_dp != VQEC_DP_ERR_OK) ||
+            vam_hist_merge((vam_hist_type_t *)hist,
+                           (vam_hist_type_t *)&tuner_hist)) {
+            return VQEC_CHAN_ERR_INTERNAL;
+        }
+    }
+    return VQEC_CHAN_ERR_OK;
+}
+
 /* 
  * Collect XR DC stats and populate structure. Some of the fields must
  * be retrieved from the DP and should be filled in before this is called
@@ -4903,6 +5323,31 @@ vqec_chan_upcall_burst_done_event (vqec_chan_t *chan)
 } 
 
 
+/**---------------------------------------------------------------------------
+ * Process an aged-gap upcall event received for the channel: gaps have aged
+ * past the dataplane's hold time, and are reported immediately, rather than
+ * at the next poll.
+ *
+ * @param[in] chan Pointer to the channel.
+ *---------------------------------------------------------------------------*/ 
+void
+vqec_chan_upcall_gap_aged_event (vqec_chan_t *chan) 
+{
+    if (!chan || 
+        chan->shutdown ||
+        !chan->er_enabled ||
+        !chan->er_poll_active) {
+        return;
+    }
+
+    VQEC_DEBUG(VQEC_DEBUG_ERROR_REPAIR,
+               "Channel %s, dataplane signaled aged gaps\n",
+               vqec_chan_print_name(chan));
+
+    vqec_chan_gap_report(chan, get_sys_time());
+}
+
+
 /**---------------------------------------------------------------------------
  * Process a primary inactive upcall event received for the channel.
  *
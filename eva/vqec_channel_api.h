@@ -110,6 +110,41 @@ vqec_chan_err_t
 vqec_chan_find_chanid(vqec_chanid_t *chanid,
                       in_addr_t ip, uint16_t port);
 
+/**
+ * Retrieves a channel manager ID for the active channel which was
+ * last associated with the supplied URL by vqec_chan_index_url().
+ * This saves the caller from resolving the URL to a channel
+ * destination again.
+ *
+ * @param[out] chanid   Retrieved channel's ID upon success, or
+ *                      VQEC_CHANID_INVALID upon failure.
+ * @param[in] url       URL by which the channel is requested
+ * @param[out] vqec_chan_err_t 
+ *                      Returns VQEC_CHAN_ERR_OK upon success,
+ *                      VQEC_CHAN_ERR_NOTFOUND if no channel is
+ *                      associated with the URL.
+ */
+vqec_chan_err_t
+vqec_chan_find_chanid_by_url(vqec_chanid_t *chanid, const char *url);
+
+/**
+ * Associates a URL with an active channel, so that it may be found by
+ * vqec_chan_find_chanid_by_url(). A channel is associated with at most
+ * one URL; URLs longer than VQEC_MAX_URL_LEN are not associated.
+ *
+ * @param[in] chanid    ID of an active channel
+ * @param[in] url       URL which resolves to the channel
+ */
+void
+vqec_chan_index_url(vqec_chanid_t chanid, const char *url);
+
+/**
+ * Removes all associations between URLs and channels. To be called
+ * whenever the channel lineup, by which URLs are resolved, changes.
+ */
+void
+vqec_chan_flush_url_index(void);
+
 /**
  * Converts a channel_cfg_t structure (based on SDP)
  * into a vqec_chan_cfg_t structure (internal VQE-C
@@ -283,6 +318,26 @@ vqec_chan_get_counters_channel(vqec_chanid_t chanid,
                                vqec_ifclient_stats_channel_t *stats,
                                boolean cumulative);
 
+/**
+ * Get compact counters for all active channels from a dataplane
+ * statistics snapshot.
+ *
+ * @param[in]  snapshot        Statistics of all dataplane channels.
+ * @param[out] chans           Array of channel summaries to be filled.
+ * @param[out] chanids         IDs of the summarized channels, by index.
+ * @param[in]  max_chans       Number of entries in chans and chanids.
+ * @param[out] num_chans       Number of channel summaries filled.
+ * @param[in]  cumulative      Flag indicating cumulative counters desired.
+ * @param[out] vqec_chan_err_t Indicates success or reason for failure.
+ */
+vqec_chan_err_t
+vqec_chan_get_counters_summary(const vqec_dp_stats_snapshot_t *snapshot,
+                               vqec_ifclient_stats_channel_summary_t *chans,
+                               vqec_chanid_t *chanids,
+                               uint32_t max_chans,
+                               uint32_t *num_chans,
+                               boolean cumulative);
+
 /**
  * Get TR-135 sample counters for an individual channel.
  *
@@ -320,6 +375,21 @@ vqec_chan_err_t vqec_chan_get_tuner_q_drops(vqec_chanid_t chanid,
                                             uint64_t *tuner_queue_drops,
                                             boolean cumulative);
 
+/*
+ * Get a packet latency histogram of a channel; sink residence is summed
+ * over the tuners bound to the channel.
+ *
+ * @param[in]  chanid              Channel identifier.
+ * @param[in]  stage               Latency stage.
+ * @param[in]  cls                 Class of packets.
+ * @param[out] hist                Histogram.
+ * @returns vqec_chan_err_t
+ */
+vqec_chan_err_t vqec_chan_get_latency_hist(vqec_chanid_t chanid,
+                                           vqec_dp_latency_stage_t stage,
+                                           vqec_dp_latency_class_t cls,
+                                           vqec_dp_histogram_data_t *hist);
+
 /**
  * Retrieve a channel's input shim stream identifiers.
  *
@@ -370,6 +440,12 @@ vqec_chan_clear_counters(void);
 void
 vqec_chan_display_state(vqec_chanid_t chanid, uint32_t options_flag);
 
+/**
+ * Display the packet latency histograms of all active channels.
+ */
+void
+vqec_chan_display_latency_hist(void);
+
 /**
  * Function:    vqec_channel_cfg_printf()
  * Description: Print out the channel configuration data
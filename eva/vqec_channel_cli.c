@@ -520,6 +520,37 @@ void vqec_chan_cfg_printf_brief (vqec_chan_cfg_t *channel_p)
       }
 }
 
+/**
+ * Display the packet latency histograms of all active channels.
+ */
+void
+vqec_chan_display_latency_hist (void)
+{
+    vqec_dp_histogram_data_t hist;
+    vqec_chan_t *chan;
+    int stage, cls;
+
+    if (!g_channel_module) {
+        return;
+    }
+
+    VQE_LIST_FOREACH(chan, &g_channel_module->channel_list, list_obj) {
+        if (chan->shutdown) {
+            continue;
+        }
+        CONSOLE_PRINTF("Packet latency for channel %s\n",
+                       vqec_chan_print_name(chan));
+        for (stage = 0; stage < VQEC_DP_LATENCY_STAGE_MAX; stage++) {
+            for (cls = 0; cls < VQEC_DP_LATENCY_CLASS_MAX; cls++) {
+                if (vqec_chan_get_latency_hist(chan->chanid, stage, cls,
+                                               &hist) == VQEC_CHAN_ERR_OK) {
+                    vam_hist_display_nonzero_hits((vam_hist_type_t *)&hist);
+                }
+            }
+        }
+    }
+}
+
 /**
  * Display the state of a channel (equivalent to src_dump sans
  * the display of channel configuration from the configuration
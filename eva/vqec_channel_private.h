@@ -28,6 +28,8 @@
 #include <rtp/rcc_tlv.h>
 #endif
 #include "vqec_ifclient_fcc.h"
+#include "vqec_url.h"
+#include <utils/vqe_hash.h>
 
 /**
  * Storage for all global data within the channel module.
@@ -68,6 +70,8 @@ typedef struct vqec_channel_module_t_ {
     char *rtcp_iobuf;                      /*!< RTCP packet buffer */
     uint32_t rtcp_iobuf_len;               /*!< RTCP packet buffer length */
     VQE_LIST_HEAD(,vqec_chan_) channel_list; /*!< List of active channels */
+    vqe_hash_t *dest_hash;  /*!< Active channels by (dest addr, dest port) */
+    vqe_hash_t *url_hash;   /*!< Active channels by stats API URL */
 } vqec_channel_module_t;
 
 extern vqec_channel_module_t *g_channel_module;
@@ -190,6 +194,15 @@ struct vqec_chan_upcall_data_
     abs_time_t display_time; /* first frame display time at STB */\
     uint64_t display_pts;    /* first frame display PTS at STB */\
 
+/**
+ * Key of a channel in the destination index.
+ */
+typedef struct vqec_chan_dest_key_ {
+    in_addr_t addr;                     /*!< primary destination address */
+    in_port_t port;                     /*!< primary destination port */
+    uint16_t pad;                       /*!< always zero */
+} vqec_chan_dest_key_t;
+
 /**
  * VQEC channel data structure.
  */
@@ -218,6 +231,18 @@ struct vqec_chan_
      * of multiple-bye(s).
      */
     boolean shutdown;                               
+    /**
+     * Entry of the channel in the destination index.
+     */
+    vqec_chan_dest_key_t dest_key;
+    vqe_hash_elem_t dest_elem;
+    /**
+     * Entry of the channel in the URL index: the last URL by which
+     * the channel was looked up through the stats APIs, if any.
+     */
+    boolean url_indexed;
+    char url_key[VQEC_MAX_URL_LEN];
+    vqe_hash_elem_t url_elem;
     /**
      * List of tuners associated with this channel.
      */
@@ -764,6 +789,14 @@ vqec_chan_upcall_burst_done_event(vqec_chan_t *chan);
 
 #endif /* HAVE_FCC */
 
+/**
+ * Process an aged-gap upcall event received for the channel.
+ *
+ * @param[in] chan Pointer to the channel.
+ */
+void
+vqec_chan_upcall_gap_aged_event(vqec_chan_t *chan);
+
 /**
  * Process a primary inactive upcall event received for the channel.
  *
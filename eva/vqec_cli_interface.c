@@ -886,19 +886,60 @@ vqec_cli_show_ipc_status_safe (void)
 
 /**
  * Display dataplane global debug counters.
- * Acquires and releases the global lock.
+ * The counters are those published by the dataplane, so the global lock
+ * is not needed.
  */
 void
 vqec_cli_show_dp_global_counters_safe (void)
 {
     vqec_dp_global_debug_stats_t stats;
 
-    vqec_lock_lock(vqec_g_lock);
-
     if (vqec_dp_get_global_counters(&stats) == VQEC_DP_ERR_OK) {
         vqec_cli_dp_global_counters_print(&stats, DP_GLOBAL_COUNTERS_ALL);
     }
+}
+
+/**
+ * Display the execution profile of the event loop handlers, sorted by
+ * total execution time so that the handlers which hold up the event loop
+ * the most are listed first.  Lateness is only measured for timers.
+ * Acquires and releases the global lock.
+ */
+void
+vqec_cli_show_event_profile_safe (void)
+{
+    vqec_event_profile_t prof[VQEC_IFCLIENT_EVENT_PROFILE_MAX], tmp;
+    uint32_t num, i, j;
+
+    vqec_lock_lock(vqec_g_lock);
+    num = vqec_ifclient_event_profile_get_ul(prof, 
+                                             VQEC_IFCLIENT_EVENT_PROFILE_MAX);
     vqec_lock_unlock(vqec_g_lock);
+
+    for (i = 1; i < num; i++) {
+        tmp = prof[i];
+        for (j = i; (j > 0) && (prof[j - 1].total_usecs < tmp.total_usecs);
+             j--) {
+            prof[j] = prof[j - 1];
+        }
+        prof[j] = tmp;
+    }
+
+    CONSOLE_PRINTF("%-40s %10s %10s %8s %8s %8s %8s\n",
+                   "Event handler", "Runs", "Total(ms)", "Avg(us)",
+                   "Max(us)", "Late(us)", "MaxLate");
+    for (i = 0; i < num; i++) {
+        CONSOLE_PRINTF("%-40s %10llu %10llu %8llu %8u %8llu %8u\n",
+                       prof[i].name, 
+                       prof[i].runs,
+                       prof[i].total_usecs / 1000,
+                       prof[i].runs ? 
+                       prof[i].total_usecs / prof[i].runs : 0,
+                       prof[i].max_usecs,
+                       prof[i].timer_runs ?
+                       prof[i].total_late_usecs / prof[i].timer_runs : 0,
+                       prof[i].max_late_usecs);
+    }
 }
 
 void
@@ -154,6 +154,13 @@ void vqec_cli_show_ipc_status_safe(void);
 void
 vqec_cli_show_dp_global_counters_safe(void);
 
+/**
+ * Display the execution profile of the event loop handlers, busiest
+ * first.  Acquires and releases the global lock.
+ */
+void
+vqec_cli_show_event_profile_safe(void);
+
 /**
  * Display log sequence data from dataplane to the CLI.
  */ 
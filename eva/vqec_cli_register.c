@@ -1413,6 +1413,19 @@ vqec_cmd_show_ipc (struct vqec_cli_def *cli, char *command,
     return VQEC_CLI_OK;
 }
 
+UT_STATIC int32_t
+vqec_cmd_show_event_profile (struct vqec_cli_def *cli, char *command, 
+                             char *argv[], int argc)
+{
+    if ((argc > 0) || vqec_check_args_for_help_char(argv, argc)) {
+        vqec_cli_print(cli, "Usage: show event-profile");
+        return VQEC_CLI_ERROR;
+    }
+
+    vqec_cli_show_event_profile_safe();
+    return VQEC_CLI_OK;
+}
+
 UT_STATIC int32_t
 vqec_cmd_show_proxy_igmp (struct vqec_cli_def *cli, char *command,
                           char *argv[], int argc) 
@@ -3299,6 +3312,9 @@ UT_STATIC int vqec_cmd_clear_counters (struct vqec_cli_def *cli,
     if (vqec_ifclient_histogram_clear(VQEC_HIST_JOIN_DELAY) != VQEC_OK) {
         vqec_cli_print(cli, "Error in clearing join-delay histogram");
     }
+    if (vqec_ifclient_histogram_clear(VQEC_HIST_LATENCY) != VQEC_OK) {
+        vqec_cli_print(cli, "Error in clearing latency histograms");
+    }
     
     /* clear global/historical tuner counters */
     vqec_ifclient_clear_stats();
@@ -3945,6 +3961,39 @@ vqec_cmd_monitor_outputsched_reset (struct vqec_cli_def *cli, char *command,
     return VQEC_CLI_OK;
 }
 
+UT_STATIC int
+vqec_cmd_monitor_latency_show (struct vqec_cli_def *cli, char *command, 
+                               char *argv[], int argc)
+{
+    if ((argc > 0) || vqec_check_args_for_help_char(argv, argc)) {
+        vqec_cli_print(cli, "Usage: monitor latency show");
+        return VQEC_CLI_ERROR;
+    }
+
+    if (vqec_ifclient_histogram_display(VQEC_HIST_LATENCY) != VQEC_OK) {
+        vqec_cli_print(cli, "Error in displaying histogram");
+        return VQEC_CLI_ERROR;
+    }
+
+    return VQEC_CLI_OK;
+}
+
+UT_STATIC int
+vqec_cmd_monitor_latency_reset (struct vqec_cli_def *cli, char *command, 
+                                char *argv[], int argc)
+{
+    if ((argc > 0) || vqec_check_args_for_help_char(argv, argc)) {
+        vqec_cli_print(cli, "Usage: monitor latency reset");
+        return VQEC_CLI_ERROR;
+    }
+
+    if (vqec_ifclient_histogram_clear(VQEC_HIST_LATENCY) != VQEC_OK) {
+        return VQEC_CLI_ERROR;
+    }
+
+    return VQEC_CLI_OK;
+}
+
 UT_STATIC int
 vqec_cmd_monitor_benchmark_show (struct vqec_cli_def *cli, char *command, 
                                  char *argv[], int argc)
@@ -4269,6 +4318,16 @@ void vqec_register_show_cmds (struct vqec_cli_def *cli)
                               PRIVILEGE_UNPRIVILEGED, VQEC_CLI_MODE_EXEC,
                               "Show error-repair status");
 
+    /*
+     * show event-profile
+     * Displays the execution profile of each event loop handler
+     */
+    /*sa_ignore {no recourse on failure} IGNORE_RETURN (4) */
+    vqec_cli_register_command(cli, cmd_show_c, "event-profile",
+                              vqec_cmd_show_event_profile,
+                              PRIVILEGE_UNPRIVILEGED, VQEC_CLI_MODE_EXEC,
+                              "Show event loop handler profiles");
+
     /*
      * show fec 
      * Display current fec status
@@ -5209,6 +5268,7 @@ void vqec_register_monitor_cmds (struct vqec_cli_def *cli)
     struct vqec_cli_command *cmd_monitor_elog_c;
 #endif
     struct vqec_cli_command *cmd_monitor_outputsched_c;
+    struct vqec_cli_command *cmd_monitor_latency_c;
     struct vqec_cli_command *cmd_monitor_benchmark_c;
 
     /*
@@ -5325,6 +5385,38 @@ void vqec_register_monitor_cmds (struct vqec_cli_def *cli)
                                PRIVILEGE_PRIVILEGED, VQEC_CLI_MODE_EXEC,
                                "reset current output scheduling data");
 
+     /*
+      * monitor latency
+      * Commands to monitor per-channel packet latency
+      */
+     cmd_monitor_latency_c = 
+         vqec_cli_register_command(cli, cmd_monitor_c, "latency", NULL,
+                                   PRIVILEGE_PRIVILEGED, VQEC_CLI_MODE_EXEC,
+                                   "packet latency monitoring commands");
+     
+     VQEC_ASSERT(cmd_monitor_latency_c);
+
+    /*
+     * monitor latency show
+     * Prints the packet latency histograms of each active channel
+     */
+    /*sa_ignore {no recourse on failure} IGNORE_RETURN (4) */
+    vqec_cli_register_command(cli, cmd_monitor_latency_c, "show",
+                              vqec_cmd_monitor_latency_show,
+                              PRIVILEGE_PRIVILEGED, VQEC_CLI_MODE_EXEC,
+                              "print histograms of packet latency per "
+                              "channel");
+
+    /*
+     * monitor latency reset
+     * Reset current packet latency data
+     */
+    /*sa_ignore {no recourse on failure} IGNORE_RETURN (4) */
+    vqec_cli_register_command(cli, cmd_monitor_latency_c, "reset",
+                              vqec_cmd_monitor_latency_reset,
+                              PRIVILEGE_PRIVILEGED, VQEC_CLI_MODE_EXEC,
+                              "reset current packet latency data");
+
      /*
       * monitor benchmark
       * Commands to monitor benchmark
@@ -265,6 +265,109 @@ vqec_error_repair_show (struct vqec_cli_def *cli)
                    g_vqec_error_repair_policed_requests);
 }
 
+/*
+ * Number of packets following the PID that are covered by the bitmask
+ * of lost packets (BLP) of one Generic NACK field.
+ */
+#define VQEC_GAP_REPORTER_BLP_BITS 16
+
+/*
+ * State of the Generic NACK encoder: the NACK fields written so far, and
+ * the field (PID / BLP) currently being filled in.
+ */
+typedef struct vqec_gap_reporter_nack_enc_ {
+    rtcp_rtpfb_generic_nack_t *nd;
+    int max_fci_count;
+    int fci_count;
+    uint16_t seq_num_offset;    /* session RTP sequence number offset */
+    boolean pid_set;
+    boolean overflow;           /* more fields needed than max_fci_count */
+    vqec_seq_num_t pid;
+    uint32_t blp;
+} vqec_gap_reporter_nack_enc_t;
+
+/*
+ * vqec_gap_reporter_nack_enc_flush()
+ *
+ * Writes the Generic NACK field being filled in to the buffer.
+ *
+ * Parameters:
+ *  @param[in]:  enc            encoder state
+ *  @return:
+ *    FALSE if the buffer is already full, TRUE otherwise
+ */
+static boolean
+vqec_gap_reporter_nack_enc_flush (vqec_gap_reporter_nack_enc_t *enc)
+{
+    if (!enc->pid_set) {
+        return (TRUE);
+    }
+    if (enc->fci_count >= enc->max_fci_count) {
+        enc->overflow = TRUE;
+        return (FALSE);
+    }
+    enc->nd[enc->fci_count].pid =
+        vqec_seq_num_to_rtp_seq_num(enc->pid) - enc->seq_num_offset;
+    enc->nd[enc->fci_count].bitmask = (uint16_t)enc->blp;
+    enc->fci_count++;
+    enc->pid_set = FALSE;
+    return (TRUE);
+}
+
+/*
+ * vqec_gap_reporter_nack_enc_run()
+ *
+ * Adds a run of consecutive lost packets to the Generic NACK fields.
+ * The run is consumed one 17-packet window (PID and BLP) at a time: the
+ * part of the run that falls within the window of the current field is
+ * set in its BLP with a single mask, and the rest of the run opens new
+ * fields. Runs are normally added in increasing sequence order; a run
+ * which starts before the current PID opens a new field.
+ *
+ * Parameters:
+ *  @param[in]:  enc            encoder state
+ *  @param[in]:  seq            first sequence number of the run
+ *  @param[in]:  len            number of packets in the run
+ */
+static void
+vqec_gap_reporter_nack_enc_run (vqec_gap_reporter_nack_enc_t *enc,
+                                vqec_seq_num_t seq,
+                                uint64_t len)
+{
+    int32_t diff;
+    uint32_t k;
+
+    while (len && !enc->overflow) {
+        if (enc->pid_set) {
+            diff = vqec_seq_num_sub(seq, enc->pid);
+            if (diff >= 0 && diff <= VQEC_GAP_REPORTER_BLP_BITS) {
+                if (!diff) {
+                    /* the PID itself is already requested */
+                    seq = vqec_next_seq_num(seq);
+                    len--;
+                    continue;
+                }
+                k = VQEC_GAP_REPORTER_BLP_BITS + 1 - diff;
+                if (len < k) {
+                    k = len;
+                }
+                enc->blp |= ((1U << k) - 1) << (diff - 1);
+                seq = vqec_seq_num_add(seq, k);
+                len -= k;
+                continue;
+            }
+            if (!vqec_gap_reporter_nack_enc_flush(enc)) {
+                return;
+            }
+        }
+        enc->pid = seq;
+        enc->blp = 0;
+        enc->pid_set = TRUE;
+        seq = vqec_next_seq_num(seq);
+        len--;
+    }
+}
+
 /*
  * vqec_pcm_construct_generic_nack()
  *
@@ -272,6 +375,12 @@ vqec_error_repair_show (struct vqec_cli_def *cli)
  * generic NACK data contents for use in an RTCP feedback message 
  * (see RFC 4585, section 6.1, 6.2).
  *
+ * Gaps are encoded as runs rather than packet by packet, and are policed
+ * with a single draw from the token bucket for each run, so that the
+ * cost of a report does not grow with the number of lost packets.
+ * If the gaps do not fit into max_fci_count fields, none of them are
+ * requested (a "jumbo" gap).
+ *
  * Parameters:
  *  @param[in]:  chan           Channel whose gaps are to be included in
  *                               the FCI field
@@ -293,12 +402,7 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
 {
     boolean more = TRUE;
     int i;
-    vqec_seq_num_t seq;
-
-    int fci_count = 0;          /*
-                                 * How many Generic NACK fields are encoded
-                                 * into the nd buffer?
-                                 */
+    uint64_t run_len, admitted;
     uint32_t repair_count = 0;  /*
                                  * How many repair requests are encoded across
                                  * all generic NACKs (excludes policed repairs)
@@ -306,17 +410,12 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
     uint32_t policed_count = 0; /*
                                  * How many repair requests were policed?
                                  */
-    uint32_t first_pid;
-    boolean first_pid_set = FALSE;
-    uint32_t current_pid = 0, current_blp = 0; 
-    boolean current_pid_set = FALSE;
-    const int blp_max = 16;
-    uint16_t gap_diff = 0;    
-    uint32_t avail_tokens;
+    uint32_t avail_tokens = 0;
     tb_retval_t tb_retval;
     char str[VQEC_LOGMSG_BUFSIZE];
     vqec_dp_error_t err;
     vqec_dp_gap_buffer_t gapbuff;
+    vqec_gap_reporter_nack_enc_t enc;
 
     if (!chan || !nd) {
         return 0;
@@ -331,6 +430,12 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
     }
 
     bzero(nd, sizeof(rtcp_rtpfb_generic_nack_t) * max_fci_count);
+    memset(&enc, 0, sizeof(enc));
+    enc.nd = nd;
+    enc.max_fci_count = max_fci_count;
+    if (chan->prim_session) {
+        enc.seq_num_offset = chan->prim_session->session_rtp_seq_num_offset;
+    }
     
     if (chan->er_policer_enabled) {
         tb_retval = tb_credit_tokens(&chan->er_policer_tb, 
@@ -348,8 +453,9 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
     }
 
     /*
-     * First we need to go through the gap list to figure out how many 
-     * packets we need to send.
+     * Collect the whole gap list from the dataplane, encoding each gap
+     * as it is retrieved.  Once the NACK buffer has overflowed, gaps are
+     * only counted.
      */
     while (more) {
         err = vqec_dp_chan_get_gap_report(chan->dp_chanid, &gapbuff, &more);
@@ -363,65 +469,33 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
         }
 
         for (i = 0; i < gapbuff.num_gaps; i++) {
-            for (seq = gapbuff.gap_list[i].start_seq;
-                 vqec_seq_num_le(seq, 
-                                 vqec_seq_num_add(gapbuff.gap_list[i].start_seq,
-                                                  gapbuff.gap_list[i].extent));
-                 seq = vqec_next_seq_num(seq)) {
-
-                /*
-                 * If error-repair policing is enabled for this stream,
-                 * police the request using the local copy of number of tokens
-                 * available.
-                 */
-                if (chan->er_policer_enabled) {
-                    if (avail_tokens) {
-                        avail_tokens--;
-                    } else {
-                        policed_count++;
-                        continue;
-                    }
-                }
+            run_len = (uint64_t)gapbuff.gap_list[i].extent + 1;
 
-                /*
-                 * Keep track of how many repairs are added to the FCI field 
-                 * (across all generic NACK fields)
-                 */
-                repair_count++;
-
-                /* 
-                 * Check if we have enough space to store the fci
-                 */
-                if (fci_count >= max_fci_count) {
-                    syslog_print(VQEC_ERROR, 
-                                 "Too many gaps, can't be report by one NACK");
-                    break;
+            /*
+             * If error-repair policing is enabled for this stream, the
+             * leading part of the gap for which there are tokens is
+             * requested, and the rest of it is policed.
+             */
+            admitted = run_len;
+            if (chan->er_policer_enabled) {
+                if (admitted > avail_tokens) {
+                    admitted = avail_tokens;
                 }
+                avail_tokens -= admitted;
+                policed_count += run_len - admitted;
+            }
+            if (!admitted) {
+                continue;
+            }
 
-                if (!first_pid_set) {
-                    first_pid_set = TRUE;
-                    first_pid = seq;
-                    current_pid = first_pid;
-                    current_pid_set = TRUE;
-                } else {
-                    if (vqec_seq_num_lt(seq, current_pid) ||
-                        vqec_seq_num_lt(vqec_seq_num_add(current_pid,
-                                                         blp_max), seq)) {
-                        nd[fci_count].pid = 
-                            vqec_seq_num_to_rtp_seq_num(current_pid) -
-                            chan->prim_session->session_rtp_seq_num_offset;
-                        nd[fci_count].bitmask = current_blp;
-                        gap_diff = 0;
-                        fci_count++;
-                        current_pid = seq;
-                        current_blp = 0;
-                    } else {
-                        gap_diff = 
-                            vqec_seq_num_sub(seq, current_pid);
-                        current_blp |= 1 << (gap_diff - 1);
-                    }            
-                }
-            } /* end-of-for(seq) */
+            /*
+             * Keep track of how many repairs are added to the FCI field 
+             * (across all generic NACK fields)
+             */
+            repair_count += admitted;
+            vqec_gap_reporter_nack_enc_run(&enc, 
+                                           gapbuff.gap_list[i].start_seq,
+                                           admitted);
         } /* end-of-for(i) */
     } /* end-of-while */
 
@@ -462,24 +536,23 @@ vqec_gap_reporter_construct_generic_nack (vqec_chan_t *chan,
     }
 
     /* Remember the last fci if we have space */
-    if ((repair_count) && (fci_count < max_fci_count)) {
-        nd[fci_count].pid =
-            vqec_seq_num_to_rtp_seq_num(current_pid) -
-            chan->prim_session->session_rtp_seq_num_offset;
-        nd[fci_count].bitmask = current_blp;
-        fci_count++;
-    } else if (repair_count) {
+    if (!enc.overflow) {
+        (void)vqec_gap_reporter_nack_enc_flush(&enc);
+    }
+    if (enc.overflow) {
+        syslog_print(VQEC_ERROR, 
+                     "Too many gaps, can't be report by one NACK");
         VQEC_DEBUG(VQEC_DEBUG_ERROR_REPAIR, "suppressed jumbo gaps");
         chan->stats.suppressed_jumbo_gap_counter++;
         chan->stats.total_repairs_unrequested += repair_count;
-        fci_count = 0;
+        enc.fci_count = 0;
         repair_count = 0;
     }
 
     if (num_repairs) {
         *num_repairs = repair_count;
     }
-    return fci_count;
+    return enc.fci_count;
 }
 
 /**
@@ -48,6 +48,7 @@
 #include <utils/vam_util.h>
 #include <utils/vam_hist.h>
 #include "vqec_pthread.h"
+#include "vqec_metrics_export.h"
 #include <poll.h>
 
 #ifndef HAVE_STRLFUNCS
@@ -92,6 +93,37 @@ UT_STATIC vqec_ifclient_state_t s_vqec_ifclient_state;
 UT_STATIC vqec_ifclient_tmp_chan_t *s_vqec_ifclient_tmp_chans;
 UT_STATIC boolean s_vqec_ifclient_deliver_paks_to_user;
 
+/*
+ * Stats summaries published for readers, indexed by the double-buffer
+ * index and then by the cumulative flag.  They are refreshed under the 
+ * global lock, and copied by vqec_ifclient_get_stats_summary() without it,
+ * so that monitoring never holds up the event loop.
+ */
+typedef struct vqec_ifclient_stats_pub_
+{
+    vqec_error_t err;           /* Result of building the summary */
+    uint32_t num_chans;
+    uint32_t num_tuners;
+    vqec_ifclient_stats_channel_summary_t 
+        chans[VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS];
+    vqec_ifclient_stats_tuner_summary_t 
+        tuners[VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS];
+} vqec_ifclient_stats_pub_t;
+
+static vqec_ifclient_stats_pub_t s_vqec_ifclient_stats_pub[2][2];
+
+/* Event loop profiles, published along with the stats summaries */
+typedef struct vqec_ifclient_evprof_pub_
+{
+    uint32_t num_events;
+    vqec_event_profile_t events[VQEC_IFCLIENT_EVENT_PROFILE_MAX];
+} vqec_ifclient_evprof_pub_t;
+
+static vqec_ifclient_evprof_pub_t s_vqec_ifclient_evprof_pub[2];
+static vqec_dbuf_t s_vqec_ifclient_stats_dbuf;
+static abs_time_t s_vqec_ifclient_stats_next_publish;
+static abs_time_t s_vqec_ifclient_stats_last_publish;
+
 UT_STATIC vqec_error_t 
 vqec_ifclient_tuner_create_ul(vqec_tunerid_t *id, const char *name);
 UT_STATIC vqec_error_t 
@@ -161,6 +193,31 @@ UT_STATIC vqec_error_t
 vqec_ifclient_get_stats_tuner_legacy_ul(vqec_tunerid_t id,
                                         vqec_ifclient_stats_channel_t *stats);
 UT_STATIC vqec_error_t
+vqec_ifclient_get_stats_channel_latency_ul(
+    const char *url,
+    vqec_ifclient_stats_channel_latency_t *stats);
+UT_STATIC vqec_error_t
+vqec_ifclient_get_stats_summary_ul(
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners,
+    boolean cumulative,
+    boolean refresh);
+UT_STATIC void
+vqec_ifclient_stats_publish_ul(boolean refresh);
+static vqec_error_t
+vqec_ifclient_stats_read_published(
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners,
+    boolean cumulative);
+UT_STATIC vqec_error_t
 vqec_ifclient_histogram_display_ul(const vqec_hist_t hist);
 UT_STATIC vqec_error_t
 vqec_ifclient_histogram_clear_ul(const vqec_hist_t hist);
@@ -1288,6 +1345,49 @@ vqec_ifclient_set_tr135_params_channel (const char *url,
     return (retval);
 }
 
+vqec_error_t
+vqec_ifclient_get_stats_channel_latency (
+    const char *url,
+    vqec_ifclient_stats_channel_latency_t *stats)
+{
+    vqec_error_t retval;
+
+    vqec_lock_lock(vqec_g_lock);
+    retval = vqec_ifclient_get_stats_channel_latency_ul(url, stats);
+    vqec_lock_unlock(vqec_g_lock);        
+
+    return (retval);
+}
+
+vqec_error_t
+vqec_ifclient_get_stats_summary (vqec_ifclient_stats_channel_summary_t *chans,
+                                 uint32_t max_chans,
+                                 uint32_t *num_chans,
+                                 vqec_ifclient_stats_tuner_summary_t *tuners,
+                                 uint32_t max_tuners,
+                                 uint32_t *num_tuners)
+{
+    /* Served from the published summaries, without the global lock */
+    return (vqec_ifclient_stats_read_published(chans, max_chans, num_chans,
+                                               tuners, max_tuners, num_tuners,
+                                               FALSE));
+}
+
+vqec_error_t
+vqec_ifclient_get_stats_summary_cumulative (
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners)
+{
+    /* Served from the published summaries, without the global lock */
+    return (vqec_ifclient_stats_read_published(chans, max_chans, num_chans,
+                                               tuners, max_tuners, num_tuners,
+                                               TRUE));
+}
+
 vqec_error_t
 vqec_ifclient_histogram_display (const vqec_hist_t hist)
 {
@@ -1432,6 +1532,9 @@ vqec_ifclient_tuner_create_ul (vqec_tunerid_t *id, const char *name)
                               __FUNCTION__, vqec_err2str(err));
         break;
     }
+    if (err == VQEC_OK) {
+        vqec_ifclient_stats_publish_ul(TRUE);
+    }
 
     return (err);
 }
@@ -1446,6 +1549,7 @@ vqec_ifclient_tuner_destroy_ul (const vqec_tunerid_t id)
 
     err = vqec_tuner_destroy(id);
     if (err == VQEC_OK) {
+        vqec_ifclient_stats_publish_ul(TRUE);
         if (vqec_info_logging()) {
             snprintf(s_log_str_large, VQEC_LOGMSG_BUFSIZE_LARGE,
                      "%s(id=%d)",
@@ -1608,6 +1712,8 @@ vqec_ifclient_tuner_bind_chan_cfg_internal (
     }
     if (err != VQEC_OK) {
         (void)vqec_chan_put_chanid(chanid_new);
+    } else {
+        vqec_ifclient_stats_publish_ul(TRUE);
     }
     return (err);
 }
@@ -1806,6 +1912,7 @@ vqec_ifclient_tuner_unbind_chan_ul (const vqec_tunerid_t id)
     err = vqec_tuner_unbind_chan(id);
 
     if (err == VQEC_OK) {
+        vqec_ifclient_stats_publish_ul(TRUE);
         if (vqec_info_logging()) {
             snprintf(s_log_str_large, VQEC_LOGMSG_BUFSIZE_LARGE,
                      "%s(id=%d)",
@@ -2337,7 +2444,7 @@ vqec_ifclient_tuner_recvmsg_ul (const vqec_tunerid_t id,
 // Initialize the client library.
 // s_vqec_keepalive_ev is used to keep the event loop from exiting, since
 // if there are no events enQ'ed the loop it exits; keepalive_handler(..)
-// is an empty handler for this event.
+// also republishes the stats summaries every publish interval.
 //----------------------------------------------------------------------------
 
 UT_STATIC void *vqec_cli_thread (void* arg)
@@ -2382,7 +2489,28 @@ UT_STATIC void
 vqec_ifclient_keepalive_handler (const vqec_event_t *const evptr, 
                                  int fd, short event, void *dptr)
 {
-    return;
+    abs_time_t now, idle_publish;
+
+    /* 
+     * Republish the stats summaries once per publish interval, or once
+     * per idle interval if they have not been read since the last publish.
+     */
+    now = get_sys_time();
+    if (TIME_CMP_A(ge, now, s_vqec_ifclient_stats_next_publish)) {
+        idle_publish = 
+            TIME_ADD_A_R(s_vqec_ifclient_stats_last_publish,
+                         TIME_MK_R(msec, 
+                                   VQEC_DP_STATS_PUBLISH_IDLE_INTERVAL_MSECS));
+        if (vqec_dbuf_is_read(&s_vqec_ifclient_stats_dbuf) ||
+            TIME_CMP_A(ge, now, idle_publish)) {
+            vqec_ifclient_stats_publish_ul(FALSE);
+        } else {
+            s_vqec_ifclient_stats_next_publish = 
+                TIME_ADD_A_R(now, 
+                             TIME_MK_R(msec, 
+                                       VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS));
+        }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -2497,6 +2625,7 @@ vqec_ifclient_deinit_do_oper (void)
     vqec_igmp_module_deinit();
 
     vqec_nat_module_deinit();
+    vqec_metrics_export_stop();
     vqec_destroy_cli();    
     vqec_upcall_close_unsocks();
     (void)vqec_dp_deinit_module();
@@ -2513,6 +2642,7 @@ vqec_ifclient_deinit_ul (void)
     if (s_vqec_ifclient_state >= VQEC_IFCLIENT_INITED) {
         vqec_ifclient_deinit_do_oper();
         s_vqec_ifclient_state = VQEC_IFCLIENT_UNINITED;
+        vqec_ifclient_stats_publish_ul(FALSE);
         if (vqec_info_logging()) {
             snprintf(s_log_str_large, VQEC_LOGMSG_BUFSIZE_LARGE,
                      "%s()",
@@ -2901,6 +3031,15 @@ vqec_error_t vqec_ifclient_init_ul (const char *filename)
     }
 
     s_vqec_ifclient_state = VQEC_IFCLIENT_INITED;
+    vqec_ifclient_stats_publish_ul(TRUE);
+
+    if (v_cfg.metrics_export_port &&
+        !vqec_metrics_export_start(v_cfg.metrics_export_port)) {
+        /* Log this error, treat as non-fatal */
+        vqec_ifclient_log_err(VQEC_IFCLIENT_ERR_GENERAL, "%s %s",
+                              __FUNCTION__,
+                              "Metrics exporter failed to start");
+    }
 
     if (vqec_info_logging()) {
         init_duration = TIME_SUB_A_A(get_sys_time(), init_start_time);
@@ -2996,6 +3135,7 @@ vqec_ifclient_clear_stats_ul (void)
     (void)vqec_chan_clear_counters();
     vqec_tuner_clear_stats();
     vqec_updater_clear_counters();
+    vqec_ifclient_stats_publish_ul(TRUE);
 }
 
 UT_STATIC vqec_error_t
@@ -3045,10 +3185,19 @@ done:
     return (err);
 }
 
-UT_STATIC vqec_error_t 
-vqec_ifclient_get_stats_channel_ul (const char *url,
-                                    vqec_ifclient_stats_channel_t *stats,
-                                    boolean cumulative)
+/*
+ * Resolves the URL of a channel given to one of the channel stats APIs
+ * to the ID of the active channel.  URLs which have been resolved before
+ * are found in the channel module's URL index.
+ *
+ * @param[in]  url      URL of the channel
+ * @param[out] chanid   ID of the active channel
+ * @return              VQEC_OK on success, otherwise
+ *                      VQEC_ERR_CHANNELPARSE if the URL cannot be parsed,
+ *                      VQEC_ERR_CHANNOTACTIVE if the channel is not active
+ */
+static vqec_error_t
+vqec_ifclient_url_to_chanid_ul (const char *url, vqec_chanid_t *chanid)
 {
     vqec_protocol_t protocol;
     in_addr_t ip;
@@ -3056,19 +3205,14 @@ vqec_ifclient_get_stats_channel_ul (const char *url,
     struct in_addr ip_addr;
     channel_cfg_t *sdp_cfg = NULL;
     vqec_chan_cfg_t chan_cfg;
-    vqec_chanid_t chanid;
     vqec_chan_err_t err_chan;
-    vqec_error_t err = VQEC_OK;
 
-    if (!url || !stats) {
-        err = VQEC_ERR_INVALIDARGS;
-        goto done;
+    if (vqec_chan_find_chanid_by_url(chanid, url) == VQEC_CHAN_ERR_OK) {
+        return (VQEC_OK);
     }
 
-    memset(stats, 0, sizeof(*stats));
     if (!vqec_url_parse((vqec_url_t)url, &protocol, &ip, &port)) {
-        err = VQEC_ERR_CHANNELPARSE;
-        goto done;
+        return (VQEC_ERR_CHANNELPARSE);
     }
 
     /* 
@@ -3081,26 +3225,46 @@ vqec_ifclient_get_stats_channel_ul (const char *url,
     sdp_cfg = cfg_get_channel_cfg_from_orig_src_addr(ip_addr, port);
     if (sdp_cfg) {
         vqec_chan_convert_sdp_to_cfg(sdp_cfg, VQEC_CHAN_TYPE_LINEAR, &chan_cfg);
-  
-        err_chan = vqec_chan_find_chanid(&chanid, 
+        err_chan = vqec_chan_find_chanid(chanid, 
                                          chan_cfg.primary_dest_addr.s_addr,
                                          chan_cfg.primary_dest_port);
     } else {
-       /*
-        * Signifies a channel that is not in the channel_mgr's channel map
-        * e.g. a VOD channel
-        */
-       err_chan = vqec_chan_find_chanid(&chanid, ip, port);
-
+        /*
+         * Signifies a channel that is not in the channel_mgr's channel map
+         * e.g. a VOD channel
+         */
+        err_chan = vqec_chan_find_chanid(chanid, ip, port);
     }
     switch (err_chan) {
     case VQEC_CHAN_ERR_NOTFOUND:
-        err = VQEC_ERR_CHANNOTACTIVE;
-        goto done;
+        return (VQEC_ERR_CHANNOTACTIVE);
     case VQEC_CHAN_ERR_OK:
         break;
     default:
-        err = VQEC_ERR_INTERNAL;
+        return (VQEC_ERR_INTERNAL);
+    }
+
+    vqec_chan_index_url(*chanid, url);
+    return (VQEC_OK);
+}
+
+UT_STATIC vqec_error_t 
+vqec_ifclient_get_stats_channel_ul (const char *url,
+                                    vqec_ifclient_stats_channel_t *stats,
+                                    boolean cumulative)
+{
+    vqec_chanid_t chanid;
+    vqec_chan_err_t err_chan;
+    vqec_error_t err = VQEC_OK;
+
+    if (!url || !stats) {
+        err = VQEC_ERR_INVALIDARGS;
+        goto done;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    err = vqec_ifclient_url_to_chanid_ul(url, &chanid);
+    if (err != VQEC_OK) {
         goto done;
     }
 
@@ -3129,12 +3293,6 @@ vqec_ifclient_get_stats_channel_tr135_sample_ul (
                     vqec_ifclient_stats_channel_tr135_sample_t *stats)
 {
      
-    vqec_protocol_t protocol;
-    in_addr_t ip;
-    uint16_t port;
-    struct in_addr ip_addr;
-    channel_cfg_t *sdp_cfg = NULL;
-    vqec_chan_cfg_t chan_cfg;
     vqec_chanid_t chanid;
     vqec_chan_err_t err_chan;
     vqec_error_t err = VQEC_OK;
@@ -3145,41 +3303,8 @@ vqec_ifclient_get_stats_channel_tr135_sample_ul (
     }
 
     memset(stats, 0, sizeof(*stats));
-    if (!vqec_url_parse((vqec_url_t)url, &protocol, &ip, &port)) {
-        err = VQEC_ERR_CHANNELPARSE;
-        goto done;
-    }
-
-    /* 
-     * API caller's supplied primary stream address and port are translated 
-     * from (original dest addr, original dest port) to (re-sourced dest addr, 
-     * re-sourced dest port) if such a re-sourced stream is present in the 
-     * channel manager.
-     */
-    ip_addr.s_addr = ip;
-    sdp_cfg = cfg_get_channel_cfg_from_orig_src_addr(ip_addr, port);
-    if (sdp_cfg) {
-        vqec_chan_convert_sdp_to_cfg(sdp_cfg, VQEC_CHAN_TYPE_LINEAR, &chan_cfg);
-  
-        err_chan = vqec_chan_find_chanid(&chanid, 
-                                         chan_cfg.primary_dest_addr.s_addr,
-                                         chan_cfg.primary_dest_port);
-    } else {
-       /*
-        * Signifies a channel that is not in the channel_mgr's channel map
-        * e.g. a VOD channel
-        */
-       err_chan = vqec_chan_find_chanid(&chanid, ip, port);
-
-    }
-    switch (err_chan) {
-    case VQEC_CHAN_ERR_NOTFOUND:
-        err = VQEC_ERR_CHANNOTACTIVE;
-        goto done;
-    case VQEC_CHAN_ERR_OK:
-        break;
-    default:
-        err = VQEC_ERR_INTERNAL;
+    err = vqec_ifclient_url_to_chanid_ul(url, &chanid);
+    if (err != VQEC_OK) {
         goto done;
     }
 
@@ -3204,12 +3329,6 @@ vqec_ifclient_set_tr135_params_channel_ul (const char *url,
                                            vqec_ifclient_tr135_params_t *params)
 {
 
-    vqec_protocol_t protocol;
-    in_addr_t ip;
-    uint16_t port;
-    struct in_addr ip_addr;
-    channel_cfg_t *sdp_cfg = NULL;
-    vqec_chan_cfg_t chan_cfg;
     vqec_chanid_t chanid;
     vqec_chan_err_t err_chan;
     vqec_error_t err = VQEC_OK;
@@ -3219,40 +3338,8 @@ vqec_ifclient_set_tr135_params_channel_ul (const char *url,
         goto done;
     }
 
-    if (!vqec_url_parse((vqec_url_t)url, &protocol, &ip, &port)) {
-        err = VQEC_ERR_CHANNELPARSE;
-        goto done;
-    }
-
-    /*
-     * API caller's supplied primary stream address and port are translated
-     * from (original dest addr, original dest port) to 
-     * (re-sourced dest addr, re-sourced dest port) 
-     * if such a re-sourced stream is present in the channel manager.
-     */
-    ip_addr.s_addr = ip;
-    sdp_cfg = cfg_get_channel_cfg_from_orig_src_addr(ip_addr, port);
-    if (sdp_cfg) {
-        vqec_chan_convert_sdp_to_cfg(sdp_cfg, VQEC_CHAN_TYPE_LINEAR, &chan_cfg);
-        err_chan = vqec_chan_find_chanid(&chanid, 
-                                         chan_cfg.primary_dest_addr.s_addr,
-                                         chan_cfg.primary_dest_port);
-    } else {
-        /* 
-         * Signifies a channel that is not in the channel_mgr's channel map
-         * e.g. a VOD channel
-         */
-        err_chan = vqec_chan_find_chanid(&chanid, ip, port);
-    }
-
-    switch (err_chan) {
-    case VQEC_CHAN_ERR_NOTFOUND:
-        err = VQEC_ERR_CHANNOTACTIVE;
-        goto done;
-    case VQEC_CHAN_ERR_OK:
-        break;
-    default:
-        err = VQEC_ERR_INTERNAL;
+    err = vqec_ifclient_url_to_chanid_ul(url, &chanid);
+    if (err != VQEC_OK) {
         goto done;
     }
 
@@ -3278,6 +3365,322 @@ vqec_ifclient_get_stats_tuner_legacy_ul (vqec_tunerid_t id,
     return (err);
 }
 
+/*
+ * Copy a dataplane latency histogram into its public form.
+ */
+static void
+vqec_ifclient_latency_hist_copy (vqec_ifclient_latency_hist_t *dst,
+                                 vqec_dp_histogram_data_t *src)
+{
+    vam_hist_bucket_t bucket;
+    int i;
+
+    memset(dst, 0, sizeof(*dst));
+    memset(&bucket, 0, sizeof(bucket));
+    for (i = 0; 
+         (i < vam_hist_get_num_buckets((vam_hist_type_t *)src)) &&
+             (i < VQEC_IFCLIENT_LATENCY_HIST_BUCKETS);
+         i++) {
+        vam_hist_get_bucket((vam_hist_type_t *)src, i, &bucket);
+        dst->buckets[i].lower_bound = bucket.lower_bound;
+        dst->buckets[i].upper_bound = bucket.upper_bound;
+        dst->buckets[i].hits = bucket.hits;
+    }
+    dst->num_buckets = i;
+}
+
+UT_STATIC vqec_error_t 
+vqec_ifclient_get_stats_channel_latency_ul (
+    const char *url,
+    vqec_ifclient_stats_channel_latency_t *stats)
+{
+    static const vqec_dp_latency_class_t 
+        dp_class[VQEC_LATENCY_CLASS_MAX] = {
+        VQEC_DP_LATENCY_PRIMARY,
+        VQEC_DP_LATENCY_REPAIR,
+        VQEC_DP_LATENCY_FEC
+    };
+    vqec_ifclient_latency_hist_t *dst[VQEC_DP_LATENCY_STAGE_MAX];
+    vqec_dp_histogram_data_t *hist = NULL;
+    vqec_chanid_t chanid;
+    vqec_error_t err = VQEC_OK;
+    int stage, cls;
+
+    if (!url || !stats) {
+        err = VQEC_ERR_INVALIDARGS;
+        goto done;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    err = vqec_ifclient_url_to_chanid_ul(url, &chanid);
+    if (err != VQEC_OK) {
+        goto done;
+    }
+
+    hist = malloc(sizeof(*hist));
+    if (!hist) {
+        err = VQEC_ERR_MALLOC;
+        goto done;
+    }
+    dst[VQEC_DP_LATENCY_NET_TO_PCM] = stats->net_to_pcm;
+    dst[VQEC_DP_LATENCY_PCM_RESIDENCE] = stats->pcm_residence;
+    dst[VQEC_DP_LATENCY_SINK_RESIDENCE] = stats->sink_residence;
+    for (stage = 0; stage < VQEC_DP_LATENCY_STAGE_MAX; stage++) {
+        for (cls = 0; cls < VQEC_LATENCY_CLASS_MAX; cls++) {
+            if (vqec_chan_get_latency_hist(chanid, stage, dp_class[cls], 
+                                           hist) != VQEC_CHAN_ERR_OK) {
+                err = VQEC_ERR_INTERNAL;
+                goto done;
+            }
+            vqec_ifclient_latency_hist_copy(&dst[stage][cls], hist);
+        }
+    }
+
+done:
+    if (err != VQEC_OK) {
+        vqec_ifclient_log_err(VQEC_IFCLIENT_ERR_GENERAL, "%s %s", 
+                              __FUNCTION__, vqec_err2str(err));
+    }
+    if (hist) {
+        free(hist);
+    }
+    return (err);
+}
+
+/*
+ * Snapshot of the dataplane stats of all channels and tuners; it is only
+ * used under the global lock, and is kept off the stack for its size.
+ */
+static vqec_dp_stats_snapshot_t s_vqec_ifclient_stats_snapshot;
+
+UT_STATIC vqec_error_t 
+vqec_ifclient_get_stats_summary_ul (
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners,
+    boolean cumulative,
+    boolean refresh)
+{
+    vqec_dp_stats_snapshot_t *snapshot = &s_vqec_ifclient_stats_snapshot;
+    vqec_chanid_t chanids[VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS];
+    vqec_dp_tuner_stats_summary_t *dp;
+    vqec_ifclient_stats_tuner_summary_t *t;
+    vqec_chanid_t chanid;
+    const char *name;
+    int32_t chan_index;
+    vqec_error_t err = VQEC_OK;
+    uint32_t i, j;
+
+    if (!num_chans || !num_tuners || 
+        (max_chans && !chans) || (max_tuners && !tuners)) {
+        err = VQEC_ERR_INVALIDARGS;
+        goto done;
+    }
+    *num_chans = 0;
+    *num_tuners = 0;
+
+    /* Every active channel has a dataplane channel */
+    if (max_chans > VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS) {
+        max_chans = VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS;
+    }
+
+    if ((refresh && (vqec_dp_publish_stats() != VQEC_DP_ERR_OK)) ||
+        (vqec_dp_get_stats_snapshot(cumulative, snapshot) 
+         != VQEC_DP_ERR_OK)) {
+        err = VQEC_ERR_INTERNAL;
+        goto done;
+    }
+    if (vqec_chan_get_counters_summary(snapshot, chans, chanids, max_chans,
+                                       num_chans, cumulative) 
+        != VQEC_CHAN_ERR_OK) {
+        err = VQEC_ERR_INTERNAL;
+        goto done;
+    }
+
+    for (i = 0; i < snapshot->num_tuners; i++) {
+        dp = &snapshot->tuners[i];
+        chan_index = -1;
+        if ((vqec_tuner_get_chan(dp->cp_tid, &chanid) == VQEC_OK) &&
+            (chanid != VQEC_CHANID_INVALID)) {
+            for (j = 0; j < *num_chans; j++) {
+                if (chanids[j] == chanid) {
+                    chan_index = j;
+                    chans[j].tuner_queue_drops += dp->qdrops;
+                    break;
+                }
+            }
+        }
+        if (*num_tuners == max_tuners) {
+            continue;
+        }
+
+        t = &tuners[(*num_tuners)++];
+        memset(t, 0, sizeof(*t));
+        t->id = dp->cp_tid;
+        name = vqec_tuner_get_name(dp->cp_tid);
+        if (name) {
+            (void)strlcpy(t->name, name, sizeof(t->name));
+        }
+        t->chan_index = chan_index;
+        t->queue_depth = dp->qdepth;
+        t->queue_drops = dp->qdrops;
+    }
+
+done:
+    if (err != VQEC_OK) {
+        vqec_ifclient_log_err(VQEC_IFCLIENT_ERR_GENERAL, "%s %s", 
+                              __FUNCTION__, vqec_err2str(err));
+    }
+    return (err);
+}
+
+/*
+ * Publish the stats summaries of all channels and tuners.  This is done
+ * from the keepalive event once per publish interval (once per idle
+ * interval while the summaries are not read), and with refresh set
+ * whenever tuners or channels have just changed, so that readers see the 
+ * change at once.
+ */
+UT_STATIC void
+vqec_ifclient_stats_publish_ul (boolean refresh)
+{
+    vqec_ifclient_stats_pub_t *pub;
+    uint32_t idx, i;
+
+    idx = vqec_dbuf_write_idx(&s_vqec_ifclient_stats_dbuf);
+    for (i = 0; i < 2; i++) {
+        pub = &s_vqec_ifclient_stats_pub[idx][i];
+        if (s_vqec_ifclient_state < VQEC_IFCLIENT_INITED) {
+            pub->err = VQEC_ERR_NOTINITIALIZED;
+            pub->num_chans = 0;
+            pub->num_tuners = 0;
+            continue;
+        }
+        /* refresh the dataplane statistics only once */
+        pub->err = vqec_ifclient_get_stats_summary_ul(
+            pub->chans, VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS, &pub->num_chans,
+            pub->tuners, VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS, &pub->num_tuners,
+            (i != 0), (refresh && (i == 0)));
+    }
+    s_vqec_ifclient_evprof_pub[idx].num_events = 
+        (s_vqec_ifclient_state < VQEC_IFCLIENT_INITED) ? 0 :
+        vqec_ifclient_event_profile_get_ul(
+            s_vqec_ifclient_evprof_pub[idx].events,
+            VQEC_IFCLIENT_EVENT_PROFILE_MAX);
+    vqec_dbuf_publish(&s_vqec_ifclient_stats_dbuf);
+
+    s_vqec_ifclient_stats_last_publish = get_sys_time();
+    s_vqec_ifclient_stats_next_publish = 
+        TIME_ADD_A_R(s_vqec_ifclient_stats_last_publish, 
+                     TIME_MK_R(msec, VQEC_DP_STATS_PUBLISH_INTERVAL_MSECS));
+}
+
+/*
+ * Copy the published stats summaries.  The global lock is not taken:  the
+ * copy is retried if a publish completes while it is being made.
+ */
+static vqec_error_t
+vqec_ifclient_stats_read_published (
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners,
+    boolean cumulative)
+{
+    const vqec_ifclient_stats_pub_t *pub;
+    vqec_error_t err;
+    uint32_t version, i;
+
+    if (!num_chans || !num_tuners || 
+        (max_chans && !chans) || (max_tuners && !tuners)) {
+        return (VQEC_ERR_INVALIDARGS);
+    }
+
+    do {
+        version = vqec_dbuf_read_begin(&s_vqec_ifclient_stats_dbuf);
+        pub = &s_vqec_ifclient_stats_pub[version & 1][cumulative ? 1 : 0];
+        err = version ? pub->err : VQEC_ERR_NOTINITIALIZED;
+        *num_chans = 0;
+        *num_tuners = 0;
+        if (err != VQEC_OK) {
+            continue;
+        }
+        *num_chans = (pub->num_chans < max_chans) ? 
+            pub->num_chans : max_chans;
+        *num_tuners = (pub->num_tuners < max_tuners) ? 
+            pub->num_tuners : max_tuners;
+        if (*num_chans) {
+            memcpy(chans, pub->chans, *num_chans * sizeof(*chans));
+        }
+        if (*num_tuners) {
+            memcpy(tuners, pub->tuners, *num_tuners * sizeof(*tuners));
+        }
+    } while (vqec_dbuf_read_retry(&s_vqec_ifclient_stats_dbuf, version));
+
+    /* Tuners bound to channels that did not fit are reported as unbound */
+    for (i = 0; i < *num_tuners; i++) {
+        if (tuners[i].chan_index >= (int32_t)*num_chans) {
+            tuners[i].chan_index = -1;
+        }
+    }
+    return (err);
+}
+
+/*
+ * Collect the profiles of the control-plane event loop, and those of the
+ * dataplane event loop, which are only kept by the kernel dataplane.  The
+ * dataplane profiles are fetched into a static buffer, which the global
+ * lock protects.
+ */
+uint32_t
+vqec_ifclient_event_profile_get_ul (vqec_event_profile_t *prof, uint32_t max)
+{
+    static vqec_dp_event_profile_t dp_prof;
+    uint32_t num, i;
+
+    if (!prof) {
+        return (0);
+    }
+    num = vqec_event_get_profile(prof, max);
+
+    if (vqec_dp_get_event_profile(&dp_prof) == VQEC_DP_ERR_OK) {
+        for (i = 0; (i < dp_prof.num_events) && (num < max); i++) {
+            prof[num++] = dp_prof.events[i];
+        }
+    }
+    return (num);
+}
+
+uint32_t
+vqec_ifclient_event_profile_read_published (vqec_event_profile_t *prof,
+                                            uint32_t max)
+{
+    const vqec_ifclient_evprof_pub_t *pub;
+    uint32_t version, num;
+
+    if (!prof) {
+        return (0);
+    }
+    do {
+        version = vqec_dbuf_read_begin(&s_vqec_ifclient_stats_dbuf);
+        pub = &s_vqec_ifclient_evprof_pub[version & 1];
+        num = version ? pub->num_events : 0;
+        if (num > max) {
+            num = max;
+        }
+        if (num) {
+            memcpy(prof, pub->events, num * sizeof(*prof));
+        }
+    } while (vqec_dbuf_read_retry(&s_vqec_ifclient_stats_dbuf, version));
+
+    return (num);
+}
+
 UT_STATIC vqec_error_t
 vqec_ifclient_histogram_display_ul (const vqec_hist_t hist)
 {
@@ -3321,6 +3724,10 @@ vqec_ifclient_histogram_display_ul (const vqec_hist_t hist)
             goto done;
         }
         break;
+    /* Per-channel histograms:  displayed by the channel module */
+    case VQEC_HIST_LATENCY:
+        vqec_chan_display_latency_hist();
+        goto done;
     /* Unrecognized histograms */
     default:
         err = VQEC_ERR_INVALIDARGS;
@@ -3369,6 +3776,13 @@ vqec_ifclient_histogram_clear_ul (const vqec_hist_t hist)
             goto done;
         }
         break;
+    case VQEC_HIST_LATENCY:
+        if ((vqec_dp_chan_latency_hist_clear() != VQEC_DP_ERR_OK) ||
+            (vqec_dp_output_shim_latency_hist_clear() != VQEC_DP_ERR_OK)) {
+            err = VQEC_ERR_INTERNAL;
+            goto done;
+        }
+        break;
     /* Unrecognized histograms */
     default:
         err = VQEC_ERR_INVALIDARGS;
@@ -3436,6 +3850,7 @@ vqec_ifclient_cfg_channel_lineup_set (sdp_block_t *sdp_block)
                 if (cfg_commit_update() != CFG_SUCCESS) {
                     err = VQEC_ERR_NOCHANNELLINEUP;
                 }
+                vqec_chan_flush_url_index();
                 vqec_lock_unlock(vqec_g_lock);
             }
             else {
@@ -3515,8 +3930,9 @@ vqec_ifclient_config_update_ul (
         
         if (cfg_commit_update() != CFG_SUCCESS) {
             status = VQEC_ERR_UPDATE_FAILED_EXISTING_REMOVED;
-            goto done;
         }
+        /* URLs are resolved through the lineup which has been replaced */
+        vqec_chan_flush_url_index();
         break;
 
     default:
@@ -756,6 +756,82 @@ vqec_error_t
 vqec_ifclient_get_stats_channel_cumulative(const char *url,
 				          vqec_ifclient_stats_channel_t *stats);
 
+/**---------------------------------------------------------------------------
+ * Retrieves the packet latency histograms of an active channel: the time
+ * spent by packets from their receipt to their insertion in the jitter
+ * buffer, in the jitter buffer, and in the output queues of the tuners,
+ * for primary, repair and FEC-recovered packets.  The histograms are
+ * cleared with vqec_ifclient_histogram_clear(VQEC_HIST_LATENCY).
+ *
+ * @param[in]  url          - URL specifying the channel of interest.
+ *                            (See vqec_ifclient_get_stats_channel().)
+ * @param[out] stats        - Latency histograms of the channel
+ * @param[out] vqec_error_t - Returns VQEC_OK on success. On failure, the 
+ *                             following error codes may be returned:
+ *                             <I>VQEC_ERR_INVALIDARGS</I><BR>
+ *                             <I>VQEC_ERR_CHANNELPARSE</I><BR>
+ *                             <I>VQEC_ERR_CHANNOTACTIVE</I><BR>
+ *---------------------------------------------------------------------------- 
+ */
+VQEC_PUBLIC VQEC_SYNCHRONIZED
+vqec_error_t 
+vqec_ifclient_get_stats_channel_latency(
+    const char *url,
+    vqec_ifclient_stats_channel_latency_t *stats);
+
+/**---------------------------------------------------------------------------
+ * Retrieves compact stats for all active channels and for all tuners in a
+ * single call.  The stats are gathered from the dataplane at once, which
+ * is far cheaper than polling channels one by one with
+ * vqec_ifclient_get_stats_channel() when monitoring every channel.
+ *
+ * The stats are copied from a summary that VQE-C publishes periodically
+ * (every 100 milliseconds while it is being read, every second otherwise,
+ * and whenever tuners are created, bound, unbound or destroyed, or stats
+ * are cleared), so this call does not take the VQE-C global lock and never
+ * delays packet processing.  The first call after a pause in polling may
+ * thus return stats up to about two seconds old.
+ *
+ * The channel stats accumulate as for vqec_ifclient_get_stats_channel().
+ *
+ * @param[out] chans        - Array filled with the stats of active channels
+ * @param[in]  max_chans    - Number of entries in the chans array
+ * @param[out] num_chans    - Number of channel entries filled
+ * @param[out] tuners       - Array filled with the stats of tuners
+ *                            (may be NULL if max_tuners is 0)
+ * @param[in]  max_tuners   - Number of entries in the tuners array
+ * @param[out] num_tuners   - Number of tuner entries filled
+ * @param[out] vqec_error_t - Returns VQEC_OK on success. On failure, the 
+ *                             following error codes may be returned:
+ *                             <I>VQEC_ERR_INVALIDARGS</I><BR>
+ *                             <I>VQEC_ERR_NOTINITIALIZED</I><BR>
+ *                             <I>VQEC_ERR_INTERNAL</I><BR>
+ *---------------------------------------------------------------------------- 
+ */
+VQEC_PUBLIC
+vqec_error_t
+vqec_ifclient_get_stats_summary(vqec_ifclient_stats_channel_summary_t *chans,
+                                uint32_t max_chans,
+                                uint32_t *num_chans,
+                                vqec_ifclient_stats_tuner_summary_t *tuners,
+                                uint32_t max_tuners,
+                                uint32_t *num_tuners);
+
+/**---------------------------------------------------------------------------
+ * This is a cumulative version of the vqec_ifclient_get_stats_summary API.
+ * For more details refer to vqec_ifclient_get_stats_summary API.
+ *---------------------------------------------------------------------------- 
+ */
+VQEC_PUBLIC
+vqec_error_t
+vqec_ifclient_get_stats_summary_cumulative(
+    vqec_ifclient_stats_channel_summary_t *chans,
+    uint32_t max_chans,
+    uint32_t *num_chans,
+    vqec_ifclient_stats_tuner_summary_t *tuners,
+    uint32_t max_tuners,
+    uint32_t *num_tuners);
+
 /**---------------------------------------------------------------------------
  * Display a histogram maintained internally by VQE-C (primarily used for
  * monitoring or troubleshooting).  The display is either to the CLI 
@@ -58,12 +58,18 @@ extern "C" {
  * VQEC_HIST_OUTPUTSCHED:
  * Delay intervals between instances of output interval scheduling. 
  *
+ * VQEC_HIST_LATENCY:
+ * Per-channel packet latencies from the network to the PCM, within
+ * the PCM, and within the tuner output queues, for primary, repair
+ * and FEC-recovered packets.
+ *
  * VQEC_HIST_MAX:
  * Unused, must be last.
  */
 typedef enum vqec_hist_t_ {
     VQEC_HIST_JOIN_DELAY = 0,
     VQEC_HIST_OUTPUTSCHED,
+    VQEC_HIST_LATENCY,
     VQEC_HIST_MAX
 } vqec_hist_t;
 
@@ -403,6 +409,54 @@ struct vqec_ifclient_stats_channel_
     uint32_t tr135_severe_loss_min_distance;
 } vqec_ifclient_stats_channel_t;
 
+//----------------------------------------------------------------------------
+// Per-channel packet latency histograms
+//----------------------------------------------------------------------------
+#define VQEC_IFCLIENT_LATENCY_HIST_BUCKETS 25
+
+/*
+ * Classes of packets with separate latency histograms.
+ */
+typedef enum vqec_latency_class_t_ {
+    VQEC_LATENCY_PRIMARY = 0,
+    VQEC_LATENCY_REPAIR,            /*!< retransmitted packets */
+    VQEC_LATENCY_FEC,               /*!< packets recovered by FEC */
+    VQEC_LATENCY_CLASS_MAX
+} vqec_latency_class_t;
+
+typedef
+struct vqec_ifclient_latency_hist_
+{
+    uint32_t num_buckets;                   /*!< buckets in use */
+    struct {
+        int32_t lower_bound;                /*!< usec, inclusive */
+        int32_t upper_bound;                /*!< usec, inclusive */
+        uint32_t hits;                      /*!< packets in range */
+    } buckets[VQEC_IFCLIENT_LATENCY_HIST_BUCKETS];
+} vqec_ifclient_latency_hist_t;
+
+typedef
+struct vqec_ifclient_stats_channel_latency_
+{
+    vqec_ifclient_latency_hist_t net_to_pcm[VQEC_LATENCY_CLASS_MAX];
+                            /*!< 
+                             * From the receipt of a packet to its insertion
+                             * in the PCM; FEC-recovered packets are not
+                             * received and are not counted.
+                             */
+    vqec_ifclient_latency_hist_t pcm_residence[VQEC_LATENCY_CLASS_MAX];
+                            /*!<
+                             * From the insertion of a packet in the PCM to
+                             * its output to the tuners.
+                             */
+    vqec_ifclient_latency_hist_t sink_residence[VQEC_LATENCY_CLASS_MAX];
+                            /*!<
+                             * From the output of a packet to a tuner to its
+                             * read from the tuner, summed over the tuners
+                             * bound to the channel.
+                             */
+} vqec_ifclient_stats_channel_latency_t;
+
 /*----------------------------------------------------------------------------
  * Statistics on updates.
  *--------------------------------------------------------------------------*/
@@ -698,6 +752,52 @@ extern int32_t g_vqec_client_mode;
 typedef struct in_addr vqec_in_addr_t; /* network byte order */
 typedef in_port_t vqec_in_port_t;      /* network byte order */
 
+//----------------------------------------------------------------------------
+// Compact statistics of all active channels and tuners
+//----------------------------------------------------------------------------
+typedef
+struct vqec_ifclient_stats_channel_summary_
+{
+    vqec_in_addr_t primary_dest_addr;       /*!< identifies the channel */
+    vqec_in_port_t primary_dest_port;       /*!< (network byte order) */
+    uint16_t num_tuners;                    /*!< tuners bound to channel */
+
+    /*
+     * The counters below have the same meaning as the counters of the
+     * same name in vqec_ifclient_stats_channel_t.
+     */
+    uint64_t primary_udp_inputs;
+    uint64_t primary_rtp_inputs;
+    uint64_t primary_rtp_drops;
+    uint64_t primary_rtp_expected;
+    int64_t  primary_rtp_lost;
+    uint64_t repair_rtp_inputs;
+    uint64_t repair_rtp_drops;
+    uint64_t repairs_requested;
+    uint64_t repairs_policed;
+    uint64_t fec_inputs;
+    uint64_t fec_recovered_paks;
+    uint64_t pre_repair_losses;
+    uint64_t post_repair_losses;
+    uint64_t post_repair_outputs;
+    uint64_t underruns;
+    uint64_t tuner_queue_drops;             /*!< summed over bound tuners */
+} vqec_ifclient_stats_channel_summary_t;
+
+typedef
+struct vqec_ifclient_stats_tuner_summary_
+{
+    vqec_tunerid_t id;
+    char name[VQEC_MAX_TUNER_NAMESTR_LEN];
+    int32_t chan_index;                     /*!<
+                                             * index of the tuner's channel
+                                             * in the channel summaries, or
+                                             * -1 if the tuner is not bound
+                                             */
+    uint32_t queue_depth;                   /*!< packets queued for output */
+    uint64_t queue_drops;                   /*!< packets dropped from queue */
+} vqec_ifclient_stats_tuner_summary_t;
+
 /*----------------------------------------------------------------------------
  * VQE-C Channel Configuration Structure 
  *--------------------------------------------------------------------------*/
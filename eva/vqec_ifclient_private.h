@@ -9,6 +9,8 @@
 #ifndef __VQEC_IFCLIENT_PRIVATE_H__
 #define __VQEC_IFCLIENT_PRIVATE_H__
 
+#include "vqec_event.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
@@ -62,6 +64,35 @@ vqec_error_t
 vqec_ifclient_config_register_ul(
     const vqec_ifclient_config_register_params_t *params);
 
+/*
+ * Event loop profiles:  those of the control-plane event loop, followed by
+ * those of the dataplane event loop when the dataplane runs its own loop.
+ */
+#define VQEC_IFCLIENT_EVENT_PROFILE_MAX \
+    (VQEC_EVENT_PROFILE_MAX + VQEC_DP_EVENT_PROFILE_MAX)
+
+/*
+ * Collect the event loop profiles; the global lock must be held.
+ *
+ * @param[out] prof Array into which the profiles are copied.
+ * @param[in] max Number of entries in the array.
+ * @param[out] uint32_t Returns the number of entries copied.
+ */
+uint32_t
+vqec_ifclient_event_profile_get_ul(vqec_event_profile_t *prof, uint32_t max);
+
+/*
+ * Copy the event loop profiles as last published with the statistics
+ * summaries, without taking the global lock.
+ *
+ * @param[out] prof Array into which the profiles are copied.
+ * @param[in] max Number of entries in the array.
+ * @param[out] uint32_t Returns the number of entries copied.
+ */
+uint32_t
+vqec_ifclient_event_profile_read_published(vqec_event_profile_t *prof,
+                                           uint32_t max);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,553 @@
+/*------------------------------------------------------------------
+ *
+ * VQE-C metrics exporter.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <utils/vam_hist.h>
+#include <utils/vam_time.h>
+#include "vqec_metrics_export.h"
+#include "vqec_ifclient.h"
+#include "vqec_dp_api.h"
+#include "vqec_event.h"
+#include "vqec_ifclient_private.h"
+#include "vqec_pthread.h"
+#include "vqec_syslog_def.h"
+
+/* Size of the buffer into which the metrics are rendered */
+#define VQEC_METRICS_EXPORT_BUFLEN (128 * 1024)
+/* Time allowed for a client to send its request after connecting */
+#define VQEC_METRICS_EXPORT_RCVTIMEO_USECS (200 * 1000)
+/*
+ * Time allowed for a client to read the response:  each send() is bounded
+ * by the socket send timeout, and the whole response by the deadline, so
+ * that a client that stops reading cannot hold the exporter thread (and
+ * vqec_metrics_export_stop()) for longer.
+ */
+#define VQEC_METRICS_EXPORT_SNDTIMEO_USECS (500 * 1000)
+#define VQEC_METRICS_EXPORT_SEND_DEADLINE SECS(1)
+#define VQEC_METRICS_EXPORT_BACKLOG 4
+
+#define VQEC_METRICS_EXPORT_HTTP_HDR                            \
+    "HTTP/1.0 200 OK\r\n"                                       \
+    "Content-Type: text/plain; version=0.0.4\r\n"               \
+    "Connection: close\r\n\r\n"
+#define VQEC_METRICS_EXPORT_HTTP_405                            \
+    "HTTP/1.0 405 Method Not Allowed\r\n"                       \
+    "Allow: GET\r\n"                                            \
+    "Content-Length: 0\r\n"                                     \
+    "Connection: close\r\n\r\n"
+
+/*
+ * Exporter state.  Start and stop are called by the control plane with the
+ * global lock held, so the state itself needs no lock of its own.
+ */
+static int s_vqec_metrics_export_sock = -1;
+static boolean s_vqec_metrics_export_running;
+static pthread_t s_vqec_metrics_export_tid;
+
+/* Rendering buffers, used only by the exporter thread */
+static char s_vqec_metrics_export_buf[VQEC_METRICS_EXPORT_BUFLEN];
+static vqec_ifclient_stats_channel_summary_t
+    s_vqec_metrics_export_chans[VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS];
+static vqec_ifclient_stats_tuner_summary_t
+    s_vqec_metrics_export_tuners[VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS];
+static vqec_event_profile_t
+    s_vqec_metrics_export_events[VQEC_IFCLIENT_EVENT_PROFILE_MAX];
+
+/*
+ * Bounded text writer.  Output beyond the end of the buffer is dropped,
+ * but still accounted for in "used" so that truncation can be detected.
+ */
+typedef struct vqec_metrics_export_writer_
+{
+    char *buf;
+    int32_t len;
+    int32_t used;
+} vqec_metrics_export_writer_t;
+
+static void
+vqec_metrics_export_printf (vqec_metrics_export_writer_t *w,
+                            const char *fmt, ...)
+    __attribute__ ((format (printf, 2, 3)));
+
+static void
+vqec_metrics_export_printf (vqec_metrics_export_writer_t *w,
+                            const char *fmt, ...)
+{
+    va_list ap;
+    int32_t avail, n;
+
+    avail = (w->used < w->len) ? (w->len - w->used) : 0;
+    va_start(ap, fmt);
+    n = vsnprintf(avail ? w->buf + w->used : NULL, avail, fmt, ap);
+    va_end(ap);
+    if (n > 0) {
+        w->used += n;
+    }
+}
+
+static void
+vqec_metrics_export_header (vqec_metrics_export_writer_t *w,
+                            const char *name,
+                            const char *help,
+                            const char *type)
+{
+    vqec_metrics_export_printf(w, "# HELP %s %s\n# TYPE %s %s\n",
+                               name, help, name, type);
+}
+
+/*
+ * Dataplane global counters, named after the TLM counter declarations.
+ */
+static void
+vqec_metrics_export_global (vqec_metrics_export_writer_t *w)
+{
+    vqec_dp_global_debug_stats_t stats;
+
+    if (vqec_dp_get_global_counters(&stats) != VQEC_DP_ERR_OK) {
+        return;
+    }
+
+#define VQEC_DP_TLM_CNT_DECL(name,desc)                                 \
+    vqec_metrics_export_header(w, "vqec_dp_" #name, desc, "counter");   \
+    vqec_metrics_export_printf(w, "vqec_dp_" #name " %u\n", stats.name);
+#include "vqec_dp_tlm_cnt_decl.h"
+#undef VQEC_DP_TLM_CNT_DECL
+}
+
+/*
+ * Channel counters, exported from the cumulative stats summary.
+ */
+static const struct {
+    const char *name;
+    const char *help;
+    size_t offset;
+} s_vqec_metrics_export_chan_cnts[] = {
+#define VQEC_METRICS_EXPORT_CHAN_CNT(field, help)                       \
+    { "vqec_channel_" #field, help,                                     \
+      offsetof(vqec_ifclient_stats_channel_summary_t, field) }
+    VQEC_METRICS_EXPORT_CHAN_CNT(primary_udp_inputs,
+                                 "Primary stream UDP packets received"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(primary_rtp_inputs,
+                                 "Primary stream RTP packets received"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(primary_rtp_drops,
+                                 "Primary stream RTP packets dropped"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(primary_rtp_expected,
+                                 "Primary stream RTP packets expected"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(repair_rtp_inputs,
+                                 "Repair stream RTP packets received"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(repair_rtp_drops,
+                                 "Repair stream RTP packets dropped"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(repairs_requested,
+                                 "Packets requested for repair"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(repairs_policed,
+                                 "Repair requests suppressed by policing"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(fec_inputs,
+                                 "FEC packets received"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(fec_recovered_paks,
+                                 "Packets recovered by FEC"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(pre_repair_losses,
+                                 "Packets lost before error repair"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(post_repair_losses,
+                                 "Packets lost after error repair"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(post_repair_outputs,
+                                 "Packets output after error repair"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(underruns,
+                                 "Output underruns"),
+    VQEC_METRICS_EXPORT_CHAN_CNT(tuner_queue_drops,
+                                 "Packets dropped from bound tuner queues"),
+#undef VQEC_METRICS_EXPORT_CHAN_CNT
+};
+
+static void
+vqec_metrics_export_chan_label (const vqec_ifclient_stats_channel_summary_t
+                                *chan,
+                                char *buf,
+                                int32_t len)
+{
+    char addr[INET_ADDRSTRLEN];
+
+    if (!inet_ntop(AF_INET, &chan->primary_dest_addr, addr, sizeof(addr))) {
+        addr[0] = '\0';
+    }
+    snprintf(buf, len, "channel=\"%s:%u\"",
+             addr, ntohs(chan->primary_dest_port));
+}
+
+static void
+vqec_metrics_export_chans_tuners (vqec_metrics_export_writer_t *w)
+{
+    vqec_ifclient_stats_channel_summary_t *chans =
+        s_vqec_metrics_export_chans;
+    vqec_ifclient_stats_tuner_summary_t *tuners =
+        s_vqec_metrics_export_tuners;
+    uint32_t num_chans, num_tuners, i, j;
+    char label[INET_ADDRSTRLEN + 32];
+
+    if (vqec_ifclient_get_stats_summary_cumulative(
+            chans, VQEC_DP_STATS_SNAPSHOT_MAX_CHANNELS, &num_chans,
+            tuners, VQEC_DP_STATS_SNAPSHOT_MAX_TUNERS, &num_tuners) !=
+        VQEC_OK) {
+        return;
+    }
+
+    vqec_metrics_export_header(w, "vqec_channel_tuners",
+                               "Tuners bound to the channel", "gauge");
+    for (j = 0; j < num_chans; j++) {
+        vqec_metrics_export_chan_label(&chans[j], label, sizeof(label));
+        vqec_metrics_export_printf(w, "vqec_channel_tuners{%s} %u\n",
+                                   label, chans[j].num_tuners);
+    }
+    for (i = 0;
+         i < sizeof(s_vqec_metrics_export_chan_cnts) /
+             sizeof(s_vqec_metrics_export_chan_cnts[0]);
+         i++) {
+        vqec_metrics_export_header(w,
+                                   s_vqec_metrics_export_chan_cnts[i].name,
+                                   s_vqec_metrics_export_chan_cnts[i].help,
+                                   "counter");
+        for (j = 0; j < num_chans; j++) {
+            vqec_metrics_export_chan_label(&chans[j], label, sizeof(label));
+            vqec_metrics_export_printf(
+                w, "%s{%s} %" PRIu64 "\n",
+                s_vqec_metrics_export_chan_cnts[i].name, label,
+                *(uint64_t *)((char *)&chans[j] +
+                              s_vqec_metrics_export_chan_cnts[i].offset));
+        }
+    }
+    /* signed, as duplicates can make it negative */
+    vqec_metrics_export_header(w, "vqec_channel_primary_rtp_lost",
+                               "Primary stream RTP packets lost", "gauge");
+    for (j = 0; j < num_chans; j++) {
+        vqec_metrics_export_chan_label(&chans[j], label, sizeof(label));
+        vqec_metrics_export_printf(w,
+                                   "vqec_channel_primary_rtp_lost{%s} %"
+                                   PRId64 "\n",
+                                   label, chans[j].primary_rtp_lost);
+    }
+
+    vqec_metrics_export_header(w, "vqec_tuner_queue_depth",
+                               "Packets queued for output", "gauge");
+    for (j = 0; j < num_tuners; j++) {
+        vqec_metrics_export_printf(w,
+                                   "vqec_tuner_queue_depth"
+                                   "{tuner=\"%s\",id=\"%d\"} %u\n",
+                                   tuners[j].name, tuners[j].id,
+                                   tuners[j].queue_depth);
+    }
+    vqec_metrics_export_header(w, "vqec_tuner_queue_drops",
+                               "Packets dropped from the output queue",
+                               "counter");
+    for (j = 0; j < num_tuners; j++) {
+        vqec_metrics_export_printf(w,
+                                   "vqec_tuner_queue_drops"
+                                   "{tuner=\"%s\",id=\"%d\"} %" PRIu64 "\n",
+                                   tuners[j].name, tuners[j].id,
+                                   tuners[j].queue_drops);
+    }
+}
+
+/*
+ * Event loop handler profiles, labelled by handler name.
+ */
+static const struct {
+    const char *name;
+    const char *help;
+    const char *type;
+    size_t offset;
+    boolean is_64bit;
+} s_vqec_metrics_export_event_cnts[] = {
+#define VQEC_METRICS_EXPORT_EVENT_CNT(name, field, help, type)          \
+    { "vqec_event_" name, help, type,                                   \
+      offsetof(vqec_event_profile_t, field),                            \
+      (sizeof(((vqec_event_profile_t *)0)->field) == sizeof(uint64_t)) }
+    VQEC_METRICS_EXPORT_EVENT_CNT("runs", runs,
+                                  "Event handler runs", "counter"),
+    VQEC_METRICS_EXPORT_EVENT_CNT("exec_usecs", total_usecs,
+                                  "Event handler execution time (usec)",
+                                  "counter"),
+    VQEC_METRICS_EXPORT_EVENT_CNT("exec_usecs_max", max_usecs,
+                                  "Longest event handler run (usec)",
+                                  "gauge"),
+    VQEC_METRICS_EXPORT_EVENT_CNT("timer_runs", timer_runs,
+                                  "Event handler runs on timer expiration",
+                                  "counter"),
+    VQEC_METRICS_EXPORT_EVENT_CNT("late_usecs", total_late_usecs,
+                                  "Time from timer expiration to handler "
+                                  "run (usec)", "counter"),
+    VQEC_METRICS_EXPORT_EVENT_CNT("late_usecs_max", max_late_usecs,
+                                  "Latest event handler run after timer "
+                                  "expiration (usec)", "gauge"),
+#undef VQEC_METRICS_EXPORT_EVENT_CNT
+};
+
+static void
+vqec_metrics_export_events (vqec_metrics_export_writer_t *w)
+{
+    vqec_event_profile_t *events = s_vqec_metrics_export_events;
+    uint32_t num, i, j;
+    const char *p;
+    uint64_t val;
+
+    num = vqec_ifclient_event_profile_read_published(
+        events, VQEC_IFCLIENT_EVENT_PROFILE_MAX);
+    for (i = 0;
+         i < sizeof(s_vqec_metrics_export_event_cnts) /
+             sizeof(s_vqec_metrics_export_event_cnts[0]);
+         i++) {
+        vqec_metrics_export_header(w,
+                                   s_vqec_metrics_export_event_cnts[i].name,
+                                   s_vqec_metrics_export_event_cnts[i].help,
+                                   s_vqec_metrics_export_event_cnts[i].type);
+        for (j = 0; j < num; j++) {
+            p = (const char *)&events[j] + 
+                s_vqec_metrics_export_event_cnts[i].offset;
+            val = s_vqec_metrics_export_event_cnts[i].is_64bit ?
+                *(const uint64_t *)p : *(const uint32_t *)p;
+            vqec_metrics_export_printf(
+                w, "%s{handler=\"%s\"} %" PRIu64 "\n",
+                s_vqec_metrics_export_event_cnts[i].name,
+                events[j].name, val);
+        }
+    }
+}
+
+/*
+ * Dataplane histograms, with cumulative buckets labelled by their
+ * (inclusive) upper bounds.
+ */
+static void
+vqec_metrics_export_hist (vqec_metrics_export_writer_t *w,
+                          vqec_dp_published_hist_t which,
+                          const char *name,
+                          const char *help)
+{
+    vqec_dp_histogram_data_t hist;
+    uint64_t count = 0;
+    int32_t i;
+
+    if ((vqec_dp_get_published_hist(which, &hist) != VQEC_DP_ERR_OK) ||
+        (hist.num_buckets <= 0)) {
+        return;
+    }
+    if (hist.num_buckets > VQEC_DP_HIST_MAX_BUCKETS) {
+        hist.num_buckets = VQEC_DP_HIST_MAX_BUCKETS;
+    }
+
+    vqec_metrics_export_header(w, name, help, "histogram");
+    for (i = 0; i < hist.num_buckets; i++) {
+        count += hist.buckets[i].hits;
+        if ((i == hist.num_buckets - 1) ||
+            (hist.buckets[i].upper_bound == INT32_MAX)) {
+            vqec_metrics_export_printf(w, "%s_bucket{le=\"+Inf\"} %" PRIu64
+                                       "\n", name, count);
+        } else {
+            vqec_metrics_export_printf(w, "%s_bucket{le=\"%d\"} %" PRIu64
+                                       "\n", name,
+                                       hist.buckets[i].upper_bound, count);
+        }
+    }
+    vqec_metrics_export_printf(w, "%s_count %" PRIu64 "\n", name, count);
+}
+
+int32_t
+vqec_metrics_export_render (char *buf, int32_t len)
+{
+    vqec_metrics_export_writer_t w;
+
+    if (!buf || (len <= 0)) {
+        return (-1);
+    }
+    w.buf = buf;
+    w.len = len;
+    w.used = 0;
+    buf[0] = '\0';
+
+    vqec_metrics_export_global(&w);
+    vqec_metrics_export_chans_tuners(&w);
+    vqec_metrics_export_hist(&w, VQEC_DP_PUBLISHED_HIST_JOIN_DELAY,
+                             "vqec_join_delay_msec",
+                             "Channel join delay (msec)");
+    vqec_metrics_export_hist(&w, VQEC_DP_PUBLISHED_HIST_OUTPUTSCHED,
+                             "vqec_output_sched_msec",
+                             "Output scheduling interval (msec)");
+    vqec_metrics_export_hist(&w, VQEC_DP_PUBLISHED_HIST_READER_JITTER,
+                             "vqec_reader_jitter_msec",
+                             "Output reader jitter (msec)");
+    vqec_metrics_export_events(&w);
+
+    return (w.used);
+}
+
+/*
+ * Send a buffer, giving up on a send error or timeout, or once the
+ * deadline has passed.
+ */
+static boolean
+vqec_metrics_export_send (int fd, 
+                          const char *buf, 
+                          int32_t len,
+                          abs_time_t deadline)
+{
+    ssize_t n;
+
+    while (len > 0) {
+        if (TIME_CMP_A(ge, get_sys_time(), deadline)) {
+            return (FALSE);
+        }
+        n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (FALSE);
+        }
+        buf += n;
+        len -= n;
+    }
+    return (TRUE);
+}
+
+static void
+vqec_metrics_export_serve (int fd)
+{
+    struct timeval tv;
+    abs_time_t deadline;
+    char req[512];
+    ssize_t n;
+    int32_t len;
+
+    tv.tv_sec = 0;
+    tv.tv_usec = VQEC_METRICS_EXPORT_RCVTIMEO_USECS;
+    (void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    tv.tv_usec = VQEC_METRICS_EXPORT_SNDTIMEO_USECS;
+    (void)setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    /*
+     * Only the request line matters; anything beyond what fits in one
+     * read is discarded when the connection is closed.  A connection
+     * that sends nothing is closed without a response.
+     */
+    n = recv(fd, req, sizeof(req), 0);
+    if (n <= 0) {
+        return;
+    }
+    deadline = TIME_ADD_A_R(get_sys_time(), 
+                            VQEC_METRICS_EXPORT_SEND_DEADLINE);
+    if ((n < 4) || strncmp(req, "GET ", 4)) {
+        (void)vqec_metrics_export_send(fd, VQEC_METRICS_EXPORT_HTTP_405,
+                                       strlen(VQEC_METRICS_EXPORT_HTTP_405),
+                                       deadline);
+        return;
+    }
+    if (!vqec_metrics_export_send(fd, VQEC_METRICS_EXPORT_HTTP_HDR,
+                                  strlen(VQEC_METRICS_EXPORT_HTTP_HDR),
+                                  deadline)) {
+        return;
+    }
+
+    len = vqec_metrics_export_render(s_vqec_metrics_export_buf,
+                                     sizeof(s_vqec_metrics_export_buf));
+    if (len < 0) {
+        return;
+    }
+    if (len >= sizeof(s_vqec_metrics_export_buf)) {
+        len = sizeof(s_vqec_metrics_export_buf) - 1;
+    }
+    (void)vqec_metrics_export_send(fd, s_vqec_metrics_export_buf, len, 
+                                   deadline);
+}
+
+static void *
+vqec_metrics_export_thread (void *arg)
+{
+    int lsock = (int)(intptr_t)arg;
+    int fd;
+
+    while (TRUE) {
+        fd = accept(lsock, NULL, NULL);
+        if (fd < 0) {
+            if ((errno == EINTR) || (errno == ECONNABORTED)) {
+                continue;
+            }
+            /* the listening socket has been shut down */
+            break;
+        }
+        vqec_metrics_export_serve(fd);
+        close(fd);
+    }
+    return (NULL);
+}
+
+boolean
+vqec_metrics_export_start (uint16_t port)
+{
+    struct sockaddr_in addr;
+    int sock, on = 1;
+
+    if (s_vqec_metrics_export_running) {
+        return (TRUE);
+    }
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        syslog_print(VQEC_ERROR, "metrics exporter: socket creation failed");
+        return (FALSE);
+    }
+    (void)setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(sock, VQEC_METRICS_EXPORT_BACKLOG)) {
+        syslog_print(VQEC_ERROR, "metrics exporter: cannot listen on port");
+        close(sock);
+        return (FALSE);
+    }
+
+    if (vqec_pthread_create(&s_vqec_metrics_export_tid,
+                            vqec_metrics_export_thread,
+                            (void *)(intptr_t)sock)) {
+        syslog_print(VQEC_ERROR, "metrics exporter: thread creation failed");
+        close(sock);
+        return (FALSE);
+    }
+
+    s_vqec_metrics_export_sock = sock;
+    s_vqec_metrics_export_running = TRUE;
+    return (TRUE);
+}
+
+void
+vqec_metrics_export_stop (void)
+{
+    if (!s_vqec_metrics_export_running) {
+        return;
+    }
+
+    /* wakes the thread from accept() */
+    (void)shutdown(s_vqec_metrics_export_sock, SHUT_RDWR);
+    (void)pthread_join(s_vqec_metrics_export_tid, NULL);
+    close(s_vqec_metrics_export_sock);
+
+    s_vqec_metrics_export_sock = -1;
+    s_vqec_metrics_export_running = FALSE;
+}
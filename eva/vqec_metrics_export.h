@@ -0,0 +1,64 @@
+/*------------------------------------------------------------------
+ *
+ * VQE-C metrics exporter.
+ *
+ * When enabled, a thread serves the dataplane global counters, the
+ * statistics of all channels and tuners, the dataplane histograms and
+ * the event loop handler profiles on a loopback TCP port.  They are
+ * returned in response to an HTTP GET request, in a plain text exposition
+ * format (one "name{labels} value" line per sample, with HELP and TYPE
+ * comments) that monitoring agents can collect directly.  Other requests
+ * are answered with status 405, and a connection that sends no request
+ * is closed without a response.  The connection is closed once the
+ * response is written, or once the client has failed to read it in time.
+ *
+ * The metrics are rendered from the statistics published by the control
+ * plane and by the dataplane, so serving them never takes the global lock.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#ifndef __VQEC_METRICS_EXPORT_H__
+#define __VQEC_METRICS_EXPORT_H__
+
+#include <utils/vam_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Start the metrics exporter on a loopback TCP port.  Only one exporter
+ * runs at a time:  if one is running, this call does nothing.
+ *
+ * @param[in] port Loopback TCP port (host byte order).
+ * @param[out] boolean Returns TRUE on success, FALSE if the port cannot
+ * be bound or the exporter thread cannot be created.
+ */
+boolean vqec_metrics_export_start(uint16_t port);
+
+/**
+ * Stop the metrics exporter, if it is running.  The listening socket is
+ * closed, which terminates the exporter thread.  If a client is being
+ * served, this waits until it has been served, which is bounded by the
+ * request and response timeouts (under two seconds).
+ */
+void vqec_metrics_export_stop(void);
+
+/**
+ * Render all metrics into a buffer, as served by the exporter.
+ *
+ * @param[out] buf Buffer into which the metrics are rendered.
+ * @param[in] len Length of the buffer.
+ * @param[out] int32_t Returns the length of the full rendering, which
+ * is truncated if it is not less than len, or -1 on failure.
+ */
+int32_t vqec_metrics_export_render(char *buf, int32_t len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __VQEC_METRICS_EXPORT_H__ */
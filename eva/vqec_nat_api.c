@@ -153,11 +153,13 @@ vqec_nat_bind_update (vqec_nat_bindid_t id,
  * @param[in] periodic If the timer is periodic, set to true.
  * @param[in] handler Handler associated with the timer.
  * @param[in] arg Argument to be echoed in the callback.
+ * @param[in] name Name under which the timer is profiled.
  * @param[out]  vqec_event_* A pointer to an opaque event structure.
  *---------------------------------------------------------------------------*/  
 struct vqec_event_ *
-vqec_nat_timer_create (boolean periodic, 
-                       vqec_nat_proto_evt_handler handler, void *arg)
+vqec_nat_timer_create_named (boolean periodic, 
+                             vqec_nat_proto_evt_handler handler, void *arg,
+                             const char *name)
 {
     vqec_event_t *p_ev;
 
@@ -166,12 +168,14 @@ vqec_nat_timer_create (boolean periodic,
         return (NULL);
     }
     
-    if (!vqec_event_create(&p_ev,
-                           VQEC_EVTYPE_TIMER,
-                           periodic ? VQEC_EV_RECURRING : VQEC_EV_ONESHOT,
-                           handler,
-                           VQEC_EVDESC_TIMER,
-                           arg)) {
+    if (!vqec_event_create_named(&p_ev,
+                                 VQEC_EVTYPE_TIMER,
+                                 periodic ? 
+                                 VQEC_EV_RECURRING : VQEC_EV_ONESHOT,
+                                 handler,
+                                 VQEC_EVDESC_TIMER,
+                                 arg,
+                                 name)) {
         syslog_print(VQEC_ERROR, 
                      "Time creation failed in nat timer create");
         return (NULL);
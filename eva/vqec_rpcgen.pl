@@ -18,6 +18,7 @@ my $server_file = "";
 my $client_file = "";
 my @markers;
 $markers[0] = "RPC";
+$markers[1] = "RPC_NOLOCK";
 
 while ($#ARGV >= 0) {
     $arg = shift @ARGV;
@@ -132,6 +133,7 @@ while ($remaining =~ /((?:$marker_re)[ \t\n][^;]*;)(.*)/s) {
     ($pre_tokens, $arg_list) = split /[\(\)]/s,$current;
 
     @split_pretokens = split /[ \n\t][ \n\t]*/s,$pre_tokens;
+    $nolock = ($split_pretokens[0] eq "RPC_NOLOCK");
     shift @split_pretokens;
     $function_name = $split_pretokens[$#split_pretokens];
     $return_type = $split_pretokens[0];
@@ -192,7 +194,7 @@ while ($remaining =~ /((?:$marker_re)[ \t\n][^;]*;)(.*)/s) {
         $args->[$i] = { CLASS => $arg_class, TYPE => $arg_type, NAME => $arg_name, BOUND => $arg_bound };
     }
 
-    $rpcs[$num_rpcs] = { RET => $return_type, NAME => $function_name, , DIR => $arg_dir, ARGS => $args, LASTARG => $#split_args};
+    $rpcs[$num_rpcs] = { RET => $return_type, NAME => $function_name, , DIR => $arg_dir, ARGS => $args, LASTARG => $#split_args, NOLOCK => $nolock};
     $num_rpcs++;
 }
 
@@ -323,7 +325,13 @@ if ($do_common) {
             }
         }
 
-        print COMMON  "} " . $rsp_struct_name . "t;\n";  
+        print COMMON  "} " . $rsp_struct_name . "t;\n";
+
+        # fail the build if either structure outgrows its IPC buffer
+        print COMMON  "typedef char " . $req_struct_name . "fits_" .
+            "[(sizeof(" . $req_struct_name . "t) <= VQEC_DEV_IPC_BUF_LEN) ? 1 : -1];\n";
+        print COMMON  "typedef char " . $rsp_struct_name . "fits_" .
+            "[(sizeof(" . $rsp_struct_name . "t) <= VQEC_DEV_IPC_BUF_LEN) ? 1 : -1];\n";
 
     }
 
@@ -551,6 +559,7 @@ if ($do_server) {
         my $req_struct_name =  &mk_req_struct_name($fcn_name);
         my $rsp_struct_name = &mk_rsp_struct_name($fcn_name);
         my $fcn_num = &mk_rpc_id($fcn_name);
+        my $nolock = $rpcs[$i]->{'NOLOCK'};
 
         print SERVER  "          case $fcn_num:\n";
         print SERVER  "          {\n";
@@ -606,7 +615,9 @@ if ($do_server) {
             }
         }
 
-        print SERVER  "               vqec_lock_lock(g_vqec_dp_lock);\n";
+        if (!$nolock) {
+            print SERVER  "               vqec_lock_lock(g_vqec_dp_lock);\n";
+        }
         print SERVER  "               ret_val = $fcn_name(";
         for ($j=0; $j<$num_args; $j++) {
             my $class = $args[$j]->{'CLASS'};
@@ -626,7 +637,9 @@ if ($do_server) {
             }
         }
         print SERVER  ");\n";
-        print SERVER  "               vqec_lock_unlock(g_vqec_dp_lock);\n";
+        if (!$nolock) {
+            print SERVER  "               vqec_lock_unlock(g_vqec_dp_lock);\n";
+        }
 
         print SERVER  "               rsp_p->__ret_val = ret_val;\n";
         print SERVER  "               rsp_p->__rpc_rsp_len = sizeof(*rsp_p);\n";
@@ -0,0 +1,740 @@
+/*------------------------------------------------------------------
+ *
+ * VQE-C shared RTCP receive sockets.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+#define _GNU_SOURCE 1   /* for recvmmsg */
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <utils/vqe_hash.h>
+#include <utils/queue_plus.h>
+#include <rtp/rtcp.h>
+#include <rtp/rtp_database.h>
+#include <rtp/rtp_util.h>
+#include "vqec_rtcp_mux.h"
+#include "vqec_rtp.h"
+#include "rtp_era_recv.h"
+#include "rtp_repair_recv.h"
+#include "vqec_debug.h"
+#include "vqe_port_macros.h"
+#include "vqec_assert_macros.h"
+#include "vqec_event.h"
+
+#ifdef _VQEC_UTEST_INTERPOSERS
+#define UT_STATIC 
+#else
+#define UT_STATIC static
+#endif
+
+#ifdef MSG_WAITFORONE
+#define VQEC_RTCP_MUX_HAVE_RECVMMSG 1
+#endif
+
+#define VQEC_RTCP_MUX_HASH_BUCKETS 256  /* must be a power of 2 */
+#define VQEC_RTCP_MUX_BATCH 16          /* datagrams per receive */
+
+/*
+ * A shared receive socket.
+ */
+typedef struct vqec_rtcp_mux_sock_ {
+    VQE_LIST_ENTRY(vqec_rtcp_mux_sock_) list_obj;
+    vqec_recv_sock_t *sock;
+    boolean ephemeral;      /* shared by requests for an ephemeral port */
+    uint32_t refs;          /* attached sessions, plus one while draining */
+} vqec_rtcp_mux_sock_t;
+
+/*
+ * Demultiplexing key: the local end of a shared socket and the remote
+ * end from which RTCP is received.
+ */
+typedef struct vqec_rtcp_mux_key_ {
+    in_addr_t local_addr;
+    in_addr_t remote_addr;
+    in_port_t local_port;
+    in_port_t remote_port;
+} vqec_rtcp_mux_key_t;
+
+/*
+ * All the sessions which receive RTCP from one remote end on one
+ * shared socket; the most recently attached session is first.
+ */
+typedef struct vqec_rtcp_mux_dest_ {
+    vqe_hash_elem_t elem;
+    vqec_rtcp_mux_key_t key;
+    VQE_LIST_HEAD(, vqec_rtcp_mux_sess_) sess_list;
+} vqec_rtcp_mux_dest_t;
+
+typedef struct vqec_rtcp_mux_sess_ {
+    VQE_LIST_ENTRY(vqec_rtcp_mux_sess_) list_obj;
+    rtp_session_t *session;
+    boolean is_primary;
+    vqec_rtcp_mux_sock_t *msock;
+    vqec_rtcp_mux_dest_t *dest;
+} vqec_rtcp_mux_sess_t;
+
+/*
+ * One received datagram.
+ */
+typedef struct vqec_rtcp_mux_pak_ {
+    char *buf;
+    int32_t len;
+    struct in_addr src_addr;
+    uint16_t src_port;
+    struct timeval recv_time;
+} vqec_rtcp_mux_pak_t;
+
+typedef struct vqec_rtcp_mux_ {
+    VQE_LIST_HEAD(, vqec_rtcp_mux_sock_) sock_list;
+    vqe_hash_t *dest_hash;
+    char *iobuf;                /* VQEC_RTCP_MUX_BATCH packet buffers */
+#ifdef VQEC_RTCP_MUX_HAVE_RECVMMSG
+    boolean no_recvmmsg;        /* not supported by the running kernel */
+    struct mmsghdr msgs[VQEC_RTCP_MUX_BATCH];
+    struct iovec iov[VQEC_RTCP_MUX_BATCH];
+    struct sockaddr_in saddr[VQEC_RTCP_MUX_BATCH];
+    char ctl[VQEC_RTCP_MUX_BATCH][CMSG_SPACE(sizeof(struct timeval))];
+#endif /* VQEC_RTCP_MUX_HAVE_RECVMMSG */
+} vqec_rtcp_mux_t;
+
+static vqec_rtcp_mux_t *s_rtcp_mux = NULL;
+
+static uint32_t
+vqec_rtcp_mux_hash_func (uint8_t *key, int32_t len, int32_t mask)
+{
+    vqec_rtcp_mux_key_t *k = (vqec_rtcp_mux_key_t *)key;
+    uint32_t hash;
+
+    hash = (ntohl(k->remote_addr) * 2654435761U) ^
+        (ntohs(k->remote_port) << 16) ^ ntohs(k->local_port) ^
+        ntohl(k->local_addr);
+    return ((hash ^ (hash >> 16)) & (VQEC_RTCP_MUX_HASH_BUCKETS - 1));
+}
+
+/**---------------------------------------------------------------------------
+ * Read up to VQEC_RTCP_MUX_BATCH datagrams from a shared socket.
+ *
+ * @param[in] sock Socket to be read.
+ * @param[out] paks Received datagrams; empty datagrams have a length of 0.
+ * @param[out] int32_t Number of datagrams received; less than
+ * VQEC_RTCP_MUX_BATCH once the socket is drained.
+ *---------------------------------------------------------------------------*/
+static int32_t
+vqec_rtcp_mux_read_batch (vqec_recv_sock_t *sock, vqec_rtcp_mux_pak_t *paks)
+{
+    int32_t n = 0, i, len;
+
+#ifdef VQEC_RTCP_MUX_HAVE_RECVMMSG
+    struct msghdr *msg;
+    struct cmsghdr *cmsg;
+
+    if (!s_rtcp_mux->no_recvmmsg) {
+        for (i = 0; i < VQEC_RTCP_MUX_BATCH; i++) {
+            s_rtcp_mux->iov[i].iov_len = RTCP_PAK_SIZE;
+            msg = &s_rtcp_mux->msgs[i].msg_hdr;
+            msg->msg_namelen = sizeof(s_rtcp_mux->saddr[i]);
+            msg->msg_controllen = sizeof(s_rtcp_mux->ctl[i]);
+            msg->msg_flags = 0;
+        }
+        n = recvmmsg(sock->fd, s_rtcp_mux->msgs, VQEC_RTCP_MUX_BATCH, 0,
+                     NULL);
+        if (n >= 0) {
+            for (i = 0; i < n; i++) {
+                msg = &s_rtcp_mux->msgs[i].msg_hdr;
+                paks[i].buf = s_rtcp_mux->iov[i].iov_base;
+                paks[i].len = s_rtcp_mux->msgs[i].msg_len;
+                paks[i].src_addr = s_rtcp_mux->saddr[i].sin_addr;
+                paks[i].src_port = s_rtcp_mux->saddr[i].sin_port;
+                timerclear(&paks[i].recv_time);
+                for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL;
+                     cmsg = CMSG_NXTHDR(msg, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_SOCKET &&
+                        cmsg->cmsg_type == SO_TIMESTAMP) {
+                        memcpy(&paks[i].recv_time, CMSG_DATA(cmsg),
+                               sizeof(struct timeval));
+                    }
+                }
+                if (!timerisset(&paks[i].recv_time)) {
+                    gettimeofday(&paks[i].recv_time, NULL);
+                }
+            }
+            return (n);
+        }
+        if (errno != ENOSYS) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                VQEC_DEBUG(VQEC_DEBUG_RTCP, "shared rtcp socket recvmmsg: "
+                           "%s\n", strerror(errno));
+            }
+            return (0);
+        }
+        s_rtcp_mux->no_recvmmsg = TRUE;
+        n = 0;
+    }
+#endif /* VQEC_RTCP_MUX_HAVE_RECVMMSG */
+
+    for (i = 0; i < VQEC_RTCP_MUX_BATCH; i++) {
+        paks[n].buf = s_rtcp_mux->iobuf + i * RTCP_PAK_SIZE;
+        len = vqec_recv_sock_read(sock,
+                                  &paks[n].recv_time,
+                                  paks[n].buf,
+                                  RTCP_PAK_SIZE,
+                                  &paks[n].src_addr,
+                                  &paks[n].src_port);
+        if (len < 1) {
+            break;
+        }
+        paks[n++].len = len;
+    }
+    return (n);
+}
+
+/**---------------------------------------------------------------------------
+ * Look up the sessions on a shared socket which receive from a remote end.
+ *
+ * @param[in] key Local and remote ends.
+ * @param[out] vqec_rtcp_mux_dest_t* The sessions, or NULL if there are none.
+ *---------------------------------------------------------------------------*/
+static vqec_rtcp_mux_dest_t *
+vqec_rtcp_mux_dest_find (vqec_rtcp_mux_key_t *key)
+{
+    vqe_hash_key_t hkey;
+    vqe_hash_elem_t *elem;
+
+    VQE_HASH_MAKE_KEY(&hkey, key, sizeof(*key));
+    elem = MCALL(s_rtcp_mux->dest_hash, vqe_hash_get_elem, &hkey);
+    return (elem ? (vqec_rtcp_mux_dest_t *)vqe_hash_get_elem_data(elem) :
+            NULL);
+}
+
+/**---------------------------------------------------------------------------
+ * Look up the sessions on a shared socket which receive from the source of
+ * a datagram: those attached with the source's address and port, or else
+ * those attached with its address and any port.  A datagram from any other
+ * source is not for a session on the socket.
+ *
+ * @param[in] msock Shared socket.
+ * @param[in] src_addr Source address of the datagram.
+ * @param[in] src_port Source port of the datagram, in network order.
+ * @param[out] vqec_rtcp_mux_dest_t* The sessions, or NULL if there are none.
+ *---------------------------------------------------------------------------*/
+UT_STATIC vqec_rtcp_mux_dest_t *
+vqec_rtcp_mux_dest_lookup (vqec_rtcp_mux_sock_t *msock,
+                           struct in_addr src_addr,
+                           uint16_t src_port)
+{
+    vqec_rtcp_mux_key_t key;
+    vqec_rtcp_mux_dest_t *dest;
+
+    memset(&key, 0, sizeof(key));
+    key.local_addr = msock->sock->rcv_if_address.s_addr;
+    key.local_port = msock->sock->port;
+    key.remote_addr = src_addr.s_addr;
+    key.remote_port = src_port;
+    dest = vqec_rtcp_mux_dest_find(&key);
+    if (!dest) {
+        /* sessions which accept RTCP from any port of the source */
+        key.remote_port = 0;
+        dest = vqec_rtcp_mux_dest_find(&key);
+    }
+    return (dest);
+}
+
+/**---------------------------------------------------------------------------
+ * Get the packetflow source SSRC of an attached session.
+ *
+ * @param[in] msess Attached session.
+ * @param[out] ssrc Packetflow source SSRC.
+ * @param[out] boolean Returns TRUE if the session has a packetflow source.
+ *---------------------------------------------------------------------------*/
+static boolean
+vqec_rtcp_mux_sess_pktflow_ssrc (vqec_rtcp_mux_sess_t *msess, uint32_t *ssrc)
+{
+    rtp_era_recv_t *era;
+    rtp_repair_recv_t *repair;
+
+    if (msess->is_primary) {
+        era = (rtp_era_recv_t *)msess->session;
+        if (is_null_rtp_source_id(&era->pktflow_src.id)) {
+            return (FALSE);
+        }
+        *ssrc = era->pktflow_src.id.ssrc;
+    } else {
+        repair = (rtp_repair_recv_t *)msess->session;
+        if (!repair->ssrc_filter_en) {
+            return (FALSE);
+        }
+        *ssrc = repair->src_ssrc_filter;
+    }
+    return (TRUE);
+}
+
+/**---------------------------------------------------------------------------
+ * Select the session for an RTCP datagram among those which receive from
+ * its source.  The sender SSRC of the first RTCP packet selects, in order:
+ * a session in which the sender is already a member, then a session whose
+ * packetflow source is the sender; otherwise the datagram goes to the most
+ * recently attached session.
+ *
+ * @param[in] dest Sessions which receive from the datagram's source.
+ * @param[in] pak Received datagram.
+ * @param[out] vqec_rtcp_mux_sess_t* Selected session.
+ *---------------------------------------------------------------------------*/
+static vqec_rtcp_mux_sess_t *
+vqec_rtcp_mux_select (vqec_rtcp_mux_dest_t *dest, vqec_rtcp_mux_pak_t *pak)
+{
+    vqec_rtcp_mux_sess_t *first, *msess;
+    rtp_member_t *member;
+    uint32_t ssrc, pktflow_ssrc;
+
+    first = VQE_LIST_FIRST(&dest->sess_list);
+    if (!VQE_LIST_NEXT(first, list_obj) || pak->len < 8) {
+        return (first);
+    }
+    memcpy(&ssrc, pak->buf + 4, sizeof(ssrc));
+    ssrc = ntohl(ssrc);
+
+    VQE_LIST_FOREACH(msess, &dest->sess_list, list_obj) {
+        for (member = rtp_first_member_with_ssrc(msess->session, ssrc);
+             member;
+             member = rtp_next_member_with_ssrc(msess->session, member)) {
+            if (!(member->flags & RTP_MEMBER_FLAG_RCVR_ONLY) &&
+                (!member->rtcp_src_addr ||
+                 member->rtcp_src_addr == pak->src_addr.s_addr)) {
+                return (msess);
+            }
+        }
+    }
+    VQE_LIST_FOREACH(msess, &dest->sess_list, list_obj) {
+        if (vqec_rtcp_mux_sess_pktflow_ssrc(msess, &pktflow_ssrc) &&
+            pktflow_ssrc == ssrc) {
+            return (msess);
+        }
+    }
+    return (first);
+}
+
+/**---------------------------------------------------------------------------
+ * Hand a datagram received on a shared socket to its session(s).
+ *
+ * @param[in] msock Shared socket.
+ * @param[in] pak Received datagram.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_rtcp_mux_demux (vqec_rtcp_mux_sock_t *msock, vqec_rtcp_mux_pak_t *pak)
+{
+    vqec_rtcp_mux_dest_t *dest;
+    vqec_rtcp_mux_sess_t *msess, *tmsess;
+
+    dest = vqec_rtcp_mux_dest_lookup(msock, pak->src_addr, pak->src_port);
+    if (!dest) {
+        VQEC_DEBUG(VQEC_DEBUG_RTCP,
+                   "shared rtcp socket port %d: no session for source "
+                   "0x%x:%d\n", ntohs(msock->sock->port),
+                   ntohl(pak->src_addr.s_addr), ntohs(pak->src_port));
+        return;
+    }
+
+    if ((pak->buf[0] & 0xC0) == 0) {
+        /*
+         * NAT packet: it is seen by the bindings of all the sessions
+         * which share the source; each binding only accepts responses
+         * to its own requests.
+         */
+        VQE_LIST_FOREACH_SAFE(msess, &dest->sess_list, list_obj, tmsess) {
+            rtcp_event_handler_internal_deliver_pak(msess->session,
+                                                    pak->src_addr,
+                                                    pak->src_port,
+                                                    pak->buf,
+                                                    pak->len,
+                                                    &pak->recv_time,
+                                                    msess->is_primary);
+        }
+        return;
+    }
+
+    msess = vqec_rtcp_mux_select(dest, pak);
+    rtcp_event_handler_internal_deliver_pak(msess->session,
+                                            pak->src_addr,
+                                            pak->src_port,
+                                            pak->buf,
+                                            pak->len,
+                                            &pak->recv_time,
+                                            msess->is_primary);
+}
+
+/**---------------------------------------------------------------------------
+ * Release a reference to a shared socket, closing it with the last one.
+ *
+ * @param[in] msock Shared socket.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_rtcp_mux_sock_put (vqec_rtcp_mux_sock_t *msock)
+{
+    VQEC_ASSERT(msock->refs > 0);
+    if (--msock->refs) {
+        return;
+    }
+    VQE_LIST_REMOVE(msock, list_obj);
+    if (msock->sock->vqec_ev) {
+        vqec_event_destroy(&msock->sock->vqec_ev);
+    }
+    vqec_recv_sock_destroy(msock->sock);
+    free(msock);
+}
+
+/**---------------------------------------------------------------------------
+ * Shared RTCP socket event handler for libevent: drains the socket a
+ * batch at a time.
+ *
+ * @param[in] dptr Pointer to the shared socket.
+ * All other arguments are unused.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_rtcp_mux_event_handler (const vqec_event_t *const evptr,
+                             int fd, short event, void *dptr)
+{
+    vqec_rtcp_mux_sock_t *msock = dptr;
+    vqec_rtcp_mux_pak_t paks[VQEC_RTCP_MUX_BATCH];
+    int32_t n, i;
+
+    VQEC_ASSERT(msock != NULL);
+    VQEC_ASSERT(s_rtcp_mux != NULL);
+
+    /* keep the socket while its sessions process the batch */
+    msock->refs++;
+    do {
+        n = vqec_rtcp_mux_read_batch(msock->sock, paks);
+        for (i = 0; i < n; i++) {
+            if (paks[i].len > 0) {
+                vqec_rtcp_mux_demux(msock, &paks[i]);
+            }
+        }
+    } while (n == VQEC_RTCP_MUX_BATCH && msock->refs > 1);
+    vqec_rtcp_mux_sock_put(msock);
+}
+
+/**---------------------------------------------------------------------------
+ * Get a reference to a shared socket, creating the socket if needed.
+ *
+ * @param[in] local_addr Local address.
+ * @param[in] local_port Local port, or 0 for the ephemeral socket.
+ * @param[in] sock_buf_depth Receive buffer depth of a new socket.
+ * @param[in] dscp DSCP value of a new socket.
+ * @param[out] vqec_rtcp_mux_sock_t* The socket, or NULL on failure.
+ *---------------------------------------------------------------------------*/
+static vqec_rtcp_mux_sock_t *
+vqec_rtcp_mux_sock_get (in_addr_t local_addr,
+                        uint16_t local_port,
+                        uint32_t sock_buf_depth,
+                        uint8_t dscp)
+{
+    vqec_rtcp_mux_sock_t *msock;
+
+    VQE_LIST_FOREACH(msock, &s_rtcp_mux->sock_list, list_obj) {
+        if ((msock->sock->rcv_if_address.s_addr == local_addr) &&
+            (local_port ? (msock->sock->port == local_port) :
+             msock->ephemeral)) {
+            msock->refs++;
+            return (msock);
+        }
+    }
+
+    msock = malloc(sizeof(*msock));
+    if (!msock) {
+        return (NULL);
+    }
+    memset(msock, 0, sizeof(*msock));
+    msock->sock = vqec_recv_sock_create("shared rtcp sock",
+                                        local_addr,
+                                        local_port,
+                                        local_addr,
+                                        FALSE,
+                                        sock_buf_depth,
+                                        dscp);
+    if (!msock->sock) {
+        syslog_print(VQEC_ERROR, "unable to create shared rtcp socket\n");
+        free(msock);
+        return (NULL);
+    }
+    if (!vqec_event_create(&msock->sock->vqec_ev,
+                           VQEC_EVTYPE_FD,
+                           VQEC_EV_READ | VQEC_EV_RECURRING,
+                           vqec_rtcp_mux_event_handler,
+                           msock->sock->fd,
+                           msock) ||
+        !vqec_event_start(msock->sock->vqec_ev, NULL)) {
+        vqec_event_destroy(&msock->sock->vqec_ev);
+        vqec_recv_sock_destroy(msock->sock);
+        free(msock);
+        syslog_print(VQEC_ERROR, "failed to add event");
+        return (NULL);
+    }
+    msock->ephemeral = !local_port;
+    msock->refs = 1;
+    VQE_LIST_INSERT_HEAD(&s_rtcp_mux->sock_list, msock, list_obj);
+    return (msock);
+}
+
+/**---------------------------------------------------------------------------
+ * Get the sessions on a shared socket which receive from a remote end,
+ * creating an empty entry if there are none.
+ *
+ * @param[in] msock Shared socket.
+ * @param[in] remote_addr Remote address.
+ * @param[in] remote_port Remote port.
+ * @param[out] vqec_rtcp_mux_dest_t* The entry, or NULL on failure.
+ *---------------------------------------------------------------------------*/
+static vqec_rtcp_mux_dest_t *
+vqec_rtcp_mux_dest_get (vqec_rtcp_mux_sock_t *msock,
+                        in_addr_t remote_addr,
+                        uint16_t remote_port)
+{
+    vqec_rtcp_mux_key_t key;
+    vqec_rtcp_mux_dest_t *dest;
+    vqe_hash_key_t hkey;
+
+    memset(&key, 0, sizeof(key));
+    key.local_addr = msock->sock->rcv_if_address.s_addr;
+    key.local_port = msock->sock->port;
+    key.remote_addr = remote_addr;
+    key.remote_port = remote_port;
+    dest = vqec_rtcp_mux_dest_find(&key);
+    if (dest) {
+        return (dest);
+    }
+
+    dest = malloc(sizeof(*dest));
+    if (!dest) {
+        return (NULL);
+    }
+    memset(dest, 0, sizeof(*dest));
+    dest->key = key;
+    VQE_LIST_INIT(&dest->sess_list);
+    VQE_HASH_MAKE_KEY(&hkey, &dest->key, sizeof(dest->key));
+    vqe_hash_elem_init(&dest->elem, &hkey, dest);
+    if (!MCALL(s_rtcp_mux->dest_hash, vqe_hash_add_elem, &dest->elem)) {
+        free(dest);
+        return (NULL);
+    }
+    return (dest);
+}
+
+/**---------------------------------------------------------------------------
+ * Remove a session from the entry of its remote end, and free the entry
+ * if it is left empty.
+ *
+ * @param[in] msess Attached session.
+ *---------------------------------------------------------------------------*/
+static void
+vqec_rtcp_mux_dest_remove (vqec_rtcp_mux_sess_t *msess)
+{
+    vqec_rtcp_mux_dest_t *dest = msess->dest;
+
+    VQE_LIST_REMOVE(msess, list_obj);
+    msess->dest = NULL;
+    if (VQE_LIST_EMPTY(&dest->sess_list)) {
+        (void)MCALL(s_rtcp_mux->dest_hash, vqe_hash_del_elem, &dest->elem);
+        free(dest);
+    }
+}
+
+/**---------------------------------------------------------------------------
+ * Enable shared RTCP receive sockets.
+ *
+ * @param[out] boolean Returns TRUE on success.
+ *---------------------------------------------------------------------------*/
+boolean
+vqec_rtcp_mux_init (void)
+{
+#ifdef VQEC_RTCP_MUX_HAVE_RECVMMSG
+    struct msghdr *msg;
+    int32_t i;
+#endif /* VQEC_RTCP_MUX_HAVE_RECVMMSG */
+
+    if (s_rtcp_mux) {
+        return (TRUE);
+    }
+
+    s_rtcp_mux = malloc(sizeof(*s_rtcp_mux));
+    if (!s_rtcp_mux) {
+        return (FALSE);
+    }
+    memset(s_rtcp_mux, 0, sizeof(*s_rtcp_mux));
+    VQE_LIST_INIT(&s_rtcp_mux->sock_list);
+
+    s_rtcp_mux->iobuf = malloc(VQEC_RTCP_MUX_BATCH * RTCP_PAK_SIZE);
+    init_vqe_hash_elem_module();
+    init_vqe_hash_module();
+    s_rtcp_mux->dest_hash = vqe_hash_create(VQEC_RTCP_MUX_HASH_BUCKETS,
+                                            vqec_rtcp_mux_hash_func,
+                                            NULL);
+    if (!s_rtcp_mux->iobuf || !s_rtcp_mux->dest_hash) {
+        vqec_rtcp_mux_deinit();
+        return (FALSE);
+    }
+
+#ifdef VQEC_RTCP_MUX_HAVE_RECVMMSG
+    for (i = 0; i < VQEC_RTCP_MUX_BATCH; i++) {
+        s_rtcp_mux->iov[i].iov_base = s_rtcp_mux->iobuf + i * RTCP_PAK_SIZE;
+        msg = &s_rtcp_mux->msgs[i].msg_hdr;
+        msg->msg_name = &s_rtcp_mux->saddr[i];
+        msg->msg_iov = &s_rtcp_mux->iov[i];
+        msg->msg_iovlen = 1;
+        msg->msg_control = s_rtcp_mux->ctl[i];
+    }
+#endif /* VQEC_RTCP_MUX_HAVE_RECVMMSG */
+    return (TRUE);
+}
+
+/**---------------------------------------------------------------------------
+ * Disable shared RTCP receive sockets.
+ *---------------------------------------------------------------------------*/
+void
+vqec_rtcp_mux_deinit (void)
+{
+    vqec_rtcp_mux_sock_t *msock, *tmsock;
+
+    if (!s_rtcp_mux) {
+        return;
+    }
+
+    VQE_LIST_FOREACH_SAFE(msock, &s_rtcp_mux->sock_list, list_obj, tmsock) {
+        msock->refs = 1;
+        vqec_rtcp_mux_sock_put(msock);
+    }
+    if (s_rtcp_mux->dest_hash) {
+        (void)vqe_hash_destroy_x(s_rtcp_mux->dest_hash, FALSE);
+    }
+    if (s_rtcp_mux->iobuf) {
+        free(s_rtcp_mux->iobuf);
+    }
+    free(s_rtcp_mux);
+    s_rtcp_mux = NULL;
+}
+
+/**---------------------------------------------------------------------------
+ * @param[out] boolean Returns TRUE if shared sockets are enabled.
+ *---------------------------------------------------------------------------*/
+boolean
+vqec_rtcp_mux_enabled (void)
+{
+    return (s_rtcp_mux != NULL);
+}
+
+/**---------------------------------------------------------------------------
+ * Attach a session to a shared RTCP receive socket.
+ *
+ * @param[out] pp_msess Attachment handle.
+ * @param[in] session Primary or repair session.
+ * @param[in] is_primary TRUE for a primary (ERA) session.
+ * @param[in] local_addr Local address of the socket.
+ * @param[in,out] local_port Local port of the socket, 0 for the
+ * ephemeral socket.
+ * @param[in] remote_addr Address of the feedback target.
+ * @param[in] remote_port RTCP port of the feedback target, or 0.
+ * @param[in] sock_buf_depth Receive buffer depth of a new socket.
+ * @param[in] dscp DSCP value of a new socket.
+ * @param[out] vqec_recv_sock_t* The shared socket, or NULL on failure.
+ *---------------------------------------------------------------------------*/
+vqec_recv_sock_t *
+vqec_rtcp_mux_attach (vqec_rtcp_mux_sess_t **pp_msess,
+                      rtp_session_t *session,
+                      boolean is_primary,
+                      in_addr_t local_addr,
+                      uint16_t *local_port,
+                      in_addr_t remote_addr,
+                      uint16_t remote_port,
+                      uint32_t sock_buf_depth,
+                      uint8_t dscp)
+{
+    vqec_rtcp_mux_sock_t *msock;
+    vqec_rtcp_mux_dest_t *dest;
+    vqec_rtcp_mux_sess_t *msess;
+
+    if (!s_rtcp_mux || !pp_msess || !session || !local_port) {
+        syslog_print(VQEC_INVALIDARGS, __FUNCTION__);
+        return (NULL);
+    }
+
+    msock = vqec_rtcp_mux_sock_get(local_addr, *local_port,
+                                   sock_buf_depth, dscp);
+    if (!msock) {
+        return (NULL);
+    }
+    msess = malloc(sizeof(*msess));
+    dest = msess ? vqec_rtcp_mux_dest_get(msock, remote_addr, remote_port) :
+        NULL;
+    if (!dest) {
+        if (msess) {
+            free(msess);
+        }
+        vqec_rtcp_mux_sock_put(msock);
+        return (NULL);
+    }
+    memset(msess, 0, sizeof(*msess));
+    msess->session = session;
+    msess->is_primary = is_primary;
+    msess->msock = msock;
+    msess->dest = dest;
+    VQE_LIST_INSERT_HEAD(&dest->sess_list, msess, list_obj);
+
+    *local_port = msock->sock->port;
+    *pp_msess = msess;
+    return (msock->sock);
+}
+
+/**---------------------------------------------------------------------------
+ * Change the feedback target of an attached session.
+ *
+ * @param[in] msess Attachment handle.
+ * @param[in] remote_addr Address of the feedback target.
+ * @param[in] remote_port RTCP port of the feedback target.
+ * @param[out] boolean Returns TRUE on success.
+ *---------------------------------------------------------------------------*/
+boolean
+vqec_rtcp_mux_update (vqec_rtcp_mux_sess_t *msess,
+                      in_addr_t remote_addr,
+                      uint16_t remote_port)
+{
+    vqec_rtcp_mux_dest_t *dest;
+
+    if (!s_rtcp_mux || !msess) {
+        return (FALSE);
+    }
+    if (msess->dest->key.remote_addr == remote_addr &&
+        msess->dest->key.remote_port == remote_port) {
+        return (TRUE);
+    }
+
+    dest = vqec_rtcp_mux_dest_get(msess->msock, remote_addr, remote_port);
+    if (!dest) {
+        return (FALSE);
+    }
+    vqec_rtcp_mux_dest_remove(msess);
+    msess->dest = dest;
+    VQE_LIST_INSERT_HEAD(&dest->sess_list, msess, list_obj);
+    return (TRUE);
+}
+
+/**---------------------------------------------------------------------------
+ * Detach a session from its shared socket.
+ *
+ * @param[in,out] pp_msess Attachment handle, set to NULL.
+ *---------------------------------------------------------------------------*/
+void
+vqec_rtcp_mux_detach (vqec_rtcp_mux_sess_t **pp_msess)
+{
+    vqec_rtcp_mux_sess_t *msess;
+
+    if (!s_rtcp_mux || !pp_msess || !*pp_msess) {
+        return;
+    }
+    msess = *pp_msess;
+    vqec_rtcp_mux_dest_remove(msess);
+    vqec_rtcp_mux_sock_put(msess->msock);
+    free(msess);
+    *pp_msess = NULL;
+}
@@ -0,0 +1,117 @@
+/*------------------------------------------------------------------
+ *
+ * VQE-C shared RTCP receive sockets.
+ *
+ * When enabled, the unicast RTCP receive sockets of primary and repair
+ * sessions are shared: sessions which bind the same local address and
+ * port use one socket, and sessions which ask for an ephemeral port
+ * share one ephemeral socket per local address.  Each shared socket has
+ * a single read event, is drained a batch of datagrams at a time, and
+ * every datagram is handed to the session whose feedback target sent
+ * it.  When several sessions on a socket have the same feedback target
+ * the sender SSRC of the datagram selects the session.  Unlike a socket
+ * of its own, on which a session receives RTCP from any source, a shared
+ * socket drops RTCP from sources other than the feedback targets.
+ *
+ * Primary sessions with a multicast (SSM) destination keep their own
+ * socket, since it is bound to the group.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#ifndef __VQEC_RTCP_MUX_H__
+#define __VQEC_RTCP_MUX_H__
+
+#include <utils/vam_types.h>
+#include <rtp/rtp_session.h>
+#include "vqec_recv_socket.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * Attachment of a session to a shared socket; opaque outside the module.
+ */
+struct vqec_rtcp_mux_sess_;
+
+/**
+ * Enable shared RTCP receive sockets.  Sessions created after this call
+ * use them; it is safe to call this function more than once.
+ *
+ * @param[out] boolean Returns TRUE on success, FALSE if resources
+ * cannot be allocated.
+ */
+boolean vqec_rtcp_mux_init(void);
+
+/**
+ * Disable shared sockets.  It must be called after all the sessions
+ * have been deleted.
+ */
+void vqec_rtcp_mux_deinit(void);
+
+/**
+ * @param[out] boolean Returns TRUE if shared sockets are enabled.
+ */
+boolean vqec_rtcp_mux_enabled(void);
+
+/**
+ * Attach a session to a shared RTCP receive socket, creating the socket
+ * if needed.  The socket returned is owned by the module: the session
+ * may transmit on its descriptor, but must not add events to it or
+ * destroy it; vqec_rtcp_mux_detach() releases it instead.
+ *
+ * @param[out] pp_msess Attachment handle.
+ * @param[in] session Primary or repair session.
+ * @param[in] is_primary TRUE for a primary (ERA) session.
+ * @param[in] local_addr Local address of the socket.
+ * @param[in,out] local_port Local port of the socket, in network order;
+ * if it is 0 on input, the port of the socket shared by ephemeral
+ * requests is returned.
+ * @param[in] remote_addr Address of the feedback target.
+ * @param[in] remote_port RTCP port of the feedback target, in network
+ * order; 0 to accept RTCP from any port of remote_addr.
+ * @param[in] sock_buf_depth Receive buffer depth, if a socket is created.
+ * @param[in] dscp DSCP value for transmission, if a socket is created.
+ * @param[out] vqec_recv_sock_t* The shared socket, or NULL on failure.
+ */
+vqec_recv_sock_t *
+vqec_rtcp_mux_attach(struct vqec_rtcp_mux_sess_ **pp_msess,
+                     rtp_session_t *session,
+                     boolean is_primary,
+                     in_addr_t local_addr,
+                     uint16_t *local_port,
+                     in_addr_t remote_addr,
+                     uint16_t remote_port,
+                     uint32_t sock_buf_depth,
+                     uint8_t dscp);
+
+/**
+ * Change the feedback target of an attached session.
+ *
+ * @param[in] msess Attachment handle.
+ * @param[in] remote_addr Address of the feedback target.
+ * @param[in] remote_port RTCP port of the feedback target, in network
+ * order.
+ * @param[out] boolean Returns TRUE on success.
+ */
+boolean
+vqec_rtcp_mux_update(struct vqec_rtcp_mux_sess_ *msess,
+                     in_addr_t remote_addr,
+                     uint16_t remote_port);
+
+/**
+ * Detach a session from its shared socket; the socket is closed when
+ * its last session is detached.
+ *
+ * @param[in,out] pp_msess Attachment handle, set to NULL.
+ */
+void vqec_rtcp_mux_detach(struct vqec_rtcp_mux_sess_ **pp_msess);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __VQEC_RTCP_MUX_H__ */
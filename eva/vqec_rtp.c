@@ -49,6 +49,11 @@ static timeout_callback s_timeout_cb_array[VQEC_RTCP_LAST_TIMEOUT] =
     rtcp_member_timeout_cb,
     rtcp_receive_report_timeout_cb 
 };
+static const char *s_timeout_cb_name_array[VQEC_RTCP_LAST_TIMEOUT] = 
+{ 
+    "rtcp_member_timeout_cb",
+    "rtcp_receive_report_timeout_cb" 
+};
 
 /*
  * rtcp_construct_report_pubports
@@ -421,6 +426,68 @@ rtcp_event_handler_internal_process_pak (rtp_session_t *rtp_session,
 }
 
 
+/**---------------------------------------------------------------------------
+ * Deliver one received RTCP datagram to a session: NAT packets are
+ * ejected to the NAT protocol, others are processed as RTCP.
+ *
+ * @param[in] rtp_session Pointer to a repair or primary session.
+ * @param[in] pak_src_addr IP source address of the datagram.
+ * @param[in] pak_src_port UDP source port of the datagram.
+ * @param[in] pak_buff Contents of the datagram.
+ * @param[in] pak_buff_len Length of the datagram.
+ * @param[in] recv_time Time at which the datagram is received.
+ * @param[in] is_primary_session True if the session is the primary session.
+ *---------------------------------------------------------------------------*/ 
+void
+rtcp_event_handler_internal_deliver_pak (rtp_session_t *rtp_session,
+                                         struct in_addr pak_src_addr,
+                                         uint16_t pak_src_port,
+                                         char *pak_buff,
+                                         int32_t pak_buff_len,
+                                         struct timeval *recv_time,
+                                         boolean is_primary_session)
+{
+    if ((pak_buff[0] & 0xC0) == 0) {
+        /* NAT packet */
+        if (!is_primary_session) {
+            /* send to the NAT protocol for repair session. */
+            if(!vqec_chan_eject_rtcp_nat_pak(
+                   rtp_repair_session_chanid(
+                       (rtp_repair_recv_t *)rtp_session),
+                   pak_buff, 
+                   pak_buff_len, 
+                   VQEC_CHAN_RTP_SESSION_REPAIR,
+                   pak_src_addr.s_addr,
+                   pak_src_port)) {
+                syslog_print(VQEC_ERROR, 
+                             "Eject of NAT packet failed repair");
+            }
+        } else {
+            /* send to the NAT protocol for primary session. */                 
+            if(!vqec_chan_eject_rtcp_nat_pak(
+                   rtp_era_session_chanid(
+                       (rtp_era_recv_t *)rtp_session),
+                   pak_buff, 
+                   pak_buff_len, 
+                   VQEC_CHAN_RTP_SESSION_PRIMARY,
+                   pak_src_addr.s_addr,
+                   pak_src_port)) {
+                syslog_print(VQEC_ERROR, 
+                             "Eject of NAT packet failed primary");
+            }
+        }
+        return;
+    }
+
+    rtcp_event_handler_internal_process_pak(rtp_session, 
+                                            pak_src_addr,
+                                            pak_src_port,
+                                            pak_buff,
+                                            pak_buff_len,
+                                            recv_time);
+}
+
+
 /**---------------------------------------------------------------------------
  * Front-end RTCP event handler.
  *
@@ -453,46 +520,14 @@ rtcp_event_handler_internal (rtp_session_t *rtp_session,
                                            &pak_src_port);
         if (pak_buff_len < 1) {
             break;
-        } else { 
-            if ((iobuf[0] & 0xC0) == 0) {
-                /* NAT packet */
-                if (!is_primary_session) {
-                    /* send to the NAT protocol for repair session. */
-                    if(!vqec_chan_eject_rtcp_nat_pak(
-                           rtp_repair_session_chanid(
-                               (rtp_repair_recv_t *)rtp_session),
-                           iobuf, 
-                           pak_buff_len, 
-                           VQEC_CHAN_RTP_SESSION_REPAIR,
-                           pak_src_addr.s_addr,
-                           pak_src_port)) {
-                        syslog_print(VQEC_ERROR, 
-                                     "Eject of NAT packet failed repair");
-                    }
-                } else {
-                    /* send to the NAT protocol for primary session. */                 
-                    if(!vqec_chan_eject_rtcp_nat_pak(
-                           rtp_era_session_chanid(
-                               (rtp_era_recv_t *)rtp_session),
-                           iobuf, 
-                           pak_buff_len, 
-                           VQEC_CHAN_RTP_SESSION_PRIMARY,
-                           pak_src_addr.s_addr,
-                           pak_src_port)) {
-                        syslog_print(VQEC_ERROR, 
-                                     "Eject of NAT packet failed primary");
-                    }
-                }
-                continue;
-            }
-            
-            rtcp_event_handler_internal_process_pak(rtp_session, 
-                                                    pak_src_addr,
-                                                    pak_src_port,
-                                                    iobuf,
-                                                    pak_buff_len,
-                                                    &recv_time);
         }
+        rtcp_event_handler_internal_deliver_pak(rtp_session,
+                                                pak_src_addr,
+                                                pak_src_port,
+                                                iobuf,
+                                                pak_buff_len,
+                                                &recv_time,
+                                                is_primary_session);
     }
 
     return;
@@ -609,12 +644,13 @@ vqec_event_t *rtcp_timer_event_create (vqec_rtcp_timer_type to_type,
     vqec_event_t *rtcp_timeout = NULL;
 
     if (p_sess && p_tv && to_type < VQEC_RTCP_LAST_TIMEOUT) {
-        if (!vqec_event_create(&rtcp_timeout, 
-                               VQEC_EVTYPE_TIMER, 
-                               VQEC_EV_ONESHOT, 
-                               s_timeout_cb_array[to_type], 
-                               VQEC_EVDESC_TIMER, 
-                               p_sess) ||
+        if (!vqec_event_create_named(&rtcp_timeout, 
+                                     VQEC_EVTYPE_TIMER, 
+                                     VQEC_EV_ONESHOT, 
+                                     s_timeout_cb_array[to_type], 
+                                     VQEC_EVDESC_TIMER, 
+                                     p_sess,
+                                     s_timeout_cb_name_array[to_type]) ||
             !vqec_event_start (rtcp_timeout, p_tv)) {
 
             vqec_event_destroy(&rtcp_timeout);
@@ -148,6 +148,27 @@ rtcp_event_handler_internal_process_pak (rtp_session_t *rtp_session,
                                          int32_t pak_buff_len,
                                          struct timeval *recv_time);
 
+/**
+ * Deliver one received RTCP datagram to a session: NAT packets are
+ * ejected to the NAT protocol, others are processed as RTCP.
+ *
+ * @param[in] rtp_session Pointer to a repair or primary session.
+ * @param[in] pak_src_addr IP source address of the datagram.
+ * @param[in] pak_src_port UDP source port of the datagram.
+ * @param[in] pak_buff Contents of the datagram.
+ * @param[in] pak_buff_len Length of the datagram.
+ * @param[in] recv_time Time at which the datagram is received.
+ * @param[in] is_primary_session True if the session is the primary session.
+ */
+void
+rtcp_event_handler_internal_deliver_pak(rtp_session_t *rtp_session,
+                                        struct in_addr pak_src_addr,
+                                        uint16_t pak_src_port,
+                                        char *pak_buff,
+                                        int32_t pak_buff_len,
+                                        struct timeval *recv_time,
+                                        boolean is_primary_session);
+
 /**
  * Front-end RTCP event handler.
  *
@@ -527,6 +527,12 @@ vqec_syscfg_set_defaults (vqec_syscfg_t *cfg,
         case VQEC_CFG_STUN_OPTIMIZATION:
             cfg->stun_optimization = VQEC_SYSCFG_DEFAULT_STUN_OPTIMIZATION;
             break;
+        case VQEC_CFG_RTCP_SHARED_SOCKETS:
+            cfg->rtcp_shared_sockets = VQEC_SYSCFG_DEFAULT_RTCP_SHARED_SOCKETS;
+            break;
+        case VQEC_CFG_METRICS_EXPORT_PORT:
+            cfg->metrics_export_port = VQEC_SYSCFG_DEFAULT_METRICS_EXPORT_PORT;
+            break;
 
         case VQEC_CFG_MUST_BE_LAST:
             break;
@@ -863,6 +869,14 @@ vqec_syscfg_dump (const vqec_syscfg_t *v_cfg,
                 CONSOLE_PRINTF("stun_optimization = %s;\n",
                                v_cfg->stun_optimization ? "true" : "false");
                 break;
+            case VQEC_CFG_RTCP_SHARED_SOCKETS:
+                CONSOLE_PRINTF("rtcp_shared_sockets = %s;\n",
+                               v_cfg->rtcp_shared_sockets ? "true" : "false");
+                break;
+            case VQEC_CFG_METRICS_EXPORT_PORT:
+                CONSOLE_PRINTF("metrics_export_port = %d;\n",
+                               v_cfg->metrics_export_port);
+                break;
 
             case VQEC_CFG_MUST_BE_LAST:
                 break;
@@ -2198,6 +2212,39 @@ vqec_syscfg_load (vqec_syscfg_t *cfg,
             }
             break;
 
+        case VQEC_CFG_RTCP_SHARED_SOCKETS:
+            if (vqec_config_setting_type(setting) == VQEC_CONFIG_SETTING_TYPE_BOOLEAN) {
+                cfg->rtcp_shared_sockets = vqec_config_setting_get_bool(setting);
+            } else {
+                if (log_nonfatal_messages) {
+                    snprintf(debug_str, DEBUG_STR_LEN,
+                             "invalid boolean value for \"%s\"",
+                             "rtcp_shared_sockets");
+                    syslog_print(VQEC_SYSCFG_PARAM_INVALID, debug_str);
+                }
+                param_err = VQEC_ERR_PARAMRANGEINVALID;
+            }
+            break;
+
+        case VQEC_CFG_METRICS_EXPORT_PORT:
+            temp_int = vqec_config_setting_get_int(setting);
+            if (is_vqec_cfg_metrics_export_port_valid(temp_int)) {
+                cfg->metrics_export_port = (uint16_t)temp_int;
+            } else {
+                if (log_nonfatal_messages) {
+                    snprintf(debug_str, DEBUG_STR_LEN,
+                             "Invalid %s value (%d)\n "
+                             " Valid range: %d - %d or 0\n",
+                             "metrics_export_port",
+                             temp_int,
+                             VQEC_SYSCFG_MIN_R1_METRICS_EXPORT_PORT,
+                             VQEC_SYSCFG_MAX_R1_METRICS_EXPORT_PORT);
+                    syslog_print(VQEC_SYSCFG_PARAM_INVALID, debug_str);
+                }
+                param_err = VQEC_ERR_PARAMRANGEINVALID;
+            }
+            break;
+
         case VQEC_CFG_MUST_BE_LAST:
             param_err = VQEC_ERR_PARAMRANGEINVALID;
             break;
@@ -3277,6 +3324,12 @@ vqec_syscfg_set (vqec_syscfg_t *cfg, boolean update)
         case VQEC_CFG_STUN_OPTIMIZATION:
             s_cfg.stun_optimization = cfg->stun_optimization;
             break;
+        case VQEC_CFG_RTCP_SHARED_SOCKETS:
+            s_cfg.rtcp_shared_sockets = cfg->rtcp_shared_sockets;
+            break;
+        case VQEC_CFG_METRICS_EXPORT_PORT:
+            s_cfg.metrics_export_port = cfg->metrics_export_port;
+            break;
         case VQEC_CFG_MUST_BE_LAST:
             break;
         }
@@ -249,6 +249,14 @@ typedef struct vqec_syscfg_ {
                                            * FALSE to force stun signaling for each
                                            * channel change, event not behind nat. 
                                            */
+    boolean rtcp_shared_sockets;          /*
+                                           * TRUE to share unicast RTCP
+                                           * receive sockets between channels
+                                           */
+    uint16_t metrics_export_port;         /*
+                                           * loopback TCP port of the metrics
+                                           * exporter, 0 if disabled
+                                           */
 
 } vqec_syscfg_t;
 
@@ -365,6 +365,13 @@ vqec_upcall_chan_event (vqec_chan_t *chan,
             vqec_chan_upcall_prim_inactive_event(chan);
         }
 
+        if (VQEC_DP_UPCALL_REASON_ISSET(
+                irq_resp->irq_reason_code,
+                VQEC_DP_UPCALL_REASON_CHAN_GAP_AGED)) {
+            /* gaps have aged and are eligible for error repair */
+            vqec_chan_upcall_gap_aged_event(chan);
+        }
+
         break;
 
     default:
@@ -860,6 +867,7 @@ vqec_upcall_event_pak_eject (const vqec_event_t * const ev,
  * @param[in] un_sock_path Pathname for the named socket.
  * @param[in] desc Upcall socket data descriptor.
  * @param[in] handler Socket event handler.
+ * @param[in] handler_name Name under which the socket event is profiled.
  * @param[out] vqec_error_t Returns VQEC_OK on success.
  *---------------------------------------------------------------------------*/ 
 typedef void (*upcall_evt_handler)(const vqec_event_t * const, int32_t, 
@@ -868,7 +876,8 @@ typedef void (*upcall_evt_handler)(const vqec_event_t * const, int32_t,
 static vqec_error_t
 vqec_setup_upc_socket (char *un_sock_path, 
                        struct vqec_upcall_sock_desc *desc,
-                       upcall_evt_handler handler)
+                       upcall_evt_handler handler,
+                       const char *handler_name)
 {
     struct sockaddr_un *name;
     size_t len;
@@ -892,9 +901,9 @@ vqec_setup_upc_socket (char *un_sock_path,
     }
 
     /* Add a socket to libevent. */
-    if ((!vqec_event_create(&desc->ev, VQEC_EVTYPE_FD,
-                            VQEC_EV_READ | VQEC_EV_RECURRING,
-                            handler, desc->fd, NULL)) ||
+    if ((!vqec_event_create_named(&desc->ev, VQEC_EVTYPE_FD,
+                                  VQEC_EV_READ | VQEC_EV_RECURRING,
+                                  handler, desc->fd, NULL, handler_name)) ||
         (!vqec_event_start(desc->ev, NULL))) {
         
         if (desc->ev) {
@@ -950,7 +959,8 @@ vqec_upcall_setup_irqsock (void)
     }
         
     /* establish IRQ socket. */
-    err = vqec_setup_upc_socket(name, desc, vqec_upcall_event_irq);
+    err = vqec_setup_upc_socket(name, desc, vqec_upcall_event_irq,
+                                "vqec_upcall_event_irq");
     if (err != VQEC_OK) {
         goto done;
     }
@@ -1011,7 +1021,8 @@ vqec_upcall_setup_pak_ejectsock (uint32_t max_paksize)
     }
     
     /* establish packet eject socket. */
-    err = vqec_setup_upc_socket(name, desc, vqec_upcall_event_pak_eject);
+    err = vqec_setup_upc_socket(name, desc, vqec_upcall_event_pak_eject,
+                                "vqec_upcall_event_pak_eject");
     if (err != VQEC_OK) {
         goto done;
     }
@@ -52,6 +52,13 @@ static boolean vqec_updater_update_request_issued = FALSE;
                                           */
 static pthread_t vqec_updater_thread_id;
 
+/*
+ * Connection to the VCDS, kept open across the index, attribute and
+ * channel fetches of an update, and the request of the current fetch.
+ */
+static rtsp_conn_t vqec_updater_conn;
+static rtsp_request_t vqec_updater_request;
+
 
 #define vqec_updater_polling_enabled() \
     (vqec_syscfg_get_ptr()->update_interval_max)
@@ -381,7 +388,7 @@ vqec_updater_build_rtsp_obj_str (const char *resource_name,
 UT_STATIC boolean
 fetch_index_cb (boolean arg)
 {
-    char *buffer = rtsp_get_response_body();
+    char *buffer = rtsp_request_get_response_body(&vqec_updater_request);
     char line_buffer[MAX_LINE_LENGTH+1];
     char *resource_name = NULL, *resource_version = NULL, *saveptr = NULL;
     boolean success = TRUE;
@@ -435,6 +442,12 @@ fetch_index_cb (boolean arg)
         }
     }
 
+    /* Remember which index this is, for a conditional request next time */
+    if (vqe_MD5ComputeChecksumStr(buffer, FALSE,
+                                  vqec_updater.last_index_request.index_version)) {
+        vqec_updater.last_index_request.index_version[0] = '\0';
+    }
+
     return (success);
 }
 
@@ -442,7 +455,7 @@ fetch_index_cb (boolean arg)
  * Processes an update to the attribute configuration file.
  *
  * If 'erase' is FALSE, then the updated file is accessible in a buffer
- * referenced by the rtsp_get_response_body() API.
+ * referenced by the rtsp_request_get_response_body() API.
  * If 'erase' is TRUE, then the file is to be erased.
  *
  * Attribute configurations are always written to a file--
@@ -456,7 +469,7 @@ fetch_index_cb (boolean arg)
 UT_STATIC boolean
 vqec_updater_update_attrcfg (boolean erase)
 {
-    char *buffer = rtsp_get_response_body();
+    char *buffer = rtsp_request_get_response_body(&vqec_updater_request);
     boolean success = TRUE;
     boolean lock_acquired;
     int err;
@@ -561,7 +574,7 @@ done:
  * Processes an update to the channel configuration file.
  *
  * If 'erase' is FALSE, then the updated file is accessible in a buffer
- * referenced by the rtsp_get_response_body() API.
+ * referenced by the rtsp_request_get_response_body() API.
  * If 'erase' is TRUE, then the file is to be erased.
  *
  * Channel configurations are validated and committed upon receipt--
@@ -587,7 +600,7 @@ vqec_updater_update_chancfg (boolean erase)
     vqec_error_t status;
     char log_str[VQEC_LOGMSG_BUFSIZE];
 
-    buffer = rtsp_get_response_body();
+    buffer = rtsp_request_get_response_body(&vqec_updater_request);
     if (!buffer || erase) {
         buffer = "";
     }
@@ -679,6 +692,7 @@ vqec_updater_update_chancfg (boolean erase)
         cfg_error = CFG_FAILURE;
     } else {
         cfg_error = cfg_commit_update();
+        vqec_chan_flush_url_index();
     }
     if (lock_acquired) {
         vqec_lock_unlock(vqec_g_lock);
@@ -736,6 +750,23 @@ done:
     return (success);
 }
 
+/*
+ * Returns the version of a resource VQE-C has, to be sent with a request
+ * for the resource so that the VCDS need not send it if it is unchanged.
+ *
+ * @param[in]  version     - MD5 checksum string recorded for the resource
+ * @param[out] const char* - the version, or NULL if VQE-C has no valid
+ *                           version of the resource
+ */
+static const char *
+vqec_updater_cached_version (const char *version)
+{
+    if (strlen(version) != (MD5_CHECKSUM_STRLEN - 1)) {
+        return (NULL);
+    }
+    return (version);
+}
+
 /*
  * Fetches and processes a resource from a VCDS. 
  * 
@@ -743,6 +774,9 @@ done:
  *                                  (excludes CNAME)
  * @param[in]  use_cname         - TRUE if CNAME should be used in RTSP URL
  * @param[in]  accept_media_type - media type to accept in RTSP header
+ * @param[in]  version           - [optional] MD5 checksum of the version of
+ *                                  the resource VQE-C has; the VCDS need not
+ *                                  send the resource if it is unchanged
  * @param[in]  update_abort_time - time after which update should be aborted
  * @param[out] response_time     - [optional] amount of time it took to 
  *                                  receive the complete VCDS response
@@ -755,6 +789,7 @@ vqec_updater_result_err_t
 vqec_updater_fetch_resource (const char *resource_name,
                              boolean use_cname,
                              const char *accept_media_type,
+                             const char *version,
                              abs_time_t update_abort_time,
                              rel_time_t *response_time,
                              boolean (*fetch_resource_cb)(boolean arg))
@@ -766,6 +801,7 @@ vqec_updater_fetch_resource (const char *resource_name,
     remote_server_t *rtsp_server = NULL; 
     remote_server_t **server_list = NULL;
     int i, total_servers = 1, rtsp_server_response_code;
+    boolean reused;
     remote_server_t specific_rtsp_server;
     struct in_addr addr;
     abs_time_t response_time_start;
@@ -926,25 +962,32 @@ vqec_updater_fetch_resource (const char *resource_name,
         }
 
         /*
-         * Create a RTSP client, opening the TCP connection to a VCDS
+         * Open a TCP connection to the VCDS, unless one is still open
+         * from an earlier fetch of this update.
          * If this fails, move on to the next VCDS.
          */
         strncpy(vqec_updater.last_index_request.vcds_addr,
                 server_list[i]->addr, MAX_DOMAIN_NAME_LENGTH);
         vqec_updater.last_index_request.vcds_port = server_list[i]->port;
-        VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-                   "vqec_updater_fetch_resource:: "
-                   "Contacting the RTSP server %s port %d ...\n",
-                   vqec_updater.last_index_request.vcds_addr,
-                   server_list[i]->port);
-        err_rtsp = rtsp_client_init(vqec_updater.last_index_request.vcds_addr,
-                                    server_list[i]->port);
-        if (err_rtsp != RTSP_SUCCESS) {
+        reused = rtsp_conn_is_open(&vqec_updater_conn,
+                                   vqec_updater.last_index_request.vcds_addr,
+                                   server_list[i]->port);
+        if (!reused) {
             VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-                       "vqec_updater_fetch_resource:: Failed to "
-                       "connect the RTSP server %s\n",
-                       vqec_updater.last_index_request.vcds_addr);
-            continue;
+                       "vqec_updater_fetch_resource:: "
+                       "Contacting the RTSP server %s port %d ...\n",
+                       vqec_updater.last_index_request.vcds_addr,
+                       server_list[i]->port);
+            err_rtsp = rtsp_conn_open(&vqec_updater_conn,
+                                      vqec_updater.last_index_request.vcds_addr,
+                                      server_list[i]->port);
+            if (err_rtsp != RTSP_SUCCESS) {
+                VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+                           "vqec_updater_fetch_resource:: Failed to "
+                           "connect the RTSP server %s\n",
+                           vqec_updater.last_index_request.vcds_addr);
+                continue;
+            }
         }
 
         /*
@@ -956,18 +999,55 @@ vqec_updater_fetch_resource (const char *resource_name,
         if (TIME_CMP_A(gt, response_time_start, update_abort_time)) {
             VQEC_LOG_ERROR("vqec_updater_fetch_resource:: Timeout while "
                            "getting the configuration data\n");
-            rtsp_client_close();
+            rtsp_conn_close(&vqec_updater_conn);
             break;
         }
         err_rtsp = 
-            rtsp_send_request(
+            rtsp_request_start(
+                &vqec_updater_request, &vqec_updater_conn,
                 vqec_updater_build_rtsp_obj_str(resource_name, use_cname),
-                accept_media_type,
-                update_abort_time);
-        if (err_rtsp != RTSP_SUCCESS) {
+                accept_media_type, version);
+        if (err_rtsp == RTSP_SUCCESS) {
+            err_rtsp = rtsp_request_wait(&vqec_updater_request,
+                                         update_abort_time);
+        }
+        if (err_rtsp != RTSP_SUCCESS && reused &&
+            TIME_CMP_A(lt, get_sys_time(), update_abort_time)) {
+            /*
+             * The VCDS may have closed the connection while it was idle:
+             * try once more on a new one.
+             */
+            VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+                       "vqec_updater_fetch_resource:: Reconnecting to "
+                       "the RTSP server %s\n",
+                       vqec_updater.last_index_request.vcds_addr);
+            err_rtsp = rtsp_conn_open(&vqec_updater_conn,
+                                      vqec_updater.last_index_request.vcds_addr,
+                                      server_list[i]->port);
+            if (err_rtsp == RTSP_SUCCESS) {
+                err_rtsp = 
+                    rtsp_request_start(
+                        &vqec_updater_request, &vqec_updater_conn,
+                        vqec_updater_build_rtsp_obj_str(resource_name,
+                                                        use_cname),
+                        accept_media_type, version);
+            }
+            if (err_rtsp == RTSP_SUCCESS) {
+                err_rtsp = rtsp_request_wait(&vqec_updater_request,
+                                             update_abort_time);
+            }
+        }
+        if (err_rtsp == RTSP_CONNECT_ERR) {
+            VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+                       "vqec_updater_fetch_resource:: Failed to "
+                       "connect the RTSP server %s\n",
+                       vqec_updater.last_index_request.vcds_addr);
+            rtsp_conn_close(&vqec_updater_conn);
+            continue;
+        } else if (err_rtsp != RTSP_SUCCESS) {
             VQEC_LOG_ERROR("vqec_updater_fetch_resource:: Failed to "
                            "get the configuration data\n");
-            rtsp_client_close();
+            rtsp_conn_close(&vqec_updater_conn);
             continue;
         }
         if (response_time) {
@@ -977,14 +1057,16 @@ vqec_updater_fetch_resource (const char *resource_name,
         /*
          * Response received:  parse and validate the response body
          */
-        rtsp_server_response_version = rtsp_get_response_server();
+        rtsp_server_response_version =
+            rtsp_request_get_response_server(&vqec_updater_request);
         if (rtsp_server_response_version) {
             strncpy(server_version,
                     rtsp_server_response_version,
                     VQEC_UPDATER_SERVER_VERSION_LEN);
             server_version[VQEC_UPDATER_SERVER_VERSION_LEN - 1] = '\0';
         }
-        rtsp_server_response_code = rtsp_get_response_code();
+        rtsp_server_response_code =
+            rtsp_request_get_response_code(&vqec_updater_request);
         VQEC_DEBUG(VQEC_DEBUG_UPDATER,
                    "vqec_updater_fetch_resource:: Received response code %d "
                    "for RTSP DESCRIBE from the RTSP server %s\n",
@@ -993,7 +1075,7 @@ vqec_updater_fetch_resource (const char *resource_name,
         if (!strcmp(resource_name, VQEC_UPDATER_RESOURCE_NAME_INDEX) &&
             ((rtsp_server_response_code == MSG_404_NOT_FOUND) ||
              (rtsp_server_response_code == MSG_415_UNSUPPORTED_MEDIA_TYPE)) &&
-            !rtsp_get_response_server()) {
+            !rtsp_server_response_version) {
             /*
              * VCDS neither supplied an index file nor identified its version.
              * From this we assume index files are not supported
@@ -1001,6 +1083,20 @@ vqec_updater_fetch_resource (const char *resource_name,
              * retrieving only the channel lineup without using a CNAME.
              */
             err = VQEC_UPDATER_RESULT_ERR_VCDS_REPLY_OLDVERSION;
+        } else if (rtsp_server_response_code == MSG_304_NOT_MODIFIED &&
+                   version) {
+            /*
+             * The VCDS still has the version VQE-C has.  For the index,
+             * the versions recorded from it remain current.
+             */
+            VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+                       "vqec_updater_fetch_resource:: \"%s\" is "
+                       "unchanged\n", resource_name);
+            if (!strcmp(resource_name, VQEC_UPDATER_RESOURCE_NAME_INDEX)) {
+                err = VQEC_UPDATER_RESULT_ERR_OK;
+            } else {
+                err = VQEC_UPDATER_RESULT_ERR_UNNECESSARY;
+            }
         } else if (rtsp_server_response_code == MSG_200_OK) {
             if ((*fetch_resource_cb)(FALSE)) {
                 err = VQEC_UPDATER_RESULT_ERR_OK;
@@ -1016,8 +1112,8 @@ vqec_updater_fetch_resource (const char *resource_name,
             err = VQEC_UPDATER_RESULT_ERR_VCDS_REPLY_UNEXPECTED;
         }
 
-        /* Close the RTSP connection */
-        rtsp_client_close();
+        /* The connection is left open for the next fetch of the update */
+        rtsp_request_free(&vqec_updater_request);
         break;
 
     }
@@ -1098,7 +1194,10 @@ vqec_updater_request_update (boolean update_index,
         vqec_updater.last_index_request.result =
             vqec_updater_fetch_resource(
                 VQEC_UPDATER_RESOURCE_NAME_INDEX, TRUE,
-                MEDIA_TYPE_APP_PLAIN_TEXT, update_abort_time,
+                MEDIA_TYPE_APP_PLAIN_TEXT,
+                vqec_updater_cached_version(
+                    vqec_updater.last_index_request.index_version),
+                update_abort_time,
                 NULL, fetch_index_cb);
         vqec_updater.total_update_attempts++;
         if (vqec_updater_result_is_failure(
@@ -1170,7 +1269,10 @@ vqec_updater_request_update (boolean update_index,
                 vqec_updater.attrcfg.last_update_result =
                     vqec_updater_fetch_resource(
                         VQEC_UPDATER_RESOURCE_NAME_NETCFG, TRUE,
-                        MEDIA_TYPE_APP_PLAIN_TEXT, update_abort_time,
+                        MEDIA_TYPE_APP_PLAIN_TEXT,
+                        vqec_updater_cached_version(
+                            vqec_updater.attrcfg.vqec_version),
+                        update_abort_time,
                         &vqec_updater.attrcfg.last_response_time,
                         vqec_updater_update_attrcfg);
             }
@@ -1196,7 +1298,7 @@ vqec_updater_request_update (boolean update_index,
             vqec_updater.chancfg.last_update_result =
                 vqec_updater_fetch_resource(
                     VQEC_UPDATER_RESOURCE_NAME_CHANCFG, FALSE,
-                    MEDIA_TYPE_APP_SDP, update_abort_time,
+                    MEDIA_TYPE_APP_SDP, NULL, update_abort_time,
                     &vqec_updater.chancfg.last_response_time,
                     vqec_updater_update_chancfg);
             vqec_updater.chancfg.total_update_attempts++;
@@ -1225,7 +1327,10 @@ vqec_updater_request_update (boolean update_index,
                 vqec_updater.chancfg.last_update_result =
                     vqec_updater_fetch_resource(
                         VQEC_UPDATER_RESOURCE_NAME_CHANCFG, TRUE,
-                        MEDIA_TYPE_APP_SDP, update_abort_time,
+                        MEDIA_TYPE_APP_SDP,
+                        vqec_updater_cached_version(
+                            vqec_updater.chancfg.vqec_version),
+                        update_abort_time,
                         &vqec_updater.chancfg.last_response_time,
                         vqec_updater_update_chancfg);
             }
@@ -1237,6 +1342,8 @@ vqec_updater_request_update (boolean update_index,
         }
     }
 done:
+    /* The connection is only shared by the fetches of one update */
+    rtsp_conn_close(&vqec_updater_conn);
     return;
 }
 
@@ -1619,6 +1726,8 @@ vqec_updater_init (vqec_syscfg_t *syscfg)
     }
 
     memset(&vqec_updater, 0, sizeof(vqec_updater));
+    rtsp_conn_init(&vqec_updater_conn);
+    rtsp_request_init(&vqec_updater_request);
 
     /*
      * Top-level updater field initialization
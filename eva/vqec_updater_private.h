@@ -198,6 +198,14 @@ typedef struct vqec_updater_mgr_ {
         vqec_updater_result_err_t result;/*
                                           * Result of last index file request
                                           */
+        char index_version[MD5_CHECKSUM_STRLEN];
+                                         /*
+                                          * MD5 checksum of the last index
+                                          * file received, or empty string.
+                                          * Sent with the next index request
+                                          * so that an unchanged index need
+                                          * not be sent again.
+                                          */
         char server_version[VQEC_UPDATER_SERVER_VERSION_LEN];
                                          /*
                                           * Version string of last contacted 
@@ -1296,3 +1296,82 @@ void test_rtcp_xr_late_arrival(void)
     CU_ASSERT_EQUAL(1, xr_stats.lost_packets);
     CU_ASSERT_EQUAL(0, xr_stats.dup_packets);
 }
+
+static rtcp_xr_map_t xr_map;
+
+void test_rtcp_xr_map(void)
+{
+    rtcp_xr_stats_t xr_stats, xr_map_stats;
+    uint32_t start_seq = 65000;
+    uint32_t eseq;
+    uint16_t max_size = 1400;
+    int i;
+    int totals = 1000;
+
+    memset(&xr_stats, 0, sizeof(xr_stats));
+    memset(&xr_map_stats, 0, sizeof(xr_map_stats));
+    rtcp_xr_set_size(&xr_stats, max_size);
+    rtcp_xr_set_size(&xr_map_stats, max_size);
+    rtcp_xr_map_attach(&xr_map_stats, &xr_map);
+    CU_ASSERT_PTR_EQUAL(&xr_map, xr_map_stats.map);
+
+    /* Losses, duplicates and a gap: the chunks are the same */
+    rtcp_xr_init_seq(&xr_stats, start_seq, FALSE);
+    rtcp_xr_init_seq(&xr_map_stats, start_seq, FALSE);
+    for (i = 0; i < totals; i++) {
+        if (i % 7 == 3 || (i >= 400 && i < 520)) {
+            continue;
+        }
+        eseq = start_seq + i;
+        rtcp_xr_update_seq(&xr_stats, eseq);
+        rtcp_xr_update_seq(&xr_map_stats, eseq);
+        if (i % 11 == 0) {
+            rtcp_xr_update_seq(&xr_stats, eseq);
+            rtcp_xr_update_seq(&xr_map_stats, eseq);
+        }
+    }
+    rtcp_xr_update_seq(&xr_stats, start_seq - 1);
+    rtcp_xr_update_seq(&xr_map_stats, start_seq - 1);
+
+    rtcp_xr_map_encode(&xr_map_stats);
+    CU_ASSERT_EQUAL(xr_stats.totals, xr_map_stats.totals);
+    CU_ASSERT_EQUAL(xr_stats.lost_packets, xr_map_stats.lost_packets);
+    CU_ASSERT_EQUAL(xr_stats.dup_packets, xr_map_stats.dup_packets);
+    CU_ASSERT_EQUAL(xr_stats.late_arrivals, xr_map_stats.late_arrivals);
+    CU_ASSERT_EQUAL(xr_stats.before_intvl, xr_map_stats.before_intvl);
+    CU_ASSERT_EQUAL(xr_stats.cur_chunk_in_use, xr_map_stats.cur_chunk_in_use);
+    CU_ASSERT_EQUAL(xr_stats.bit_idx, xr_map_stats.bit_idx);
+    for (i = 0; i <= xr_stats.cur_chunk_in_use; i++) {
+        CU_ASSERT_EQUAL(xr_stats.chunk[i], xr_map_stats.chunk[i]);
+    }
+
+    /* Encoding again gives the same result */
+    rtcp_xr_map_encode(&xr_map_stats);
+    CU_ASSERT_EQUAL(xr_stats.totals, xr_map_stats.totals);
+    CU_ASSERT_EQUAL(xr_stats.lost_packets, xr_map_stats.lost_packets);
+
+    /* Re-initialization carries the counts over, and clears the map */
+    eseq = start_seq + totals;
+    rtcp_xr_init_seq(&xr_stats, eseq, TRUE);
+    rtcp_xr_init_seq(&xr_map_stats, eseq, TRUE);
+    CU_ASSERT_EQUAL(xr_stats.re_init, xr_map_stats.re_init);
+
+    /* Every other packet, then the late arrivals complete the interval */
+    for (i = 0; i < totals; i += 2) {
+        rtcp_xr_update_seq(&xr_map_stats, eseq + i);
+    }
+    for (i = 1; i < totals; i += 2) {
+        rtcp_xr_update_seq(&xr_map_stats, eseq + i);
+    }
+    rtcp_xr_map_encode(&xr_map_stats);
+    CU_ASSERT_EQUAL(totals, xr_map_stats.totals);
+    CU_ASSERT_EQUAL(0, xr_map_stats.lost_packets);
+    CU_ASSERT_EQUAL(totals/2 - 1, xr_map_stats.late_arrivals);
+    CU_ASSERT_EQUAL(0, xr_map_stats.dup_packets);
+
+    /* 990 1's as one run length, and a bit vector of 10 1's */
+    CU_ASSERT_EQUAL(1, xr_map_stats.cur_chunk_in_use);
+    CU_ASSERT_EQUAL(RUN_LENGTH_FOR_ONE | 990, xr_map_stats.chunk[0]);
+    CU_ASSERT_EQUAL(0xffe0, xr_map_stats.chunk[1]);
+    CU_ASSERT_EQUAL(5, xr_map_stats.bit_idx);
+}
@@ -0,0 +1,212 @@
+/*------------------------------------------------------------------
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *
+ *------------------------------------------------------------------
+ */
+
+/*
+ * rtcp_testxr_bench.c - standalone benchmark for RTCP XR loss RLE.
+ *
+ * For several arrival patterns, this program feeds the same reporting
+ * interval to rtcp_xr_update_seq() with and without a loss map, builds
+ * the chunks from the map with rtcp_xr_map_encode() as a report would,
+ * and checks that both describe the same sequence with the same
+ * counters. The time per packet is reported for both, the map time
+ * including the encode.
+ *
+ * Usage: rtcp_testxr_bench [iterations] [packets-per-interval]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rtcp_xr.h"
+
+#define BENCH_DEFAULT_ITERATIONS  200
+#define BENCH_DEFAULT_PACKETS     20000  /* ~5 s of a 15 Mbps stream */
+#define BENCH_MAX_PACKETS         60000
+#define BENCH_RLE_SIZE            (MAX_CHUNKS * sizeof(uint16_t))
+
+typedef enum bench_pattern_ {
+    BENCH_NO_LOSS,
+    BENCH_RANDOM_LOSS,
+    BENCH_BURST_LOSS,
+    BENCH_REORDER_DUP,
+    BENCH_NUM_PATTERNS
+} bench_pattern_t;
+
+static const char *s_bench_pattern_name[BENCH_NUM_PATTERNS] = {
+    "no loss", "1% random loss", "bursts of 50", "reorder + dup"
+};
+
+static rtcp_xr_map_t s_bench_map;
+static uint8_t s_bench_bits[2][MAX_SEQ_ALLOWED + MAX_BIT_IDX];
+
+static uint64_t
+bench_now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+ * Build the arrival order of one interval of num_pkts sequence numbers.
+ */
+static uint32_t
+bench_make_arrivals (bench_pattern_t pattern, uint32_t base,
+                     uint32_t num_pkts, uint32_t *arrivals)
+{
+    uint32_t i, n = 0, tmp;
+
+    srand(1);
+    for (i = 0; i < num_pkts; i++) {
+        switch (pattern) {
+        case BENCH_RANDOM_LOSS:
+            if (rand() % 100 == 0) {
+                continue;
+            }
+            break;
+        case BENCH_BURST_LOSS:
+            if (i % 1000 >= 950) {
+                continue;
+            }
+            break;
+        default:
+            break;
+        }
+        arrivals[n++] = base + i;
+        if (pattern == BENCH_REORDER_DUP && rand() % 100 == 0) {
+            arrivals[n++] = base + i;
+        }
+    }
+    if (pattern == BENCH_REORDER_DUP) {
+        for (i = 1; i < n; i++) {
+            if (rand() % 20 == 0) {
+                tmp = arrivals[i];
+                arrivals[i] = arrivals[i - 1];
+                arrivals[i - 1] = tmp;
+            }
+        }
+    }
+    return (n);
+}
+
+/*
+ * Expand the chunks into one byte per sequence number.
+ */
+static uint32_t
+bench_decode (rtcp_xr_stats_t *xr_stats, uint8_t *bits)
+{
+    uint32_t n = 0, i, num_chunks, len;
+    uint16_t chunk;
+    int b, last;
+
+    num_chunks = xr_stats->cur_chunk_in_use + 1;
+    if (xr_stats->bit_idx == MAX_BIT_IDX &&
+        xr_stats->chunk[xr_stats->cur_chunk_in_use] == INITIAL_BIT_VECTOR) {
+        num_chunks--;
+    }
+    for (i = 0; i < num_chunks; i++) {
+        chunk = xr_stats->chunk[i];
+        if (chunk & INITIAL_BIT_VECTOR) {
+            last = (i == xr_stats->cur_chunk_in_use) ? xr_stats->bit_idx : 0;
+            for (b = MAX_BIT_IDX - 1; b >= last; b--) {
+                bits[n++] = (chunk >> b) & 1;
+            }
+        } else {
+            for (len = 0; len < (chunk & RUN_LENGTH_MASK); len++) {
+                bits[n++] = (chunk & RUN_LENGTH_FOR_ONE) ? 1 : 0;
+            }
+        }
+    }
+    return (n);
+}
+
+int
+main (int argc, char **argv)
+{
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS, it, i;
+    uint32_t num_pkts = BENCH_DEFAULT_PACKETS, num_arrivals, n0, n1;
+    uint32_t base = 65000, *arrivals;
+    rtcp_xr_stats_t xr[2];
+    uint64_t start, rle_ns, map_ns;
+    bench_pattern_t p;
+    boolean ok = TRUE;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        num_pkts = strtoul(argv[2], NULL, 10);
+    }
+    if (!iterations || !num_pkts || num_pkts > BENCH_MAX_PACKETS) {
+        fprintf(stderr, "usage: %s [iterations] [packets <= %d]\n",
+                argv[0], BENCH_MAX_PACKETS);
+        return (1);
+    }
+
+    arrivals = malloc(2 * num_pkts * sizeof(*arrivals));
+    if (!arrivals) {
+        return (1);
+    }
+
+    printf("RTCP XR loss RLE benchmark: %u packets per interval, "
+           "%u iterations\n", num_pkts, iterations);
+    printf("%-16s %8s %8s %14s %14s\n", "pattern", "chunks", "(map)",
+           "ns/pkt rle", "ns/pkt map");
+
+    for (p = 0; p < BENCH_NUM_PATTERNS; p++) {
+        num_arrivals = bench_make_arrivals(p, base, num_pkts, arrivals);
+
+        memset(xr, 0, sizeof(xr));
+        rtcp_xr_set_size(&xr[0], BENCH_RLE_SIZE);
+        rtcp_xr_set_size(&xr[1], BENCH_RLE_SIZE);
+        rtcp_xr_map_attach(&xr[1], &s_bench_map);
+
+        start = bench_now_ns();
+        for (it = 0; it < iterations; it++) {
+            rtcp_xr_init_seq(&xr[0], base, FALSE);
+            for (i = 0; i < num_arrivals; i++) {
+                rtcp_xr_update_seq(&xr[0], arrivals[i]);
+            }
+        }
+        rle_ns = bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (it = 0; it < iterations; it++) {
+            rtcp_xr_init_seq(&xr[1], base, FALSE);
+            for (i = 0; i < num_arrivals; i++) {
+                rtcp_xr_update_seq(&xr[1], arrivals[i]);
+            }
+            rtcp_xr_map_encode(&xr[1]);
+        }
+        map_ns = bench_now_ns() - start;
+
+        n0 = bench_decode(&xr[0], s_bench_bits[0]);
+        n1 = bench_decode(&xr[1], s_bench_bits[1]);
+        if (xr[0].exceed_limit || xr[1].exceed_limit ||
+            n0 != n1 || n0 != xr[0].totals || n1 != xr[1].totals ||
+            memcmp(s_bench_bits[0], s_bench_bits[1], n0) ||
+            xr[0].lost_packets != xr[1].lost_packets ||
+            xr[0].dup_packets != xr[1].dup_packets ||
+            xr[0].late_arrivals != xr[1].late_arrivals) {
+            printf("%-16s MISMATCH\n", s_bench_pattern_name[p]);
+            ok = FALSE;
+            continue;
+        }
+
+        printf("%-16s %8u %8u %14.2f %14.2f\n",
+               s_bench_pattern_name[p],
+               xr[0].cur_chunk_in_use + 1, xr[1].cur_chunk_in_use + 1,
+               (double)rle_ns / ((double)iterations * num_arrivals),
+               (double)map_ns / ((double)iterations * num_arrivals));
+    }
+
+    free(arrivals);
+    return (ok ? 0 : 1);
+}
@@ -19,7 +19,8 @@
 /*
  * rtcp_xr_set_size
  *
- * This function sets up the maximum chunks to be used.
+ * This function sets up the maximum chunks to be used. Any loss map is
+ * detached.
  *
  * Parameters:  xr_stats        ptr to rtcp_xr_stats info
  *              max_size        maximum bytes used for RLE chunks
@@ -34,6 +35,7 @@ void rtcp_xr_set_size (rtcp_xr_stats_t *xr_stats,
         return;
     }
 
+    xr_stats->map = NULL;
     max_chunks = max_size / sizeof(uint16_t);
     if (max_chunks > MAX_CHUNKS) {
         xr_stats->max_chunks_allow = MAX_CHUNKS;
@@ -43,6 +45,41 @@ void rtcp_xr_set_size (rtcp_xr_stats_t *xr_stats,
 }
 
 
+/*
+ * rtcp_xr_map_span
+ *
+ * Number of sequence numbers from eseq_start up to, but excluding,
+ * next_exp_eseq that are covered by the loss map.
+ *
+ * Parameters:  xr_stats    ptr to rtcp_xr_stats info
+ * Returns:     span, at most RTCP_XR_MAP_BITS
+ */
+static inline uint32_t rtcp_xr_map_span (rtcp_xr_stats_t *xr_stats)
+{
+    uint32_t span = xr_stats->next_exp_eseq - xr_stats->eseq_start;
+
+    if ((int32_t)span <= 0) {
+        return (0);
+    }
+    return (span > RTCP_XR_MAP_BITS ? RTCP_XR_MAP_BITS : span);
+}
+
+/*
+ * rtcp_xr_map_clear
+ *
+ * Clear the words of the loss map used in the current interval.
+ *
+ * Parameters:  xr_stats    ptr to rtcp_xr_stats info, with a map
+ * Returns:     None
+ */
+static void rtcp_xr_map_clear (rtcp_xr_stats_t *xr_stats)
+{
+    uint32_t words = (rtcp_xr_map_span(xr_stats) + 63) / 64;
+
+    memset(xr_stats->map->word, 0, words * sizeof(uint64_t));
+    xr_stats->map->beyond = 0;
+}
+
 /*
  * rtcp_xr_init_seq
  *
@@ -63,6 +100,14 @@ void rtcp_xr_init_seq (rtcp_xr_stats_t *xr_stats,
         return;
     }
 
+    if (xr_stats->map) {
+        /* The counters below are only maintained by the encoder */
+        if (re_init_mode) {
+            rtcp_xr_map_encode(xr_stats);
+        }
+        rtcp_xr_map_clear(xr_stats);
+    }
+
     xr_stats->eseq_start = sequence;
     /* Depend on the condition, re_init counter will be either the total
        counts from previous unreported interval or zero. */
@@ -169,6 +214,58 @@ static void fill_up_zeros (rtcp_xr_stats_t *xr_stats,
 /* Compare two uint32_t numbers and determine which one is ahead or equal */
 #define U32_GTE(a, b) ((int32_t)(a - b) >= 0)
 
+/*
+ * rtcp_xr_map_update_seq
+ *
+ * Record a sequence number in the loss map. Only the counters that
+ * cannot be derived from the map afterwards are updated here.
+ *
+ * Parameters:  xr_stats    ptr to rtcp_xr_stats info, with a map
+ *              eseq        extended sequence number received
+ * Returns:     None
+ */
+static inline void rtcp_xr_map_update_seq (rtcp_xr_stats_t *xr_stats,
+                                           uint32_t eseq)
+{
+    rtcp_xr_map_t *map = xr_stats->map;
+    uint32_t offset = eseq - xr_stats->eseq_start;
+    uint32_t map_end;
+    uint64_t bit;
+
+    if ((int32_t)offset < 0) {
+        xr_stats->before_intvl++;
+        return;
+    }
+
+    if (offset >= RTCP_XR_MAP_BITS) {
+        if (U32_GTE(eseq, xr_stats->next_exp_eseq)) {
+            map_end = xr_stats->eseq_start + RTCP_XR_MAP_BITS;
+            if (U32_GT(map_end, xr_stats->next_exp_eseq)) {
+                map->beyond += eseq - map_end + 1;
+            } else {
+                map->beyond += eseq - xr_stats->next_exp_eseq + 1;
+            }
+            xr_stats->next_exp_eseq = eseq + 1;
+        } else {
+            map->beyond++;
+        }
+        return;
+    }
+
+    bit = 0x8000000000000000ULL >> (offset & 63);
+    if (map->word[offset >> 6] & bit) {
+        xr_stats->dup_packets++;
+        return;
+    }
+    map->word[offset >> 6] |= bit;
+
+    if (U32_GTE(eseq, xr_stats->next_exp_eseq)) {
+        xr_stats->next_exp_eseq = eseq + 1;
+    } else {
+        xr_stats->late_arrivals++;
+    }
+}
+
 /*
  * rtcp_xr_update_seq
  *
@@ -277,6 +374,11 @@ void rtcp_xr_update_seq (rtcp_xr_stats_t *xr_stats,
         return;
     }
 
+    if (xr_stats->map) {
+        rtcp_xr_map_update_seq(xr_stats, eseq);
+        return;
+    }
+
     /* Check whether this is a late arrival for previous reporting intervals */
     if (U32_GT(xr_stats->eseq_start, eseq)) {
         /* If so, increment the counter for before interval by one */
@@ -609,6 +711,180 @@ void rtcp_xr_update_seq (rtcp_xr_stats_t *xr_stats,
 }
 
 
+/*
+ * rtcp_xr_map_attach
+ *
+ * Attach a loss map to rtcp_xr_stats. This must be done after
+ * rtcp_xr_set_size() and before the first rtcp_xr_init_seq() call for
+ * the source, and the map must stay attached until the stats are
+ * discarded.
+ *
+ * Parameters:  xr_stats    ptr to rtcp_xr_stats info
+ *              map         ptr to the loss map
+ * Returns:     None
+ */
+void rtcp_xr_map_attach (rtcp_xr_stats_t *xr_stats,
+                         rtcp_xr_map_t *map)
+{
+    if (xr_stats == NULL || map == NULL) {
+        return;
+    }
+
+    memset(map, 0, sizeof(*map));
+    xr_stats->map = map;
+}
+
+/*
+ * rtcp_xr_map_get15
+ *
+ * Get the 15 bits of the loss map starting at offset, with the bit
+ * for offset as bit 14, as in an RLE bit vector.
+ *
+ * Parameters:  word        loss map words
+ *              offset      offset of the first bit; offset + 15 must
+ *                          not exceed RTCP_XR_MAP_BITS
+ * Returns:     bits
+ */
+static inline uint16_t rtcp_xr_map_get15 (const uint64_t *word,
+                                          uint32_t offset)
+{
+    uint32_t i = offset >> 6, shift = offset & 63;
+    uint64_t v = word[i] << shift;
+
+    if (shift > 64 - MAX_BIT_IDX) {
+        v |= word[i + 1] >> (64 - shift);
+    }
+    return ((uint16_t)(v >> (64 - MAX_BIT_IDX)));
+}
+
+/*
+ * rtcp_xr_popcount15
+ *
+ * Number of bits set in a 15-bit value.
+ */
+static inline uint16_t rtcp_xr_popcount15 (uint16_t v)
+{
+    v = v - ((v >> 1) & 0x5555);
+    v = (v & 0x3333) + ((v >> 2) & 0x3333);
+    v = (v + (v >> 4)) & 0x0f0f;
+    return ((v + (v >> 8)) & 0x1f);
+}
+
+/*
+ * rtcp_xr_map_encode
+ *
+ * Build the RLE chunks of the current interval from the loss map, and
+ * set totals, lost_packets, not_reported and exceed_limit accordingly.
+ * The map is not modified, so the function may be called any number of
+ * times during an interval. It does nothing if no map is attached.
+ *
+ * The map is read 15 sequence numbers at a time: a group of all 1's
+ * extends a preceding run length of 1's, a group of all 0's extends a
+ * preceding run length of 0's (both up to MAX_RUN_LENGTH), and any
+ * other group, as well as the last, partial group, becomes a bit
+ * vector. The chunks describe the same sequence as those built by
+ * rtcp_xr_update_seq() without a map, but may differ from them where
+ * late arrivals have filled in a bit vector, which is reported here as
+ * part of a run length. Once the limits are exceeded, late and
+ * duplicate arrivals past the reported interval are still counted as
+ * such rather than as not reported.
+ *
+ * Parameters:  xr_stats    ptr to rtcp_xr_stats info
+ * Returns:     None
+ */
+void rtcp_xr_map_encode (rtcp_xr_stats_t *xr_stats)
+{
+    rtcp_xr_map_t *map;
+    uint32_t span, limit, offset, len;
+    uint32_t covered = 0, received = 0;
+    uint16_t max_chunks, num_chunks = 0;
+    uint16_t bits, chunk, prev, num_rcvd;
+    boolean exceed;
+
+    if (xr_stats == NULL || (map = xr_stats->map) == NULL) {
+        return;
+    }
+
+    span = xr_stats->next_exp_eseq - xr_stats->eseq_start;
+    if ((int32_t)span < 0) {
+        span = 0;
+    }
+    limit = (span > MAX_SEQ_ALLOWED) ? MAX_SEQ_ALLOWED : span;
+    max_chunks = xr_stats->max_chunks_allow;
+    exceed = (span >= MAX_SEQ_ALLOWED);
+
+    for (offset = 0; offset < limit; offset += len) {
+        len = limit - offset;
+        if (len > MAX_BIT_IDX) {
+            len = MAX_BIT_IDX;
+        }
+        bits = rtcp_xr_map_get15(map->word, offset) &
+            (0x7fff & (0x7fff << (MAX_BIT_IDX - len)));
+        prev = num_chunks ?
+            xr_stats->chunk[num_chunks - 1] : INITIAL_BIT_VECTOR;
+
+        if (len == MAX_BIT_IDX && bits == 0x7fff) {
+            if ((prev & RUN_LENGTH_FOR_ONE_MASK) == RUN_LENGTH_FOR_ONE &&
+                (prev & RUN_LENGTH_MASK) < MAX_RUN_LENGTH) {
+                xr_stats->chunk[num_chunks - 1] += MAX_BIT_IDX;
+                covered += MAX_BIT_IDX;
+                received += MAX_BIT_IDX;
+                continue;
+            }
+            chunk = RUN_LENGTH_FOR_ONE | MAX_BIT_IDX;
+            num_rcvd = MAX_BIT_IDX;
+        } else if (len == MAX_BIT_IDX && bits == 0) {
+            if ((prev & RUN_LENGTH_FOR_ONE_MASK) == 0 &&
+                (prev & RUN_LENGTH_MASK) < MAX_RUN_LENGTH) {
+                xr_stats->chunk[num_chunks - 1] += MAX_BIT_IDX;
+                covered += MAX_BIT_IDX;
+                continue;
+            }
+            chunk = MAX_BIT_IDX;
+            num_rcvd = 0;
+        } else {
+            chunk = INITIAL_BIT_VECTOR | bits;
+            num_rcvd = rtcp_xr_popcount15(bits);
+        }
+
+        if (num_chunks == max_chunks) {
+            exceed = TRUE;
+            break;
+        }
+        xr_stats->chunk[num_chunks++] = chunk;
+        covered += len;
+        received += num_rcvd;
+    }
+
+    /* As without a map, the limit is also reached when no chunk is left */
+    if (!(covered % MAX_BIT_IDX) && num_chunks && num_chunks == max_chunks) {
+        exceed = TRUE;
+    }
+
+    xr_stats->totals = covered;
+    xr_stats->lost_packets = covered - received;
+    xr_stats->not_reported = (span > RTCP_XR_MAP_BITS ?
+                              RTCP_XR_MAP_BITS : span) - covered + map->beyond;
+    xr_stats->exceed_limit = exceed;
+
+    /*
+     * Leave cur_chunk_in_use and bit_idx as rtcp_xr_update_seq() does:
+     * the current chunk is an empty bit vector if the last group is
+     * complete, unless the limit has been reached.
+     */
+    if (exceed) {
+        xr_stats->cur_chunk_in_use = num_chunks ? num_chunks - 1 : 0;
+        xr_stats->bit_idx = 0;
+    } else if (!(covered % MAX_BIT_IDX)) {
+        xr_stats->chunk[num_chunks] = INITIAL_BIT_VECTOR;
+        xr_stats->cur_chunk_in_use = num_chunks;
+        xr_stats->bit_idx = MAX_BIT_IDX;
+    } else {
+        xr_stats->cur_chunk_in_use = num_chunks - 1;
+        xr_stats->bit_idx = MAX_BIT_IDX - (covered % MAX_BIT_IDX);
+    }
+}
+
 /*
  * rtcp_xr_update_jitter
  *
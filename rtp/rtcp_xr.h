@@ -35,6 +35,24 @@
 #define RUN_LENGTH_MASK 0x3fff
 #define RUN_LENGTH_FOR_ONE_MASK 0xC000
 
+/*
+ * RTCP XR loss map
+ *
+ * Optional accumulator for rtcp_xr_stats_t. When a map is attached, the
+ * per-packet update only records the arrival of the sequence number as a
+ * bit in an array of 64-bit words (plus the duplicate, late arrival and
+ * before interval counters); the RLE chunks, totals, lost_packets and
+ * not_reported are only built by rtcp_xr_map_encode() when a report is
+ * about to be constructed. Bit 63 of word 0 stands for eseq_start.
+ */
+#define RTCP_XR_MAP_BITS 65536
+#define RTCP_XR_MAP_WORDS (RTCP_XR_MAP_BITS / 64)
+
+typedef struct rtcp_xr_map_t_ {
+    uint32_t beyond;                      /* seq. numbers past the map */
+    uint64_t word[RTCP_XR_MAP_WORDS];     /* arrival bits */
+} rtcp_xr_map_t;
+
 #pragma pack(4)
 
 typedef struct rtcp_xr_stats_t_ {
@@ -64,6 +82,9 @@ typedef struct rtcp_xr_stats_t_ {
     uint16_t max_chunks_allow; /* maximum number of chunks allowed to use */
     uint8_t  bit_idx;          /* index for last bit being used in current
                                   chunk */
+    rtcp_xr_map_t *map;        /* loss map, if attached; the chunks and
+                                  the loss counters are then only valid
+                                  after rtcp_xr_map_encode() */
 } rtcp_xr_stats_t;
 
 /*
@@ -252,6 +273,11 @@ extern void rtcp_xr_init_seq(rtcp_xr_stats_t *xr_stats,
 extern void rtcp_xr_update_seq(rtcp_xr_stats_t *xr_stats,
                                uint32_t eseq);
 
+extern void rtcp_xr_map_attach(rtcp_xr_stats_t *xr_stats,
+                               rtcp_xr_map_t *map);
+
+extern void rtcp_xr_map_encode(rtcp_xr_stats_t *xr_stats);
+
 extern void rtcp_xr_update_jitter(rtcp_xr_stats_t *xr_stats,
                                   uint32_t jitter);
 
@@ -14,6 +14,7 @@
 
 #include <stdio.h>
 #include "rtp_asm.h"
+#include "rtp_database.h"
 
 /*
  * Extern the global instantiation of the memory mgr object.
@@ -132,6 +133,11 @@ boolean rtp_create_session_asm (rtp_config_t *p_config,
        return FALSE;
      }     
 
+     /* Index members by SSRC */
+     rtp_member_hash_init((rtp_session_t *)*pp_asm_sess,
+                          (*pp_asm_sess)->member_hash_buckets,
+                          RTP_ASM_HASH_SIZE);
+
      /* Set the methods table */
      (*pp_asm_sess)->__func_table = &rtp_asm_methods_table;
 
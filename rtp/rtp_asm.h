@@ -41,8 +41,14 @@
      * type 
      */
   
+/*
+ * Number of buckets in the SSRC hash index of members.
+ */
+#define RTP_ASM_HASH_SIZE   127
+
 #define RTP_ASM_INFO        \
-    RTP_SESSION_INFO        
+    RTP_SESSION_INFO        \
+    rtp_member_hash_t member_hash_buckets[RTP_ASM_HASH_SIZE];
     /* Insert any session fields here that are unique to the 
      * ASM session type */
     /* Calling this "info" instead of "members"; the RTP term "members" 
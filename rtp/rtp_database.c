@@ -104,6 +104,77 @@ static int rtp_cmp_member (rtp_member_t *m1, rtp_member_t *m2)
 VQE_RBP_GENERATE(rtp_member_tree_t_, rtp_member_t_, member_entry, rtp_cmp_member);
 /*sa_ignore */
 
+/*
+ * rtp_member_hash_init
+ *
+ * Index the members of a session by SSRC, as well as by SSRC+CNAME:
+ * lookups by SSRC then take a hash bucket scan instead of a tree search.
+ * Members already in the session are added to the index.
+ *
+ * Parameters:
+ * sess                --ptr to session data
+ * buckets             --hash buckets, which must remain valid for the
+ *                       lifetime of the session; NULL to remove the index
+ * size                --number of buckets
+ */
+void rtp_member_hash_init (rtp_session_t *sess,
+                           rtp_member_hash_t *buckets,
+                           uint32_t size)
+{
+    rtp_member_t *member;
+    rtp_member_hash_t *bucket;
+    uint32_t i;
+
+    if (!sess) {
+        return;
+    }
+
+    if (!buckets || !size) {
+        sess->member_hash = NULL;
+        sess->member_hash_size = 0;
+        return;
+    }
+
+    sess->member_hash = buckets;
+    sess->member_hash_size = size;
+    for (i = 0; i < size; i++) {
+        VQE_LIST_INIT(&buckets[i].collision_head);
+    }
+    VQE_RB_FOREACH(member, rtp_member_tree_t_, &sess->member_tree) {
+        bucket = RTP_HASH_BUCKET_HEAD(sess, RTP_HASH(member->ssrc, size));
+        VQE_LIST_INSERT_HEAD(&bucket->collision_head, member, 
+                             member_hash_entry);
+    }
+}
+
+/*
+ * rtp_hash_first_member_with_ssrc
+ *
+ * Find, in the SSRC hash index, the member with the lowest SSRC+CNAME
+ * key value whose SSRC is equal to the specified SSRC.
+ *
+ * Parameters:
+ * sess                --ptr to session data, with an SSRC hash index
+ * ssrc                --SSRC value to search for (host order)
+ * Returns:            ptr to member, if it exists; else NULL.
+ */
+static rtp_member_t *rtp_hash_first_member_with_ssrc (rtp_session_t *sess,
+                                                      uint32_t ssrc)
+{
+    rtp_member_hash_t *bucket;
+    rtp_member_t *member, *match = NULL;
+
+    bucket = RTP_HASH_BUCKET_HEAD(sess, 
+                                  RTP_HASH(ssrc, sess->member_hash_size));
+    VQE_LIST_FOREACH(member, &bucket->collision_head, member_hash_entry) {
+        if (member->ssrc == ssrc &&
+            (!match || rtp_cmp_member(member, match) < 0)) {
+            match = member;
+        }
+    }
+    return (match);
+}
+
 /*
  * rtp_first_member
  *
@@ -158,6 +229,10 @@ rtp_member_t *rtp_first_member_with_ssrc (rtp_session_t *sess,
         return (NULL);
     }
 
+    if (sess->member_hash) {
+        return (rtp_hash_first_member_with_ssrc(sess, ssrc));
+    }
+
     search.ssrc = ssrc;
     search.sdes[RTCP_SDES_CNAME] = NULL;
 
@@ -230,10 +305,23 @@ rtp_member_t *rtp_find_member (rtp_session_t *sess,
                                char *cname)
 {
     rtp_member_t search;
+    rtp_member_hash_t *bucket;
+    rtp_member_t *member;
 
     if (!sess) {
         return (NULL);
     }
+    if (sess->member_hash) {
+        bucket = RTP_HASH_BUCKET_HEAD(sess, 
+                                      RTP_HASH(ssrc, sess->member_hash_size));
+        VQE_LIST_FOREACH(member, &bucket->collision_head, member_hash_entry) {
+            if (member->ssrc == ssrc &&
+                rtp_cmp_cname(member->sdes[RTCP_SDES_CNAME], cname) == 0) {
+                return (member);
+            }
+        }
+        return (NULL);
+    }
     search.ssrc = ssrc;
     search.sdes[RTCP_SDES_CNAME] = cname;
 
@@ -256,10 +344,21 @@ rtp_member_t *rtp_find_member (rtp_session_t *sess,
 boolean rtp_add_member (rtp_session_t *sess,
                         rtp_member_t *member)
 {
+    rtp_member_hash_t *bucket;
     rtp_member_t *result = VQE_RB_INSERT(rtp_member_tree_t_,
                                      &sess->member_tree,
                                      member);
-    return (result == NULL ? TRUE : FALSE);
+    if (result) {
+        return (FALSE);
+    }
+    if (sess->member_hash) {
+        bucket = RTP_HASH_BUCKET_HEAD(sess, 
+                                      RTP_HASH(member->ssrc, 
+                                               sess->member_hash_size));
+        VQE_LIST_INSERT_HEAD(&bucket->collision_head, member, 
+                             member_hash_entry);
+    }
+    return (TRUE);
 }
 
 /*
@@ -330,6 +429,7 @@ boolean rtp_update_member_cname (rtp_session_t *sess,
         }
     }
     cnamecpy(member->sdes[RTCP_SDES_CNAME], cname);
+    rtcp_invalidate_report_template(sess, member);
     if (rtp_add_member(sess, member)) {
         return (TRUE);
     } else {
@@ -421,4 +521,7 @@ void rtp_remove_member (rtp_session_t *sess,
     result = VQE_RB_REMOVE(rtp_member_tree_t_,
                        &sess->member_tree,
                        member);
+    if (sess->member_hash) {
+        VQE_LIST_REMOVE(member, member_hash_entry);
+    }
 }
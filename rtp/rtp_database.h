@@ -19,6 +19,10 @@
 
 extern int rtp_cmp_cname(char *cn1, char *cn2);
 
+extern void rtp_member_hash_init(rtp_session_t *sess,
+                                 rtp_member_hash_t *buckets,
+                                 uint32_t size);
+
 extern rtp_member_t *rtp_first_member(rtp_session_t *sess);
 extern rtp_member_t *rtp_next_member(rtp_session_t *sess,
                                      rtp_member_t *member);
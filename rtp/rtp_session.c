@@ -155,6 +155,7 @@ boolean rtp_create_session_base (rtp_config_t *config,
     }
 
     VQE_RB_INIT(&p_sess->member_tree);
+    rtp_member_hash_init(p_sess, NULL, 0);
     
     cfg = &config->rtcp_bw_cfg;
     info = &p_sess->rtcp_bw;
@@ -162,6 +163,7 @@ boolean rtp_create_session_base (rtp_config_t *config,
     rtcp_jitter_init(&p_sess->intvl_jitter);
 
     p_sess->rtcp_xr_cfg = config->rtcp_xr_cfg;
+    rtcp_invalidate_report_template(p_sess, NULL);
 
     p_sess->rtcp_handler = &rtp_session_rtcp_handler;
     VQE_TAILQ_INIT(&(p_sess->senders_list));
@@ -254,7 +256,8 @@ rtp_session_t *rtp_get_parent_session_base (rtp_session_t *p_sess)
 
 /*
  * Function:    rtp_member_move_to_head
- * Description: Move a member to head of garbage list.
+ * Description: Move a member to head of garbage list, as RTCP has just
+ *              been received from it.
  * Parameters:  p_sess     pointer to session object
  *              p_member   pointer to member object
  * Returns:     None
@@ -263,10 +266,38 @@ static void rtp_member_move_to_head (rtp_session_t *p_sess,
                                      rtp_member_t  *p_member)
 {
 
+  GET_TIMESTAMP(p_member->rcv_ctrl_ts);
   VQE_TAILQ_REMOVE(&(p_sess->garbage_list),p_member,p_member_chain);
   VQE_TAILQ_INSERT_HEAD(&(p_sess->garbage_list),p_member,p_member_chain);
 }
 
+/*
+ * Function:    rtp_member_insert_garbage
+ * Description: Insert a member into the garbage list, keeping the list
+ *              in decreasing rcv_ctrl_ts order. Members are inserted 
+ *              this way when they stop sending, i.e. when they have not 
+ *              been heard from for a while, so the list is searched from
+ *              its tail.
+ * Parameters:  p_sess     pointer to session object
+ *              p_member   pointer to member object
+ * Returns:     None
+ */
+static void rtp_member_insert_garbage (rtp_session_t *p_sess,
+                                       rtp_member_t  *p_member)
+{
+    rtp_member_t *p_prev;
+
+    VQE_TAILQ_FOREACH_REVERSE(p_prev, &(p_sess->garbage_list),
+                              garbage_list_t_, p_member_chain) {
+        if (TIME_CMP_A(ge, p_prev->rcv_ctrl_ts, p_member->rcv_ctrl_ts)) {
+            VQE_TAILQ_INSERT_AFTER(&(p_sess->garbage_list), p_prev,
+                                   p_member, p_member_chain);
+            return;
+        }
+    }
+    VQE_TAILQ_INSERT_HEAD(&(p_sess->garbage_list),p_member,p_member_chain);
+}
+
 /*
  * Function:    rtp_create_member_base
  * Description: Fill in and add new member into hash table (the base 
@@ -1427,6 +1458,7 @@ void rtp_delete_member_base ( rtp_session_t *p_sess,
                     "Session now has %u members, %u senders\n",
                     p_sess->rtcp_nmembers, p_sess->rtcp_nsenders);
 
+    rtcp_invalidate_report_template(p_sess, p_member);
     for (i = 1; i <= RTCP_SDES_MAX; i++) {
         if (p_member->sdes[i]) {
             rtcp_delete_object(p_sess->rtcp_mem, 
@@ -1552,6 +1584,7 @@ rtp_member_t *rtp_create_local_source_base (rtp_session_t   *p_sess,
     }
     
     p_sess->rtp_local_source = p_source;
+    rtcp_invalidate_report_template(p_sess, NULL);
     /* mark the local source as initial, as it has not sent any RTCP packet
      */
     p_sess->initial = TRUE;
@@ -1850,9 +1883,9 @@ void rtp_session_timeout_slist_base (rtp_session_t *p_sess)
                                          tempts);
         if (!(recent_rtcp_activity || recent_rtp_activity)) {
             /*
-             * Remove from senders list and add to the garbage list. $$$ Note that
-             * we add it to the head of the garbage list, need to confirm if that
-             * is okay?
+             * Remove from senders list and add to the garbage list, in
+             * order of the last RTCP received, so that it times out from
+             * the garbage list in turn.
              */
             if (p_member->pos != -1) {
                 p_sess->rtp_source_bitmask &= ~(1 << p_member->pos);
@@ -1865,7 +1898,7 @@ void rtp_session_timeout_slist_base (rtp_session_t *p_sess)
                             p_member->sdes[RTCP_SDES_CNAME] : "<none>");
             p_sess->rtcp_nsenders--;
             VQE_TAILQ_REMOVE(&(p_sess->senders_list),p_member,p_member_chain);
-            VQE_TAILQ_INSERT_HEAD(&(p_sess->garbage_list),p_member,p_member_chain);
+            rtp_member_insert_garbage(p_sess, p_member);
             source_id.ssrc = p_member->ssrc;
             source_id.src_addr = p_member->rtp_src_addr;
             source_id.src_port = p_member->rtp_src_port;
@@ -1897,9 +1930,9 @@ void rtp_session_timeout_glist_base (rtp_session_t *p_sess)
                      FALSE /* we_sent */,
                      FALSE /* do not jitter */);
     /* 
-     * Note each member in slist is traversed to check timeout. It is
-     * assumed that number of senders are small enough to not cause
-     * any potential hogs
+     * The garbage list is kept in decreasing rcv_ctrl_ts order, so only
+     * the members which have timed out, at its tail, are visited: the
+     * walk stops at the first member which has not timed out.
      */
     VQE_TAILQ_FOREACH_REVERSE_SAFE(p_member, &(p_sess->garbage_list),
                                garbage_list_t_,
@@ -2599,6 +2632,7 @@ static void rtcp_process_one_sdes_item (rtp_session_t *p_sess,
         }
         bcopy(item_data, p_sdes_item, item_len);
         p_sdes_item[item_len] = 0;
+        rtcp_invalidate_report_template(p_sess, p_source);
     }
 }
 
@@ -4060,39 +4094,40 @@ static rtcp_bw_bi_t rtcp_get_rcvr_rtcpbi_value (rtp_session_t *p_sess)
 }
 
 /*
- * Function:    rtcp_construct_rsi
- * Description: Construct a RSI report
- *              Note: Currently only Group and Average Packet Size Sub Report
- *              Block (Need to add collision summary also )
- * Parameters:  p_ssm_rsi_source  pointer to session object
- *              p_source          pointer to local source member
- *              subrpt_mask       Mask indicating which subreports to include.
- *              p_rtcp   pointer to start of rtcp packet in the buffer
+ * Function:    rtcp_format_rsi
+ * Description: Lay out a RSI report: its header and fields, and the header
+ *              of each sub report.  The NTP timestamp and the sub report
+ *              values are filled in by rtcp_update_rsi.
+ *              Note: Currently only Group and Average Packet Size and
+ *              RTCP Bandwidth Indication Sub Report Blocks are supported.
+ * Parameters:  p_sess       pointer to session object
+ *              p_source     pointer to local source member
+ *              p_rtcp       pointer to start of rtcp packet in the buffer
+ *              bufflen      length of the buffer
+ *              subrpt_mask  Mask indicating which subreports to include.
  * Returns:     Length of RSI packet, or zero if no room in the buffer.
  */
-
-uint32_t rtcp_construct_rsi (rtp_session_t *p_sess,
-                             rtp_member_t *p_source,
-                             rtcptype *p_rtcp,
-                             uint32_t bufflen,
-                             rtcp_rsi_subrpt_mask_t subrpt_mask)
+static uint32_t rtcp_format_rsi (rtp_session_t *p_sess,
+                                 rtp_member_t *p_source,
+                                 rtcptype *p_rtcp,
+                                 uint32_t bufflen,
+                                 rtcp_rsi_subrpt_mask_t subrpt_mask)
 {
     ushort params = 0;
     rtcp_rsi_t *p_rsi;
-    ntp64_t      ntp_ts;
     rtcp_rsi_gen_subrpt_t *p_subrpt;
-    rtcp_rsi_gaps_subrpt_t *p_gaps_subrpt;
     rtcp_rsi_rtcpbi_subrpt_t *p_rtcpbi_subrpt;
     uint32_t length_in_bytes;
     uint32_t subrpt_length_in_bytes;
     rtcp_rsi_subrpt_t subrpt_type;
-    uint32_t bytes_remaining = bufflen;
+    uint32_t bytes_remaining;
 
     /* minimum length of RSI packet */
     length_in_bytes = (sizeof(rtcptype) + sizeof(rtcp_rsi_t));
-    if (length_in_bytes > bytes_remaining) {
+    if (length_in_bytes > bufflen) {
         return (0);
     }
+    bytes_remaining = bufflen - length_in_bytes;
 
     params = rtcp_set_version(params);
     params = rtcp_set_count(params, 0);
@@ -4106,9 +4141,8 @@ uint32_t rtcp_construct_rsi (rtp_session_t *p_sess,
     p_subrpt = (rtcp_rsi_gen_subrpt_t *)p_rsi->data;
 
     p_rsi->summ_ssrc = htonl(p_source->ssrc);
-    ntp_ts = get_ntp_time();
-    p_rsi->ntp_h = htonl(ntp_ts.upper);
-    p_rsi->ntp_l = htonl(ntp_ts.lower);
+    p_rsi->ntp_h = 0;
+    p_rsi->ntp_l = 0;
 
     for (subrpt_type = rtcp_rsi_get_first_subrpt(subrpt_mask) ;
          subrpt_type != NOT_AN_RSI_SUBRPT ;
@@ -4116,36 +4150,27 @@ uint32_t rtcp_construct_rsi (rtp_session_t *p_sess,
         switch (subrpt_type) {
         case RTCP_RSI_GAPSB:
             subrpt_length_in_bytes = sizeof(rtcp_rsi_gaps_subrpt_t);
-            if (subrpt_length_in_bytes > bytes_remaining) {
-                return (0);
-            }
-            p_gaps_subrpt = (rtcp_rsi_gaps_subrpt_t *)p_subrpt;
-            p_gaps_subrpt->average_packet_size = 
-                htons((uint16_t)(p_sess->rtcp_stats.avg_pkt_size));
-            p_gaps_subrpt->group_size = htonl(p_sess->rtcp_nmembers);
-            /* $$$ this doesn't work for a DS with a disjoint FBT,
-               where it should be rtcp_nmembers + rtcp_nmembers_learned */
             break;
         case RTCP_RSI_BISB:
             subrpt_length_in_bytes = sizeof(rtcp_rsi_rtcpbi_subrpt_t);
-            if (subrpt_length_in_bytes > bytes_remaining) {
-                return (0);
-            }
-            p_rtcpbi_subrpt = (rtcp_rsi_rtcpbi_subrpt_t *)p_subrpt;
-            p_rtcpbi_subrpt->role = htons(RTCP_RSI_BI_RECEIVERS);
-            p_rtcpbi_subrpt->rtcp_bandwidth =
-                htonl(rtcp_get_rcvr_rtcpbi_value(p_sess));
             break;
         default:
-            subrpt_length_in_bytes = 0;
             RTP_LOG_ERROR_F(p_sess, p_source,
                             "Attempt to format unsupported RTCP RSI "
                             "sub report block (type %d)\n",
                             subrpt_type);
-            break;
+            continue;
+        }
+        if (subrpt_length_in_bytes > bytes_remaining) {
+            return (0);
         }
+        memset(p_subrpt, 0, subrpt_length_in_bytes);
         p_subrpt->srbt = subrpt_type;
         p_subrpt->length = subrpt_length_in_bytes / 4;
+        if (subrpt_type == RTCP_RSI_BISB) {
+            p_rtcpbi_subrpt = (rtcp_rsi_rtcpbi_subrpt_t *)p_subrpt;
+            p_rtcpbi_subrpt->role = htons(RTCP_RSI_BI_RECEIVERS);
+        }
         p_subrpt = (rtcp_rsi_gen_subrpt_t *)((uint8_t *)p_subrpt 
                                              + subrpt_length_in_bytes);
         length_in_bytes += subrpt_length_in_bytes;
@@ -4156,6 +4181,82 @@ uint32_t rtcp_construct_rsi (rtp_session_t *p_sess,
     return (length_in_bytes);
 }
 
+/*
+ * Function:    rtcp_update_rsi
+ * Description: Fill in the NTP timestamp and the sub report values of a 
+ *              RSI report laid out by rtcp_format_rsi.
+ * Parameters:  p_sess   pointer to session object
+ *              p_rtcp   pointer to start of the RSI packet
+ * Returns:     None
+ */
+static void rtcp_update_rsi (rtp_session_t *p_sess,
+                             rtcptype *p_rtcp)
+{
+    rtcp_rsi_t *p_rsi;
+    ntp64_t      ntp_ts;
+    rtcp_rsi_gen_subrpt_t *p_subrpt;
+    rtcp_rsi_gaps_subrpt_t *p_gaps_subrpt;
+    rtcp_rsi_rtcpbi_subrpt_t *p_rtcpbi_subrpt;
+    uint8_t *p_end;
+
+    p_rsi = (rtcp_rsi_t *)(p_rtcp + 1);
+    ntp_ts = get_ntp_time();
+    p_rsi->ntp_h = htonl(ntp_ts.upper);
+    p_rsi->ntp_l = htonl(ntp_ts.lower);
+
+    p_end = (uint8_t *)p_rtcp + ((ntohs(p_rtcp->len) + 1) << 2);
+    for (p_subrpt = (rtcp_rsi_gen_subrpt_t *)p_rsi->data;
+         (uint8_t *)(p_subrpt + 1) <= p_end && p_subrpt->length;
+         p_subrpt = (rtcp_rsi_gen_subrpt_t *)((uint8_t *)p_subrpt 
+                                              + (p_subrpt->length << 2))) {
+        switch (p_subrpt->srbt) {
+        case RTCP_RSI_GAPSB:
+            p_gaps_subrpt = (rtcp_rsi_gaps_subrpt_t *)p_subrpt;
+            p_gaps_subrpt->average_packet_size = 
+                htons((uint16_t)(p_sess->rtcp_stats.avg_pkt_size));
+            p_gaps_subrpt->group_size = htonl(p_sess->rtcp_nmembers);
+            /* $$$ this doesn't work for a DS with a disjoint FBT,
+               where it should be rtcp_nmembers + rtcp_nmembers_learned */
+            break;
+        case RTCP_RSI_BISB:
+            p_rtcpbi_subrpt = (rtcp_rsi_rtcpbi_subrpt_t *)p_subrpt;
+            p_rtcpbi_subrpt->rtcp_bandwidth =
+                htonl(rtcp_get_rcvr_rtcpbi_value(p_sess));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/*
+ * Function:    rtcp_construct_rsi
+ * Description: Construct a RSI report
+ *              Note: Currently only Group and Average Packet Size and
+ *              RTCP Bandwidth Indication Sub Report Blocks are supported.
+ *              (Need to add collision summary also)
+ * Parameters:  p_ssm_rsi_source  pointer to session object
+ *              p_source          pointer to local source member
+ *              subrpt_mask       Mask indicating which subreports to include.
+ *              p_rtcp   pointer to start of rtcp packet in the buffer
+ * Returns:     Length of RSI packet, or zero if no room in the buffer.
+ */
+
+uint32_t rtcp_construct_rsi (rtp_session_t *p_sess,
+                             rtp_member_t *p_source,
+                             rtcptype *p_rtcp,
+                             uint32_t bufflen,
+                             rtcp_rsi_subrpt_mask_t subrpt_mask)
+{
+    uint32_t len;
+
+    len = rtcp_format_rsi(p_sess, p_source, p_rtcp, bufflen, subrpt_mask);
+    if (len) {
+        rtcp_update_rsi(p_sess, p_rtcp);
+    }
+    return (len);
+}
+
 /*
  * Function:    rtcp_construct_pubports
  * Description: Construct a PUBPORTS msg.  Arguments are in
@@ -4198,6 +4299,155 @@ rtcp_construct_pubports (const rtp_member_t *p_source,
     return (pubports_len);
 }
 
+/*
+ * Function:    rtcp_invalidate_report_template
+ * Description: Discard the compound report template of a session, if it
+ *              was built for the given member. Must be called whenever
+ *              an SDES item of the local source is changed in place.
+ * Parameters:  p_sess   ptr to session object
+ *              p_member ptr to the member whose SDES items changed, or
+ *                       NULL to discard the template unconditionally
+ * Returns:     None
+ */
+void rtcp_invalidate_report_template (rtp_session_t *p_sess,
+                                      rtp_member_t *p_member)
+{
+    rtcp_rpt_tmpl_t *p_tmpl = &p_sess->rpt_tmpl;
+
+    if (!p_member || p_member == p_tmpl->source) {
+        p_tmpl->source = NULL;
+        p_tmpl->static_len = 0;
+        p_tmpl->rsi_len = 0;
+    }
+}
+
+/*
+ * Function:    rtcp_get_report_template
+ * Description: Get the compound report template of a session for a local
+ *              source, discarding its contents first if they were built 
+ *              for another source or SSRC.
+ * Parameters:  p_sess   ptr to session object
+ *              p_source pointer to local source member
+ * Returns:     Pointer to the template
+ */
+static rtcp_rpt_tmpl_t *rtcp_get_report_template (rtp_session_t *p_sess,
+                                                  rtp_member_t  *p_source)
+{
+    rtcp_rpt_tmpl_t *p_tmpl = &p_sess->rpt_tmpl;
+
+    if (p_tmpl->source != p_source || p_tmpl->ssrc != p_source->ssrc) {
+        rtcp_invalidate_report_template(p_sess, NULL);
+        p_tmpl->source = p_source;
+        p_tmpl->ssrc = p_source->ssrc;
+    }
+    return (p_tmpl);
+}
+
+/*
+ * Function:    rtcp_copy_static_report
+ * Description: Copy the SDES packet of the local source, followed by the
+ *              PUBPORTS packet if specified, into a report, (re)building 
+ *              them in the session's template first if they are missing
+ *              or were built for other PUBPORTS info.
+ * Parameters:  p_sess     ptr to session object
+ *              p_source   pointer to local source member
+ *              p_data     pointer to the SDES packet in the report
+ *              bufflen    bytes available in the report
+ *              p_pubports pointer to PUBPORTS info, or NULL for none
+ *              p_pkttype  set to the type of the packet which did not fit
+ * Returns:     Length of the packets in bytes, or zero if they will not fit.
+ */
+static uint32_t rtcp_copy_static_report (rtp_session_t        *p_sess,
+                                         rtp_member_t         *p_source,
+                                         uint8_t              *p_data,
+                                         uint32_t              bufflen,
+                                         rtcp_pubports_info_t *p_pubports,
+                                         char                **p_pkttype)
+{
+    rtcp_rpt_tmpl_t *p_tmpl;
+    uint32_t len;
+
+    p_tmpl = rtcp_get_report_template(p_sess, p_source);
+    if (!p_tmpl->static_len ||
+        (p_tmpl->has_pubports != (p_pubports != NULL)) ||
+        (p_pubports && 
+         memcmp(&p_tmpl->pubports, p_pubports, sizeof(*p_pubports)))) {
+        /*
+         * Only the CNAME item is sent, so SDES and PUBPORTS always fit 
+         * in the template.
+         */
+        p_tmpl->static_len = 0;
+        len = rtcp_construct_sdes_report((rtcptype *)p_tmpl->static_pkts,
+                                         sizeof(p_tmpl->static_pkts),
+                                         p_source,
+                                         0x1 << (RTCP_SDES_CNAME - 1));
+        if (!len) {
+            *p_pkttype = "SDES";
+            return (0);
+        }
+        p_tmpl->sdes_len = len;
+        p_tmpl->has_pubports = FALSE;
+        if (p_pubports) {
+            len += rtcp_construct_pubports(p_source,
+                                           &p_tmpl->static_pkts[len],
+                                           sizeof(p_tmpl->static_pkts) - len,
+                                           p_pubports);
+            p_tmpl->has_pubports = TRUE;
+            p_tmpl->pubports = *p_pubports;
+        }
+        p_tmpl->static_len = len;
+    }
+
+    if (p_tmpl->static_len > bufflen) {
+        *p_pkttype = (p_tmpl->sdes_len > bufflen) ? "SDES" : "PUBPORTS";
+        return (0);
+    }
+    memcpy(p_data, p_tmpl->static_pkts, p_tmpl->static_len);
+    return (p_tmpl->static_len);
+}
+
+/*
+ * Function:    rtcp_copy_rsi_report
+ * Description: Copy the RSI packet of the local source into a report,
+ *              (re)building its layout in the session's template first if
+ *              it is missing or was built for other sub reports, and fill
+ *              in its NTP timestamp and sub report values.
+ * Parameters:  p_sess      ptr to session object
+ *              p_source    pointer to local source member
+ *              p_rtcp      pointer to the RSI packet in the report
+ *              bufflen     bytes available in the report
+ *              subrpt_mask Mask indicating which subreports to include.
+ * Returns:     Length of RSI in bytes, or zero if RSI will not fit.
+ */
+static uint32_t rtcp_copy_rsi_report (rtp_session_t         *p_sess,
+                                      rtp_member_t          *p_source,
+                                      rtcptype              *p_rtcp,
+                                      uint32_t               bufflen,
+                                      rtcp_rsi_subrpt_mask_t subrpt_mask)
+{
+    rtcp_rpt_tmpl_t *p_tmpl;
+    uint32_t len;
+
+    p_tmpl = rtcp_get_report_template(p_sess, p_source);
+    if (!p_tmpl->rsi_len || (p_tmpl->rsi_mask != subrpt_mask)) {
+        len = rtcp_format_rsi(p_sess, p_source, (rtcptype *)p_tmpl->rsi,
+                              sizeof(p_tmpl->rsi), subrpt_mask);
+        if (!len) {
+            p_tmpl->rsi_len = 0;
+            return (0);
+        }
+        p_tmpl->rsi_len = len;
+        p_tmpl->rsi_mask = subrpt_mask;
+    }
+
+    if (p_tmpl->rsi_len > bufflen) {
+        return (0);
+    }
+    memcpy(p_rtcp, p_tmpl->rsi, p_tmpl->rsi_len);
+    rtcp_update_rsi(p_sess, p_rtcp);
+    return (p_tmpl->rsi_len);
+}
+
 /*
  * Function:    rtcp_construct_report_base
  *
@@ -4232,7 +4482,6 @@ uint32_t rtcp_construct_report_base (rtp_session_t   *p_sess,
     rtcp_sr_t *p_sr;
     rtcp_rr_t *p_rr;
     rtcp_msg_info_t *p_msg_info;
-    uint8_t    sdes_mask;
     uint8_t   *p_data;
     ntp64_t   ntp_now;
     uint8_t   *p_end = NULL;
@@ -4361,37 +4610,24 @@ uint32_t rtcp_construct_report_base (rtp_session_t   *p_sess,
      */
      
     /*
-     * Add in SDES, with a (mandatory) CNAME item.
+     * Add in SDES, with a (mandatory) CNAME item, and PUBPORTS, if
+     * specified.
      * $$$ temporarily, we're not supporting the formatting of other items.
+     * Both only change with the local source and the PUBPORTS info, so
+     * they are copied from the session's template rather than built for
+     * every report.
      */
-    sdes_mask = 0x1 << (RTCP_SDES_CNAME - 1);
-    if (sdes_mask) {
-        len = rtcp_construct_sdes_report((rtcptype *) p_data, 
-                                         bufflen - total_len,
-                                         p_source, sdes_mask);
-        if (len) {
-            total_len += len;
-            p_data += len;
-        } else {
-            p_pkttype = "SDES";
-            goto no_room;
-        }
-    }
-
-    /* Add PUBPORTS, if specified */
     p_msg_info = rtcp_get_pkt_info(p_pkt_info, RTCP_PUBPORTS);
-    if (p_msg_info) {
-        len = rtcp_construct_pubports(p_source, 
-                                      p_data, 
-                                      bufflen - total_len,
-                                      &(p_msg_info->pubports_info));
-        if (len) {
-            total_len += len;
-            p_data += len;
-        } else {
-            p_pkttype = "PUBPORTS";
-            goto no_room;
-        }
+    len = rtcp_copy_static_report(p_sess, p_source, p_data,
+                                  bufflen - total_len,
+                                  p_msg_info ? 
+                                  &(p_msg_info->pubports_info) : NULL,
+                                  &p_pkttype);
+    if (len) {
+        total_len += len;
+        p_data += len;
+    } else {
+        goto no_room;
     }
 
     /* Add APP, if specified */
@@ -4446,11 +4682,11 @@ uint32_t rtcp_construct_report_base (rtp_session_t   *p_sess,
     /* Add RSI, if specified. */
     p_msg_info = rtcp_get_pkt_info(p_pkt_info, RTCP_RSI);
     if (p_msg_info) {
-        len = rtcp_construct_rsi(p_sess,
-                                 p_source,
-                                 (rtcptype *)p_data,
-                                 bufflen - total_len,
-                                 p_msg_info->rsi_info.subrpt_mask);
+        len = rtcp_copy_rsi_report(p_sess,
+                                   p_source,
+                                   (rtcptype *)p_data,
+                                   bufflen - total_len,
+                                   p_msg_info->rsi_info.subrpt_mask);
         if (len) {
             total_len += len;
             p_data += len;
@@ -106,6 +106,7 @@ typedef uint32_t rtp_member_flags_t;
 #define  RTP_MEMBER_INFO                                                           \
     VQE_RB_ENTRY(rtp_member_t_)      member_entry;     /* node in member rb tree */    \
     VQE_TAILQ_ENTRY(rtp_member_t_)   p_member_chain;   /* Garbage or sender chain */   \
+    VQE_LIST_ENTRY(rtp_member_t_)    member_hash_entry; /* node in SSRC hash */       \
     uint32_t                ssrc; /* RTP/RTCP synchronization source id (SSRC) */  \
     ipaddrtype              rtp_src_addr;  /* src IP addr of RTP packets */        \
     uint16_t                rtp_src_port;  /* src UPD port of RTP packets */       \
@@ -196,6 +197,49 @@ typedef struct rtp_conflict {
 
 #define RTP_MAX_CONFLICT_ITEMS  5
 
+/*
+ * RTCP_RPT_TMPL_STATIC_SIZE
+ * Size of the cached static packets of the local source's compound
+ * reports: SDES (the RTCP header, one CNAME item, and up to 4 bytes of 
+ * null termination and padding), followed by PUBPORTS.
+ */
+#define RTCP_RPT_TMPL_STATIC_SIZE  ((8 + 2 + RTCP_MAX_CNAME + 4) +         \
+                                    sizeof(rtcptype) + sizeof(rtcp_pubports_t))
+
+/*
+ * RTCP_RPT_TMPL_RSI_SIZE
+ * Size of the cached RSI packet: the RTCP header, the RSI fields and
+ * the supported sub-reports.
+ */
+#define RTCP_RPT_TMPL_RSI_SIZE  (sizeof(rtcptype) + sizeof(rtcp_rsi_t) +   \
+                                 sizeof(rtcp_rsi_gaps_subrpt_t) +          \
+                                 sizeof(rtcp_rsi_rtcpbi_subrpt_t))
+
+/*
+ * rtcp_rpt_tmpl_t
+ *
+ * Wire-format template of the compound reports of the local source.
+ * The SDES and PUBPORTS packets only change with the local source and
+ * the PUBPORTS info, so they are cached whole.  The RSI packet is cached 
+ * for a set of sub-reports, and only its NTP timestamp and sub-report 
+ * values are filled in for each report.  The template is rebuilt when 
+ * the local source, its SSRC or the report content changes, and is
+ * invalidated (by rtcp_invalidate_report_template) when an SDES item of
+ * the local source changes.
+ */
+typedef struct rtcp_rpt_tmpl_ {
+    rtp_member_t *source;           /* Local source the template is for */
+    uint32_t ssrc;                  /* SSRC the template is for */
+    uint16_t sdes_len;              /* Length of SDES in static_pkts */
+    uint16_t static_len;            /* Length of static_pkts, 0 if invalid */
+    boolean has_pubports;           /* PUBPORTS follows SDES */
+    rtcp_pubports_info_t pubports;  /* PUBPORTS info, if has_pubports */
+    uint16_t rsi_len;               /* Length of rsi, 0 if invalid */
+    rtcp_rsi_subrpt_mask_t rsi_mask; /* Sub-reports of rsi */
+    uint8_t static_pkts[RTCP_RPT_TMPL_STATIC_SIZE]; /* SDES [+ PUBPORTS] */
+    uint8_t rsi[RTCP_RPT_TMPL_RSI_SIZE];    /* RSI, without its values */
+} rtcp_rpt_tmpl_t;
+
 /*
  * rtp_conflict_type_t
  *
@@ -359,8 +403,9 @@ typedef struct rtp_config_t_ {
     void *app_ref;
 } rtp_config_t;
 
-/* Hash List for members. Note the hash size (number of buckets) is dynmaically
- * allocated
+/* Hash List for members. Note the hash size (number of buckets) is set
+ * per session type: the buckets are part of the derived session, and
+ * sessions without buckets index their members by the RB tree only.
  */
 typedef struct rtp_member_hash_t_ {
     VQE_LIST_HEAD(,rtp_member_t_) collision_head;
@@ -370,10 +415,10 @@ typedef struct rtp_member_hash_t_ {
  * New hash algorithm (old hash algorithm was nethash() 
  * see rtcp_memory.h for possible "size" values 
  */
-#define RTP_HASH(ssrc,size)         ((ssrc) % size)
+#define RTP_HASH(ssrc,size)         ((ssrc) % (size))
 
 #define RTP_HASH_BUCKET_HEAD(p_sess, hash)  \
-    (rtp_member_hash_t *)(p_sess->member_hash + hash);
+    ((rtp_member_hash_t *)((p_sess)->member_hash + (hash)))
 
 typedef VQE_TAILQ_HEAD(garbage_list_t_,rtp_member_t_) garbage_list_t;
 typedef VQE_TAILQ_HEAD(senders_list_t_,rtp_member_t_) senders_list_t;
@@ -413,6 +458,14 @@ typedef VQE_RB_HEAD(rtp_member_tree_t_, rtp_member_t_) rtp_member_tree_t;
  * rtcp_nmembers is the total session members during this interval
  * rtcp_nsources is the total active sources during this interval
  * rtcp_interval is the timeout for scheduling the RTCP packet
+ * member_hash (if not NULL) indexes the members of member_tree by SSRC,
+ * for session types which may have many members; it has member_hash_size
+ * buckets.
+ * garbage_list holds the members which are not senders, most recently
+ * heard from first: i.e. in decreasing rcv_ctrl_ts order, so that
+ * members time out from its tail.
+ * rpt_tmpl holds the parts of the local source's compound reports which
+ * are copied into every report rather than built for each.
  */
 
 #define RTP_SESSION_INFO                                                      \
@@ -424,6 +477,8 @@ typedef VQE_RB_HEAD(rtp_member_tree_t_, rtp_member_t_) rtp_member_tree_t;
     void *app_ref;                                                            \
     rtcp_memory_t *rtcp_mem;                                                  \
     rtp_member_tree_t member_tree;                                            \
+    rtp_member_hash_t *member_hash;                                           \
+    uint32_t member_hash_size;                                                \
     boolean rtcp_rsize;                                                       \
     uint32_t           rtp_source_bitmask;                                       \
     uint8_t           max_senders_cached;                                       \
@@ -457,6 +512,7 @@ typedef VQE_RB_HEAD(rtp_member_tree_t_, rtp_member_t_) rtp_member_tree_t;
     boolean xr_ma_sent;             /* Set to true once the XR MA is sent*/       \
     rtcp_xr_dc_stats_t xr_dc_stats;                                               \
     abs_time_t last_rtcp_pkt_ts;    /* Updated by rtcp_recv_timestamped_packet*/ \
+    rtcp_rpt_tmpl_t rpt_tmpl;       /* Compound report template */           \
 
 
 
@@ -765,6 +821,8 @@ boolean rtcp_process_packet_base(rtp_session_t *p_sess,
 uint32_t rtcp_report_interval_base(rtp_session_t    *p_sess,
                                    boolean          we_sent,
                                    boolean          add_jitter);
+void rtcp_invalidate_report_template(rtp_session_t *p_sess,
+                                     rtp_member_t *p_member);
 uint32_t rtcp_construct_report_base (rtp_session_t   *p_sess,
                                      rtp_member_t    *p_source, 
                                      rtcptype        *p_rtcp,
@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include "rtp_ssm_rsi.h"
 #include "rtp_ssm_rsi_source.h"
+#include "rtp_database.h"
 
 static rtcp_memory_t     rtp_ssm_rsi_source_memory;
 static rtp_ssm_rsi_source_methods_t rtp_ssm_rsi_source_methods_table;
@@ -138,6 +139,11 @@ boolean rtp_create_session_ssm_rsi_source (rtp_config_t *p_config,
         return FALSE;
      }     
 
+     /* Index members by SSRC */
+     rtp_member_hash_init((rtp_session_t *)*pp_ssm_rsi_source,
+                          (*pp_ssm_rsi_source)->member_hash_buckets,
+                          RTP_SSM_RSI_SOURCE_HASH_SIZE);
+
      /* Set the methods table */
      (*pp_ssm_rsi_source)->__func_table = &rtp_ssm_rsi_source_methods_table;
 
@@ -47,10 +47,17 @@
      */
 
 
+/*
+ * Number of buckets in the SSRC hash index of members: a source session
+ * may have thousands of receivers reporting.
+ */
+#define RTP_SSM_RSI_SOURCE_HASH_SIZE  1021
+
 /* Insert any session fields that are unique to the SSM-RSI-SOURCE session type 
  * after RTP_SESSION_INFO */
 #define RTP_SSM_RSI_SOURCE_INFO        \
-    RTP_SESSION_INFO        
+    RTP_SESSION_INFO                   \
+    rtp_member_hash_t member_hash_buckets[RTP_SSM_RSI_SOURCE_HASH_SIZE];
 
 
 typedef struct rtp_ssm_rsi_source_methods_t_ {
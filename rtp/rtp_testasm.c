@@ -11,6 +11,7 @@
 #include "../include/utils/vam_types.h"
 #include "rtp_session.h"
 #include "rtp_asm.h"
+#include "rtp_database.h"
 #include "../add-ons/include/CUnit/CUnit.h"
 #include "../add-ons/include/CUnit/Basic.h"
 /* CU_ASSERT_* return values are not used */
@@ -63,6 +64,74 @@ void test_asm_sess_create(void)
 
 }
 
+/*
+ * Members of an ASM session are indexed by SSRC as well as by
+ * SSRC+CNAME: check that lookups by either key agree with the tree,
+ * across hash collisions and members sharing an SSRC.
+ */
+void test_asm_member_hash(void)
+{
+    rtp_session_t *p_sess = (rtp_session_t *)p_rtp_asm;
+    rtp_member_t *p_member[4] = { NULL, NULL, NULL, NULL };
+    rtp_member_t *p_found;
+    rtp_member_id_t member_id;
+    uint32_t ssrc = 0x12345678;
+    char *cname[4] = { "member-b", "member-a", "member-c", "member-d" };
+    uint32_t i;
+
+    CU_ASSERT_PTR_NOT_NULL_FATAL(p_sess);
+    CU_ASSERT(p_sess->member_hash_size == RTP_ASM_HASH_SIZE);
+
+    /*
+     * Members 0 and 1 share an SSRC; members 2 and 3 have SSRCs in the
+     * same hash bucket.
+     */
+    member_id.type = RTP_RMEMBER_ID_RTCP_DATA;
+    member_id.subtype = RTCP_CHANNEL_MEMBER;
+    member_id.src_addr = 0x0a000001;
+    member_id.src_port = 0x1000;
+    for (i = 0; i < 4; i++) {
+        member_id.ssrc = (i < 2) ? ssrc : ssrc + i * RTP_ASM_HASH_SIZE;
+        member_id.cname = cname[i];
+        CU_ASSERT(RTP_SUCCESS == 
+                  MCALL(p_sess, rtp_create_member, &member_id, &p_member[i]));
+    }
+
+    /* the lowest CNAME comes first, as in the tree */
+    p_found = rtp_first_member_with_ssrc(p_sess, ssrc);
+    CU_ASSERT(p_found == p_member[1]);
+    p_found = rtp_next_member_with_ssrc(p_sess, p_found);
+    CU_ASSERT(p_found == p_member[0]);
+    CU_ASSERT_PTR_NULL(rtp_next_member_with_ssrc(p_sess, p_found));
+
+    for (i = 0; i < 4; i++) {
+        CU_ASSERT(rtp_find_member(p_sess, p_member[i]->ssrc, cname[i]) ==
+                  p_member[i]);
+    }
+    CU_ASSERT_PTR_NULL(rtp_find_member(p_sess, ssrc, cname[2]));
+    CU_ASSERT_PTR_NULL(rtp_first_member_with_ssrc(p_sess, 
+                                                  ssrc + RTP_ASM_HASH_SIZE));
+
+    /* re-keying moves members within the index */
+    CU_ASSERT(rtp_update_member_ssrc(p_sess, p_member[3], ssrc + 1));
+    CU_ASSERT(rtp_first_member_with_ssrc(p_sess, ssrc + 1) == p_member[3]);
+    CU_ASSERT_PTR_NULL(rtp_first_member_with_ssrc(p_sess, 
+                                                  ssrc + 3 * 
+                                                  RTP_ASM_HASH_SIZE));
+    CU_ASSERT(rtp_update_member_cname(p_sess, p_member[0], "member-0"));
+    CU_ASSERT(rtp_first_member_with_ssrc(p_sess, ssrc) == p_member[0]);
+
+    /* removal */
+    for (i = 0; i < 4; i++) {
+        MCALL(p_sess, rtp_delete_member, &p_member[i], TRUE);
+    }
+    CU_ASSERT_PTR_NULL(rtp_first_member_with_ssrc(p_sess, ssrc));
+    CU_ASSERT_PTR_NULL(rtp_first_member_with_ssrc(p_sess, 
+                                                  ssrc + 2 * 
+                                                  RTP_ASM_HASH_SIZE));
+    CU_ASSERT(0 == p_sess->rtcp_nmembers);
+}
+
 void test_asm_sess_delete(void)
 {
     /* KK!! Must change delete to return error if bad */
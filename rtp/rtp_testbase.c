@@ -1212,6 +1212,251 @@ void test_base_construct_pubports(void)
     CU_ASSERT(0 == p_sender_sess->rtcp_nsenders);
 }
 
+/*
+ * test_base_construct_sdes
+ *
+ * Test that the (cached) SDES packet of successive reports follows
+ * changes of the CNAME and SSRC of the local source.
+ */
+static void check_sdes_cname (uint8_t *buff, uint32_t len,
+                              uint32_t ssrc, char *cname)
+{
+    rtcptype *p_rtcp;
+    uint8_t *p_item;
+
+    p_rtcp = rtcp_find_msg((rtcptype *)buff, len, RTCP_SDES);
+    CU_ASSERT_PTR_NOT_NULL(p_rtcp);
+    if (!p_rtcp) {
+        return;
+    }
+    CU_ASSERT(ntohl(p_rtcp->ssrc) == ssrc);
+    p_item = (uint8_t *)(p_rtcp + 1);
+    CU_ASSERT(p_item[RTCP_SDES_ITEM_TYPE] == RTCP_SDES_CNAME);
+    CU_ASSERT(p_item[RTCP_SDES_ITEM_LEN] == strlen(cname));
+    CU_ASSERT(memcmp(&p_item[RTCP_SDES_ITEM_DATA], cname, 
+                     strlen(cname)) == 0);
+}
+
+void test_base_construct_sdes(void)
+{
+    rtp_member_t   *p_sender = NULL;
+    uint32_t        len = 0, first_len = 0;
+    uint8_t        *buff = NULL;
+    uint32_t        new_ssrc;
+    rtp_member_id_t member_id;
+
+    ipaddrtype src_addr_sender = 0xc0a83737;
+    uint16_t src_port_sender = 0x0301;
+    char cname_sender[] = "Sender (VAM)";
+    char cname_changed[] = "Sender (VAM), renamed";
+
+    member_id.type = RTP_SMEMBER_ID_RTCP_DATA;
+    member_id.ssrc = 0;
+    member_id.subtype = RTCP_CHANNEL_MEMBER;
+    member_id.src_addr = src_addr_sender;
+    member_id.src_port = src_port_sender;
+    member_id.cname = cname_sender;
+    p_sender = MCALL(p_sender_sess, rtp_create_local_source, 
+                     &member_id, RTP_SELECT_RANDOM_SSRC);
+    CU_ASSERT_PTR_NOT_NULL(p_sender);
+
+    buff = malloc(RTCP_PAK_SIZE);
+    CU_ASSERT_PTR_NOT_NULL(buff);
+    if (!p_sender || !buff) {
+        goto cleanup;
+    }
+
+    /* Two reports in a row: the second one comes from the template */
+    first_len = MCALL(p_sender_sess, rtcp_construct_report, 
+                      p_sender, (rtcptype *)buff, RTCP_PAK_SIZE,
+                      NULL, FALSE);
+    CU_ASSERT(first_len > 0);
+    check_sdes_cname(buff, first_len, p_sender->ssrc, cname_sender);
+    memset(buff, 0, RTCP_PAK_SIZE);
+    len = MCALL(p_sender_sess, rtcp_construct_report, 
+                p_sender, (rtcptype *)buff, RTCP_PAK_SIZE,
+                NULL, FALSE);
+    CU_ASSERT(len == first_len);
+    check_sdes_cname(buff, len, p_sender->ssrc, cname_sender);
+
+    /* CNAME change */
+    CU_ASSERT(rtp_update_member_cname(p_sender_sess, p_sender, 
+                                      cname_changed));
+    len = MCALL(p_sender_sess, rtcp_construct_report, 
+                p_sender, (rtcptype *)buff, RTCP_PAK_SIZE,
+                NULL, FALSE);
+    CU_ASSERT(len == first_len + 8);
+    check_sdes_cname(buff, len, p_sender->ssrc, cname_changed);
+
+    /* SSRC change */
+    new_ssrc = p_sender->ssrc + 1;
+    MCALL(p_sender_sess, rtp_update_local_ssrc, p_sender->ssrc, new_ssrc);
+    len = MCALL(p_sender_sess, rtcp_construct_report, 
+                p_sender, (rtcptype *)buff, RTCP_PAK_SIZE,
+                NULL, FALSE);
+    check_sdes_cname(buff, len, new_ssrc, cname_changed);
+
+    /* No room for the SDES packet */
+    len = MCALL(p_sender_sess, rtcp_construct_report, 
+                p_sender, (rtcptype *)buff, first_len - 4,
+                NULL, FALSE);
+    CU_ASSERT(len == 0);
+
+ cleanup:
+    free(buff);
+    MCALL(p_sender_sess, rtp_cleanup_session);
+    CU_ASSERT(0 == p_sender_sess->rtcp_nmembers);
+    CU_ASSERT(0 == p_sender_sess->rtcp_nsenders);
+}
+
+/*
+ * test_base_construct_report_template
+ *
+ * Test that the PUBPORTS and RSI packets of successive reports, which
+ * are copied from the session's report template, follow changes of the
+ * PUBPORTS info and RSI sub-reports, and that the RSI values are those
+ * of each report.  The base class method is called, as the SSM classes
+ * add RSI packets of their own.
+ */
+static rtcp_rsi_gaps_subrpt_t *find_rsi_gaps (uint8_t *buff, uint32_t len)
+{
+    rtcptype *p_rtcp;
+    rtcp_rsi_t *p_rsi;
+    rtcp_rsi_gen_subrpt_t *p_subrpt;
+    uint8_t *p_end;
+
+    p_rtcp = rtcp_find_msg((rtcptype *)buff, len, RTCP_RSI);
+    if (!p_rtcp) {
+        return (NULL);
+    }
+    p_rsi = (rtcp_rsi_t *)(p_rtcp + 1);
+    p_end = (uint8_t *)p_rtcp + ((ntohs(p_rtcp->len) + 1) << 2);
+    for (p_subrpt = (rtcp_rsi_gen_subrpt_t *)p_rsi->data;
+         (uint8_t *)(p_subrpt + 1) <= p_end && p_subrpt->length;
+         p_subrpt = (rtcp_rsi_gen_subrpt_t *)((uint8_t *)p_subrpt 
+                                              + (p_subrpt->length << 2))) {
+        if (p_subrpt->srbt == RTCP_RSI_GAPSB) {
+            return ((rtcp_rsi_gaps_subrpt_t *)p_subrpt);
+        }
+    }
+    return (NULL);
+}
+
+void test_base_construct_report_template(void)
+{
+    rtp_member_t   *p_sender = NULL;
+    uint32_t        len = 0, first_len = 0;
+    uint8_t        *buff = NULL;
+    rtcp_pkt_info_t pkt_info;
+    rtcp_msg_info_t pubports_msg, rsi_msg;
+    rtcptype       *p_rtcp;
+    rtcp_pubports_t *p_pubports;
+    rtcp_rsi_gaps_subrpt_t *p_gaps;
+    rtp_member_id_t member_id;
+
+    ipaddrtype src_addr_sender = 0xc0a83737;
+    uint16_t src_port_sender = 0x0401;
+    char cname_sender[] = "Sender (VAM)";
+
+    member_id.type = RTP_SMEMBER_ID_RTCP_DATA;
+    member_id.ssrc = 0;
+    member_id.subtype = RTCP_CHANNEL_MEMBER;
+    member_id.src_addr = src_addr_sender;
+    member_id.src_port = src_port_sender;
+    member_id.cname = cname_sender;
+    p_sender = MCALL(p_sender_sess, rtp_create_local_source, 
+                     &member_id, RTP_SELECT_RANDOM_SSRC);
+    CU_ASSERT_PTR_NOT_NULL(p_sender);
+
+    buff = malloc(RTCP_PAK_SIZE);
+    CU_ASSERT_PTR_NOT_NULL(buff);
+    if (!p_sender || !buff) {
+        goto cleanup;
+    }
+
+    rtcp_init_pkt_info(&pkt_info);
+    rtcp_init_msg_info(&pubports_msg);
+    pubports_msg.pubports_info.ssrc_media_sender = 0x01020304;
+    pubports_msg.pubports_info.rtp_port = 0x1234;
+    pubports_msg.pubports_info.rtcp_port = 0x4567;
+    rtcp_set_pkt_info(&pkt_info, RTCP_PUBPORTS, &pubports_msg);
+    rtcp_init_msg_info(&rsi_msg);
+    rtcp_set_rsi_subrpt_mask(&rsi_msg.rsi_info.subrpt_mask, RTCP_RSI_GAPSB);
+    rtcp_set_rsi_subrpt_mask(&rsi_msg.rsi_info.subrpt_mask, RTCP_RSI_BISB);
+    rtcp_set_pkt_info(&pkt_info, RTCP_RSI, &rsi_msg);
+
+    /* The second report is copied from the template, with new values */
+    p_sender_sess->rtcp_stats.avg_pkt_size = 100;
+    first_len = rtcp_construct_report_base(p_sender_sess,
+                                           p_sender, (rtcptype *)buff, 
+                                           RTCP_PAK_SIZE, &pkt_info, FALSE);
+    CU_ASSERT(first_len > 0);
+    p_gaps = find_rsi_gaps(buff, first_len);
+    CU_ASSERT_PTR_NOT_NULL(p_gaps);
+    if (p_gaps) {
+        CU_ASSERT(ntohs(p_gaps->average_packet_size) == 100);
+    }
+
+    memset(buff, 0, RTCP_PAK_SIZE);
+    p_sender_sess->rtcp_stats.avg_pkt_size = 200;
+    len = rtcp_construct_report_base(p_sender_sess,
+                                     p_sender, (rtcptype *)buff, 
+                                     RTCP_PAK_SIZE, &pkt_info, FALSE);
+    CU_ASSERT(len == first_len);
+    check_sdes_cname(buff, len, p_sender->ssrc, cname_sender);
+    p_gaps = find_rsi_gaps(buff, len);
+    CU_ASSERT_PTR_NOT_NULL(p_gaps);
+    if (p_gaps) {
+        CU_ASSERT(ntohs(p_gaps->average_packet_size) == 200);
+        CU_ASSERT(ntohl(p_gaps->group_size) == 
+                  p_sender_sess->rtcp_nmembers);
+    }
+    p_rtcp = rtcp_find_msg((rtcptype *)buff, len, RTCP_PUBPORTS);
+    CU_ASSERT_PTR_NOT_NULL(p_rtcp);
+    if (p_rtcp) {
+        p_pubports = (rtcp_pubports_t *)(p_rtcp + 1);
+        CU_ASSERT(ntohs(p_pubports->rtp_port) == 0x1234);
+    }
+
+    /* PUBPORTS info change */
+    pubports_msg.pubports_info.rtp_port = 0x2345;
+    len = rtcp_construct_report_base(p_sender_sess,
+                                     p_sender, (rtcptype *)buff, 
+                                     RTCP_PAK_SIZE, &pkt_info, FALSE);
+    CU_ASSERT(len == first_len);
+    p_rtcp = rtcp_find_msg((rtcptype *)buff, len, RTCP_PUBPORTS);
+    CU_ASSERT_PTR_NOT_NULL(p_rtcp);
+    if (p_rtcp) {
+        p_pubports = (rtcp_pubports_t *)(p_rtcp + 1);
+        CU_ASSERT(ntohs(p_pubports->rtp_port) == 0x2345);
+    }
+
+    /* RSI sub-reports change */
+    rtcp_clear_rsi_subrpt_mask(&rsi_msg.rsi_info.subrpt_mask, 
+                               RTCP_RSI_GAPSB);
+    len = rtcp_construct_report_base(p_sender_sess,
+                                     p_sender, (rtcptype *)buff, 
+                                     RTCP_PAK_SIZE, &pkt_info, FALSE);
+    CU_ASSERT(len == first_len - sizeof(rtcp_rsi_gaps_subrpt_t));
+    CU_ASSERT_PTR_NOT_NULL(rtcp_find_msg((rtcptype *)buff, len, RTCP_RSI));
+    CU_ASSERT_PTR_NULL(find_rsi_gaps(buff, len));
+
+    /* PUBPORTS no longer specified */
+    rtcp_init_pkt_info(&pkt_info);
+    len = rtcp_construct_report_base(p_sender_sess,
+                                     p_sender, (rtcptype *)buff, 
+                                     RTCP_PAK_SIZE, &pkt_info, FALSE);
+    CU_ASSERT_PTR_NULL(rtcp_find_msg((rtcptype *)buff, len, RTCP_PUBPORTS));
+    CU_ASSERT_PTR_NULL(rtcp_find_msg((rtcptype *)buff, len, RTCP_RSI));
+    check_sdes_cname(buff, len, p_sender->ssrc, cname_sender);
+
+ cleanup:
+    free(buff);
+    MCALL(p_sender_sess, rtp_cleanup_session);
+    CU_ASSERT(0 == p_sender_sess->rtcp_nmembers);
+    CU_ASSERT(0 == p_sender_sess->rtcp_nsenders);
+}
+
 /* 
  * Memory test checks remembered values of alloc_blocks against
  * current value.
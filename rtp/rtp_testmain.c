@@ -74,12 +74,16 @@ CU_TestInfo test_array_rtp_base_sender_report[] = {
     { "test base construct, parse sender report", test_base_sender_report },
     { "test base construct generic NACK", test_base_construct_gnack },
     { "test base construct PUBPORTS message", test_base_construct_pubports },
+    { "test base construct SDES", test_base_construct_sdes },
+    { "test base construct report template", 
+      test_base_construct_report_template },
     /* The memory test should be the last in the member suite. */
     { "test base sender report memory", test_base_sender_report_memory },
     CU_TEST_INFO_NULL,
 };
 CU_TestInfo test_array_rtp_asm_sess[] = {
     { "test asm session create", test_asm_sess_create },
+    { "test asm member hash index", test_asm_member_hash },
     { "test asm session delete", test_asm_sess_delete },
     CU_TEST_INFO_NULL,
 };
@@ -104,6 +108,7 @@ CU_TestInfo test_array_rtcp_xr[] = {
     { "test rtcp xr update with missing seq", test_rtcp_xr_missing_seq },
     { "test rtcp xr update with duplicated seq", test_rtcp_xr_dup_seq },
     { "test rtcp xr update with late arrival", test_rtcp_xr_late_arrival },
+    { "test rtcp xr update with a loss map", test_rtcp_xr_map },
     CU_TEST_INFO_NULL,
 };
 
@@ -35,6 +35,8 @@ void test_base_two_member_memory(void);
 void test_base_sender_report(void);
 void test_base_construct_gnack(void);
 void test_base_construct_pubports(void);
+void test_base_construct_sdes(void);
+void test_base_construct_report_template(void);
 void test_base_sender_report_memory(void);
 
 /*****************************************************************
@@ -53,6 +55,7 @@ int clean_asm_sender_report_suite(void);
  * Actual tests.
  */
 void test_asm_sess_create(void);
+void test_asm_member_hash(void);
 void test_asm_sess_delete(void);
 
 /*****************************************************************
@@ -126,3 +129,4 @@ void test_rtcp_xr_over_limit(void);
 void test_rtcp_xr_missing_seq(void);
 void test_rtcp_xr_dup_seq(void);
 void test_rtcp_xr_late_arrival(void);
+void test_rtcp_xr_map(void);
@@ -22,6 +22,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 #include <vam_time.h>
 
 #include "rtsp_client.h"
@@ -30,25 +31,23 @@
 #endif
 #include <vqec_debug.h>
 
-static rtsp_client_t client;
-static rtsp_ret_e ConnectServer(const char *host, int port);
-static rtsp_ret_e SendRequest (const char *abs_path,
-                               const char *accept_media_type);
-static rtsp_ret_e RecvResponse (abs_time_t abort_time);
-static int GetResponseLength (char *response);
-static rtsp_ret_e ValidateResponse (char *response);
-static int ReadLine (char* from_str, int first, int max, char* to_str);
+static rtsp_conn_t client_conn = { .socket = -1 };
+static rtsp_request_t client_req;
+
+static rtsp_ret_e rtsp_conn_check_connect(rtsp_conn_t *conn_p,
+                                          int timeout_ms);
+static rtsp_ret_e rtsp_request_parse(rtsp_request_t *req_p);
+static rtsp_ret_e rtsp_request_fail(rtsp_request_t *req_p, rtsp_ret_e err);
 
 /* Time allowed to establish TCP connection */
 #define RTSP_CLIENT_TCP_CONNECT_TIMEOUT_SECS 5
 /*
  * Timeout for reading received pkt(s) on TCP connection.
  *
- * Once the RTSP request has been sent, the RTSP client tries to read
- * the packets arriving from the server as the response.  The read calls
- * are blocking, so this defines the maximum amount of time to block upon
- * a read or else a failure is reported due to the inactivity on the 
- * connection.
+ * Once the RTSP request has been sent, the RTSP client waits for the
+ * packets arriving from the server as the response.  This defines the
+ * maximum amount of time to wait for the next packet, or else a failure
+ * is reported due to the inactivity on the connection.
  */
 #define RTSP_CLIENT_RESPONSE_FRAG_RECV_TIMEOUT_SECS 5
 
@@ -56,155 +55,50 @@ static int ReadLine (char* from_str, int first, int max, char* to_str);
 /* sa_ignore DISABLE_RETURNS fcntl */
 
 
-/*
- * The following function is modified based on the code from the book of 
- * "Unix Network Programming", (Second Edition) Volume 1, by W. Richard 
- * Stevens. We would like to acknowledge Richard Stevens for contributing 
- * the code in this function.
- *
+/* Function:    rtsp_conn_init
+ * Description: Initialize a connection structure as closed
+ * Parameters:  conn_p - connection
+ * Returns:     N/A
  */
-static int connect_nonb (int sockfd, 
-                         const struct sockaddr *saptr, 
-                         socklen_t salen, 
-                         int nsec)
+void rtsp_conn_init (rtsp_conn_t *conn_p)
 {
-    int		        flags, n, error;
-    socklen_t		len;
-    fd_set		rset, wset;
-    struct timeval	tval;
-
-    flags = fcntl(sockfd, F_GETFL, 0);
-    fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
-
-    error = 0;
-    if ((n = connect(sockfd, (struct sockaddr *) saptr, salen)) < 0) {
-        if (errno != EINPROGRESS) {
-            return (-1);
-        }
-    }
-
-    /* Do whatever we want while the connect is taking place. */
-    
-    if (n == 0) {
-        goto done;	/* connect completed immediately */
-    }
-
-    FD_ZERO(&rset);
-    FD_SET(sockfd, &rset);
-    wset = rset;
-    tval.tv_sec = nsec;
-    tval.tv_usec = 0;
-
-    if ((n = select(sockfd+1, &rset, &wset, NULL,
-                    nsec ? &tval : NULL)) == 0) {
-        close(sockfd);		/* timeout */
-        errno = ETIMEDOUT;
-        return (-1);
-    }
-
-    if (FD_ISSET(sockfd, &rset) || FD_ISSET(sockfd, &wset)) {
-        len = sizeof(error);
-        if (getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &error, &len) < 0) {
-            return (-1);			/* Solaris pending error */
-        }
-    } else {
-        VQEC_LOG_ERROR("connect_nonb:: sockfd not set\n");
-    }
-    
-done:
-    fcntl(sockfd, F_SETFL, flags);      /* restore file status flags */
-
-    if (error) {
-        close(sockfd);		/* just in case */
-        errno = error;
-        return (-1);
-    }
-
-    return (0);
+    memset(conn_p, 0, sizeof(rtsp_conn_t));
+    conn_p->socket = -1;
 }
 
 
-
-/* Function:    rtsp_client_init
- * Description: Initialize the RTSP client
- * Parameters:  name - RTSP server name
- *              port - RTSP server port
- * Returns:     Success or failed
- */
-rtsp_ret_e rtsp_client_init (const char *name, int port)
-{
-    rtsp_ret_e ret = RTSP_FAILURE;
-
-    if (name != NULL) {
-        strncpy(client.serverHost, name, MAX_NAME_LENGTH);
-        client.serverPort = port;
-
-        ret = ConnectServer(name, port);
-        client.cSeq = 0;
-        client.response.code = 0;
-        client.response.server = NULL;
-        client.response.data_buffer = NULL;
-        client.response.body = NULL;
-    }
-    else {
-        VQEC_LOG_ERROR("rtsp_client_init:: RTSP server name "
-                        "or IP address must be specified\n");
-    }
-
-    return ret;
-}
-
-
-/* Function:    rtsp_client_close
- * Description: Close the RTSP client
- * Parameters:  N/A
- * Returns:     Success or failed
- */
-rtsp_ret_e rtsp_client_close (void)
-{
-    if (client.socket) {
-        close(client.socket);
-    }
-
-    if (client.response.server) {
-        free(client.response.server);
-        client.response.server = NULL;
-    }
-
-    if (client.response.data_buffer) {
-        free(client.response.data_buffer);
-        client.response.data_buffer = NULL;
-    }
-
-    if (client.response.body) {
-        free(client.response.body);
-        client.response.body = NULL;
-    }
-
-    return RTSP_SUCCESS;
-}
-
-
-/* Function:    ConnectServer
- * Description: Open the socket connection to RTSP server
- * Parameters:  host - RTSP server name
- *              port - RTSP server port
+/* Function:    rtsp_conn_open
+ * Description: Open a non-blocking socket connection to an RTSP server.
+ *              The connection may still be in progress on return; it is
+ *              completed by the first request sent on it.
+ * Parameters:  conn_p - connection
+ *              host   - RTSP server name
+ *              port   - RTSP server port
  * Returns:     Success or failed
  */
 #define ERRBUF_LEN 80
-rtsp_ret_e ConnectServer (const char *host, int port)
+rtsp_ret_e rtsp_conn_open (rtsp_conn_t *conn_p, const char *host, int port)
 {
     int socket_type = SOCK_STREAM;
     struct sockaddr_in server;
     struct hostent *hp;
     char errbuf[ERRBUF_LEN];
+    int flags;
+
+    rtsp_conn_close(conn_p);
+
+    if (host == NULL || host[0] == '\0') {
+        VQEC_LOG_ERROR("rtsp_conn_open:: RTSP server name "
+                       "or IP address must be specified\n");
+        return RTSP_FAILURE;
+    }
 
     memset(&server, 0, sizeof(server));
 
     if (isalpha(host[0])) {   /* server address is a name */
         hp = gethostbyname(host);
         if (hp == NULL ) {
-            VQEC_LOG_ERROR("ConnectServer:: Host %s not found!\n", host);
+            VQEC_LOG_ERROR("rtsp_conn_open:: Host %s not found!\n", host);
             return RTSP_FAILURE;
         }
 
@@ -213,7 +107,7 @@ rtsp_ret_e ConnectServer (const char *host, int port)
     }
     else  { /* Simply just use it */
         if (inet_aton(host, &(server.sin_addr)) == 0) {
-            VQEC_LOG_ERROR("ConnectServer:: Invalid address %s is used!\n",
+            VQEC_LOG_ERROR("rtsp_conn_open:: Invalid address %s is used!\n",
                            host);
             return RTSP_FAILURE;
         }
@@ -222,95 +116,201 @@ rtsp_ret_e ConnectServer (const char *host, int port)
 
     server.sin_port = htons(port);
 
-    client.socket = socket(AF_INET, socket_type, 0); /* Open the socket */
-    if (client.socket < 0) {
-        VQEC_LOG_ERROR("ConnectServer:: Could not open the socket!\n");
+    conn_p->socket = socket(AF_INET, socket_type, 0); /* Open the socket */
+    if (conn_p->socket < 0) {
+        VQEC_LOG_ERROR("rtsp_conn_open:: Could not open the socket!\n");
+        conn_p->socket = -1;
         return RTSP_SOCKET_ERR;
     }
 
-    if (connect_nonb(client.socket,
-                     (struct sockaddr*)&server, 
-                     sizeof(server), 
-                     RTSP_CLIENT_TCP_CONNECT_TIMEOUT_SECS)
-        == SOCKET_ERROR) {
-        VQEC_LOG_ERROR("ConnectServer:: Could not connect to the server "
-                       "%s! (connect error: %s)\n", host,
-                       strerror_r(errno, errbuf, ERRBUF_LEN));
+    flags = fcntl(conn_p->socket, F_GETFL, 0);
+    fcntl(conn_p->socket, F_SETFL, flags | O_NONBLOCK);
+
+    strlcpy(conn_p->serverHost, host, MAX_NAME_LENGTH);
+    conn_p->serverPort = port;
+    conn_p->cSeq = 0;
+    conn_p->num_requests = 0;
+    conn_p->recv_start = 0;
+    conn_p->recv_end = 0;
+    conn_p->connecting = FALSE;
+
+    if (connect(conn_p->socket, (struct sockaddr*)&server,
+                sizeof(server)) < 0) {
+        if (errno != EINPROGRESS) {
+            VQEC_LOG_ERROR("rtsp_conn_open:: Could not connect to the "
+                           "server %s! (connect error: %s)\n", host,
+                           strerror_r(errno, errbuf, ERRBUF_LEN));
+            rtsp_conn_close(conn_p);
+            return RTSP_CONNECT_ERR;
+        }
+        conn_p->connecting = TRUE;
+    }
+
+    return RTSP_SUCCESS;
+}
+
+
+/* Function:    rtsp_conn_check_connect
+ * Description: Check whether the TCP connection of a connection in
+ *              progress has been established
+ * Parameters:  conn_p     - connection
+ *              timeout_ms - how long to wait for it
+ * Returns:     RTSP_SUCCESS once connected, RTSP_IN_PROGRESS, or
+ *              RTSP_CONNECT_ERR
+ */
+static rtsp_ret_e rtsp_conn_check_connect (rtsp_conn_t *conn_p,
+                                           int timeout_ms)
+{
+    struct pollfd pfd;
+    int error = 0;
+    socklen_t len = sizeof(error);
+    char errbuf[ERRBUF_LEN];
+
+    pfd.fd = conn_p->socket;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeout_ms) == 0) {
+        return RTSP_IN_PROGRESS;
+    }
+
+    if (getsockopt(conn_p->socket, SOL_SOCKET, SO_ERROR, &error, &len) < 0) {
+        error = errno;
+    }
+    if (error) {
+        VQEC_LOG_ERROR("rtsp_conn_check_connect:: Could not connect to the "
+                       "server %s! (connect error: %s)\n", conn_p->serverHost,
+                       strerror_r(error, errbuf, ERRBUF_LEN));
         return RTSP_CONNECT_ERR;
     }
 
+    conn_p->connecting = FALSE;
     return RTSP_SUCCESS;
 }
 
 
-/* Function:    rtsp_send_request
- * Description: Send out an DESCRIBE request and process the response
- * Parameters:  abs_path              - absolute ptah for rtsp url
- *              accept_media_type     - media types to include in RTSP header
- *              abort_time            - time after which reqyest should be
- *                                      aborted
- * Returns:     Success or failed
+/* Function:    rtsp_conn_is_open
+ * Description: Check whether a connection is open to the given server
+ * Parameters:  conn_p - connection
+ *              host   - RTSP server name
+ *              port   - RTSP server port
+ * Returns:     TRUE or FALSE
  */
-rtsp_ret_e rtsp_send_request (const char *abs_path,
-                              const char *accept_media_type,
-                              abs_time_t abort_time)
+boolean rtsp_conn_is_open (const rtsp_conn_t *conn_p,
+                           const char *host, int port)
 {
-    rtsp_ret_e ret;
+    return (conn_p->socket >= 0 &&
+            conn_p->serverPort == port &&
+            strncmp(conn_p->serverHost, host, MAX_NAME_LENGTH) == 0);
+}
 
-    if (!abs_path) {
-        return RTSP_SEND_ERR;
+
+/* Function:    rtsp_conn_get_fd
+ * Description: Get the socket of a connection
+ * Parameters:  conn_p - connection
+ * Returns:     The socket or -1 if the connection is closed
+ */
+int rtsp_conn_get_fd (const rtsp_conn_t *conn_p)
+{
+    return conn_p->socket;
+}
+
+
+/* Function:    rtsp_conn_close
+ * Description: Close a connection
+ * Parameters:  conn_p - connection
+ * Returns:     N/A
+ */
+void rtsp_conn_close (rtsp_conn_t *conn_p)
+{
+    if (conn_p->socket >= 0) {
+        close(conn_p->socket);
     }
-    ret = SendRequest(abs_path, accept_media_type);
-    if (ret != RTSP_SUCCESS) {
-        VQEC_LOG_ERROR("rtsp_send_request:: Failed sending DESCRIBE "
-                        "request to %s!\n",
-                        abs_path);
-        return RTSP_SEND_ERR;
+    conn_p->socket = -1;
+    conn_p->connecting = FALSE;
+    conn_p->recv_start = 0;
+    conn_p->recv_end = 0;
+}
+
+
+/* Function:    rtsp_request_init
+ * Description: Initialize a request structure
+ * Parameters:  req_p - request
+ * Returns:     N/A
+ */
+void rtsp_request_init (rtsp_request_t *req_p)
+{
+    memset(req_p, 0, sizeof(rtsp_request_t));
+    req_p->state = RTSP_REQ_IDLE;
+    req_p->err = RTSP_FAILURE;
+}
+
+
+/* Function:    rtsp_request_free
+ * Description: Free the response held by a request
+ * Parameters:  req_p - request
+ * Returns:     N/A
+ */
+void rtsp_request_free (rtsp_request_t *req_p)
+{
+    if (req_p->response.server) {
+        free(req_p->response.server);
+        req_p->response.server = NULL;
     }
-    else {
-        ret = RecvResponse(abort_time);
-        if (ret != RTSP_SUCCESS) {
-            VQEC_LOG_ERROR("rtsp_send_request:: Failed receiving "
-                            "the response!\n");
-            return RTSP_RESP_ERR;
-        }
-        else {
-            ret = ValidateResponse(client.response.data_buffer);
-        }
+
+    if (req_p->response.body) {
+        free(req_p->response.body);
+        req_p->response.body = NULL;
     }
 
-    return ret;
+    req_p->response.code = 0;
+    req_p->response.etag[0] = '\0';
 }
 
+
 #define RETURN_LEN 3
 #define SEQ_LENGTH 20
 
-/* Function:    SendRequest
- * Description: Send out the DESCRIBE message
- * Parameters:  abs_path - absolute path for rtsp url
+/* Function:    rtsp_request_start
+ * Description: Build a DESCRIBE request and queue it on a connection
+ * Parameters:  req_p             - request
+ *              conn_p            - connection to send it on
+ *              abs_path          - absolute path for rtsp url
  *              accept_media_type - accepted media for "Accept" field
  *                                  (may be NULL) 
+ *              if_none_match     - entity tag for "If-None-Match" field
+ *                                  (may be NULL)
  * Returns:     Success or failed
  */
-rtsp_ret_e SendRequest (const char *abs_path,
-                        const char *accept_media_type)
+rtsp_ret_e rtsp_request_start (rtsp_request_t *req_p,
+                               rtsp_conn_t *conn_p,
+                               const char *abs_path,
+                               const char *accept_media_type,
+                               const char *if_none_match)
 { 
-    rtsp_ret_e ret = RTSP_SUCCESS;
-    int len, cur = 0;
+    int len;
     char nl[RETURN_LEN] = "\r\n";
-    char reqString[MAX_BUFFER_LENGTH];
-    char *send_p;
+    char *reqString = req_p->send_buf;
     char seqNum[SEQ_LENGTH];
 
+    rtsp_request_free(req_p);
+    req_p->conn_p = conn_p;
+
+    if (!abs_path || conn_p->socket < 0) {
+        req_p->state = RTSP_REQ_FAILED;
+        req_p->err = RTSP_SEND_ERR;
+        return RTSP_SEND_ERR;
+    }
+
     /* Construct the DESCRIBE message */
+    req_p->cSeq = ++conn_p->cSeq;
     snprintf(reqString, MAX_BUFFER_LENGTH, "DESCRIBE ");
     len = strlcat(reqString, "rtsp://", MAX_BUFFER_LENGTH);
-    len = strlcat(reqString, client.serverHost, MAX_BUFFER_LENGTH);
+    len = strlcat(reqString, conn_p->serverHost, MAX_BUFFER_LENGTH);
     len = strlcat(reqString, "/", MAX_BUFFER_LENGTH);
     len = strlcat(reqString, abs_path, MAX_BUFFER_LENGTH);
     len = strlcat(reqString, " RTSP/1.0", MAX_BUFFER_LENGTH);
     len = strlcat(reqString, nl, MAX_BUFFER_LENGTH);
-    snprintf(seqNum, SEQ_LENGTH, "%d", ++client.cSeq);
+    snprintf(seqNum, SEQ_LENGTH, "%u", req_p->cSeq);
     len = strlcat(reqString, "CSeq: ", MAX_BUFFER_LENGTH);
     len = strlcat(reqString, seqNum, MAX_BUFFER_LENGTH);
     len = strlcat(reqString, nl, MAX_BUFFER_LENGTH);
@@ -319,457 +319,543 @@ rtsp_ret_e SendRequest (const char *abs_path,
         len = strlcat(reqString, accept_media_type, MAX_BUFFER_LENGTH);
         len = strlcat(reqString, nl, MAX_BUFFER_LENGTH);
     }
+    if (if_none_match) {
+        len = strlcat(reqString, "If-None-Match: \"", MAX_BUFFER_LENGTH);
+        len = strlcat(reqString, if_none_match, MAX_BUFFER_LENGTH);
+        len = strlcat(reqString, "\"", MAX_BUFFER_LENGTH);
+        len = strlcat(reqString, nl, MAX_BUFFER_LENGTH);
+    }
     len = strlcat(reqString, nl, MAX_BUFFER_LENGTH);
-    len = strlcat(reqString, "\0", MAX_BUFFER_LENGTH);
     if (len >= MAX_BUFFER_LENGTH) {
+        req_p->state = RTSP_REQ_FAILED;
+        req_p->err = RTSP_INTERNAL_ERR;
         return RTSP_INTERNAL_ERR;
     }
 
-    send_p = reqString;
+    VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+               "rtsp_request_start:: Sending request:\n\n%s\n", reqString);
+
+    req_p->send_len = len;
+    req_p->send_off = 0;
+    req_p->cseq_matched = FALSE;
+    req_p->conn_close = FALSE;
+    req_p->content_length = 0;
+    req_p->body_len = 0;
+    req_p->scan_off = 0;
+    req_p->err = RTSP_IN_PROGRESS;
+    req_p->state = RTSP_REQ_SENDING;
+    conn_p->num_requests++;
 
-    /* Clear the response data in client */
-    client.response.code = 0;
-    if (client.response.data_buffer) {
-        free(client.response.data_buffer);
-        client.response.data_buffer = NULL;
-    }
+    return RTSP_SUCCESS;
+}
 
-    if (client.response.body) {
-        free(client.response.body);
-        client.response.body = NULL;
-    }
 
-    VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-               "SendRequest:: Sending request:\n\n%s\n", reqString);
-
-    while (len > 0) {
-        if ((cur = send(client.socket, send_p, len-cur, 0)) == SOCKET_ERROR) {
-            VQEC_LOG_ERROR("SendRequest:: Socket error occured in "
-                            "sending the request\n");
-            ret = RTSP_SOCKET_ERR;
-            break;
-        }
-        else {
-            send_p += cur; 
-            len -= cur;
-        }
+/* Function:    rtsp_request_get_events
+ * Description: Get the events a request is waiting for on its socket
+ * Parameters:  req_p - request
+ * Returns:     POLLOUT while connecting or sending, POLLIN while
+ *              receiving, 0 once complete
+ */
+int rtsp_request_get_events (const rtsp_request_t *req_p)
+{
+    switch (req_p->state) {
+    case RTSP_REQ_SENDING:
+        return POLLOUT;
+    case RTSP_REQ_STATUS:
+    case RTSP_REQ_HEADERS:
+    case RTSP_REQ_BODY:
+        return POLLIN;
+    default:
+        return 0;
     }
-  
-    return ret;
 }
 
 
-/* Function:    RecvResponse
- * Description: Receive the response to the DESCRIBE request
- * Parameters:  abort_time  - time after which receive should be aborted
- * Returns:     Success or failed
+/* Function:    rtsp_request_fail
+ * Description: Fail a request.  The state of the connection is unknown
+ *              after a failure, so it is closed.
+ * Parameters:  req_p - request
+ *              err   - reason of the failure
+ * Returns:     err
+ */
+static rtsp_ret_e rtsp_request_fail (rtsp_request_t *req_p, rtsp_ret_e err)
+{
+    req_p->state = RTSP_REQ_FAILED;
+    req_p->err = err;
+    rtsp_request_free(req_p);
+    rtsp_conn_close(req_p->conn_p);
+    return err;
+}
+
+
+/* Function:    rtsp_request_process
+ * Description: Send the request and receive and parse the response as
+ *              far as the socket allows without blocking
+ * Parameters:  req_p - request
+ * Returns:     RTSP_IN_PROGRESS, RTSP_SUCCESS once the whole response
+ *              has been received, or failed
  */
-rtsp_ret_e RecvResponse (abs_time_t abort_time)
+rtsp_ret_e rtsp_request_process (rtsp_request_t *req_p)
 {
+    rtsp_conn_t *conn_p = req_p->conn_p;
+    rtsp_ret_e ret;
     int len;
-    char resp[MAX_BUFFER_LENGTH];
-    int total_length;
-    int acc_len;
-    int req_len = MAX_BUFFER_LENGTH;
-    int rv;
-    struct timeval timeout;
-
-    /*
-     * The socket is blocking and consequently the recv syscall will block until
-     * a TCP fragment is received or a timeout is reached. If the timeout
-     * is reached the method will immediately free the response data buffer
-     * and return declaring failure. The timeout value is arbitrarily chosen. 
-     * The socket will return with EAGAIN when there is a timeout. 
-     *
-     * It is also possible that there are multiple TCP fragments and while no
-     * timeouts are seen, an update continues to be active. Thus the total
-     * time for receiving a complete response has been bounded as well.
-     */ 
-    timeout.tv_sec = RTSP_CLIENT_RESPONSE_FRAG_RECV_TIMEOUT_SECS;
-    timeout.tv_usec = 0;
-    rv = setsockopt(client.socket, SOL_SOCKET, 
-                    SO_RCVTIMEO, &timeout, sizeof(timeout));
-    if (rv) {
-        VQEC_LOG_ERROR("RecvResponse:: Error in setting socket option \n");
-        return RTSP_SOCKET_ERR;
+
+    if (req_p->state == RTSP_REQ_DONE || req_p->state == RTSP_REQ_FAILED ||
+        req_p->state == RTSP_REQ_IDLE) {
+        return req_p->err;
     }
-    
-    bzero(resp, MAX_BUFFER_LENGTH);
-    /* Peek the message first to figure out the content length */
-    if ((len = recv(client.socket, resp, MAX_BUFFER_LENGTH, MSG_PEEK))
-        != SOCKET_ERROR) {
-        VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-                   "RecvResponse:: Received the first byte ...\n");
-        total_length = GetResponseLength(resp);
-        req_len += total_length;
-
-        /* Check the size of the request */
-        if (req_len > MAX_BUFFER_LENGTH * MAX_CHANNELS) {
-            VQEC_LOG_ERROR("RecvResponse:: Ask too much memory "
-                            "in receiving the response\n");
-            return RTSP_MALLOC_ERR;
-        }
 
-        /* Allocate the memory for response data */
-        client.response.data_buffer = malloc(sizeof(char) * req_len);
-        if (client.response.data_buffer == NULL) {
-            VQEC_LOG_ERROR("RecvResponse:: Memory allocation error occured "
-                            "in receiving the response\n");
-            return RTSP_MALLOC_ERR;
+    if (conn_p->connecting) {
+        ret = rtsp_conn_check_connect(conn_p, 0);
+        if (ret != RTSP_SUCCESS) {
+            return (ret == RTSP_IN_PROGRESS) ?
+                ret : rtsp_request_fail(req_p, ret);
         }
+    }
 
-        /* Reset the memory */
-        memset(client.response.data_buffer, 0, req_len);
-
-        bzero(resp, MAX_BUFFER_LENGTH);
-        acc_len = 0;
-        
-        while ((len = recv(client.socket, resp, MAX_BUFFER_LENGTH, 0))) {
-
-            if (len <= 0) {
-
-                /*
-                 * EAGAIN is nominally returned when there is a timeout or the
-                 * socket has been closed - abort reception in that case.
-                 */
-                if (errno == ECONNRESET || errno == EAGAIN) {
-                    VQEC_LOG_ERROR("RecvResponse:: Socket error occured "
-                                   "in receiving the response (ECONNRESET / EAGAIN)\n");
-                    free(client.response.data_buffer);
-                    client.response.data_buffer = NULL;        
-                    return RTSP_SOCKET_ERR;
-                }
-            }
-            else {
-                strncat(client.response.data_buffer, resp, len);
-                acc_len += len;
-                if (acc_len > total_length) {
-                    break;
-                }
-                VQEC_DEBUG(VQEC_DEBUG_UPDATER, 
-                           "Received fragment %d/%d/%d\n", 
-                           len, acc_len, total_length);
-
-                bzero(resp, MAX_BUFFER_LENGTH);
+    while (req_p->state == RTSP_REQ_SENDING) {
+        len = send(conn_p->socket, req_p->send_buf + req_p->send_off,
+                   req_p->send_len - req_p->send_off, MSG_NOSIGNAL);
+        if (len == SOCKET_ERROR) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return RTSP_IN_PROGRESS;
+            } else if (errno != EINTR) {
+                VQEC_LOG_ERROR("rtsp_request_process:: Socket error occured "
+                               "in sending the request\n");
+                return rtsp_request_fail(req_p, RTSP_SEND_ERR);
             }
-            
-            if (TIME_CMP_A(gt, get_sys_time(), abort_time)) {
-                VQEC_LOG_ERROR("RecvResponse:: maximum timeout exceeded\n");
-                free(client.response.data_buffer);
-                client.response.data_buffer = NULL;
-                return RTSP_SOCKET_ERR;                
+        } else {
+            req_p->send_off += len;
+            if (req_p->send_off == req_p->send_len) {
+                req_p->state = RTSP_REQ_STATUS;
             }
         }
+    }
 
-        VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-                   "RecvResponse:: Received %d bytes ...\n", acc_len);
+    /* Parse what has been received, then read whatever else is there */
+    for (;;) {
+        ret = rtsp_request_parse(req_p);
+        if (ret != RTSP_IN_PROGRESS) {
+            return ret;
+        }
 
-        return RTSP_SUCCESS;
+        /* Make room for more data behind the unconsumed part */
+        if (conn_p->recv_start > 0) {
+            memmove(conn_p->recv_buf, conn_p->recv_buf + conn_p->recv_start,
+                    conn_p->recv_end - conn_p->recv_start);
+            conn_p->recv_end -= conn_p->recv_start;
+            conn_p->recv_start = 0;
+        }
+
+        len = recv(conn_p->socket, conn_p->recv_buf + conn_p->recv_end,
+                   MAX_BUFFER_LENGTH - conn_p->recv_end, 0);
+        if (len == 0) {
+            VQEC_LOG_ERROR("rtsp_request_process:: Connection closed by "
+                           "the server in receiving the response\n");
+            return rtsp_request_fail(req_p, RTSP_RESP_ERR);
+        } else if (len == SOCKET_ERROR) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return RTSP_IN_PROGRESS;
+            } else if (errno != EINTR) {
+                VQEC_LOG_ERROR("rtsp_request_process:: Socket error occured "
+                               "in receiving the response\n");
+                return rtsp_request_fail(req_p, RTSP_RESP_ERR);
+            }
+        } else {
+            VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+                       "Received fragment %d/%d/%d\n", 
+                       len, req_p->body_len, req_p->content_length);
+            conn_p->recv_end += len;
+        }
     }
-    else {
-        VQEC_LOG_ERROR("RecvResponse:: Socket error occured in receiving "
-                        "the response\n");
-        return RTSP_SOCKET_ERR;
-    }	
 }
 
+
 #define STRING_LEN 30
 
-/* Function:    GetResponseLength
- * Description: Get the content length of response message
- * Parameters:  response - response message
- * Returns:     Success or failed
+/* Function:    rtsp_request_header
+ * Description: Process a header line of the response
+ * Parameters:  req_p  - request
+ *              buffer - the header line, without its line terminator
+ * Returns:     RTSP_IN_PROGRESS, or failed
  */
-int GetResponseLength (char* response)
+static rtsp_ret_e rtsp_request_header (rtsp_request_t *req_p, char *buffer)
 {
-    int cur, len;
-    int resp_len;
-    char buffer[MAX_LINE_SIZE];
-    char *resp;
     char string_buffer[STRING_LEN];
-    int response_code = 0;
-    int cSeq;
-    int length = 0;
-
-    /* Figure out the status of response first */
-    cur = 0;
-    resp_len = strlen(response);
-    resp = malloc(sizeof(char) * resp_len);
-    if (resp == NULL) {
-        VQEC_LOG_ERROR("GetResponseLength:: Failed to allocate memory\n");
-        return 0;
-    }
+    char type[MAX_LINE_SIZE];
+    unsigned int cSeq = 0;
+    const char *value;
+    int len;
 
-    strncpy(resp, response, resp_len);
-    if ((len = ReadLine(resp, cur, resp_len, buffer)) != -1) {
-        if (strncasecmp(buffer, "RTSP/1.0", 8) == 0) {
-            /* Extract the response code */
-            sscanf(buffer, "%20s %d",
-                   string_buffer, &response_code);
+    /* Check the cSeq number */
+    if (strncasecmp(buffer, "CSeq:", 5) == 0) {
+        /* Extract the c-sequence number */
+        sscanf(buffer, "%20s %u", string_buffer, &cSeq);
+
+        if (cSeq != req_p->cSeq) {
+            VQEC_LOG_ERROR("rtsp_request_header:: Mismatch CSeq %u "
+                           "in response\n",
+                           cSeq);
+            return RTSP_INVALID_RESP;
+        }
+        req_p->cseq_matched = TRUE;
+    } else if (strncasecmp(buffer, "Server:", 7) == 0) {
+        /* 
+         * We expect the format:  "Server: <version>"
+         * Everything following "Server: " is considered to be the version
+         */
+        value = buffer + 7;
+        if (*value == ' ') {
+            value++;
+        }
+        if (req_p->response.server) {
+            free(req_p->response.server);
+        }
+        req_p->response.server = strdup(value);
+        if (!req_p->response.server) {
+            VQEC_LOG_ERROR("rtsp_request_header:: Failed to allocate "
+                           "memory for server field\n");
+            return RTSP_MALLOC_ERR;
+        }
+    } else if (strncasecmp(buffer, "Content-Type:", 13) == 0) {
+        /* Check for content type */
+        sscanf(buffer, "%20s %1000s", string_buffer, type);
+
+        if ((strcmp(type, MEDIA_TYPE_APP_SDP) != 0) &&
+            (strcmp(type, MEDIA_TYPE_APP_PLAIN_TEXT) != 0)) {
+            VQEC_LOG_ERROR("rtsp_request_header:: Unknown "
+                           "content type %s\n",
+                           type);
+            return RTSP_INVALID_RESP;
+        }
+    } else if (strncasecmp(buffer, "Content-Length:", 15) == 0) {
+        sscanf(buffer, "%20s %d", string_buffer, &req_p->content_length);
+        if (req_p->content_length < 0 ||
+            req_p->content_length > MAX_BUFFER_LENGTH * MAX_CHANNELS) {
+            VQEC_LOG_ERROR("rtsp_request_header:: Ask to malloc too much "
+                           "memory for response body\n");
+            return RTSP_MALLOC_ERR;
         }
-        else {
-            VQEC_LOG_ERROR("GetResponseLength:: Invalid RTSP response:"
-                            "\n\n%s\n",
-                            response);
-            free(resp);
-            return 0;
+    } else if (strncasecmp(buffer, "ETag:", 5) == 0) {
+        /* Keep the entity tag without its quotes */
+        value = buffer + 5;
+        while (*value == ' ' || *value == '"') {
+            value++;
+        }
+        len = strlcpy(req_p->response.etag, value, RTSP_ETAG_LENGTH);
+        if (len > 0 && len < RTSP_ETAG_LENGTH &&
+            req_p->response.etag[len - 1] == '"') {
+            req_p->response.etag[len - 1] = '\0';
+        }
+    } else if (strncasecmp(buffer, "Connection:", 11) == 0) {
+        if (strstr(buffer + 11, "close") || strstr(buffer + 11, "Close")) {
+            req_p->conn_close = TRUE;
         }
     }
 
-    /* Process the response header */
-    if (response_code == MSG_200_OK) {
-        cur = len; 
-        while ((len = ReadLine(resp, cur, resp_len, buffer)) != -1) {
-            /* Check the cSeq number */
-            if (strncasecmp(buffer, "CSeq:", 5) == 0) {
-                /* Extract the c-sequence number */
-                sscanf(buffer, "%20s %d",
-                       string_buffer, &cSeq);
-            
-                if (cSeq != client.cSeq) {
-                    VQEC_LOG_ERROR("GetResponseLength:: Mismatch CSeq %d "
-                                    "in response\n",
-                                    cSeq);
-                    free(resp);
-                    return 0;
-                }
-
-                cur += len;
-            }
-            else {
-                /* Check for content type */
-                if (strncasecmp(buffer, "Content-Type:", 13) == 0) {
-                    /* Extract the content type */
-                    char type[STRING_LEN];
-                    sscanf(buffer, "%20s %30s",
-                           string_buffer, type);
-
-                    if ((strcmp(type, MEDIA_TYPE_APP_SDP) != 0) &&
-                        (strcmp(type, MEDIA_TYPE_APP_PLAIN_TEXT) != 0)) {
-                        VQEC_LOG_ERROR("GetResponseLength:: Unknown "
-                                        "content type %s\n",
-                                        type);
-                        free(resp);
-                        return 0;
-                    }
-
-                    cur += len;
-                }
-                else {
-                    /* Check for content length */
-                    if (strncasecmp(buffer, "Content-Length:", 15) == 0) {
-                        /* Extract the content type */
-                        sscanf(buffer, "%20s %d",
-                               string_buffer, &length);
-                        
-                        cur += len;
-                    }
-                    else {
-                        /* If we hit the empty line, this is */
-                        /* beginning of response body */
-                        if (strlen(buffer) != 0) {
-                            cur += len;
-                        }
-                        else {
-                            free(resp);
-
-                            /* Found the beginning of body */
-                            /* We return the header length */
-                            /* plus the content length */
-                            return cur+length;
-                        }
-                    }
-                }
-            }
-        }
+    return RTSP_IN_PROGRESS;
+}
+
+
+/* Function:    rtsp_request_complete
+ * Description: Finish a request once its whole response has arrived
+ * Parameters:  req_p - request
+ * Returns:     RTSP_SUCCESS
+ */
+static rtsp_ret_e rtsp_request_complete (rtsp_request_t *req_p)
+{
+    /* The body is only kept from a good response to this request */
+    if (req_p->response.body &&
+        (req_p->response.code != MSG_200_OK || !req_p->cseq_matched)) {
+        free(req_p->response.body);
+        req_p->response.body = NULL;
     }
-    else {
-        VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-                   "GetResponseLength:: Not 200 OK response:\n\n%s\n",
-                   response);
 
-        free(resp);
-        return 0;
+    if (req_p->response.body) {
+        /* Make sure that it is null terminated */
+        req_p->response.body[req_p->content_length] = '\0';
+        req_p->response.body[req_p->content_length - 1] = '\n';
     }
 
-    free(resp);
-    return 0;
+    VQEC_DEBUG(VQEC_DEBUG_UPDATER,
+               "rtsp_request_complete:: Received response %d with "
+               "%d bytes of body\n",
+               req_p->response.code, req_p->body_len);
+
+    req_p->state = RTSP_REQ_DONE;
+    req_p->err = RTSP_SUCCESS;
+    if (req_p->conn_close) {
+        rtsp_conn_close(req_p->conn_p);
+    }
+    return RTSP_SUCCESS;
 }
 
 
-/* Function:    ValidateResponse
- * Description: Validate the response message
- * Parameters:  response - response message
- * Returns:     Success or failed
+/* Function:    rtsp_request_parse
+ * Description: Parse the part of the response received so far.  Each
+ *              byte is examined once: complete header lines are consumed
+ *              as they arrive and the body is copied straight out of the
+ *              receive buffer.
+ * Parameters:  req_p - request
+ * Returns:     RTSP_IN_PROGRESS if more data is needed, RTSP_SUCCESS
+ *              once the response is complete, or failed
  */
-rtsp_ret_e ValidateResponse (char* response)
+static rtsp_ret_e rtsp_request_parse (rtsp_request_t *req_p)
 {
-    int cur, len;
-    int resp_len;
-    char buffer[MAX_LINE_SIZE];
-    char *resp;
+    rtsp_conn_t *conn_p = req_p->conn_p;
     char string_buffer[STRING_LEN];
-    int response_code = 0;
-    int cSeq = 0;
-    int length = 0;
-    rtsp_ret_e err = RTSP_SUCCESS;
+    char *line, *eol;
+    int avail, len;
+    rtsp_ret_e ret;
 
-    VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-               "ValidateResponse:: Starting to validate "
-               "the response ...\n");
-
-    /* Figure out the status of response first */
-    cur = 0;
-    resp_len = strlen(response);
-    resp = malloc(sizeof(char) * resp_len);
-    if (resp == NULL) {
-        VQEC_LOG_ERROR("ValidateResponse:: Failed to allocate memory\n");
-        err = RTSP_MALLOC_ERR;
-        goto done;
-    }
-
-    strncpy(resp, response, resp_len);
-    if ((len = ReadLine(resp, cur, resp_len, buffer)) != -1) {
-        if (strncasecmp(buffer, "RTSP/1.0", 8) == 0) {
+    while (req_p->state == RTSP_REQ_STATUS ||
+           req_p->state == RTSP_REQ_HEADERS) {
+        line = conn_p->recv_buf + conn_p->recv_start;
+        avail = conn_p->recv_end - conn_p->recv_start;
+        eol = memchr(line + req_p->scan_off, '\n', avail - req_p->scan_off);
+        if (eol == NULL) {
+            req_p->scan_off = avail;
+            if (avail >= MAX_LINE_SIZE) {
+                VQEC_LOG_ERROR("rtsp_request_parse:: Very long lines "
+                               "received from the server!\n");
+                return rtsp_request_fail(req_p, RTSP_INVALID_RESP);
+            }
+            return RTSP_IN_PROGRESS;
+        }
+
+        /* We support "\r\n" and "\n" line termination */
+        len = eol - line;
+        conn_p->recv_start += len + 1;
+        req_p->scan_off = 0;
+        *eol = '\0';
+        if (len > 0 && line[len - 1] == '\r') {
+            line[--len] = '\0';
+        }
+
+        if (req_p->state == RTSP_REQ_STATUS) {
+            if (strncasecmp(line, "RTSP/1.0", 8) != 0) {
+                VQEC_LOG_ERROR("rtsp_request_parse:: Invalid RTSP response:"
+                               "\n\n%s\n",
+                               line);
+                return rtsp_request_fail(req_p, RTSP_INVALID_RESP);
+            }
             /* Extract the response code */
-            sscanf(buffer, "%20s %d",
-                   string_buffer, &response_code);
+            sscanf(line, "%20s %d", string_buffer, &req_p->response.code);
+            req_p->state = RTSP_REQ_HEADERS;
+        } else if (len != 0) {
+            ret = rtsp_request_header(req_p, line);
+            if (ret != RTSP_IN_PROGRESS) {
+                return rtsp_request_fail(req_p, ret);
+            }
+        } else {
+            /* The empty line ends the header */
+            if (req_p->content_length == 0) {
+                return rtsp_request_complete(req_p);
+            }
+            req_p->response.body = malloc(req_p->content_length + 1);
+            if (req_p->response.body == NULL) {
+                VQEC_LOG_ERROR("rtsp_request_parse:: Failed to allocate "
+                               "memory for response body\n");
+                return rtsp_request_fail(req_p, RTSP_MALLOC_ERR);
+            }
+            req_p->state = RTSP_REQ_BODY;
+        }
+    }
 
-            client.response.code = response_code;
+    if (req_p->state == RTSP_REQ_BODY) {
+        avail = conn_p->recv_end - conn_p->recv_start;
+        len = req_p->content_length - req_p->body_len;
+        if (len > avail) {
+            len = avail;
         }
-        else {
-            VQEC_LOG_ERROR("ValidateResponse:: Invalid RTSP response:"
-                            "\n\n%s\n",
-                            response);
-            err = RTSP_INVALID_RESP;
-            goto done;
+        memcpy(req_p->response.body + req_p->body_len,
+               conn_p->recv_buf + conn_p->recv_start, len);
+        req_p->body_len += len;
+        conn_p->recv_start += len;
+        if (req_p->body_len == req_p->content_length) {
+            return rtsp_request_complete(req_p);
         }
     }
 
-    /* Process the response header */
-    cur = len; 
-    while ((len = ReadLine(resp, cur, resp_len, buffer)) != -1) {
-        /* Check the cSeq number */
-        if (strncasecmp(buffer, "CSeq:", 5) == 0) {
-            /* Extract the c-sequence number */
-            sscanf(buffer, "%20s %d",
-                   string_buffer, &cSeq);
-
-            if (cSeq != client.cSeq) {
-                VQEC_LOG_ERROR("ValidateResponse:: Mismatch CSeq %d "
-                                "in response\n",
-                                cSeq);
-                err = RTSP_INVALID_RESP;
-                goto done;
-            }
+    return RTSP_IN_PROGRESS;
+}
+
+
+/* Function:    rtsp_request_wait
+ * Description: Process a request until it completes, blocking on its
+ *              socket in between
+ * Parameters:  req_p      - request
+ *              abort_time - time after which the request should be
+ *                           aborted
+ * Returns:     Success or failed
+ */
+rtsp_ret_e rtsp_request_wait (rtsp_request_t *req_p, abs_time_t abort_time)
+{
+    struct pollfd pfd;
+    rel_time_t remaining;
+    int timeout_ms, n;
+    rtsp_ret_e ret;
 
-            cur += len;
+    while ((ret = rtsp_request_process(req_p)) == RTSP_IN_PROGRESS) {
+        /*
+         * Wait for the socket, but no longer than the connection may be
+         * idle, nor past the time the whole response is due.
+         */
+        if (TIME_CMP_A(gt, get_sys_time(), abort_time)) {
+            VQEC_LOG_ERROR("rtsp_request_wait:: maximum timeout exceeded\n");
+            return rtsp_request_fail(req_p, RTSP_RESP_ERR);
         }
-        else {
-            /* 
-             * Check for Server
-             * We expect the format:  "Server: <version>"
-             * Everything following "Server: " is considered to be the version
-             */
-            if (strncasecmp(buffer, "Server:", 7) == 0) {
-                /* Allocate room for <version> plus a terminating NULL */
-                client.response.server = malloc(sizeof(char) * (len - 6));
-                memset(client.response.server, 0, sizeof(char) * (len - 6));
-                if (!client.response.server) {
-                    VQEC_LOG_ERROR("ValidateResponse:: Failed to allocate "
-                                   "memory for server field\n");
-                    err = RTSP_MALLOC_ERR;
-                    goto done;
-                }
-                /* Copy the version, starting just after the whitespace */
-                strncpy(client.response.server, buffer + 8, len - 8);
-                
-                cur += len;
-            }
-            else {
-                /* Check for content type */
-                if (strncasecmp(buffer, "Content-Type:", 13) == 0) {
-                    /* Extract the content type */
-                    char type[MAX_LINE_SIZE];
-                    sscanf(buffer, "%20s %s",
-                           string_buffer, type);
-                    
-                    if ((strcmp(type, MEDIA_TYPE_APP_SDP) != 0) &&
-                        (strcmp(type, MEDIA_TYPE_APP_PLAIN_TEXT) != 0)) {
-                        VQEC_LOG_ERROR("ValidateResponse:: Unknown "
-                                       "content type %s\n",
-                                       type);
-                        err = RTSP_INVALID_RESP;
-                        goto done;
-                    }
-                    
-                    cur += len;
-                }
-                else {
-                    /* Check for content length */
-                    if (strncasecmp(buffer, "Content-Length:", 15) == 0) {
-                        /* Extract the content type */
-                        sscanf(buffer, "%20s %d",
-                               string_buffer, &length);
-                        
-                        cur += len;
-                    }
-                    else {
-                        /* If we hit the empty line, this is */
-                        /* beginning of response body */
-                        if (strlen(buffer) != 0) {
-                            cur += len;
-                        }
-                        else {
-                            /* Found the beginning of body */
-                            break;
-                        }
-                    }
-                }
-            }
+        remaining = TIME_SUB_A_A(abort_time, get_sys_time());
+        timeout_ms = (req_p->conn_p->connecting ?
+                      RTSP_CLIENT_TCP_CONNECT_TIMEOUT_SECS :
+                      RTSP_CLIENT_RESPONSE_FRAG_RECV_TIMEOUT_SECS) * 1000;
+        if (TIME_CMP_R(lt, remaining, TIME_MK_R(msec, timeout_ms))) {
+            timeout_ms = TIME_GET_R(msec, remaining) + 1;
         }
-    }
 
-    /* Now, extract the body data */
-    cur += len;
-    if (response_code == MSG_200_OK && 
-        cSeq == client.cSeq && length != 0) {
-        if (length > MAX_BUFFER_LENGTH * MAX_CHANNELS) {
-            VQEC_LOG_ERROR("ValidateResponse:: Ask to malloc too much "
-                            "memory for response body\n");
-            err = RTSP_MALLOC_ERR;
-            goto done;
+        pfd.fd = rtsp_conn_get_fd(req_p->conn_p);
+        pfd.events = req_p->conn_p->connecting ?
+            POLLOUT : rtsp_request_get_events(req_p);
+        pfd.revents = 0;
+        n = poll(&pfd, 1, timeout_ms);
+        if (n == 0 && !TIME_CMP_A(gt, get_sys_time(), abort_time)) {
+            VQEC_LOG_ERROR("rtsp_request_wait:: No data from the server "
+                           "%s for %d seconds\n", req_p->conn_p->serverHost,
+                           timeout_ms / 1000);
+            return rtsp_request_fail(req_p, req_p->conn_p->connecting ?
+                                     RTSP_CONNECT_ERR : RTSP_RESP_ERR);
+        } else if (n < 0 && errno != EINTR) {
+            return rtsp_request_fail(req_p, RTSP_RESP_ERR);
         }
+    }
+
+    return ret;
+}
+
+
+/* Function:    rtsp_request_get_response_code
+ * Description: return the response code of a request
+ * Parameters:  req_p - request
+ * Returns:     response code
+ */
+int rtsp_request_get_response_code (const rtsp_request_t *req_p)
+{
+    return req_p->response.code;
+}
+
+
+/* Function:    rtsp_request_get_response_server
+ * Description: return the "Server" field of the response to a request
+ * Parameters:  req_p - request
+ * Returns:     "Server" string contents, or NULL if no server field
+ *              was present
+ */
+char *rtsp_request_get_response_server (const rtsp_request_t *req_p)
+{
+    return req_p->response.server;
+}
+
+
+/* Function:    rtsp_request_get_response_body
+ * Description: return the body of the response to a request
+ * Parameters:  req_p - request
+ * Returns:     response body data, or NULL
+ */
+char *rtsp_request_get_response_body (const rtsp_request_t *req_p)
+{
+    return req_p->response.body;
+}
+
+
+/* Function:    rtsp_request_get_response_etag
+ * Description: return the "ETag" field of the response to a request
+ * Parameters:  req_p - request
+ * Returns:     entity tag without quotes, or an empty string
+ */
+const char *rtsp_request_get_response_etag (const rtsp_request_t *req_p)
+{
+    return req_p->response.etag;
+}
+
+
+/* Function:    rtsp_client_init
+ * Description: Initialize the RTSP client
+ * Parameters:  name - RTSP server name
+ *              port - RTSP server port
+ * Returns:     Success or failed
+ */
+rtsp_ret_e rtsp_client_init (const char *name, int port)
+{
+    rtsp_ret_e ret = RTSP_FAILURE;
 
-        client.response.body = malloc(sizeof(char) * (length + 1));
-        memset(client.response.body, 0, length+1);
-        if (client.response.body == NULL) {
-            VQEC_LOG_ERROR("ValidateResponse:: Failed to allocate "
-                            "memory for response body\n");
-            err = RTSP_MALLOC_ERR;
-            goto done;
+    if (name != NULL) {
+        rtsp_request_free(&client_req);
+        ret = rtsp_conn_open(&client_conn, name, port);
+        if (ret == RTSP_SUCCESS && client_conn.connecting) {
+            ret = rtsp_conn_check_connect(
+                &client_conn, RTSP_CLIENT_TCP_CONNECT_TIMEOUT_SECS * 1000);
+            if (ret != RTSP_SUCCESS) {
+                rtsp_conn_close(&client_conn);
+                ret = RTSP_CONNECT_ERR;
+            }
         }
+    }
+    else {
+        VQEC_LOG_ERROR("rtsp_client_init:: RTSP server name "
+                        "or IP address must be specified\n");
+    }
 
-        strncpy(client.response.body, &resp[cur], length);
+    return ret;
+}
 
-        /* Make sure that it is null terminated */
-        client.response.body[length-1] = '\n';
+
+/* Function:    rtsp_client_close
+ * Description: Close the RTSP client
+ * Parameters:  N/A
+ * Returns:     Success or failed
+ */
+rtsp_ret_e rtsp_client_close (void)
+{
+    rtsp_conn_close(&client_conn);
+    rtsp_request_free(&client_req);
+
+    return RTSP_SUCCESS;
+}
+
+
+/* Function:    rtsp_send_request
+ * Description: Send out an DESCRIBE request and process the response
+ * Parameters:  abs_path              - absolute ptah for rtsp url
+ *              accept_media_type     - media types to include in RTSP header
+ *              abort_time            - time after which reqyest should be
+ *                                      aborted
+ * Returns:     Success or failed
+ */
+rtsp_ret_e rtsp_send_request (const char *abs_path,
+                              const char *accept_media_type,
+                              abs_time_t abort_time)
+{
+    rtsp_ret_e ret;
+
+    ret = rtsp_request_start(&client_req, &client_conn,
+                             abs_path, accept_media_type, NULL);
+    if (ret == RTSP_SUCCESS) {
+        ret = rtsp_request_wait(&client_req, abort_time);
     }
 
-    VQEC_DEBUG(VQEC_DEBUG_UPDATER,
-               "ValidateResponse:: Done with validation "
-               "of the response ...\n");
- done:
-    if (resp) {
-        free(resp);
-    }
-    if (err != RTSP_SUCCESS) {
-        if (client.response.server) {
-            free(client.response.server);
-            client.response.server = NULL;
-        }
+    if (ret == RTSP_SEND_ERR || ret == RTSP_INTERNAL_ERR) {
+        VQEC_LOG_ERROR("rtsp_send_request:: Failed sending DESCRIBE "
+                        "request to %s!\n",
+                        abs_path ? abs_path : "");
+        return RTSP_SEND_ERR;
     }
-    return (err);
+    else if (ret != RTSP_SUCCESS) {
+        VQEC_LOG_ERROR("rtsp_send_request:: Failed receiving "
+                        "the response!\n");
+    }
+
+    return ret;
 }
 
 
@@ -780,7 +866,7 @@ rtsp_ret_e ValidateResponse (char* response)
  */
 int rtsp_get_response_code ()
 {
-    return client.response.code;
+    return rtsp_request_get_response_code(&client_req);
 }
 
 
@@ -792,7 +878,7 @@ int rtsp_get_response_code ()
  */
 char *rtsp_get_response_server ()
 {
-    return client.response.server;
+    return rtsp_request_get_response_server(&client_req);
 }
 
 /* Function:    rtsp_get_response_body
@@ -802,51 +888,5 @@ char *rtsp_get_response_server ()
  */
 char *rtsp_get_response_body ()
 {
-    return client.response.body;
-}
-
-
-/* Function:    ReadLine
- * Description: Parse out each line from response message
- * Parameters:  
- * Returns:     Success or failed
- */
-int ReadLine (char* from_str, int first, int max, char* to_str)
-{
-    int res = 0;
-    int count = 0;
-
-    // We support "\r\n" and "\n" line termination
-    while ((first + count < max) && (count < MAX_LINE_SIZE)) {
-        if (from_str[first+count] == '\n') { 
-            to_str[count] = '\0';
-            count+=1;
-            res = count;
-            break;
-        }
-	
-	if (from_str[first+count] == '\r') { 
-            to_str[count] = '\0';
-            count+=2;
-            res = count;
-            break;
-        }
-
-        to_str[count] = from_str[first+count];
-        count++;
-    }
-
-    if (res == 0) {
-        if (first + count == max) {
-            res = -1; // from_str is empty, read more from e.g. the socket
-        }
-        else {
-            VQEC_LOG_ERROR("ReadLine:: Very long lines received "
-                            "from the server!\n");
-            res = -2;
-        }
-    }
-
-    return res;
+    return rtsp_request_get_response_body(&client_req);
 }
-
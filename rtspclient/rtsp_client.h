@@ -20,10 +20,12 @@
 #define MAX_LINE_SIZE 1024
 #define SOCKET_ERROR -1
 #define MSG_200_OK 200
+#define MSG_304_NOT_MODIFIED 304
 #define MSG_404_NOT_FOUND 404
 #define MSG_415_UNSUPPORTED_MEDIA_TYPE 415
 #define MEDIA_TYPE_APP_PLAIN_TEXT "application/plain-text"
 #define MEDIA_TYPE_APP_SDP        "application/sdp"
+#define RTSP_ETAG_LENGTH 80
 
 /*! \enum rtsp_ret_e
     \brief Return value from rtsp_client api calls.
@@ -37,7 +39,8 @@ typedef enum {
     RTSP_RESP_ERR,       /**< error processing the response to DESCRIBE request */
     RTSP_INVALID_RESP,   /**< invalid RTSP response */
     RTSP_MALLOC_ERR,     /**< memory allocation failed */
-    RTSP_INTERNAL_ERR    /**< internal error */
+    RTSP_INTERNAL_ERR,   /**< internal error */
+    RTSP_IN_PROGRESS     /**< request not complete yet */
 } rtsp_ret_e;
 
 
@@ -47,24 +50,182 @@ typedef enum {
 typedef struct rtsp_response_ {
     int         code;
     char        *server;
-    char        *data_buffer;
     char        *body;
+    char        etag[RTSP_ETAG_LENGTH];
 } rtsp_response_t;
 
 
-/*! \struct rtsp_client_t
-    \brief RTSP client structure
+/*! \struct rtsp_conn_t
+    \brief A TCP connection to an RTSP server.
+
+    A connection is kept open after a response so that further requests
+    to the same server can reuse it.  Its socket is non-blocking.
 */
-typedef struct rtsp_client_ {
+typedef struct rtsp_conn_ {
     char                serverHost[MAX_NAME_LENGTH]; // DNS name of RTSP server
     int                 serverPort;
-    int                 socket;
+    int                 socket;         /* -1 when closed */
+    boolean             connecting;     /* TCP connect still in progress */
+
+    uint32_t            cSeq;
+    uint32_t            num_requests;   /* requests sent on the connection */
+
+    /* Data received and not consumed by a response yet */
+    char                recv_buf[MAX_BUFFER_LENGTH];
+    int                 recv_start;
+    int                 recv_end;
+} rtsp_conn_t;
+
+
+/*! \enum rtsp_req_state_e
+    \brief Progress of an RTSP request.
+*/
+typedef enum {
+    RTSP_REQ_IDLE,       /**< not started */
+    RTSP_REQ_SENDING,    /**< sending the request */
+    RTSP_REQ_STATUS,     /**< awaiting the status line */
+    RTSP_REQ_HEADERS,    /**< receiving the response headers */
+    RTSP_REQ_BODY,       /**< receiving the response body */
+    RTSP_REQ_DONE,       /**< complete response received */
+    RTSP_REQ_FAILED      /**< request failed */
+} rtsp_req_state_e;
+
+
+/*! \struct rtsp_request_t
+    \brief A DESCRIBE request and its response.
+
+    The response is parsed as it arrives, so the request can be driven
+    from an event loop with rtsp_request_process().
+*/
+typedef struct rtsp_request_ {
+    rtsp_conn_t         *conn_p;
+    rtsp_req_state_e    state;
+    rtsp_ret_e          err;            /* result once DONE or FAILED */
+
+    char                send_buf[MAX_BUFFER_LENGTH];
+    int                 send_len;
+    int                 send_off;
 
     uint32_t            cSeq;
+    boolean             cseq_matched;   /* response carried our CSeq */
+    boolean             conn_close;     /* server will close the connection */
+    int                 content_length;
+    int                 body_len;
+    int                 scan_off;       /* bytes searched for end of line */
 
     rtsp_response_t     response;
-} rtsp_client_t;
+} rtsp_request_t;
+
+
+/*! \fn void rtsp_conn_init(rtsp_conn_t *conn_p)
+    \brief Initialize a connection structure as closed.
+*/
+extern void rtsp_conn_init(rtsp_conn_t *conn_p);
+
+/*! \fn rtsp_ret_e rtsp_conn_open(rtsp_conn_t *conn_p,
+                                  const char *server_name, int port)
+    \brief Start connecting to an RTSP server without waiting for the
+    connection to complete.
+
+    \param server_name The DNS name or IP address of RTSP server.
+*/
+extern rtsp_ret_e rtsp_conn_open(rtsp_conn_t *conn_p,
+                                 const char *server_name, int port);
+
+/*! \fn boolean rtsp_conn_is_open(const rtsp_conn_t *conn_p,
+                                  const char *server_name, int port)
+    \brief Check whether a connection is open to the given server, and so
+    can be reused for a request to it.
+*/
+extern boolean rtsp_conn_is_open(const rtsp_conn_t *conn_p,
+                                 const char *server_name, int port);
+
+/*! \fn int rtsp_conn_get_fd(const rtsp_conn_t *conn_p)
+    \brief Get the socket of a connection, or -1 if closed.
+*/
+extern int rtsp_conn_get_fd(const rtsp_conn_t *conn_p);
+
+/*! \fn void rtsp_conn_close(rtsp_conn_t *conn_p)
+    \brief Close a connection.
+*/
+extern void rtsp_conn_close(rtsp_conn_t *conn_p);
+
+/*! \fn void rtsp_request_init(rtsp_request_t *req_p)
+    \brief Initialize a request structure.
+*/
+extern void rtsp_request_init(rtsp_request_t *req_p);
 
+/*! \fn rtsp_ret_e rtsp_request_start(rtsp_request_t *req_p,
+                                      rtsp_conn_t *conn_p,
+                                      const char *abs_path,
+                                      const char *accept_media_type,
+                                      const char *if_none_match)
+    \brief Start a DESCRIBE request on a connection.  Any response held by
+    the request structure is freed.
+
+    \param if_none_match Entity tag of the version the client has; the
+    server answers 304 if the resource still has it.  May be NULL.
+*/
+extern rtsp_ret_e rtsp_request_start(rtsp_request_t *req_p,
+                                     rtsp_conn_t *conn_p,
+                                     const char *abs_path,
+                                     const char *accept_media_type,
+                                     const char *if_none_match);
+
+/*! \fn int rtsp_request_get_events(const rtsp_request_t *req_p)
+    \brief Get the poll events (POLLIN or POLLOUT) the request is waiting
+    for on the socket of its connection.
+*/
+extern int rtsp_request_get_events(const rtsp_request_t *req_p);
+
+/*! \fn rtsp_ret_e rtsp_request_process(rtsp_request_t *req_p)
+    \brief Make as much progress on a request as the socket allows
+    without blocking.
+
+    \return RTSP_IN_PROGRESS until the response is complete, then
+    RTSP_SUCCESS or an error.
+*/
+extern rtsp_ret_e rtsp_request_process(rtsp_request_t *req_p);
+
+/*! \fn rtsp_ret_e rtsp_request_wait(rtsp_request_t *req_p,
+                                     abs_time_t abort_time)
+    \brief Process a request until it completes or abort_time passes.
+*/
+extern rtsp_ret_e rtsp_request_wait(rtsp_request_t *req_p,
+                                    abs_time_t abort_time);
+
+/*! \fn void rtsp_request_free(rtsp_request_t *req_p)
+    \brief Free the response held by a request.
+*/
+extern void rtsp_request_free(rtsp_request_t *req_p);
+
+/*! \fn int rtsp_request_get_response_code(const rtsp_request_t *req_p)
+    \brief Get the response code of a request
+*/
+extern int rtsp_request_get_response_code(const rtsp_request_t *req_p);
+
+/*! \fn char *rtsp_request_get_response_server(const rtsp_request_t *req_p)
+    \brief Get the "Server" field of the response, or NULL if absent
+*/
+extern char *rtsp_request_get_response_server(const rtsp_request_t *req_p);
+
+/*! \fn char *rtsp_request_get_response_body(const rtsp_request_t *req_p)
+    \brief Get the body of a 200 OK response, or NULL
+*/
+extern char *rtsp_request_get_response_body(const rtsp_request_t *req_p);
+
+/*! \fn const char *rtsp_request_get_response_etag(
+                                       const rtsp_request_t *req_p)
+    \brief Get the "ETag" field of the response, or an empty string
+*/
+extern const char *rtsp_request_get_response_etag(
+    const rtsp_request_t *req_p);
+
+
+/*
+ * The calls below drive a single connection and request held by the
+ * RTSP client, one blocking request at a time.
+ */
 
 /*! \fn rtsp_ret_e rtsp_client_init(const char *server_name, int port)
     \brief Initialize the rtsp client.
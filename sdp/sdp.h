@@ -35,6 +35,10 @@
 
 #define SDP_MAX_LEN                1024
 
+/* Default block size of an arena created by sdp_init_arena; large
+ * enough to hold a typical channel description in one block. */
+#define SDP_ARENA_DEFAULT_BLOCK_SIZE  (32 * 1024)
+
 #define UNKNOWN_CRYPTO_SUITE              "UNKNOWN_CRYPTO_SUITE"
 #define AES_CM_128_HMAC_SHA1_32           "AES_CM_128_HMAC_SHA1_32"
 #define AES_CM_128_HMAC_SHA1_80           "AES_CM_128_HMAC_SHA1_80"
@@ -710,8 +714,14 @@ extern void sdp_transport_supported(void *config_p, sdp_transport_e transport,
 extern void sdp_allow_choose(void *config_p, sdp_choose_param_e param, 
                              tinybool choose_allowed);
 
+/* sdp_arena.c */
+extern void *sdp_init_arena(u32 block_size);
+extern void sdp_reset_arena(void *arena_ptr);
+extern void sdp_free_arena(void *arena_ptr);
+
 /* sdp_main.c */
 extern void *sdp_init_description(void *config_p);
+extern void *sdp_init_description_arena(void *config_p, void *arena_ptr);
 extern void sdp_debug(void *sdp_ptr, sdp_debug_e debug_type, tinybool debug_flag);
 extern void sdp_set_string_debug(void *sdp_ptr, char *debug_str);
 extern sdp_result_e sdp_parse(void *sdp_ptr, char **bufp, u16 len);
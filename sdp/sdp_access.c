@@ -518,7 +518,8 @@ sdp_result_e sdp_set_time_start (void *sdp_ptr, const char *start_time)
     }
 
     if (sdp_p->timespec_p == NULL) {
-        sdp_p->timespec_p = (sdp_timespec_t *)SDP_MALLOC(sizeof(sdp_timespec_t));
+        sdp_p->timespec_p = (sdp_timespec_t *)
+            sdp_alloc(sdp_p, sizeof(sdp_timespec_t));
         if (sdp_p->timespec_p == NULL) {
             sdp_p->conf_p->num_no_resource++;
             return (SDP_NO_RESOURCE);
@@ -549,7 +550,8 @@ sdp_result_e sdp_set_time_stop (void *sdp_ptr, const char *stop_time)
     }
 
     if (sdp_p->timespec_p == NULL) {
-        sdp_p->timespec_p = (sdp_timespec_t *)SDP_MALLOC(sizeof(sdp_timespec_t));
+        sdp_p->timespec_p = (sdp_timespec_t *)
+            sdp_alloc(sdp_p, sizeof(sdp_timespec_t));
         if (sdp_p->timespec_p == NULL) {
             sdp_p->conf_p->num_no_resource++;
             return (SDP_NO_RESOURCE);
@@ -1821,7 +1823,7 @@ sdp_result_e sdp_insert_media_line (void *sdp_ptr, u16 level)
     }
 
     /* Allocate resource for new media stream. */
-    new_mca_p = sdp_alloc_mca();
+    new_mca_p = sdp_alloc_mca(sdp_p);
     if (new_mca_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -1837,7 +1839,7 @@ sdp_result_e sdp_insert_media_line (void *sdp_ptr, u16 level)
          */
         mca_p = sdp_find_media_level(sdp_p, level-1);
         if (mca_p == NULL) {
-            SDP_FREE(new_mca_p);
+            sdp_release(sdp_p, new_mca_p);
             sdp_p->conf_p->num_invalid_param++;
             return (SDP_INVALID_PARAMETER);
         }
@@ -1889,7 +1891,7 @@ void sdp_delete_media_line (void *sdp_ptr, u16 level)
     /* Delete all attributes from this level. */
     for (attr_p = mca_p->media_attrs_p; attr_p != NULL;) {
         next_attr_p = attr_p->next_p;
-        sdp_free_attr(attr_p);
+        sdp_free_attr(sdp_p, attr_p);
         attr_p = next_attr_p;
     }
 
@@ -1899,7 +1901,7 @@ void sdp_delete_media_line (void *sdp_ptr, u16 level)
     } else {
         prev_mca_p->next_p = mca_p->next_p;
     }
-    SDP_FREE(mca_p);
+    sdp_release(sdp_p, mca_p);
     sdp_p->mca_count--;
     return;
 }
@@ -2194,7 +2196,7 @@ sdp_result_e sdp_add_media_profile (void *sdp_ptr, u16 level,
 
     if (mca_p->media_profiles_p == NULL) {
         mca_p->media_profiles_p = (sdp_media_profiles_t *) \
-            SDP_MALLOC(sizeof(sdp_media_profiles_t));
+            sdp_alloc(sdp_p, sizeof(sdp_media_profiles_t));
         if (mca_p->media_profiles_p == NULL) {
             sdp_p->conf_p->num_no_resource++;
             return (SDP_NO_RESOURCE);
@@ -2433,7 +2435,8 @@ sdp_result_e sdp_copy_all_bw_lines (void *src_sdp_ptr, void *dst_sdp_ptr,
     orig_bw_data_p = src_bw_p->bw_data_list;
     while (orig_bw_data_p) {
         /* For ever bw line in the src, allocate a new one for the dst */
-        new_bw_data_p = (sdp_bw_data_t*)SDP_MALLOC(sizeof(sdp_bw_data_t));
+        new_bw_data_p = (sdp_bw_data_t*)
+            sdp_alloc(dst_sdp_p, sizeof(sdp_bw_data_t));
         if (new_bw_data_p == NULL) {
             return (SDP_NO_RESOURCE);
         }
@@ -2612,7 +2615,7 @@ sdp_result_e sdp_add_new_bw_line (void *sdp_ptr, u16 level, u16 *inst_num)
      * Allocate a new sdp_bw_data_t instance and set it's values from the
      * input parameters.
      */
-    new_bw_data_p = (sdp_bw_data_t*)SDP_MALLOC(sizeof(sdp_bw_data_t));
+    new_bw_data_p = (sdp_bw_data_t*)sdp_alloc(sdp_p, sizeof(sdp_bw_data_t));
     if (new_bw_data_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -2698,7 +2701,7 @@ sdp_result_e sdp_delete_bw_line (void *sdp_ptr, u16 level, u16 inst_num)
     }
     bw_p->bw_data_count--;
     
-    SDP_FREE(bw_data_p);
+    sdp_release(sdp_p, bw_data_p);
     return (SDP_SUCCESS);
 }
 
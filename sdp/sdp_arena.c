@@ -0,0 +1,239 @@
+/*
+ *------------------------------------------------------------------
+ * sdp_arena.c  -- Arena allocation for parsed SDP descriptions.
+ *
+ * An arena hands out memory for the structures hung off an SDP
+ * description (media lines, attributes, bandwidth lines, etc.) by
+ * bumping a pointer through large blocks.  Nothing allocated from an
+ * arena is freed individually; the whole arena is rewound or released
+ * at once when the application is done with the descriptions parsed
+ * into it.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "sdp_os_defs.h"
+#include "sdp.h"
+#include "sdp_private.h"
+
+/* Every allocation is rounded up to this many bytes. */
+#define SDP_ARENA_ALIGN         8
+#define SDP_ARENA_ROUND(bytes) \
+    (((bytes) + (SDP_ARENA_ALIGN - 1)) & ~(SDP_ARENA_ALIGN - 1))
+
+/* Space taken by a block header, kept aligned so block data is too. */
+#define SDP_ARENA_BLOCK_HDR_LEN SDP_ARENA_ROUND(sizeof(sdp_arena_block_t))
+
+
+/* Function:    sdp_init_arena
+ * Description: Allocates a new arena from which SDP descriptions created
+ *              with sdp_init_description_arena allocate their memory.
+ *              No blocks are allocated until the first allocation.
+ * Parameters:  block_size  Size in bytes of each block the arena
+ *                          allocates.  If zero, SDP_ARENA_DEFAULT_BLOCK_SIZE
+ *                          is used.  Allocations larger than the block
+ *                          size are given a block of their own.
+ * Returns:     A handle for the new arena as a void ptr, or NULL if
+ *              the memory could not be allocated.
+ */
+void *sdp_init_arena (u32 block_size)
+{
+    sdp_arena_t *arena_p;
+
+    arena_p = (sdp_arena_t *)SDP_MALLOC(sizeof(sdp_arena_t));
+    if (arena_p == NULL) {
+        return (NULL);
+    }
+
+    if (block_size == 0) {
+        block_size = SDP_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+
+    arena_p->magic_num  = SDP_ARENA_MAGIC_NUM;
+    arena_p->block_size = SDP_ARENA_ROUND(block_size);
+    arena_p->first_p    = NULL;
+    arena_p->cur_p      = NULL;
+
+    return (arena_p);
+}
+
+/* Function:    sdp_verify_arena_ptr
+ * Description: Verify the arena pointer is valid by checking for
+ *              the SDP arena magic number.
+ * Parameters:  arena_p  The arena handle returned by sdp_init_arena.
+ * Returns:     TRUE or FALSE.
+ */
+static tinybool sdp_verify_arena_ptr (sdp_arena_t *arena_p)
+{
+    if ((arena_p != NULL) && (arena_p->magic_num == SDP_ARENA_MAGIC_NUM)) {
+        return (TRUE);
+    } else {
+        return (FALSE);
+    }
+}
+
+/* Function:    sdp_reset_arena
+ * Description: Rewinds an arena so its memory can be reused for the
+ *              next descriptions.  The blocks already allocated are
+ *              kept, so this does not touch the heap.  Every description
+ *              created on the arena must have been freed with
+ *              sdp_free_description before the arena is reset.
+ * Parameters:  arena_ptr  The arena handle returned by sdp_init_arena.
+ * Returns:     Nothing.
+ */
+void sdp_reset_arena (void *arena_ptr)
+{
+    sdp_arena_t *arena_p = (sdp_arena_t *)arena_ptr;
+
+    if (sdp_verify_arena_ptr(arena_p) == FALSE) {
+        return;
+    }
+
+    arena_p->cur_p = arena_p->first_p;
+    if (arena_p->cur_p != NULL) {
+        arena_p->cur_p->used = 0;
+    }
+}
+
+/* Function:    sdp_free_arena
+ * Description: Releases an arena and all of the blocks it allocated.
+ *              Every description created on the arena must have been
+ *              freed with sdp_free_description first.
+ * Parameters:  arena_ptr  The arena handle returned by sdp_init_arena.
+ * Returns:     Nothing.
+ */
+void sdp_free_arena (void *arena_ptr)
+{
+    sdp_arena_t       *arena_p = (sdp_arena_t *)arena_ptr;
+    sdp_arena_block_t *block_p, *next_block_p;
+
+    if (sdp_verify_arena_ptr(arena_p) == FALSE) {
+        return;
+    }
+
+    block_p = arena_p->first_p;
+    while (block_p != NULL) {
+        next_block_p = block_p->next_p;
+        SDP_FREE(block_p);
+        block_p = next_block_p;
+    }
+
+    arena_p->magic_num = 0;
+    SDP_FREE(arena_p);
+}
+
+/* Function:    sdp_arena_alloc
+ * Description: Allocates zeroed memory from an arena.  The current block
+ *              is used if it has room, then any blocks kept from before
+ *              the last reset, and a new block is appended otherwise.
+ * Parameters:  arena_p  The arena to allocate from.
+ *              bytes    Number of bytes to allocate.
+ * Returns:     Pointer to the memory, or NULL if a new block was needed
+ *              and could not be allocated.
+ */
+void *sdp_arena_alloc (sdp_arena_t *arena_p, u32 bytes)
+{
+    sdp_arena_block_t *block_p;
+    u32                block_size;
+    void              *ptr;
+
+    bytes = SDP_ARENA_ROUND(bytes);
+
+    block_p = arena_p->cur_p;
+    while ((block_p != NULL) && (block_p->size - block_p->used < bytes)) {
+        if (block_p->next_p == NULL) {
+            break;
+        }
+        block_p = block_p->next_p;
+        block_p->used = 0;
+    }
+
+    if ((block_p == NULL) || (block_p->size - block_p->used < bytes)) {
+        block_size = (bytes > arena_p->block_size) ?
+            bytes : arena_p->block_size;
+        block_p = (sdp_arena_block_t *)
+            SDP_MALLOC(SDP_ARENA_BLOCK_HDR_LEN + block_size);
+        if (block_p == NULL) {
+            return (NULL);
+        }
+        block_p->next_p = NULL;
+        block_p->size   = block_size;
+        block_p->used   = 0;
+
+        /* New blocks always go at the end of the list. */
+        if (arena_p->first_p == NULL) {
+            arena_p->first_p = block_p;
+        } else {
+            while (arena_p->cur_p->next_p != NULL) {
+                arena_p->cur_p = arena_p->cur_p->next_p;
+            }
+            arena_p->cur_p->next_p = block_p;
+        }
+    }
+
+    arena_p->cur_p = block_p;
+    ptr = (char *)block_p + SDP_ARENA_BLOCK_HDR_LEN + block_p->used;
+    block_p->used += bytes;
+
+    memset(ptr, 0, bytes);
+    return (ptr);
+}
+
+/* Function:    sdp_alloc
+ * Description: Allocates memory for a structure belonging to an SDP
+ *              description, from the description's arena if it has
+ *              one and from the heap otherwise.
+ * Parameters:  sdp_p  The SDP description the memory belongs to.
+ *              bytes  Number of bytes to allocate.
+ * Returns:     Pointer to the memory, or NULL on failure.
+ */
+void *sdp_alloc (sdp_t *sdp_p, u32 bytes)
+{
+    if (sdp_p->arena_p != NULL) {
+        return (sdp_arena_alloc(sdp_p->arena_p, bytes));
+    }
+    return (SDP_MALLOC(bytes));
+}
+
+/* Function:    sdp_release
+ * Description: Frees memory allocated with sdp_alloc or sdp_strdup.
+ *              Memory from an arena is only reclaimed when the arena
+ *              is reset or freed, so this does nothing in that case.
+ * Parameters:  sdp_p  The SDP description the memory belongs to.
+ *              ptr    The memory to free.
+ * Returns:     Nothing.
+ */
+void sdp_release (sdp_t *sdp_p, void *ptr)
+{
+    if (sdp_p->arena_p == NULL) {
+        SDP_FREE(ptr);
+    }
+}
+
+/* Function:    sdp_strdup
+ * Description: Duplicates a string for an SDP description, from the
+ *              description's arena if it has one and from the heap
+ *              otherwise.
+ * Parameters:  sdp_p  The SDP description the string belongs to.
+ *              str    The string to duplicate.
+ * Returns:     Pointer to the copy, or NULL on failure.
+ */
+char *sdp_strdup (sdp_t *sdp_p, const char *str)
+{
+    char *copy_p;
+    u32   len;
+
+    if (sdp_p->arena_p == NULL) {
+        return (strdup(str));
+    }
+
+    len = strlen(str) + 1;
+    copy_p = (char *)sdp_arena_alloc(sdp_p->arena_p, len);
+    if (copy_p != NULL) {
+        memcpy(copy_p, str, len);
+    }
+    return (copy_p);
+}
@@ -67,25 +67,23 @@ sdp_result_e sdp_parse_attribute (sdp_t *sdp_p, u16 level, const char *ptr)
         return (SDP_INVALID_PARAMETER);
     }
 
-    attr_p = (sdp_attr_t *)SDP_MALLOC(sizeof(sdp_attr_t));
+    attr_p = (sdp_attr_t *)sdp_alloc(sdp_p, sizeof(sdp_attr_t));
     if (attr_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
     }
     attr_p->type = SDP_ATTR_INVALID;
     attr_p->next_p = NULL;
-    for (i=0; i < SDP_MAX_ATTR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_attr[i].name, sdp_attr[i].strlen) == 0) {
-            attr_p->type = (sdp_attr_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_attr_index, tmp);
+    if (i >= 0) {
+        attr_p->type = (sdp_attr_e)i;
     }
     if (attr_p->type == SDP_ATTR_INVALID) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
             SDP_WARN("%s Warning: Unrecognized attribute (%s) ", 
                      sdp_p->debug_str, tmp);
         }
-        sdp_free_attr(attr_p);
+        sdp_free_attr(sdp_p, attr_p);
         return (SDP_SUCCESS);
     }
 
@@ -99,7 +97,7 @@ sdp_result_e sdp_parse_attribute (sdp_t *sdp_p, u16 level, const char *ptr)
     /* Parse the attribute. */
     result = sdp_attr[attr_p->type].parse_func(sdp_p, attr_p, ptr);
     if (result != SDP_SUCCESS) {
-        sdp_free_attr(attr_p);
+        sdp_free_attr(sdp_p, attr_p);
         /* Return success so the parse won't fail.  We don't want to
          * fail on errors with attributes but just ignore them.
          */
@@ -373,6 +371,8 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
                                   const char *ptr)
 {
     u16           i;
+    int           codec_param;
+    int           retrans_param;
     u32           mapword;
     u32           bmap;
     u8            low_val;
@@ -463,8 +463,8 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
     while (!done) {
       fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "= ;\t", &result1);
       if (result1 == SDP_SUCCESS) {
-        if (strncasecmp(tmp, sdp_fmtp_codec_param[1].name,
-	                sdp_fmtp_codec_param[1].strlen) == 0) {
+        codec_param = sdp_keyword_find(&sdp_fmtp_codec_param_index, tmp);
+        if (codec_param == 1) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr  = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -502,8 +502,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    } 
 	    codec_info_found = TRUE;
 	
-	} else if (strncasecmp(tmp, sdp_fmtp_codec_param[0].name,
-	                       sdp_fmtp_codec_param[0].strlen) == 0) {
+	} else if (codec_param == 0) {
 			
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
@@ -542,8 +541,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    } 
 	    codec_info_found = TRUE;
 	    
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[2].name,
-                               sdp_fmtp_codec_param[2].strlen) == 0) {
+	} else if (codec_param == 2) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -574,8 +572,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->bitrate = bitrate;   
             codec_info_found = TRUE;
             
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[3].name,
-                               sdp_fmtp_codec_param[3].strlen) == 0) {
+	} else if (codec_param == 3) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
                fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -604,8 +601,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sdp_set_video_pic_val(fmtp_p, SDP_VIDEO_PIC_SIZE_QCIF, val);
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[4].name,
-                               sdp_fmtp_codec_param[4].strlen) == 0) {
+	} else if (codec_param == 4) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -634,8 +630,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sdp_set_video_pic_val(fmtp_p, SDP_VIDEO_PIC_SIZE_CIF, val);
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[5].name,
-                               sdp_fmtp_codec_param[5].strlen) == 0) {
+	} else if (codec_param == 5) {
 	    val = sdp_getnextnumtok(fmtp_ptr, &fmtp_ptr, "= ;\t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 		if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -656,8 +651,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    fmtp_p->maxbr = val;   
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[6].name,
-                               sdp_fmtp_codec_param[6].strlen) == 0) {
+	} else if (codec_param == 6) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -685,8 +679,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sdp_set_video_pic_val(fmtp_p, SDP_VIDEO_PIC_SIZE_SQCIF, val);
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[7].name,
-                               sdp_fmtp_codec_param[7].strlen) == 0) {
+	} else if (codec_param == 7) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -715,8 +708,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sdp_set_video_pic_val(fmtp_p, SDP_VIDEO_PIC_SIZE_CIF4, val);
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[8].name,
-                               sdp_fmtp_codec_param[8].strlen) == 0) {
+	} else if (codec_param == 8) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -745,8 +737,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sdp_set_video_pic_val(fmtp_p, SDP_VIDEO_PIC_SIZE_CIF16, val);
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
 	    codec_info_found = TRUE;
-        } else  if (strncasecmp(tmp,sdp_fmtp_codec_param[9].name,
-                               sdp_fmtp_codec_param[9].strlen) == 0) {
+        } else  if (codec_param == 9) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -844,8 +835,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->custom_y = custom_y;
             fmtp_p->custom_mpi = custom_mpi;
 	    codec_info_found = TRUE;
-        } else  if (strncasecmp(tmp,sdp_fmtp_codec_param[10].name,
-                               sdp_fmtp_codec_param[10].strlen) == 0) {
+        } else  if (codec_param == 10) {
             par_width = sdp_getnextnumtok(fmtp_ptr, &fmtp_ptr, "=: \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 		if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -879,8 +869,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->par_width = par_width;
             fmtp_p->par_height = par_height;
 	    codec_info_found = TRUE;
-        } else  if (strncasecmp(tmp,sdp_fmtp_codec_param[11].name,
-                               sdp_fmtp_codec_param[11].strlen) == 0) {
+        } else  if (codec_param == 11) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; =\t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 		if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -902,8 +891,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    sstrncpy(fmtp_p->cpcf, tmp, sizeof(fmtp_p->cpcf));
 	    codec_info_found = TRUE;
 
-        } else  if (strncasecmp(tmp,sdp_fmtp_codec_param[12].name,
-                               sdp_fmtp_codec_param[12].strlen) == 0) {
+        } else  if (codec_param == 12) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -933,8 +921,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->bpp = temp_val;
 	    codec_info_found = TRUE;
-        } else  if (strncasecmp(tmp,sdp_fmtp_codec_param[13].name,
-                               sdp_fmtp_codec_param[13].strlen) == 0) {
+        } else  if (codec_param == 13) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -964,8 +951,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->hrd = temp_val;
 	    codec_info_found = TRUE;
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[14].name,
-                               sdp_fmtp_codec_param[14].strlen) == 0) {
+	} else if (codec_param == 14) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -995,8 +981,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->profile = profile;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[15].name,
-                               sdp_fmtp_codec_param[15].strlen) == 0) {
+        } else if (codec_param == 15) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1026,13 +1011,15 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->level = level;
 	    codec_info_found = TRUE; 
-        } if (strncasecmp(tmp,sdp_fmtp_codec_param[16].name,
-                               sdp_fmtp_codec_param[16].strlen) == 0) {
+        }
+        /* Not an else-if: the branches above may have consumed the
+         * parameter's value into tmp, and it is matched again here. */
+        codec_param = sdp_keyword_find(&sdp_fmtp_codec_param_index, tmp);
+        if (codec_param == 16) {
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->is_interlace = TRUE;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[17].name,
-                               sdp_fmtp_codec_param[17].strlen) == 0) {
+        } else if (codec_param == 17) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1052,8 +1039,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sstrncpy(fmtp_p->profile_level_id , tok, sizeof(fmtp_p->profile_level_id));
             fmtp_p->flag |= SDP_PROFILE_LEVEL_ID_FLAG;
 	    codec_info_found = TRUE;
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[18].name,
-                               sdp_fmtp_codec_param[18].strlen) == 0) {
+        } else if (codec_param == 18) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1073,8 +1059,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             sstrncpy(fmtp_p->parameter_sets , tok, sizeof(fmtp_p->parameter_sets));
             fmtp_p->flag |= SDP_SPROP_PARAMETER_SETS_FLAG;
 	    codec_info_found = TRUE;
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[19].name,
-                               sdp_fmtp_codec_param[19].strlen) == 0) {
+        } else if (codec_param == 19) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1102,8 +1087,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
                 fmtp_p->flag |= SDP_PACKETIZATION_MODE_FLAG;
 		codec_info_found = TRUE;
             }
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[20].name,
-                               sdp_fmtp_codec_param[20].strlen) == 0) {
+        } else if (codec_param == 20) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1133,8 +1117,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->interleaving_depth = val;
             fmtp_p->flag |= SDP_SPROP_INTERLEAVING_DEPTH_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[21].name,
-                               sdp_fmtp_codec_param[21].strlen) == 0) {
+        } else if (codec_param == 21) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1161,8 +1144,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 			     "fmtp attribute.", sdp_p->debug_str);
 		}
             }
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[22].name,
-                               sdp_fmtp_codec_param[22].strlen) == 0) {
+        } else if (codec_param == 22) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1192,8 +1174,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_don_diff = temp_val;
 	    fmtp_p->flag |= SDP_SPROP_MAX_DON_DIFF_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[23].name,
-                               sdp_fmtp_codec_param[23].strlen) == 0) {
+        } else if (codec_param == 23) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1220,8 +1201,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 			     "fmtp attribute.", sdp_p->debug_str);
 		}
             }
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[24].name,
-                               sdp_fmtp_codec_param[24].strlen) == 0) {
+        } else if (codec_param == 24) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1251,8 +1231,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_mbps = temp_val;
 	    fmtp_p->flag |= SDP_MAX_MBPS_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[25].name,
-                               sdp_fmtp_codec_param[25].strlen) == 0) {
+        } else if (codec_param == 25) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1282,8 +1261,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_fs = temp_val;
 	    fmtp_p->flag |= SDP_MAX_FS_FLAG;
             codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[26].name,
-                               sdp_fmtp_codec_param[26].strlen) == 0) {
+        } else if (codec_param == 26) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1313,8 +1291,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_cpb = temp_val;
 	    fmtp_p->flag |= SDP_MAX_CPB_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[27].name,
-                               sdp_fmtp_codec_param[27].strlen) == 0) {
+        } else if (codec_param == 27) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1344,8 +1321,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_dpb = temp_val;
 	    fmtp_p->flag |= SDP_MAX_DPB_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[28].name,
-                               sdp_fmtp_codec_param[28].strlen) == 0) {
+        } else if (codec_param == 28) {
             temp_val = sdp_getnextnumtok(fmtp_ptr, &fmtp_ptr, "=; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 		if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -1367,8 +1343,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->max_br = temp_val;
 	    fmtp_p->flag |= SDP_MAX_BR_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[29].name,
-                               sdp_fmtp_codec_param[29].strlen) == 0) {
+        } else if (codec_param == 29) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1403,8 +1378,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             }
             fmtp_p->flag |= SDP_REDUNDANT_PIC_CAP_FLAG;
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[30].name,
-                               sdp_fmtp_codec_param[30].strlen) == 0) {
+        } else if (codec_param == 30) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1431,8 +1405,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 			     "fmtp attribute.", sdp_p->debug_str);
 		}
             }
-        }  else if (strncasecmp(tmp,sdp_fmtp_codec_param[31].name,
-                               sdp_fmtp_codec_param[31].strlen) == 0) {
+        }  else if (codec_param == 31) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1459,8 +1432,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
 			     "fmtp attribute.", sdp_p->debug_str);
 		}
             }
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[32].name,
-                               sdp_fmtp_codec_param[32].strlen) == 0) {
+        } else if (codec_param == 32) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
 	        fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1493,33 +1465,27 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
                 fmtp_p->flag |= SDP_PARAMETER_ADD_FLAG;
             }
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[33].name,
-                               sdp_fmtp_codec_param[33].strlen) == 0) {
+        } else if (codec_param == 33) {
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_d = TRUE;                
 	    codec_info_found = TRUE;
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[34].name,
-                               sdp_fmtp_codec_param[34].strlen) == 0) {
+        } else if (codec_param == 34) {
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_f = TRUE;                
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[35].name,
-                               sdp_fmtp_codec_param[35].strlen) == 0) {
+        } else if (codec_param == 35) {
             fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_i = TRUE;                
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[36].name,
-                               sdp_fmtp_codec_param[36].strlen) == 0) {
+        } else if (codec_param == 36) {
             fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_j = TRUE;                
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[37].name,
-                               sdp_fmtp_codec_param[36].strlen) == 0) {
+        } else if (codec_param == 37) {
 	    fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_t = TRUE;                
 	    codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[38].name,
-                             sdp_fmtp_codec_param[38].strlen) == 0) {
+        } else if (codec_param == 38) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
                 if (result1 != SDP_SUCCESS) {
                     fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1547,8 +1513,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
                 fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
                 fmtp_p->annex_k_val = annex_k_val;
                 codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[39].name,
-                               sdp_fmtp_codec_param[39].strlen) == 0) {
+        } else if (codec_param == 39) {
             fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
             if (result1 != SDP_SUCCESS) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1576,8 +1541,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             fmtp_p->annex_n_val = annex_n_val;
             codec_info_found = TRUE; 
-        } else if (strncasecmp(tmp,sdp_fmtp_codec_param[40].name,
-                               sdp_fmtp_codec_param[40].strlen) == 0) {
+        } else if (codec_param == 40) {
             fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
             if (result1 != SDP_SUCCESS) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, " \t", &result1);
@@ -1658,8 +1622,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
             }
             fmtp_p->fmtp_format = SDP_FMTP_CODEC_INFO;
             codec_info_found = TRUE; 
-	} else if (strncasecmp(tmp,sdp_fmtp_codec_param[41].name,
-                               sdp_fmtp_codec_param[41].strlen) == 0) {
+	} else if (codec_param == 41) {
 	    fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "; \t", &result1);
 	    if (result1 != SDP_SUCCESS) {
                 if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -1822,8 +1785,9 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
     while (!done) {
         fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "=; \t", &result1);
         if (result1 == SDP_SUCCESS) {
-            if (strncasecmp(tmp,sdp_fmtp_rtp_retrans_param[0].name,
-                            sdp_fmtp_rtp_retrans_param[0].strlen) == 0) {
+            retrans_param = sdp_keyword_find(&sdp_fmtp_rtp_retrans_param_index,
+                                             tmp);
+            if (retrans_param == SDP_FMTP_APT) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "=; \t", &result1);
                 if (result1 != SDP_SUCCESS) {
                     if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -1837,8 +1801,7 @@ sdp_result_e sdp_parse_attr_fmtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
                 attr_p->attr.fmtp.apt = atoi(tmp);
                 fmtp_p->fmtp_format = SDP_FMTP_RTP_RETRANS;
                 
-            } else if (strncasecmp(tmp,sdp_fmtp_rtp_retrans_param[1].name,
-                                   sdp_fmtp_rtp_retrans_param[1].strlen) == 0) {
+            } else if (retrans_param == SDP_FMTP_RTX_TIME) {
                 fmtp_ptr = sdp_getnextstrtok(fmtp_ptr, tmp, "=; \t", &result1);
                 if (result1 != SDP_SUCCESS) {
                     if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2610,11 +2573,9 @@ sdp_result_e sdp_parse_attr_qos (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.qos.strength = SDP_QOS_STRENGTH_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_STRENGTH; i++) {
-        if (strncasecmp(tmp, sdp_qos_strength[i].name,
-                        sdp_qos_strength[i].strlen) == 0) {
-            attr_p->attr.qos.strength = (sdp_qos_strength_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_strength_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.qos.strength = (sdp_qos_strength_e)i;
     }
     if (attr_p->attr.qos.strength == SDP_QOS_STRENGTH_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2636,11 +2597,9 @@ sdp_result_e sdp_parse_attr_qos (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.qos.direction = SDP_QOS_DIR_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_DIR; i++) {
-        if (strncasecmp(tmp, sdp_qos_direction[i].name,
-                        sdp_qos_direction[i].strlen) == 0) {
-            attr_p->attr.qos.direction = (sdp_qos_dir_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_direction_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.qos.direction = (sdp_qos_dir_e)i;
     }
     if (attr_p->attr.qos.direction == SDP_QOS_DIR_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2720,11 +2679,9 @@ sdp_result_e sdp_parse_attr_curr (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.curr.type = SDP_CURR_UNKNOWN_TYPE;
-    for (i=0; i < SDP_MAX_CURR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_curr_type[i].name,
-                        sdp_curr_type[i].strlen) == 0) {
-            attr_p->attr.curr.type = (sdp_curr_type_e)i;
-        }
+    i = sdp_keyword_find(&sdp_curr_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.curr.type = (sdp_curr_type_e)i;
     }
     
     if (attr_p->attr.curr.type != SDP_CURR_QOS_TYPE) {
@@ -2747,11 +2704,9 @@ sdp_result_e sdp_parse_attr_curr (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.curr.status_type = SDP_QOS_STATUS_TYPE_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_STATUS_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_qos_status_type[i].name,
-                        sdp_qos_status_type[i].strlen) == 0) {
-            attr_p->attr.curr.status_type = (sdp_qos_status_types_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_status_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.curr.status_type = (sdp_qos_status_types_e)i;
     }
     
 
@@ -2766,11 +2721,9 @@ sdp_result_e sdp_parse_attr_curr (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.curr.direction = SDP_QOS_DIR_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_DIR; i++) {
-        if (strncasecmp(tmp, sdp_qos_direction[i].name,
-                        sdp_qos_direction[i].strlen) == 0) {
-            attr_p->attr.curr.direction = (sdp_qos_dir_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_direction_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.curr.direction = (sdp_qos_dir_e)i;
     }
     if (attr_p->attr.curr.direction == SDP_QOS_DIR_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2830,11 +2783,9 @@ sdp_result_e sdp_parse_attr_des (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.des.type = SDP_DES_UNKNOWN_TYPE;
-    for (i=0; i < SDP_MAX_CURR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_des_type[i].name,
-                        sdp_des_type[i].strlen) == 0) {
-            attr_p->attr.des.type = (sdp_des_type_e)i;
-        }
+    i = sdp_keyword_find(&sdp_des_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.des.type = (sdp_des_type_e)i;
     }
     
     if (attr_p->attr.des.type != SDP_DES_QOS_TYPE) {
@@ -2857,11 +2808,9 @@ sdp_result_e sdp_parse_attr_des (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.des.strength = SDP_QOS_STRENGTH_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_STRENGTH; i++) {
-        if (strncasecmp(tmp, sdp_qos_strength[i].name,
-                        sdp_qos_strength[i].strlen) == 0) {
-            attr_p->attr.des.strength = (sdp_qos_strength_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_strength_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.des.strength = (sdp_qos_strength_e)i;
     }
     if (attr_p->attr.des.strength == SDP_QOS_STRENGTH_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2883,11 +2832,9 @@ sdp_result_e sdp_parse_attr_des (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.des.status_type = SDP_QOS_STATUS_TYPE_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_STATUS_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_qos_status_type[i].name,
-                        sdp_qos_status_type[i].strlen) == 0) {
-            attr_p->attr.des.status_type = (sdp_qos_status_types_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_status_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.des.status_type = (sdp_qos_status_types_e)i;
     }
     
 
@@ -2902,11 +2849,9 @@ sdp_result_e sdp_parse_attr_des (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.des.direction = SDP_QOS_DIR_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_DIR; i++) {
-        if (strncasecmp(tmp, sdp_qos_direction[i].name,
-                        sdp_qos_direction[i].strlen) == 0) {
-            attr_p->attr.des.direction = (sdp_qos_dir_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_direction_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.des.direction = (sdp_qos_dir_e)i;
     }
     if (attr_p->attr.des.direction == SDP_QOS_DIR_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -2969,11 +2914,9 @@ sdp_result_e sdp_parse_attr_conf (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.conf.type = SDP_CONF_UNKNOWN_TYPE;
-    for (i=0; i < SDP_MAX_CURR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_conf_type[i].name,
-                        sdp_conf_type[i].strlen) == 0) {
-            attr_p->attr.conf.type = (sdp_conf_type_e)i;
-        }
+    i = sdp_keyword_find(&sdp_conf_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.conf.type = (sdp_conf_type_e)i;
     }
     
     if (attr_p->attr.conf.type != SDP_CONF_QOS_TYPE) {
@@ -2996,11 +2939,9 @@ sdp_result_e sdp_parse_attr_conf (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.conf.status_type = SDP_QOS_STATUS_TYPE_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_STATUS_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_qos_status_type[i].name,
-                        sdp_qos_status_type[i].strlen) == 0) {
-            attr_p->attr.conf.status_type = (sdp_qos_status_types_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_status_type_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.conf.status_type = (sdp_qos_status_types_e)i;
     }
     
 
@@ -3015,11 +2956,9 @@ sdp_result_e sdp_parse_attr_conf (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.conf.direction = SDP_QOS_DIR_UNKNOWN;
-    for (i=0; i < SDP_MAX_QOS_DIR; i++) {
-        if (strncasecmp(tmp, sdp_qos_direction[i].name,
-                        sdp_qos_direction[i].strlen) == 0) {
-            attr_p->attr.conf.direction = (sdp_qos_dir_e)i;
-        }
+    i = sdp_keyword_find(&sdp_qos_direction_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.conf.direction = (sdp_qos_dir_e)i;
     }
     if (attr_p->attr.conf.direction == SDP_QOS_DIR_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -3182,7 +3121,6 @@ sdp_result_e sdp_parse_attr_subnet (sdp_t *sdp_p, sdp_attr_t *attr_p,
     int i;
     char         *slash_ptr;
     sdp_result_e  result;
-    tinybool      type_found = FALSE;
     char          tmp[SDP_MAX_STRING_LEN];
 
     /* Find the subnet network type. */
@@ -3196,16 +3134,10 @@ sdp_result_e sdp_parse_attr_subnet (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.subnet.nettype = SDP_NT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name, 
-                        sdp_nettype[i].strlen) == 0) {
-            type_found = TRUE;
-        }
-        if (type_found == TRUE) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                attr_p->attr.subnet.nettype = (sdp_nettype_e)i;
-            }
-            type_found = FALSE;
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            attr_p->attr.subnet.nettype = (sdp_nettype_e)i;
         }
     }
     if (attr_p->attr.subnet.nettype == SDP_NT_UNSUPPORTED) {
@@ -3228,16 +3160,10 @@ sdp_result_e sdp_parse_attr_subnet (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.subnet.addrtype = SDP_AT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            type_found = TRUE;
-        }
-        if (type_found == TRUE) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                attr_p->attr.subnet.addrtype = (sdp_addrtype_e)i;
-            }
-            type_found = FALSE;
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            attr_p->attr.subnet.addrtype = (sdp_addrtype_e)i;
         }
     }
     if (attr_p->attr.subnet.addrtype == SDP_AT_UNSUPPORTED) {
@@ -3334,11 +3260,9 @@ sdp_result_e sdp_parse_attr_t38_ratemgmt (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.t38ratemgmt = SDP_T38_UNKNOWN_RATE;
-    for (i=0; i < SDP_T38_MAX_RATES; i++) {
-        if (strncasecmp(tmp, sdp_t38_rate[i].name,
-                        sdp_t38_rate[i].strlen) == 0) {
-            attr_p->attr.t38ratemgmt = (sdp_t38_ratemgmt_e)i;
-        }
+    i = sdp_keyword_find(&sdp_t38_rate_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.t38ratemgmt = (sdp_t38_ratemgmt_e)i;
     }
 
     if (sdp_p->debug_flag[SDP_DEBUG_TRACE]) {
@@ -3379,11 +3303,9 @@ sdp_result_e sdp_parse_attr_t38_udpec (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.t38udpec = SDP_T38_UDPEC_UNKNOWN;
-    for (i=0; i < SDP_T38_MAX_UDPEC; i++) {
-        if (strncasecmp(tmp, sdp_t38_udpec[i].name,
-                        sdp_t38_udpec[i].strlen) == 0) {
-            attr_p->attr.t38udpec = (sdp_t38_udpec_e)i;
-        }
+    i = sdp_keyword_find(&sdp_t38_udpec_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.t38udpec = (sdp_t38_udpec_e)i;
     }
 
     if (sdp_p->debug_flag[SDP_DEBUG_TRACE]) {
@@ -3470,7 +3392,7 @@ sdp_result_e sdp_build_attr_pc_codec (sdp_t *sdp_p, sdp_attr_t *attr_p,
 sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p, 
                                  const char *ptr)
 {
-    u16           i;
+    int           i;
     u16           cap_num;
     sdp_result_e  result;
     sdp_mca_t    *cap_p;
@@ -3488,7 +3410,7 @@ sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
     /* Allocate resource for new capability. Note that the capability 
      * uses the same structure used for media lines.
      */
-    cap_p = sdp_alloc_mca();
+    cap_p = sdp_alloc_mca(sdp_p);
     if (cap_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -3504,7 +3426,7 @@ sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
 		     sdp_get_attr_name(attr_p->type));
                      
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
@@ -3517,23 +3439,21 @@ sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
                      "unable to parse.", sdp_p->debug_str,
 		     sdp_get_attr_name(attr_p->type));
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
     cap_p->media = SDP_MEDIA_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_MEDIA_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_media[i].name, sdp_media[i].strlen) == 0) {
-            cap_p->media = (sdp_media_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_media_index, tmp);
+    if (i >= 0) {
+        cap_p->media = (sdp_media_e)i;
     }
     if (cap_p->media == SDP_MEDIA_UNSUPPORTED) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
             SDP_WARN("%s Warning: Media type unsupported (%s).", 
                      sdp_p->debug_str, tmp);
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
@@ -3545,24 +3465,21 @@ sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
             SDP_WARN("%s No transport protocol type specified, "
                      "unable to parse.", sdp_p->debug_str);
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
     cap_p->transport = SDP_TRANSPORT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_TRANSPORT_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_transport[i].name,
-                        sdp_transport[i].strlen) == 0) {
-            cap_p->transport = (sdp_transport_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_transport_index, tmp);
+    if (i >= 0) {
+        cap_p->transport = (sdp_transport_e)i;
     }
     if (cap_p->transport == SDP_TRANSPORT_UNSUPPORTED) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
             SDP_WARN("%s Warning: Transport protocol type unsupported "
                      "(%s).", sdp_p->debug_str, tmp);
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
@@ -3580,14 +3497,14 @@ sdp_result_e sdp_parse_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
                      "%s attributes.", sdp_p->debug_str,
 		     sdp_get_attr_name(attr_p->type));
         }
-        SDP_FREE(cap_p);
+        sdp_release(sdp_p, cap_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     } else {
         /* Transport is a non-AAL2 type.  Parse payloads normally. */
         sdp_parse_payload_types(sdp_p, cap_p, ptr);
         if (cap_p->num_payloads == 0) {
-            SDP_FREE(cap_p);
+            sdp_release(sdp_p, cap_p);
             sdp_p->conf_p->num_invalid_param++;
             return (SDP_INVALID_PARAMETER);
         }
@@ -3714,7 +3631,7 @@ sdp_result_e sdp_build_attr_cap (sdp_t *sdp_p, sdp_attr_t *attr_p,
 sdp_result_e sdp_parse_attr_cpar (sdp_t *sdp_p, sdp_attr_t *attr_p, 
                                   const char *ptr)
 {
-    u16           i;
+    int           i;
     sdp_result_e  result;
     sdp_mca_t    *cap_p;
     sdp_attr_t   *cap_attr_p = NULL;
@@ -3809,10 +3726,9 @@ sdp_result_e sdp_parse_attr_cpar (sdp_t *sdp_p, sdp_attr_t *attr_p,
      * specified type is. */
     attr_p->type = SDP_ATTR_INVALID;
     attr_p->next_p = NULL;
-    for (i=0; i < SDP_MAX_ATTR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_attr[i].name, sdp_attr[i].strlen) == 0) {
-            attr_p->type = (sdp_attr_e)i;
-        }
+    i = sdp_keyword_find(&sdp_attr_index, tmp);
+    if (i >= 0) {
+        attr_p->type = (sdp_attr_e)i;
     }
     if (attr_p->type == SDP_ATTR_INVALID) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -3961,7 +3877,6 @@ sdp_result_e sdp_parse_attr_comediadir (sdp_t *sdp_p, sdp_attr_t *attr_p,
 {
     int i;
     sdp_result_e  result;
-    tinybool      type_found = FALSE;
     char          tmp[SDP_MAX_STRING_LEN];
 
     attr_p->attr.comediadir.role = SDP_MEDIADIR_ROLE_PASSIVE;
@@ -3981,13 +3896,9 @@ sdp_result_e sdp_parse_attr_comediadir (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.comediadir.role = SDP_MEDIADIR_ROLE_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_MEDIADIR_ROLES; i++) {
-        if (strncasecmp(tmp, sdp_mediadir_role[i].name, 
-                        sdp_mediadir_role[i].strlen) == 0) {
-            type_found = TRUE;
-            attr_p->attr.comediadir.role = (sdp_mediadir_role_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_mediadir_role_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.comediadir.role = (sdp_mediadir_role_e)i;
     }
     if (attr_p->attr.comediadir.role == SDP_MEDIADIR_ROLE_UNSUPPORTED) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -4019,16 +3930,10 @@ sdp_result_e sdp_parse_attr_comediadir (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_SUCCESS); /* as the optional parameters are not there */
     }
     attr_p->attr.comediadir.conn_info.nettype = SDP_NT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name, 
-                        sdp_nettype[i].strlen) == 0) {
-            type_found = TRUE;
-        }
-        if (type_found == TRUE) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                attr_p->attr.comediadir.conn_info.nettype = (sdp_nettype_e)i;
-            }
-            type_found = FALSE;
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            attr_p->attr.comediadir.conn_info.nettype = (sdp_nettype_e)i;
         }
     }
     if (attr_p->attr.comediadir.conn_info.nettype == SDP_NT_UNSUPPORTED) {
@@ -4049,16 +3954,10 @@ sdp_result_e sdp_parse_attr_comediadir (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
     }
     attr_p->attr.comediadir.conn_info.addrtype = SDP_AT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            type_found = TRUE;
-        }
-        if (type_found == TRUE) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                attr_p->attr.comediadir.conn_info.addrtype = (sdp_addrtype_e)i;
-            }
-            type_found = FALSE;
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            attr_p->attr.comediadir.conn_info.addrtype = (sdp_addrtype_e)i;
         }
     }
     if (attr_p->attr.comediadir.conn_info.addrtype == SDP_AT_UNSUPPORTED) {
@@ -4186,11 +4085,9 @@ sdp_result_e sdp_parse_attr_silencesupp (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.silencesupp.pref = SDP_SILENCESUPP_PREF_UNKNOWN;
-    for (i=0; i < SDP_MAX_SILENCESUPP_PREF; i++) {
-        if (strncasecmp(tmp, sdp_silencesupp_pref[i].name,
-                        sdp_silencesupp_pref[i].strlen) == 0) {
-            attr_p->attr.silencesupp.pref = (sdp_silencesupp_pref_e)i;
-        }
+    i = sdp_keyword_find(&sdp_silencesupp_pref_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.silencesupp.pref = (sdp_silencesupp_pref_e)i;
     }
     if (attr_p->attr.silencesupp.pref == SDP_SILENCESUPP_PREF_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -4212,11 +4109,9 @@ sdp_result_e sdp_parse_attr_silencesupp (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_PARAMETER);
     }
     attr_p->attr.silencesupp.siduse = SDP_SILENCESUPP_SIDUSE_UNKNOWN;
-    for (i=0; i < SDP_MAX_SILENCESUPP_SIDUSE; i++) {
-        if (strncasecmp(tmp, sdp_silencesupp_siduse[i].name,
-                        sdp_silencesupp_siduse[i].strlen) == 0) {
-            attr_p->attr.silencesupp.siduse = (sdp_silencesupp_siduse_e)i;
-        }
+    i = sdp_keyword_find(&sdp_silencesupp_siduse_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.silencesupp.siduse = (sdp_silencesupp_siduse_e)i;
     }
     if (attr_p->attr.silencesupp.siduse == SDP_SILENCESUPP_SIDUSE_UNKNOWN) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -4667,18 +4562,15 @@ sdp_result_e sdp_parse_attr_group (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_INVALID_GROUP_LINE);
     }
     
-    for (i=0; i < SDP_MAX_GROUP_ATTR_VAL; i++) {
-        if (strncasecmp(tmp, sdp_group_attr_val[i].name,
-                        sdp_group_attr_val[i].strlen) == 0) {
-            attr_p->attr.group_data.group_attr = (sdp_group_attr_e)i;
+    i = sdp_keyword_find(&sdp_group_attr_val_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.group_data.group_attr = (sdp_group_attr_e)i;
 
-            if (sdp_p->debug_flag[SDP_DEBUG_TRACE]) {
-                SDP_PRINT("%s Parsed a=%s:%s", sdp_p->debug_str,
-                          sdp_get_attr_name(attr_p->type), 
-                          sdp_get_group_attr_name(
-                            attr_p->attr.group_data.group_attr));
-            }
-            break;
+        if (sdp_p->debug_flag[SDP_DEBUG_TRACE]) {
+            SDP_PRINT("%s Parsed a=%s:%s", sdp_p->debug_str,
+                      sdp_get_attr_name(attr_p->type), 
+                      sdp_get_group_attr_name(
+                        attr_p->attr.group_data.group_attr));
         }
     }
 
@@ -4704,7 +4596,7 @@ sdp_result_e sdp_parse_attr_group (sdp_t *sdp_p, sdp_attr_t *attr_p,
             }
             break;
         }
-        attr_p->attr.group_data.group_id_arr[i] = strdup(tmp);
+        attr_p->attr.group_data.group_id_arr[i] = sdp_strdup(sdp_p, tmp);
         attr_p->attr.group_data.num_group_id++;
 
         if (sdp_p->debug_flag[SDP_DEBUG_TRACE]) {
@@ -4792,12 +4684,10 @@ sdp_result_e sdp_parse_attr_rtcp (sdp_t *sdp_p, sdp_attr_t *attr_p,
         return (SDP_SUCCESS);
     }
 
-    for (i = 0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name,
-                        sdp_nettype[i].strlen) == 0) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                attr_p->attr.rtcp.nettype = (sdp_nettype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            attr_p->attr.rtcp.nettype = (sdp_nettype_e)i;
         }
     }
     if (attr_p->attr.rtcp.nettype == SDP_NT_UNSUPPORTED) {
@@ -4815,12 +4705,10 @@ sdp_result_e sdp_parse_attr_rtcp (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_RTCP_LINE);
     }
-    for (i = 0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                attr_p->attr.rtcp.addrtype = (sdp_addrtype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            attr_p->attr.rtcp.addrtype = (sdp_addrtype_e)i;
         }
     }
     if (attr_p->attr.rtcp.addrtype == SDP_AT_UNSUPPORTED) {
@@ -4902,12 +4790,9 @@ sdp_result_e sdp_parse_attr_source_filter (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_SRC_FILTER_LINE);
     }
-    for (i = 0; i < SDP_MAX_FILTER_MODE; i++) {
-        if (strncasecmp(tmp, sdp_src_filter_mode_val[i].name,
-                        sdp_src_filter_mode_val[i].strlen) == 0) {
-            attr_p->attr.source_filter.mode = (sdp_src_filter_mode_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_src_filter_mode_val_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.source_filter.mode = (sdp_src_filter_mode_e)i;
     }
     if (attr_p->attr.source_filter.mode == SDP_FILTER_MODE_NOT_PRESENT) {
         /* No point continuing */
@@ -4925,12 +4810,10 @@ sdp_result_e sdp_parse_attr_source_filter (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
-    for (i = 0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name,
-                        sdp_nettype[i].strlen) == 0) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                attr_p->attr.source_filter.nettype = (sdp_nettype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            attr_p->attr.source_filter.nettype = (sdp_nettype_e)i;
         }
     }
     if (attr_p->attr.source_filter.nettype == SDP_NT_UNSUPPORTED) {
@@ -4948,12 +4831,10 @@ sdp_result_e sdp_parse_attr_source_filter (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
-    for (i = 0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                attr_p->attr.source_filter.addrtype = (sdp_addrtype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            attr_p->attr.source_filter.addrtype = (sdp_addrtype_e)i;
         }
     }
     if (attr_p->attr.source_filter.addrtype == SDP_AT_UNSUPPORTED) {
@@ -5035,7 +4916,7 @@ sdp_result_e sdp_parse_attr_rtcp_unicast (sdp_t *sdp_p, sdp_attr_t *attr_p,
                                           const char *ptr)
 {
     sdp_result_e result;
-    u32 i;
+    int i;
     char tmp[SDP_MAX_STRING_LEN] = {0};
 
     attr_p->attr.u32_val = SDP_RTCP_UNICAST_MODE_NOT_PRESENT;
@@ -5049,12 +4930,9 @@ sdp_result_e sdp_parse_attr_rtcp_unicast (sdp_t *sdp_p, sdp_attr_t *attr_p,
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_RTCP_UNICAST_LINE);
     }
-    for (i = 0; i < SDP_RTCP_MAX_UNICAST_MODE;  i++) {
-        if (strncasecmp(tmp, sdp_rtcp_unicast_mode_val[i].name,
-                        sdp_rtcp_unicast_mode_val[i].strlen) == 0) {
-            attr_p->attr.u32_val = i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_rtcp_unicast_mode_val_index, tmp);
+    if (i >= 0) {
+        attr_p->attr.u32_val = i;
     }
     if (attr_p->attr.u32_val == SDP_RTCP_UNICAST_MODE_NOT_PRESENT) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -5740,7 +5618,7 @@ sdp_parse_attr_srtp (sdp_t *sdp_p, sdp_attr_t *attr_p,
     
     if (k) {
         tmp[k] = 0;
-	attr_p->attr.srtp_context.session_parameters = strdup(tmp);
+	attr_p->attr.srtp_context.session_parameters = sdp_strdup(sdp_p, tmp);
     }
        
     return SDP_SUCCESS;  
@@ -219,7 +219,7 @@ sdp_result_e sdp_add_new_attr (void *sdp_ptr, u16 level, u8 cap_num,
         }
     }
 
-    new_attr_p = (sdp_attr_t *)SDP_MALLOC(sizeof(sdp_attr_t));
+    new_attr_p = (sdp_attr_t *)sdp_alloc(sdp_p, sizeof(sdp_attr_t));
     if (new_attr_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -232,9 +232,10 @@ sdp_result_e sdp_add_new_attr (void *sdp_ptr, u16 level, u8 cap_num,
     switch (new_attr_p->type) {
     case SDP_ATTR_X_CAP:
     case SDP_ATTR_CDSC:
-        new_attr_p->attr.cap_p = (sdp_mca_t *)SDP_MALLOC(sizeof(sdp_mca_t));
+        new_attr_p->attr.cap_p =
+            (sdp_mca_t *)sdp_alloc(sdp_p, sizeof(sdp_mca_t));
         if (new_attr_p->attr.cap_p == NULL) {
-            sdp_free_attr(new_attr_p);
+            sdp_free_attr(sdp_p, new_attr_p);
             sdp_p->conf_p->num_no_resource++;
             return (SDP_NO_RESOURCE);
         }
@@ -306,7 +307,7 @@ sdp_result_e sdp_add_new_attr (void *sdp_ptr, u16 level, u8 cap_num,
         } else {
             mca_p = sdp_find_media_level(sdp_p, level);
             if (mca_p == NULL) {
-                sdp_free_attr(new_attr_p);
+                sdp_free_attr(sdp_p, new_attr_p);
                 sdp_p->conf_p->num_invalid_param++;
                 return (SDP_INVALID_PARAMETER);
             }
@@ -328,7 +329,7 @@ sdp_result_e sdp_add_new_attr (void *sdp_ptr, u16 level, u8 cap_num,
         /* Add a new capability attribute - find the capability attr. */
         attr_p = sdp_find_capability(sdp_p, level, cap_num);
         if (attr_p == NULL) {
-            sdp_free_attr(new_attr_p);
+            sdp_free_attr(sdp_p, new_attr_p);
             sdp_p->conf_p->num_invalid_param++;
             return (SDP_INVALID_PARAMETER);
         }
@@ -357,11 +358,13 @@ sdp_result_e sdp_add_new_attr (void *sdp_ptr, u16 level, u8 cap_num,
  * Description: Copy the fields of an attribute based on attr type.
  *              This is an INTERNAL SDP routine only.  It will not copy
  *              X-Cap, X-Cpar, CDSC, or CPAR attrs.
- * Parameters:  src_attr_p  Ptr to the source attribute.
+ * Parameters:  dst_sdp_p   The SDP description owning the dst attribute.
+ *              src_attr_p  Ptr to the source attribute.
  *              dst_attr_p  Ptr to the dst attribute.
  * Returns:     Nothing.
  */
-void sdp_copy_attr_fields (sdp_attr_t *src_attr_p, sdp_attr_t *dst_attr_p)
+void sdp_copy_attr_fields (sdp_t *dst_sdp_p, sdp_attr_t *src_attr_p,
+                           sdp_attr_t *dst_attr_p)
 {
     u16 i;
 
@@ -628,7 +631,8 @@ void sdp_copy_attr_fields (sdp_attr_t *src_attr_p, sdp_attr_t *dst_attr_p)
         
         for (i=0; i < src_attr_p->attr.group_data.num_group_id; i++) {
             dst_attr_p->attr.group_data.group_id_arr[i] =
-                strdup(src_attr_p->attr.group_data.group_id_arr[i]);
+                sdp_strdup(dst_sdp_p,
+                           src_attr_p->attr.group_data.group_id_arr[i]);
         }
         break;
 
@@ -701,7 +705,8 @@ void sdp_copy_attr_fields (sdp_attr_t *src_attr_p, sdp_attr_t *dst_attr_p)
 		    
 	if (src_attr_p->attr.srtp_context.session_parameters) {
 	    dst_attr_p->attr.srtp_context.session_parameters =
-	                strdup(src_attr_p->attr.srtp_context.session_parameters);
+	                sdp_strdup(dst_sdp_p,
+                           src_attr_p->attr.srtp_context.session_parameters);
 	}
 		    
         break;
@@ -783,7 +788,7 @@ sdp_result_e sdp_copy_attr (void *src_sdp_ptr, void *dst_sdp_ptr,
         return (SDP_INVALID_PARAMETER);
     }
 
-    new_attr_p = (sdp_attr_t *)SDP_MALLOC(sizeof(sdp_attr_t));
+    new_attr_p = (sdp_attr_t *)sdp_alloc(dst_sdp_p, sizeof(sdp_attr_t));
     if (new_attr_p == NULL) {
         src_sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -1055,7 +1060,8 @@ sdp_result_e sdp_copy_attr (void *src_sdp_ptr, void *dst_sdp_ptr,
         
         for (i=0; i < src_attr_p->attr.group_data.num_group_id; i++) {
             new_attr_p->attr.group_data.group_id_arr[i] =
-                strdup(src_attr_p->attr.group_data.group_id_arr[i]);
+                sdp_strdup(dst_sdp_p,
+                           src_attr_p->attr.group_data.group_id_arr[i]);
         }
         break;
 
@@ -1129,7 +1135,8 @@ sdp_result_e sdp_copy_attr (void *src_sdp_ptr, void *dst_sdp_ptr,
 		    
 	if (src_attr_p->attr.srtp_context.session_parameters) {
 	    new_attr_p->attr.srtp_context.session_parameters =
-	                strdup(src_attr_p->attr.srtp_context.session_parameters);
+	                sdp_strdup(dst_sdp_p,
+                           src_attr_p->attr.srtp_context.session_parameters);
 	}
 		    
         break;
@@ -1151,7 +1158,7 @@ sdp_result_e sdp_copy_attr (void *src_sdp_ptr, void *dst_sdp_ptr,
         } else {
             mca_p = sdp_find_media_level(dst_sdp_p, dst_level);
             if (mca_p == NULL) {
-                sdp_free_attr(new_attr_p);
+                sdp_free_attr(dst_sdp_p, new_attr_p);
                 src_sdp_p->conf_p->num_invalid_param++;
                 return (SDP_INVALID_PARAMETER);
             }
@@ -1168,7 +1175,7 @@ sdp_result_e sdp_copy_attr (void *src_sdp_ptr, void *dst_sdp_ptr,
         /* Add a new capability attribute - find the capability attr. */
         attr_p = sdp_find_capability(dst_sdp_p, dst_level, dst_cap_num);
         if (attr_p == NULL) {
-            sdp_free_attr(new_attr_p);
+            sdp_free_attr(dst_sdp_p, new_attr_p);
             src_sdp_p->conf_p->num_invalid_param++;
             return (SDP_INVALID_PARAMETER);
         }
@@ -1258,7 +1265,7 @@ sdp_result_e sdp_copy_all_attrs (void *src_sdp_ptr, void *dst_sdp_ptr,
     while (src_attr_p != NULL) {
 
         /* Allocate the new attr. */
-        new_attr_p = (sdp_attr_t *)SDP_MALLOC(sizeof(sdp_attr_t));
+        new_attr_p = (sdp_attr_t *)sdp_alloc(dst_sdp_p, sizeof(sdp_attr_t));
         if (new_attr_p == NULL) {
             src_sdp_p->conf_p->num_no_resource++;
             return (SDP_NO_RESOURCE);
@@ -1267,15 +1274,15 @@ sdp_result_e sdp_copy_all_attrs (void *src_sdp_ptr, void *dst_sdp_ptr,
         if ((src_attr_p->type != SDP_ATTR_X_CAP) &&
 	    (src_attr_p->type != SDP_ATTR_CDSC)) {
             /* Simple attr type - copy over all the attr info. */
-            sdp_copy_attr_fields(src_attr_p, new_attr_p);
+            sdp_copy_attr_fields(dst_sdp_p, src_attr_p, new_attr_p);
         } else {
             /* X-cap/cdsc attrs must be handled differently. Allocate an 
              * mca structure and copy over any X-cpar/cdsc attrs. */
             
             new_attr_p->attr.cap_p = 
-                (sdp_mca_t *)SDP_MALLOC(sizeof(sdp_mca_t));
+                (sdp_mca_t *)sdp_alloc(dst_sdp_p, sizeof(sdp_mca_t));
             if (new_attr_p->attr.cap_p == NULL) {
-	        sdp_free_attr(new_attr_p);
+	        sdp_free_attr(dst_sdp_p, new_attr_p);
                 return (SDP_NO_RESOURCE);
             }
 
@@ -1312,14 +1319,16 @@ sdp_result_e sdp_copy_all_attrs (void *src_sdp_ptr, void *dst_sdp_ptr,
             /* Copy all of the X-cpar/cpar attrs from the src. */
             while (src_cap_attr_p != NULL) {
 
-                new_cap_attr_p = (sdp_attr_t *)SDP_MALLOC(sizeof(sdp_attr_t));
+                new_cap_attr_p = (sdp_attr_t *)
+                    sdp_alloc(dst_sdp_p, sizeof(sdp_attr_t));
                 if (new_cap_attr_p == NULL) {
-		    sdp_free_attr (new_attr_p);
+		    sdp_free_attr(dst_sdp_p, new_attr_p);
                     return (SDP_NO_RESOURCE);
                 }
                 
                 /* Copy X-cpar/cpar attribute info. */
-                sdp_copy_attr_fields(src_cap_attr_p, new_cap_attr_p);
+                sdp_copy_attr_fields(dst_sdp_p, src_cap_attr_p,
+                                     new_cap_attr_p);
 
                 /* Now add the new X-cpar/cpar attr in the right place. */
                 if (dst_cap_attr_p == NULL) {
@@ -1513,7 +1522,7 @@ sdp_result_e sdp_get_attr_type (void *sdp_ptr, u16 level, u8 cap_num,
  * associated with an attribute may or may not have been already 
  * allocated. This routine should check this carefully.
  */
-void sdp_free_attr (sdp_attr_t *attr_p) 
+void sdp_free_attr (sdp_t *sdp_p, sdp_attr_t *attr_p) 
 {
     sdp_mca_t   *cap_p;
     sdp_attr_t  *cpar_p;
@@ -1528,22 +1537,22 @@ void sdp_free_attr (sdp_attr_t *attr_p)
         if (cap_p != NULL) {
             for (cpar_p = cap_p->media_attrs_p; cpar_p != NULL;) {
                 next_cpar_p = cpar_p->next_p;
-                sdp_free_attr(cpar_p);
+                sdp_free_attr(sdp_p, cpar_p);
                 cpar_p = next_cpar_p;
             }
-            SDP_FREE(cap_p);
+            sdp_release(sdp_p, cap_p);
         }
     } else if ((attr_p->type == SDP_ATTR_SDESCRIPTIONS) ||
               (attr_p->type == SDP_ATTR_SRTP_CONTEXT)) {
-              SDP_FREE(attr_p->attr.srtp_context.session_parameters);
+              sdp_release(sdp_p, attr_p->attr.srtp_context.session_parameters);
     } else if (attr_p->type == SDP_ATTR_GROUP) {
         for(i=0; i < attr_p->attr.group_data.num_group_id; i++) {
-            SDP_FREE(attr_p->attr.group_data.group_id_arr[i]);
+            sdp_release(sdp_p, attr_p->attr.group_data.group_id_arr[i]);
         }
     }
 
     /* Now free the actual attribute memory. */
-    SDP_FREE(attr_p);
+    sdp_release(sdp_p, attr_p);
 
 }
 
@@ -1599,7 +1608,7 @@ sdp_result_e sdp_delete_attr (void *sdp_ptr, u16 level, u8 cap_num,
             } else {
                 prev_attr_p->next_p = attr_p->next_p;
             }
-            sdp_free_attr(attr_p);
+            sdp_free_attr(sdp_p, attr_p);
         } else {  /* Attr is at a media level */
             mca_p = sdp_find_media_level(sdp_p, level);
             if (mca_p == NULL) {
@@ -1629,7 +1638,7 @@ sdp_result_e sdp_delete_attr (void *sdp_ptr, u16 level, u8 cap_num,
             } else {
                 prev_attr_p->next_p = attr_p->next_p;
             }
-            sdp_free_attr(attr_p);
+            sdp_free_attr(sdp_p, attr_p);
         }  /* Attr is at a media level */
     } else {
         /* Attr is a capability X-cpar/cpar attribute, find the capability. */
@@ -1663,7 +1672,7 @@ sdp_result_e sdp_delete_attr (void *sdp_ptr, u16 level, u8 cap_num,
         } else {
             prev_attr_p->next_p = attr_p->next_p;
         }
-        sdp_free_attr(attr_p);
+        sdp_free_attr(sdp_p, attr_p);
     }
 
     return (SDP_SUCCESS);
@@ -1696,7 +1705,7 @@ sdp_result_e sdp_delete_all_attrs (void *sdp_ptr, u16 level, u8 cap_num)
             attr_p = sdp_p->sess_attrs_p;
             while (attr_p != NULL) {
                 next_attr_p = attr_p->next_p;
-                sdp_free_attr(attr_p);
+                sdp_free_attr(sdp_p, attr_p);
                 attr_p = next_attr_p;
             }
             sdp_p->sess_attrs_p = NULL;
@@ -1709,7 +1718,7 @@ sdp_result_e sdp_delete_all_attrs (void *sdp_ptr, u16 level, u8 cap_num)
             attr_p = mca_p->media_attrs_p;
             while (attr_p != NULL) {
                 next_attr_p = attr_p->next_p;
-                sdp_free_attr(attr_p);
+                sdp_free_attr(sdp_p, attr_p);
                 attr_p = next_attr_p;
             }
             mca_p->media_attrs_p = NULL;
@@ -1726,7 +1735,7 @@ sdp_result_e sdp_delete_all_attrs (void *sdp_ptr, u16 level, u8 cap_num)
         attr_p = cap_p->media_attrs_p;
         while (attr_p != NULL) {
             next_attr_p = attr_p->next_p;
-            sdp_free_attr(attr_p);
+            sdp_free_attr(sdp_p, attr_p);
             attr_p = next_attr_p;
         }
         cap_p->media_attrs_p = NULL;
@@ -2665,7 +2674,7 @@ sdp_result_e sdp_delete_all_media_direction_attrs (void *sdp_ptr, u16 level)
                 }
                 attr_p = attr_p->next_p;
 
-                sdp_free_attr(tmp_attr_p);                
+                sdp_free_attr(sdp_p, tmp_attr_p);                
             } else {
                 prev_attr_p = attr_p;
                 attr_p = attr_p->next_p;
@@ -2693,7 +2702,7 @@ sdp_result_e sdp_delete_all_media_direction_attrs (void *sdp_ptr, u16 level)
                 }
                 attr_p = attr_p->next_p;
 
-                sdp_free_attr(tmp_attr_p);
+                sdp_free_attr(sdp_p, tmp_attr_p);
             } else {
                 prev_attr_p = attr_p;
                 attr_p = attr_p->next_p;
@@ -9776,9 +9785,10 @@ sdp_result_e sdp_set_group_id (void *sdp_ptr, u16 level,
         }
 
         if (attr_p->attr.group_data.group_id_arr[id_num-1]) {
-            SDP_FREE(attr_p->attr.group_data.group_id_arr[id_num-1]);
+            sdp_release(sdp_p, attr_p->attr.group_data.group_id_arr[id_num-1]);
         }
-        attr_p->attr.group_data.group_id_arr[id_num-1] = strdup(group_id);
+        attr_p->attr.group_data.group_id_arr[id_num-1] =
+            sdp_strdup(sdp_p, group_id);
             
         return (SDP_SUCCESS);
     }
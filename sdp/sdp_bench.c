@@ -0,0 +1,276 @@
+/*
+ *------------------------------------------------------------------
+ * sdp_bench.c  -- Parse benchmark for the generic SDP parser.
+ *
+ * Generates a channel lineup of VQE sessions in memory and times how
+ * long the parser takes to parse all of them, as the configuration
+ * manager does when it loads a channel database.  The lineup is parsed
+ * with descriptions allocated from the heap and from an arena.  The
+ * keyword lookup used to dispatch attributes and tokens is also timed
+ * against the linear table scan it replaces.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "sdp_os_defs.h"
+#include "sdp.h"
+#include "sdp_private.h"
+
+#define SDP_BENCH_DEFAULT_CHANNELS      1000
+#define SDP_BENCH_DEFAULT_ITERATIONS    10
+#define SDP_BENCH_SESSION_LEN           2048
+#define SDP_BENCH_LOOKUPS               1000000
+
+void *my_malloc(unsigned bytes);
+void my_free(void *ptr);
+
+/*
+ * A channel session, as found in a VQE channel lineup.  The channel
+ * number selects the multicast group and the RTCP/retransmission ports.
+ */
+static const char sdp_bench_template[] =
+    "v=0\r\n"
+    "o=dncs 0130282450120741990000110790000%05u 1211890050 IN IP4 "
+    "10.253.0.1\r\n"
+    "s=Channel %u\r\n"
+    "i=Channel setup for channel %u\r\n"
+    "t=0 0\r\n"
+    "a=rtcp-unicast:rsi\r\n"
+    "a=group:FID 1 3\r\n"
+    "m=video 2000 RTP/AVPF 120\r\n"
+    "i=Original Stream\r\n"
+    "c=IN IP4 226.5.%u.%u/255\r\n"
+    "b=AS:12000\r\n"
+    "b=RS:53\r\n"
+    "b=RR:53000\r\n"
+    "a=fmtp:120 rtcp-per-rcvr-bw=53\r\n"
+    "a=recvonly\r\n"
+    "a=source-filter: incl IN IP4 226.5.%u.%u 192.168.81.150\r\n"
+    "a=rtpmap:120 MP2T/90000\r\n"
+    "a=rtcp:%u IN IP4 172.16.10.42\r\n"
+    "a=rtcp-fb:120 nack\r\n"
+    "a=mid:1\r\n"
+    "m=video %u RTP/AVPF 112\r\n"
+    "i=Retransmission Stream\r\n"
+    "c=IN IP4 172.16.10.42\r\n"
+    "b=RS:53\r\n"
+    "b=RR:53\r\n"
+    "a=recvonly\r\n"
+    "a=rtpmap:112 rtx/90000\r\n"
+    "a=rtcp:%u\r\n"
+    "a=fmtp:112 apt=120\r\n"
+    "a=fmtp:112 rtx-time=250\r\n"
+    "a=mid:3\r\n";
+
+/* Attribute names looked up by the keyword benchmark. */
+static const char *sdp_bench_attrs[] = {
+    "rtcp-unicast", "group", "fmtp", "recvonly", "source-filter",
+    "rtpmap", "rtcp", "rtcp-fb", "mid", "inactive", "x-unknown",
+};
+#define SDP_BENCH_NUM_ATTRS \
+    (sizeof(sdp_bench_attrs) / sizeof(sdp_bench_attrs[0]))
+
+static double sdp_bench_elapsed_us (struct timeval *start)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return ((now.tv_sec - start->tv_sec) * 1000000.0 +
+            (now.tv_usec - start->tv_usec));
+}
+
+static void *sdp_bench_init_config (void)
+{
+    void *conf_p;
+
+    /* The configuration used by the VQE-C configuration manager. */
+    conf_p = sdp_init_config();
+    if (conf_p == NULL) {
+        return (NULL);
+    }
+
+    sdp_appl_debug(conf_p, SDP_DEBUG_TRACE, FALSE);
+    sdp_appl_debug(conf_p, SDP_DEBUG_WARNINGS, FALSE);
+    sdp_appl_debug(conf_p, SDP_DEBUG_ERRORS, FALSE);
+
+    sdp_require_version(conf_p, TRUE);
+    sdp_require_owner(conf_p, TRUE);
+    sdp_require_session_name(conf_p, TRUE);
+    sdp_require_timespec(conf_p, TRUE);
+
+    sdp_media_supported(conf_p, SDP_MEDIA_VIDEO, TRUE);
+
+    sdp_nettype_supported(conf_p, SDP_NT_INTERNET, TRUE);
+    sdp_addrtype_supported(conf_p, SDP_AT_IP4, TRUE);
+
+    sdp_transport_supported(conf_p, SDP_TRANSPORT_UDP, TRUE);
+    sdp_transport_supported(conf_p, SDP_TRANSPORT_RTPAVP, TRUE);
+    sdp_transport_supported(conf_p, SDP_TRANSPORT_RTPAVPF, TRUE);
+
+    return (conf_p);
+}
+
+/*
+ * Parse every session of the lineup, iterations times, allocating the
+ * descriptions from the arena if one is given.  Returns the elapsed time
+ * in microseconds.
+ */
+static double sdp_bench_parse (void *conf_p, void *arena_p, char *lineup,
+                               unsigned num_channels, unsigned iterations,
+                               unsigned *failed)
+{
+    void *sdp_p;
+    char *session, *ptr;
+    unsigned chan, iter;
+    size_t len;
+    struct timeval start;
+    sdp_result_e result;
+
+    gettimeofday(&start, NULL);
+    for (iter = 0; iter < iterations; iter++) {
+        for (chan = 0; chan < num_channels; chan++) {
+            session = lineup + (size_t)chan * SDP_BENCH_SESSION_LEN;
+            len = strlen(session);
+            ptr = session;
+            sdp_p = sdp_init_description_arena(conf_p, arena_p);
+            if (sdp_p == NULL) {
+                printf("Out of memory\n");
+                exit(-1);
+            }
+            result = sdp_parse(sdp_p, &ptr, len);
+            if (result != SDP_SUCCESS) {
+                (*failed)++;
+            }
+            sdp_free_description(sdp_p);
+            if (arena_p) {
+                sdp_reset_arena(arena_p);
+            }
+        }
+    }
+    return (sdp_bench_elapsed_us(&start));
+}
+
+/*
+ * Time the attribute lookup, by hashed index and by linear scan.
+ */
+static void sdp_bench_keywords (void)
+{
+    struct timeval start;
+    double index_us, scan_us;
+    unsigned n, i;
+    int found = 0;
+    const char *name;
+
+    gettimeofday(&start, NULL);
+    for (n = 0; n < SDP_BENCH_LOOKUPS; n++) {
+        name = sdp_bench_attrs[n % SDP_BENCH_NUM_ATTRS];
+        if (sdp_keyword_find(&sdp_attr_index, name) >= 0) {
+            found++;
+        }
+    }
+    index_us = sdp_bench_elapsed_us(&start);
+
+    gettimeofday(&start, NULL);
+    for (n = 0; n < SDP_BENCH_LOOKUPS; n++) {
+        name = sdp_bench_attrs[n % SDP_BENCH_NUM_ATTRS];
+        for (i = 0; i < SDP_MAX_ATTR_TYPES; i++) {
+            if (strncasecmp(name, sdp_attr[i].name,
+                            sdp_attr[i].strlen) == 0) {
+                found--;
+                break;
+            }
+        }
+    }
+    scan_us = sdp_bench_elapsed_us(&start);
+
+    printf("Attribute lookups:     %u\n", SDP_BENCH_LOOKUPS);
+    printf("  hashed index:        %.1f ns/lookup\n",
+           index_us * 1000.0 / SDP_BENCH_LOOKUPS);
+    printf("  linear scan:         %.1f ns/lookup\n",
+           scan_us * 1000.0 / SDP_BENCH_LOOKUPS);
+    if (found != 0) {
+        printf("  MISMATCH between index and scan results\n");
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    void *conf_p, *arena_p;
+    char *lineup, *session;
+    unsigned num_channels = SDP_BENCH_DEFAULT_CHANNELS;
+    unsigned iterations = SDP_BENCH_DEFAULT_ITERATIONS;
+    unsigned chan, failed = 0;
+    double heap_us, arena_us;
+
+    if (argc > 1) {
+        num_channels = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        iterations = strtoul(argv[2], NULL, 10);
+    }
+    if ((num_channels == 0) || (num_channels > 65535) || (iterations == 0)) {
+        printf("Usage: sdp-bench [<channels> [<iterations>]]\n");
+        exit(-1);
+    }
+
+    conf_p = sdp_bench_init_config();
+    arena_p = sdp_init_arena(0);
+    lineup = malloc((size_t)num_channels * SDP_BENCH_SESSION_LEN);
+    if ((conf_p == NULL) || (arena_p == NULL) || (lineup == NULL)) {
+        printf("Out of memory\n");
+        exit(-1);
+    }
+
+    for (chan = 0; chan < num_channels; chan++) {
+        session = lineup + (size_t)chan * SDP_BENCH_SESSION_LEN;
+        snprintf(session, SDP_BENCH_SESSION_LEN, sdp_bench_template,
+                 chan, chan, chan,
+                 chan / 256, chan % 256,
+                 chan / 256, chan % 256,
+                 2001 + 2 * chan,
+                 3000 + 2 * chan,
+                 3001 + 2 * chan);
+    }
+
+    heap_us = sdp_bench_parse(conf_p, NULL, lineup, num_channels,
+                              iterations, &failed);
+    arena_us = sdp_bench_parse(conf_p, arena_p, lineup, num_channels,
+                               iterations, &failed);
+
+    printf("Channels:              %u\n", num_channels);
+    printf("Iterations:            %u\n", iterations);
+    printf("Parse failures:        %u\n", failed);
+    printf("Lineup parse time:     %.3f ms (heap), %.3f ms (arena)\n",
+           heap_us / iterations / 1000.0, arena_us / iterations / 1000.0);
+    printf("Per channel:           %.2f us (heap), %.2f us (arena)\n",
+           heap_us / iterations / num_channels,
+           arena_us / iterations / num_channels);
+    sdp_bench_keywords();
+
+    free(lineup);
+    sdp_free_arena(arena_p);
+    SDP_FREE(conf_p);
+
+    return (failed ? 1 : 0);
+}
+
+
+/*
+ * Allocation hooks used by the SDP library; they zero memory as the
+ * configuration manager's do.
+ */
+void *my_malloc (unsigned bytes)
+{
+    return (calloc(1, bytes));
+}
+
+void my_free (void *ptr)
+{
+    free(ptr);
+}
@@ -59,6 +59,9 @@ void *sdp_init_config ()
     /* Initialize magic number. */
     conf_p->magic_num = SDP_MAGIC_NUM;
 
+    /* Build the parser's keyword lookup indexes, if not already built. */
+    sdp_init_keyword_indexes();
+
     /* Set default debug flags. */
     conf_p->debug_flag[SDP_DEBUG_TRACE]    = FALSE;
     conf_p->debug_flag[SDP_DEBUG_WARNINGS] = FALSE;
@@ -0,0 +1,258 @@
+/*
+ *------------------------------------------------------------------
+ * sdp_keyword_test.c  -- Checks the SDP keyword lookup indexes.
+ *
+ * For every token table indexed by sdp_init_keyword_indexes(), looks
+ * up each name as written, upper-cased and lower-cased, together with
+ * tokens that are not in the table, and checks that the index returns
+ * the entry the linear strncasecmp scan it replaced would have.  Also
+ * checks that a table too large to index is refused.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "sdp_os_defs.h"
+#include "sdp.h"
+#include "sdp_private.h"
+
+#define SDP_KEYWORD_TEST_TOKEN_LEN      64
+
+void *my_malloc(unsigned bytes);
+void my_free(void *ptr);
+
+/*
+ * An indexed table, described by its first name and entry size so that
+ * sdp_attr and the sdp_namearray_t tables can be scanned alike.
+ */
+typedef struct {
+    const char                *label;
+    const sdp_keyword_index_t *index;
+    const char                *table;
+    u16                        stride;
+    u16                        num_entries;
+} sdp_keyword_test_table_t;
+
+#define SDP_KEYWORD_TEST_TABLE(table, count)                            \
+    { #table, &table##_index, (const char *)table, sizeof(table[0]), count }
+
+static const sdp_keyword_test_table_t sdp_keyword_test_tables[] = {
+    SDP_KEYWORD_TEST_TABLE(sdp_attr, SDP_MAX_ATTR_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_media, SDP_MAX_MEDIA_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_nettype, SDP_MAX_NETWORK_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_addrtype, SDP_MAX_ADDR_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_transport, SDP_MAX_TRANSPORT_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_encrypt, SDP_MAX_ENCRYPT_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_payload, SDP_MAX_STRING_PAYLOAD_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_t38_rate, SDP_T38_MAX_RATES),
+    SDP_KEYWORD_TEST_TABLE(sdp_t38_udpec, SDP_T38_MAX_UDPEC),
+    SDP_KEYWORD_TEST_TABLE(sdp_qos_strength, SDP_MAX_QOS_STRENGTH),
+    SDP_KEYWORD_TEST_TABLE(sdp_qos_direction, SDP_MAX_QOS_DIR),
+    SDP_KEYWORD_TEST_TABLE(sdp_qos_status_type, SDP_MAX_QOS_STATUS_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_curr_type, SDP_MAX_CURR_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_des_type, SDP_MAX_DES_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_conf_type, SDP_MAX_CONF_TYPES),
+    SDP_KEYWORD_TEST_TABLE(sdp_mediadir_role, SDP_MAX_MEDIADIR_ROLES),
+    SDP_KEYWORD_TEST_TABLE(sdp_fmtp_codec_param, SDP_MAX_FMTP_PARAM),
+    SDP_KEYWORD_TEST_TABLE(sdp_fmtp_rtp_retrans_param,
+                           SDP_MAX_FMTP_RTP_RETRANS_VAL),
+    SDP_KEYWORD_TEST_TABLE(sdp_silencesupp_pref, SDP_MAX_SILENCESUPP_PREF),
+    SDP_KEYWORD_TEST_TABLE(sdp_silencesupp_siduse,
+                           SDP_MAX_SILENCESUPP_SIDUSE),
+    SDP_KEYWORD_TEST_TABLE(sdp_bw_modifier_val, SDP_MAX_BW_MODIFIER_VAL),
+    SDP_KEYWORD_TEST_TABLE(sdp_group_attr_val, SDP_MAX_GROUP_ATTR_VAL),
+    SDP_KEYWORD_TEST_TABLE(sdp_src_filter_mode_val, SDP_MAX_FILTER_MODE),
+    SDP_KEYWORD_TEST_TABLE(sdp_rtcp_unicast_mode_val,
+                           SDP_RTCP_MAX_UNICAST_MODE),
+};
+
+#undef SDP_KEYWORD_TEST_TABLE
+
+/* Tokens that are expected to be in none of the tables. */
+static const char *sdp_keyword_test_unknown[] = {
+    "", "x", "x-unknown-token", " ", "rtpmap ", "RTPMAP:96",
+};
+
+/*
+ * Entry i of a table; every indexed table's entries start with their
+ * name, followed by the length of the name including its NUL.
+ */
+static const char *sdp_keyword_test_name (const sdp_keyword_test_table_t *t,
+                                          u16 i)
+{
+    return (*(const char * const *)(t->table + i * t->stride));
+}
+
+static u16 sdp_keyword_test_strlen (const sdp_keyword_test_table_t *t, u16 i)
+{
+    if (t->table == (const char *)sdp_attr) {
+        return (sdp_attr[i].strlen);
+    }
+    return (((const sdp_namearray_t *)t->table)[i].strlen);
+}
+
+/*
+ * The lookup the parser did before the tables were indexed.
+ */
+static int sdp_keyword_test_scan (const sdp_keyword_test_table_t *t,
+                                  const char *tok)
+{
+    u16 i;
+
+    for (i = 0; i < t->num_entries; i++) {
+        if (sdp_keyword_test_name(t, i) == NULL) {
+            continue;
+        }
+        if (strncasecmp(tok, sdp_keyword_test_name(t, i),
+                        sdp_keyword_test_strlen(t, i)) == 0) {
+            return (i);
+        }
+    }
+    return (-1);
+}
+
+static int sdp_keyword_test_check (const sdp_keyword_test_table_t *t,
+                                   const char *tok)
+{
+    int found, expected;
+
+    found = sdp_keyword_find(t->index, tok);
+    expected = sdp_keyword_test_scan(t, tok);
+    if (found != expected) {
+        printf("%s: \"%s\" found entry %d, linear scan finds %d\n",
+               t->label, tok, found, expected);
+        return (1);
+    }
+    return (0);
+}
+
+static int sdp_keyword_test_table (const sdp_keyword_test_table_t *t)
+{
+    char tok[SDP_KEYWORD_TEST_TOKEN_LEN];
+    const char *name;
+    size_t len, j;
+    int failed = 0;
+    u16 i;
+
+    for (i = 0; i < sizeof(sdp_keyword_test_unknown) /
+             sizeof(sdp_keyword_test_unknown[0]); i++) {
+        failed += sdp_keyword_test_check(t, sdp_keyword_test_unknown[i]);
+    }
+
+    for (i = 0; i < t->num_entries; i++) {
+        name = sdp_keyword_test_name(t, i);
+        if (name == NULL) {
+            continue;
+        }
+        len = strlen(name);
+        if (len + 2 > sizeof(tok)) {
+            printf("%s: name \"%s\" is too long to test\n", t->label, name);
+            failed++;
+            continue;
+        }
+
+        failed += sdp_keyword_test_check(t, name);
+        for (j = 0; j <= len; j++) {
+            tok[j] = toupper((unsigned char)name[j]);
+        }
+        failed += sdp_keyword_test_check(t, tok);
+        for (j = 0; j <= len; j++) {
+            tok[j] = tolower((unsigned char)name[j]);
+        }
+        failed += sdp_keyword_test_check(t, tok);
+
+        /* A name with a character added, and with its last one removed. */
+        memcpy(tok, name, len);
+        tok[len] = 'x';
+        tok[len + 1] = '\0';
+        failed += sdp_keyword_test_check(t, tok);
+        if (len > 0) {
+            tok[len - 1] = '\0';
+            failed += sdp_keyword_test_check(t, tok);
+        }
+    }
+
+    return (failed);
+}
+
+/*
+ * A table with SDP_KEYWORD_MAX_SLOTS / 2 entries must be left
+ * unindexed, and one with an entry fewer must be indexed.
+ */
+static int sdp_keyword_test_limit (void)
+{
+    static sdp_namearray_t names[SDP_KEYWORD_MAX_SLOTS / 2];
+    static char text[SDP_KEYWORD_MAX_SLOTS / 2][8];
+    sdp_keyword_index_t index;
+    int failed = 0, found;
+    u16 i;
+
+    for (i = 0; i < SDP_KEYWORD_MAX_SLOTS / 2; i++) {
+        snprintf(text[i], sizeof(text[i]), "k%u", i);
+        names[i].name = text[i];
+        names[i].strlen = strlen(text[i]) + 1;
+    }
+
+    sdp_keyword_index_init(&index, names, sizeof(names[0]),
+                           SDP_KEYWORD_MAX_SLOTS / 2 - 1);
+    for (i = 0; i < SDP_KEYWORD_MAX_SLOTS / 2 - 1; i++) {
+        found = sdp_keyword_find(&index, names[i].name);
+        if (found != i) {
+            printf("limit: \"%s\" found entry %d in a table of %u\n",
+                   names[i].name, found, SDP_KEYWORD_MAX_SLOTS / 2 - 1);
+            failed++;
+        }
+    }
+
+    sdp_keyword_index_init(&index, names, sizeof(names[0]),
+                           SDP_KEYWORD_MAX_SLOTS / 2);
+    printf("\n");              /* SDP_ERROR does not end its line. */
+    for (i = 0; i < SDP_KEYWORD_MAX_SLOTS / 2; i++) {
+        found = sdp_keyword_find(&index, names[i].name);
+        if (found != -1) {
+            printf("limit: \"%s\" found entry %d in a table of %u\n",
+                   names[i].name, found, SDP_KEYWORD_MAX_SLOTS / 2);
+            failed++;
+        }
+    }
+
+    return (failed);
+}
+
+int main (int argc, char *argv[])
+{
+    int failed = 0;
+    u16 i;
+
+    sdp_init_keyword_indexes();
+
+    for (i = 0; i < sizeof(sdp_keyword_test_tables) /
+             sizeof(sdp_keyword_test_tables[0]); i++) {
+        failed += sdp_keyword_test_table(&sdp_keyword_test_tables[i]);
+    }
+    failed += sdp_keyword_test_limit();
+
+    printf("%u tables checked, %d failure(s)\n",
+           (unsigned)(sizeof(sdp_keyword_test_tables) /
+                      sizeof(sdp_keyword_test_tables[0])), failed);
+    return (failed ? 1 : 0);
+}
+
+
+/*
+ * Allocation hooks used by the SDP library.
+ */
+void *my_malloc (unsigned bytes)
+{
+    return (calloc(1, bytes));
+}
+
+void my_free (void *ptr)
+{
+    free(ptr);
+}
@@ -469,6 +469,81 @@ const sdp_srtp_crypto_suite_list sdp_srtp_crypto_suite_array[SDP_SRTP_MAX_NUM_CR
       SDP_SRTP_F8_128_HMAC_SHA1_80_SALT_BYTES}
 };
 
+/* Keyword lookup indexes for the tables above, built once by
+ * sdp_init_keyword_indexes(). */
+sdp_keyword_index_t sdp_attr_index;
+sdp_keyword_index_t sdp_media_index;
+sdp_keyword_index_t sdp_nettype_index;
+sdp_keyword_index_t sdp_addrtype_index;
+sdp_keyword_index_t sdp_transport_index;
+sdp_keyword_index_t sdp_encrypt_index;
+sdp_keyword_index_t sdp_payload_index;
+sdp_keyword_index_t sdp_t38_rate_index;
+sdp_keyword_index_t sdp_t38_udpec_index;
+sdp_keyword_index_t sdp_qos_strength_index;
+sdp_keyword_index_t sdp_qos_direction_index;
+sdp_keyword_index_t sdp_qos_status_type_index;
+sdp_keyword_index_t sdp_curr_type_index;
+sdp_keyword_index_t sdp_des_type_index;
+sdp_keyword_index_t sdp_conf_type_index;
+sdp_keyword_index_t sdp_mediadir_role_index;
+sdp_keyword_index_t sdp_fmtp_codec_param_index;
+sdp_keyword_index_t sdp_fmtp_rtp_retrans_param_index;
+sdp_keyword_index_t sdp_silencesupp_pref_index;
+sdp_keyword_index_t sdp_silencesupp_siduse_index;
+sdp_keyword_index_t sdp_bw_modifier_val_index;
+sdp_keyword_index_t sdp_group_attr_val_index;
+sdp_keyword_index_t sdp_src_filter_mode_val_index;
+sdp_keyword_index_t sdp_rtcp_unicast_mode_val_index;
+
+static tinybool sdp_keyword_indexes_built = FALSE;
+
+/* Function:    sdp_init_keyword_indexes
+ * Description: Build the keyword lookup indexes used by the parser.
+ *              Called from sdp_init_config(); later calls do nothing.
+ * Parameters:  None.
+ * Returns:     Nothing.
+ */
+void sdp_init_keyword_indexes (void)
+{
+    if (sdp_keyword_indexes_built == TRUE) {
+        return;
+    }
+
+#define SDP_KEYWORD_INDEX_INIT(table, count)                            \
+    sdp_keyword_index_init(&table##_index, table, sizeof(table[0]), count)
+
+    SDP_KEYWORD_INDEX_INIT(sdp_attr, SDP_MAX_ATTR_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_media, SDP_MAX_MEDIA_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_nettype, SDP_MAX_NETWORK_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_addrtype, SDP_MAX_ADDR_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_transport, SDP_MAX_TRANSPORT_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_encrypt, SDP_MAX_ENCRYPT_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_payload, SDP_MAX_STRING_PAYLOAD_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_t38_rate, SDP_T38_MAX_RATES);
+    SDP_KEYWORD_INDEX_INIT(sdp_t38_udpec, SDP_T38_MAX_UDPEC);
+    SDP_KEYWORD_INDEX_INIT(sdp_qos_strength, SDP_MAX_QOS_STRENGTH);
+    SDP_KEYWORD_INDEX_INIT(sdp_qos_direction, SDP_MAX_QOS_DIR);
+    SDP_KEYWORD_INDEX_INIT(sdp_qos_status_type, SDP_MAX_QOS_STATUS_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_curr_type, SDP_MAX_CURR_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_des_type, SDP_MAX_DES_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_conf_type, SDP_MAX_CONF_TYPES);
+    SDP_KEYWORD_INDEX_INIT(sdp_mediadir_role, SDP_MAX_MEDIADIR_ROLES);
+    SDP_KEYWORD_INDEX_INIT(sdp_fmtp_codec_param, SDP_MAX_FMTP_PARAM);
+    SDP_KEYWORD_INDEX_INIT(sdp_fmtp_rtp_retrans_param,
+                           SDP_MAX_FMTP_RTP_RETRANS_VAL);
+    SDP_KEYWORD_INDEX_INIT(sdp_silencesupp_pref, SDP_MAX_SILENCESUPP_PREF);
+    SDP_KEYWORD_INDEX_INIT(sdp_silencesupp_siduse, SDP_MAX_SILENCESUPP_SIDUSE);
+    SDP_KEYWORD_INDEX_INIT(sdp_bw_modifier_val, SDP_MAX_BW_MODIFIER_VAL);
+    SDP_KEYWORD_INDEX_INIT(sdp_group_attr_val, SDP_MAX_GROUP_ATTR_VAL);
+    SDP_KEYWORD_INDEX_INIT(sdp_src_filter_mode_val, SDP_MAX_FILTER_MODE);
+    SDP_KEYWORD_INDEX_INIT(sdp_rtcp_unicast_mode_val, SDP_RTCP_MAX_UNICAST_MODE);
+
+#undef SDP_KEYWORD_INDEX_INIT
+
+    sdp_keyword_indexes_built = TRUE;
+}
+
 const char* sdp_result_name[SDP_MAX_RC] = 
     {"SDP_SUCCESS", 
      "SDP_FAILURE", 
@@ -755,16 +830,42 @@ tinybool sdp_verify_sdp_ptr (sdp_t *sdp_p)
  * Returns:     A handle for a new SDP structure as a void ptr.
 */
 void *sdp_init_description (void *config_p)
+{
+    return (sdp_init_description_arena(config_p, NULL));
+}
+
+/* Function:    sdp_init_description_arena
+ * Description:	Allocates a new SDP structure the same way as 
+ *              sdp_init_description, except that the structure and all
+ *              of the memory allocated while parsing or building into it
+ *              come from the given arena.  sdp_free_description must still
+ *              be called, but releases nothing back to the heap; the 
+ *              memory is reclaimed all at once by sdp_reset_arena or
+ *              sdp_free_arena.
+ * Parameters:  config_p     The config handle returned by sdp_init_config
+ *              arena_ptr    The arena handle returned by sdp_init_arena,
+ *                           or NULL to allocate from the heap.
+ * Returns:     A handle for a new SDP structure as a void ptr.
+*/
+void *sdp_init_description_arena (void *config_p, void *arena_ptr)
 {
     int i;
     sdp_t *sdp_p;
     sdp_conf_options_t *conf_p = (sdp_conf_options_t *)config_p;
+    sdp_arena_t *arena_p = (sdp_arena_t *)arena_ptr;
 
     if (sdp_verify_conf_ptr(conf_p) == FALSE) {
         return (NULL);
     }
 
-    sdp_p = (sdp_t *)SDP_MALLOC(sizeof(sdp_t));
+    if (arena_p != NULL) {
+        if (arena_p->magic_num != SDP_ARENA_MAGIC_NUM) {
+            return (NULL);
+        }
+        sdp_p = (sdp_t *)sdp_arena_alloc(arena_p, sizeof(sdp_t));
+    } else {
+        sdp_p = (sdp_t *)SDP_MALLOC(sizeof(sdp_t));
+    }
     if (sdp_p == NULL) {
 	return (NULL);
     }
@@ -773,6 +874,7 @@ void *sdp_init_description (void *config_p)
     sdp_p->magic_num = SDP_MAGIC_NUM;
 
     sdp_p->conf_p             = conf_p;
+    sdp_p->arena_p            = arena_p;
     sdp_p->version            = SDP_CURRENT_VERSION;
     sdp_p->owner_name[0]      = '\0';
     sdp_p->owner_sessid[0]    = '\0';
@@ -1242,6 +1344,7 @@ void *sdp_copy (void *sdp_ptr)
     new_sdp_p->magic_num = orig_sdp_p->magic_num;
 
     new_sdp_p->conf_p             = orig_sdp_p->conf_p;
+    new_sdp_p->arena_p            = NULL;
     new_sdp_p->version            = orig_sdp_p->version;
     sstrncpy(new_sdp_p->owner_name, orig_sdp_p->owner_name,
              SDP_MAX_LINE_LEN+1);
@@ -1327,7 +1430,7 @@ void *sdp_copy (void *sdp_ptr)
         cur_level++;
 
         /* Allocate and link in a new media level. */
-        new_mca_p = sdp_alloc_mca();
+        new_mca_p = sdp_alloc_mca(new_sdp_p);
         if (new_mca_p == NULL) {
             sdp_free_description(new_sdp_p);
             return (NULL);
@@ -1443,6 +1546,14 @@ sdp_result_e sdp_free_description (void *sdp_ptr)
         return (SDP_INVALID_SDP_PTR);
     }
 
+    /* Everything hung off a description created on an arena came from
+     * the arena too, and is reclaimed when the arena is reset or freed.
+     */
+    if (sdp_p->arena_p != NULL) {
+        sdp_p->magic_num = 0;
+        return (SDP_SUCCESS);
+    }
+
     /* Free any timespec structures - should be only one since
      * this is all we currently support.
      */
@@ -1465,7 +1576,7 @@ sdp_result_e sdp_free_description (void *sdp_ptr)
     attr_p = sdp_p->sess_attrs_p;
     while (attr_p != NULL) {
 	next_attr_p = attr_p->next_p;
-	sdp_free_attr(attr_p);
+	sdp_free_attr(sdp_p, attr_p);
 	attr_p = next_attr_p;
     }
 
@@ -1478,7 +1589,7 @@ sdp_result_e sdp_free_description (void *sdp_ptr)
 	attr_p = mca_p->media_attrs_p;
 	while (attr_p != NULL) {
 	    next_attr_p = attr_p->next_p;
-	    sdp_free_attr(attr_p);
+	    sdp_free_attr(sdp_p, attr_p);
 	    attr_p = next_attr_p;
 	}
 
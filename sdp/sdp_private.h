@@ -38,6 +38,7 @@
 
 
 #define SDP_MAGIC_NUM           0xabcdabcd
+#define SDP_ARENA_MAGIC_NUM     0xabcdaeae
 
 #define SDP_UNSUPPORTED         "Unsupported"
 #define SDP_MAX_LINE_LEN   80 /* Max len for SDP Line */
@@ -558,6 +559,21 @@ typedef struct sdp_conf_options {
 } sdp_conf_options_t;
 
 
+/* Arena for the memory hung off parsed SDP descriptions.  Blocks are
+ * kept on a list and reused after the arena is reset. */
+typedef struct sdp_arena_block_ {
+    struct sdp_arena_block_  *next_p;
+    u32                       size;   /* bytes of data after the header */
+    u32                       used;
+} sdp_arena_block_t;
+
+typedef struct {
+    u32                       magic_num;
+    u32                       block_size;
+    sdp_arena_block_t        *first_p;
+    sdp_arena_block_t        *cur_p;
+} sdp_arena_t;
+
 /* Session level SDP info with pointers to media line info. */
 /* Elements here that can only be one of are included directly. Elements */
 /* that can be more than one are pointers.                               */
@@ -596,6 +612,9 @@ typedef struct {
     /* MCA - Media, connection, and attributes */
     sdp_mca_t                *mca_p;
     ushort                    mca_count;
+
+    /* Arena the description allocates from, NULL to use the heap. */
+    sdp_arena_t              *arena_p;
 } sdp_t;
 
 
@@ -618,6 +637,24 @@ typedef struct {
 } sdp_attrarray_t;
 
 
+/* Keyword lookup index.  Maps the name of a token table entry (matched
+ * case-insensitively, as a whole token) to its index in the table with
+ * a single hash probe.  The hash seed is chosen when the index is built
+ * so that, where possible, no two names share a slot; lookups still
+ * probe linearly so a collision only costs an extra compare. */
+#define SDP_KEYWORD_MAX_SLOTS   256
+
+typedef struct {
+    const char *table;          /* First entry of the token table. */
+    u16         stride;         /* Size of one table entry.  The name
+                                 * must be the entry's first member. */
+    u16         num_entries;
+    u16         mask;           /* Number of slots - 1. */
+    u32         seed;
+    u8          slot[SDP_KEYWORD_MAX_SLOTS]; /* Entry index + 1, or 0. */
+} sdp_keyword_index_t;
+
+
 /* Data declarations */
 
 extern const sdp_attrarray_t sdp_attr[];
@@ -649,6 +686,31 @@ extern const sdp_namearray_t sdp_rtcp_unicast_mode_val[];
 extern const sdp_namearray_t sdp_rtcp_xr_param[];
 
 extern const  sdp_srtp_crypto_suite_list sdp_srtp_crypto_suite_array[];
+
+extern sdp_keyword_index_t sdp_attr_index;
+extern sdp_keyword_index_t sdp_media_index;
+extern sdp_keyword_index_t sdp_nettype_index;
+extern sdp_keyword_index_t sdp_addrtype_index;
+extern sdp_keyword_index_t sdp_transport_index;
+extern sdp_keyword_index_t sdp_encrypt_index;
+extern sdp_keyword_index_t sdp_payload_index;
+extern sdp_keyword_index_t sdp_t38_rate_index;
+extern sdp_keyword_index_t sdp_t38_udpec_index;
+extern sdp_keyword_index_t sdp_qos_strength_index;
+extern sdp_keyword_index_t sdp_qos_direction_index;
+extern sdp_keyword_index_t sdp_qos_status_type_index;
+extern sdp_keyword_index_t sdp_curr_type_index;
+extern sdp_keyword_index_t sdp_des_type_index;
+extern sdp_keyword_index_t sdp_conf_type_index;
+extern sdp_keyword_index_t sdp_mediadir_role_index;
+extern sdp_keyword_index_t sdp_fmtp_codec_param_index;
+extern sdp_keyword_index_t sdp_fmtp_rtp_retrans_param_index;
+extern sdp_keyword_index_t sdp_silencesupp_pref_index;
+extern sdp_keyword_index_t sdp_silencesupp_siduse_index;
+extern sdp_keyword_index_t sdp_bw_modifier_val_index;
+extern sdp_keyword_index_t sdp_group_attr_val_index;
+extern sdp_keyword_index_t sdp_src_filter_mode_val_index;
+extern sdp_keyword_index_t sdp_rtcp_unicast_mode_val_index;
 /* Function Prototypes */
 
 /* sdp_access.c */
@@ -824,15 +886,21 @@ extern tinybool sdp_parse_context_crypto_suite(char * str,
 extern char* sdp_get_video_pic_str (sdp_video_picture_size type);
 
 
+/* sdp_arena.c */
+extern void *sdp_arena_alloc(sdp_arena_t *arena_p, u32 bytes);
+extern void *sdp_alloc(sdp_t *sdp_p, u32 bytes);
+extern void sdp_release(sdp_t *sdp_p, void *ptr);
+extern char *sdp_strdup(sdp_t *sdp_p, const char *str);
+
 /* sdp_attr_access.c */
-extern void sdp_free_attr(sdp_attr_t *attr_p);
+extern void sdp_free_attr(sdp_t *sdp_p, sdp_attr_t *attr_p);
 extern sdp_result_e sdp_find_attr_list(sdp_t *sdp_p, u16 level, u8 cap_num, 
                                        sdp_attr_t **attr_p, char *fname);
 extern sdp_attr_t *sdp_find_attr(sdp_t *sdp_p, u16 level, u8 cap_num,
                                  sdp_attr_e attr_type, u16 inst_num);
 extern sdp_attr_t *sdp_find_capability(sdp_t *sdp_p, u16 level, u8 cap_num);
 
-extern void sdp_copy_attr_fields (sdp_attr_t *src_attr_p, 
+extern void sdp_copy_attr_fields (sdp_t *dst_sdp_p, sdp_attr_t *src_attr_p,
                                   sdp_attr_t *dst_attr_p);
 
 extern tinybool sdp_validate_qos_attr (sdp_attr_e qos_attr);
@@ -872,6 +940,7 @@ extern const char *sdp_get_group_attr_name(sdp_group_attr_e group_attr);
 extern const char *sdp_get_src_filter_mode_name(sdp_src_filter_mode_e type);
 extern const char *sdp_get_rtcp_unicast_mode_name(sdp_rtcp_unicast_mode_e type);
 
+extern void sdp_init_keyword_indexes(void);
 extern tinybool sdp_verify_sdp_ptr(sdp_t *sdp_p);
 
 extern sdp_result_e sdp_validate_sdp (sdp_t *sdp_p);
@@ -953,7 +1022,7 @@ extern sdp_result_e sdp_parse_mcast_connection_addr (sdp_t *sdp_p, u16 level);
 			     
 
 /* sdp_utils.c */
-extern sdp_mca_t *sdp_alloc_mca(void);
+extern sdp_mca_t *sdp_alloc_mca(sdp_t *sdp_p);
 extern tinybool sdp_validate_floating_point_string(const char *string_parm);
 extern char *sdp_findchar(const char *ptr, char *char_list);
 extern char *sdp_getnextstrtok(const char *str, char *tokenstr, 
@@ -975,6 +1044,11 @@ extern
 tinybool verify_sdescriptions_lifetime(char *buf);
 
 extern tinybool sdp_check_for_non_numeric(const char *str);
+extern void sdp_keyword_index_init(sdp_keyword_index_t *index,
+                                   const void *table, u16 stride,
+                                   u16 num_entries);
+extern int sdp_keyword_find(const sdp_keyword_index_t *index,
+                            const char *str);
 			     
 /* sdp_services_xxx.c */
 extern void sdp_log_errmsg(sdp_errmsg_e err_msg, char *str);
@@ -156,12 +156,10 @@ sdp_result_e sdp_parse_owner (sdp_t *sdp_p, u16 level, const char *ptr)
         return (SDP_INVALID_PARAMETER);
     }
     sdp_p->owner_network_type = SDP_NT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name,
-                        sdp_nettype[i].strlen) == 0) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                sdp_p->owner_network_type = (sdp_nettype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            sdp_p->owner_network_type = (sdp_nettype_e)i;
         }
     }
     if (sdp_p->owner_network_type == SDP_NT_UNSUPPORTED) {
@@ -184,12 +182,10 @@ sdp_result_e sdp_parse_owner (sdp_t *sdp_p, u16 level, const char *ptr)
         return (SDP_INVALID_PARAMETER);
     }
     sdp_p->owner_addr_type = SDP_AT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                sdp_p->owner_addr_type = (sdp_addrtype_e)i;
-            }
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            sdp_p->owner_addr_type = (sdp_addrtype_e)i;
         }
     }
     if ((sdp_p->owner_addr_type == SDP_AT_UNSUPPORTED) &&
@@ -621,13 +617,10 @@ sdp_result_e sdp_parse_connection (sdp_t *sdp_p, u16 level, const char *ptr)
         return (SDP_INVALID_PARAMETER);
     }
     conn_p->nettype = SDP_NT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_NETWORK_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_nettype[i].name, 
-                        sdp_nettype[i].strlen) == 0) {
-            if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
-                conn_p->nettype = (sdp_nettype_e)i;
-                break;
-            }
+    i = sdp_keyword_find(&sdp_nettype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->nettype_supported[i] == TRUE) {
+            conn_p->nettype = (sdp_nettype_e)i;
         }
     }
     if (conn_p->nettype == SDP_NT_UNSUPPORTED) {
@@ -657,13 +650,10 @@ sdp_result_e sdp_parse_connection (sdp_t *sdp_p, u16 level, const char *ptr)
         }
     }
     conn_p->addrtype = SDP_AT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_ADDR_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_addrtype[i].name,
-                        sdp_addrtype[i].strlen) == 0) {
-            if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
-                conn_p->addrtype = (sdp_addrtype_e)i;
-                break;
-            }
+    i = sdp_keyword_find(&sdp_addrtype_index, tmp);
+    if (i >= 0) {
+        if (sdp_p->conf_p->addrtype_supported[i] == TRUE) {
+            conn_p->addrtype = (sdp_addrtype_e)i;
         }
     }
     if (conn_p->addrtype == SDP_AT_UNSUPPORTED) {
@@ -852,12 +842,9 @@ sdp_result_e sdp_parse_bandwidth (sdp_t *sdp_p, u16 level, const char *ptr)
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
-    for (i=0; i < SDP_MAX_BW_MODIFIER_VAL; i++) {
-        if (strncasecmp(tmp, sdp_bw_modifier_val[i].name,
-                        sdp_bw_modifier_val[i].strlen) == 0) {
-            bw_modifier  = (sdp_bw_modifier_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_bw_modifier_val_index, tmp);
+    if (i >= 0) {
+        bw_modifier  = (sdp_bw_modifier_e)i;
     }
 
     if (bw_modifier == SDP_BW_MODIFIER_UNSUPPORTED) {
@@ -888,7 +875,7 @@ sdp_result_e sdp_parse_bandwidth (sdp_t *sdp_p, u16 level, const char *ptr)
      * Allocate a new sdp_bw_data_t instance and set it's values from the
      * input parameters.
      */
-    new_bw_data_p = (sdp_bw_data_t*)SDP_MALLOC(sizeof(sdp_bw_data_t));
+    new_bw_data_p = (sdp_bw_data_t*)sdp_alloc(sdp_p, sizeof(sdp_bw_data_t));
     if (new_bw_data_p == NULL) {
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_NO_RESOURCE);
@@ -972,7 +959,7 @@ sdp_result_e sdp_parse_timespec (sdp_t *sdp_p, u16 level, const char *ptr)
     sdp_timespec_t  *timespec_p;
     sdp_timespec_t  *next_timespec_p;
 
-    timespec_p = (sdp_timespec_t *)SDP_MALLOC(sizeof(sdp_timespec_t));
+    timespec_p = (sdp_timespec_t *)sdp_alloc(sdp_p, sizeof(sdp_timespec_t));
     if (timespec_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -990,7 +977,7 @@ sdp_result_e sdp_parse_timespec (sdp_t *sdp_p, u16 level, const char *ptr)
                           sdp_p->debug_str);
             }
             sdp_p->conf_p->num_invalid_param++;
-            SDP_FREE(timespec_p);
+            sdp_release(sdp_p, timespec_p);
             return (SDP_INVALID_PARAMETER);
         }
     }
@@ -1000,7 +987,7 @@ sdp_result_e sdp_parse_timespec (sdp_t *sdp_p, u16 level, const char *ptr)
                       sdp_p->debug_str);
         }
         sdp_p->conf_p->num_invalid_param++;
-        SDP_FREE(timespec_p);
+        sdp_release(sdp_p, timespec_p);
         return (result);
     }
 
@@ -1015,7 +1002,7 @@ sdp_result_e sdp_parse_timespec (sdp_t *sdp_p, u16 level, const char *ptr)
                           sdp_p->debug_str);
             }
             sdp_p->conf_p->num_invalid_param++;
-            SDP_FREE(timespec_p);
+            sdp_release(sdp_p, timespec_p);
             return (SDP_INVALID_PARAMETER);
         }
     }
@@ -1025,7 +1012,7 @@ sdp_result_e sdp_parse_timespec (sdp_t *sdp_p, u16 level, const char *ptr)
                       sdp_p->debug_str);
         }
         sdp_p->conf_p->num_invalid_param++;
-        SDP_FREE(timespec_p);
+        sdp_release(sdp_p, timespec_p);
         return (result);
     }
 
@@ -1167,12 +1154,9 @@ sdp_result_e sdp_parse_encryption (sdp_t *sdp_p, u16 level, const char *ptr)
         return (SDP_INVALID_PARAMETER);
     }
     encrypt_p->encrypt_type = SDP_ENCRYPT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_ENCRYPT_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_encrypt[i].name,
-                        sdp_encrypt[i].strlen) == 0) {
-            encrypt_p->encrypt_type = (sdp_encrypt_type_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_encrypt_index, tmp);
+    if (i >= 0) {
+        encrypt_p->encrypt_type = (sdp_encrypt_type_e)i;
     }
     if (encrypt_p->encrypt_type == SDP_ENCRYPT_UNSUPPORTED) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -1255,7 +1239,7 @@ sdp_result_e sdp_build_encryption (sdp_t *sdp_p, u16 level, char **ptr,
 sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
 {
     GCC_UNUSED(level);
-    u16                   i;
+    int                   i;
     u16                   num_port_params=0;
     int32                 num[SDP_MAX_PORT_PARAMS];  
     tinybool              valid_param = FALSE;
@@ -1267,7 +1251,7 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
     char                 *port_ptr;
 
     /* Allocate resource for new media stream. */
-    mca_p = sdp_alloc_mca();
+    mca_p = sdp_alloc_mca(sdp_p);
     if (mca_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
         return (SDP_NO_RESOURCE);
@@ -1280,16 +1264,14 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
             SDP_ERROR("%s No media type specified, parse failed.", 
                       sdp_p->debug_str);
         }
-        SDP_FREE(mca_p);
+        sdp_release(sdp_p, mca_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
     mca_p->media = SDP_MEDIA_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_MEDIA_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_media[i].name,
-                        sdp_media[i].strlen) == 0) {
-            mca_p->media = (sdp_media_e)i;
-        }
+    i = sdp_keyword_find(&sdp_media_index, tmp);
+    if (i >= 0) {
+        mca_p->media = (sdp_media_e)i;
     }
     if (mca_p->media == SDP_MEDIA_UNSUPPORTED) {
         if (sdp_p->debug_flag[SDP_DEBUG_WARNINGS]) {
@@ -1308,7 +1290,7 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
             SDP_ERROR("%s No port specified in m= media line, "
                       "parse failed.", sdp_p->debug_str);
         }
-        SDP_FREE(mca_p);
+        sdp_release(sdp_p, mca_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
@@ -1333,17 +1315,14 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
             SDP_ERROR("%s No transport protocol type specified, "
                       "parse failed.", sdp_p->debug_str);
         }
-        SDP_FREE(mca_p);
+        sdp_release(sdp_p, mca_p);
         sdp_p->conf_p->num_invalid_param++;
         return (SDP_INVALID_PARAMETER);
     }
     mca_p->transport = SDP_TRANSPORT_UNSUPPORTED;
-    for (i=0; i < SDP_MAX_TRANSPORT_TYPES; i++) {
-        if (strncasecmp(tmp, sdp_transport[i].name,
-                        sdp_transport[i].strlen) == 0) {
-            mca_p->transport = (sdp_transport_e)i;
-            break;
-        }
+    i = sdp_keyword_find(&sdp_transport_index, tmp);
+    if (i >= 0) {
+        mca_p->transport = (sdp_transport_e)i;
     }
     if (mca_p->transport == SDP_TRANSPORT_UNSUPPORTED) {
         /* If we don't recognize or don't support the transport type,
@@ -1501,7 +1480,7 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
                       port, sdp_get_transport_name(mca_p->transport));
         }
         sdp_p->conf_p->num_invalid_param++;
-	SDP_FREE(mca_p);
+	sdp_release(sdp_p, mca_p);
         return (SDP_INVALID_PARAMETER);
     }
 
@@ -1514,7 +1493,7 @@ sdp_result_e sdp_parse_media (sdp_t *sdp_p, u16 level, const char *ptr)
         if (sdp_parse_multiple_profile_payload_types(sdp_p, mca_p, ptr) != 
             SDP_SUCCESS) {
             sdp_p->conf_p->num_invalid_param++;
-	    SDP_FREE(mca_p);
+	    sdp_release(sdp_p, mca_p);
             return (SDP_INVALID_PARAMETER);
         }
     } else {
@@ -1721,7 +1700,7 @@ sdp_result_e sdp_build_media (sdp_t *sdp_p, u16 level, char **ptr, u16 len)
  */
 void sdp_parse_payload_types (sdp_t *sdp_p, sdp_mca_t *mca_p, const char *ptr)
 {
-    u16           i;
+    int           i;
     u16           num_payloads;
     sdp_result_e  result;
     tinybool      valid_payload;
@@ -1756,12 +1735,9 @@ void sdp_parse_payload_types (sdp_t *sdp_p, sdp_mca_t *mca_p, const char *ptr)
         }
 
         valid_payload = FALSE;
-        for (i=0; i < SDP_MAX_STRING_PAYLOAD_TYPES; i++) {
-            if (strncasecmp(tmp, sdp_payload[i].name,
-                            sdp_payload[i].strlen) == 0) {
-                valid_payload = TRUE;
-                break;
-            }
+        i = sdp_keyword_find(&sdp_payload_index, tmp);
+        if (i >= 0) {
+            valid_payload = TRUE;
         }
         if (valid_payload == TRUE) {
             /* We recognized the payload type.  Make sure it
@@ -1827,6 +1803,7 @@ sdp_result_e sdp_parse_multiple_profile_payload_types (sdp_t *sdp_p,
                                                  const char *ptr)
 {
     u16                   i;
+    int                   transport;
     u16                   prof;
     u16                   payload;
     sdp_result_e          result;
@@ -1838,10 +1815,10 @@ sdp_result_e sdp_parse_multiple_profile_payload_types (sdp_t *sdp_p,
      * need to look for multiple AAL2 profiles and their associated
      * payload lists. */
     mca_p->media_profiles_p = (sdp_media_profiles_t *) \
-        SDP_MALLOC(sizeof(sdp_media_profiles_t));
+        sdp_alloc(sdp_p, sizeof(sdp_media_profiles_t));
     if (mca_p->media_profiles_p == NULL) {
         sdp_p->conf_p->num_no_resource++;
-        SDP_FREE(mca_p);
+        sdp_release(sdp_p, mca_p);
         return (SDP_NO_RESOURCE);
     }
     profile_p = mca_p->media_profiles_p;
@@ -1862,13 +1839,10 @@ sdp_result_e sdp_parse_multiple_profile_payload_types (sdp_t *sdp_p,
 
         /* See if the next token is a new profile type. */
         profile_p->profile[prof+1] = SDP_TRANSPORT_UNSUPPORTED;
-        for (i=SDP_TRANSPORT_AAL2_ITU;
-             i <= SDP_TRANSPORT_AAL2_CUSTOM; i++) {
-            if (strncasecmp(tmp, sdp_transport[i].name,
-                            sdp_transport[i].strlen) == 0) {
-                profile_p->profile[prof+1] = (sdp_transport_e)i;
-                break;
-            }
+        transport = sdp_keyword_find(&sdp_transport_index, tmp);
+        if ((transport >= SDP_TRANSPORT_AAL2_ITU) &&
+            (transport <= SDP_TRANSPORT_AAL2_CUSTOM)) {
+            profile_p->profile[prof+1] = (sdp_transport_e)transport;
         }
         /* If we recognized the profile type, start looking for the
          * next payload list. */
@@ -20,11 +20,11 @@
 
 
 
-sdp_mca_t *sdp_alloc_mca () {
+sdp_mca_t *sdp_alloc_mca (sdp_t *sdp_p) {
     sdp_mca_t           *mca_p;
 
     /* Allocate resource for new media stream. */
-    mca_p = (sdp_mca_t *)SDP_MALLOC(sizeof(sdp_mca_t));
+    mca_p = (sdp_mca_t *)sdp_alloc(sdp_p, sizeof(sdp_mca_t));
     if (mca_p == NULL) {
         return (NULL);
     }
@@ -910,6 +910,153 @@ tinybool sdp_check_for_non_numeric (const char *ptr)
 }
 
 
+/*
+ * Keyword lookup.
+ *
+ * The token tables in sdp_main.c are searched on every line parsed;
+ * scanning them with strncasecmp costs one compare per table entry.
+ * Each table is instead given a small open-addressed hash index.  The
+ * hash folds case, and the seed is picked at build time so the names
+ * in the table land in distinct slots, making a lookup one hash and
+ * one compare.
+ */
+
+/* Number of seeds tried when building an index. */
+#define SDP_KEYWORD_SEED_TRIES  4096
+
+static u32 sdp_keyword_hash (const char *str, u32 seed)
+{
+    u32 hash = 2166136261U + seed * 0x9e3779b9U;
+
+    while (*str != '\0') {
+        hash ^= (u8)tolower((u8)*str);
+        hash *= 16777619U;
+        str++;
+    }
+    /* Mix the high bits down, since only the low bits select a slot. */
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+
+    return (hash);
+}
+
+static const char *sdp_keyword_name (const sdp_keyword_index_t *index,
+                                     u16 entry)
+{
+    return (*(char * const *)(index->table + entry * index->stride));
+}
+
+/*
+ * Place every name of the table using the given seed.  Returns the
+ * number of names that could not be placed in their home slot.
+ */
+static u16 sdp_keyword_index_fill (sdp_keyword_index_t *index, u32 seed)
+{
+    const char *name;
+    u16 i, slot, collisions = 0;
+
+    memset(index->slot, 0, sizeof(index->slot));
+    index->seed = seed;
+    for (i = 0; i < index->num_entries; i++) {
+        name = sdp_keyword_name(index, i);
+        if (name == NULL) {
+            continue;
+        }
+        slot = sdp_keyword_hash(name, seed) & index->mask;
+        if (index->slot[slot] != 0) {
+            collisions++;
+            while (index->slot[slot] != 0) {
+                slot = (slot + 1) & index->mask;
+            }
+        }
+        index->slot[slot] = (u8)(i + 1);
+    }
+
+    return (collisions);
+}
+
+/* Function:    sdp_keyword_index_init
+ * Description: Build the lookup index of a token table.  The table must
+ *              have fewer than SDP_KEYWORD_MAX_SLOTS / 2 entries, and
+ *              each entry must start with its name; NULL names are
+ *              skipped.  When a name appears more than once, lookups
+ *              return its first entry.
+ * Parameters:  index        The index to build.
+ *              table        The first entry of the token table.
+ *              stride       The size of one table entry.
+ *              num_entries  The number of entries in the table.
+ * Returns:     Nothing.
+ */
+void sdp_keyword_index_init (sdp_keyword_index_t *index, const void *table,
+                             u16 stride, u16 num_entries)
+{
+    u32 seed, best_seed = 0;
+    u16 slots, collisions, best = 0xFFFF;
+
+    index->table = (const char *)table;
+    index->stride = stride;
+
+    /* The slots must stay less than half full, and each holds its entry
+     * number in a byte.  Leave a larger table unindexed, so that every
+     * lookup fails rather than returning the wrong entry. */
+    if (num_entries >= SDP_KEYWORD_MAX_SLOTS / 2) {
+        SDP_ERROR("SDP ERROR: keyword table of %u entries is too large "
+                  "to index.", num_entries);
+        index->num_entries = 0;
+        index->mask = 0;
+        index->seed = 0;
+        memset(index->slot, 0, sizeof(index->slot));
+        return;
+    }
+    index->num_entries = num_entries;
+
+    /* Keep the load at or below one quarter where the slots allow it,
+     * which makes a collision-free seed quick to find. */
+    for (slots = 8;
+         (slots < SDP_KEYWORD_MAX_SLOTS) && (slots < num_entries * 4);
+         slots <<= 1) {
+        ;
+    }
+    index->mask = slots - 1;
+
+    for (seed = 0; seed < SDP_KEYWORD_SEED_TRIES; seed++) {
+        collisions = sdp_keyword_index_fill(index, seed);
+        if (collisions < best) {
+            best = collisions;
+            best_seed = seed;
+            if (collisions == 0) {
+                return;
+            }
+        }
+    }
+    (void)sdp_keyword_index_fill(index, best_seed);
+}
+
+/* Function:    sdp_keyword_find
+ * Description: Look up a token in a keyword index.  The token matches
+ *              an entry when it equals the entry's name, ignoring case.
+ * Parameters:  index  An index built by sdp_keyword_index_init.
+ *              str    The token, NUL-terminated.
+ * Returns:     The table index of the matching entry, or -1 if none.
+ */
+int sdp_keyword_find (const sdp_keyword_index_t *index, const char *str)
+{
+    u16 slot, entry;
+
+    slot = sdp_keyword_hash(str, index->seed) & index->mask;
+    while (index->slot[slot] != 0) {
+        entry = index->slot[slot] - 1;
+        if (strcasecmp(str, sdp_keyword_name(index, entry)) == 0) {
+            return (entry);
+        }
+        slot = (slot + 1) & index->mask;
+    }
+
+    return (-1);
+}
+
+
 #undef CHAR_IS_WHITESPACE
 #undef SKIP_WHITESPACE
 #undef FIND_WHITESPACE
@@ -500,11 +500,16 @@ typedef void (*vqec_nat_proto_evt_handler)(
     const struct vqec_event_ *const ptr, int32_t fd, int16_t ev, void *arg);
 
 /**
- * Use the nat api to create a timer.
+ * Use the nat api to create a timer.  The timer is profiled under the
+ * given name; vqec_nat_timer_create() names it after its handler.
  */   
 struct vqec_event_ *
-vqec_nat_timer_create(boolean periodic, 
-                      vqec_nat_proto_evt_handler handler, void *arg);
+vqec_nat_timer_create_named(boolean periodic, 
+                            vqec_nat_proto_evt_handler handler, void *arg,
+                            const char *name);
+
+#define vqec_nat_timer_create(periodic, handler, arg)                   \
+    vqec_nat_timer_create_named((periodic), (handler), (arg), #handler)
 
 /**
  * Use the nat api to destroy a timer.
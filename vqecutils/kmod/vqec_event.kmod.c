@@ -19,6 +19,7 @@
 #include <linux/err.h>
 #include <linux/sched.h>
 #include "vqec_event.h"
+#include "vqec_event_profile.h"
 #include "add-ons/include/tree.h"
 #include "vqec_lock.h"
 #include "utils/queue_plus.h"
@@ -70,6 +71,7 @@ struct vqec_event_
     struct timeval timeout;     /* timeout [relative] for the event */
     abs_time_t exp_time;        /* event's absolute expiration time. */
     uint32_t state;          /* if the event is inactive or active */
+    vqec_event_profile_t *prof; /* profile of events of the same name */
     VQE_TAILQ_ENTRY(vqec_event_) event_queue_entry;
                                 /* Event queue entry */
     VQE_RB_ENTRY(vqec_event_) tree_entry;
@@ -84,6 +86,9 @@ static char s_event_jitter_hist_mem[
                     sizeof(vam_hist_type_t) + 
                     sizeof(vam_hist_bucket_t) * 
                     VQEC_EVENT_JITTER_HISTOGRAM_BUCKETS];
+/* Execution profiles of the events, by name; updated under the dp lock. */
+static vqec_event_profile_t s_event_profile[VQEC_EVENT_PROFILE_MAX];
+static uint32_t s_event_profile_num;
 static int32_t s_event_task_tid;
 static struct task_struct *s_vqec_event_task = NULL;
 static boolean s_task_run, s_task_stop; 
@@ -241,17 +246,19 @@ vqec_event_base_remove (vqec_event_base_t *baseptr, vqec_event_t *evptr)
  * constant file-descriptor used for timers.
  * @param[in] dataptr Object pointer used as an input argument when
  * the callback is invoked.
+ * @param[in] name Name under which the event is profiled.
  * @param[out] boolean Returns true if the event creation succeeds,
  * false if it fails. 
  *---------------------------------------------------------------------------*/
 boolean 
-vqec_event_create (vqec_event_t **evptrptr,
-                   vqec_event_evtypes_t type,
-                   int32_t events,
-                   void (*evh)(const vqec_event_t * const, int32_t,
-                               int16_t, void *),
-                   int32_t fd,
-                   void *dataptr)
+vqec_event_create_named (vqec_event_t **evptrptr,
+                         vqec_event_evtypes_t type,
+                         int32_t events,
+                         void (*evh)(const vqec_event_t * const, int32_t,
+                                     int16_t, void *),
+                         int32_t fd,
+                         void *dataptr,
+                         const char *name)
 {
     int32_t persist = events & (VQEC_EV_ONESHOT | VQEC_EV_RECURRING);
 
@@ -283,6 +290,9 @@ vqec_event_create (vqec_event_t **evptrptr,
         events & VQEC_EV_RECURRING ? TRUE : FALSE;
     (*evptrptr)->dptr = dataptr; 
     (*evptrptr)->userfunc = evh;
+    (*evptrptr)->prof = vqec_event_profile_lookup(s_event_profile,
+                                                  &s_event_profile_num,
+                                                  name);
     vqec_event_base_insert(s_event_base_ptr, *evptrptr);
     
     return (TRUE);
@@ -425,7 +435,8 @@ vqec_event_tree_adjust_timeouts (vqec_event_base_t *baseptr,
  * Process active events on the timer tree. All events which have expired
  * are removed from the tree. If the events are recurring, they are added
  * back onto the timer tree. The callback function is invoked for all
- * expired events.
+ * expired events, and each run is accounted to the event's profile; the
+ * profile is saved before the callback, which may destroy the event.
  *
  * @param[in] baseptr Pointer to the event base. 
  * @param[out] rel_time_t The relative time after which the next event
@@ -435,6 +446,9 @@ static rel_time_t
 vqec_event_tree_process (vqec_event_base_t *baseptr)
 {
     vqec_event_t *evptr, *next;
+    vqec_event_profile_t *prof;
+    abs_time_t start;
+    rel_time_t late;
     static abs_time_t prev_wakeup = ABS_TIME_0;
     static boolean prev_wakeup_valid = FALSE;
     abs_time_t now;
@@ -467,6 +481,9 @@ vqec_event_tree_process (vqec_event_base_t *baseptr)
                                TIME_GET_R(msec, 
                                           TIME_SUB_A_A(now, evptr->exp_time)));
         }
+        start = get_sys_time();
+        late = TIME_SUB_A_A(start, evptr->exp_time);
+        prof = evptr->prof;
         if (evptr->persist && (evptr->state == VQEC_EVENT_STATE_INACTIVE)) {
             vqec_event_start_internal(baseptr, evptr, &evptr->timeout);
         }
@@ -474,6 +491,11 @@ vqec_event_tree_process (vqec_event_base_t *baseptr)
             (*evptr->userfunc)(evptr, VQEC_EVDESC_TIMER, 
                                VQEC_EV_TYPE_TIMEOUT, evptr->dptr); 
         }
+        if (prof) {
+            vqec_event_profile_record(prof, 
+                                      TIME_SUB_A_A(get_sys_time(), start),
+                                      TRUE, late);
+        }
     }
     
     return (next_wakeup);
@@ -895,6 +917,22 @@ static inline void benchmark_init (void)
     benchmark_calibrate();
 }
 
+/**---------------------------------------------------------------------------
+ * Event profiles.  In the kernel, only the dataplane runs in this event
+ * loop, so the profiles are returned by the dp_ variant; the caller holds
+ * the dp lock, as all dataplane API calls do.
+ *---------------------------------------------------------------------------*/
+uint32_t vqec_event_get_profile (vqec_event_profile_t *prof, uint32_t max)
+{
+    return 0;
+}
+
+uint32_t vqec_dp_event_get_profile (vqec_event_profile_t *prof, uint32_t max)
+{
+    return vqec_event_profile_copy(s_event_profile, s_event_profile_num,
+                                   prof, max);
+}
+
 uint32_t vqec_dp_event_get_benchmark (uint32_t interval) 
 {
     uint32_t start_index, i, num_samples, total;
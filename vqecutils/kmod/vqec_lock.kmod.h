@@ -43,4 +43,53 @@ typedef struct semaphore vqec_lock_t;
 
 extern vqec_lock_t g_vqec_dp_lock;
 
+/**---------------------------------------------------------------------------
+ * Double-buffered publication:  see the user-space definition.
+ *---------------------------------------------------------------------------*/
+typedef struct vqec_dbuf_
+{
+    volatile uint32_t version;
+    volatile uint32_t read;
+} vqec_dbuf_t;
+
+static inline uint32_t 
+vqec_dbuf_write_idx (const vqec_dbuf_t *db)
+{
+    return ((db->version + 1) & 1);
+}
+
+static inline void 
+vqec_dbuf_publish (vqec_dbuf_t *db)
+{
+    db->read = 0;
+    smp_wmb();
+    db->version++;
+    smp_wmb();
+}
+
+static inline uint32_t 
+vqec_dbuf_read_begin (vqec_dbuf_t *db)
+{
+    uint32_t version = db->version;
+
+    if (!db->read) {
+        db->read = 1;
+    }
+    smp_rmb();
+    return (version);
+}
+
+static inline int32_t 
+vqec_dbuf_read_retry (const vqec_dbuf_t *db, uint32_t version)
+{
+    smp_rmb();
+    return (db->version != version);
+}
+
+static inline int32_t 
+vqec_dbuf_is_read (const vqec_dbuf_t *db)
+{
+    return (db->read != 0);
+}
+
 #endif // __VQEC_LOCK_API_H__
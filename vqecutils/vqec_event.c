@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "vqec_event.h"
+#include "vqec_event_profile.h"
 #include "vqec_debug.h"
 #include <sys/event.h>
 #include "vqec_syslog_def.h"
@@ -60,6 +61,10 @@ struct vqec_event_
                                 //!<  Callback function
     struct      timeval tv;
                                 //!<  Associated timeout (timers)
+    abs_time_t  sched_time;
+                                //!<  Scheduled expiration time (timers)
+    vqec_event_profile_t *prof;
+                                //!<  Profile of events of the same name
     struct      event ev; 
                                 //!<  Libevent event object
 };
@@ -71,6 +76,13 @@ enum ev_errtype_t_
     VQEC_EVENT_ERR_MALLOC,
 } ev_errtype_t;
 
+//
+// Execution profiles of the events, by name.  They are only updated and 
+// read with the global lock held.
+//
+static vqec_event_profile_t s_vqec_event_profile[VQEC_EVENT_PROFILE_MAX];
+static uint32_t s_vqec_event_profile_num;
+
 static const char s_libevt_start_err[]   = "- Starting event via libevt failed -";
 static const char s_libevt_add_err[]     = "- Adding event via libevt failed -";
 static const char s_libevt_del_err[]     = "- Deleting event via libevt failed -";
@@ -159,14 +171,26 @@ int32_t vqec_event_2usr (int16_t ev)
 //----------------------------------------------------------------------------
 // Global handler which wraps all registered callbacks, and also provides
 // persistence for timers. It acquires and releases a lock around the 
-// the entire function, including the user-callback.
+// the entire function, including the user-callback. The run is accounted
+// to the event's profile; the profile is saved before the callback, which
+// may destroy the event.
 //----------------------------------------------------------------------------
 UT_STATIC
 void vqec_g_ev_handler (int32_t fd, int16_t events, void *dptr)
 {
     vqec_event_t *evptr = (vqec_event_t *)dptr;
+    vqec_event_profile_t *prof;
+    abs_time_t start;
+    rel_time_t late = REL_TIME_0;
+    boolean is_timer;
 
     if (evptr && evptr->refcnt) {
+        start = get_sys_time();
+        prof = evptr->prof;
+        is_timer = (evptr->type == VQEC_EVTYPE_TIMER);
+        if (is_timer) {
+            late = TIME_SUB_A_A(start, evptr->sched_time);
+        }
         if (evptr->type == VQEC_EVTYPE_TIMER && 
             evptr->persist == VQEC_EV_RECURRING) {
             if (!vqec_event_start(evptr, &evptr->tv)) {
@@ -179,6 +203,11 @@ void vqec_g_ev_handler (int32_t fd, int16_t events, void *dptr)
             (*(evptr->userfunc))(evptr, fd, 
                                  vqec_event_2usr(events), evptr->dptr);
         }
+        if (prof) {
+            vqec_event_profile_record(prof, 
+                                      TIME_SUB_A_A(get_sys_time(), start),
+                                      is_timer, late);
+        }
     } else {	
         if (!evptr) {
             vqec_event_log_err(VQEC_EVENT_ERR_GENERAL, "%s %s (null evptr)", 
@@ -268,16 +297,17 @@ boolean vqec_event_loopexit (struct timeval *tv)
 //----------------------------------------------------------------------------
 // Create a new event object; a pointer to the created object is returned
 // in *evptrptr.  The event is *not* registered will libevent yet, and has
-// a reference count of 1.
+// a reference count of 1. The event is profiled under the given name.
 //----------------------------------------------------------------------------
 boolean 
-vqec_event_create (vqec_event_t **evptrptr,
-                   vqec_event_evtypes_t type,
-                   int32_t events,
-                   void (*evh)(const vqec_event_t * const, int32_t, 
-                               int16_t, void *),
-                   int32_t fd,
-                   void *dataptr)
+vqec_event_create_named (vqec_event_t **evptrptr,
+                         vqec_event_evtypes_t type,
+                         int32_t events,
+                         void (*evh)(const vqec_event_t * const, int32_t, 
+                                     int16_t, void *),
+                         int32_t fd,
+                         void *dataptr,
+                         const char *name)
 {
     boolean rv = TRUE;
     int16_t flags;
@@ -330,6 +360,10 @@ vqec_event_create (vqec_event_t **evptrptr,
                 (*evptrptr)->fd = fd;
                 (*evptrptr)->dptr = dataptr; 
                 (*evptrptr)->userfunc = evh;   
+                (*evptrptr)->prof = 
+                    vqec_event_profile_lookup(s_vqec_event_profile,
+                                              &s_vqec_event_profile_num,
+                                              name);
                 (*evptrptr)->refcnt++;
                 if (type == VQEC_EVTYPE_FD) {
                     flags = vqec_event_2libevt((*evptrptr)->events_rw);
@@ -395,6 +429,8 @@ vqec_event_start (const vqec_event_t *const evptr,
         } else {
             if (tv) {
                 ((vqec_event_t *)evptr)->tv = *tv;
+                ((vqec_event_t *)evptr)->sched_time = 
+                    TIME_ADD_A_R(get_sys_time(), timeval_to_rel_time(tv));
             } else {
                 memset(&((vqec_event_t *)evptr)->tv, 0, 
                        sizeof(struct timeval));
@@ -531,3 +567,18 @@ uint32_t vqec_dp_event_get_benchmark (uint32_t interval)
     return 0;
 }
 
+/**--------------------------------------------------------------------------
+ * Event profile API 
+ *-------------------------------------------------------------------------*/
+uint32_t vqec_event_get_profile (vqec_event_profile_t *prof, uint32_t max)
+{
+    return vqec_event_profile_copy(s_vqec_event_profile,
+                                   s_vqec_event_profile_num,
+                                   prof, max);
+}
+
+uint32_t vqec_dp_event_get_profile (vqec_event_profile_t *prof, uint32_t max)
+{
+    return 0;
+}
+
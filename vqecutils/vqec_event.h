@@ -61,6 +61,38 @@ enum vqec_event_evtypes_
     VQEC_EVTYPE_FD,             //!< - Object for File-descriptors
 } vqec_event_evtypes_t;
 
+//----------------------------------------------------------------------------
+/// Execution profile of the events sharing a name.  Every event is named
+/// after its handler when it is created, and the profile aggregates all
+/// events of that name:  the number of handler runs, the total and maximum
+/// handler execution time, and for timers, how late the handler ran with
+/// respect to the scheduled expiration time. 
+//----------------------------------------------------------------------------
+#define VQEC_EVENT_PROFILE_NAME_LEN 48
+                                //!< - Maximum event name length, with NUL
+#define VQEC_EVENT_PROFILE_MAX  32
+                                //!< - Maximum number of distinct names;
+                                //!< - further names share the last entry
+
+typedef
+struct vqec_event_profile_
+{
+    char        name[VQEC_EVENT_PROFILE_NAME_LEN];
+                                //!< Event (handler) name
+    uint64_t    runs;
+                                //!< Number of handler runs
+    uint64_t    total_usecs;
+                                //!< Total handler execution time
+    uint64_t    timer_runs;
+                                //!< Runs for which lateness was measured
+    uint64_t    total_late_usecs;
+                                //!< Total lateness of timer runs
+    uint32_t    max_usecs;
+                                //!< Maximum handler execution time
+    uint32_t    max_late_usecs;
+                                //!< Maximum lateness of a timer run
+} vqec_event_profile_t;
+
 //----------------------------------------------------------------------------
 /// Initializes the event library. 
 /// @param[out]  boolean Returns FALSE if the library initialization
@@ -137,15 +169,24 @@ boolean vqec_event_loopexit(struct timeval *tv);
 /// @param[in]  dataptr Some opaque object pointer, which will be returned
 /// to the user as a parameter, when the associated handler is invoked
 /// upon detection of a requested event. 
+/// @param[in]  name    Name under which the event is profiled.  It is
+/// copied when the event is created, truncated to 
+/// VQEC_EVENT_PROFILE_NAME_LEN - 1 characters. vqec_event_create() names
+/// the event after its handler.
 /// @param[out] boolean Returns TRUE on success, FALSE on failure.
 //----------------------------------------------------------------------------
-boolean vqec_event_create(vqec_event_t **evptrptr,
-                          vqec_event_evtypes_t type,
-                          int32_t events,
-                          void (*evh)(const vqec_event_t * const, int32_t, 
-                                      int16_t, void *),
-                          int32_t fd,
-                          void *dataptr);
+boolean vqec_event_create_named(vqec_event_t **evptrptr,
+                                vqec_event_evtypes_t type,
+                                int32_t events,
+                                void (*evh)(const vqec_event_t * const, 
+                                            int32_t, int16_t, void *),
+                                int32_t fd,
+                                void *dataptr,
+                                const char *name);
+
+#define vqec_event_create(evptrptr, type, events, evh, fd, dataptr)     \
+    vqec_event_create_named((evptrptr), (type), (events), (evh), (fd),  \
+                            (dataptr), #evh)
 
 //----------------------------------------------------------------------------
 /// Activate the timer or descriptor-based event-object. For timers
@@ -256,6 +297,19 @@ uint32_t vqec_event_get_benchmark(uint32_t interval);
 void vqec_event_enable_benchmark(boolean enabled);
 uint32_t vqec_dp_event_get_benchmark(uint32_t interval);
 
+/*----------------------------------------------------------------------------
+ * Copy the execution profiles of the event loop, one entry per event name,
+ * in the order in which the names were first seen.  The dp_ variant returns
+ * the profiles of the kernel dataplane event loop; in user-mode builds the
+ * dataplane shares the event loop, and the dp_ variant returns nothing.
+ *
+ * @param[out] prof Array into which the profiles are copied.
+ * @param[in] max Number of entries in the array.
+ * @param[out] uint32_t Returns the number of entries copied.
+ *----------------------------------------------------------------------------*/
+uint32_t vqec_event_get_profile(vqec_event_profile_t *prof, uint32_t max);
+uint32_t vqec_dp_event_get_profile(vqec_event_profile_t *prof, uint32_t max);
+
 /// @}
 
 #ifdef __cplusplus
@@ -0,0 +1,129 @@
+/*------------------------------------------------------------------
+ * VQEC event profiling.
+ *
+ * Bookkeeping for the per-name event execution profiles, shared by the
+ * user-mode and kernel-mode event libraries.  Both libraries keep a
+ * table of profiles, and the helpers below are invoked from the event
+ * loop only, so no locking is done here.
+ *
+ * Copyright (c) 2010 by Cisco Systems, Inc.
+ * All rights reserved.
+ *------------------------------------------------------------------
+ */
+
+#ifndef __VQEC_EVENT_PROFILE_H__
+#define __VQEC_EVENT_PROFILE_H__
+
+#include "vqec_event.h"
+#include <utils/vam_time.h>
+
+#define VQEC_EVENT_PROFILE_OTHER "(other)"
+#define VQEC_EVENT_PROFILE_USECS_MAX ((uint32_t)~0)
+
+/**
+ * Find the profile entry for a name, adding it to the table if it is not
+ * present.  Once the table is full, new names share a last entry named
+ * VQEC_EVENT_PROFILE_OTHER.
+ *
+ * @param[in] tbl Profile table, VQEC_EVENT_PROFILE_MAX entries long.
+ * @param[in] num Number of entries in use; updated if one is added.
+ * @param[in] name Event name; may be NULL.
+ * @param[out] vqec_event_profile_t* Returns the profile entry.
+ */
+static inline vqec_event_profile_t *
+vqec_event_profile_lookup (vqec_event_profile_t *tbl,
+                           uint32_t *num,
+                           const char *name)
+{
+    vqec_event_profile_t *prof;
+    uint32_t i;
+
+    if (!name) {
+        name = VQEC_EVENT_PROFILE_OTHER;
+    }
+    for (i = 0; i < *num; i++) {
+        if (!strncmp(tbl[i].name, name, VQEC_EVENT_PROFILE_NAME_LEN - 1)) {
+            return (&tbl[i]);
+        }
+    }
+    if (*num == VQEC_EVENT_PROFILE_MAX) {
+        return (&tbl[VQEC_EVENT_PROFILE_MAX - 1]);
+    }
+
+    prof = &tbl[(*num)++];
+    memset(prof, 0, sizeof(*prof));
+    if (*num == VQEC_EVENT_PROFILE_MAX) {
+        name = VQEC_EVENT_PROFILE_OTHER;
+    }
+    strncpy(prof->name, name, VQEC_EVENT_PROFILE_NAME_LEN - 1);
+    return (prof);
+}
+
+/**
+ * Account one handler run to a profile entry.
+ *
+ * @param[in] prof Profile entry.
+ * @param[in] exec Handler execution time.
+ * @param[in] is_timer True if the run was a timer expiration, in which
+ * case late is accounted as well.
+ * @param[in] late Time from the scheduled expiration to the handler run.
+ */
+static inline void
+vqec_event_profile_record (vqec_event_profile_t *prof,
+                           rel_time_t exec,
+                           boolean is_timer,
+                           rel_time_t late)
+{
+    int64_t usecs;
+
+    usecs = TIME_GET_R(usec, exec);
+    if (usecs < 0) {
+        usecs = 0;
+    }
+    prof->runs++;
+    prof->total_usecs += usecs;
+    if (usecs > prof->max_usecs) {
+        prof->max_usecs = (usecs > VQEC_EVENT_PROFILE_USECS_MAX) ?
+                VQEC_EVENT_PROFILE_USECS_MAX : usecs;
+    }
+
+    if (is_timer) {
+        usecs = TIME_GET_R(usec, late);
+        if (usecs < 0) {
+            usecs = 0;
+        }
+        prof->timer_runs++;
+        prof->total_late_usecs += usecs;
+        if (usecs > prof->max_late_usecs) {
+            prof->max_late_usecs = (usecs > VQEC_EVENT_PROFILE_USECS_MAX) ?
+                VQEC_EVENT_PROFILE_USECS_MAX : usecs;
+        }
+    }
+}
+
+/**
+ * Copy the entries of a profile table.
+ *
+ * @param[in] tbl Profile table.
+ * @param[in] num Number of entries in use in the table.
+ * @param[out] prof Array into which the entries are copied.
+ * @param[in] max Number of entries in the array.
+ * @param[out] uint32_t Returns the number of entries copied.
+ */
+static inline uint32_t
+vqec_event_profile_copy (const vqec_event_profile_t *tbl,
+                         uint32_t num,
+                         vqec_event_profile_t *prof,
+                         uint32_t max)
+{
+    if (!prof) {
+        return (0);
+    }
+    if (num > max) {
+        num = max;
+    }
+    memcpy(prof, tbl, num * sizeof(*prof));
+    return (num);
+}
+
+#endif /* __VQEC_EVENT_PROFILE_H__ */
@@ -92,6 +92,69 @@ int32_t vqec_lock_lock_internal (vqec_lock_t *lp)
         _rv;                                                             \
     })
 
+//----------------------------------------------------------------------------
+// Double-buffered publication, for data that one writer refreshes and
+// many readers poll without taking the writer's lock. The writer fills
+// buffer vqec_dbuf_write_idx() and then makes it current with
+// vqec_dbuf_publish(). A reader copies buffer (version & 1), where version
+// is returned by vqec_dbuf_read_begin(), and retries the copy if
+// vqec_dbuf_read_retry() reports that a publish completed meanwhile. The
+// writer never touches the current buffer, so readers never wait.
+//
+// Readers also mark the data as read, which the writer may test with
+// vqec_dbuf_is_read() to publish less often while nobody reads it.
+//----------------------------------------------------------------------------  
+typedef struct vqec_dbuf_
+{
+    volatile uint32_t   version;        //!< Number of publishes
+    volatile uint32_t   read;           //!< Read since the last publish
+} vqec_dbuf_t;
+
+static inline 
+uint32_t vqec_dbuf_write_idx (const vqec_dbuf_t *db)
+{
+    return ((db->version + 1) & 1);
+}
+
+static inline 
+void vqec_dbuf_publish (vqec_dbuf_t *db)
+{
+    /* the buffer is complete before it is made current */
+    db->read = 0;
+    __sync_synchronize();
+    db->version++;
+    /* 
+     * the new version is visible before the writer starts to refill the
+     * buffer it replaces, so that readers copying that buffer retry
+     */
+    __sync_synchronize();
+}
+
+static inline 
+uint32_t vqec_dbuf_read_begin (vqec_dbuf_t *db)
+{
+    uint32_t _version = db->version;
+
+    if (!db->read) {
+        db->read = 1;
+    }
+    __sync_synchronize();
+    return (_version);
+}
+
+static inline 
+int32_t vqec_dbuf_read_retry (const vqec_dbuf_t *db, uint32_t version)
+{
+    __sync_synchronize();
+    return (db->version != version);
+}
+
+static inline 
+int32_t vqec_dbuf_is_read (const vqec_dbuf_t *db)
+{
+    return (db->read != 0);
+}
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -39,6 +39,10 @@ typedef struct vqec_pak_ {
     /* system time at which pkt was received */
     abs_time_t rcv_ts;
     abs_time_t pred_ts;  /* "predicted" receive timestamp */
+    /* system time at which pkt was inserted in a channel's PCM */
+    abs_time_t pcm_ts;
+    /* system time at which pkt was output to the tuner sinks */
+    abs_time_t sink_ts;
     rel_time_t app_cpy_delay;  /** 
                                 * packet-specific delay, resultant from APP
                                 * replication